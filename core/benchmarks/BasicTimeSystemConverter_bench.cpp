@@ -0,0 +1,108 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file BasicTimeSystemConverter_bench.cpp
+ * Time one day of 1 Hz GPS epochs converted to UTC through
+ * CivilTime and getTimeSystemCorrection(), getOffset(),
+ * CommonTime::changeTimeSystem() and the bulk changeTimeSystem(). */
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "BasicTimeSystemConverter.hpp"
+#include "CivilTime.hpp"
+#include "TimeSystem.hpp"
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   gnsstk::BasicTimeSystemConverter btsc;
+   std::vector<gnsstk::CommonTime> times;
+   gnsstk::CommonTime t = gnsstk::CivilTime(2020,1,1,0,0,0,
+                                            gnsstk::TimeSystem::GPS);
+   for (unsigned i = 0; i < 86400; i++)
+   {
+      times.push_back(t);
+      t += 1.;
+   }
+   double sum = 0, offs;
+   clock::time_point t0 = clock::now();
+   for (unsigned i = 0; i < times.size(); i++)
+   {
+         // what getOffset did before the MJD table
+      gnsstk::CivilTime civ(times[i]);
+      sum += gnsstk::getTimeSystemCorrection(
+         gnsstk::TimeSystem::GPS, gnsstk::TimeSystem::UTC,
+         civ.year, civ.month, civ.day);
+   }
+   double dtCivil = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   for (unsigned i = 0; i < times.size(); i++)
+   {
+      btsc.getOffset(gnsstk::TimeSystem::GPS, gnsstk::TimeSystem::UTC,
+                     times[i], offs);
+      sum += offs;
+   }
+   double dtOffset = std::chrono::duration<double>(clock::now()-t0).count();
+   std::vector<gnsstk::CommonTime> single(times);
+   t0 = clock::now();
+   for (unsigned i = 0; i < single.size(); i++)
+   {
+      single[i].changeTimeSystem(gnsstk::TimeSystem::UTC, &btsc);
+   }
+   double dtSingle = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   btsc.changeTimeSystem(times, gnsstk::TimeSystem::UTC);
+   double dtBulk = std::chrono::duration<double>(clock::now()-t0).count();
+   double n = times.size() * 1e-9;
+   std::cout << "CivilTime+getTimeSystemCorrection " << dtCivil/n
+             << " ns/epoch" << std::endl
+             << "getOffset                         " << dtOffset/n
+             << " ns/epoch" << std::endl
+             << "CommonTime::changeTimeSystem      " << dtSingle/n
+             << " ns/epoch" << std::endl
+             << "changeTimeSystem(vector)          " << dtBulk/n
+             << " ns/epoch" << std::endl
+             << "(" << sum << ")" << std::endl;
+   return 0;
+}
@@ -0,0 +1,134 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file CompiledTimeFormat_bench.cpp
+ * Compare printTime() and scanTime() with CompiledTimeFormat::print()
+ * and CompiledTimeFormat::scan() for the formats used by the
+ * FileHandling writers and readers. */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CompiledTimeFormat.hpp"
+#include "TimeString.hpp"
+#include "CivilTime.hpp"
+
+using namespace gnsstk;
+using namespace std;
+
+   /// Formats used by the FileHandling writers and readers.
+static const char *writerFormats[] =
+{
+   "%02m/%02d/%04Y %02H:%02M:%02S",
+   "%4Y %02m %02d %02H %02M %06.3f %P",
+   "%4Y %02m %02d %02H %02M %06.3f",
+   "%04Y/%02m/%02d %02H:%02M:%06.3f %P",
+   "%Y/%02m/%02d %2H:%02M:%06.3f = %F/%10.3g %P",
+   "%4Y %02m %02d %02H %02M %9.6f",
+   "%4Y %02m %02d %02H %02M %02S",
+   "%4F/%w/%10.3g = %04Y/%02m/%02d %02H:%02M:%02S",
+   "%4F %10.3g",
+   "%04Y/%02m/%02d %02H:%02M:%02S %4P",
+   "%04Y%02m%02d %02H%02M%02S UTC",
+   "%04Y%02m%02d %02H%02M%02S %P",
+   "%02y %2m %2d %2H %2M %4.1f",
+   " TOC %Y/%02m/%02d %02H:%02M:%02S",
+   " %02y %2m %2d %2H %2M%5.1f",
+};
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   vector<CommonTime> times;
+   times.push_back(CivilTime(2008,8,21,13,30,15.25,TimeSystem::GPS));
+   times.push_back(CivilTime(2020,2,29,23,59,59.9995,TimeSystem::UTC));
+   times.push_back(CivilTime(1999,12,31,0,0,0,TimeSystem::GAL));
+   times.push_back(CivilTime(2015,6,7,8,9,10.125,TimeSystem::BDT));
+   const unsigned reps = 2000;
+   unsigned numFmt = sizeof(writerFormats)/sizeof(writerFormats[0]);
+   vector<CompiledTimeFormat> compiled;
+   vector<std::string> strs;
+   for (unsigned f = 0; f < numFmt; f++)
+   {
+      compiled.push_back(CompiledTimeFormat(writerFormats[f]));
+      strs.push_back(printTime(times[0], writerFormats[f]));
+   }
+   unsigned long chars = 0;
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (unsigned f = 0; f < numFmt; f++)
+         chars += printTime(times[r % times.size()], writerFormats[f]).size();
+   }
+   double dtPrintTime = std::chrono::duration<double>(clock::now()-t0).count();
+   char buf[128];
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (unsigned f = 0; f < numFmt; f++)
+         chars += compiled[f].print(times[r % times.size()], buf, sizeof(buf));
+   }
+   double dtPrint = std::chrono::duration<double>(clock::now()-t0).count();
+   CommonTime ct;
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (unsigned f = 0; f < numFmt; f++)
+         scanTime(ct, strs[f], writerFormats[f]);
+   }
+   double dtScanTime = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (unsigned f = 0; f < numFmt; f++)
+         compiled[f].scan(ct, strs[f]);
+   }
+   double dtScan = std::chrono::duration<double>(clock::now()-t0).count();
+   double n = reps * numFmt * 1e-6;
+   cout << "printTime          " << dtPrintTime/n << " us/call" << endl
+        << "CompiledTimeFormat " << dtPrint/n << " us/call" << endl
+        << "scanTime           " << dtScanTime/n << " us/call" << endl
+        << "CompiledTimeFormat " << dtScan/n << " us/call" << endl
+        << "(" << chars << " characters)" << endl;
+   return 0;
+}
@@ -0,0 +1,327 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+/** @file FFTextStream_bench.cpp
+ * Compare the time to read a day of RINEX 3 through Rinex3ObsStream
+ * from a plain file and through FFTextStream::openCompressed().
+ *
+ * A day of 30 second data for 32 GPS satellites is written as RINEX 3
+ * and as Compact RINEX 3 (by a small first-order encoder here), and,
+ * when built with zlib, gzip-compressed copies of each.  Every path
+ * must yield the same data, and the expanded CRINEX text must match
+ * the RINEX text line for line.
+ *
+ * Usage: FFTextStream_bench [directory for the generated files] */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#ifdef GNSSTK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+
+
+/** Make a day of 30 second RINEX 3 data for 32 GPS satellites, and
+ * the same data in Compact RINEX 3. */
+static void makeBenchmarkData(std::string& rinex, std::string& crinex)
+{
+   const unsigned numSats = 32, numTypes = 4, numEpochs = 2880;
+   char buf[128];
+   std::string header;
+   const char *hdrLines[] = {
+      "     3.04           OBSERVATION DATA    G                   RINEX VERSION / TYPE",
+      "test                test                20200311 120000 UTC PGM / RUN BY / DATE ",
+      "TEST                                                        MARKER NAME         ",
+      "obs                 agency                                  OBSERVER / AGENCY   ",
+      "1                   rcv                 1                   REC # / TYPE / VERS ",
+      "1                   ant                                     ANT # / TYPE        ",
+      "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ ",
+      "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N",
+      "G    4 C1C L1C D1C S1C                                      SYS / # / OBS TYPES ",
+      "    30.000                                                  INTERVAL            ",
+      "  2020     3    11     0     0    0.0000000     GPS         TIME OF FIRST OBS   ",
+      "                                                            END OF HEADER       "
+   };
+   for (const char *hl : hdrLines)
+   {
+      header += hl;
+      header += '\n';
+   }
+   rinex = header;
+   crinex =
+      "3.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE\n"
+      "FFTextStream_bench                      16-Oct-26 00:00     CRINEX PROG / DATE\n"
+      + header;
+      // Each value is a first order arc, so after the first epoch
+      // only the difference from the previous epoch is written.
+   std::vector<long long> prev(numSats * numTypes);
+   std::string prevEpoch, satList;
+   for (unsigned s = 1; s <= numSats; s++)
+   {
+      snprintf(buf, sizeof(buf), "G%02u", s);
+      satList += buf;
+   }
+   for (unsigned e = 0; e < numEpochs; e++)
+   {
+      unsigned sec = 30 * e;
+      snprintf(buf, sizeof(buf), "> 2020 03 11 %02u %02u %2u.0000000  0 %2u",
+               sec / 3600, (sec / 60) % 60, sec % 60, numSats);
+      std::string epoch(buf);
+      rinex += epoch + "\n";
+      epoch.resize(41, ' ');
+      epoch += satList;
+      if (e == 0)
+      {
+         crinex += epoch;
+      }
+      else
+      {
+            // text difference from the previous epoch line
+         std::string diff(epoch.size(), ' ');
+         for (unsigned i = 0; i < epoch.size(); i++)
+         {
+            if (epoch[i] != prevEpoch[i])
+               diff[i] = (epoch[i] == ' ' ? '&' : epoch[i]);
+         }
+         crinex += diff.substr(0, diff.find_last_not_of(' ') + 1);
+      }
+         // no receiver clock offset
+      crinex += "\n\n";
+      prevEpoch = epoch;
+      for (unsigned s = 0; s < numSats; s++)
+      {
+         snprintf(buf, sizeof(buf), "G%02u", s+1);
+         rinex += buf;
+         std::string crxLine;
+         for (unsigned t = 0; t < numTypes; t++)
+         {
+               // values in units of 0.001, changing smoothly
+            long long value;
+            if (t == 3)
+            {
+               value = 30000 + 500 * s + 10 * (e % 50);
+            }
+            else
+            {
+               value = (20000000000LL + 1000000000LL * s) / (t + 1) +
+                  (long long)e * e * (s + 7) * 31 + e * 12345LL * (t + 1);
+            }
+            snprintf(buf, sizeof(buf), "%14.3f 7", value / 1000.0);
+            rinex += buf;
+            long long& p(prev[s * numTypes + t]);
+            snprintf(buf, sizeof(buf), (e == 0 ? "1&%lld " : "%lld "),
+                     (e == 0 ? value : value - p));
+            crxLine += buf;
+            p = value;
+         }
+         rinex += "\n";
+            // flags for the first epoch only, they don't change
+         crinex += (e == 0 ? crxLine + " 7 7 7 7"
+                    : crxLine.substr(0, crxLine.size() - 1));
+         crinex += "\n";
+      }
+   }
+}
+
+
+/** Read a RINEX 3 obs stream to the end.
+ * @return the number of epochs read. */
+static unsigned readObs(gnsstk::Rinex3ObsStream& strm, double& sum)
+{
+   gnsstk::Rinex3ObsHeader hdr;
+   gnsstk::Rinex3ObsData rod;
+   unsigned epochs = 0;
+   strm >> hdr;
+   while (strm >> rod)
+   {
+      epochs++;
+      for (const auto& sati : rod.obs)
+         sum += sati.second[1].data;
+   }
+   return epochs;
+}
+
+
+/// Read all the lines of strm, up to EOF.
+static void readLines(gnsstk::FFTextStream& strm, std::vector<std::string>& lines,
+          std::vector<unsigned>& lineNums)
+{
+   lines.clear();
+   lineNums.clear();
+   try
+   {
+      while (true)
+      {
+         std::string line;
+         strm.formattedGetLine(line, true);
+         lines.push_back(line);
+         lineNums.push_back(strm.lineNumber);
+      }
+   }
+   catch (gnsstk::EndOfFile&)
+   {
+   }
+}
+
+
+/// Split text into lines, without the newlines.
+static std::vector<std::string> splitLines(const std::string& text)
+{
+   std::vector<std::string> rv;
+   std::string::size_type pos = 0, nl;
+   while ((nl = text.find('\n', pos)) != std::string::npos)
+   {
+      rv.push_back(text.substr(pos, nl - pos));
+      pos = nl + 1;
+   }
+   if (pos < text.size())
+      rv.push_back(text.substr(pos));
+   return rv;
+}
+
+
+/// Write text to a file, returning its name.
+static std::string writeFile(const std::string& fn, const std::string& text)
+{
+   std::ofstream ofs(fn.c_str(), std::ios::out | std::ios::binary);
+   ofs << text;
+   return fn;
+}
+
+
+int main(int argc, char *argv[])
+{
+   typedef std::chrono::steady_clock clock;
+   std::string rinex, crinex;
+   makeBenchmarkData(rinex, crinex);
+   std::string dir = std::string(argc > 1 ? argv[1] : ".") + "/";
+   std::string rnxFn = writeFile(dir + "FFTextStream_bench.rnx", rinex);
+   std::string crxFn = writeFile(dir + "FFTextStream_bench.crx", crinex);
+   std::vector<std::string> names, files;
+   names.push_back("plain .rnx");
+   files.push_back(rnxFn);
+   names.push_back("openCompressed .crx");
+   files.push_back(crxFn);
+#ifdef GNSSTK_HAVE_ZLIB
+   const std::string *texts[] = { &rinex, &crinex };
+   const char *gzNames[] = { "FFTextStream_bench.rnx.gz",
+                             "FFTextStream_bench.crx.gz" };
+   for (unsigned i = 0; i < 2; i++)
+   {
+      gzFile gz = gzopen((dir + gzNames[i]).c_str(), "wb");
+      gzwrite(gz, texts[i]->data(), texts[i]->size());
+      gzclose(gz);
+   }
+   names.push_back("openCompressed .rnx.gz");
+   files.push_back(dir + gzNames[0]);
+   names.push_back("openCompressed .crx.gz");
+   files.push_back(dir + gzNames[1]);
+#endif
+   std::cout << "RINEX " << rinex.size() << " bytes, CRINEX "
+             << crinex.size() << " bytes" << std::endl;
+   unsigned expEpochs = 0, errors = 0;
+   double expSum = 0;
+   for (unsigned i = 0; i < files.size(); i++)
+   {
+      double sum = 0;
+      clock::time_point t0 = clock::now();
+      gnsstk::Rinex3ObsStream strm;
+      if (i == 0)
+         strm.open(files[i].c_str(), std::ios::in);
+      else
+         strm.openCompressed(files[i]);
+      unsigned epochs = readObs(strm, sum);
+      double dt = std::chrono::duration<double>(clock::now()-t0).count();
+      if (i == 0)
+      {
+         expEpochs = epochs;
+         expSum = sum;
+         errors += (epochs == 0);
+      }
+      else if ((epochs != expEpochs) || (sum != expSum))
+      {
+         errors++;
+      }
+      std::cout << names[i] << ": " << dt << " s, " << epochs << " epochs"
+                << std::endl;
+   }
+#ifdef GNSSTK_HAVE_ZLIB
+      // the alternative to openCompressed: decompress to a
+      // temporary file, then read that
+   {
+      double sum = 0;
+      clock::time_point t0 = clock::now();
+      std::string tmpFn = dir + "FFTextStream_bench.tmp.rnx";
+      gzFile gz = gzopen(files[2].c_str(), "rb");
+      std::FILE *tmp = std::fopen(tmpFn.c_str(), "wb");
+      std::vector<char> gzbuf(65536);
+      int n;
+      while ((n = gzread(gz, gzbuf.data(), gzbuf.size())) > 0)
+         std::fwrite(gzbuf.data(), 1, n, tmp);
+      std::fclose(tmp);
+      gzclose(gz);
+      gnsstk::Rinex3ObsStream strm(tmpFn.c_str());
+      unsigned epochs = readObs(strm, sum);
+      double dt = std::chrono::duration<double>(clock::now()-t0).count();
+      if ((epochs != expEpochs) || (sum != expSum))
+         errors++;
+      std::cout << "gunzip to temp file, then read: " << dt << " s, "
+                << epochs << " epochs" << std::endl;
+   }
+#else
+   std::cout << "(built without zlib, gzip not timed)" << std::endl;
+#endif
+      // make sure the CRINEX is a faithful copy of the RINEX
+   gnsstk::FFTextStream crxStrm;
+   crxStrm.openCompressed(crxFn);
+   std::vector<std::string> gotLines;
+   std::vector<unsigned> gotNums;
+   readLines(crxStrm, gotLines, gotNums);
+   if (gotLines != splitLines(rinex))
+      errors++;
+   std::cout << "(" << expSum << ", " << errors << " mismatched)"
+             << std::endl;
+   return errors != 0;
+}
@@ -0,0 +1,146 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file FixedPointTime_bench.cpp
+ * Compare the time to sort, compare, difference and add seconds to
+ * CommonTime and FixedPointTime. */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "FixedPointTime.hpp"
+#include "CivilTime.hpp"
+
+using namespace gnsstk;
+using namespace std;
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   const unsigned reps = 200;
+      // times with fractional milliseconds across the CommonTime range
+   std::mt19937 gen(20221);
+   std::uniform_int_distribution<long> dayDist(CommonTime::BEGIN_LIMIT_JDAY,
+                                               CommonTime::END_LIMIT_JDAY-1);
+   std::uniform_int_distribution<long> msodDist(0, MS_PER_DAY-1);
+   std::uniform_real_distribution<double> fsodDist(0, 0.001);
+   vector<CommonTime> ct;
+   ct.push_back(CivilTime(2022,1,1,0,0,0.0,TimeSystem::GPS));
+   ct.push_back(CivilTime(2022,1,1,23,59,59.9999999999,TimeSystem::GPS));
+   for (unsigned i = 0; i < 2000; i++)
+   {
+      CommonTime t;
+      t.setInternal(dayDist(gen), msodDist(gen), (i % 4) ? fsodDist(gen) : 0,
+                    TimeSystem::GPS);
+      ct.push_back(t);
+   }
+   vector<FixedPointTime> fpt;
+   for (const auto& t : ct)
+      fpt.push_back(FixedPointTime(t));
+   double n = reps * ct.size() * 1e-9;
+   double sum = 0;
+   unsigned count = 0;
+
+   auto t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      vector<CommonTime> tmp(ct);
+      std::sort(tmp.begin(), tmp.end());
+      count += tmp.front() < tmp.back();
+   }
+   double dtSortCT = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      vector<FixedPointTime> tmp(fpt);
+      std::sort(tmp.begin(), tmp.end());
+      count += tmp.front() < tmp.back();
+   }
+   double dtSortFPT = std::chrono::duration<double>(clock::now()-t0).count();
+
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 1; i < ct.size(); i++)
+         count += (ct[i-1] < ct[i]) + (ct[i-1] == ct[i]);
+   double dtCmpCT = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 1; i < fpt.size(); i++)
+         count += (fpt[i-1] < fpt[i]) + (fpt[i-1] == fpt[i]);
+   double dtCmpFPT = std::chrono::duration<double>(clock::now()-t0).count();
+
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 1; i < ct.size(); i++)
+         sum += ct[i] - ct[i-1];
+   double dtDiffCT = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 1; i < fpt.size(); i++)
+         sum += fpt[i] - fpt[i-1];
+   double dtDiffFPT = std::chrono::duration<double>(clock::now()-t0).count();
+
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 0; i < ct.size(); i++)
+         sum += (ct[i] + 0.25).getSecondOfDay();
+   double dtAddCT = std::chrono::duration<double>(clock::now()-t0).count();
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 0; i < fpt.size(); i++)
+         sum += (fpt[i] + 0.25).getAttoseconds();
+   double dtAddFPT = std::chrono::duration<double>(clock::now()-t0).count();
+
+   cout << "sort        CommonTime " << dtSortCT/n << " ns/time"
+        << "  FixedPointTime " << dtSortFPT/n << " ns/time" << endl
+        << "compare     CommonTime " << dtCmpCT/n << " ns/pair"
+        << "  FixedPointTime " << dtCmpFPT/n << " ns/pair" << endl
+        << "difference  CommonTime " << dtDiffCT/n << " ns/pair"
+        << "  FixedPointTime " << dtDiffFPT/n << " ns/pair" << endl
+        << "add seconds CommonTime " << dtAddCT/n << " ns/time"
+        << "  FixedPointTime " << dtAddFPT/n << " ns/time" << endl
+        << "(" << count << " " << sum << ")" << endl;
+   return 0;
+}
@@ -0,0 +1,136 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file Matrix_Kernels_bench.cpp
+ * Print timings of the reference loops and each MatrixKernels level
+ * this processor supports, for sizes 4..maxN (default 2000); the
+ * reference loops are only timed up to 1000.
+ *
+ * Usage: Matrix_Kernels_bench [maxN] */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// deterministic matrix with elements in [-1,1)
+static Matrix<double> randomMatrix(size_t r, size_t c, unsigned long seed)
+{
+   Matrix<double> m(r,c);
+   for (size_t i = 0; i < r; i++)
+      for (size_t j = 0; j < c; j++)
+      {
+         seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+         m(i,j) = double(seed >> 11) / double(1UL << 52) - 1.;
+      }
+   return m;
+}
+
+   /// symmetric positive definite n x n
+static Matrix<double> spdMatrix(size_t n, unsigned long seed)
+{
+   Matrix<double> a(randomMatrix(n, n, seed));
+   MatrixKernels::Level level = MatrixKernels::getLevel();
+   MatrixKernels::setLevel(MatrixKernels::Reference);
+   Matrix<double> s(a * transpose(a));
+   MatrixKernels::setLevel(level);
+   for (size_t i = 0; i < n; i++)
+      s(i,i) += double(n);
+   return s;
+}
+
+
+   /// seconds per call of f, repeated for at least 0.2 s
+template <class F>
+static double timeIt(F f)
+{
+   typedef std::chrono::steady_clock clock;
+   unsigned reps = 0;
+   clock::time_point start = clock::now();
+   double elapsed;
+   do
+   {
+      f();
+      reps++;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+   } while (elapsed < 0.2);
+   return elapsed / reps;
+}
+
+
+int main(int argc, char *argv[])
+{
+   size_t maxN = (argc > 1 ? atoi(argv[1]) : 2000);
+   const size_t sizes[] = { 4, 8, 16, 32, 64, 128, 256, 512, 1000, 2000 };
+   MatrixKernels::Level best = MatrixKernels::bestLevel();
+   MatrixKernels::setCrossover(1);
+   cout << "times in ms; level: multiply LUDecomp CholeskyCrout Householder"
+        << endl;
+   for (unsigned s = 0; s < sizeof(sizes)/sizeof(sizes[0]); s++)
+   {
+      size_t n = sizes[s];
+      if (n > maxN)
+         break;
+      Matrix<double> a(randomMatrix(n, n, n)), b(randomMatrix(n, n, n+1)),
+         spd(spdMatrix(n, n+2));
+      cout << "n=" << n << endl;
+      for (unsigned l = MatrixKernels::Reference; l <= best; l++)
+      {
+         if (l == MatrixKernels::Reference && n > 1000)
+            continue;
+         MatrixKernels::setLevel(MatrixKernels::Level(l));
+         double tm = timeIt([&]{ Matrix<double> c(a * b); });
+         double tl = timeIt([&]{ LUDecomp<double> lu; lu(a); });
+         double tc = timeIt([&]{ CholeskyCrout<double> ch; ch(spd); });
+         double th = timeIt([&]{ Householder<double> hh; hh(a); });
+         cout << "  " << MatrixKernels::levelName(MatrixKernels::Level(l))
+              << ": " << tm*1e3 << " " << tl*1e3 << " " << tc*1e3 << " "
+              << th*1e3 << "  (" << 2.*n*n*n/tm*1e-9 << " GFlop/s multiply)"
+              << endl;
+      }
+   }
+   return 0;
+}
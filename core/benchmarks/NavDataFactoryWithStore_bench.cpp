@@ -0,0 +1,229 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file NavDataFactoryWithStore_bench.cpp
+ * Compare the search rate of frozen and unfrozen
+ * NavDataFactoryWithStore objects holding a day of GPS LNAV
+ * ephemerides, almanacs and health, and check that both find the
+ * same data. */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "NavDataFactoryWithStore.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSLNavAlm.hpp"
+#include "GPSLNavHealth.hpp"
+
+
+   /// A NavDataFactoryWithStore that is filled directly.
+class BenchFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "BUNK"; }
+};
+
+
+   /// Add a healthy GPS LNAV message of type nmt for sat to fact.
+static void addData(BenchFactory& fact, const gnsstk::CommonTime& ct,
+                    unsigned long sat, unsigned long xmitSat,
+                    gnsstk::CarrierBand car, gnsstk::TrackingCode code,
+                    gnsstk::NavMessageType nmt)
+{
+   gnsstk::NavDataPtr navOut;
+   gnsstk::GPSWeekSecond toe = ct;
+   if (nmt == gnsstk::NavMessageType::Ephemeris)
+   {
+      auto eph = std::make_shared<gnsstk::GPSLNavEph>();
+      eph->timeStamp = ct-3600;
+      eph->health = gnsstk::SVHealth::Healthy;
+      toe.sow -= fmod(toe.sow,7200);
+      eph->Toe = toe;
+      eph->Toc = toe;
+      eph->xmitTime = ct-3600;
+      eph->xmit2 = ct-3594;
+      eph->xmit3 = ct-3588;
+      eph->fixFit();
+      navOut = eph;
+   }
+   else if (nmt == gnsstk::NavMessageType::Almanac)
+   {
+      auto alm = std::make_shared<gnsstk::GPSLNavAlm>();
+      alm->timeStamp = ct;
+      alm->health = gnsstk::SVHealth::Healthy;
+      toe.sow = toe.sow - fmod(toe.sow,86400) + (xmitSat == 3 ? 61000 : 61056);
+      alm->Toe = toe;
+      alm->xmitTime = ct;
+      alm->fixFit();
+      navOut = alm;
+   }
+   else
+   {
+      auto hea = std::make_shared<gnsstk::GPSLNavHealth>();
+      hea->timeStamp = ct;
+      hea->svHealth = 0;
+      navOut = hea;
+   }
+   navOut->signal.messageType = nmt;
+   navOut->signal.system = gnsstk::SatelliteSystem::GPS;
+   navOut->signal.obs = gnsstk::ObsID(gnsstk::ObservationType::NavMsg,car,code);
+   navOut->signal.nav = gnsstk::NavType::GPSLNAV;
+   navOut->signal.sat = gnsstk::SatID(sat,gnsstk::SatelliteSystem::GPS);
+   navOut->signal.xmitSat = gnsstk::SatID(xmitSat,gnsstk::SatelliteSystem::GPS);
+   fact.addNavData(navOut);
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   BenchFactory uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refct = gnsstk::GPSWeekSecond(2101, 0);
+   const unsigned numSats = 32;
+      // One day of ephemerides every 2 hours on two signals, almanacs
+      // from 4 transmitting satellites every 750 seconds and health
+      // every 30 seconds.
+   for (unsigned long sat = 1; sat <= numSats; sat++)
+   {
+      for (unsigned i = 0; i < 2880; i++)
+      {
+         gnsstk::CommonTime t(refct + 30.0*i);
+         addData(uut, t, sat, sat, CB::L1, TC::CA, MT::Health);
+         if ((i % 240) == 0)
+         {
+            addData(uut, t, sat, sat, CB::L1, TC::CA, MT::Ephemeris);
+            addData(uut, t, sat, sat, CB::L2, TC::Y, MT::Ephemeris);
+         }
+         if ((i % 25) == 0)
+         {
+            for (unsigned long x = 0; x < 4; x++)
+            {
+               addData(uut, t + x, sat, 1 + (sat + 8*x) % numSats,
+                       CB::L1, TC::CA, MT::Almanac);
+            }
+         }
+      }
+   }
+   BenchFactory frozenUut(uut);
+   frozenUut.freeze();
+   const char *what[] = { "ephemeris, specific signal",
+                          "ephemeris, any signal",
+                          "almanac, any transmitter" };
+   std::vector<gnsstk::CommonTime> times;
+   for (unsigned i = 0; i < 97; i++)
+      times.push_back(refct + 3600 + 823.0*i);
+   const unsigned reps = 4;
+   unsigned long found = 0, mismatch = 0;
+   for (unsigned kind = 0; kind < 3; kind++)
+   {
+      for (SO order : {SO::User, SO::Nearest})
+      {
+         std::vector<gnsstk::NavMessageID> nmids;
+         for (unsigned long sat = 1; sat <= numSats; sat++)
+         {
+            if (kind == 0)
+            {
+               nmids.push_back(gnsstk::NavMessageID(
+                                  gnsstk::NavSatelliteID(
+                                     sat, SS::GPS, CB::L1, TC::CA,
+                                     NT::GPSLNAV),
+                                  MT::Ephemeris));
+            }
+            else
+            {
+               nmids.push_back(gnsstk::NavMessageID(
+                                  gnsstk::NavSatelliteID(
+                                     gnsstk::SatID(sat, SS::GPS)),
+                                  kind == 1 ? MT::Ephemeris : MT::Almanac));
+            }
+         }
+         double dt[2];
+         std::vector<gnsstk::NavDataPtr> results[2];
+         BenchFactory *facts[2] = { &uut, &frozenUut };
+         for (unsigned f = 0; f < 2; f++)
+         {
+            clock::time_point t0 = clock::now();
+            for (unsigned r = 0; r < reps; r++)
+            {
+               for (const auto& when : times)
+               {
+                  for (const auto& nmid : nmids)
+                  {
+                     gnsstk::NavDataPtr ndp;
+                     if (facts[f]->find(nmid, when, ndp, SH::Any, VT::Any,
+                                        order))
+                     {
+                        found++;
+                     }
+                     if (r == 0)
+                        results[f].push_back(ndp);
+                  }
+               }
+            }
+            dt[f] = std::chrono::duration<double>(clock::now()-t0).count();
+         }
+         mismatch += (results[0] != results[1]);
+         double n = double(reps) * times.size() * nmids.size() * 1e-9;
+         std::cout << what[kind]
+                   << (order == SO::User ? ", User" : ", Nearest")
+                   << ": unfrozen " << dt[0]/n << " ns/find, frozen "
+                   << dt[1]/n << " ns/find" << std::endl;
+      }
+   }
+   std::cout << "(" << found << " found, " << mismatch << " mismatched)"
+             << std::endl;
+   return mismatch != 0;
+}
@@ -0,0 +1,156 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file NavFilterPool_bench.cpp
+ * Compare node churn through NavFilter::NavMsgList with a std::list,
+ * then time some filters on synthetic data from 32 PRNs x 3 sites. */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <vector>
+#include "NavFilterMgr.hpp"
+#include "LNavFilterData.hpp"
+#include "LNavCrossSourceFilter.hpp"
+#include "LNavEmptyFilter.hpp"
+#include "LNavOrderFilter.hpp"
+#include "GPSWeekSecond.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// A subframe 1 with good parity.
+static uint32_t sfGood[10] =
+{ 0x22C34D21, 0x000029D4, 0x34D44000, 0x091B1DE7, 0x1C33746E,
+  0x2F701369, 0x39F53CB5, 0x128070A8, 0x003FF454, 0x3EAFC2F0 };
+   /// The same subframe with a bit error in word 3.
+static uint32_t sfBad[10] =
+{ 0x22C34D21, 0x000029D4, 0x34D44001, 0x091B1DE7, 0x1C33746E,
+  0x2F701369, 0x39F53CB5, 0x128070A8, 0x003FF454, 0x3EAFC2F0 };
+
+
+
+   /// Report the subframe rate through a NavFilterMgr with filt.
+static double timeFilter(const std::string& name, NavFilter *filt,
+                         std::vector<LNavFilterData>& data)
+{
+   typedef std::chrono::steady_clock clock;
+   NavFilterMgr mgr;
+   mgr.addFilter(filt);
+   size_t accepted = 0;
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < 20; r++)
+   {
+      for (unsigned i = 0; i < data.size(); i++)
+         accepted += mgr.validate(&data[i]).size();
+      accepted += mgr.finalize().size();
+      filt->rejected.clear();
+   }
+   double rate = 20.0 * data.size() /
+      std::chrono::duration<double>(clock::now()-t0).count();
+   cout << setw(24) << left << name << right << setw(10) << fixed
+        << setprecision(3) << rate * 1e-6 << " Msubframes/s" << endl;
+   return accepted;
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   LNavFilterData fd;
+   const unsigned reps = 2000000;
+   std::list<NavFilterKey*> sl1, sl2;
+   NavFilter::NavMsgList pl1, pl2;
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (unsigned i = 0; i < 4; i++)
+         sl1.push_back(&fd);
+      sl2 = sl1;
+      sl1.clear();
+      sl2.clear();
+   }
+   clock::time_point t1 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (unsigned i = 0; i < 4; i++)
+         pl1.push_back(&fd);
+      pl2 = pl1;
+      pl1.clear();
+      pl2.clear();
+   }
+   clock::time_point t2 = clock::now();
+   double nodes = 8.0 * reps;
+   cout << "std::list node churn:   " << setw(10) << fixed << setprecision(3)
+        << nodes / std::chrono::duration<double>(t1-t0).count() * 1e-6
+        << " Mnodes/s" << endl
+        << "NavMsgList node churn:  " << setw(10)
+        << nodes / std::chrono::duration<double>(t2-t1).count() * 1e-6
+        << " Mnodes/s" << endl;
+
+   std::vector<LNavFilterData> data;
+   for (unsigned epoch = 0; epoch < 100; epoch++)
+   {
+      CommonTime t(GPSWeekSecond(1869, 6.0 * (epoch+1)));
+      for (uint32_t prn = 1; prn <= 32; prn++)
+      {
+         for (unsigned site = 0; site < 3; site++)
+         {
+            LNavFilterData tmp;
+            tmp.sf = (site == 2 && (prn & 1)) ? sfBad : sfGood;
+            tmp.prn = prn;
+            tmp.stationID = std::string(1, 'a' + site);
+            tmp.timeStamp = t;
+            data.push_back(tmp);
+         }
+      }
+   }
+   double sum = 0;
+   LNavEmptyFilter filtEmpty;
+   LNavCrossSourceFilter filtXS;
+   LNavOrderFilter filtOrder;
+   sum += timeFilter("LNavEmptyFilter", &filtEmpty, data);
+   sum += timeFilter("LNavCrossSourceFilter", &filtXS, data);
+   sum += timeFilter("LNavOrderFilter", &filtOrder, data);
+   return sum == 0;
+}
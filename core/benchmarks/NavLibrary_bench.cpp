@@ -0,0 +1,226 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file NavLibrary_bench.cpp
+ * Compare NavLibrary::getXvts, with and without a ThreadPool, with a
+ * plain loop over NavLibrary::getXvt for a day of GPS LNAV
+ * ephemerides, check that all give the same results, and measure the
+ * cost of handing a loop to a pool compared with starting threads
+ * for each call. */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "NavLibrary.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "GPSWeekSecond.hpp"
+#include "GPSLNavEph.hpp"
+#include "ThreadPool.hpp"
+
+
+   /// A NavDataFactoryWithStore that is filled directly.
+class BenchFactory : public gnsstk::NavDataFactoryWithStore
+{
+public:
+   BenchFactory()
+   {
+      supportedSignals.insert(gnsstk::NavSignalID(
+                                 gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV));
+   }
+   bool addDataSource(const std::string& source) override
+   { return false; }
+   std::string getFactoryFormats() const override
+   { return "BUNK"; }
+};
+
+
+   /// Add a healthy GPS LNAV ephemeris for sat, Toe at ct, to fact.
+static void addEph(BenchFactory& fact, const gnsstk::CommonTime& ct,
+                   unsigned long sat)
+{
+   auto eph = std::make_shared<gnsstk::GPSLNavEph>();
+   eph->timeStamp = ct - 3600;
+   eph->health = gnsstk::SVHealth::Healthy;
+   eph->Toe = eph->Toc = ct;
+   eph->xmitTime = ct - 3600;
+   eph->xmit2 = ct - 3594;
+   eph->xmit3 = ct - 3588;
+   eph->A = 26559800.0;
+   eph->Ahalf = std::sqrt(eph->A);
+   eph->ecc = 0.005 + 0.0005 * (sat % 7);
+   eph->i0 = 0.96;
+   eph->OMEGA0 = (sat % 6) * 1.0472;
+   eph->OMEGAdot = -8.0e-9;
+   eph->w = 0.3 * sat;
+   eph->M0 = 0.7 * sat;
+   eph->dn = 4.5e-9;
+   eph->af0 = 1e-5 * sat;
+   eph->af1 = 1e-12;
+   eph->fixFit();
+   eph->signal.messageType = gnsstk::NavMessageType::Ephemeris;
+   eph->signal.system = gnsstk::SatelliteSystem::GPS;
+   eph->signal.obs = gnsstk::ObsID(gnsstk::ObservationType::NavMsg,
+                                   gnsstk::CarrierBand::L1,
+                                   gnsstk::TrackingCode::CA);
+   eph->signal.nav = gnsstk::NavType::GPSLNAV;
+   eph->signal.sat = gnsstk::SatID(sat, gnsstk::SatelliteSystem::GPS);
+   eph->signal.xmitSat = eph->signal.sat;
+   fact.addNavData(eph);
+}
+
+
+   /// Return true if a and b are the same result.
+static bool same(const gnsstk::Xvt& a, const gnsstk::Xvt& b)
+{
+   return ((a.health == b.health) &&
+           ((a.health == gnsstk::Xvt::Unavailable) ||
+            ((a.x == b.x) && (a.v == b.v) && (a.clkbias == b.clkbias) &&
+             (a.clkdrift == b.clkdrift) && (a.relcorr == b.relcorr))));
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   auto seconds = [](clock::time_point t0)
+   { return std::chrono::duration<double>(clock::now() - t0).count(); };
+   const unsigned numSats = 32;
+   gnsstk::CommonTime refct = gnsstk::GPSWeekSecond(2101, 0);
+   gnsstk::NavDataFactoryPtr fact(std::make_shared<BenchFactory>());
+   BenchFactory *bf = dynamic_cast<BenchFactory*>(fact.get());
+   for (unsigned long sat = 1; sat <= numSats; sat++)
+   {
+      for (unsigned i = 0; i <= 13; i++)
+         addEph(*bf, refct + 7200.0 * i, sat);
+   }
+   gnsstk::NavLibrary navLib;
+   navLib.addFactory(fact);
+   navLib.freeze();
+   std::vector<gnsstk::NavSatelliteID> sats;
+   for (unsigned long sat = 1; sat <= numSats; sat++)
+   {
+      sats.push_back(gnsstk::NavSatelliteID(
+                        sat, sat, gnsstk::SatelliteSystem::GPS,
+                        gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                        gnsstk::NavType::GPSLNAV));
+   }
+   unsigned long mismatch = 0;
+   std::cout << "hardware threads: " << std::thread::hardware_concurrency()
+             << std::endl;
+      // Batch sizes from one epoch of all satellites to a full day.
+   for (double step : {86400.0, 900.0, 30.0})
+   {
+      std::vector<gnsstk::CommonTime> times;
+      for (double t = 3600; t < 90000; t += step)
+         times.push_back(refct + t);
+      const size_t total = sats.size() * times.size();
+      const unsigned reps = (total < 1000 ? 2000 : (total < 10000 ? 20 : 1));
+      std::vector<gnsstk::Xvt> expXvts(total);
+      size_t expCount = 0;
+      clock::time_point t0 = clock::now();
+      for (unsigned r = 0; r < reps; r++)
+      {
+         expCount = 0;
+         for (size_t i = 0; i < sats.size(); i++)
+         {
+            for (size_t j = 0; j < times.size(); j++)
+            {
+               gnsstk::Xvt& xvt(expXvts[i*times.size()+j]);
+               xvt = gnsstk::Xvt();
+               if (navLib.getXvt(sats[i], times[j], xvt, gnsstk::ObsID()))
+                  expCount++;
+               else
+                  xvt.health = gnsstk::Xvt::Unavailable;
+            }
+         }
+      }
+      double loopNs = seconds(t0) / (double(reps) * total) * 1e9;
+      std::cout << total << " results (" << expCount << " found): loop "
+                << loopNs << " ns/result";
+      gnsstk::ThreadPool *pools[] = { nullptr, nullptr, nullptr };
+      gnsstk::ThreadPool pool2(2), pool4(4);
+      pools[1] = &pool2;
+      pools[2] = &pool4;
+      const char *names[] = { "getXvts", "pool(2)", "pool(4)" };
+      for (unsigned p = 0; p < 3; p++)
+      {
+         std::vector<gnsstk::Xvt> xvts;
+         size_t count = 0;
+         t0 = clock::now();
+         for (unsigned r = 0; r < reps; r++)
+         {
+            count = navLib.getXvts(sats, times, xvts, gnsstk::ObsID(),
+                                   gnsstk::SVHealth::Any,
+                                   gnsstk::NavValidityType::ValidOnly,
+                                   gnsstk::NavSearchOrder::User, pools[p]);
+         }
+         double ns = seconds(t0) / (double(reps) * total) * 1e9;
+         std::cout << ", " << names[p] << " " << ns << " ns/result";
+         mismatch += (count != expCount);
+         for (size_t k = 0; k < total; k++)
+            mismatch += !same(expXvts[k], xvts[k]);
+      }
+      std::cout << std::endl;
+   }
+      // Fixed cost of spreading one loop over 4 threads.
+   const unsigned reps = 2000;
+   gnsstk::ThreadPool pool4(4);
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      pool4.run(4, [](size_t, size_t) {});
+   double poolUs = seconds(t0) / reps * 1e6;
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      std::vector<std::thread> threads;
+      for (unsigned t = 0; t < 4; t++)
+         threads.emplace_back([]() {});
+      for (auto& thr : threads)
+         thr.join();
+   }
+   double spawnUs = seconds(t0) / reps * 1e6;
+   std::cout << "empty 4-way loop: pool " << poolUs << " us, new threads "
+             << spawnUs << " us" << std::endl;
+   std::cout << "(" << mismatch << " mismatched)" << std::endl;
+   return mismatch != 0;
+}
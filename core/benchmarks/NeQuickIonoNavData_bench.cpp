@@ -0,0 +1,150 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file NeQuickIonoNavData_bench.cpp
+ * Time NeQuickIonoNavData::getTEC() one satellite at a time and one
+ * receiver epoch at a time over a grid of stations and satellites,
+ * and report the largest difference between the two. */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "NeQuickIonoNavData.hpp"
+#include "GalileoIonoEllipsoid.hpp"
+#include "CivilTime.hpp"
+
+using namespace std;
+
+
+   /// NeQuickIonoNavData is abstract; this is the simplest concrete one.
+class BenchNeQuick : public gnsstk::NeQuickIonoNavData
+{
+public:
+   gnsstk::NavDataPtr clone() const override
+   { return std::make_shared<BenchNeQuick>(*this); }
+};
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   gnsstk::GalileoIonoEllipsoid galEll;
+   BenchNeQuick uut;
+      // high solar activity coefficients from Annex E of galileo:iono
+   uut.ai[0] = 236.831641;
+   uut.ai[1] = -0.39362878;
+   uut.ai[2] = 0.00402826613;
+      // 30 stations, each seeing 8 satellites at 6 times of day
+   vector<gnsstk::Position> stations;
+   vector<vector<gnsstk::Position> > sats;
+   for (double lat = -60; lat <= 60; lat += 30)
+   {
+      for (double lon = 0; lon < 360; lon += 60)
+      {
+         stations.push_back(gnsstk::Position(lat, lon, 100.0,
+                                             gnsstk::Position::Geodetic,
+                                             &galEll));
+         vector<gnsstk::Position> svgeo;
+         for (unsigned k = 0; k < 8; k++)
+         {
+            double az = k * 45.0 * gnsstk::DEG_TO_RAD;
+            double slat = std::max(-80.0, std::min(80.0,
+                                                   lat + 30.0*::cos(az)));
+            svgeo.push_back(gnsstk::Position(slat, lon + 30.0*::sin(az),
+                                             20200000.0,
+                                             gnsstk::Position::Geodetic,
+                                             &galEll));
+         }
+         sats.push_back(svgeo);
+      }
+   }
+   vector<gnsstk::CommonTime> times;
+   for (int hour = 0; hour < 24; hour += 4)
+   {
+      times.push_back(gnsstk::CivilTime(2525,4,1,hour,0,0.0,
+                                        gnsstk::TimeSystem::UTC));
+   }
+   const unsigned reps = 2;
+   vector<double> single, batch, tec;
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      single.clear();
+      for (const auto& when : times)
+         for (unsigned s = 0; s < stations.size(); s++)
+            for (const auto& sv : sats[s])
+               single.push_back(uut.getTEC(when, stations[s], sv));
+   }
+   double dtSingle = std::chrono::duration<double>(clock::now() - t0).count();
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      batch.clear();
+      for (const auto& when : times)
+      {
+         for (unsigned s = 0; s < stations.size(); s++)
+         {
+            uut.getTEC(when, stations[s], sats[s], tec);
+            batch.insert(batch.end(), tec.begin(), tec.end());
+         }
+      }
+   }
+   double dtBatch = std::chrono::duration<double>(clock::now() - t0).count();
+   double maxDiff = 0;
+   for (unsigned i = 0; i < single.size(); i++)
+      maxDiff = max(maxDiff, fabs(single[i] - batch[i]));
+   unsigned rays = reps * single.size();
+   cout << rays << " rays in " << reps * times.size() * stations.size()
+        << " epochs" << endl
+        << fixed << setprecision(3)
+        << "one satellite at a time: " << setw(8) << dtSingle << " s  "
+        << setprecision(1) << setw(7) << (dtSingle / rays * 1e6) << " us/ray"
+        << endl << setprecision(3)
+        << "one epoch at a time:     " << setw(8) << dtBatch << " s  "
+        << setprecision(1) << setw(7) << (dtBatch / rays * 1e6) << " us/ray"
+        << endl << scientific << setprecision(2)
+        << "max |single - batch| " << maxDiff << endl;
+   return 0;
+}
@@ -0,0 +1,500 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file PRSolution_bench.cpp
+ * Time PRSolution RAIM on synthetic 1 Hz GPS data: the old method of
+ * calling SimplePRSolution() for every subset against RAIMCompute()
+ * with one and with all hardware threads, and RAIMComputeEpochs() with
+ * and without memory for 1 to all hardware threads.  All methods must
+ * give the same solutions. */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "PRSolution.hpp"
+#include "Combinations.hpp"
+#include "RinexNavDataFactory.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GGTropModel.hpp"
+#include "CivilTime.hpp"
+
+class PRSolution_bench
+{
+public:
+   PRSolution_bench();
+      /** Time RAIMCompute() and RAIMComputeEpochs() on 1 Hz data, in
+       * epochs per second.
+       * @return 0 if all the methods agree, 1 otherwise. */
+   int run();
+
+private:
+      /// Fill navLib with ephemerides for 30 GPS satellites.
+   void makeEphemeris();
+      /// Fill eps with count epochs of the pseudoranges of the visible
+      /// satellites, every interval seconds.
+   void makeData(std::vector<gnsstk::PRSolutionEpoch>& eps, unsigned count,
+                 double interval);
+      /// Compute a RAIM solution as RAIMCompute() did before it solved the
+      /// subsets itself: SimplePRSolution() for each combination of
+      /// excluded satellites, keeping the best. Returns as RAIMCompute(),
+      /// and the results in ep.
+   static int referenceRAIM(gnsstk::PRSolution& prs,
+                            gnsstk::PRSolutionEpoch& ep,
+                            const gnsstk::Matrix<double>& SVP,
+                            gnsstk::TropModel *pTropModel);
+      /// Count the differences between two results
+   static unsigned compare(const gnsstk::PRSolutionEpoch& a,
+                           const gnsstk::PRSolutionEpoch& b,
+                           double tol);
+      /// Count the differences between all the results of two epochs
+   static unsigned compareAll(const gnsstk::PRSolutionEpoch& a,
+                              const gnsstk::PRSolutionEpoch& b);
+      /// Count the differences between two vectors
+   static unsigned compare(const gnsstk::Vector<double>& a,
+                           const gnsstk::Vector<double>& b);
+      /// Count the differences between two matrices
+   static unsigned compare(const gnsstk::Matrix<double>& a,
+                           const gnsstk::Matrix<double>& b);
+      /// Configure a PRSolution for the data
+   static void configure(gnsstk::PRSolution& prs);
+
+   gnsstk::CommonTime ct;
+   gnsstk::NavLibrary navLib;
+   gnsstk::Position rx;
+};
+
+
+PRSolution_bench ::
+PRSolution_bench()
+      : ct(gnsstk::CivilTime(2015,7,19,2,0,0.0,gnsstk::TimeSystem::GPS))
+{
+   rx.setECEF(-740290.0, -5457071.7, 3207245.6);
+   makeEphemeris();
+   }
+
+
+void PRSolution_bench ::
+makeEphemeris()
+{
+   std::shared_ptr<gnsstk::RinexNavDataFactory> fact(
+      std::make_shared<gnsstk::RinexNavDataFactory>());
+   gnsstk::NavDataFactoryPtr ndfp(fact);
+   navLib.addFactory(ndfp);
+   for (unsigned long prn = 1; prn <= 30; prn++)
+   {
+      gnsstk::NavSatelliteID sat(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV);
+      for (unsigned i = 0; i < 3; i++)
+      {
+         std::shared_ptr<gnsstk::GPSLNavEph> eph(
+            std::make_shared<gnsstk::GPSLNavEph>());
+         eph->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Ephemeris);
+         eph->timeStamp = ct + (7200.0*i - 7200.0);
+         eph->xmitTime = eph->xmit2 = eph->xmit3 = eph->timeStamp;
+         eph->Toe = eph->Toc = eph->timeStamp + 7200.0;
+         eph->A = 26559700.0;
+         eph->Ahalf = ::sqrt(eph->A);
+         eph->ecc = 0.005;
+         eph->i0 = 0.96;
+            // six planes of five satellites
+         eph->OMEGA0 = 1.0472 * ((prn-1) % 6);
+         eph->M0 = 1.2566 * ((prn-1) / 6) + 0.2 * ((prn-1) % 6)
+            + 0.000146 * 7200.0 * i;
+         eph->w = 0.1;
+         eph->af0 = 1e-5 * prn;
+         eph->health = gnsstk::SVHealth::Healthy;
+         eph->fixFit();
+         fact->addNavData(eph);
+      }
+   }
+   navLib.freeze();
+}
+
+
+void PRSolution_bench ::
+makeData(std::vector<gnsstk::PRSolutionEpoch>& eps, unsigned count,
+         double interval)
+{
+   gnsstk::GPSEllipsoid ellip;
+   gnsstk::GGTropModel trop;
+   gnsstk::PRSolution prs;
+   configure(prs);
+   unsigned seed = 12345;
+   for (unsigned e = 0; e < count; e++)
+   {
+      gnsstk::PRSolutionEpoch ep;
+      ep.time = ct + interval*e;
+         // receiver clock (m)
+      double clk = 1000.0 + 0.1*e;
+      for (unsigned long prn = 1; prn <= 30; prn++)
+      {
+         gnsstk::SatID sat(prn, gnsstk::SatelliteSystem::GPS);
+         gnsstk::Xvt xvt;
+         if (!navLib.getXvt(gnsstk::NavSatelliteID(sat), ep.time, xvt))
+            continue;
+         gnsstk::Position sv(xvt.x[0], xvt.x[1], xvt.x[2]);
+         if (rx.elevation(sv) < 10.0)
+            continue;
+         ep.Satellites.push_back(sat);
+         ep.Pseudorange.push_back(2.2e7);
+      }
+         // iterate to get the transmit time right
+      for (unsigned iter = 0; iter < 3; iter++)
+      {
+         std::vector<gnsstk::SatID> sats(ep.Satellites);
+         gnsstk::Matrix<double> SVP;
+         prs.PreparePRSolution(ep.time, sats, ep.Pseudorange, navLib, SVP);
+         for (unsigned i = 0; i < sats.size(); i++)
+         {
+            double corr = SVP(i,3) - ep.Pseudorange[i];
+            double rho = gnsstk::RSS(SVP(i,0)-rx.X(), SVP(i,1)-rx.Y(),
+                                     SVP(i,2)-rx.Z());
+            double wt = ellip.angVelocity()*rho/ellip.c();
+            gnsstk::Position sv( ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1),
+                                -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1),
+                                 SVP(i,2));
+            rho = gnsstk::RSS(sv.X()-rx.X(), sv.Y()-rx.Y(), sv.Z()-rx.Z());
+            ep.Pseudorange[i] = rho + clk - corr
+               + trop.correction(rx, sv, ep.time);
+         }
+      }
+         // uniform noise of about a meter, and a fault every fifth epoch
+      for (unsigned i = 0; i < ep.Pseudorange.size(); i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         ep.Pseudorange[i] += ((seed >> 8) % 2000) / 1000.0 - 1.0;
+      }
+      if ((e % 5) == 0)
+      {
+         ep.Pseudorange[e % ep.Pseudorange.size()] += 100.0;
+      }
+      eps.push_back(ep);
+   }
+}
+
+
+void PRSolution_bench ::
+configure(gnsstk::PRSolution& prs)
+{
+   prs.allowedGNSS.push_back(gnsstk::SatelliteSystem::GPS);
+   prs.RMSLimit = 3.0;
+}
+
+
+unsigned PRSolution_bench ::
+compare(const gnsstk::PRSolutionEpoch& a, const gnsstk::PRSolutionEpoch& b,
+        double tol)
+{
+   unsigned diffs = 0;
+   if ((a.iret != b.iret) || (a.Satellites != b.Satellites) ||
+       (a.Solution.size() != b.Solution.size()))
+   {
+      return 1;
+   }
+   for (unsigned i = 0; i < a.Solution.size(); i++)
+   {
+      if (::fabs(a.Solution[i] - b.Solution[i]) > tol)
+         diffs++;
+   }
+   if (::fabs(a.RMSResidual - b.RMSResidual) > tol)
+      diffs++;
+   return diffs;
+}
+
+
+unsigned PRSolution_bench ::
+compareAll(const gnsstk::PRSolutionEpoch& a, const gnsstk::PRSolutionEpoch& b)
+{
+   unsigned diffs = compare(a, b, 0.0);
+   diffs += compare(a.Covariance, b.Covariance);
+   diffs += compare(a.invMeasCov, b.invMeasCov);
+   diffs += compare(a.Partials, b.Partials);
+   diffs += compare(a.PreFitResidual, b.PreFitResidual);
+   if ((a.Valid != b.Valid) ||
+       (a.dataGNSS != b.dataGNSS) ||
+       (a.MaxSlope != b.MaxSlope) ||
+       (a.TDOP != b.TDOP) || (a.PDOP != b.PDOP) || (a.GDOP != b.GDOP) ||
+       (a.NIterations != b.NIterations) ||
+       (a.Convergence != b.Convergence) ||
+       (a.Nsvs != b.Nsvs) ||
+       (a.TropFlag != b.TropFlag) ||
+       (a.RMSFlag != b.RMSFlag) ||
+       (a.SlopeFlag != b.SlopeFlag))
+   {
+      diffs++;
+   }
+   return diffs;
+}
+
+
+unsigned PRSolution_bench ::
+compare(const gnsstk::Matrix<double>& a, const gnsstk::Matrix<double>& b)
+{
+   if ((a.rows() != b.rows()) || (a.cols() != b.cols()))
+      return 1;
+   unsigned diffs = 0;
+   for (unsigned i = 0; i < a.rows(); i++)
+   {
+      for (unsigned j = 0; j < a.cols(); j++)
+      {
+         if (a(i,j) != b(i,j))
+            diffs++;
+      }
+   }
+   return diffs;
+}
+
+
+unsigned PRSolution_bench ::
+compare(const gnsstk::Vector<double>& a, const gnsstk::Vector<double>& b)
+{
+   if (a.size() != b.size())
+      return 1;
+   unsigned diffs = 0;
+   for (unsigned i = 0; i < a.size(); i++)
+   {
+      if (a[i] != b[i])
+         diffs++;
+   }
+   return diffs;
+}
+
+
+int PRSolution_bench ::
+referenceRAIM(gnsstk::PRSolution& prs, gnsstk::PRSolutionEpoch& ep,
+              const gnsstk::Matrix<double>& SVP, gnsstk::TropModel *pTropModel)
+{
+   const std::vector<gnsstk::SatID> saveSats(ep.Satellites);
+   std::vector<gnsstk::SatID>& sats(ep.Satellites);
+   std::vector<int> good;
+   for (unsigned i = 0; i < sats.size(); i++)
+   {
+      if (sats[i].id > 0)
+         good.push_back(i);
+   }
+   const int N = good.size();
+   gnsstk::Vector<double> resids, slopes;
+   std::vector<gnsstk::SatID> bestSats;
+   int iret = 0, bestIret = -5;
+   double bestRMS = -1.0;
+
+   for (int stage = 0; ; stage++)
+   {
+      gnsstk::Combinations combo(N, stage);
+      do
+      {
+         sats = saveSats;
+         for (int i = 0; i < N; i++)
+         {
+            if (combo.isSelected(i))
+               sats[good[i]].id = -::abs(sats[good[i]].id);
+         }
+         iret = prs.SimplePRSolution(ep.time, sats, SVP, ep.invMC,
+                                     pTropModel, prs.MaxNIterations,
+                                     prs.ConvergenceLimit, resids, slopes);
+         if (iret <= 0 && iret > bestIret)
+            bestIret = iret;
+         if (iret == -1 || iret == -2)
+            continue;
+         if (iret == -3)
+            break;
+         if (bestRMS < 0.0 || prs.RMSResidual < bestRMS)
+         {
+            bestRMS = prs.RMSResidual;
+            bestSats = sats;
+            bestIret = iret;
+            ep.Solution = prs.Solution;
+            ep.RMSResidual = prs.RMSResidual;
+            ep.MaxSlope = prs.MaxSlope;
+            ep.Nsvs = prs.Nsvs;
+            ep.TropFlag = prs.TropFlag;
+         }
+         if (stage == 0 && prs.RMSResidual < prs.RMSLimit)
+            break;
+      } while (combo.Next() != -1);
+
+      if (bestRMS > 0.0 && bestRMS < prs.RMSLimit)
+      {
+         iret = 0;
+         break;
+      }
+      if ((prs.NSatsReject > -1 && stage+1 > prs.NSatsReject) || iret == -3)
+         break;
+   }
+
+   if (iret >= 0)
+   {
+      sats = bestSats;
+      iret = bestIret;
+      if (iret == 0 &&
+          (ep.MaxSlope > prs.SlopeLimit ||
+           (ep.MaxSlope > prs.SlopeLimit/2.0 && ep.Nsvs == 5) ||
+           bestRMS >= prs.RMSLimit || ep.TropFlag))
+      {
+         iret = 1;
+      }
+   }
+   ep.iret = iret;
+   return iret;
+}
+
+
+int PRSolution_bench ::
+run()
+{
+   std::vector<gnsstk::PRSolutionEpoch> all, faulted;
+   makeData(all, 600, 1.0);
+   for (unsigned e = 0; e < all.size(); e += 5)
+      faulted.push_back(all[e]);
+   gnsstk::GGTropModel trop;
+   const unsigned nhw = std::max(1u, std::thread::hardware_concurrency());
+   const char *methods[] = { "SimplePRSolution per subset",
+                             "RAIMCompute, NThreads 1    ",
+                             "RAIMCompute, NThreads all  " };
+   unsigned diffs = 0;
+
+   std::cout << "PRSolution RAIM on 1 Hz data, " << nhw << " hardware threads"
+             << std::endl;
+   for (const auto *data : { &all, &faulted })
+   {
+      std::cout << "  " << data->size() << " epochs"
+                << (data == &faulted ? ", all with a fault" : "")
+                << std::endl;
+         // 0: SimplePRSolution() for every subset, 1: RAIMCompute() with
+         // one thread, 2: RAIMCompute() with a thread per core
+      std::vector<std::vector<gnsstk::PRSolutionEpoch> > results;
+      for (int method = 0; method < 3; method++)
+      {
+            // the best of several passes
+         std::vector<gnsstk::PRSolutionEpoch> got;
+         double best = 0.0;
+         for (unsigned pass = 0; pass < 5; pass++)
+         {
+            gnsstk::PRSolution prs;
+            configure(prs);
+            prs.NThreads = (method == 2 ? nhw : 1);
+            got = *data;
+            auto start = std::chrono::steady_clock::now();
+            for (auto& ep : got)
+            {
+               gnsstk::Matrix<double> SVP;
+               prs.PreparePRSolution(ep.time, ep.Satellites, ep.Pseudorange,
+                                     navLib, SVP);
+               if (method == 0)
+               {
+                  referenceRAIM(prs, ep, SVP, &trop);
+                  continue;
+               }
+               ep.iret = prs.RAIMCompute(ep.time, ep.Satellites, SVP,
+                                         ep.invMC, &trop);
+               ep.Solution = prs.Solution;
+               ep.RMSResidual = prs.RMSResidual;
+            }
+            std::chrono::duration<double> dt =
+               std::chrono::steady_clock::now() - start;
+            best = std::max(best, got.size() / dt.count());
+         }
+         std::cout << "    " << methods[method] << " " << best
+                   << " epochs/s" << std::endl;
+         results.push_back(got);
+      }
+      for (unsigned i = 0; i < data->size(); i++)
+      {
+         diffs += compare(results[0][i], results[1][i], 1e-7);
+         diffs += compare(results[1][i], results[2][i], 0.0);
+      }
+   }
+
+      // RAIMComputeEpochs() with and without memory, for 1 to nhw threads
+   std::vector<gnsstk::GGTropModel> trops(nhw);
+   std::cout << "  RAIMComputeEpochs, " << all.size() << " epochs"
+             << std::endl;
+   for (bool memory : { false, true })
+   {
+      std::vector<gnsstk::PRSolutionEpoch> first;
+      for (unsigned nThreads = 1; nThreads <= nhw; nThreads *= 2)
+      {
+         std::vector<gnsstk::TropModel*> pTrops;
+         for (unsigned t = 0; t < nThreads; t++)
+            pTrops.push_back(&trops[t]);
+         std::vector<gnsstk::PRSolutionEpoch> got;
+         double best = 0.0;
+         for (unsigned pass = 0; pass < 5; pass++)
+         {
+            gnsstk::PRSolution prs;
+            configure(prs);
+            prs.hasMemory = memory;
+            prs.NThreads = nThreads;
+            got = all;
+            auto start = std::chrono::steady_clock::now();
+            prs.RAIMComputeEpochs(got, navLib, pTrops);
+            std::chrono::duration<double> dt =
+               std::chrono::steady_clock::now() - start;
+            best = std::max(best, got.size() / dt.count());
+         }
+         std::cout << "    " << (memory ? "memory,    " : "no memory, ")
+                   << nThreads << " threads " << best << " epochs/s"
+                   << std::endl;
+         if (first.empty())
+            first = got;
+         for (unsigned i = 0; i < got.size(); i++)
+            diffs += compareAll(first[i], got[i]);
+      }
+   }
+   std::cout << "  differences " << diffs << std::endl;
+   return (diffs == 0 ? 0 : 1);
+}
+
+
+int main()
+{
+   PRSolution_bench bench;
+   return bench.run();
+}
@@ -0,0 +1,125 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file PackedNavBits_bench.cpp
+ * Compare the rate at which PackedNavBits::asUnsignedLong() decodes
+ * fields with a bit-by-bit extraction of the same fields. */
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "PackedNavBits.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+
+   /// Extract a field one bit at a time, as the original decoder did.
+static uint64_t refField(const std::vector<bool>& ref, size_t start,
+                         size_t num)
+{
+   uint64_t rv = 0;
+   for (size_t i = start; i < start+num; i++)
+   {
+      rv <<= 1;
+      if (ref[i]) rv++;
+   }
+   return rv;
+}
+
+
+   /// Build a PackedNavBits of numBits random bits along with a copy
+   /// of those bits in a vector<bool>.
+static void randomPNB(std::mt19937& gen, size_t numBits, PackedNavBits& pnb,
+                      std::vector<bool>& ref)
+{
+   ref.clear();
+   while (ref.size() < numBits)
+   {
+      int n = 1 + gen() % 32;
+      if (ref.size() + n > numBits)
+         n = numBits - ref.size();
+      unsigned long value = gen() & (0xFFFFFFFFUL >> (32-n));
+      pnb.addUnsignedLong(value, n, 1);
+      for (int i = n-1; i >= 0; i--)
+         ref.push_back((value >> i) & 1);
+   }
+   pnb.trimsize();
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   std::mt19937 gen(1);
+   PackedNavBits pnb;
+   std::vector<bool> ref;
+   randomPNB(gen, 300, pnb, ref);
+   std::vector<unsigned> starts, widths;
+   for (unsigned i = 0; i < 1024; i++)
+   {
+      widths.push_back(1 + gen() % 32);
+      starts.push_back(gen() % (300 - widths.back() + 1));
+   }
+   const unsigned reps = 2000;
+   unsigned long sum = 0;
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 0; i < starts.size(); i++)
+         sum += pnb.asUnsignedLong(starts[i], widths[i], 1);
+   clock::time_point t1 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (unsigned i = 0; i < starts.size(); i++)
+         sum -= refField(ref, starts[i], widths[i]);
+   clock::time_point t2 = clock::now();
+   double fields = double(reps) * starts.size();
+   cout << "PackedNavBits: "
+        << fields / std::chrono::duration<double>(t1-t0).count() * 1e-6
+        << " Mfields/s" << endl
+        << "bit by bit:    "
+        << fields / std::chrono::duration<double>(t2-t1).count() * 1e-6
+        << " Mfields/s" << endl;
+      // the two decoders must agree
+   return sum != 0;
+}
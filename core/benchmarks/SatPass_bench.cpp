@@ -0,0 +1,198 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file SatPass_bench.cpp
+ * Time filling SatPass objects by label and by handle, and reading
+ * them back by label, by handle, by column and with SatPassIterator. */
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CivilTime.hpp"
+#include "SatPass.hpp"
+#include "SatPassIterator.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+
+   /// synthetic value for obs type k of prn at count n; exact in F14.3
+static double value(int prn, int k, int n)
+{
+   return 20000000.0 + 1000000.0 * k + 1000.0 * prn + 0.125 * n;
+}
+
+
+   /** Build nprn satellites with three passes each of 30 second data, with
+    * obs types L1 L2 C1 P2 S1, filled by label or by handle. */
+static vector<SatPass> makePasses(int nprn, bool byHandle)
+{
+   vector<string> ots;
+   ots.push_back("L1");
+   ots.push_back("L2");
+   ots.push_back("C1");
+   ots.push_back("P2");
+   ots.push_back("S1");
+      // labels in another order, to add data by label
+   vector<string> rots(ots.rbegin(), ots.rend());
+   vector<double> data(ots.size());
+   vector<unsigned short> lli(ots.size()), ssi(ots.size());
+
+   Epoch t0(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   vector<SatPass> passes;
+   for (int p = 0; p < 3; p++)
+   {
+      for (int prn = 1; prn <= nprn; prn++)
+      {
+         SatPass sp(RinexSatID(prn, SatelliteSystem::GPS), 30.0, ots);
+         int start = p * 1000 + (prn * 7) % 50;
+         int npts = 200 + (prn * 37 + p * 53) % 300;
+         for (int i = 0; i < npts; i++)
+         {
+            Epoch tt(t0);
+            tt += 30.0 * (start + i);
+            for (unsigned k = 0; k < ots.size(); k++)
+            {
+               unsigned kk(byHandle ? k : ots.size() - 1 - k);
+               data[kk] = value(prn, k, start + i);
+               lli[kk] = (i % 11 == 0 ? 1 : 0);
+               ssi[kk] = 5 + k;
+            }
+            if (byHandle)
+               sp.addData(tt, data, lli, ssi);
+            else
+               sp.addData(tt, rots, data, lli, ssi);
+         }
+         passes.push_back(sp);
+      }
+   }
+   return passes;
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   const int nsites(20);
+   clock::time_point t0 = clock::now();
+   vector<SatPass> passes;
+   for (int s = 0; s < nsites; s++)
+   {
+      vector<SatPass> one(makePasses(32, false));
+      passes.insert(passes.end(), one.begin(), one.end());
+   }
+   double dt = std::chrono::duration<double>(clock::now() - t0).count();
+   size_t npts(0);
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      npts += passes[i].size();
+   }
+   cout << passes.size() << " passes, " << npts << " epochs, 5 obs types"
+        << endl;
+   cout << "fill by label:     " << fixed << setprecision(3) << setw(8) << dt
+        << " s" << endl;
+
+   t0 = clock::now();
+   passes.clear();
+   for (int s = 0; s < nsites; s++)
+   {
+      vector<SatPass> one(makePasses(32, true));
+      passes.insert(passes.end(), one.begin(), one.end());
+   }
+   dt = std::chrono::duration<double>(clock::now() - t0).count();
+   cout << "fill by handle:    " << setw(8) << dt << " s" << endl;
+
+   double sum(0.0);
+   t0 = clock::now();
+   for (unsigned p = 0; p < passes.size(); p++)
+   {
+      for (unsigned i = 0; i < passes[p].size(); i++)
+      {
+         sum += passes[p].data(i, "L1") - passes[p].data(i, "P2");
+      }
+   }
+   dt = std::chrono::duration<double>(clock::now() - t0).count();
+   cout << "read by label:     " << setw(8) << dt << " s" << endl;
+
+   t0 = clock::now();
+   for (unsigned p = 0; p < passes.size(); p++)
+   {
+      unsigned kL1(passes[p].obsIndex("L1")), kP2(passes[p].obsIndex("P2"));
+      for (unsigned i = 0; i < passes[p].size(); i++)
+      {
+         sum += passes[p].data(i, kL1) - passes[p].data(i, kP2);
+      }
+   }
+   dt = std::chrono::duration<double>(clock::now() - t0).count();
+   cout << "read by handle:    " << setw(8) << dt << " s" << endl;
+
+   t0 = clock::now();
+   for (unsigned p = 0; p < passes.size(); p++)
+   {
+      const SatPass& sp(passes[p]);
+      const double *L1(sp.dataColumn(sp.obsIndex("L1")));
+      const double *P2(sp.dataColumn(sp.obsIndex("P2")));
+      for (unsigned i = 0; i < sp.size(); i++)
+      {
+         sum += L1[i] - P2[i];
+      }
+   }
+   dt = std::chrono::duration<double>(clock::now() - t0).count();
+   cout << "read by column:    " << setw(8) << dt << " s" << endl;
+
+   t0 = clock::now();
+   {
+      vector<SatPass> site(passes.begin(), passes.begin() + passes.size() / nsites);
+      SatPassIterator spit(site);
+      RinexObsData robs;
+      while (spit.next(robs))
+      {
+         sum += robs.numSvs;
+      }
+   }
+   dt = std::chrono::duration<double>(clock::now() - t0).count();
+   cout << "iterate one site:  " << setw(8) << dt << " s" << endl;
+   cout << "(checksum " << sum << ")" << endl;
+   return 0;
+}
@@ -0,0 +1,180 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file StringUtils_bench.cpp
+ * Compare the decode rate of RINEX observation fields in place, by
+ * StringUtils::asDouble(const char*,size_t) and
+ * RinexDatum::fromString(), with the substring and strtod path. */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "StringUtils.hpp"
+#include "RinexDatum.hpp"
+
+using namespace gnsstk::StringUtils;
+
+
+   /** Decode a RINEX datum the way RinexDatum::fromString() did
+    * before it decoded in place. */
+static void oldFromString(const std::string& str, gnsstk::RinexDatum& rd)
+{
+   std::string tmpStr = str.substr(0, 14);
+   if (tmpStr.find_last_not_of(" ") == std::string::npos)
+   {
+      rd.data = 0.;
+      rd.dataBlank = true;
+   }
+   else
+   {
+      rd.data = asDouble(tmpStr);
+      rd.dataBlank = false;
+   }
+   tmpStr = str.substr(14, 1);
+   rd.lliBlank = (tmpStr == " ");
+   rd.lli = (rd.lliBlank ? 0 : asInt(tmpStr));
+   tmpStr = str.substr(15, 1);
+   rd.ssiBlank = (tmpStr == " ");
+   rd.ssi = (rd.ssiBlank ? 0 : asInt(tmpStr));
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+      // RINEX 3 observation records with 8 data each
+   const unsigned numLines = 10000, numData = 8;
+   std::vector<std::string> lines;
+   unsigned long long seed = 12345;
+   for (unsigned l = 0; l < numLines; l++)
+   {
+      std::string line("G01");
+      for (unsigned d = 0; d < numData; d++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         long long ival = (seed >> 20) % 10000000000000LL;
+         char buf[32];
+         int lli = (d & 1) ? ' ' : static_cast<int>('0' + (seed>>8) % 10);
+         int ssi = static_cast<int>('0' + (seed >> 12) % 10);
+         snprintf(buf, sizeof(buf), "%14.3f%c%c", ival / 1000., lli, ssi);
+         line += buf;
+      }
+      lines.push_back(line);
+   }
+   const unsigned reps = 5;
+   double fields = double(reps) * numLines * numData * 1e-6;
+   double sum = 0;
+   unsigned long mismatch = 0;
+      // double fields only
+   clock::time_point t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (const auto& line : lines)
+         for (unsigned d = 0; d < numData; d++)
+            sum += asDouble(line.substr(3+d*16, 14));
+   clock::time_point t1 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+      for (const auto& line : lines)
+         for (unsigned d = 0; d < numData; d++)
+            sum -= asDouble(line.data()+3+d*16, 14);
+   clock::time_point t2 = clock::now();
+   std::cout << "asDouble(substr):       "
+             << fields / std::chrono::duration<double>(t1-t0).count()
+             << " Mfields/s" << std::endl
+             << "asDouble(char*,len):    "
+             << fields / std::chrono::duration<double>(t2-t1).count()
+             << " Mfields/s" << std::endl;
+      // whole datum including LLI and SSI
+   gnsstk::RinexDatum oldrd, newrd;
+   t0 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (const auto& line : lines)
+      {
+         for (unsigned d = 0; d < numData; d++)
+         {
+            oldFromString(line.substr(3+d*16, 16), oldrd);
+            sum += oldrd.data + oldrd.lli + oldrd.ssi;
+         }
+      }
+   }
+   t1 = clock::now();
+   for (unsigned r = 0; r < reps; r++)
+   {
+      for (const auto& line : lines)
+      {
+         for (unsigned d = 0; d < numData; d++)
+         {
+            newrd.fromString(line, 3+d*16);
+            sum -= newrd.data + newrd.lli + newrd.ssi;
+         }
+      }
+   }
+   t2 = clock::now();
+   for (const auto& line : lines)
+   {
+      for (unsigned d = 0; d < numData; d++)
+      {
+         oldFromString(line.substr(3+d*16, 16), oldrd);
+         newrd.fromString(line, 3+d*16);
+         if ((oldrd.data != newrd.data) ||
+             (oldrd.dataBlank != newrd.dataBlank) ||
+             (oldrd.lli != newrd.lli) ||
+             (oldrd.lliBlank != newrd.lliBlank) ||
+             (oldrd.ssi != newrd.ssi) ||
+             (oldrd.ssiBlank != newrd.ssiBlank))
+         {
+            mismatch++;
+         }
+      }
+   }
+   std::cout << "old RinexDatum decode:  "
+             << fields / std::chrono::duration<double>(t1-t0).count()
+             << " Mdatum/s" << std::endl
+             << "RinexDatum::fromString: "
+             << fields / std::chrono::duration<double>(t2-t1).count()
+             << " Mdatum/s" << std::endl
+             << "(" << sum << ", " << mismatch << " mismatched)"
+             << std::endl;
+   return mismatch != 0;
+}
@@ -0,0 +1,195 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file TropModel_bench.cpp
+ * Time TropModel::correction() one satellite at a time against
+ * TropModel::batchCorrection() for each model, and
+ * GlobalTropModel::setParameters() for many stationary receivers with
+ * and without the coefficient cache. */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "TropModel.hpp"
+#include "GlobalTropModel.hpp"
+#include "NeillTropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "GCATTropModel.hpp"
+#include "MOPSTropModel.hpp"
+#include "SimpleTropModel.hpp"
+#include "CivilTime.hpp"
+
+using namespace gnsstk;
+using namespace std;
+
+
+/// Satellites spread over the sky of rx, including below the horizon.
+static void makeSatellites(const Position& rx, vector<Position>& svs)
+{
+   Position rxECEF(rx);
+   rxECEF.transformTo(Position::Cartesian);
+   Triple up(rxECEF.X(), rxECEF.Y(), rxECEF.Z());
+   up = up.unitVector();
+   Triple east(-rxECEF.Y(), rxECEF.X(), 0.0);
+   east = east.unitVector();
+   Triple north = up.cross(east);
+   const double range = 2.2e7;
+   for (double az = 0; az < 360; az += 37)
+   {
+      for (double el = -10; el <= 90; el += 2.5)
+      {
+         double ce = ::cos(el*DEG_TO_RAD), se = ::sin(el*DEG_TO_RAD);
+         double ca = ::cos(az*DEG_TO_RAD), sa = ::sin(az*DEG_TO_RAD);
+         svs.push_back(Position(rxECEF.X() + range*(ce*ca*north[0] +
+                                                    ce*sa*east[0] + se*up[0]),
+                                rxECEF.Y() + range*(ce*ca*north[1] +
+                                                    ce*sa*east[1] + se*up[1]),
+                                rxECEF.Z() + range*(ce*ca*north[2] +
+                                                    ce*sa*east[2] + se*up[2])));
+      }
+   }
+}
+
+
+/// Create each model, set up for rx and when.
+static void makeModels(const Position& rx, const CommonTime& when,
+                       const Position& sv,
+                       vector<shared_ptr<TropModel> >& models)
+{
+   models.clear();
+   models.push_back(make_shared<GlobalTropModel>(rx, when));
+   models.push_back(make_shared<NeillTropModel>(rx, when));
+   shared_ptr<SaasTropModel> saas = make_shared<SaasTropModel>();
+   saas->setWeather(20.0, 1013.0, 50.0);
+   models.push_back(saas);
+   models.push_back(make_shared<GCATTropModel>(rx.getAltitude()));
+   models.push_back(make_shared<MOPSTropModel>(rx, when));
+   models.push_back(make_shared<SimpleTropModel>(20.0, 1013.0, 50.0));
+      // set up any receiver and time state
+   for (auto& model : models)
+      model->correction(rx, sv, when);
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   const Position rx(30.38, -97.73, 250.0, Position::Geodetic);
+   const CommonTime when(CivilTime(2022,6,15,12,0,0.0,TimeSystem::GPS));
+   const unsigned reps = 200;
+   vector<Position> svs;
+   makeSatellites(rx, svs);
+   vector<shared_ptr<TropModel> > models;
+   makeModels(rx, when, svs.back(), models);
+   vector<double> delay;
+   double sum = 0;
+   int rv = 0;
+   for (auto& model : models)
+   {
+      auto t0 = clock::now();
+      for (unsigned r = 0; r < reps; r++)
+      {
+         for (const auto& sv : svs)
+            sum += model->correction(rx, sv, when);
+      }
+      double dtSingle = std::chrono::duration<double>(clock::now()-t0).count();
+      t0 = clock::now();
+      for (unsigned r = 0; r < reps; r++)
+      {
+         model->batchCorrection(rx, svs, when, delay);
+         sum += delay[0];
+      }
+      double dtBatch = std::chrono::duration<double>(clock::now()-t0).count();
+      for (unsigned i = 0; i < svs.size(); i++)
+      {
+         if (std::abs(delay[i] - model->correction(rx, svs[i], when)) > 1e-12)
+         {
+            cout << model->name() << " batchCorrection differs for "
+                 << "satellite " << i << endl;
+            rv = 1;
+            break;
+         }
+      }
+      double n = reps * svs.size() * 1e-9;
+      cout << model->name() << " correction " << dtSingle/n
+           << " ns/sat  batchCorrection " << dtBatch/n << " ns/sat" << endl;
+   }
+      // GlobalTropModel::setParameters() for stationary receivers
+   const unsigned stations = 1000, epochs = 100;
+   vector<Position> sta;
+   for (unsigned i = 0; i < stations; i++)
+   {
+      sta.push_back(Position(-60.0 + 120.0*i/stations, 0.36*i, 100.0,
+                             Position::Geodetic));
+   }
+   GlobalTropModel::clearCoefficientCache();
+   for (unsigned mode = 0; mode < 3; mode++)
+   {
+         // 0 = one model for all stations, cache disabled,
+         // 1 = one model for all stations, cache enabled,
+         // 2 = one model (copy) per station
+      GlobalTropModel::setCoefficientCacheSize(
+         mode == 0 ? 0 : GlobalTropModel::DEFAULT_COEFF_CACHE_SIZE);
+      GlobalTropModel global;
+      vector<GlobalTropModel> perStation(stations, global);
+      auto t0 = clock::now();
+      for (unsigned e = 0; e < epochs; e++)
+      {
+         CommonTime t(when + 30.0*e);
+         for (unsigned i = 0; i < stations; i++)
+         {
+            GlobalTropModel& model(mode == 2 ? perStation[i] : global);
+            model.setParameters(t, sta[i]);
+            sum += model.correction(30.0);
+         }
+      }
+      double dt = std::chrono::duration<double>(clock::now()-t0).count();
+      const char *what[] = { "shared model, no cache", "shared model, cache",
+                             "model per station" };
+      cout << "Global setParameters+correction, " << what[mode] << " "
+           << dt/(stations*epochs*1e-9) << " ns/station/epoch" << endl;
+   }
+   cout << "(" << sum << ")" << endl;
+   return rv;
+}
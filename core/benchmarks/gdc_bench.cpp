@@ -0,0 +1,227 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+
+
+/** @file gdc_bench.cpp
+ * Time the discontinuity corrector over a synthetic network day of
+ * passes with 1, 2, 4 and 8 threads, and one pass at a time. */
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CivilTime.hpp"
+#include "FreqConsts.hpp"
+#include "gdc.hpp"
+#include "logstream.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+
+   /** Build a day of synthetic dual-frequency GPS passes for nsites sites,
+    * 30 second data. Some passes have slips, bad data and gaps.
+    * @param[in] nsites number of sites; each has about 90 passes.
+    * @return the passes, in site and time order. */
+static vector<SatPass> makePasses(unsigned nsites)
+{
+   static const double wl1(WAVELENGTH_GPS_L1), wl2(WAVELENGTH_GPS_L2);
+   static const double gamma((FREQ_GPS_L1 / FREQ_GPS_L2) *
+                             (FREQ_GPS_L1 / FREQ_GPS_L2));
+   vector<string> ots;
+   ots.push_back("L1");
+   ots.push_back("L2");
+   ots.push_back("P1");
+   ots.push_back("P2");
+   vector<double> data(4);
+   vector<unsigned short> lli(4, 0), ssi(4, 0);
+      // simple LCG, so the data are the same everywhere
+   unsigned long long seed(12345);
+   auto noise = [&seed](double sig)
+   {
+      double sum(0.0);
+      for (int k = 0; k < 4; k++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         sum += double(seed >> 11) / 9007199254740992.0 - 0.5;
+      }
+      return sum * sig * std::sqrt(3.0);
+   };
+
+   Epoch t0(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   vector<SatPass> passes;
+   unsigned n(0);
+   for (unsigned site = 0; site < nsites; site++)
+   {
+      for (int prn = 1; prn <= 30; prn++)
+      {
+         for (int p = 0; p < 3; p++, n++)
+         {
+            SatPass sp(RinexSatID(prn, SatelliteSystem::GPS), 30.0, ots);
+            int start = (p * 8 + (prn * 7 + site * 3) % 8) * 120;
+            int npts = 300 + (prn * 37 + p * 53 + site * 11) % 300;
+            double N1(1000.0 * prn), N2(800.0 * prn + 17.0 * p);
+            for (int i = 0; i < npts; i++)
+            {
+                  // gap of 5 points in every 4th pass
+               if (n % 4 == 1 && i >= npts / 3 && i < npts / 3 + 5)
+               {
+                  continue;
+               }
+                  // slips on L1 and L2 in every 3rd pass
+               if (n % 3 == 0 && i == npts / 2)
+               {
+                  N1 += 9.0;
+                  N2 += 7.0;
+               }
+               if (n % 5 == 0 && i == 2 * npts / 3)
+               {
+                  N1 += 1.0;
+               }
+               double x = double(i) / npts;
+               double rho = 2.0e7 + 4.0e6 * std::cos(3.14159 * (x - 0.5));
+               double iono = 3.0 + 4.0 * std::sin(3.14159 * x);
+               data[0] = (rho - iono) / wl1 + N1 + noise(0.003);
+               data[1] = (rho - gamma * iono) / wl2 + N2 + noise(0.003);
+               data[2] = rho + iono + noise(0.3);
+               data[3] = rho + gamma * iono + noise(0.3);
+               Epoch tt(t0);
+               tt += 30.0 * (start + i);
+               unsigned short flag(SatPass::OK);
+                  // an outlier in every 7th pass
+               if (n % 7 == 2 && i == npts / 4)
+               {
+                  flag = SatPass::BAD;
+               }
+               sp.addData(tt, ots, data, lli, ssi, flag);
+            }
+            passes.push_back(sp);
+         }
+      }
+   }
+   return passes;
+}
+
+
+   /// Return a gdc configured to fix slips and generate commands.
+static gdc makeGDC()
+{
+   gdc dc;
+   dc.setParameter("doFix", 1);
+   dc.setParameter("doCmds", 1);
+   dc.setParameter("verbose", 1);
+   return dc;
+}
+
+
+   /// Write the L1, L2 and flags of all passes to a string.
+static string dumpPasses(vector<SatPass>& passes)
+{
+   ostringstream oss;
+   oss << setprecision(17);
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      for (unsigned j = 0; j < passes[i].size(); j++)
+      {
+         oss << i << " " << j << " " << passes[i].getFlag(j) << " "
+             << passes[i].data(j, "L1") << " " << passes[i].data(j, "L2")
+             << "\n";
+      }
+   }
+   return oss.str();
+}
+
+
+int main()
+{
+   typedef std::chrono::steady_clock clock;
+   ostringstream log;
+   ostream *saveLog = ConfigureLOGstream::Stream();
+   ConfigureLOGstream::Stream() = &log;
+
+   const vector<SatPass> input(makePasses(30));
+   size_t npts(0);
+   for (unsigned i = 0; i < input.size(); i++)
+   {
+      npts += input[i].size();
+   }
+   cout << input.size() << " passes, " << npts << " points" << endl;
+
+   vector<SatPass> passes(input);
+   vector<string> msgs(input.size());
+   vector<vector<string>> cmds(input.size());
+   gdc seqDC(makeGDC());
+   clock::time_point t0 = clock::now();
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      seqDC.DiscontinuityCorrector(passes[i], msgs[i], cmds[i]);
+   }
+   double dt = std::chrono::duration<double>(clock::now() - t0).count();
+   const string expected(dumpPasses(passes));
+   int rv = 0;
+   cout << "one pass at a time: " << fixed << setprecision(3) << setw(8)
+        << dt << " s" << endl;
+
+   unsigned nthreads[] = { 1, 2, 4, 8 };
+   for (unsigned t = 0; t < 4; t++)
+   {
+      passes = input;
+      vector<int> rets;
+      gdc dc(makeGDC());
+      log.str("");
+      t0 = clock::now();
+      dc.DiscontinuityCorrector(passes, msgs, cmds, rets, nthreads[t]);
+      dt = std::chrono::duration<double>(clock::now() - t0).count();
+      cout << nthreads[t] << " thread(s):        " << setw(8) << dt << " s"
+           << endl;
+      if (dumpPasses(passes) != expected)
+      {
+         cout << "results with " << nthreads[t] << " thread(s) differ" << endl;
+         rv = 1;
+      }
+   }
+
+   ConfigureLOGstream::Stream() = saveLog;
+   return rv;
+}
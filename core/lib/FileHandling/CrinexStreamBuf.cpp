@@ -0,0 +1,563 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file CrinexStreamBuf.cpp
+ * A read-only stream buffer that expands Compact RINEX on the fly
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "CrinexStreamBuf.hpp"
+#include "StringUtils.hpp"
+
+namespace gnsstk
+{
+      /** Apply a Compact RINEX text difference to a string.
+       * A blank leaves the character unchanged, '&' makes it blank,
+       * and anything else replaces it.
+       * @param[in,out] text The text to update.
+       * @param[in] diff The first character of the difference.
+       * @param[in] len The number of characters of difference. */
+   static void applyTextDiff(std::string& text, const char* diff,
+                             std::size_t len)
+   {
+      if (text.size() < len)
+         text.resize(len, ' ');
+      for (std::size_t i = 0; i < len; i++)
+      {
+         if (diff[i] == '&')
+            text[i] = ' ';
+         else if (diff[i] != ' ')
+            text[i] = diff[i];
+      }
+   }
+
+
+      /** Decode an unsigned integer field, blanks being ignored.
+       * @return the value, 0 if the field is blank. */
+   static unsigned parseCount(const std::string& text, std::size_t pos,
+                              std::size_t len)
+   {
+      unsigned rv = 0;
+      for (std::size_t i = pos; (i < pos + len) && (i < text.size()); i++)
+      {
+         if ((text[i] >= '0') && (text[i] <= '9'))
+            rv = rv * 10 + (text[i] - '0');
+      }
+      return rv;
+   }
+
+
+      /** Decode a signed integer.
+       * @return false if [begin,end) is not an integer. */
+   static bool parseInteger(const char* begin, const char* end,
+                            long long& value)
+   {
+      bool neg = false;
+      if ((begin < end) && ((*begin == '-') || (*begin == '+')))
+      {
+         neg = (*begin == '-');
+         begin++;
+      }
+      if (begin == end)
+         return false;
+      unsigned long long mag = 0;
+      for (; begin < end; begin++)
+      {
+         if ((*begin < '0') || (*begin > '9'))
+            return false;
+         mag = mag * 10 + (*begin - '0');
+      }
+      value = neg ? -static_cast<long long>(mag) : static_cast<long long>(mag);
+      return true;
+   }
+
+
+   bool CrinexStreamBuf::Arc ::
+   apply(const char* begin, const char* end)
+   {
+      if ((end - begin >= 2) && (begin[1] == '&'))
+      {
+            // a new arc, with its order and initial value
+         if ((begin[0] < '0') || (begin[0] > '0' + maxOrder))
+            return false;
+         arcOrder = begin[0] - '0';
+         order = 0;
+         return parseInteger(begin + 2, end, u[0]);
+      }
+      long long diff;
+      if ((order < 0) || !parseInteger(begin, end, diff))
+         return false;
+         // diff is the order'th difference of the value
+      if (order < arcOrder)
+         order++;
+      u[order] = diff;
+      for (int k = order; k > 0; k--)
+         u[k-1] += u[k];
+      return true;
+   }
+
+
+   CrinexStreamBuf ::
+   CrinexStreamBuf(std::streambuf* src)
+         : DecodeStreamBuf(src), crxVersion(0), inHeader(false), srcLine(0),
+           inBuf(bufferSize), inPos(0), inEnd(0), lineStart(0),
+           numTypes2(0), typesSys(' ')
+   {
+      std::fill(numTypes3, numTypes3 + 128, 0);
+         // Look at the first line without consuming it, so that
+         // anything other than Compact RINEX can be passed through.
+      std::streamsize n = src->sgetn(inBuf.data(), inBuf.size());
+      inEnd = (n > 0 ? n : 0);
+      const char *begin = inBuf.data();
+      const char *nl = static_cast<const char*>(
+         std::memchr(begin, '\n', inEnd));
+      std::size_t len = (nl ? nl - begin : inEnd);
+      if ((len >= 40) &&
+          (std::memcmp(begin + 20, "COMPACT RINEX FORMAT", 20) == 0))
+      {
+         crxVersion = (begin[0] == '1' ? 1 : (begin[0] == '3' ? 3 : -1));
+            // skip CRINEX VERS / TYPE and CRINEX PROG / DATE
+         readLine(line);
+         readLine(line);
+         inHeader = true;
+      }
+   }
+
+
+   CrinexStreamBuf ::
+   ~CrinexStreamBuf()
+   {
+   }
+
+
+   CrinexStreamBuf::int_type CrinexStreamBuf ::
+   underflow()
+   {
+      if (gptr() < egptr())
+         return traits_type::to_int_type(*gptr());
+      if (!errorText.empty())
+         return traits_type::eof();
+      if (crxVersion == 0)
+      {
+            // not compact, pass src through
+         if (inPos == inEnd)
+         {
+            std::streamsize n = src->sgetn(inBuf.data(), inBuf.size());
+            inPos = 0;
+            inEnd = (n > 0 ? n : 0);
+         }
+         char *begin = inBuf.data() + inPos;
+         inPos = inEnd;
+         return nextBlock(begin, inBuf.data() + inEnd);
+      }
+      if ((crxVersion != 1) && (crxVersion != 3))
+         return setError("Unsupported CRINEX version");
+      outBuf.clear();
+      lineStart = 0;
+      while (inHeader && readLine(line))
+      {
+         outBuf.append(line);
+         outBuf.push_back('\n');
+         decodeHeaderLine();
+      }
+      lineStart = outBuf.size();
+         // Decode a few epochs at a time, so as not to call
+         // underflow() for each one.
+      while ((outBuf.size() < bufferSize / 4) && readLine(line))
+      {
+         if (!decodeEpoch())
+            return traits_type::eof();
+      }
+      char *begin = &outBuf[0];
+      return nextBlock(begin, begin + outBuf.size());
+   }
+
+
+   bool CrinexStreamBuf ::
+   readLine(std::string& text)
+   {
+      text.clear();
+      while (true)
+      {
+         if (inPos == inEnd)
+         {
+            std::streamsize n = src->sgetn(inBuf.data(), inBuf.size());
+            inPos = 0;
+            inEnd = (n > 0 ? n : 0);
+            if (inEnd == 0)
+            {
+               if (text.empty())
+                  return false;
+               break;
+            }
+         }
+         const char *begin = inBuf.data() + inPos;
+         const char *nl = static_cast<const char*>(
+            std::memchr(begin, '\n', inEnd - inPos));
+         if (nl)
+         {
+            text.append(begin, nl);
+            inPos += (nl - begin) + 1;
+            break;
+         }
+         text.append(begin, inEnd - inPos);
+         inPos = inEnd;
+      }
+      while (!text.empty() && (text.back() == '\r'))
+         text.pop_back();
+      srcLine++;
+      return true;
+   }
+
+
+   bool CrinexStreamBuf ::
+   decodeHeaderLine()
+   {
+      if (line.size() < 61)
+         return false;
+      if (line.compare(60, 13, "END OF HEADER") == 0)
+      {
+         inHeader = false;
+      }
+      else if (line.compare(60, 19, "# / TYPES OF OBSERV") == 0)
+      {
+            // continuation lines have a blank count
+         if (line.compare(0, 6, "      ") != 0)
+         {
+            numTypes2 = parseCount(line, 0, 6);
+            return true;
+         }
+      }
+      else if (line.compare(60, 19, "SYS / # / OBS TYPES") == 0)
+      {
+         if (line[0] != ' ')
+         {
+            typesSys = line[0];
+            numTypes3[typesSys & 0x7f] = parseCount(line, 3, 3);
+            return true;
+         }
+      }
+      return false;
+   }
+
+
+   unsigned CrinexStreamBuf ::
+   numTypes(const char* id) const
+   {
+      return (crxVersion == 1 ? numTypes2 : numTypes3[id[0] & 0x7f]);
+   }
+
+
+   bool CrinexStreamBuf ::
+   decodeEpoch()
+   {
+      const bool v1 = (crxVersion == 1);
+      const std::size_t flagCol = (v1 ? 28 : 31);
+      const std::size_t countCol = (v1 ? 29 : 32);
+      const std::size_t satCol = (v1 ? 32 : 41);
+      std::string newEpoch;
+      bool init = false;
+      if (line.empty())
+      {
+         setError("Blank epoch line at CRINEX line " +
+                  StringUtils::asString(srcLine));
+         return false;
+      }
+      if (line[0] == (v1 ? '&' : '>'))
+      {
+         newEpoch = line;
+         if (v1)
+            newEpoch[0] = ' ';
+         init = true;
+      }
+      else if (epochLine.empty())
+      {
+         setError("Missing initial epoch at CRINEX line " +
+                  StringUtils::asString(srcLine));
+         return false;
+      }
+      else
+      {
+         newEpoch = epochLine;
+         applyTextDiff(newEpoch, line.data(), line.size());
+      }
+      char flag = (newEpoch.size() > flagCol ? newEpoch[flagCol] : '0');
+      unsigned count = parseCount(newEpoch, countCol, 3);
+      if ((flag >= '2') && (flag <= '5'))
+      {
+            // Event records don't become the reference epoch.
+         outBuf.append(newEpoch);
+         endLine();
+         return copyEvent(count);
+      }
+      epochLine.swap(newEpoch);
+      if (init)
+      {
+            // Everything starts again at an initialization epoch, so
+            // decoding may start there.
+         prevSats.clear();
+      }
+      if (epochLine.size() < satCol + 3 * count)
+      {
+         setError("Epoch line too short at CRINEX line " +
+                  StringUtils::asString(srcLine));
+         return false;
+      }
+      if (!readLine(line))
+      {
+         setError("Missing receiver clock offset after CRINEX line " +
+                  StringUtils::asString(srcLine));
+         return false;
+      }
+      bool haveClock = !line.empty();
+      if (!haveClock)
+      {
+         clock.order = -1;
+      }
+      else if (!clock.apply(line.data(), line.data() + line.size()))
+      {
+         setError("Invalid receiver clock offset at CRINEX line " +
+                  StringUtils::asString(srcLine));
+         return false;
+      }
+
+         // The RINEX epoch line(s)
+      const char *sats = epochLine.data() + satCol;
+      if (v1)
+      {
+            // up to 12 satellites per line, then the clock offset
+         unsigned first = std::min(count, 12U);
+         outBuf.append(epochLine, 0, satCol + 3 * first);
+         if (haveClock)
+         {
+            padTo(68);
+            appendFixed(clock.u[0], 12, 9);
+         }
+         endLine();
+         for (unsigned i = first; i < count; i += 12)
+         {
+            outBuf.append(satCol, ' ');
+            outBuf.append(sats + 3 * i, 3 * std::min(count - i, 12U));
+            endLine();
+         }
+      }
+      else
+      {
+         outBuf.append(epochLine, 0, std::min(epochLine.size(), satCol));
+         if (haveClock)
+         {
+            padTo(satCol);
+            appendFixed(clock.u[0], 15, 12);
+         }
+         endLine();
+      }
+
+         // The satellite data.  Satellites are matched with those
+         // of the previous epoch by ID, and any that weren't in the
+         // previous epoch start again.
+      if (curSats.size() < count)
+         curSats.resize(count);
+      for (unsigned i = 0; i < count; i++)
+      {
+         const char *id = sats + 3 * i;
+         SatState& sat(curSats[i]);
+         bool found = false;
+         for (unsigned j = 0; j < prevSats.size(); j++)
+         {
+               // Satellites are usually in the same order as in the
+               // previous epoch, so start looking there.
+            SatState& prev(prevSats[(i + j) % prevSats.size()]);
+            if (std::memcmp(prev.id, id, 3) == 0)
+            {
+               std::swap(sat, prev);
+               prev.id[0] = '\0';
+               found = true;
+               break;
+            }
+         }
+         unsigned nt = numTypes(id);
+         if (!found || (sat.arcs.size() != nt))
+         {
+            std::memcpy(sat.id, id, 3);
+            sat.arcs.assign(nt, Arc());
+            sat.flags.clear();
+         }
+         if (!readLine(line))
+         {
+            setError("Missing data after CRINEX line " +
+                     StringUtils::asString(srcLine));
+            return false;
+         }
+            // space-separated values for each type, then the flags
+         const char *text = line.data();
+         std::size_t len = line.size(), pos = 0;
+         for (unsigned j = 0; j < nt; j++)
+         {
+            Arc& arc(sat.arcs[j]);
+            if (pos > len)
+            {
+                  // the line ended, the remaining values are missing
+               arc.order = -1;
+               continue;
+            }
+            const char *sep = static_cast<const char*>(
+               std::memchr(text + pos, ' ', len - pos));
+            std::size_t end = (sep ? sep - text : len);
+            if (end == pos)
+            {
+               arc.order = -1;
+            }
+            else if (!arc.apply(text + pos, text + end))
+            {
+               setError("Invalid data for " + std::string(id, 3) +
+                        " at CRINEX line " + StringUtils::asString(srcLine));
+               return false;
+            }
+            pos = end + 1;
+         }
+         if (pos < len)
+         {
+            applyTextDiff(sat.flags, text + pos, len - pos);
+         }
+         if (sat.flags.size() < 2 * nt)
+         {
+            sat.flags.resize(2 * nt, ' ');
+         }
+
+            // RINEX 3 lines start with the satellite ID, RINEX 2
+            // lines have 5 observations each.
+         if (!v1)
+         {
+            outBuf.append(id, 3);
+         }
+         for (unsigned j = 0; j < nt; j++)
+         {
+            if (v1 && (j > 0) && ((j % 5) == 0))
+            {
+               endLine();
+            }
+            if (sat.arcs[j].order >= 0)
+               appendFixed(sat.arcs[j].u[0], 14, 3);
+            else
+               outBuf.append(14, ' ');
+            outBuf.append(sat.flags, 2 * j, 2);
+         }
+         endLine();
+      }
+      curSats.resize(count);
+      prevSats.swap(curSats);
+      return true;
+   }
+
+
+   bool CrinexStreamBuf ::
+   copyEvent(unsigned count)
+   {
+      bool typesChanged = false;
+      for (unsigned i = 0; i < count; i++)
+      {
+         if (!readLine(line))
+         {
+            setError("Missing event record after CRINEX line " +
+                     StringUtils::asString(srcLine));
+            return false;
+         }
+         outBuf.append(line);
+         outBuf.push_back('\n');
+         typesChanged |= decodeHeaderLine();
+      }
+      lineStart = outBuf.size();
+      if (typesChanged)
+      {
+            // The data arcs no longer match the types.
+         prevSats.clear();
+      }
+      return true;
+   }
+
+
+   void CrinexStreamBuf ::
+   appendFixed(long long value, unsigned width, unsigned decimals)
+   {
+      char buf[32];
+      char *end = buf + sizeof(buf), *p = end;
+      unsigned long long mag = (value < 0
+                                ? 0ULL - static_cast<unsigned long long>(value)
+                                : static_cast<unsigned long long>(value));
+      for (unsigned i = 0; i < decimals; i++)
+      {
+         *--p = '0' + (mag % 10);
+         mag /= 10;
+      }
+      *--p = '.';
+      do
+      {
+         *--p = '0' + (mag % 10);
+         mag /= 10;
+      } while (mag);
+      if (value < 0)
+         *--p = '-';
+      std::size_t len = end - p;
+      if (len < width)
+         outBuf.append(width - len, ' ');
+      outBuf.append(p, len);
+   }
+
+
+   void CrinexStreamBuf ::
+   padTo(std::size_t col)
+   {
+      std::size_t len = outBuf.size() - lineStart;
+      if (len < col)
+         outBuf.append(col - len, ' ');
+   }
+
+
+   void CrinexStreamBuf ::
+   endLine()
+   {
+      std::size_t last = outBuf.find_last_not_of(' ');
+      last = (last == std::string::npos ? 0 : last + 1);
+      outBuf.resize(std::max(last, lineStart));
+      outBuf.push_back('\n');
+      lineStart = outBuf.size();
+   }
+
+}  // End of namespace gnsstk
@@ -0,0 +1,173 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file CrinexStreamBuf.hpp
+ * A read-only stream buffer that expands Compact RINEX on the fly
+ */
+
+#ifndef GNSSTK_CRINEXSTREAMBUF_HPP
+#define GNSSTK_CRINEXSTREAMBUF_HPP
+
+#include <vector>
+#include "DecodeStreamBuf.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A read-only std::streambuf that expands Compact RINEX
+       * (Hatanaka compressed) observation data, CRINEX version 1.0
+       * for RINEX 2 and 3.0 for RINEX 3 and 4, into RINEX text as
+       * it is read, one epoch at a time, as crx2rnx does.  If the
+       * source is not Compact RINEX, it is passed through unchanged,
+       * so this buffer may be used on any RINEX file.
+       *
+       * Only the state of the previous epoch is kept, so memory use
+       * does not depend on the length of the file.
+       */
+   class CrinexStreamBuf : public DecodeStreamBuf
+   {
+   public:
+         /// Size of the buffer used to read the source.
+      static const std::size_t bufferSize = 65536;
+         /// Maximum order of the differences of a data arc.
+      static const int maxOrder = 9;
+
+         /** Create a buffer that decodes the data in src.  The
+          * first line of src is read to see whether it is Compact
+          * RINEX.
+          * @param[in] src The stream buffer containing the Compact
+          *   RINEX data.  It must remain valid while this buffer is
+          *   in use. */
+      explicit CrinexStreamBuf(std::streambuf* src);
+
+      virtual ~CrinexStreamBuf();
+
+         /// @return true if the source is Compact RINEX.
+      bool isCompact() const
+      { return crxVersion != 0; }
+
+   protected:
+         /// Decode the next header line or epoch.
+      int_type underflow() override;
+
+   private:
+         /// A data arc, reconstructed from its differences.
+      struct Arc
+      {
+         Arc() : order(-1), arcOrder(0) {}
+            /** Apply the next field of the arc.
+             * @return false if the field is invalid. */
+         bool apply(const char* begin, const char* end);
+            /// The current order, -1 if there is no data.
+         int order;
+            /// The maximum order of the differences.
+         int arcOrder;
+            /// The current value and its differences.
+         long long u[maxOrder+1];
+      };
+         /// The state of one satellite carried between epochs.
+      struct SatState
+      {
+            /// The satellite ID, as it appears in the epoch line.
+         char id[3];
+            /// One arc per observation type.
+         std::vector<Arc> arcs;
+            /// The LLI and SSI flags, two per observation type.
+         std::string flags;
+      };
+
+         /** Get the next line of src, without the newline or CR.
+          * @return false at the end of src. */
+      bool readLine(std::string& line);
+         /** Process the header line in line.
+          * @return true if it defines the number of observation types. */
+      bool decodeHeaderLine();
+         /** Decode the epoch whose epoch line is in line.
+          * @return false on error. */
+      bool decodeEpoch();
+         /** Copy an event record, whose header lines follow the epoch line.
+          * @return false on error. */
+      bool copyEvent(unsigned count);
+         /// @return the number of observation types for satellite id.
+      unsigned numTypes(const char* id) const;
+         /// Append a value with the given number of decimals.
+      void appendFixed(long long value, unsigned width, unsigned decimals);
+         /// Pad the current line of outBuf with blanks to col characters.
+      void padTo(std::size_t col);
+         /// End the current line of outBuf, removing trailing blanks.
+      void endLine();
+
+         /// 1 for CRINEX 1 (RINEX 2), 3 for CRINEX 3, 0 for not compact.
+      int crxVersion;
+         /// true while reading the header.
+      bool inHeader;
+         /// Number of lines read from src, for error messages.
+      unsigned long srcLine;
+         /// Data read from src.
+      std::vector<char> inBuf;
+         /// The unread part of inBuf.
+      std::size_t inPos, inEnd;
+         /// The line being decoded.
+      std::string line;
+         /// The decoded text of the current epoch.
+      std::string outBuf;
+         /// Where the current line starts in outBuf.
+      std::size_t lineStart;
+         /// The epoch line of the previous epoch, in compact form.
+      std::string epochLine;
+         /// The receiver clock offset arc.
+      Arc clock;
+         /// Satellites in the previous and current epoch.
+      std::vector<SatState> prevSats, curSats;
+         /// Number of observation types in RINEX 2.
+      unsigned numTypes2;
+         /// Number of observation types by RINEX 3 system character.
+      unsigned numTypes3[128];
+         /// System of the last RINEX 3 SYS / # / OBS TYPES line.
+      char typesSys;
+   };
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_CRINEXSTREAMBUF_HPP
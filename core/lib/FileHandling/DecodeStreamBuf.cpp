@@ -0,0 +1,113 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file DecodeStreamBuf.cpp
+ * Base class for read-only stream buffers that decode another stream
+ */
+
+#include "DecodeStreamBuf.hpp"
+
+namespace gnsstk
+{
+   DecodeStreamBuf ::
+   DecodeStreamBuf(std::streambuf* src)
+         : src(src), blockPos(0)
+   {
+   }
+
+
+   DecodeStreamBuf ::
+   ~DecodeStreamBuf()
+   {
+   }
+
+
+   DecodeStreamBuf::int_type DecodeStreamBuf ::
+   nextBlock(char* begin, char* end)
+   {
+      blockPos += egptr() - eback();
+      setg(begin, begin, end);
+      if (begin == end)
+         return traits_type::eof();
+      return traits_type::to_int_type(*begin);
+   }
+
+
+   DecodeStreamBuf::int_type DecodeStreamBuf ::
+   setError(const std::string& text)
+   {
+      errorText = text;
+      blockPos += egptr() - eback();
+      setg(nullptr, nullptr, nullptr);
+      return traits_type::eof();
+   }
+
+
+   std::streampos DecodeStreamBuf ::
+   seekoff(std::streamoff off, std::ios::seekdir dir,
+           std::ios::openmode which)
+   {
+      if (!(which & std::ios::in) || (dir == std::ios::end))
+         return std::streampos(std::streamoff(-1));
+      std::streamoff base = 0;
+      if (dir == std::ios::cur)
+         base = blockPos + (gptr() - eback());
+      return seekpos(std::streampos(base + off), which);
+   }
+
+
+   std::streampos DecodeStreamBuf ::
+   seekpos(std::streampos pos, std::ios::openmode which)
+   {
+      std::streamoff off = std::streamoff(pos) - blockPos;
+      if (!(which & std::ios::in) || (off < 0) || (off > egptr() - eback()))
+         return std::streampos(std::streamoff(-1));
+      setg(eback(), eback() + off, egptr());
+      return pos;
+   }
+
+
+   std::streamsize DecodeStreamBuf ::
+   showmanyc()
+   {
+      std::streamsize rv = egptr() - gptr();
+      return (rv > 0 ? rv : 0);
+   }
+
+}  // End of namespace gnsstk
@@ -0,0 +1,123 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file DecodeStreamBuf.hpp
+ * Base class for read-only stream buffers that decode another stream
+ */
+
+#ifndef GNSSTK_DECODESTREAMBUF_HPP
+#define GNSSTK_DECODESTREAMBUF_HPP
+
+#include <ios>
+#include <streambuf>
+#include <string>
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A read-only std::streambuf that decodes the contents of
+       * another stream buffer, a block at a time, into its get
+       * area.  Derived classes implement underflow() to decode the
+       * next block, calling nextBlock() to keep track of the
+       * position in the decoded stream.
+       *
+       * The decoded stream can't be rewound, but tellg() returns
+       * the position in the decoded stream, and seekg() may be used
+       * to go back to any position in the current block, which is
+       * sufficient for FFStream to retry a record.
+       *
+       * Decoding errors are not thrown, as std::istream would mask
+       * them, but end the stream and are available from error().
+       */
+   class DecodeStreamBuf : public std::streambuf
+   {
+   public:
+         /** Create a buffer that decodes the data in src.
+          * @param[in] src The stream buffer containing the encoded
+          *   data.  It must remain valid while this buffer is in
+          *   use. */
+      explicit DecodeStreamBuf(std::streambuf* src);
+
+      virtual ~DecodeStreamBuf();
+
+         /// Copying would share the source.
+      DecodeStreamBuf(const DecodeStreamBuf&) = delete;
+      DecodeStreamBuf& operator=(const DecodeStreamBuf&) = delete;
+
+         /// @return the reason decoding stopped, empty if there was no error.
+      const std::string& error() const
+      { return errorText; }
+
+   protected:
+         /** Make [begin,end) the next block of the decoded stream.
+          * @param[in] begin The first decoded character.
+          * @param[in] end One past the last decoded character.
+          * @return the first character, or EOF if the block is empty. */
+      int_type nextBlock(char* begin, char* end);
+
+         /** Stop decoding due to an error.
+          * @param[in] text A description of the error.
+          * @return EOF. */
+      int_type setError(const std::string& text);
+
+         /// @copydoc std::streambuf::seekoff
+      std::streampos seekoff(std::streamoff off, std::ios::seekdir dir,
+                             std::ios::openmode which) override;
+         /// @copydoc std::streambuf::seekpos
+      std::streampos seekpos(std::streampos pos,
+                             std::ios::openmode which) override;
+         /// @copydoc std::streambuf::showmanyc
+      std::streamsize showmanyc() override;
+
+         /// The stream buffer being decoded.
+      std::streambuf *src;
+         /// Position in the decoded stream of the start of the get area.
+      std::streamoff blockPos;
+         /// Description of the error that stopped decoding.
+      std::string errorText;
+   };
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_DECODESTREAMBUF_HPP
@@ -55,6 +55,7 @@ namespace gnsstk
    FFTextStream ::
    ~FFTextStream()
    {
+      useFileBuf();
    }
 
 
@@ -80,6 +81,7 @@ namespace gnsstk
    open( const char* fn,
          std::ios::openmode mode )
    {
+      useFileBuf();
       FFStream::open(fn, mode);
       init();
    }
@@ -93,6 +95,126 @@ namespace gnsstk
    }
 
 
+   bool FFTextStream ::
+   openMapped( const char* fn )
+   {
+         // Use the virtual open so derived classes reset themselves.
+         // The file remains open so is_open() and close() behave as
+         // usual.
+      open(fn, std::ios::in);
+      if (fail())
+         return false;
+      if (!memBuf)
+         memBuf.reset(new MemoryStreamBuf);
+      if (!memBuf->map(fn))
+         return false;
+      std::ios::rdbuf(memBuf.get());
+      return true;
+   }
+
+
+   bool FFTextStream ::
+   openMapped( const std::string& fn )
+   {
+      return openMapped(fn.c_str());
+   }
+
+
+   void FFTextStream ::
+   openBuffer( const char* data, std::size_t len, const std::string& name )
+   {
+         // Opening an empty file name resets the stream and derived
+         // classes without opening anything.  The resulting fail
+         // state is cleared when the buffer is installed.
+      open("", std::ios::in);
+      filename = name;
+      if (!memBuf)
+         memBuf.reset(new MemoryStreamBuf);
+      memBuf->setBuffer(data, len);
+      std::ios::rdbuf(memBuf.get());
+   }
+
+
+   bool FFTextStream ::
+   openCompressed( const char* fn )
+   {
+      open(fn, std::ios::in);
+      if (fail())
+         return false;
+      std::streambuf *src = std::fstream::rdbuf();
+      char magic[2];
+      bool gzip = GzipStreamBuf::isGzip(magic, src->sgetn(magic, 2));
+      src->pubseekpos(0, std::ios::in);
+      if (gzip)
+      {
+         if (!GzipStreamBuf::available())
+         {
+            try
+            {
+               setstate(std::ios::failbit);
+            }
+            catch (std::exception&)
+            {
+            }
+            return false;
+         }
+         gzipBuf.reset(new GzipStreamBuf(src));
+         src = gzipBuf.get();
+      }
+      crinexBuf.reset(new CrinexStreamBuf(src));
+      if (gzip || crinexBuf->isCompact())
+      {
+         std::ios::rdbuf(crinexBuf.get());
+      }
+      else
+      {
+            // plain text, so read the file directly
+         crinexBuf.reset();
+         src->pubseekpos(0, std::ios::in);
+      }
+      return true;
+   }
+
+
+   bool FFTextStream ::
+   openCompressed( const std::string& fn )
+   {
+      return openCompressed(fn.c_str());
+   }
+
+
+   void FFTextStream ::
+   useFileBuf()
+   {
+      if (std::ios::rdbuf() != std::fstream::rdbuf())
+      {
+         std::ios::rdbuf(std::fstream::rdbuf());
+      }
+      if (memBuf)
+      {
+         memBuf->release();
+      }
+      crinexBuf.reset();
+      gzipBuf.reset();
+   }
+
+
+   void FFTextStream ::
+   checkDecodeError()
+   {
+      const std::string *text = nullptr;
+      if (gzipBuf && !gzipBuf->error().empty())
+         text = &gzipBuf->error();
+      else if (crinexBuf && !crinexBuf->error().empty())
+         text = &crinexBuf->error();
+      if (text != nullptr)
+      {
+         FFStreamError err(*text);
+         GNSSTK_THROW(err);
+      }
+   }
+
+
    void FFTextStream ::
    init()
    {
@@ -149,9 +271,20 @@ namespace gnsstk
    formattedGetLine( std::string& line,
                      const bool expectEOF )
    {
+      if (isInMemory())
+      {
+         const char *mline;
+         std::size_t len;
+         line.clear();
+         memGetLine(mline, len, expectEOF);
+         line.assign(mline, len);
+         return;
+      }
       try
       {
          std::getline(*this, line);
+         if (crinexBuf)
+            checkDecodeError();
             // Remove CR characters left over in the buffer from windows files
          size_t crpos = line.find_last_not_of('\r');
          if ((crpos+1) < line.length())
@@ -211,4 +344,75 @@ namespace gnsstk
       }
    }  // End of method 'FFTextStream::formattedGetLine()'
 
+
+   void FFTextStream ::
+   formattedGetLine( const char*& line, std::size_t& len,
+                     const bool expectEOF )
+   {
+      if (isInMemory())
+      {
+         memGetLine(line, len, expectEOF);
+      }
+      else
+      {
+         formattedGetLine(lineBuf, expectEOF);
+         line = lineBuf.data();
+         len = lineBuf.size();
+      }
+   }
+
+
+   void FFTextStream ::
+   memGetLine( const char*& line, std::size_t& len,
+               const bool expectEOF )
+   {
+      bool terminated;
+      if (!memBuf->nextLine(line, len, terminated))
+      {
+            // Set the state the same as std::getline would, but
+            // throw our own exception rather than the stream's.
+         try
+         {
+            setstate(std::ios::eofbit | std::ios::failbit);
+         }
+         catch (std::exception&)
+         {
+         }
+         lineNumber++;
+         len = 0;
+         if (expectEOF)
+         {
+            EndOfFile err("EOF encountered");
+            GNSSTK_THROW(err);
+         }
+         else
+         {
+            FFStreamError err("Unexpected EOF encountered");
+            GNSSTK_THROW(err);
+         }
+      }
+      if (!terminated)
+      {
+         try
+         {
+            setstate(std::ios::eofbit);
+         }
+         catch (std::exception&)
+         {
+         }
+      }
+         // Remove CR characters left over in the buffer from windows files
+      while ((len > 0) && (line[len-1] == '\r'))
+         len--;
+      for (std::size_t i = 0; i < len; i++)
+      {
+         if (!isprint(line[i]))
+         {
+            FFStreamError err("Non-text data in file.");
+            GNSSTK_THROW(err);
+         }
+      }
+      lineNumber++;
+   }
+
 }  // End of namespace gnsstk
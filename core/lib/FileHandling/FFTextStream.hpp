@@ -44,7 +44,11 @@
 #ifndef GNSSTK_FFTEXTSTREAM_HPP
 #define GNSSTK_FFTEXTSTREAM_HPP
 
+#include <memory>
 #include "FFStream.hpp"
+#include "CrinexStreamBuf.hpp"
+#include "GzipStreamBuf.hpp"
+#include "MemoryStreamBuf.hpp"
 
 namespace gnsstk
 {
@@ -59,6 +63,19 @@ namespace gnsstk
        * update the line number - the derived class or programmer
        * needs to make sure that the reader or writer increments
        * lineNumber in these cases.
+       *
+       * Input may be read from memory instead of through the file
+       * stream buffer, either by memory-mapping the file with
+       * openMapped() or from a caller-supplied block of memory with
+       * openBuffer().  All of the existing readers work unchanged in
+       * this mode, as the memory is presented to them as the
+       * stream's buffer, while readers that use the
+       * formattedGetLine() that returns a pointer and length can
+       * avoid copying the lines at all.
+       *
+       * Similarly, openCompressed() reads gzip-compressed and/or
+       * Compact RINEX files through stream buffers that decode them
+       * as they are read, without temporary files.
        */
    class FFTextStream : public FFStream
    {
@@ -93,6 +110,47 @@ namespace gnsstk
       virtual void open( const std::string& fn,
                          std::ios::openmode mode );
 
+         /** Open a file for reading by mapping it into memory.  The
+          * stream is reset as for open().  If the file can't be
+          * mapped, it is read through the file stream buffer as
+          * usual.
+          * @param[in] fn file name.
+          * @return true if the file was mapped. */
+      bool openMapped( const char* fn );
+
+         /// @copydoc openMapped(const char*)
+      bool openMapped( const std::string& fn );
+
+         /** Read from a block of memory rather than a file.  The
+          * stream is reset as for open(), but no file is opened, so
+          * is_open() returns false.
+          * @param[in] data The first character of the text.  The
+          *   memory must remain valid and unchanged until the stream
+          *   is reopened or destroyed.
+          * @param[in] len The number of characters of text.
+          * @param[in] name The name to use as the file name in
+          *   error messages. */
+      void openBuffer( const char* data, std::size_t len,
+                       const std::string& name = std::string() );
+
+         /** Open a file for reading that may be gzip-compressed
+          * and/or Compact RINEX (Hatanaka compressed), decoding it
+          * as it is read using bounded buffers.  Files that are
+          * neither are read as they would be after open().  The
+          * stream is reset as for open().
+          * @param[in] fn file name.
+          * @return false if the file could not be opened, or is
+          *   gzip-compressed and GNSSTk was built without zlib, in
+          *   which case the stream's fail bit is set. */
+      bool openCompressed( const char* fn );
+
+         /// @copydoc openCompressed(const char*)
+      bool openCompressed( const std::string& fn );
+
+         /// @return true if reading from memory rather than the file.
+      bool isInMemory() const
+      { return (memBuf != nullptr) && (std::ios::rdbuf() == memBuf.get()); }
+
          /// The internal line count. When writing, make sure
          /// to increment this.
       unsigned int lineNumber;
@@ -118,6 +176,24 @@ namespace gnsstk
       void formattedGetLine( std::string& line,
                              const bool expectEOF = false );
 
+         /**
+          * The same as formattedGetLine(std::string&,bool), but
+          * without copying the line when reading from memory (see
+          * isInMemory()).  Otherwise the line is read into a buffer
+          * belonging to the stream.
+          * @param[out] line is set to the first character of the
+          *   line, which remains valid until the next read from the
+          *   stream.  The line is NOT terminated with a null.
+          * @param[out] len is set to the number of characters in the
+          *   line.
+          * @param[in] expectEOF set true if finding EOF on this read
+          *   is acceptable.
+          * @throw EndOfFile if \a expectEOF is true and an EOF is encountered.
+          * @throw FFStreamError if EOF is found and \a expectEOF is false
+          */
+      void formattedGetLine( const char*& line, std::size_t& len,
+                             const bool expectEOF = false );
+
 
    protected:
 
@@ -137,6 +213,32 @@ namespace gnsstk
          /// Initialize internal data structures
       void init();
 
+         /// Go back to reading through the file stream buffer.
+      void useFileBuf();
+
+         /** Get the next line from memBuf, doing the checks of
+          * formattedGetLine().
+          * @throw EndOfFile
+          * @throw FFStreamError */
+      void memGetLine( const char*& line, std::size_t& len,
+                       const bool expectEOF );
+
+         /// The memory buffer used by openMapped() and openBuffer().
+      std::unique_ptr<MemoryStreamBuf> memBuf;
+
+         /** Throw the error, if any, that stopped the buffers used by
+          * openCompressed() from decoding.
+          * @throw FFStreamError */
+      void checkDecodeError();
+
+         /// The gzip decoder used by openCompressed().
+      std::unique_ptr<GzipStreamBuf> gzipBuf;
+         /// The Compact RINEX decoder used by openCompressed().
+      std::unique_ptr<CrinexStreamBuf> crinexBuf;
+
+         /// Line storage for formattedGetLine() when not in memory.
+      std::string lineBuf;
+
    }; // End of class 'FFTextStream'
 
       //@}
@@ -0,0 +1,168 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file GzipStreamBuf.cpp
+ * A read-only stream buffer that decompresses gzip data on the fly
+ */
+
+#include "GzipStreamBuf.hpp"
+
+#ifdef GNSSTK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace gnsstk
+{
+   struct GzipStreamBuf::ZState
+   {
+#ifdef GNSSTK_HAVE_ZLIB
+      ZState()
+            : initialized(false), memberEnd(false)
+      {
+         strm.zalloc = Z_NULL;
+         strm.zfree = Z_NULL;
+         strm.opaque = Z_NULL;
+         strm.next_in = Z_NULL;
+         strm.avail_in = 0;
+            // 32 adds automatic gzip/zlib header detection
+         initialized = (inflateInit2(&strm, 15 + 32) == Z_OK);
+      }
+      ~ZState()
+      {
+         if (initialized)
+            inflateEnd(&strm);
+      }
+      z_stream strm;
+      bool initialized;
+         /// true when the end of a gzip member has been reached.
+      bool memberEnd;
+#endif
+   };
+
+
+   GzipStreamBuf ::
+   GzipStreamBuf(std::streambuf* src)
+         : DecodeStreamBuf(src), zs(new ZState),
+           inBuf(bufferSize), outBuf(bufferSize)
+   {
+   }
+
+
+   GzipStreamBuf ::
+   ~GzipStreamBuf()
+   {
+   }
+
+
+   bool GzipStreamBuf ::
+   available()
+   {
+#ifdef GNSSTK_HAVE_ZLIB
+      return true;
+#else
+      return false;
+#endif
+   }
+
+
+   bool GzipStreamBuf ::
+   isGzip(const char* data, std::size_t len)
+   {
+      return ((len >= 2) && (data[0] == '\x1f') && (data[1] == '\x8b'));
+   }
+
+
+   GzipStreamBuf::int_type GzipStreamBuf ::
+   underflow()
+   {
+      if (gptr() < egptr())
+         return traits_type::to_int_type(*gptr());
+      if (!errorText.empty())
+         return traits_type::eof();
+#ifdef GNSSTK_HAVE_ZLIB
+      if (!zs->initialized)
+         return setError("Unable to initialize zlib");
+      z_stream& strm(zs->strm);
+      strm.next_out = reinterpret_cast<Bytef*>(outBuf.data());
+      strm.avail_out = outBuf.size();
+      while (strm.avail_out == outBuf.size())
+      {
+         if (strm.avail_in == 0)
+         {
+            std::streamsize n = src->sgetn(inBuf.data(), inBuf.size());
+            if (n <= 0)
+            {
+               if (!zs->memberEnd)
+                  return setError("Unexpected end of gzip data");
+               break;
+            }
+            strm.next_in = reinterpret_cast<Bytef*>(inBuf.data());
+            strm.avail_in = n;
+         }
+         if (zs->memberEnd)
+         {
+               // Another gzip member may follow, anything else is
+               // ignored as gzip does.
+            if (strm.next_in[0] != 0x1f)
+            {
+               strm.avail_in = 0;
+               break;
+            }
+            inflateReset(&strm);
+            zs->memberEnd = false;
+         }
+         int rc = inflate(&strm, Z_NO_FLUSH);
+         if (rc == Z_STREAM_END)
+         {
+            zs->memberEnd = true;
+         }
+         else if ((rc != Z_OK) && (rc != Z_BUF_ERROR))
+         {
+            return setError(std::string("gzip data error: ") +
+                            (strm.msg ? strm.msg : "unknown"));
+         }
+      }
+      char *begin = outBuf.data();
+      return nextBlock(begin, begin + (outBuf.size() - strm.avail_out));
+#else
+      return setError("GNSSTk was built without gzip support");
+#endif
+   }
+
+}  // End of namespace gnsstk
@@ -0,0 +1,104 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file GzipStreamBuf.hpp
+ * A read-only stream buffer that decompresses gzip data on the fly
+ */
+
+#ifndef GNSSTK_GZIPSTREAMBUF_HPP
+#define GNSSTK_GZIPSTREAMBUF_HPP
+
+#include <memory>
+#include <vector>
+#include "DecodeStreamBuf.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A read-only std::streambuf that decompresses gzip (or zlib)
+       * data from another stream buffer as it is read, using fixed
+       * size input and output buffers.  Concatenated gzip members
+       * are read as one stream, as gzip does.
+       *
+       * Decompression uses zlib.  If GNSSTk was built without zlib,
+       * available() returns false and reading fails with an error.
+       */
+   class GzipStreamBuf : public DecodeStreamBuf
+   {
+   public:
+         /// Size of each of the input and output buffers.
+      static const std::size_t bufferSize = 65536;
+
+         /// @copydoc DecodeStreamBuf::DecodeStreamBuf
+      explicit GzipStreamBuf(std::streambuf* src);
+
+      virtual ~GzipStreamBuf();
+
+         /// @return true if gzip decompression is supported.
+      static bool available();
+
+         /** Check the first two characters of some data for the
+          * gzip signature.
+          * @param[in] data The first characters of the data.
+          * @param[in] len The number of characters in data.
+          * @return true if the data starts with the gzip signature. */
+      static bool isGzip(const char* data, std::size_t len);
+
+   protected:
+         /// Decompress the next block.
+      int_type underflow() override;
+
+   private:
+         /// The zlib state, kept out of the header.
+      struct ZState;
+      std::unique_ptr<ZState> zs;
+         /// Compressed data read from src.
+      std::vector<char> inBuf;
+         /// Decompressed data.
+      std::vector<char> outBuf;
+   };
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_GZIPSTREAMBUF_HPP
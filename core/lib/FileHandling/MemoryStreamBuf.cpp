@@ -0,0 +1,209 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MemoryStreamBuf.cpp
+ * A read-only stream buffer over a memory-mapped file or a block of memory
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "MemoryStreamBuf.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gnsstk
+{
+   MemoryStreamBuf ::
+   MemoryStreamBuf()
+         : mapAddr(nullptr), mapLen(0)
+   {
+   }
+
+
+   MemoryStreamBuf ::
+   ~MemoryStreamBuf()
+   {
+      release();
+   }
+
+
+   bool MemoryStreamBuf ::
+   map(const char* fn)
+   {
+      release();
+#ifndef _WIN32
+      int fd = ::open(fn, O_RDONLY);
+      if (fd < 0)
+         return false;
+      struct stat st;
+      if ((::fstat(fd, &st) != 0) || !S_ISREG(st.st_mode))
+      {
+         ::close(fd);
+         return false;
+      }
+      if (st.st_size == 0)
+      {
+            // mmap doesn't do empty files, but empty is easy.
+         ::close(fd);
+         return true;
+      }
+      void *addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+         // the mapping stays valid after the descriptor is closed
+      ::close(fd);
+      if (addr == MAP_FAILED)
+         return false;
+#ifdef MADV_SEQUENTIAL
+      ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+#endif
+      mapAddr = addr;
+      mapLen = st.st_size;
+      char *begin = static_cast<char*>(addr);
+      setg(begin, begin, begin + mapLen);
+      return true;
+#else
+      std::ifstream ifs(fn, std::ios::in | std::ios::binary);
+      if (!ifs)
+         return false;
+      fileData.assign(std::istreambuf_iterator<char>(ifs),
+                      std::istreambuf_iterator<char>());
+      if (ifs.bad())
+      {
+         fileData.clear();
+         return false;
+      }
+      char *begin = fileData.data();
+      setg(begin, begin, begin + fileData.size());
+      return true;
+#endif
+   }
+
+
+   void MemoryStreamBuf ::
+   setBuffer(const char* data, std::size_t len)
+   {
+      release();
+         // The get area is never written through, the const_cast is
+         // only needed to satisfy the std::streambuf interface.
+      char *begin = const_cast<char*>(data);
+      setg(begin, begin, begin + len);
+   }
+
+
+   void MemoryStreamBuf ::
+   release()
+   {
+#ifndef _WIN32
+      if (mapAddr != nullptr)
+      {
+         ::munmap(mapAddr, mapLen);
+      }
+#endif
+      mapAddr = nullptr;
+      mapLen = 0;
+      fileData.clear();
+      setg(nullptr, nullptr, nullptr);
+   }
+
+
+   bool MemoryStreamBuf ::
+   nextLine(const char*& line, std::size_t& len, bool& terminated)
+   {
+      char *cur = gptr();
+      char *end = egptr();
+      if (cur >= end)
+         return false;
+      char *nl = static_cast<char*>(std::memchr(cur, '\n', end - cur));
+      line = cur;
+      terminated = (nl != nullptr);
+      if (terminated)
+      {
+         len = nl - cur;
+         setg(eback(), nl + 1, end);
+      }
+      else
+      {
+         len = end - cur;
+         setg(eback(), end, end);
+      }
+      return true;
+   }
+
+
+   std::streampos MemoryStreamBuf ::
+   seekoff(std::streamoff off, std::ios::seekdir dir,
+           std::ios::openmode which)
+   {
+      if (!(which & std::ios::in))
+         return std::streampos(std::streamoff(-1));
+      std::streamoff base;
+      if (dir == std::ios::beg)
+         base = 0;
+      else if (dir == std::ios::cur)
+         base = gptr() - eback();
+      else
+         base = egptr() - eback();
+      return seekpos(std::streampos(base + off), which);
+   }
+
+
+   std::streampos MemoryStreamBuf ::
+   seekpos(std::streampos pos, std::ios::openmode which)
+   {
+      std::streamoff off(pos);
+      if (!(which & std::ios::in) || (off < 0) || (off > egptr() - eback()))
+         return std::streampos(std::streamoff(-1));
+      setg(eback(), eback() + off, egptr());
+      return pos;
+   }
+
+
+   std::streamsize MemoryStreamBuf ::
+   showmanyc()
+   {
+      std::streamsize rv = egptr() - gptr();
+      return (rv > 0 ? rv : -1);
+   }
+
+}  // End of namespace gnsstk
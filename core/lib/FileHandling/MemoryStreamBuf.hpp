@@ -0,0 +1,132 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MemoryStreamBuf.hpp
+ * A read-only stream buffer over a memory-mapped file or a block of memory
+ */
+
+#ifndef GNSSTK_MEMORYSTREAMBUF_HPP
+#define GNSSTK_MEMORYSTREAMBUF_HPP
+
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace gnsstk
+{
+      /// @ingroup FileHandling
+      //@{
+
+      /**
+       * A read-only std::streambuf whose contents are either a
+       * memory-mapped file or a block of memory supplied by the
+       * caller.  Any std::istream using this buffer reads the data
+       * directly from memory, and nextLine() allows the lines to be
+       * read without copying them at all.  Seeking is supported.
+       *
+       * On systems without mmap, map() reads the whole file into
+       * memory instead.
+       */
+   class MemoryStreamBuf : public std::streambuf
+   {
+   public:
+         /// Create an empty buffer.
+      MemoryStreamBuf();
+
+         /// Unmap any mapped file.
+      virtual ~MemoryStreamBuf();
+
+         /// Copying would duplicate the mapping.
+      MemoryStreamBuf(const MemoryStreamBuf&) = delete;
+      MemoryStreamBuf& operator=(const MemoryStreamBuf&) = delete;
+
+         /** Map a file into memory, replacing any previous contents.
+          * @param[in] fn The name of the file to map.
+          * @return true on success, false if the file could not be
+          *   opened or mapped, in which case the buffer is empty. */
+      bool map(const char* fn);
+
+         /** Use a block of memory owned by the caller, replacing any
+          * previous contents.  The memory must remain valid and
+          * unchanged while it is in use by this buffer.
+          * @param[in] data The first character of the block.
+          * @param[in] len The number of characters in the block. */
+      void setBuffer(const char* data, std::size_t len);
+
+         /// Unmap or forget the current contents, leaving the buffer empty.
+      void release();
+
+         /// @return true if the buffer contains a mapped file.
+      bool isMapped() const
+      { return mapAddr != nullptr; }
+
+         /** Get the next line, without the terminating newline,
+          * and advance past it.  The line remains valid until the
+          * contents of the buffer are replaced or released.
+          * @param[out] line The first character of the line.
+          * @param[out] len The number of characters in the line.
+          * @param[out] terminated Set to false if the line is the
+          *   last in the buffer and has no newline.
+          * @return false if there are no more characters. */
+      bool nextLine(const char*& line, std::size_t& len, bool& terminated);
+
+   protected:
+         /// @copydoc std::streambuf::seekoff
+      std::streampos seekoff(std::streamoff off, std::ios::seekdir dir,
+                             std::ios::openmode which) override;
+         /// @copydoc std::streambuf::seekpos
+      std::streampos seekpos(std::streampos pos,
+                             std::ios::openmode which) override;
+         /// @copydoc std::streambuf::showmanyc
+      std::streamsize showmanyc() override;
+
+   private:
+         /// Address of the mapped file, nullptr if not mapped.
+      void *mapAddr;
+         /// Size of the mapped region.
+      std::size_t mapLen;
+         /// Contents of the file when mmap is unavailable.
+      std::vector<char> fileData;
+   };
+
+      //@}
+
+}  // End of namespace gnsstk
+
+#endif   // GNSSTK_MEMORYSTREAMBUF_HPP
@@ -0,0 +1,420 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file Rinex3ObsColumnStore.cpp
+ * Column-oriented in-memory storage of RINEX observation data.
+ */
+
+#include <limits>
+#include "StringUtils.hpp"
+#include "Rinex3ObsColumnStore.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   const uint16_t Rinex3ObsColumnStore::lliMask;
+   const uint16_t Rinex3ObsColumnStore::ssiMask;
+   const unsigned Rinex3ObsColumnStore::ssiShift;
+   const uint16_t Rinex3ObsColumnStore::dataBlankBit;
+   const uint16_t Rinex3ObsColumnStore::lliBlankBit;
+   const uint16_t Rinex3ObsColumnStore::ssiBlankBit;
+
+
+   Rinex3ObsColumnStore ::
+   Rinex3ObsColumnStore(const std::vector<std::string>& types)
+   {
+      for (unsigned i = 0; i < types.size(); i++)
+      {
+         addObsType(types[i]);
+      }
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   clear()
+   {
+      times.clear();
+      epochFlags.clear();
+      clockOffsets.clear();
+      epochFirstRow.clear();
+      rowEpoch.clear();
+      rowSat.clear();
+      sats.clear();
+      satIndex.clear();
+      satRows.clear();
+      for (unsigned i = 0; i < data.size(); i++)
+      {
+         data[i].clear();
+         flags[i].clear();
+      }
+   }
+
+
+   size_t Rinex3ObsColumnStore ::
+   addObsType(const std::string& type)
+   {
+      if (obsIndex.find(type) != obsIndex.end())
+      {
+         InvalidParameter exc("Observation type " + type +
+                              " is already in the store");
+         GNSSTK_THROW(exc);
+      }
+      size_t col = obsTypes.size();
+      obsTypes.push_back(type);
+      obsIndex[type] = col;
+      data.push_back(std::vector<double>(numRows(), 0.));
+      flags.push_back(std::vector<uint16_t>(numRows(), 0));
+      return col;
+   }
+
+
+   int Rinex3ObsColumnStore ::
+   getObsIndex(const std::string& type) const
+   {
+      std::map<std::string, size_t>::const_iterator i = obsIndex.find(type);
+      if (i == obsIndex.end())
+         return -1;
+      return i->second;
+   }
+
+
+   RinexDatum Rinex3ObsColumnStore ::
+   getDatum(size_t row, size_t col) const
+   {
+      RinexDatum rv;
+      uint16_t f = flags[col][row];
+      rv.data = data[col][row];
+      rv.lli = (f & lliMask);
+      rv.ssi = (f & ssiMask) >> ssiShift;
+      rv.dataBlank = ((f & dataBlankBit) != 0);
+      rv.lliBlank = ((f & lliBlankBit) != 0);
+      rv.ssiBlank = ((f & ssiBlankBit) != 0);
+      return rv;
+   }
+
+
+   size_t Rinex3ObsColumnStore ::
+   addEpoch(const CommonTime& time, short epochFlag, double clockOffset)
+   {
+      times.push_back(time);
+      epochFlags.push_back(epochFlag);
+      clockOffsets.push_back(clockOffset);
+      epochFirstRow.push_back(numRows());
+      return times.size() - 1;
+   }
+
+
+   size_t Rinex3ObsColumnStore ::
+   addRow(const RinexSatID& sat)
+   {
+      if (times.empty())
+      {
+         InvalidRequest exc("No epoch to add the row to");
+         GNSSTK_THROW(exc);
+      }
+      if (numRows() >= std::numeric_limits<uint32_t>::max())
+      {
+         InvalidRequest exc("Store is full");
+         GNSSTK_THROW(exc);
+      }
+      uint32_t row = numRows();
+      std::map<RinexSatID, uint16_t>::const_iterator si = satIndex.find(sat);
+      uint16_t idx;
+      if (si == satIndex.end())
+      {
+         if (sats.size() > std::numeric_limits<uint16_t>::max())
+         {
+            InvalidRequest exc("Too many satellites");
+            GNSSTK_THROW(exc);
+         }
+         idx = sats.size();
+         sats.push_back(sat);
+         satIndex[sat] = idx;
+         satRows.push_back(std::vector<uint32_t>());
+      }
+      else
+      {
+         idx = si->second;
+      }
+      rowEpoch.push_back(times.size() - 1);
+      rowSat.push_back(idx);
+      satRows[idx].push_back(row);
+      for (unsigned col = 0; col < data.size(); col++)
+      {
+         data[col].push_back(0.);
+         flags[col].push_back(0);
+      }
+      return row;
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   setDatum(size_t row, size_t col, const RinexDatum& rd)
+   {
+      flags[col][row] = packFlags(rd);
+      data[col][row] = rd.data;
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   addEpoch(const Rinex3ObsData& rod)
+   {
+         // Check before changing anything so a bad record isn't
+         // partially stored.
+      Rinex3ObsData::DataMap::const_iterator it;
+      for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
+      {
+         if (it->second.size() > obsTypes.size())
+         {
+            InvalidParameter exc(it->first.toString() + " has " +
+                                 StringUtils::asString(it->second.size()) +
+                                 " observations, store has " +
+                                 StringUtils::asString(obsTypes.size()) +
+                                 " types");
+            GNSSTK_THROW(exc);
+         }
+         for (unsigned i = 0; i < it->second.size(); i++)
+         {
+            packFlags(it->second[i]);
+         }
+      }
+      addEpoch(rod.time, rod.epochFlag, rod.clockOffset);
+      for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
+      {
+         size_t row = addRow(it->first);
+         for (unsigned i = 0; i < it->second.size(); i++)
+         {
+            setDatum(row, i, it->second[i]);
+         }
+      }
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   addEpoch(const Rinex3ObsData& rod, const Rinex3ObsHeader& roh)
+   {
+         // Column indices for each system's header obs types,
+         // determined once per system.
+      std::map<std::string, std::vector<int> > sysCols;
+      Rinex3ObsData::DataMap::const_iterator it;
+      for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
+      {
+         std::string sys(1, it->first.systemChar());
+         if (sysCols.find(sys) == sysCols.end())
+         {
+            mapHeaderTypes(sys, roh, sysCols[sys]);
+         }
+         const std::vector<int>& cols(sysCols[sys]);
+         for (unsigned i = 0; i < it->second.size() && i < cols.size(); i++)
+         {
+            if (cols[i] >= 0)
+            {
+               packFlags(it->second[i]);
+            }
+         }
+      }
+      addEpoch(rod.time, rod.epochFlag, rod.clockOffset);
+      for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
+      {
+         const std::vector<int>& cols(
+            sysCols[std::string(1, it->first.systemChar())]);
+         size_t row = addRow(it->first);
+         for (unsigned i = 0; i < it->second.size() && i < cols.size(); i++)
+         {
+            if (cols[i] >= 0)
+            {
+               setDatum(row, cols[i], it->second[i]);
+            }
+         }
+      }
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   getEpoch(size_t epoch, Rinex3ObsData& rod) const
+   {
+      EpochView ev(getEpochView(epoch));
+      rod.time = ev.getTime();
+      rod.epochFlag = ev.getEpochFlag();
+      rod.clockOffset = ev.getClockOffset();
+      rod.numSVs = ev.size();
+      rod.auxHeader.clear();
+      rod.obs.clear();
+      for (size_t i = 0; i < ev.size(); i++)
+      {
+         std::vector<RinexDatum>& obs(rod.obs[ev.getSat(i)]);
+         obs.resize(obsTypes.size());
+         for (size_t col = 0; col < obsTypes.size(); col++)
+         {
+            obs[col] = ev.getDatum(i, col);
+         }
+      }
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   getEpoch(size_t epoch, const Rinex3ObsHeader& roh, Rinex3ObsData& rod)
+      const
+   {
+      EpochView ev(getEpochView(epoch));
+      rod.time = ev.getTime();
+      rod.epochFlag = ev.getEpochFlag();
+      rod.clockOffset = ev.getClockOffset();
+      rod.auxHeader.clear();
+      rod.obs.clear();
+      std::map<std::string, std::vector<int> > sysCols;
+      for (size_t i = 0; i < ev.size(); i++)
+      {
+         std::string sys(1, ev.getSat(i).systemChar());
+         std::map<std::string, std::vector<int> >::iterator sci =
+            sysCols.find(sys);
+         if (sci == sysCols.end())
+         {
+            sci = sysCols.insert(
+               std::make_pair(sys, std::vector<int>())).first;
+            mapHeaderTypes(sys, roh, sci->second);
+         }
+            // A satellite whose system isn't in the header can't be
+            // represented.
+         if (sci->second.empty())
+            continue;
+         std::vector<RinexDatum>& obs(rod.obs[ev.getSat(i)]);
+         obs.resize(sci->second.size());
+         for (size_t j = 0; j < sci->second.size(); j++)
+         {
+            if (sci->second[j] >= 0)
+            {
+               obs[j] = ev.getDatum(i, sci->second[j]);
+            }
+         }
+      }
+      rod.numSVs = rod.obs.size();
+   }
+
+
+   Rinex3ObsColumnStore::EpochView Rinex3ObsColumnStore ::
+   getEpochView(size_t epoch) const
+   {
+      EpochView rv;
+      rv.store = this;
+      rv.epoch = epoch;
+      rv.first = epochFirstRow[epoch];
+      rv.last = (epoch+1 < epochFirstRow.size() ? epochFirstRow[epoch+1]
+                 : numRows());
+      return rv;
+   }
+
+
+   Rinex3ObsColumnStore::SatView Rinex3ObsColumnStore ::
+   getSatView(const RinexSatID& sat) const
+   {
+      SatView rv;
+      rv.store = this;
+      rv.sat = sat;
+      std::map<RinexSatID, uint16_t>::const_iterator si = satIndex.find(sat);
+      if (si != satIndex.end())
+      {
+         rv.rows = &satRows[si->second];
+      }
+      return rv;
+   }
+
+
+   size_t Rinex3ObsColumnStore ::
+   memoryUsed() const
+   {
+      size_t rv = sizeof(*this);
+      rv += times.capacity() * sizeof(CommonTime);
+      rv += epochFlags.capacity() * sizeof(short);
+      rv += clockOffsets.capacity() * sizeof(double);
+      rv += epochFirstRow.capacity() * sizeof(uint32_t);
+      rv += rowEpoch.capacity() * sizeof(uint32_t);
+      rv += rowSat.capacity() * sizeof(uint16_t);
+      rv += sats.capacity() * sizeof(RinexSatID);
+      for (unsigned i = 0; i < satRows.size(); i++)
+      {
+         rv += sizeof(satRows[i]) + satRows[i].capacity() * sizeof(uint32_t);
+      }
+      for (unsigned i = 0; i < data.size(); i++)
+      {
+         rv += sizeof(data[i]) + data[i].capacity() * sizeof(double);
+         rv += sizeof(flags[i]) + flags[i].capacity() * sizeof(uint16_t);
+      }
+      return rv;
+   }
+
+
+   uint16_t Rinex3ObsColumnStore ::
+   packFlags(const RinexDatum& rd)
+   {
+      if ((rd.lli < 0) || (rd.lli > 15) || (rd.ssi < 0) || (rd.ssi > 15))
+      {
+         InvalidParameter exc("LLI " + StringUtils::asString(rd.lli) +
+                              " or SSI " + StringUtils::asString(rd.ssi) +
+                              " out of range 0-15");
+         GNSSTK_THROW(exc);
+      }
+      uint16_t rv = rd.lli | (rd.ssi << ssiShift);
+      if (rd.dataBlank)
+         rv |= dataBlankBit;
+      if (rd.lliBlank)
+         rv |= lliBlankBit;
+      if (rd.ssiBlank)
+         rv |= ssiBlankBit;
+      return rv;
+   }
+
+
+   void Rinex3ObsColumnStore ::
+   mapHeaderTypes(const std::string& sys, const Rinex3ObsHeader& roh,
+                  std::vector<int>& cols) const
+   {
+      cols.clear();
+      Rinex3ObsHeader::RinexObsMap::const_iterator moti =
+         roh.mapObsTypes.find(sys);
+      if (moti == roh.mapObsTypes.end())
+         return;
+      cols.resize(moti->second.size());
+      for (unsigned i = 0; i < moti->second.size(); i++)
+      {
+         cols[i] = getObsIndex(sys + moti->second[i].asString(roh.version));
+      }
+   }
+
+} // namespace gnsstk
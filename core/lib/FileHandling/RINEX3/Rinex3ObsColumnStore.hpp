@@ -0,0 +1,396 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file Rinex3ObsColumnStore.hpp
+ * Column-oriented in-memory storage of RINEX observation data.
+ */
+
+#ifndef RINEX3OBSCOLUMNSTORE_HPP
+#define RINEX3OBSCOLUMNSTORE_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CommonTime.hpp"
+#include "Exception.hpp"
+#include "Rinex3ObsData.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "RinexDatum.hpp"
+#include "RinexSatID.hpp"
+
+namespace gnsstk
+{
+
+      /// @ingroup FileHandling
+      //@{
+
+      /** Store RINEX observation data in columns rather than as a
+       * sequence of Rinex3ObsData records.
+       *
+       * Each row of the store holds the data for one satellite at
+       * one epoch.  Each observation type has a column, which is a
+       * single contiguous array of the data values for all the rows,
+       * plus a parallel array of the LLI, SSI and blank flags packed
+       * into 16 bits.  The satellite and epoch of each row are kept
+       * in index arrays, and the epochs' times, flags and clock
+       * offsets are kept in separate arrays.  Compared to a
+       * std::vector<Rinex3ObsData>, this avoids a map and a vector
+       * allocation per epoch and satellite, and the per-datum
+       * overhead of RinexDatum.
+       *
+       * The observation types (columns) are identified by arbitrary
+       * strings, e.g. the 4-character system + RINEX 3 obs ID used
+       * by Rinex3ObsFileLoader ("GC1C").  Data can be added and
+       * retrieved as Rinex3ObsData either with the observations of
+       * each satellite parallel to the store's observation types
+       * (as in Rinex3ObsFileLoader), or mapped through a
+       * Rinex3ObsHeader, in which case the column names are the
+       * system character followed by the RINEX 3 obs ID.
+       *
+       * EpochView and SatView provide access to the data of one
+       * epoch or one satellite without copying.  Views (and
+       * references returned by the accessors) are invalidated by
+       * any change to the store.
+       *
+       * @note The auxiliary header records of epochs with flags
+       *   2-5 are not stored, nor are transmitter antenna data.
+       */
+   class Rinex3ObsColumnStore
+   {
+   public:
+         /// Bits of the packed flags, see getFlags().
+      static const uint16_t lliMask = 0x000f;
+      static const uint16_t ssiMask = 0x00f0;
+      static const unsigned ssiShift = 4;
+      static const uint16_t dataBlankBit = 0x0100;
+      static const uint16_t lliBlankBit = 0x0200;
+      static const uint16_t ssiBlankBit = 0x0400;
+
+         /** Access the data of one epoch in the store without
+          * copying.  The satellites are indexed 0 to size()-1 in
+          * the order they were added. */
+      class EpochView
+      {
+      public:
+            /// Create an empty view.
+         EpochView()
+               : store(nullptr), epoch(0), first(0), last(0)
+         {}
+            /// Number of satellites in the epoch.
+         size_t size() const
+         { return last - first; }
+            /// Index of the epoch in the store.
+         size_t getEpoch() const
+         { return epoch; }
+            /// Time of the epoch.
+         const CommonTime& getTime() const
+         { return store->times[epoch]; }
+            /// Epoch flag of the epoch.
+         short getEpochFlag() const
+         { return store->epochFlags[epoch]; }
+            /// Receiver clock offset of the epoch.
+         double getClockOffset() const
+         { return store->clockOffsets[epoch]; }
+            /// Store row of the i'th satellite.
+         size_t getRow(size_t i) const
+         { return first + i; }
+            /// Identity of the i'th satellite.
+         const RinexSatID& getSat(size_t i) const
+         { return store->getRowSat(first + i); }
+            /// Data value of the i'th satellite for column col.
+         double getData(size_t i, size_t col) const
+         { return store->data[col][first + i]; }
+            /// All the data of the i'th satellite for column col.
+         RinexDatum getDatum(size_t i, size_t col) const
+         { return store->getDatum(first + i, col); }
+      private:
+         friend class Rinex3ObsColumnStore;
+            /// The store being viewed.
+         const Rinex3ObsColumnStore *store;
+            /// Index of the epoch.
+         size_t epoch;
+            /// First row of the epoch.
+         size_t first;
+            /// One past the last row of the epoch.
+         size_t last;
+      };
+
+         /** Access the data of one satellite in the store without
+          * copying.  The epochs are indexed 0 to size()-1 in time
+          * order. */
+      class SatView
+      {
+      public:
+            /// Create an empty view.
+         SatView()
+               : store(nullptr), rows(nullptr)
+         {}
+            /// Number of epochs with data for the satellite.
+         size_t size() const
+         { return (rows == nullptr ? 0 : rows->size()); }
+            /// Identity of the satellite.
+         const RinexSatID& getSat() const
+         { return sat; }
+            /// Store row of the i'th epoch.
+         size_t getRow(size_t i) const
+         { return (*rows)[i]; }
+            /// Store epoch index of the i'th epoch.
+         size_t getEpoch(size_t i) const
+         { return store->rowEpoch[(*rows)[i]]; }
+            /// Time of the i'th epoch.
+         const CommonTime& getTime(size_t i) const
+         { return store->times[getEpoch(i)]; }
+            /// Data value of the i'th epoch for column col.
+         double getData(size_t i, size_t col) const
+         { return store->data[col][(*rows)[i]]; }
+            /// All the data of the i'th epoch for column col.
+         RinexDatum getDatum(size_t i, size_t col) const
+         { return store->getDatum((*rows)[i], col); }
+      private:
+         friend class Rinex3ObsColumnStore;
+            /// The store being viewed.
+         const Rinex3ObsColumnStore *store;
+            /// The satellite being viewed.
+         RinexSatID sat;
+            /// The rows containing data for sat.
+         const std::vector<uint32_t> *rows;
+      };
+
+         /// Create an empty store with no observation types.
+      Rinex3ObsColumnStore() = default;
+
+         /** Create an empty store with the given observation types.
+          * @param[in] types The names of the observation types, one
+          *   per column.
+          * @throw InvalidParameter if a name is repeated. */
+      Rinex3ObsColumnStore(const std::vector<std::string>& types);
+
+         /** Remove all the data, leaving the observation types in
+          * place. */
+      void clear();
+
+         /** Add an observation type (column) to the store.  Any
+          * existing rows get default (zero) data for the new column.
+          * @param[in] type The name of the observation type.
+          * @return The column index of the observation type.
+          * @throw InvalidParameter if type is already in the store. */
+      size_t addObsType(const std::string& type);
+
+         /// Get the names of the observation types, in column order.
+      const std::vector<std::string>& getObsTypes() const
+      { return obsTypes; }
+
+         /// Get the number of observation types (columns).
+      size_t numObsTypes() const
+      { return obsTypes.size(); }
+
+         /** Get the column index of an observation type.
+          * @return the index, or -1 if type is not in the store. */
+      int getObsIndex(const std::string& type) const;
+
+         /// Get the number of epochs in the store.
+      size_t numEpochs() const
+      { return times.size(); }
+
+         /// Get the number of rows (satellite-epochs) in the store.
+      size_t numRows() const
+      { return rowEpoch.size(); }
+
+         /// Get the satellites in the store, in the order first seen.
+      const std::vector<RinexSatID>& getSats() const
+      { return sats; }
+
+         /// Get the time of an epoch.
+      const CommonTime& getTime(size_t epoch) const
+      { return times[epoch]; }
+
+         /// Get the epoch flag of an epoch.
+      short getEpochFlag(size_t epoch) const
+      { return epochFlags[epoch]; }
+
+         /// Get the receiver clock offset of an epoch.
+      double getClockOffset(size_t epoch) const
+      { return clockOffsets[epoch]; }
+
+         /// Get the satellite of a row.
+      const RinexSatID& getRowSat(size_t row) const
+      { return sats[rowSat[row]]; }
+
+         /// Get the epoch index of a row.
+      size_t getRowEpoch(size_t row) const
+      { return rowEpoch[row]; }
+
+         /** Get the data values of a column for all rows.
+          * @param[in] col The column index of the observation type. */
+      const std::vector<double>& getData(size_t col) const
+      { return data[col]; }
+
+         /** Get the packed LLI, SSI and blank flags of a column for
+          * all rows.  LLI is in the bits lliMask, SSI in the bits
+          * ssiMask (shifted by ssiShift), and the RinexDatum blank
+          * flags are the bits dataBlankBit, lliBlankBit and
+          * ssiBlankBit.
+          * @param[in] col The column index of the observation type. */
+      const std::vector<uint16_t>& getFlags(size_t col) const
+      { return flags[col]; }
+
+         /// Get the data value for one row and column.
+      double getData(size_t row, size_t col) const
+      { return data[col][row]; }
+
+         /// Get the data for one row and column as a RinexDatum.
+      RinexDatum getDatum(size_t row, size_t col) const;
+
+         /** Start a new epoch at the end of the store.  Rows for
+          * the epoch are then added with addRow().
+          * @param[in] time The time of the epoch, which should not
+          *   precede the time of the last epoch.
+          * @param[in] epochFlag The RINEX epoch flag.
+          * @param[in] clockOffset The receiver clock offset.
+          * @return The index of the new epoch. */
+      size_t addEpoch(const CommonTime& time, short epochFlag,
+                      double clockOffset);
+
+         /** Add a row for a satellite to the last epoch, with
+          * default (zero) data in every column.
+          * @param[in] sat The satellite the row is for.
+          * @return The index of the new row.
+          * @throw InvalidRequest if there are no epochs. */
+      size_t addRow(const RinexSatID& sat);
+
+         /** Set the data for one row and column.
+          * @param[in] row The row index, as returned by addRow().
+          * @param[in] col The column index of the observation type.
+          * @param[in] rd The data to store.
+          * @throw InvalidParameter if rd.lli or rd.ssi is outside
+          *   the range 0-15. */
+      void setDatum(size_t row, size_t col, const RinexDatum& rd);
+
+         /** Add an epoch of data where the observations of each
+          * satellite are parallel to the store's observation types.
+          * Missing trailing observations are left at their default.
+          * @param[in] rod The data to add.
+          * @throw InvalidParameter if a satellite has more
+          *   observations than there are columns, or a datum is
+          *   invalid (see setDatum()). */
+      void addEpoch(const Rinex3ObsData& rod);
+
+         /** Add an epoch of data where the observations of each
+          * satellite are ordered as in the header for the
+          * satellite's system.  Only the observations whose system
+          * character + RINEX 3 obs ID match a column are stored.
+          * @param[in] rod The data to add.
+          * @param[in] roh The header describing rod.
+          * @throw InvalidParameter if a datum is invalid (see
+          *   setDatum()). */
+      void addEpoch(const Rinex3ObsData& rod, const Rinex3ObsHeader& roh);
+
+         /** Get an epoch of data with the observations of each
+          * satellite parallel to the store's observation types.
+          * @param[in] epoch The index of the epoch to get.
+          * @param[out] rod The resulting data.  numSVs is set to
+          *   the number of satellites in the epoch. */
+      void getEpoch(size_t epoch, Rinex3ObsData& rod) const;
+
+         /** Get an epoch of data with the observations of each
+          * satellite ordered as in the header for the satellite's
+          * system, e.g. for writing to a Rinex3ObsStream.
+          * Observation types in the header that have no column are
+          * left at their default.
+          * @param[in] epoch The index of the epoch to get.
+          * @param[in] roh The header describing the output.
+          * @param[out] rod The resulting data.  numSVs is set to
+          *   the number of satellites in the epoch. */
+      void getEpoch(size_t epoch, const Rinex3ObsHeader& roh,
+                    Rinex3ObsData& rod) const;
+
+         /// Get a view of one epoch of the store.
+      EpochView getEpochView(size_t epoch) const;
+
+         /** Get a view of all the data for one satellite.  The view
+          * is empty if there is no data for sat. */
+      SatView getSatView(const RinexSatID& sat) const;
+
+         /// Get the approximate number of bytes used by the store.
+      size_t memoryUsed() const;
+
+   private:
+         /// Pack the flags of a RinexDatum.
+      static uint16_t packFlags(const RinexDatum& rd);
+
+         /** Get the column index for each obs type in the header
+          * for sys, -1 if there's no such column. */
+      void mapHeaderTypes(const std::string& sys, const Rinex3ObsHeader& roh,
+                          std::vector<int>& cols) const;
+
+         /// Observation type names, one per column.
+      std::vector<std::string> obsTypes;
+         /// Column index by name.
+      std::map<std::string, size_t> obsIndex;
+         /// Time of each epoch.
+      std::vector<CommonTime> times;
+         /// Epoch flag of each epoch.
+      std::vector<short> epochFlags;
+         /// Receiver clock offset of each epoch.
+      std::vector<double> clockOffsets;
+         /// First row of each epoch.
+      std::vector<uint32_t> epochFirstRow;
+         /// Epoch index of each row.
+      std::vector<uint32_t> rowEpoch;
+         /// Index into sats of each row.
+      std::vector<uint16_t> rowSat;
+         /// Satellites in the order first seen.
+      std::vector<RinexSatID> sats;
+         /// Index into sats by satellite.
+      std::map<RinexSatID, uint16_t> satIndex;
+         /// Rows of each satellite, parallel to sats.
+      std::vector<std::vector<uint32_t> > satRows;
+         /// Data values, indexed by column then row.
+      std::vector<std::vector<double> > data;
+         /// Packed LLI/SSI/blank flags, indexed by column then row.
+      std::vector<std::vector<uint16_t> > flags;
+   };
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // RINEX3OBSCOLUMNSTORE_HPP
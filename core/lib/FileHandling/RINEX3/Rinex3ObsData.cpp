@@ -389,8 +389,6 @@ namespace gnsstk
 
    void reallyGetRecordVer2(Rinex3ObsStream& strm, Rinex3ObsData& rod)
    {
-      static CommonTime previousTime(CommonTime::BEGINNING_OF_TIME);
-
          // get the epoch line and check
       string line;
       while(line.empty())        // ignore blank lines in place of epoch lines
@@ -426,7 +424,7 @@ namespace gnsstk
          GNSSTK_THROW(e);
       }
       else if(noEpochTime)
-         rod.time = previousTime;
+         rod.time = strm.previousTime;
       else
       {
          try
@@ -487,7 +485,7 @@ namespace gnsstk
             // end rod.time = parseTime(line, strm.header);
 
             // save for next call
-         previousTime = rod.time;
+         strm.previousTime = rod.time;
       }
 
          // number of satellites
@@ -537,40 +535,50 @@ namespace gnsstk
 
             // number of R2 OTs in header
          int numObs(strm.header.R2ObsTypes.size());
+            // which R2 OTs map into a valid R3 ObsID, for each system
+         map<string, vector<bool> > validOT;
          rod.obs.clear();
             // loop over all sats, reading obs data
          for(isv=0; isv < rod.numSVs; isv++)
          {
             sat = satIndex[isv];                   // sat for this data
             satsys = asString(sat.systemChar());   // system for this sat
-            vector<RinexDatum> data;
-               // loop over data in the line
+            vector<bool>& valid(validOT[satsys]);
+            if(valid.empty())
+            {
+               valid.resize(numObs);
+               for(ndx=0; ndx < numObs; ndx++)
+               {
+                  string R2ot(strm.header.R2ObsTypes[ndx]);
+                  string R3ot(strm.header.mapSysR2toR3ObsID[satsys][R2ot].asString());
+                  valid[ndx] = (R3ot != string("   "));
+               }
+            }
+            vector<RinexDatum>& data(rod.obs[sat]);
+            data.clear();
+               // loop over data in the line, decoding directly from the
+               // stream's line buffer
+            const char *dline = 0;
+            size_t dlen = 0;
             for(ndx=0, line_ndx=0; ndx < numObs; ndx++, line_ndx++)
             {
                if(! (line_ndx % 5))
                {              // get a new line
-                  strm.formattedGetLine(line);
-                  StringUtils::stripTrailing(line);
-                  line.resize(80, ' ');            // pad just in case
+                  strm.formattedGetLine(dline, dlen);
+                  if(dlen > 80)                    // ignore anything past 80
+                     dlen = 80;
                   line_ndx = 0;
-                  if(line.size() > 80)
-                  {
-                     FFStreamError err("Invalid line size:" +
-                                       asString(line.size()));
-                     GNSSTK_THROW(err);
-                  }
                }
 
                   // does this R2 OT map into a valid R3 ObsID?
-               string R2ot(strm.header.R2ObsTypes[ndx]);
-               string R3ot(strm.header.mapSysR2toR3ObsID[satsys][R2ot].asString());
-               if(R3ot != string("   "))
+               if(valid[ndx])
                {
-                  RinexDatum tempData(line.substr(line_ndx*16, 16));
-                  data.push_back(tempData);
+                  size_t pos(line_ndx*16);
+                  data.push_back(RinexDatum());
+                  data.back().fromString(dline + pos,
+                                         (pos < dlen ? dlen - pos : 0));
                }
             }
-            rod.obs[sat] = data;
 
          }  // end loop over sats to read obs data
       }
@@ -665,13 +673,17 @@ namespace gnsstk
 
          for(int isv = 0; isv < numSVs; isv++)
          {
-            strm.formattedGetLine(line);
-            StringUtils::stripTrailing(line, " ");
+               // the line is decoded directly from the stream's buffer
+            const char *dline;
+            size_t dlen;
+            strm.formattedGetLine(dline, dlen);
+            while((dlen > 0) && (dline[dlen-1] == ' '))
+               dlen--;
 
                // get the SV ID
             try
             {
-               satIndex[isv] = RinexSatID(line.substr(0,3));
+               satIndex[isv] = RinexSatID(string(dline, (dlen < 3 ? dlen : 3)));
             }
             catch (Exception& e)
             {
@@ -687,22 +699,15 @@ namespace gnsstk
                // Some receivers leave blanks for missing Obs (which
                // is OK by RINEX 3).  If the last Obs are the ones
                // missing, it won't necessarily be padded with spaces,
-               // so the parser will break.  This adds the padding to
-               // let the parser do its job and interpret spaces as
-               // zeroes.
-            size_t minSize = 3 + 16*size;
-            if(line.size() < minSize)
-               line += string(minSize-line.size(), ' ');
-
-               // get the data (# entries in ObsType map of maps from header)
-            vector<RinexDatum> data;
+               // so any data past the end of the line are decoded as
+               // blanks, i.e. zeroes.
+            vector<RinexDatum>& data(obs[satIndex[isv]]);
+            data.resize(size);
             for(int i = 0; i < size; i++)
             {
                size_t pos = 3 + 16*i;
-               RinexDatum tempData(line.substr(pos,16));
-               data.push_back(tempData);
+               data[i].fromString(dline + pos, (pos < dlen ? dlen - pos : 0));
             }
-            obs[satIndex[isv]] = data;
          }
       }
 
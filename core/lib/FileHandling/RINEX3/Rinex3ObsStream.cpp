@@ -91,6 +91,7 @@ namespace gnsstk
       headerRead = false;
       header = Rinex3ObsHeader();
       timesystem = TimeSystem::GPS;
+      previousTime = CommonTime::BEGINNING_OF_TIME;
    }
 
 
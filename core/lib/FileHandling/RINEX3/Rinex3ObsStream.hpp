@@ -112,6 +112,10 @@ namespace gnsstk
          /// Time system for epochs in this file
       TimeSystem timesystem;
 
+         /** Time of the last RINEX 2 epoch read, used for event
+          * records that have no time. */
+      CommonTime previousTime;
+
          /// Check if the input stream is the kind of Rinex3ObsStream
       static bool isRinex3ObsStream(std::istream& i);
 
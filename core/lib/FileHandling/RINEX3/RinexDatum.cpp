@@ -40,6 +40,7 @@
  * Defines class methods for a single RINEX datum.
  */
 
+#include <algorithm>
 #include "RinexDatum.hpp"
 #include "Exception.hpp"
 #include "StringUtils.hpp"
@@ -65,41 +66,52 @@ namespace gnsstk
    void RinexDatum ::
    fromString(const std::string& str)
    {
-      std::string tmpStr;
       GNSSTK_ASSERT(str.length() == 16);
-      tmpStr = str.substr(0, 14);
-      if (tmpStr.find_last_not_of(" ") == std::string::npos)
+      fromString(str, 0);
+   }
+
+
+   void RinexDatum ::
+   fromString(const std::string& str, std::string::size_type pos)
+   {
+      GNSSTK_ASSERT(str.length() >= pos + 16);
+      fromString(str.data() + pos, 16);
+   }
+
+
+   void RinexDatum ::
+   fromString(const char *field, std::string::size_type len)
+   {
+      char padded[16];
+      if (len < 16)
+      {
+         std::fill(std::copy(field, field + len, padded), padded + 16, ' ');
+         field = padded;
+      }
+      std::string::size_type i = 0;
+      while ((i < 14) && (field[i] == ' '))
+         i++;
+      if (i == 14)
       {
          data = 0.;
          dataBlank = true;
       }
       else
       {
-         data = StringUtils::asDouble(tmpStr);
+         data = StringUtils::asDouble(field, 14);
          dataBlank = false;
       }
-      tmpStr = str.substr(14, 1);
-      if (tmpStr == " ")
-      {
-         lli = 0.;
-         lliBlank = true;
-      }
-      else
-      {
-         lli = StringUtils::asInt(tmpStr);
-         lliBlank = false;
-      }
-      tmpStr = str.substr(15, 1);
-      if (tmpStr == " ")
-      {
-         ssi = 0.;
-         ssiBlank = true;
-      }
-      else
-      {
-         ssi = StringUtils::asInt(tmpStr);
-         ssiBlank = false;
-      }
+      lli = digitValue(field[14], lliBlank);
+      ssi = digitValue(field[15], ssiBlank);
+   }
+
+
+   short RinexDatum ::
+   digitValue(char c, bool& blank)
+   {
+      blank = (c == ' ');
+         // same as StringUtils::asInt of a single character
+      return (((c >= '0') && (c <= '9')) ? (c - '0') : 0);
    }
 
 
@@ -70,6 +70,23 @@ namespace gnsstk
           * @throw AssertionFailure if str.length() != 16 */
       void fromString(const std::string& str);
 
+         /** Parse a RINEX OBS datum in the middle of a string into
+          * data members, without making a temporary copy.
+          * @param[in] str a string containing a RINEX-formatted datum.
+          * @param[in] pos the position in str of the 16-character
+          *   datum.
+          * @throw AssertionFailure if str.length() < pos+16 */
+      void fromString(const std::string& str, std::string::size_type pos);
+
+         /** Parse a RINEX OBS datum directly from a line buffer into
+          * data members.  A datum at the end of a line may have had
+          * its trailing blanks removed, so fewer than 16 characters
+          * may be available; the missing ones are taken as blanks.
+          * @param[in] field the first character of the datum.
+          * @param[in] len the number of characters available at
+          *   field; only the first 16 are used. */
+      void fromString(const char *field, std::string::size_type len);
+
          /// Turn this datum into a RINEX OBS formatted string
       std::string asString() const;
 
@@ -79,6 +96,13 @@ namespace gnsstk
       bool lliBlank;  ///< True if the lli is blank in the file
       short ssi;      ///< See the RINEX Spec. for an explanation.
       bool ssiBlank;  ///< True if the ssi is blank in the file
+
+   private:
+         /** Decode a single-digit LLI or SSI field.
+          * @param[in] c the character of the field.
+          * @param[out] blank set to true if c is a space.
+          * @return the value of the digit, 0 if c is not a digit. */
+      static short digitValue(char c, bool& blank);
    };
 
       //@}
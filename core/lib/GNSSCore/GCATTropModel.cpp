@@ -62,17 +62,7 @@ namespace gnsstk
    double GCATTropModel::correction( const Position& RX,
                                      const Position& SV )
    {
-
-      try
-      {
-         setReceiverHeight( RX.getAltitude() );
-      }
-      catch(GeometryException& e)
-      {
-         valid = false;
-      }
-
-      if(!valid) throw InvalidTropModel("Invalid model");
+      setReceiver(RX);
 
       double c;
       try
@@ -100,6 +90,28 @@ namespace gnsstk
    }
 
 
+   void GCATTropModel::batchCorrection( const std::vector<double>& elevation,
+                                        std::vector<double>& delay ) const
+   {
+      THROW_IF_INVALID();
+
+      batchMapping(dry_zenith_delay() + wet_zenith_delay(), elevation, delay);
+   }
+
+
+   void GCATTropModel::batchCorrection( const Position& RX,
+                                        const std::vector<Position>& SV,
+                                        const CommonTime&,
+                                        std::vector<double>& delay )
+   {
+      setReceiver(RX);
+
+      std::vector<double> elevation;
+      elevationGeodetic(RX, SV, elevation);
+      GCATTropModel::batchCorrection(elevation, delay);
+   }
+
+
    double GCATTropModel::dry_zenith_delay() const
    {
       THROW_IF_INVALID();
@@ -123,6 +135,48 @@ namespace gnsstk
    }
 
 
+   void GCATTropModel::batchMapping( double zenith,
+                                     const std::vector<double>& elevation,
+                                     std::vector<double>& delay ) const
+   {
+      std::size_t n = elevation.size();
+      delay.resize(n);
+      for(std::size_t i = 0; i < n; i++)
+      {
+         delay[i] = std::sin(elevation[i]*DEG_TO_RAD);
+      }
+
+         // same arithmetic as mapping_function(), with the elevation
+         // cutoff applied in a separate pass; GCC does not vectorize
+         // this loop unless sqrt may ignore errno (-fno-math-errno)
+      for(std::size_t i = 0; i < n; i++)
+      {
+         double d = SQRT(0.002001+(delay[i]*delay[i]));
+         delay[i] = zenith * (1.001/d);
+      }
+      for(std::size_t i = 0; i < n; i++)
+      {
+         if(elevation[i] < 5.0)
+            delay[i] = 0.0;
+      }
+   }
+
+
+   void GCATTropModel::setReceiver(const Position& RX)
+   {
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid) throw InvalidTropModel("Invalid model");
+   }
+
+
    void GCATTropModel::setReceiverHeight(const double& ht)
    {
       gcatHeight = ht;
@@ -150,6 +150,22 @@ namespace gnsstk
                                  const CommonTime& tt );
 
 
+         /// @copydoc TropModel::batchCorrection(const std::vector<double>&,std::vector<double>&) const
+      virtual void batchCorrection( const std::vector<double>& elevation,
+                                    std::vector<double>& delay ) const;
+
+
+         /** @copydoc TropModel::batchCorrection(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+          *
+          * @note This model does not use time. The \a tt parameter is a
+          *   dummy parameter kept just for consistency
+          */
+      virtual void batchCorrection( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    std::vector<double>& delay );
+
+
          /// @copydoc TropModel::dry_zenith_delay() const
       virtual double dry_zenith_delay() const;
 
@@ -201,8 +217,25 @@ namespace gnsstk
       virtual void setReceiverHeight(const double& ht);
 
 
+   protected:
+
+         /** Compute zenith * mapping_function(elevation[i]) for each
+          * elevation, zero below 5 degrees.
+          * @param[in] zenith Total zenith delay in meters.
+          * @param[in] elevation Elevations in degrees.
+          * @param[out] delay Slant delays in meters.
+          */
+      void batchMapping( double zenith,
+                         const std::vector<double>& elevation,
+                         std::vector<double>& delay ) const;
+
+
    private:
 
+         /** Set the receiver height from a position.
+          * @throw InvalidTropModel if the model is then not valid. */
+      void setReceiver(const Position& RX);
+
          /// Receiver height
       double gcatHeight;
    };
@@ -36,11 +36,33 @@
 //
 //==============================================================================
 
+#include <map>
+#include <mutex>
 #include "GlobalTropModel.hpp"
 #include "MJD.hpp"
 
 namespace gnsstk
 {
+      /** Coefficients of recently used stations, keyed by latitude
+       * and longitude. */
+   class GlobalTropModel::CoeffCache
+   {
+   public:
+      CoeffCache()
+            : maxStations(DEFAULT_COEFF_CACHE_SIZE), hits(0), misses(0)
+      {}
+         /// Maximum number of stations, 0 = disabled.
+      size_t maxStations;
+         /// Number of updates that found their station in the cache.
+      unsigned long hits;
+         /// Number of updates that did not.
+      unsigned long misses;
+         /// Cached coefficients.
+      std::map<std::pair<double,double>, Coefficients> data;
+         /// Serialize access to all the above.
+      std::mutex mtx;
+   };
+
 
    // Constants for Global mapping functions
    const double GlobalTropModel::ADryMean[55] = {
@@ -284,15 +306,15 @@ namespace gnsstk
 
    const double GlobalTropModel::HEIGHT_LIMIT = 44243.;
 
+   const size_t GlobalTropModel::DEFAULT_COEFF_CACHE_SIZE;
+
    GlobalTropModel :: GlobalTropModel()
          : validCoeff(false), validHeight(false), validLat(false),
            validLon(false), validDay(false), height(0.0), latitude(0.0),
            longitude(0.0), dayfactor(0.0), undul(0.0)
    {
          // yes setting everything to 0 is the same as IEEE 0.0
-      memset(P, 0, sizeof(P));
-      memset(aP, 0, sizeof(aP));
-      memset(bP, 0, sizeof(bP));
+      memset(&coeff, 0, sizeof(coeff));
       TropModel::humid = 50.0;
       valid = false;
    }
@@ -320,19 +342,7 @@ namespace gnsstk
 
    double GlobalTropModel::correction(const Position& RX, const Position& SV)
    {
-      try {
-         double p;
-         p = RX.getAltitude();         if(p != height) setReceiverHeight(p);
-         p = RX.getGeodeticLatitude(); if(p != latitude) setReceiverLatitude(p);
-         p = RX.getLongitude();        if(p != longitude) setReceiverLongitude(p);
-      }
-      catch(GeometryException& e) {
-         validHeight = validLat = valid = false;
-         GNSSTK_RETHROW(e);
-      }
-
-      try { testValidity(); }
-      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+      setReceiver(RX);
 
       double c;
       try {
@@ -345,6 +355,54 @@ namespace gnsstk
    }  // end GlobalTropModel::correction(RX,SV)
 
 
+   void GlobalTropModel::batchCorrection(const std::vector<double>& elevation,
+                                         std::vector<double>& delay) const
+   {
+      try { testValidity(); }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+
+      double ah, bh, ch, aw, bw, cw;
+      dryCoefficients(ah, bh, ch);
+      wetCoefficients(aw, bw, cw);
+      double dryZenith(GlobalTropModel::dry_zenith_delay());
+      double wetZenith(GlobalTropModel::wet_zenith_delay());
+
+      std::size_t n = elevation.size();
+      delay.resize(n);
+      for(std::size_t i=0; i<n; i++)
+         delay[i] = ::sin(elevation[i]*DEG_TO_RAD);
+
+      // GCC -O3 vectorizes this loop (checked with -fopt-info-vec); a
+      // branch would prevent that, so the cutoff is a separate pass
+      for(std::size_t i=0; i<n; i++) {
+         double sine = delay[i];
+         double map_dry = continuedFraction(sine, ah, bh, ch)
+                        + heightCorrection(sine, height);
+         double map_wet = continuedFraction(sine, aw, bw, cw);
+         delay[i] = dryZenith * map_dry + wetZenith * map_wet;
+      }
+      // Global mapping functions good down to 3 degrees of elevation
+      for(std::size_t i=0; i<n; i++)
+         if(elevation[i] < 3.0) delay[i] = 0.0;
+
+   }  // end GlobalTropModel::batchCorrection(elevation)
+
+
+   void GlobalTropModel::batchCorrection(const Position& RX,
+                                         const std::vector<Position>& SV,
+                                         const CommonTime& tt,
+                                         std::vector<double>& delay)
+   {
+      setTime(tt);
+      setReceiver(RX);
+
+      std::vector<double> elevation;
+      elevationGeodetic(RX, SV, elevation);
+      GlobalTropModel::batchCorrection(elevation, delay);
+
+   }  // end GlobalTropModel::batchCorrection(RX,SV,TT)
+
+
    double GlobalTropModel::dry_zenith_delay() const
    {
       try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
@@ -366,10 +424,31 @@ namespace gnsstk
       try { testValidity(); } catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
       if(elevation < 3.0) { return 0.0; }
 
+      double ah, bh, ch;
+      dryCoefficients(ah, bh, ch);
+
+      double sine = ::sin(elevation*DEG_TO_RAD);
+      //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
+      // << std::endl;
+      //std::cout << "ah bh ch " << std::fixed << std::setprecision(16)
+      // << ah << " " << bh << " " << ch << std::endl;
+      double map = continuedFraction(sine, ah, bh, ch);
+      //std::cout << "map0 " << std::fixed << std::setprecision(16) << map
+      // << std::endl;
+
+      map += heightCorrection(sine, height);
+
+      return map;
+
+   }  // end GlobalTropModel::dry_mapping_function()
+
+
+   void GlobalTropModel::dryCoefficients(double& ah, double& bh, double& ch)
+      const
+   {
       double clat = ::cos(latitude*DEG_TO_RAD);
       double phh, c11h, c10h;
 
-      static const double bh = 0.0029;
       static const double c0h = 0.062;
       if(latitude < 0) {
          phh = PI;
@@ -381,37 +460,12 @@ namespace gnsstk
          c11h = 0.005;
          c10h = 0.001;
       }
-      double ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
+      ch = c0h + ((::cos(dayfactor + phh)+1.0)*c11h/2.0 + c10h)*(1.0-clat);
+      bh = 0.0029;
 
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
-         aa += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double ah = am + aa*::cos(dayfactor);
+      ah = coeff.dryMean + coeff.dryAmp*::cos(dayfactor);
 
-      double sine = ::sin(elevation*DEG_TO_RAD);
-      //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
-      // << std::endl;
-      //std::cout << "ah bh ch " << std::fixed << std::setprecision(16)
-      // << ah << " " << bh << " " << ch << std::endl;
-      double map = (1.0 + ah/(1.0 + bh/(1.0 + ch)))
-                 / (sine + ah/(sine + bh/(sine + ch)));
-      //std::cout << "map0 " << std::fixed << std::setprecision(16) << map
-      // << std::endl;
-
-      // height correction
-      static const double a_ht = 2.53e-5;
-      static const double b_ht = 5.49e-3;
-      static const double c_ht = 1.14e-3;
-
-      map += ( (1.0/sine) - (1.0  + a_ht/(1.0  + b_ht/(1.0  + c_ht)))
-                          / (sine + a_ht/(sine + b_ht/(sine + c_ht)))
-             ) * (height/1000.0);
-
-      return map;
-
-   }  // end GlobalTropModel::dry_mapping_function()
+   }  // end GlobalTropModel::dryCoefficients()
 
    /* Computing the derivative - do it numerically instead
     * note that sin[elev] = cos[zenith]
@@ -454,24 +508,15 @@ namespace gnsstk
 
       if(elevation < 3.0) { return 0.0; }
 
-      static const double bw = 0.00146;
-      static const double cw = 0.04391;
-
-      double am(0.0), aa(0.0);
-      for(int i=0; i<55; i++) {
-         am += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
-         aa += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
-      }
-      double aw = am + aa*::cos(dayfactor);
+      double aw, bw, cw;
+      wetCoefficients(aw, bw, cw);
 
       double sine = ::sin(elevation*DEG_TO_RAD);
       //std::cout << "sine " << std::fixed << std::setprecision(16) << sine
       // << std::endl;
       //std::cout << "aw bw cw " << std::fixed << std::setprecision(16)
       // << aw << " " << bw << " " << cw << std::endl;
-      double f1(1.0 + aw/(1.0 + bw/(1.0 + cw)));
-      double f(sine + aw/(sine + bw/(sine + cw)));
-      double map = f1/f;
+      double map = continuedFraction(sine, aw, bw, cw);
 
       /** @note might be easier numerically... map' = map(elev+eps)-map(elev-eps)/2eps
        *if(doDeriv) {
@@ -490,16 +535,24 @@ namespace gnsstk
    }  // end GlobalTropModel::wet_mapping_function()
 
 
+   void GlobalTropModel::wetCoefficients(double& aw, double& bw, double& cw)
+      const
+   {
+      bw = 0.00146;
+      cw = 0.04391;
+
+      aw = coeff.wetMean + coeff.wetAmp*::cos(dayfactor);
+
+   }  // end GlobalTropModel::wetCoefficients()
+
+
    void GlobalTropModel::getGPT(double& P, double& T, double& U)
    {
       try { testValidity(); }
       catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
 
-      int i;
-
       // undulation and orthometric height
-      U = 0.0;
-      for(i=0; i<55; i++) U += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
+      U = coeff.undul;
       double orthoht(height - U);
       if(orthoht > HEIGHT_LIMIT)
       {
@@ -508,47 +561,53 @@ namespace gnsstk
       }
 
       // press at geoid
-      double am(0.0),aa(0.0),v0;
-      for(i=0; i<55; i++) {
-         am += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
-         aa += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
+      double v0 = coeff.pressMean + coeff.pressAmp * ::cos(dayfactor);
 
       // pressure at height
       // @note this implies any orthoht > 1/2.26e-5 == 44247.78m is invalid!
       P = v0 * ::pow(1.0-2.26e-5*orthoht,5.225);
 
       // temper on geoid
-      am = aa = 0.0;
-      for(i=0; i<55; i++) {
-         am += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
-         aa += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
-      }
-      v0 = am + aa * ::cos(dayfactor);
+      v0 = coeff.tempMean + coeff.tempAmp * ::cos(dayfactor);
 
       // temp at height
       T = v0 - 6.5e-3 * orthoht;
    }
 
 
+   void GlobalTropModel::setReceiver(const Position& RX)
+   {
+      try {
+         setReceiverHeight(RX.getAltitude());
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setReceiverLongitude(RX.getLongitude());
+      }
+      catch(GeometryException& e) {
+         validHeight = validLat = valid = false;
+         GNSSTK_RETHROW(e);
+      }
+
+      try { testValidity(); }
+      catch(InvalidTropModel& e) { GNSSTK_RETHROW(e); }
+   }
+
+
    void GlobalTropModel::setReceiverHeight(const double& ht)
    {
-      if(height != ht) {
+      if(!validHeight || height != ht) {
          height = ht;
          validHeight = true;
-         validCoeff = false;
-         setValid();          // calls updateGTMCoeff()
+         setValid();          // height does not change the coefficients
       }
    }
 
 
    void GlobalTropModel::setReceiverLatitude(const double& lat)
    {
-      if(latitude != lat) {
+      if(!validLat || latitude != lat) {
+         if(latitude != lat) validCoeff = false;
          latitude = lat;
          validLat = true;
-         validCoeff = false;
          setValid();          // calls updateGTMCoeff()
       }
    }
@@ -556,10 +615,10 @@ namespace gnsstk
 
    void GlobalTropModel::setReceiverLongitude(const double& lon)
    {
-      if(longitude != lon) {
+      if(!validLon || longitude != lon) {
+         if(longitude != lon) validCoeff = false;
          longitude = lon;
          validLon = true;
-         validCoeff = false;
          setValid();          // calls updateGTMCoeff()
       }
    }
@@ -568,11 +627,10 @@ namespace gnsstk
    void GlobalTropModel::setTime(const double& mjd)
    {
       double df(TWO_PI*(mjd - 44266.0)/365.25);       // -44239 + 1 - 28
-      if(df != dayfactor) {
+      if(!validDay || df != dayfactor) {
          dayfactor = df;
          validDay = true;
-         validCoeff = false;
-         setValid();
+         setValid();          // time does not change the coefficients
       }
    }
 
@@ -593,13 +651,13 @@ namespace gnsstk
 
    void GlobalTropModel::setParameters(const CommonTime& time, const Position& rxPos)
    {
-      validDay = validHeight = validLat = validLon = validCoeff = false;
+      // the coefficients are kept unless the latitude or longitude change,
+      // so a stationary receiver does not recompute them every epoch
+      validDay = validHeight = validLat = validLon = false;
       setTime(time);
       setReceiverHeight(rxPos.getHeight());
       setReceiverLatitude(rxPos.getGeodeticLatitude());
-      setReceiverLongitude(rxPos.getLongitude());
-
-      setValid();          // calls updateGTMCoeff()
+      setReceiverLongitude(rxPos.getLongitude());   // calls setValid()
    }
 
 
@@ -607,9 +665,42 @@ namespace gnsstk
    {
       if(!validLon || !validLat) return;
 
+      CoeffCache& cache(coeffCache());
+      std::pair<double,double> key(latitude, longitude);
+      {
+         std::lock_guard<std::mutex> lock(cache.mtx);
+         if(cache.maxStations > 0) {
+            auto ci = cache.data.find(key);
+            if(ci != cache.data.end()) {
+               cache.hits++;
+               coeff = ci->second;
+               return;
+            }
+            cache.misses++;
+         }
+      }
+
+      // not cached, don't hold the lock while computing
+      computeCoefficients(latitude, longitude, coeff);
+
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      if(cache.maxStations > 0) {
+         if(cache.data.size() >= cache.maxStations) {
+            // simplest policy, just start over
+            cache.data.clear();
+         }
+         cache.data[key] = coeff;
+      }
+   }
+
+
+   void GlobalTropModel::computeCoefficients(double lat, double lon,
+                                             Coefficients& c)
+   {
       // compute Legendre functions and spherical harmonics
       int i,j,k;
-      double sinlat(::sin(latitude*DEG_TO_RAD));
+      double P[10][10], aP[55], bP[55];
+      double sinlat(::sin(lat*DEG_TO_RAD));
       for(i=0; i<=9; i++) {
          for(j=0; j<=i; j++) {
             int ir((i-j)/2);
@@ -626,7 +717,7 @@ namespace gnsstk
       }
 
       // spherical harmonics
-      double rlon(longitude*DEG_TO_RAD);
+      double rlon(lon*DEG_TO_RAD);
       i = 0;
       for(j=0; j<=9; j++) {
          for(k=0; k<=j; k++) {
@@ -636,6 +727,76 @@ namespace gnsstk
          }
       }
 
+      // sum the expansions
+      c.undul = 0.0;
+      for(i=0; i<55; i++) c.undul += (Ageoid[i]*aP[i] + Bgeoid[i]*bP[i]);
+
+      c.pressMean = c.pressAmp = 0.0;
+      c.tempMean = c.tempAmp = 0.0;
+      for(i=0; i<55; i++) {
+         c.pressMean += (APressMean[i]*aP[i] + BPressMean[i]*bP[i]);
+         c.pressAmp += (APressAmp[i]*aP[i] + BPressAmp[i]*bP[i]);
+         c.tempMean += (ATempMean[i]*aP[i] + BTempMean[i]*bP[i]);
+         c.tempAmp += (ATempAmp[i]*aP[i] + BTempAmp[i]*bP[i]);
+      }
+
+      c.dryMean = c.dryAmp = 0.0;
+      c.wetMean = c.wetAmp = 0.0;
+      for(i=0; i<55; i++) {
+         c.dryMean += (ADryMean[i]*aP[i] + BDryMean[i]*bP[i]) * 1.0e-5;
+         c.dryAmp += (ADryAmp[i]*aP[i] + BDryAmp[i]*bP[i]) * 1.0e-5;
+         c.wetMean += (AWetMean[i]*aP[i] + BWetMean[i]*bP[i]) * 1.0e-5;
+         c.wetAmp += (AWetAmp[i]*aP[i] + BWetAmp[i]*bP[i]) * 1.0e-5;
+      }
+   }
+
+
+   GlobalTropModel::CoeffCache& GlobalTropModel::coeffCache()
+   {
+      static CoeffCache cache;
+      return cache;
+   }
+
+
+   void GlobalTropModel::setCoefficientCacheSize(size_t maxStations)
+   {
+      CoeffCache& cache(coeffCache());
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      cache.maxStations = maxStations;
+      cache.data.clear();
+   }
+
+
+   size_t GlobalTropModel::getCoefficientCacheSize()
+   {
+      CoeffCache& cache(coeffCache());
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      return cache.maxStations;
+   }
+
+
+   unsigned long GlobalTropModel::getCoefficientCacheHits()
+   {
+      CoeffCache& cache(coeffCache());
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      return cache.hits;
+   }
+
+
+   unsigned long GlobalTropModel::getCoefficientCacheMisses()
+   {
+      CoeffCache& cache(coeffCache());
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      return cache.misses;
+   }
+
+
+   void GlobalTropModel::clearCoefficientCache()
+   {
+      CoeffCache& cache(coeffCache());
+      std::lock_guard<std::mutex> lock(cache.mtx);
+      cache.data.clear();
+      cache.hits = cache.misses = 0;
    }
 
 
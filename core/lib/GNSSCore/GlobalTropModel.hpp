@@ -73,7 +73,7 @@ namespace gnsstk
        * <pre>
        *  depedency cheat sheet:
        *   User provides:    Model computes/stores:           Output of model:
-       *     lat,lon,ht ---> coeffs  [in updateGTMCoeff()]
+       *     lat,lon    ---> coeffs  [in updateGTMCoeff()]
        *     time (doy) ---> dayfactor [ setTime(mjd) ]
        *     humidity%  ---> humid
        *
@@ -84,7 +84,7 @@ namespace gnsstk
        *                     dayfactor,coeffs --------------> dry_mapping_function(elev)
        *  So, change lat   => coeffs => P,T => wet/dry zen/map
        *             lon   => coeffs => P,T => wet/dry zen/map
-       *             ht    => coeffs => P,T => wet/dry zen/map
+       *             ht    => P,T => wet/dry zen/map
        *             time  => dayfactor => P,T => wet/dry zen/map
        *             humid => wet zen
        *
@@ -92,7 +92,16 @@ namespace gnsstk
        *
        * @note Members of base TropModel::temp,press,humid,valid. 
        *   Members of GlobalTropModel::height,latitude,longitude,dayfactor,undul,
-       *   validHeight, validLat, validLon, validDay
+       *   coeff, validHeight, validLat, validLon, validDay, validCoeff
+       *
+       * The coeffs are the 9x9 spherical harmonic expansions of the GPT
+       * and GMF terms, summed at the receiver latitude and longitude.
+       * They are the expensive part of the model, and they depend on
+       * neither the height nor the time, so changing only those is cheap.
+       * The coeffs of recently used stations are also kept in a cache
+       * shared by all GlobalTropModel objects, see
+       * setCoefficientCacheSize().  A model holds no other large data,
+       * so it is cheap to copy, e.g. one copy per station.
        *
        * A typical way to use this model follows:
        *
@@ -131,9 +140,8 @@ namespace gnsstk
           */
       GlobalTropModel(const double& ht, const double& lat, const double& lon,
                       const double& mjd)
+            : GlobalTropModel()
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid =
-            false;
          setReceiverHeight(ht);
          setReceiverLatitude(lat);
          setReceiverLongitude(lon);
@@ -146,8 +154,8 @@ namespace gnsstk
           * @param time Time.
           */
       GlobalTropModel(const Position& RX, const CommonTime& time)
+            : GlobalTropModel()
       {
-         validCoeff = validHeight = validLat = validLon = validDay = valid = false;
          setReceiverHeight(RX.getAltitude());
          setReceiverLatitude(RX.getGeodeticLatitude());
          setReceiverLongitude(RX.getLongitude());
@@ -188,6 +196,16 @@ namespace gnsstk
          return correction(RX,SV);
       }
 
+         /// @copydoc TropModel::batchCorrection(const std::vector<double>&,std::vector<double>&) const
+      virtual void batchCorrection(const std::vector<double>& elevation,
+                                   std::vector<double>& delay) const;
+
+         /// @copydoc TropModel::batchCorrection(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   std::vector<double>& delay);
+
          /** Compute and return the zenith delay for hydrostatic (dry)
           * component of the troposphere. Use the Saastamoinen value.
           * Ref. Davis etal 1985 and Leick, 3rd ed, pg 197.
@@ -268,6 +286,37 @@ namespace gnsstk
       double getHeightLimit()
       { return HEIGHT_LIMIT; }
 
+         /** Set the maximum number of stations (latitude, longitude
+          * pairs) whose harmonic coefficients are kept in the cache
+          * shared by all GlobalTropModel objects.  When the cache is
+          * full it is emptied and refilled as needed.  The cache only
+          * affects performance, the model results are identical with
+          * or without it.
+          * @param[in] maxStations The maximum number of stations to
+          *   cache.  A value of 0 disables caching.  The default is
+          *   DEFAULT_COEFF_CACHE_SIZE.
+          * @note The cache is safe to use from multiple threads; the
+          *   models using it are not. */
+      static void setCoefficientCacheSize(size_t maxStations);
+
+         /// Get the maximum number of stations to cache.
+      static size_t getCoefficientCacheSize();
+
+         /** Get the number of coefficient updates that were found in
+          * the cache. */
+      static unsigned long getCoefficientCacheHits();
+
+         /** Get the number of coefficient updates that had to compute
+          * the harmonic expansion while the cache was enabled. */
+      static unsigned long getCoefficientCacheMisses();
+
+         /// Empty the coefficient cache and reset its counters.
+      static void clearCoefficientCache();
+
+         /// Default maximum number of stations in the coefficient cache.
+      GNSSTK_EXPORT
+      static const size_t DEFAULT_COEFF_CACHE_SIZE = 10000;
+
    private:
       /** Define the time of interest; this is required before calling
        * correction() or any of the zenith_delay routines.
@@ -308,13 +357,48 @@ namespace gnsstk
       GNSSTK_EXPORT
       static const double HEIGHT_LIMIT;
 
+         /** The spherical harmonic expansions at one latitude and
+          * longitude, split into mean and annual amplitude terms. */
+      struct Coefficients
+      {
+         double undul;                 ///< geoid undulation
+         double pressMean, pressAmp;   ///< pressure at geoid
+         double tempMean, tempAmp;     ///< temperature at geoid
+         double dryMean, dryAmp;       ///< hydrostatic mapping a
+         double wetMean, wetAmp;       ///< wet mapping a
+      };
+
+         /// Shared cache of Coefficients, defined in GlobalTropModel.cpp
+      class CoeffCache;
+
+         /// Get the one shared CoeffCache.
+      static CoeffCache& coeffCache();
+
+         /** Evaluate the harmonic expansions at a latitude and
+          * longitude, in degrees. */
+      static void computeCoefficients(double lat, double lon,
+                                      Coefficients& c);
+
       double height, latitude, longitude, dayfactor, undul;
-      double P[10][10], aP[55], bP[55];
+      Coefficients coeff;
       bool validHeight, validLat, validLon, validDay, validCoeff;
 
       /// Update coefficients when latitude and/or longitude changes
       void updateGTMCoeff();
 
+      /** Set the receiver height, latitude and longitude from a
+       * position, and check that the model is then valid.
+       * @throw GeometryException
+       * @throw InvalidTropModel
+       */
+      void setReceiver(const Position& RX);
+
+      /// Compute the hydrostatic mapping function coefficients a, b, c
+      void dryCoefficients(double& ah, double& bh, double& ch) const;
+
+      /// Compute the wet mapping function coefficients a, b, c
+      void wetCoefficients(double& aw, double& bw, double& cw) const;
+
          /** Utility to test valid flags
           * @throw InvalidTropModel
           */
@@ -328,9 +412,11 @@ namespace gnsstk
       {
          try{
             valid = validHeight && validLat && validLon && validDay;
-            if(valid && !validCoeff) {
-               updateGTMCoeff();
-               validCoeff = true;
+            if(valid) {
+               if(!validCoeff) {
+                  updateGTMCoeff();
+                  validCoeff = true;
+               }
                getGPT(press,temp,undul);
             }
          } catch(Exception& e) { GNSSTK_RETHROW(e); }
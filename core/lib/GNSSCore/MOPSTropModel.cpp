@@ -104,18 +104,7 @@ namespace gnsstk
    double MOPSTropModel::correction( const Position& RX,
                                      const Position& SV )
    {
-      try
-      {
-         setReceiverHeight( RX.getAltitude() );
-         setReceiverLatitude(RX.getGeodeticLatitude());
-         setWeather();
-      }
-      catch(GeometryException& e)
-      {
-         valid = false;
-      }
-
-      if(!valid) throw InvalidTropModel("Invalid model");
+      setReceiver(RX);
 
       double c;
       try
@@ -183,6 +172,30 @@ namespace gnsstk
    }
 
 
+   void MOPSTropModel::batchCorrection( const std::vector<double>& elevation,
+                                        std::vector<double>& delay ) const
+   {
+      THROW_IF_INVALID_DETAILED();
+
+      batchMapping( MOPSTropModel::dry_zenith_delay() +
+                    MOPSTropModel::wet_zenith_delay(), elevation, delay );
+   }
+
+
+   void MOPSTropModel::batchCorrection( const Position& RX,
+                                        const std::vector<Position>& SV,
+                                        const CommonTime& tt,
+                                        std::vector<double>& delay )
+   {
+      setDayOfYear(tt);
+      setReceiver(RX);
+
+      std::vector<double> elevation;
+      elevationGeodetic(RX, SV, elevation);
+      MOPSTropModel::batchCorrection(elevation, delay);
+   }
+
+
    double MOPSTropModel::dry_zenith_delay() const
    {
       THROW_IF_INVALID();
@@ -268,6 +281,23 @@ namespace gnsstk
    }
 
 
+   void MOPSTropModel::setReceiver(const Position& RX)
+   {
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setWeather();
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid) throw InvalidTropModel("Invalid model");
+   }
+
+
    void MOPSTropModel::setReceiverHeight(const double& ht)
    {
       MOPSHeight = ht;
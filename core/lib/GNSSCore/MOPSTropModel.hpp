@@ -211,6 +211,18 @@ namespace gnsstk
                                  const int& doy );
 
 
+         /// @copydoc TropModel::batchCorrection(const std::vector<double>&,std::vector<double>&) const
+      virtual void batchCorrection( const std::vector<double>& elevation,
+                                    std::vector<double>& delay ) const;
+
+
+         /// @copydoc TropModel::batchCorrection(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void batchCorrection( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    std::vector<double>& delay );
+
+
          /// @copydoc TropModel::dry_zenith_delay() const
       virtual double dry_zenith_delay() const;
 
@@ -286,6 +298,11 @@ namespace gnsstk
 
    private:
 
+         /** Set the receiver height and latitude from a position and
+          * recompute the weather parameters.
+          * @throw InvalidTropModel if the model is then not valid. */
+      void setReceiver(const Position& RX);
+
       double MOPSHeight;
       double MOPSLat;
       int MOPSTime;
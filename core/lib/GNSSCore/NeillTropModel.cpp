@@ -119,22 +119,7 @@ namespace gnsstk
    double NeillTropModel::correction( const Position& RX,
                                       const Position& SV )
    {
-
-      try
-      {
-         setReceiverHeight( RX.getAltitude() );
-         setReceiverLatitude(RX.getGeodeticLatitude());
-         setWeather();
-      }
-      catch(GeometryException& e)
-      {
-         valid = false;
-      }
-
-      if(!valid)
-      {
-         throw InvalidTropModel("Invalid model");
-      }
+      setReceiver(RX);
 
       double c;
       try
@@ -200,6 +185,57 @@ namespace gnsstk
    }
 
 
+   void NeillTropModel::batchCorrection( const std::vector<double>& elevation,
+                                         std::vector<double>& delay ) const
+   {
+      THROW_IF_INVALID_DETAILED();
+
+      double ad, bd, cd, aw, bw, cw;
+      dryCoefficients(ad, bd, cd);
+      wetCoefficients(aw, bw, cw);
+      double dryZenith(NeillTropModel::dry_zenith_delay());
+      double wetZenith(NeillTropModel::wet_zenith_delay());
+
+      std::size_t n = elevation.size();
+      delay.resize(n);
+      for(std::size_t i = 0; i < n; i++)
+      {
+         delay[i] = ::sin(elevation[i]*DEG_TO_RAD);
+      }
+
+         // plain arithmetic, which GCC -O3 vectorizes (-fopt-info-vec);
+         // the elevation cutoff test is kept out of this loop
+      for(std::size_t i = 0; i < n; i++)
+      {
+         double se = delay[i];
+         double map_dry = continuedFraction(se, ad, bd, cd)
+            + heightCorrection(se, NeillHeight);
+         double map_wet = continuedFraction(se, aw, bw, cw);
+         delay[i] = dryZenith * map_dry + wetZenith * map_wet;
+      }
+         // Neill mapping functions work down to 3 degrees of elevation
+      for(std::size_t i = 0; i < n; i++)
+      {
+         if(elevation[i] < 3.0)
+            delay[i] = 0.0;
+      }
+   }
+
+
+   void NeillTropModel::batchCorrection( const Position& RX,
+                                         const std::vector<Position>& SV,
+                                         const CommonTime& tt,
+                                         std::vector<double>& delay )
+   {
+      setDayOfYear(tt);
+      setReceiver(RX);
+
+      std::vector<double> elevation;
+      elevationGeodetic(RX, SV, elevation);
+      NeillTropModel::batchCorrection(elevation, delay);
+   }
+
+
    double NeillTropModel::dry_zenith_delay() const
    {
       THROW_IF_INVALID();
@@ -225,6 +261,20 @@ namespace gnsstk
          return 0.0;
       }
 
+      double a, b, c;
+      dryCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = continuedFraction(se, a, b, c);
+
+      map += heightCorrection(se, NeillHeight);
+
+      return map;
+   }
+
+
+   void NeillTropModel::dryCoefficients(double& a, double& b, double& c) const
+   {
       double lat, t, ct;
       lat = fabs(NeillLat);         // degrees
       t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
@@ -237,7 +287,6 @@ namespace gnsstk
       t *= 360.0/365.25;            // convert to degrees
       ct = ::cos(t*DEG_TO_RAD);
 
-      double a, b, c;
       if(lat < 15.0)
       {
          a = NeillDryA[0];
@@ -262,17 +311,6 @@ namespace gnsstk
          b = NeillDryB[4] - ct * NeillDryB1[4];
          c = NeillDryC[4] - ct * NeillDryC1[4];
       }
-
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += ( NeillHeight/1000.0 ) *
-         ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
-
-      return map;
    }
 
 
@@ -285,7 +323,20 @@ namespace gnsstk
          return 0.0;
       }
 
-      double a,b,c,lat;
+      double a,b,c;
+      wetCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = continuedFraction(se, a, b, c);
+
+      return map;
+
+   }  // end NeillTropModel::wet_mapping_function()
+
+
+   void NeillTropModel::wetCoefficients(double& a, double& b, double& c) const
+   {
+      double lat;
       lat = fabs(NeillLat);         // degrees
       if(lat < 15.0)
       {
@@ -307,13 +358,7 @@ namespace gnsstk
          b = NeillWetB[4];
          c = NeillWetC[4];
       }
-
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
-
-      return map;
-
-   }  // end NeillTropModel::wet_mapping_function()
+   }
 
 
    void NeillTropModel::setWeather()
@@ -339,6 +384,26 @@ namespace gnsstk
    }
 
 
+   void NeillTropModel::setReceiver(const Position& RX)
+   {
+      try
+      {
+         setReceiverHeight( RX.getAltitude() );
+         setReceiverLatitude(RX.getGeodeticLatitude());
+         setWeather();
+      }
+      catch(GeometryException& e)
+      {
+         valid = false;
+      }
+
+      if(!valid)
+      {
+         throw InvalidTropModel("Invalid model");
+      }
+   }
+
+
    void NeillTropModel::setReceiverHeight(const double& ht)
    {
       NeillHeight = ht;
@@ -226,6 +226,18 @@ namespace gnsstk
                                  const int& doy );
 
 
+         /// @copydoc TropModel::batchCorrection(const std::vector<double>&,std::vector<double>&) const
+      virtual void batchCorrection( const std::vector<double>& elevation,
+                                    std::vector<double>& delay ) const;
+
+
+         /// @copydoc TropModel::batchCorrection(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void batchCorrection( const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    const CommonTime& tt,
+                                    std::vector<double>& delay );
+
+
          /// @copydoc TropModel::dry_zenith_delay() const
       virtual double dry_zenith_delay() const;
 
@@ -299,6 +311,16 @@ namespace gnsstk
 
 
    private:
+         /** Set the receiver height and latitude from a position.
+          * @throw InvalidTropModel if the model is then not valid. */
+      void setReceiver(const Position& RX);
+
+         /// Compute the hydrostatic mapping function coefficients.
+      void dryCoefficients(double& a, double& b, double& c) const;
+
+         /// Compute the wet mapping function coefficients.
+      void wetCoefficients(double& a, double& b, double& c) const;
+
       double NeillHeight;
       double NeillLat;
       int NeillDOY;
@@ -1056,7 +1056,7 @@ namespace gnsstk
           *                    toward y axis (same as longitude)
           *                 radius (meters?) - distance from origin
           */
-         // use std::valarray<double> theArray;  -- inherit from Triple
+         // use FixedVector<double,3> theArray;  -- inherit from Triple
 
          /// semi-major axis of Earth (meters)
       double AEarth;
@@ -36,6 +36,8 @@
 //
 //==============================================================================
 
+#include <cctype>
+#include <memory>
 #include "RinexSatID.hpp"
 #include "GNSSconstants.hpp"
 
@@ -122,20 +124,35 @@ namespace gnsstk
    fromString(const std::string& s)
    {
       char c;
-      std::istringstream iss(s);
 
       id = -1;
       system = SatelliteSystem::GPS;  // default
       if(s.find_first_not_of(std::string(" \t\n"), 0) == std::string::npos)
          return;                    // all whitespace yields the default
 
-      iss >> c;                     // read one character (non-whitespace)
+         // The usual form, a system character and a two digit number
+         // e.g. "G05" or "R 7", is decoded without a string stream,
+         // which costs far more than the rest of this.
+      bool simple = ((s.size() == 3) &&
+                     std::isalpha(static_cast<unsigned char>(s[0])) &&
+                     ((s[1] == ' ') || ((s[1] >= '0') && (s[1] <= '9'))) &&
+                     (s[2] >= '0') && (s[2] <= '9'));
+      std::unique_ptr<std::istringstream> iss;
+      if(simple)
+      {
+         c = s[0];
+      }
+      else
+      {
+         iss.reset(new std::istringstream(s));
+         *iss >> c;                 // read one character (non-whitespace)
+      }
       switch(c)
       {
             // no leading system character
          case '0': case '1': case '2': case '3': case '4':
          case '5': case '6': case '7': case '8': case '9':
-            iss.putback(c);
+            iss->putback(c);
             system = SatelliteSystem::GPS;
             break;
          case 'R': case 'r':
@@ -170,7 +187,10 @@ namespace gnsstk
                         + c + std::string("\""));
             GNSSTK_THROW(e);
       }
-      iss >> id;
+      if(simple)
+         id = (s[1] == ' ' ? 0 : 10*(s[1]-'0')) + (s[2]-'0');
+      else
+         *iss >> id;
       if(id <= 0)
       {
          id = -1;
@@ -150,21 +150,7 @@ namespace gnsstk
                                     const Position& SV,
                                     const CommonTime& tt)
    {
-      SaasTropModel::setReceiverHeight(RX.getHeight());
-      SaasTropModel::setReceiverLatitude(RX.getGeodeticLatitude());
-      SaasTropModel::setDayOfYear(int((static_cast<YDSTime>(tt).doy)));
-
-      if(!valid) {
-         if(!validWeather) GNSSTK_THROW(
-            InvalidTropModel("Invalid Saastamoinen trop model: weather"));
-         if(!validRxLatitude) GNSSTK_THROW(
-            InvalidTropModel("Invalid Saastamoinen trop model: Rx Latitude"));
-         if(!validRxHeight) GNSSTK_THROW(
-            InvalidTropModel("Invalid Saastamoinen trop model: Rx Height"));
-         if(!validDOY) GNSSTK_THROW(
-            InvalidTropModel("Invalid Saastamoinen trop model: day of year"));
-         valid = true;
-      }
+      setReceiver(RX, tt);
 
       double corr=0.0;
       try {
@@ -186,6 +172,55 @@ namespace gnsstk
    }
 
 
+   void SaasTropModel::batchCorrection(const std::vector<double>& elevation,
+                                       std::vector<double>& delay) const
+   {
+      THROW_IF_INVALID_DETAILED();
+
+      double ad, bd, cd, aw, bw, cw;
+      dryCoefficients(ad, bd, cd);
+      wetCoefficients(aw, bw, cw);
+      double dryZenith(dry_zenith_delay());
+      double wetZenith(wet_zenith_delay());
+
+      std::size_t n = elevation.size();
+      delay.resize(n);
+      for(std::size_t i=0; i<n; i++)
+         delay[i] = ::sin(elevation[i]*DEG_TO_RAD);
+
+      // elevation cutoff in a separate pass: a branch here stops GCC
+      // vectorizing this loop (checked with -fopt-info-vec)
+      for(std::size_t i=0; i<n; i++) {
+         double se = delay[i];
+         double map_dry = continuedFraction(se, ad, bd, cd)
+                        + heightCorrection(se, height);
+         double map_wet = continuedFraction(se, aw, bw, cw);
+         delay[i] = dryZenith * map_dry + wetZenith * map_wet;
+      }
+      for(std::size_t i=0; i<n; i++)
+         if(elevation[i] < 0.0) delay[i] = 0.0;
+
+   }  // end SaasTropModel::batchCorrection(elevation)
+
+
+   void SaasTropModel::batchCorrection(const Position& RX,
+                                       const std::vector<Position>& SV,
+                                       const CommonTime& tt,
+                                       std::vector<double>& delay)
+   {
+      setReceiver(RX, tt);
+
+      Position R(RX);
+      R.transformTo(Position::Cartesian);
+      std::vector<double> elevation(SV.size());
+      for(std::size_t i=0; i<SV.size(); i++)
+         elevation[i] = R.elevation(SV[i]);
+
+      SaasTropModel::batchCorrection(elevation, delay);
+
+   }  // end SaasTropModel::batchCorrection(RX,SV,TT)
+
+
    double SaasTropModel::dry_zenith_delay() const
    {
       THROW_IF_INVALID_DETAILED();
@@ -226,6 +261,21 @@ namespace gnsstk
       THROW_IF_INVALID_DETAILED();
       if(elevation < 0.0) return 0.0;
 
+      double a,b,c;
+      dryCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = continuedFraction(se, a, b, c);
+
+      map += heightCorrection(se, height);
+
+      return map;
+
+   }  // end SaasTropModel::dry_mapping_function()
+
+
+   void SaasTropModel::dryCoefficients(double& a, double& b, double& c) const
+   {
       double lat,t,ct;
       lat = fabs(latitude);         // degrees
       t = doy - 28.;                // mid-winter
@@ -234,7 +284,6 @@ namespace gnsstk
       t *= 360.0/365.25;            // convert to degrees
       ct = ::cos(t*DEG_TO_RAD);
 
-      double a,b,c;
       if(lat < 15.) {
          a = SaasDryA[0];
          b = SaasDryB[0];
@@ -257,17 +306,7 @@ namespace gnsstk
          c = SaasDryC[4] - ct * SaasDryC1[4];
       }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += (height/1000.0)*(1./se-(1+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c))));
-
-      return map;
-
-   }  // end SaasTropModel::dry_mapping_function()
+   }  // end SaasTropModel::dryCoefficients()
 
 
    double SaasTropModel::wet_mapping_function(double elevation) const
@@ -275,7 +314,20 @@ namespace gnsstk
       THROW_IF_INVALID_DETAILED();
       if(elevation < 0.0) return 0.0;
 
-      double a,b,c,lat;
+      double a,b,c;
+      wetCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = continuedFraction(se, a, b, c);
+
+      return map;
+
+   }
+
+
+   void SaasTropModel::wetCoefficients(double& a, double& b, double& c) const
+   {
+      double lat;
       lat = fabs(latitude);         // degrees
       if(lat < 15.) {
          a = SaasWetA[0];
@@ -295,11 +347,26 @@ namespace gnsstk
          c = SaasWetC[4];
       }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+   }  // end SaasTropModel::wetCoefficients()
 
-      return map;
 
+   void SaasTropModel::setReceiver(const Position& RX, const CommonTime& tt)
+   {
+      SaasTropModel::setReceiverHeight(RX.getHeight());
+      SaasTropModel::setReceiverLatitude(RX.getGeodeticLatitude());
+      SaasTropModel::setDayOfYear(int((static_cast<YDSTime>(tt).doy)));
+
+      if(!valid) {
+         if(!validWeather) GNSSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: weather"));
+         if(!validRxLatitude) GNSSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: Rx Latitude"));
+         if(!validRxHeight) GNSSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: Rx Height"));
+         if(!validDOY) GNSSTK_THROW(
+            InvalidTropModel("Invalid Saastamoinen trop model: day of year"));
+         valid = true;
+      }
    }
 
 
@@ -132,6 +132,16 @@ namespace gnsstk
                                 const Xvt& SV,
                                 const CommonTime& tt);
 
+         /// @copydoc TropModel::batchCorrection(const std::vector<double>&,std::vector<double>&) const
+      virtual void batchCorrection(const std::vector<double>& elevation,
+                                   std::vector<double>& delay) const;
+
+         /// @copydoc TropModel::batchCorrection(const Position&,const std::vector<Position>&,const CommonTime&,std::vector<double>&)
+      virtual void batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   std::vector<double>& delay);
+
          /// @copydoc TropModel::dry_zenith_delay() const
       virtual double dry_zenith_delay() const;
 
@@ -162,6 +172,16 @@ namespace gnsstk
       void setDayOfYear(const int& d);
 
    private:
+         /** Set the receiver height, latitude and day of year.
+          * @throw InvalidTropModel if the model is then not valid. */
+      void setReceiver(const Position& RX, const CommonTime& tt);
+
+         /// Compute the hydrostatic mapping function coefficients.
+      void dryCoefficients(double& a, double& b, double& c) const;
+
+         /// Compute the wet mapping function coefficients.
+      void wetCoefficients(double& a, double& b, double& c) const;
+
       double height;             ///< height (m) of the receiver above the geoid
       double latitude;           ///< latitude (deg) of receiver
       int doy;                   ///< day of year
@@ -82,6 +82,59 @@ namespace gnsstk
    }  // end TropModel::correction(RX,SV,TT)
 
 
+   void TropModel::batchCorrection(const std::vector<double>& elevation,
+                                   std::vector<double>& delay) const
+   {
+      delay.resize(elevation.size());
+      for (std::size_t i = 0; i < elevation.size(); i++)
+      {
+         delay[i] = correction(elevation[i]);
+      }
+   }  // end TropModel::batchCorrection(elevation)
+
+
+   void TropModel::batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   std::vector<double>& delay)
+   {
+      delay.resize(SV.size());
+      for (std::size_t i = 0; i < SV.size(); i++)
+      {
+         delay[i] = correction(RX, SV[i], tt);
+      }
+   }  // end TropModel::batchCorrection(RX,SV,TT)
+
+
+   void TropModel::elevationGeodetic(const Position& RX,
+                                     const std::vector<Position>& SV,
+                                     std::vector<double>& elevation)
+   {
+         // same arithmetic as Position::elevationGeodetic()
+      Position R(RX);
+      double latGeodetic = R.getGeodeticLatitude()*DEG_TO_RAD;
+      double longGeodetic = R.getLongitude()*DEG_TO_RAD;
+      R.transformTo(Position::Cartesian);
+      Triple kVector(::cos(latGeodetic)*::cos(longGeodetic),
+                     ::cos(latGeodetic)*::sin(longGeodetic),
+                     ::sin(latGeodetic));
+      elevation.resize(SV.size());
+      for (std::size_t i = 0; i < SV.size(); i++)
+      {
+         Position S(SV[i]);
+         S.transformTo(Position::Cartesian);
+         Triple z(S[0]-R[0], S[1]-R[1], S[2]-R[2]);
+         if (z.mag() <= 1e-4)
+         {
+            GeometryException ge("Positions are within .1 millimeter");
+            GNSSTK_THROW(ge);
+         }
+         double cosUp = z.dot(kVector)/z.mag();
+         elevation[i] = 90.0 - ((::acos(cosUp))*RAD_TO_DEG);
+      }
+   }  // end TropModel::elevationGeodetic()
+
+
    void TropModel::setWeather(const double& T,
                               const double& P,
                               const double& H)
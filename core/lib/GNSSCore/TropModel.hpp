@@ -45,6 +45,7 @@
 #ifndef TROP_MODEL_HPP
 #define TROP_MODEL_HPP
 
+#include <vector>
 #include "Exception.hpp"
 #include "ObsEpochMap.hpp"
 #include "WxObsMap.hpp"
@@ -166,6 +167,41 @@ namespace gnsstk
                                 const CommonTime& tt)
       { Position R(RX),S(SV);  return TropModel::correction(R,S,tt); }
 
+         /** Compute the full tropospheric delay, in meters, for
+          * several satellites seen from the same receiver at the same
+          * time.  The result is the same as calling
+          * correction(elevation[i]) for each satellite; models that
+          * override this compute the zenith delays and mapping
+          * function coefficients once and then evaluate the mapping
+          * functions over the whole array.
+          * @param[in] elevation Elevations of the satellites as seen
+          *   at the receiver, in degrees
+          * @param[out] delay The tropospheric delay (meters) for each
+          *   elevation, resized to match elevation.
+          * @throw InvalidTropModel
+          */
+      virtual void batchCorrection(const std::vector<double>& elevation,
+                                   std::vector<double>& delay) const;
+
+         /** Compute the full tropospheric delay, in meters, for
+          * several satellites seen from the same receiver at the same
+          * time.  The result is the same as calling
+          * correction(RX,SV[i],tt) for each satellite; models that
+          * override this set up the receiver and time dependent terms
+          * once per call rather than once per satellite.  Call this
+          * once per epoch to process a series of epochs.
+          * @param[in] RX Receiver position
+          * @param[in] SV Satellite positions
+          * @param[in] tt Time tag of the signals
+          * @param[out] delay The tropospheric delay (meters) for each
+          *   satellite, resized to match SV.
+          * @throw InvalidTropModel
+          */
+      virtual void batchCorrection(const Position& RX,
+                                   const std::vector<Position>& SV,
+                                   const CommonTime& tt,
+                                   std::vector<double>& delay);
+
          /** Compute and return the zenith delay for hydrostatic (dry)
           * component of the troposphere, in meters.
           * @throw InvalidTropModel
@@ -275,6 +311,46 @@ namespace gnsstk
       static void weatherByStandardAtmosphereModel(
          const double& ht, double& T, double& P, double& H);
 
+   protected:
+         /** Continued fraction form of the mapping function used by
+          * the Niell, Global and Saastamoinen models (Marini 1972,
+          * normalized by Herring 1992):
+          * (1+a/(1+b/(1+c))) / (sin(E)+a/(sin(E)+b/(sin(E)+c))).
+          * Inline so that loops over many elevations can vectorize.
+          * @param sine sine of the elevation
+          * @param a,b,c mapping function coefficients
+          */
+      static double continuedFraction(double sine, double a, double b,
+                                      double c)
+      {
+         return (1.0 + a/(1.0 + b/(1.0 + c))) /
+            (sine + a/(sine + b/(sine + c)));
+      }
+
+         /** Niell height correction to the hydrostatic mapping
+          * function for a receiver ht meters above sea level.
+          * @param sine sine of the elevation
+          * @param ht receiver height in meters
+          */
+      static double heightCorrection(double sine, double ht)
+      {
+         return (1.0/sine - continuedFraction(sine, 2.53e-5, 5.49e-3, 1.14e-3))
+            * (ht/1000.0);
+      }
+
+         /** Compute the geodetic elevation (as
+          * Position::elevationGeodetic()) of each satellite, with the
+          * receiver's geodetic coordinates and local vertical
+          * computed once.
+          * @param[in] RX Receiver position
+          * @param[in] SV Satellite positions
+          * @param[out] elevation Elevation of each satellite in degrees.
+          * @throw GeometryException
+          */
+      static void elevationGeodetic(const Position& RX,
+                                    const std::vector<Position>& SV,
+                                    std::vector<double>& elevation);
+
    protected:
       bool valid;           ///< true only if current model parameters are valid
       double temp;          ///< latest value of temperature (kelvin or celsius)
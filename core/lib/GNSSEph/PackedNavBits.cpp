@@ -40,6 +40,7 @@
  * @file PackedNavBits.cpp
  * Engineering units navigation message abstraction.
  */
+#include <algorithm>
 #include <math.h>
 #include <iostream>
 #include <iomanip>
@@ -57,17 +58,18 @@ namespace gnsstk
    PackedNavBits::PackedNavBits()
                  : transmitTime(CommonTime::BEGINNING_OF_TIME),
                    parityStatus(psUnknown),
-                   bits(900),
+                   bits_size(0),
                    bits_used(0),
                    rxID(""),
                    xMitCoerced(false)
    {
+      resizeBits(900);
       transmitTime.setTimeSystem(TimeSystem::GPS);
    }
    PackedNavBits::PackedNavBits(const SatID& satSysArg,
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits_size(0),
                                   parityStatus(psUnknown),
                                   bits_used(0),
                                   rxID(""),
@@ -77,13 +79,14 @@ namespace gnsstk
       obsID = obsIDArg;
       transmitTime = transmitTimeArg;
       xMitCoerced = false;
+      resizeBits(900);
    }
 
    PackedNavBits::PackedNavBits(const SatID& satSysArg,
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits_size(0),
                                   parityStatus(psUnknown),
                                   bits_used(0),
                                   rxID(""),
@@ -94,6 +97,7 @@ namespace gnsstk
       rxID = rxString;
       transmitTime = transmitTimeArg;
       xMitCoerced = false;
+      resizeBits(900);
    }
 
    PackedNavBits::PackedNavBits(const SatID& satSysArg,
@@ -101,7 +105,7 @@ namespace gnsstk
                                 const NavID& navIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits_size(0),
                                   parityStatus(psUnknown),
                                   bits_used(0),
                                   rxID(""),
@@ -113,6 +117,7 @@ namespace gnsstk
       rxID = rxString;
       transmitTime = transmitTimeArg;
       xMitCoerced = false;
+      resizeBits(900);
    }
 
 
@@ -129,10 +134,13 @@ namespace gnsstk
            navID(navIDArg),
            rxID(rxString),
            transmitTime(transmitTimeArg),
-           bits(numBits, fillValue),
+           bits_size(0),
            bits_used(numBits),
            xMitCoerced(false)
    {
+      resizeBits(numBits);
+      if (fillValue)
+         invert();
    }
 
 
@@ -145,12 +153,10 @@ namespace gnsstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
-      bits.resize(bits_used);
+      bits_size = 0;
+      resizeBits(bits_used);
       parityStatus = right.parityStatus;
-      for (int i=0;i<bits_used;i++)
-      {
-         bits[i] = right.bits[i];
-      }
+      copyRange(right, 0, 0, std::min(bits_size, right.bits_size));
       xMitCoerced = right.xMitCoerced;
    }
 
@@ -208,7 +214,7 @@ namespace gnsstk
 
    void PackedNavBits::clearBits()
    {
-      bits.clear();
+      resizeBits(0);
       bits_used = 0;
    }
 
@@ -246,20 +252,18 @@ namespace gnsstk
    uint64_t PackedNavBits::asUint64_t(const int startBit,
                                       const int numBits ) const
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
       size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if (startBit<0 || stop>bits_size)
       {
          InvalidParameter exc("Requested bits not present.");
          GNSSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
-      {
-         temp <<= 1;
-         if (bits[i]) temp++;
-      }
-      return( temp );
+      if (numBits<=0)
+         return 0;
+         // Only the last 64 bits of a longer field fit in the result.
+      if (numBits>64)
+         return getField(stop-64, 64);
+      return getField(startBit, numBits);
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit,
@@ -286,7 +290,7 @@ namespace gnsstk
 
          // Convert to double and scale
       double dval = (double) uint;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -297,7 +301,7 @@ namespace gnsstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -474,7 +478,7 @@ namespace gnsstk
 
          // Convert to double and scale
       double dval = (double) ulong;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -492,7 +496,7 @@ namespace gnsstk
       ulong |= temp2;
          // Convert to double and scale
       double dval = (double) ulong;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -517,7 +521,7 @@ namespace gnsstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -577,7 +581,7 @@ namespace gnsstk
 
          // Convert to double and scale
       double dval = (double) s;
-      dval *= pow(static_cast<double>(2), power2);
+      dval = ldexp(dval, power2);
       return( dval );
    }
 
@@ -605,7 +609,7 @@ namespace gnsstk
 
    bool PackedNavBits::asBool( const unsigned bitNum) const
    {
-      return bits[bitNum];
+      return getBit(bitNum);
    }
 
 
@@ -772,32 +776,84 @@ namespace gnsstk
    {
       int old_bits_used = bits_used;
       bits_used += right.bits_used;
-      bits.resize(bits_used);
+      resizeBits(bits_used);
+      copyRange(right, 0, old_bits_used, right.bits_used);
+   }
 
-      for (int i=0;i<right.bits_used;i++)
+   void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
+   {
+      if (numBits<=0)
+         return;
+      if (size_t(bits_used+numBits) > bits_size)
+         resizeBits(bits_used+numBits);
+      putBits(bits_used, numBits, value);
+      bits_used += numBits;
+   }
+
+
+   void PackedNavBits::resizeBits(size_t n)
+   {
+      size_t w = n >> 6;
+      unsigned off = n & 63;
+      words.resize(w + (off ? 2 : 1), 0);
+      if (n < bits_size)
       {
-         bits[i+old_bits_used] = right.bits[i];
+            // Clear the discarded bits so that growing again yields
+            // zeros, and keep the guard word zero.
+         if (off)
+            words[w] &= ~(UINT64_C(0xFFFFFFFFFFFFFFFF) >> off);
+         words.back() = 0;
       }
+      bits_size = n;
    }
 
-   void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
+
+   void PackedNavBits::putBits(size_t startBit, int numBits, uint64_t value)
    {
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
+         // Left-pad fields wider than 64 bits with zeros.
+      for (; numBits>64; numBits -= 64, startBit += 64)
+      {
+         putBits(startBit, 64, 0);
+      }
+      if (numBits<=0)
+         return;
+      size_t w = startBit >> 6;
+      unsigned off = startBit & 63;
+         // Left-justify the field and its mask, then split them
+         // across at most two words.
+      uint64_t mask = UINT64_C(0xFFFFFFFFFFFFFFFF) << (64 - numBits);
+      uint64_t field = (value << (64 - numBits)) & mask;
+      words[w] = (words[w] & ~(mask >> off)) | (field >> off);
+      if (off + numBits > 64)
+      {
+         unsigned shift = 64 - off;
+         words[w+1] = (words[w+1] & ~(mask << shift)) | (field << shift);
+      }
+   }
 
-      for (int i=0; i<numBits; ++i)
+
+   void PackedNavBits::copyRange(const PackedNavBits& src, size_t srcStart,
+                                 size_t dstStart, size_t numBits)
+   {
+      while (numBits>0)
       {
-         bits[ndx] = false;
-         if (value & mask)
-         {
-             //set the bits to true
-            bits[ndx] = true;
-         }
-         mask>>= 1;
-         ndx++;
+         unsigned n = numBits<64 ? numBits : 64;
+         putBits(dstStart, n, src.getField(srcStart, n));
+         srcStart += n;
+         dstStart += n;
+         numBits -= n;
       }
-      bits_used += numBits;
+   }
+
+
+   std::vector<bool> PackedNavBits::getBits() const
+   {
+      std::vector<bool> rv(bits_size);
+      for (size_t i = 0; i < bits_size; i++)
+      {
+         rv[i] = getBit(i);
+      }
+      return rv;
    }
 
    //--------------------------------------------------------------------------
@@ -807,9 +863,8 @@ namespace gnsstk
    // in which left has a FALSE whereas right has a TRUE starting at the
    // lowest index and scanning to the maximum index.
    //
-   // NOTE: This is one of the cases in which the PackedNavBits implementation
-   // is probably not the fastest.  Since we are scanning a bit array rather
-   // than testing a series of unsigned ints.
+   // Because the bits are stored most significant first and unused bits
+   // are zero, the first differing word decides the comparison.
    bool PackedNavBits::operator<(const PackedNavBits& right) const
    {
          // If the two objects don't have the same number of bits,
@@ -817,22 +872,17 @@ namespace gnsstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<words.size();i++)
       {
-         if (bits[i]==false && right.bits[i]==true)
-         //if (bits[i]<right.bits[i])
+         if (words[i]!=right.words[i])
          {
-            return true;
-         }
-         if (bits[i]==true && right.bits[i]==false)
-         {
-            return false;
+            return words[i]<right.words[i];
          }
       }
       return false;
@@ -840,20 +890,15 @@ namespace gnsstk
 
    void PackedNavBits::invert( )
    {
-         // Each bit is either 1 or 0.
-         // Starting with 1 and subtracting the
-         // current value will yield the inverse
-         //
-         //  Input    Equation     Result
-         //    1       1 - 1          0
-         //    0       1 - 0          1
-         //
-         // This accomplishes the purpose without incurring
-         // the cost of a conditional statement.
-      for (int i=0;i<bits.size();i++)
+         // Invert every word except the guard word, then clear the
+         // bits past bits_size in the last word.
+      for (size_t i=0;i+1<words.size();i++)
       {
-         bits[i] = 1 - bits[i];
+         words[i] = ~words[i];
       }
+      unsigned off = bits_size & 63;
+      if (off)
+         words[words.size()-2] &= ~(UINT64_C(0xFFFFFFFFFFFFFFFF) >> off);
    }
 
       /**
@@ -876,11 +921,16 @@ namespace gnsstk
 
       short finalBit = endBit;
       if (finalBit==-1) finalBit = bits_used - 1;
-
-      for (short i=startBit; i<=finalBit; i++)
+      if (finalBit<startBit)
+         return;
+      if (startBit<0 || size_t(finalBit)>=bits_size ||
+          size_t(finalBit)>=src.bits_size)
       {
-         bits[i] = src.bits[i];
+         InvalidParameter ip("PackedNavBits::copyBits( ) range exceeds"
+                             " the packed bits.");
+         GNSSTK_THROW(ip);
       }
+      copyRange(src, startBit, startBit, finalBit-startBit+1);
    }
 
 
@@ -909,20 +959,7 @@ namespace gnsstk
          GNSSTK_THROW(exc);
       }
 
-      size_t ndx = startBit;
-      uint64_t mask = 0x0000000000000001L;
-
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; i++)
-      {
-         bits[ndx] = false;
-         if (out & mask)
-         {
-            bits[ndx] = true;
-         }
-         mask >>= 1;
-         ndx++;
-      }
+      putBits(startBit, numBits, out);
    }
 
 
@@ -937,7 +974,7 @@ namespace gnsstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
@@ -1000,10 +1037,10 @@ namespace gnsstk
       int numBitInWord = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits[i]) word++;
+         if (getBit(i)) word++;
 
          numBitInWord++;
          if (numBitInWord >= 32)
@@ -1039,10 +1076,10 @@ namespace gnsstk
       int bit_count    = 0;
       int word_count   = 0;
       uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      for(size_t i = 0; i < bits_size; ++i)
       {
          word <<= 1;
-         if (bits[i]) word++;
+         if (getBit(i)) word++;
 
          numBitInWord++;
          if (numBitInWord >= numBitsPerWord)
@@ -1056,7 +1093,7 @@ namespace gnsstk
             //but ONLY if there are more bits left to put on the next line.
             if (word_count>0 &&
                 word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;
+                (i+1) < bits_size) s << endl;
          }
       }
          // Need to check if there is a partial word in the buffer
@@ -1066,7 +1103,7 @@ namespace gnsstk
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word << dec << setfill(' ');
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size());
+      return(bits_size);
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -1119,19 +1156,23 @@ namespace gnsstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them.
-      if (bits.size()!=right.bits.size()) return false;
+      if (bits_size!=right.bits_size) return false;
+      if (bits_size==0) return true;
 
       short startBit = startBitA;
       short endBit = endBitA;
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
 
-      for (int i=startBit;i<=endBit;i++)
+         // Compare up to 64 bits at a time.
+      for (int i=startBit;i<=endBit;i+=64)
       {
-         if (bits[i]!=right.bits[i])
+         unsigned n = endBit-i+1;
+         if (n>64) n = 64;
+         if (getField(i,n)!=right.getField(i,n))
          {
             return false;
          }
@@ -436,18 +436,22 @@ namespace gnsstk
           */
       void addDataVec(const std::vector<uint8_t>& data, unsigned numBits);
 
-         /** Pack a bitset.  This is done by converting it first to a
-          * string of 0 and 1 characters which are then treated as an
-          * array that is appended to the end of the bits vector.  Not
-          * entirely sure if this is faster than iterating.
+         /** Pack a bitset.  The bits are appended, most significant
+          * first, to the end of the bits storage (i.e. after any
+          * allocated but unused bits).
           * @param[in] newbits The bitset containing the data to
           *   append to the PackedNavBits data. */
       template <size_t N>
       void addBitset(const std::bitset<N>& newbits)
       {
-         std::string binbits(newbits.to_string((char)0,(char)1));
-         bits.insert(bits.end(), &binbits[0], &binbits[binbits.length()]);
-         bits_used += binbits.length();
+         size_t ndx = bits_size;
+         resizeBits(bits_size + N);
+         for (size_t i = 0; i < N; i++, ndx++)
+         {
+            if (newbits[N-1-i])
+               words[ndx >> 6] |= UINT64_C(0x8000000000000000) >> (ndx & 63);
+         }
+         bits_used += N;
       }
 
          /**
@@ -619,8 +623,10 @@ namespace gnsstk
       void setXmitCoerced(bool tf=true) {xMitCoerced=tf;}
       bool isXmitCoerced() const {return xMitCoerced;}
 
-      const std::vector<bool>& getBits() const
-      { return bits; }
+         /** Return a copy of the stored bits, one element per bit.
+          * The bits are stored internally in 64-bit words, so this
+          * is not a cheap call and is intended for diagnostics. */
+      std::vector<bool> getBits() const;
 
          /** Indicate the status of parity/CRC checking.  Must be
           * explicitly set after construction, no parity checking is
@@ -633,7 +639,14 @@ namespace gnsstk
       NavID navID;             /**< Defines the navigation message tracked */
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+         /** Holds the packed data, 64 bits per word.  Bit i is
+          * stored in words[i/64], counting from the most significant
+          * bit.  There is always one more word than needed to hold
+          * bits_size bits, and that word and any bits beyond
+          * bits_size are kept zero so that a field can be read from
+          * two adjacent words without a range check. */
+      std::vector<uint64_t> words;
+      size_t bits_size;        /**< Number of bits allocated in words */
       int bits_used;
 
       bool xMitCoerced;        /**< Used to indicate that the transmit
@@ -648,6 +661,37 @@ namespace gnsstk
          /** Pack the bits */
       void addUint64_t( const uint64_t value, const int numBits );
 
+         /** Change the number of allocated bits to n.  New bits
+          * are zero. */
+      void resizeBits(size_t n);
+
+         /// Return the value of the bit at index i.
+      bool getBit(size_t i) const
+      { return (words[i >> 6] >> (63 - (i & 63))) & 1; }
+
+         /** Return numBits (1-64) bits starting at startBit as the
+          * least significant bits of the result.  No range check is
+          * done; startBit+numBits must be <= bits_size. */
+      uint64_t getField(size_t startBit, unsigned numBits) const
+      {
+         size_t w = startBit >> 6;
+         unsigned off = startBit & 63;
+            // The two-step shift of the second word avoids an
+            // undefined shift by 64 when off is zero.
+         uint64_t v = (words[w] << off) | ((words[w+1] >> 1) >> (63 - off));
+         return v >> (64 - numBits);
+      }
+
+         /** Store the numBits least significant bits of value
+          * starting at startBit.  Values of numBits larger than 64
+          * are zero-padded on the left.  No range check is done. */
+      void putBits(size_t startBit, int numBits, uint64_t value);
+
+         /** Copy numBits bits from src starting at srcStart to this
+          * object starting at dstStart, up to 64 bits at a time. */
+      void copyRange(const PackedNavBits& src, size_t srcStart,
+                     size_t dstStart, size_t numBits);
+
          /** Extend the sign bit for signed values */
       int64_t SignExtend( const int startBit, const int numBits ) const;
 
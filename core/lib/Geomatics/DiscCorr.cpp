@@ -46,11 +46,14 @@
 //------------------------------------------------------------------------------------
 // system
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <exception>
 #include <iostream>
 #include <list>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 // gnsstk
 #include "GNSSconstants.hpp" // PI,C_MPS,OSC_FREQ_GPS,L1_MULT_GPS,L2_MULT_GPS
@@ -629,7 +632,7 @@ static const int P1 = 2;
 static const int P2 = 3;
 static const int A1 = 4;
 static const int A2 = 5;
-vector<string>
+static thread_local vector<string>
    DCobstypes; // indexes into both data and this vector are L1,L2,etc...
 
 //------------------------------------------------------------------------------------
@@ -646,16 +649,22 @@ static const int ReturnOK     = 0;
 /* these are used only to associate a unique number in the log file with each
    pass */
 static int GDCUnique = 0;     // unique number for each call
-static int GDCUniqueFix;      // unique for each (WL,GF) fix
 static string GDCtag = "GDC"; // begin each line of return message
 
+/* the state of the pass being processed; these are per thread, so that passes
+   may be processed concurrently (see the vector<SatPass> version of DC()) */
+static thread_local int GDCPassUnique; // unique number of this pass
+static thread_local int GDCUniqueFix;  // unique for each (WL,GF) fix
+
 //------------------------------------------------------------------------------------
 /* wavelength and other frequency-dependent quantities, determined early in DC()
    constants used in linear combinations */
-int GLOn;
-double wl1, wl2, wlwl, wlgf;   // wavelengths: L1,L2,widelane,narrowlane
-double wl1r, wl2r, wl1p, wl2p; // coefficients in widelane linear combinations
-double gf1r, gf2r, gf1p,
+static thread_local int GLOn;
+static thread_local double wl1, wl2, wlwl,
+   wlgf; // wavelengths: L1,L2,widelane,narrowlane
+static thread_local double wl1r, wl2r, wl1p,
+   wl2p; // coefficients in widelane linear combinations
+static thread_local double gf1r, gf2r, gf1p,
    gf2p; // coefficients in geometry-free linear combinations
 
 /*------------------------------------------------------------------------------------
@@ -694,22 +703,147 @@ const unsigned short GDCPass::FIX      = 24; // = WLFIX | GFFIX
 //------------------------------------------------------------------------------------
 // The discontinuity corrector function
 //------------------------------------------------------------------------------------
+// process one pass, numbered GDCPassUnique; cf. DiscontinuityCorrector()
+static int DiscontinuityCorrectorPass(SatPass& svp, GDCconfiguration& gdc,
+                                      std::vector<std::string>& editCmds,
+                                      std::string& retMessage, int GLOn_in);
+
 // yes you need the gnsstk::
 int gnsstk::DiscontinuityCorrector(SatPass& svp, GDCconfiguration& gdc,
                                   std::vector<std::string>& editCmds,
                                   std::string& retMessage, int GLOn_in)
+{
+   if (gdc.getParameter("ResetUnique") != 0)
+   {
+      GDCUnique = 0;
+      gdc.setParameter("ResetUnique=0");
+   }
+   GDCPassUnique = ++GDCUnique;
+
+   return DiscontinuityCorrectorPass(svp, gdc, editCmds, retMessage, GLOn_in);
+}
+
+//------------------------------------------------------------------------------------
+// the vector<SatPass> version; each pass is processed by one thread, with its
+// own copy of the configuration and its own debug stream, and the passes are
+// numbered as if they were processed one after the other.
+int gnsstk::DiscontinuityCorrector(std::vector<SatPass>& SPs,
+                                  GDCconfiguration& gdc,
+                                  std::vector<std::vector<std::string>>& EditCmds,
+                                  std::vector<std::string>& retMsgs,
+                                  std::vector<int>& irets, unsigned nThreads,
+                                  const std::vector<int>& GLOn_in)
 {
    try
    {
-      unsigned int i, j;
-      int iret;
+      const size_t npass(SPs.size());
+      if (!GLOn_in.empty() && GLOn_in.size() != npass)
+      {
+         Exception e("GLOn is not parallel to SatPass vector");
+         GNSSTK_THROW(e);
+      }
+
+      EditCmds = vector<vector<string>>(npass);
+      retMsgs  = vector<string>(npass);
+      irets    = vector<int>(npass, 0);
+      if (npass == 0)
+      {
+         return 0;
+      }
+
+      if (nThreads == 0)
+      {
+         nThreads = std::thread::hardware_concurrency();
+      }
+      if (nThreads > npass)
+      {
+         nThreads = npass;
+      }
 
       if (gdc.getParameter("ResetUnique") != 0)
       {
          GDCUnique = 0;
          gdc.setParameter("ResetUnique=0");
       }
-      GDCUnique++;
+      const int unique0(GDCUnique);
+      GDCUnique += npass;
+
+         // debug output of each pass, written in order at the end
+      ostream& plog(gdc.getDebugStream());
+      vector<string> logs(npass);
+      vector<std::exception_ptr> errors(npass);
+
+      std::atomic<size_t> nextPass(0);
+      auto worker = [&]()
+      {
+         for (size_t i = nextPass++; i < npass; i = nextPass++)
+         {
+            ostringstream oss;
+            GDCconfiguration config(gdc);
+            config.setDebugStream(oss);
+            GDCPassUnique = unique0 + i + 1;
+            try
+            {
+               irets[i] = DiscontinuityCorrectorPass(
+                  SPs[i], config, EditCmds[i], retMsgs[i],
+                  (GLOn_in.empty() ? -99 : GLOn_in[i]));
+            }
+            catch (...)
+            {
+               errors[i] = std::current_exception();
+            }
+            logs[i] = oss.str();
+         }
+      };
+
+      if (nThreads <= 1)
+      {
+         worker();
+      }
+      else
+      {
+         vector<std::thread> threads;
+         for (unsigned t = 0; t < nThreads; t++)
+         {
+            threads.emplace_back(worker);
+         }
+         for (auto& thr : threads)
+         {
+            thr.join();
+         }
+      }
+
+      int nok(0);
+      for (size_t i = 0; i < npass; i++)
+      {
+         plog << logs[i];
+         if (errors[i])
+         {
+            std::rethrow_exception(errors[i]);
+         }
+         if (irets[i] == ReturnOK)
+         {
+            nok++;
+         }
+      }
+
+      return nok;
+   }
+   catch (Exception& e)
+   {
+      GNSSTK_RETHROW(e);
+   }
+}
+
+//------------------------------------------------------------------------------------
+static int DiscontinuityCorrectorPass(SatPass& svp, GDCconfiguration& gdc,
+                                      std::vector<std::string>& editCmds,
+                                      std::string& retMessage, int GLOn_in)
+{
+   try
+   {
+      unsigned int i, j;
+      int iret;
 
          // if(!retMessage.empty()) { GDCtag = retMessage; }
       retMessage = "";
@@ -764,17 +898,23 @@ int gnsstk::DiscontinuityCorrector(SatPass& svp, GDCconfiguration& gdc,
          // fill the new SatPass with the input data
       nsvp.status() = svp.status();
       vector<unsigned short> lli(6), ssi(6);
+         // input obs type handles, all found by the test above
+      unsigned int k[4];
+      for (j = 0; j < 4; j++)
+      {
+         k[j] = svp.obsIndex(DCobstypes[j]);
+      }
+      newdata[A1] = newdata[A2] = 0.0;
       for (i = 0; i < static_cast<int>(svp.size()); i++)
       {
-         for (j = 0; j < 6; j++)
+         for (j = 0; j < 4; j++)
          {
-            newdata[j] = j < 4 ? svp.data(i, DCobstypes[j]) : 0.0;
-            lli[j]     = j < 4 ? svp.LLI(i, DCobstypes[j]) : 0;
-            ssi[j]     = j < 4 ? svp.SSI(i, DCobstypes[j]) : 0;
+            newdata[j] = svp.data(i, k[j]);
+            lli[j]     = svp.LLI(i, k[j]);
+            ssi[j]     = svp.SSI(i, k[j]);
          }
             // return value must be 0
-         nsvp.addData(svp.time(i), DCobstypes, newdata, lli, ssi,
-                      svp.getFlag(i));
+         nsvp.addData(svp.time(i), newdata, lli, ssi, svp.getFlag(i));
       }
 
          // --------------------------------------------------------------------------
@@ -804,7 +944,7 @@ int gnsstk::DiscontinuityCorrector(SatPass& svp, GDCconfiguration& gdc,
             else
             {
                ostringstream oss;
-               oss << GDCtag << " " << setw(3) << GDCUnique << " " << sat << " "
+               oss << GDCtag << " " << setw(3) << GDCPassUnique << " " << sat << " "
                    << printTime(svp.getFirstTime(), svp.outFormat)
                    << " is returning with error code: failed to find GLONASS "
                       "frequency\n"
@@ -959,20 +1099,19 @@ GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
       indexForLabel[labelForIndex[i]] = i;
    }
 
-   vector<double> vdata;
-   vector<unsigned short> lli, ssi;
+      // obs types are in the same order here as in sp, so copy by handle
+   vector<double> vdata(ot.size());
+   vector<unsigned short> lli(ot.size()), ssi(ot.size());
+   spdvector.reserve(sp.size());
    for (i = 0; i < static_cast<int>(sp.size()); i++)
    {
-      vdata.clear();
-      lli.clear();
-      ssi.clear();
       for (j = 0; j < static_cast<int>(ot.size()); j++)
       {
-         vdata.push_back(sp.data(i, ot[j]));
-         lli.push_back(sp.LLI(i, ot[j]));
-         ssi.push_back(sp.SSI(i, ot[j]));
+         vdata[j] = sp.data(i, j);
+         lli[j]   = sp.LLI(i, j);
+         ssi[j]   = sp.SSI(i, j);
       }
-      addData(sp.time(i), ot, vdata, lli, ssi, sp.getFlag(i));
+      addData(sp.time(i), vdata, lli, ssi, sp.getFlag(i));
    }
 
    *((GDCconfiguration *)this) = gdc;
@@ -994,7 +1133,7 @@ int GDCPass::preprocess()
       {
          Epoch CurrentTime;
             // CurrentTime.setLocalTime();
-         log << "\n======== Beg GNSSTK Discontinuity Corrector " << GDCUnique
+         log << "\n======== Beg GNSSTK Discontinuity Corrector " << GDCPassUnique
              << " ================================================\n";
          log << "GNSSTK Discontinuity Corrector Ver. " << GDCVersion << " Run "
              << CurrentTime << endl;
@@ -1044,7 +1183,7 @@ int GDCPass::preprocess()
                  spdvector[i].flag = BAD;
                  learn["points deleted: obvious outlier"]++;
                  if(cfg(Debug) > 6)
-                    log << "Obvious outlier " << GDCUnique << " " << sat
+                    log << "Obvious outlier " << GDCPassUnique << " " << sat
                        << " at " << i << " " << printTime(time(i),outFormat) <<
                        endl;
                  continue;
@@ -1097,7 +1236,7 @@ int GDCPass::preprocess()
             {
                if (cfg(Debug) >= 2)
                {
-                  log << "BEFresetL1 " << GDCUnique << " " << sat << " "
+                  log << "BEFresetL1 " << GDCPassUnique << " " << sat << " "
                       << printTime(time(i), outFormat) << " " << fixed
                       << setprecision(3) << biasL1 << " "
                       << spdvector[i].data[P1] - wl1 * spdvector[i].data[L1]
@@ -1112,7 +1251,7 @@ int GDCPass::preprocess()
             {
                if (cfg(Debug) >= 2)
                {
-                  log << "BEFresetL2 " << GDCUnique << " " << sat << " "
+                  log << "BEFresetL2 " << GDCPassUnique << " " << sat << " "
                       << printTime(time(i), outFormat) << " " << fixed
                       << setprecision(3) << biasL2 << " "
                       << spdvector[i].data[P2] - wl2 * spdvector[i].data[L2]
@@ -1272,7 +1411,7 @@ int GDCPass::detectWLslips()
          if (cfg(Debug) >= 1 &&
              it->npts >= static_cast<unsigned int>(cfg(MinPts)))
          {
-            log << "WLSIG " << GDCUnique << " " << sat << " " << it->nseg << " "
+            log << "WLSIG " << GDCPassUnique << " " << sat << " " << it->nseg << " "
                 << printTime(time(it->nbeg), outFormat) << fixed
                 << setprecision(3) << " " << it->WLStats.StdDev() << " "
                 << it->WLStats.Average() << " " << it->WLStats.Minimum() << " "
@@ -1450,7 +1589,7 @@ int GDCPass::detectObviousSlips(string which)
                {
                   log << "Warning - found an obvious slip, "
                       << "but marking BAD a point already marked with slip "
-                      << GDCUnique << " " << sat << " "
+                      << GDCPassUnique << " " << sat << " "
                       << printTime(time(j), outFormat) << " " << j << endl;
                }
                spdvector[j].flag = BAD; // mark all points between as bad
@@ -1719,7 +1858,7 @@ void GDCPass::WLsigmaStrip(list<Segment>::iterator& it)
 
             if (cfg(Debug) >= 6)
             {
-               log << "DSCWLR " << GDCUnique << " " << sat << " " << it->nseg
+               log << "DSCWLR " << GDCPassUnique << " " << sat << " " << it->nseg
                    << " " << printTime(time(i), outFormat) << fixed
                    << setprecision(3) << " " << setw(3) << spdvector[i].flag
                    << " " << setw(13) << spdvector[j].data[A1] // wlbias
@@ -1881,7 +2020,7 @@ int GDCPass::WLstatSweep(list<Segment>::iterator& it, int width)
             // dump the stats
          if (cfg(Debug) >= 6)
          {
-            log << "WLS " << GDCUnique << " " << sat << " " << it->nseg << " "
+            log << "WLS " << GDCPassUnique << " " << sat << " " << it->nseg << " "
                 << printTime(time(i), outFormat) << fixed << setprecision(3)
                 << " " << setw(3) << pastStats.N() << " " << setw(7)
                 << pastStats.Average() << " " << setw(7) << pastStats.StdDev()
@@ -2004,7 +2143,7 @@ int GDCPass::detectWLsmallSlips()
                   // TD must do something here ...
                if (cfg(Debug) >= 6)
                {
-                  log << "too near end " << GDCUnique << " " << i << " " << nok
+                  log << "too near end " << GDCPassUnique << " " << i << " " << nok
                       << " " << it->npts - nok << " "
                       << printTime(time(i), outFormat) << " "
                       << spdvector[i].data[A1] << " " << spdvector[i].data[A2]
@@ -2093,7 +2232,7 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
          // Debug print - NB '>' is always pass, '<=' is fail....
       if (cfg(Debug) >= 6)
       {
-         oss << "WLslip " << GDCUnique << " " << sat << " " << setw(2)
+         oss << "WLslip " << GDCPassUnique << " " << sat << " " << setw(2)
              << it->nseg << " " << setw(3) << i << " "
              << printTime(time(i), outFormat)
              //<< " " << it->npts << "pt"
@@ -2245,7 +2384,7 @@ bool GDCPass::foundWLsmallSlip(list<Segment>::iterator& it, int i)
       }
       if (Pass >= 4 && halfCycle && j != 0)
       {
-         log << "WLslip " << GDCUnique << " " << sat << " " << setw(2)
+         log << "WLslip " << GDCPassUnique << " " << sat << " " << setw(2)
              << it->nseg << " " << setw(3) << i << " "
              << printTime(time(i), outFormat)
              << " Warning - possible half-cycle slip of " << j
@@ -2498,7 +2637,7 @@ void GDCPass::WLslipFix(list<Segment>::iterator& left,
 
       if (cfg(Debug) >= 6)
       {
-         log << "Fix " << GDCUnique << " " << sat << " " << GDCUniqueFix
+         log << "Fix " << GDCPassUnique << " " << sat << " " << GDCUniqueFix
              << " WL " << printTime(time(right->nbeg), outFormat) << " "
              << nwl // put integer fix after time, all 'Fix'
              << " " << left->nseg << "-" << right->nseg << fixed
@@ -2640,7 +2779,7 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
       {
          if (cfg(Debug) >= 6)
          {
-            log << "GFRadjust " << GDCUnique << " " << sat << " "
+            log << "GFRadjust " << GDCPassUnique << " " << sat << " "
                 << GDCUniqueFix << " GF "
                 << printTime(time(right->nbeg), outFormat) << fixed
                 << setprecision(2) << " dbias(GFR): " << dnGFR
@@ -2658,7 +2797,7 @@ void GDCPass::GFslipFix(list<Segment>::iterator& left,
          // output result
       if (cfg(Debug) >= 6)
       {
-         log << "Fix " << GDCUnique << " " << sat << " " << GDCUniqueFix
+         log << "Fix " << GDCPassUnique << " " << sat << " " << GDCUniqueFix
              << " GF " << printTime(time(right->nbeg), outFormat) << " "
              << nadj // put integer fix after time, all 'Fix'
              << fixed << setprecision(2)
@@ -2879,7 +3018,7 @@ long GDCPass::EstimateGFslipFix(list<Segment>::iterator& left,
             {
                continue;
             }
-            log << "GFE " << GDCUnique << " " << sat << " " << GDCUniqueFix
+            log << "GFE " << GDCPassUnique << " " << sat << " " << GDCUniqueFix
                 << " " << printTime(time(i), outFormat) << " " << setw(2)
                 << spdvector[i].flag << fixed << setprecision(3);
             for (k = 0; k < 3; k++)
@@ -3259,7 +3398,7 @@ int GDCPass::detectGFsmallSlips()
                {
                      /* log << "Warning - marking a slip point BAD in GF detect
                         small "
-                          << GDCUnique << " " << sat
+                          << GDCPassUnique << " " << sat
                           << " " << printTime(time(i),outFormat) << " " << i <<
                           endl; */
                   spdvector[inew].flag = spdvector[i].flag;
@@ -3345,7 +3484,7 @@ bool GDCPass::foundGFoutlier(int i, int inew, Stats<double>& pastSt,
       ostringstream oss;
       if (cfg(Debug) >= 6)
       {
-         oss << "GFoutlier " << GDCUnique << " " << sat << " " << setw(3)
+         oss << "GFoutlier " << GDCPassUnique << " " << sat << " " << setw(3)
              << inew << " " << printTime(time(inew), outFormat) << fixed
              << setprecision(3) << " p,fave=" << fabs(pmag) << "," << fabs(fmag)
              << " var=" << var << " snr=" << fabs(pmag) / var << ","
@@ -3457,7 +3596,7 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
 
       if (cfg(Debug) >= 6)
       {
-         log << "GFS " << GDCUnique << " " << sat << " " << nseg << " "
+         log << "GFS " << GDCPassUnique << " " << sat << " " << nseg << " "
              << printTime(time(i), outFormat)
              //<< " P( " << setw(3) << pastIn[0]            // don't print
              //this...
@@ -3505,7 +3644,7 @@ bool GDCPass::foundGFsmallSlip(int i, int nseg, int iend, int ibeg,
             // NB last printed test is a failure unless it says possible GF slip
          if (cfg(Debug) >= 6)
          {
-            oss << "GFslip " << GDCUnique << " " << sat << " " << nseg << " "
+            oss << "GFslip " << GDCPassUnique << " " << sat << " " << nseg << " "
                 << setw(3) << i << " " << printTime(time(i), outFormat) << fixed
                 << setprecision(3) << " mag=" << mag
                 << " snr=" << snr; // no endl
@@ -3820,7 +3959,7 @@ int GDCPass::WLconsistencyCheck()
 
             if (cfg(Debug) >= 7)
             {
-               log << "CHECK " << GDCUnique << " " << sat << " " << i << " "
+               log << "CHECK " << GDCPassUnique << " " << sat << " " << i << " "
                    << printTime(time(i), outFormat) << fixed << setprecision(3)
                    << "  "
                    << pastStats.N()
@@ -4094,7 +4233,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
       for (i = 0; i < static_cast<int>(editCmds.size()); i++)
          if (cfg(Debug) >= 2)
          {
-            log << "EditCmd: " << GDCUnique << " " << editCmds[i] << endl;
+            log << "EditCmd: " << GDCPassUnique << " " << editCmds[i] << endl;
          }
 
          // ---------------------------------------------------------
@@ -4147,7 +4286,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
            it++)
       {
          i = (it->nend - it->nbeg + 1); // total number of points
-         oss << GDCtag << " " << GDCUnique << " " << sat << " #" << setw(2)
+         oss << GDCtag << " " << GDCPassUnique << " " << sat << " #" << setw(2)
              << it->nseg << ": " << setw(4) << it->npts << "/" << setw(4) << i
              << " pts, # " << setw(4) << it->nbeg << "-" << setw(4) << it->nend
              << " (" << printTime(time(it->nbeg), outFormat) << " - "
@@ -4180,7 +4319,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
       }
 
          // print the channel number (GLO) and wavelengths in cm
-      oss << GDCtag << " " << GDCUnique << " " << sat << fixed
+      oss << GDCtag << " " << GDCPassUnique << " " << sat << fixed
           << setprecision(2) << " DT " << fixed << setprecision(2) << cfg(DT)
           << " wavelengths " << wl1 * 100.0 << " " << wl2 * 100.0 << " "
           << wlwl * 100.0 << " " << wlgf * 100.0;
@@ -4193,7 +4332,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
          // print WL & GF stats for whole pass
       if (WLPassStats.N() > 2)
       {
-         oss << GDCtag << " " << GDCUnique << " " << sat << " " << fixed
+         oss << GDCtag << " " << GDCPassUnique << " " << sat << " " << fixed
              << setprecision(3) << WLPassStats.StdDev() << " WL sigma in cycles"
              << " N=" << WLPassStats.N() << " Min=" << WLPassStats.Minimum()
              << " Max=" << WLPassStats.Maximum()
@@ -4207,13 +4346,13 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
 
       if (GFPassStats.N() > 2)
       {
-         oss << GDCtag << " " << GDCUnique << " " << sat << " " << fixed
+         oss << GDCtag << " " << GDCPassUnique << " " << sat << " " << fixed
              << setprecision(3) << GFPassStats.StdDev()
              << " sigma GF variation in meters per DT"
              << " N=" << GFPassStats.N() << " Min=" << GFPassStats.Minimum()
              << " Max=" << GFPassStats.Maximum()
              << " Ave=" << GFPassStats.Average() << endl;
-         oss << GDCtag << " " << GDCUnique << " " << sat << " " << fixed
+         oss << GDCtag << " " << GDCPassUnique << " " << sat << " " << fixed
              << setprecision(3)
              << (fabs(GFPassStats.Minimum()) > fabs(GFPassStats.Maximum())
                     ? fabs(GFPassStats.Minimum())
@@ -4226,17 +4365,17 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
          // print 'learn' summary
       map<string, int>::const_iterator kt;
       for (kt = learn.begin(); kt != learn.end(); kt++)
-         oss << GDCtag << " " << GDCUnique << " " << sat << " " << setw(3)
+         oss << GDCtag << " " << GDCPassUnique << " " << sat << " " << setw(3)
              << kt->second << " " << kt->first << endl;
          // if(sat.system == SatelliteSystem::Glonass)
-         //   oss << GDCtag << " " << GDCUnique << " " << sat
+         //   oss << GDCtag << " " << GDCPassUnique << " " << sat
          //      << "  " << GLOn << string(" GLONASS frequency channel") << endl;
 
       int n          = int((lastTime - firstTime) / cfg(DT)) + 1;
       double percent = 100.0 * double(ngood) / n;
       if (cfg(Debug) > 0)
       {
-         oss << GDCtag << "# " << setw(3) << GDCUnique << ", SAT " << sat
+         oss << GDCtag << "# " << setw(3) << GDCPassUnique << ", SAT " << sat
              << ", Pts: " << setw(4) << n << " total " << setw(4) << ngood
              << " good " << fixed << setprecision(1) << setw(5) << percent
              << "%"
@@ -4245,7 +4384,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
 
       if (iret)
       {
-         oss << GDCtag << " " << setw(3) << GDCUnique << " " << sat << " "
+         oss << GDCtag << " " << setw(3) << GDCPassUnique << " " << sat << " "
              << printTime(firstTime, outFormat)
              << " is returning with error code: "
              << (iret == NoData
@@ -4266,7 +4405,7 @@ string GDCPass::finish(int iret, SatPass& svp, vector<string>& editCmds)
 
       if (cfg(Debug) >= 2)
       {
-         log << "======== End GNSSTK Discontinuity Corrector " << GDCUnique
+         log << "======== End GNSSTK Discontinuity Corrector " << GDCPassUnique
              << " ================================================\n";
       }
 
@@ -4339,7 +4478,7 @@ list<Segment>::iterator GDCPass::createSegment(list<Segment>::iterator sit,
 
       if (cfg(Debug) >= 6)
       {
-         log << "SEG " << GDCUnique << " " << sat << " " << msg << " "
+         log << "SEG " << GDCPassUnique << " " << sat << " " << msg << " "
              << printTime(time(ibeg), outFormat) << " " << s.nbeg << " - "
              << s.nend << " biases " << fixed << setprecision(3) << s.bias1
              << " " << s.bias2 << endl;
@@ -4382,7 +4521,7 @@ string GDCPass::dumpSegments(string label, int level, bool extra)
       ostringstream oss;
 
          // summary of SegList
-      oss << label << " " << GDCUnique << " list of Segments ("
+      oss << label << " " << GDCPassUnique << " list of Segments ("
           << SegList.size() << "):" << endl;
 
       if (level < 1)
@@ -4398,7 +4537,7 @@ string GDCPass::dumpSegments(string label, int level, bool extra)
       {
          i = (it->nend - it->nbeg + 1); // total number of points
 
-         oss << label << " " << GDCUnique << " " << sat << " #" << setw(2)
+         oss << label << " " << GDCPassUnique << " " << sat << " #" << setw(2)
              << it->nseg << ": " << setw(4) << it->npts << "/" << setw(4) << i
              << " pts, # " << setw(4) << it->nbeg << "-" << setw(4) << it->nend
              << " (" << printTime(time(it->nbeg), outFormat) << " - "
@@ -4444,7 +4583,7 @@ string GDCPass::dumpSegments(string label, int level, bool extra)
          for (i = it->nbeg; i <= it->nend; i++)
          {
 
-            oss << "DSC" << label << " " << GDCUnique << " " << sat << " "
+            oss << "DSC" << label << " " << GDCPassUnique << " " << sat << " "
                 << it->nseg << " " << printTime(time(i), outFormat) << " "
                 << setw(3) << spdvector[i].flag << fixed << setprecision(3)
                 << " " << setw(13)
@@ -4498,7 +4637,7 @@ void GDCPass::deleteSegment(list<Segment>::iterator& it, string msg)
 
       if (cfg(Debug) >= 6)
       {
-         log << "Delete segment " << GDCUnique << " " << sat << " " << it->nseg
+         log << "Delete segment " << GDCPassUnique << " " << sat << " " << it->nseg
              << " pts " << it->npts << " indexes " << it->nbeg << " - "
              << it->nend << " start " << printTime(firstTime, outFormat)
              << " : " << msg << endl;
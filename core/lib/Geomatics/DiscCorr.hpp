@@ -119,6 +119,9 @@ namespace gnsstk
          /// Tell GDCconfiguration to which stream to send debugging output.
       void setDebugStream(std::ostream& os) { p_oflog = &os; }
 
+         /// Get the stream to which debugging output is sent.
+      std::ostream& getDebugStream() { return *p_oflog; }
+
          /**
           Print help page, including descriptions and current values of all
           the parameters, to the ostream. If 'advanced' is true, also print
@@ -348,6 +351,37 @@ namespace gnsstk
                               std::vector<std::string>& EditCmds,
                               std::string& retMsg, int GLOn = -99);
 
+      /**
+       GNSSTK Discontinuity Corrector for a collection of SatPass, e.g. all the
+       passes of a station-day, using a pool of threads. Each pass is processed
+       exactly as by the single-pass version, using its own copy of config, and
+       the passes are given unique numbers in order, as if they were processed
+       one after the other. The debug output of each pass is collected and
+       written to the debug stream of config in pass order once all the passes
+       are done. Thus neither the results nor the output depend on the number
+       of threads.
+
+       @param SPs      SatPass objects containing the input data; each is
+                       corrected as by the single-pass version.
+       @param config   GDCconfiguration object.
+       @param EditCmds output, parallel to SPs: RinexEditor commands.
+       @param retMsgs  output, parallel to SPs: string summary of results.
+       @param irets    output, parallel to SPs: return code for each pass, as
+                       returned by the single-pass version.
+       @param nThreads number of threads; 0 means one per hardware thread.
+       @param GLOn     GLONASS frequency channels, parallel to SPs; if empty,
+                       -99 (UNKNOWN) for all passes.
+       @return the number of passes for which the return code is 0.
+       @throw Exception if the processing of a pass throws; the exception of
+              the first such pass is rethrown, after all are done.
+      */
+   int DiscontinuityCorrector(std::vector<SatPass>& SPs,
+                              GDCconfiguration& config,
+                              std::vector<std::vector<std::string>>& EditCmds,
+                              std::vector<std::string>& retMsgs,
+                              std::vector<int>& irets, unsigned nThreads = 0,
+                              const std::vector<int>& GLOn = std::vector<int>());
+
    //@}
 
 } // end namespace gnsstk
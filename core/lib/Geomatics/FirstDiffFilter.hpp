@@ -92,6 +92,7 @@
 
 #include "RobustStats.hpp"
 #include "Stats.hpp"
+#include <algorithm>
 #include <vector>
 //#include "StringUtils.hpp"       // TEMP
 //#include "logstream.hpp"         // TEMP
@@ -302,26 +303,31 @@ namespace gnsstk
       }
 
       analvec.clear();
+      analvec.reserve(dsize);
+
+      // work on the contiguous arrays directly
+      const T *pd(data.data());
+      const int *pf(noflags ? nullptr : flags.data());
 
       // find the first good point, but don't necessarily increment
       i = i0;
-      if (!noflags)
+      if (pf)
       {
-         while (i < ilimit && flags[i])
+         while (i < ilimit && pf[i])
             i++;
       }
       int iprev(-1);
+      Analysis A;
       while (i < ilimit)
       {
-         Analysis A;
          A.index = i;
-         A.diff  = (iprev == -1 ? T(0) : data[i] - data[iprev]);
+         A.diff  = (iprev == -1 ? T(0) : pd[i] - pd[iprev]);
          analvec.push_back(A);
          iprev = i;
          i++;
-         if (!noflags)
+         if (pf)
          {
-            while (i < ilimit && flags[i])
+            while (i < ilimit && pf[i])
                i++;
          }
       }
@@ -732,16 +738,15 @@ namespace gnsstk
       int j(-1);
       unsigned int i, k;
       fe.min = fe.max = fe.med = fe.mad = T(0);
-      for (i = 0; i < analvec.size(); i++)
-         if (analvec[i].index == fe.index)
-         {
-            j = i;
-            break;
-         }
-      if (j == -1)
+      // analvec is sorted on index, so use a binary search
+      typename std::vector<Analysis>::const_iterator it(std::lower_bound(
+         analvec.begin(), analvec.end(), fe.index,
+         [](const Analysis& A, unsigned int ind) { return A.index < ind; }));
+      if (it == analvec.end() || it->index != fe.index)
       {
          return;
       }
+      j = it - analvec.begin();
       k = fe.index + fe.npts; // last index in this seg is k-1
 
       // don't include the step in stats for a segment that starts with a slip
@@ -754,6 +759,7 @@ namespace gnsstk
       bool first(true);
       T fd;
       std::vector<T> fdv;
+      fdv.reserve(fe.npts);
       for (i = i0; i < fe.npts; i++)
       {
          if ((unsigned int)(j) + i >= analvec.size() ||
@@ -42,7 +42,14 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 // GNSSTk
 #include "Exception.hpp"
@@ -67,6 +74,57 @@ namespace gnsstk
    //---------------------------------------------------------------------------------
    const double Rinex3ObsFileLoader::dttol(0.001);
 
+   //---------------------------------------------------------------------------------
+      /* The data read from one file by readFile(), reduced to the wanted obs
+         types so that several files may be held in memory at once */
+   struct Rinex3ObsFileLoader::FileData
+   {
+      FileData()
+            : opened(false), headerRead(false), dataError(false),
+              epochsRead(0), readSeconds(0.0)
+      {}
+
+         /// one epoch of data, whose data are data[begin,end)
+      struct Epoch
+      {
+         CommonTime time;
+         short epochFlag;
+         double clockOffset;
+         size_t begin, end;
+      };
+
+         /// one datum of a wanted obs type
+      struct Datum
+      {
+         RinexSatID sat;
+         int type;          ///< index into types
+         RinexDatum datum;
+      };
+
+      string filename;      ///< file name, stripped; empty if blank
+      bool opened;          ///< true if the file was opened
+      bool headerRead;      ///< true if the header was read
+      bool dataError;       ///< true if reading data failed, see error
+      string error;         ///< error message for the file, if any
+      Rinex3ObsHeader header;
+      vector<string> types; ///< wanted 4-char ObsIDs found in the header
+      vector<Epoch> epochs; ///< epochs with flag 0 or 1 within decimation
+      vector<Datum> data;   ///< non-zero data of wanted obs types
+      int epochsRead;       ///< number of records read
+      double readSeconds;   ///< wall clock time to read the file
+      exception_ptr except; ///< exception other than gnsstk::Exception
+   };
+
+   //---------------------------------------------------------------------------------
+      /* Determine if a 4-character RINEX ObsID matches a wanted obs type,
+         which may have '*' for system and/or tracking code */
+   static bool isWantedObsID(const string& wsrot, const string& srot)
+   {
+      return ((wsrot[0] == '*' || wsrot[0] == srot[0]) &&  // system
+              (wsrot[3] == '*' || wsrot[3] == srot[3]) &&  // tracking code
+              wsrot.compare(1, 2, srot, 1, 2) == 0);       // type-freq
+   }
+
    //---------------------------------------------------------------------------------
       /* Read the files already defined
          param[out] errmsg an error/warning message, blank for success
@@ -76,418 +134,617 @@ namespace gnsstk
    {
       try
       {
-         int nint;
-         unsigned int i, j;
-         double dt;
-         string str;
-
-            /* current latest RINEX version
-               critical to ObsID identification independent of RINEX version */
-         const double currVer(Rinex3ObsBase::currentVersion);
-
-            /* Rinex3ObsHeader from Rinex3ObsHeader class GNSSTk class
-               roh = rinex obs header */
-         Rinex3ObsHeader roh;
-            /* Rinex3ObsData from Rinex3ObsData class in GNSSTk
-               rod = rinex obs data, and outrod = output rinex obs data? */
-         Rinex3ObsData rod, outrod;
-         vector<string>::const_iterator vit;
-         map<RinexSatID, vector<int>>::iterator soit; // SatObsCountMap
          ostringstream oss, ossx;
+         const size_t nfiles(filenames.size());
 
          prevtime = CommonTime::BEGINNING_OF_TIME;
             // setTimeSystem sets the method for internal variable m_timeSystem
          prevtime.setTimeSystem(TimeSystem::Any);
+         fileStats.assign(nfiles, FileStats());
+
+            /* Files are read by a pool of threads, at most nthreads files
+               ahead of the one being merged, and merged in order by this
+               thread, so the results do not depend on the number of threads.
+               Each slot holds a file that has been read but not merged */
+         unsigned int nthreads(numThreads > 0
+                               ? numThreads
+                               : std::thread::hardware_concurrency());
+         if (nthreads == 0)
+         {
+            nthreads = 1;
+         }
+         if (nthreads > nfiles)
+         {
+            nthreads = (nfiles > 0 ? nfiles : 1);
+         }
+         vector<unique_ptr<FileData>> slots(nfiles);
+         std::mutex mtx;
+         std::condition_variable cv;
+         size_t nextFile(0), nmerged(0);
+         bool stop(false);
+
+         auto worker = [&]()
+         {
+            while (true)
+            {
+               size_t nf;
+               {
+                  std::unique_lock<std::mutex> lock(mtx);
+                  cv.wait(lock, [&]
+                  {
+                     return (stop || nextFile >= nfiles ||
+                             nextFile < nmerged + nthreads);
+                  });
+                  if (stop || nextFile >= nfiles)
+                  {
+                     return;
+                  }
+                  nf = nextFile++;
+               }
+               unique_ptr<FileData> fd(new FileData);
+               readFile(filenames[nf], *fd);
+               {
+                  std::lock_guard<std::mutex> lock(mtx);
+                  slots[nf] = std::move(fd);
+               }
+               cv.notify_all();
+            }
+         };
+
+            // stop and join the pool however this function is left
+         struct Pool
+         {
+            std::vector<std::thread> threads;
+            std::function<void()> halt;
+            ~Pool()
+            {
+               if (halt)
+               {
+                  halt();
+               }
+               for (unsigned int i = 0; i < threads.size(); i++)
+                  threads[i].join();
+            }
+         } pool;
+         if (nthreads > 1)
+         {
+            pool.halt = [&]()
+            {
+               {
+                  std::lock_guard<std::mutex> lock(mtx);
+                  stop = true;
+               }
+               cv.notify_all();
+            };
+            for (unsigned int i = 0; i < nthreads; i++)
+               pool.threads.push_back(std::thread(worker));
+         }
 
             /* read the files
                initialize number read counter to zero */
          int nread(0);
             // loop over file names
-         for (unsigned int nf = 0; nf < filenames.size(); nf++)
-         {
-               // set the file name to a particular string
-            string filename(filenames[nf]);
-               // strip any blank values from beginning of file name
-            StringUtils::stripLeading(filename);
-               // strip any blank values from end of file name
-            StringUtils::stripTrailing(filename);
+         for (unsigned int nf = 0; nf < nfiles; nf++)
+         {
+            unique_ptr<FileData> fd;
+            if (nthreads > 1)
+            {
+               {
+                  std::unique_lock<std::mutex> lock(mtx);
+                  cv.wait(lock, [&] { return slots[nf] != nullptr; });
+                  fd = std::move(slots[nf]);
+                  nmerged = nf + 1;
+               }
+               cv.notify_all();
+            }
+            else
+            {
+               fd.reset(new FileData);
+               readFile(filenames[nf], *fd);
+            }
+
                // If the file name list is empty, then an error in the file name
-            if (filename.empty())
+            if (fd->filename.empty())
             {
                oss << "Error - file name " << nf + 1 << " is blank";
                continue;
             }
 
-               // declare and initialize onOrder to false
-            bool onOrder(false);
-            vector<int> nOrder;
-            vector<CommonTime> timeOrder;
+            mergeFile(*fd, oss, ossx, fileStats[nf]);
+            nread++;
 
-               // read one file
-            for (;;)
+            if (nepochsToRead > -1 && nepochs >= nepochsToRead)
             {
-                  /* open file ---------------------------------------------
-                     converts file name from a string to a vector of characters
-                     using c_str */
-               Rinex3ObsStream strm(filename.c_str());
-                  // if the obs stream is not successfully opened
-               if (!strm.is_open())
-               {
-                  oss << "Error - could not open file " << filename << endl;
-                  break;
-               }
-               strm.exceptions(fstream::failbit);
+               break;
+            }
+
+         } // end loop over files
+
+         if (!errmsg.empty())
+         {
+            errmsg += string("\n");
+         }
+         errmsg += oss.str();
+         if (!errmsg.empty())
+         {
+            StringUtils::stripTrailing(errmsg, '\n');
+            StringUtils::stripTrailing(errmsg, '\r');
+         }
+         msg = ossx.str();
+         if (!msg.empty())
+         {
+            StringUtils::stripTrailing(msg, '\n');
+            StringUtils::stripTrailing(msg, '\r');
+         }
+
+         return nread;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+      catch (exception& e)
+      {
+         Exception E("std except: " + string(e.what()));
+         GNSSTK_THROW(E);
+      }
+      catch (...)
+      {
+         Exception e("Unknown exception");
+         GNSSTK_THROW(e);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+      /* Read one file, keeping the data of wanted obs types, in epochs that
+         are not excluded by flag or decimation. This depends only on the
+         configuration, not on other files, so files may be read concurrently */
+   void Rinex3ObsFileLoader::readFile(const string& name, FileData& fd) const
+   {
+      std::chrono::steady_clock::time_point t0(std::chrono::steady_clock::now());
+      try
+      {
+            /* current latest RINEX version
+               critical to ObsID identification independent of RINEX version */
+         const double currVer(Rinex3ObsBase::currentVersion);
+
+            // set the file name to a particular string
+         string filename(name);
+            // strip any blank values from beginning of file name
+         StringUtils::stripLeading(filename);
+            // strip any blank values from end of file name
+         StringUtils::stripTrailing(filename);
+         fd.filename = filename;
+         if (filename.empty())
+         {
+            return;
+         }
 
-                  // read header -------------------------------------------
-               try
+            /* open file ------------------------------------------------------
+               compressed and Compact RINEX files are decoded as they are read */
+         Rinex3ObsStream strm;
+         strm.openCompressed(filename);
+            // if the obs stream is not successfully opened
+         if (!strm.is_open() || strm.fail())
+         {
+            fd.error = "Error - could not open file " + filename + "\n";
+            return;
+         }
+         fd.opened = true;
+         strm.exceptions(fstream::failbit);
+
+            // read header ----------------------------------------------------
+         try
+         {
+            strm >> fd.header;
+         }
+         catch (Exception& e)
+         {
+            fd.error = "Error - failed to read header for file " + filename +
+                       " with exception " + e.getText(0) + "\n";
+            strm.close();
+            return;
+         }
+         fd.headerRead = true;
+
+            /* for each system, the index into fd.types of each obs type in
+               the header, or -1 if it is not wanted */
+         map<string, vector<int>> typeIndex;
+         map<string, vector<RinexObsID>>::const_iterator kt;
+         for (kt = fd.header.mapObsTypes.begin();
+              kt != fd.header.mapObsTypes.end(); kt++)
+         {
+            vector<int>& index(typeIndex[kt->first]);
+            for (unsigned int i = 0; i < kt->second.size(); i++)
+            {
+               string srot(kt->first + kt->second[i].asString(currVer));
+               int n(-1);
+               bool wanted(false);
+               for (unsigned int j = 0; !wanted && j < inputWantedObsTypes.size();
+                    j++)
+                  wanted = isWantedObsID(inputWantedObsTypes[j], srot);
+               if (wanted)
                {
-                  strm >> roh;
-
-                     /* update list of wanted obs types
-                        create iterator for looping through roh.mapObsTypes
-                        make it a const_iterator, so that it can be used for access
-                        only, and cannot be used for modification the
-                        roh.mapObsTypes is of type RinexObsMap, which has format
-                        map<string,RinexObsVec> == map<string,vector<RinexObsID>>
-                        A map where string values are the keys and
-                        vector<RinexObsID> are the values mapped to those strings */
-                  map<string, vector<RinexObsID>>::const_iterator kt;
-                  for (kt = roh.mapObsTypes.begin();
-                       kt != roh.mapObsTypes.end(); kt++)
+                  n = vectorindex(fd.types, srot);
+                  if (n == -1)
                   {
-                     for (i = 0; i < kt->second.size(); i++)
-                     {
-                           // need 4-char string version of ObsID
-                        string sys = kt->first; // system
-                        string rot =
-                           kt->second[i].asString(currVer); // 3-char id
-                        string srot = sys + rot;            // 4-char id
-                        string code = rot.substr(2, 1);     // tracking code
-
-                           /* is this ObsID Wanted? and should it be added?
-                              NB RinexObsID::operator==() handles '*' but does not
-                              compare sys NB input (loadObsID()) checks validity of
-                              ObsIDs */
-
-                        for (j = 0; j < inputWantedObsTypes.size(); j++)
-                        {
-                           if (vectorindex(wantedObsTypes, srot) != -1)
-                           {
-                              continue; // already there
-                           }
-
-                              // wsrot = wanted string rinex obs type
-                           string wsrot(inputWantedObsTypes[j]);
-
-                           string wsys(wsrot.substr(0, 1));
-                           if (wsys != "*" && wsys != sys) // different systems
-                           {
-                              continue;
-                           }
-
-                           string wcode(wsrot.substr(3, 1));
-                           if (wcode != "*" && wcode != code) // different codes
-                           {
-                              continue;
-                           }
-
-                           if (wsrot.substr(1, 2) !=
-                               rot.substr(0, 2)) // diff type-freq
-                           {
-                              continue;
-                           }
-
-                              // ok add it
-                           wantedObsTypes.push_back(srot); // add it
-                              // the number of observations for each observation type
-                           countWantedObsTypes.push_back(0);
-
-                           ossx << " Add obs type " << srot << " =~ "
-                                << inputWantedObsTypes[j] << " from "
-                                << filename << endl;
-                        }
-                     }
-                  } // end loop over obs types in header
-
-                     // must keep SatObsCountMap vectors parallel to wantedObsTypes
-                  if (SatObsCountMap.size() > 0)
-                  { // table exists
-                     vector<int> v(SatObsCountMap.begin()->second);
-                     j = wantedObsTypes.size();
-                     if (v.size() < j)
-                     { // vectors are short
-                        soit = SatObsCountMap.begin();
-                        for (; soit != SatObsCountMap.end(); ++soit)
-                           soit->second.resize(j, 0); // extend with zeros
-                     }
+                     n = fd.types.size();
+                     fd.types.push_back(srot);
                   }
-
-                  headers.push_back(roh);
                }
-               catch (Exception& e)
+               index.push_back(n);
+            }
+         }
+
+            // loop over epochs -----------------------------------------------
+         Rinex3ObsData rod;
+         while (1)
+         {
+            try
+            {
+               strm >> rod;
+               rod.time.setTimeSystem(TimeSystem::Any);
+            }
+            catch (Exception& e)
+            {
+               fd.error = "Error - failed to read data in file " + filename +
+                          " with exception " + e.getText(0) + "\n";
+               fd.dataError = true;
+               break;
+            }
+
+               // EOF or error
+            if (strm.eof() || !strm.good())
+            {
+               break;
+            }
+            fd.epochsRead++;
+
+               // skip aux header, etc
+            if (rod.epochFlag != 0 && rod.epochFlag != 1)
+            {
+               continue;
+            }
+
+               // decimate to dtdec-even sec-of-week
+            if (dtdec > 0.0)
+            {
+               double sow(static_cast<GPSWeekSecond>(rod.time).sow);
+               if (::fabs(sow - dtdec * long(0.5 + sow / dtdec)) > 0.5)
                {
-                  oss << "Error - failed to read header for file " << filename
-                      << " with exception " << e.getText(0) << endl;
-                  strm.close();
-                  break;
+                  continue;
                }
+            }
+
+            FileData::Epoch epoch;
+            epoch.time        = rod.time;
+            epoch.epochFlag   = rod.epochFlag;
+            epoch.clockOffset = rod.clockOffset;
+            epoch.begin       = fd.data.size();
 
-                  /* loop over epochs --------------------------------------
-                     while(1) always true, so only breaks out of loop with a break
-                     statement */
-               while (1)
+               // loop over satellites, keeping wanted data
+            Rinex3ObsData::DataMap::const_iterator it;
+            for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
+            {
+               RinexSatID sat(it->first);
+
+                  /* is the sat excluded?  NB it does not exclude
+                     sat=(sys,-1) */
+               if (exSats.size() > 0 && find(exSats.begin(), exSats.end(),
+                                             sat) != exSats.end())
                {
-                  try
-                  {
-                     strm >> rod;
-                     rod.time.setTimeSystem(TimeSystem::Any);
-                  }
-                  catch (Exception& e)
-                  {
-                     oss << "Error - failed to read data in file " << filename
-                         << " with exception " << e.getText(0) << endl;
-                     break;
-                  }
+                  continue;
+               }
 
-                     // EOF or error
-                  if (strm.eof() || !strm.good())
-                  {
-                     break;
-                  }
+               map<string, vector<int>>::const_iterator jt(
+                  typeIndex.find(string(1, sat.systemChar())));
+               if (jt == typeIndex.end())
+               {
+                  continue;
+               }
+               const vector<int>& index(jt->second);
 
-                     // skip aux header, etc
-                  if (rod.epochFlag != 0 && rod.epochFlag != 1)
+                  // loop over obs
+               for (unsigned int i = 0;
+                    i < it->second.size() && i < index.size(); i++)
+               {
+                     /* if the obs data is equal to zero, then do not
+                        consider that obs value (equivalent to missing data) */
+                  if (it->second[i].data == 0.0 || index[i] == -1)
                   {
                      continue;
                   }
+                  FileData::Datum datum;
+                  datum.sat   = sat;
+                  datum.type  = index[i];
+                  datum.datum = it->second[i];
+                  fd.data.push_back(datum);
+               }
+            }
+            epoch.end = fd.data.size();
+            fd.epochs.push_back(epoch);
+         }
 
-                     // decimate to dtdec-even sec-of-week
-                  if (dtdec > 0.0)
-                  {
-                     double sow(static_cast<GPSWeekSecond>(rod.time).sow);
-                        // LOG(INFO) << fixed << setprecision(3) << "Dt " << dt
-                     //<< " dtdec " << dtdec << " sow " << sow
-                     //<< " test " << ::fabs(sow-dtdec*long(0.5+sow/dtdec));
-                     if (::fabs(sow - dtdec * long(0.5 + sow / dtdec)) > 0.5)
-                     {
-                        continue;
-                     }
-                  }
+         strm.close();
+      }
+      catch (...)
+      {
+         fd.except = std::current_exception();
+      }
+      fd.readSeconds = std::chrono::duration<double>(
+         std::chrono::steady_clock::now() - t0).count();
+   }
 
-                     // consider timestep
-                  if (prevtime != CommonTime::BEGINNING_OF_TIME)
-                  {
-                        // compute time since the previous epoch
-                     dt = rod.time - prevtime;
+   //---------------------------------------------------------------------------------
+      /* Merge one file read by readFile() into the results, in order; this
+         is where everything that depends on previous files is done */
+   void Rinex3ObsFileLoader::mergeFile(FileData& fd, ostringstream& oss,
+                                       ostringstream& ossx, FileStats& stats)
+   {
+      std::chrono::steady_clock::time_point t0(std::chrono::steady_clock::now());
+      if (fd.except)
+      {
+         std::rethrow_exception(fd.except);
+      }
 
-                     if (dt >= dttol)
-                     { // positive dt only
-                           // add to the timestep estimator
-                        mcv.add(dt);
-                     }
-                     else if (dt < dttol)
-                     {  // negative, and positive but tiny (< dttol)
-                           // if(isLenient) {
-                        if (!onOrder)
-                        {
-                           nOrder.push_back(0);
-                           timeOrder.push_back(prevtime);
-                           onOrder = true;
-                        }
-                        nOrder[nOrder.size() - 1]++;
-                        continue;
-                        //}
-                           // GNSSTK_THROW(Exception(string("Records out of time
-                           // order: dt ")
-                           //   + StringUtils::asString<double>(dt) + string(" at
-                           //   time ")
-                           //   + printTime(rod.time,timefmt)));
-                     }
-                     onOrder = false;
-                  }
+      unsigned int i, j;
+      double dt;
+      const string& filename(fd.filename);
+      const Rinex3ObsHeader& roh(fd.header);
+      map<RinexSatID, vector<int>>::iterator soit; // SatObsCountMap
+      Rinex3ObsData outrod;
 
-                     // set previous time to current time
-                  prevtime = rod.time;
-                     // ignore data outside of time limits given by user
-                  if (rod.time < startTime)
-                  {
-                     continue;
-                  }
-                  if (rod.time > stopTime)
-                  {
-                     break;
-                  }
-                  if (rod.time < begDataTime)
-                  {
-                     begDataTime = rod.time;
-                  }
-                  if (rod.time > endDataTime)
-                  {
-                     endDataTime = rod.time;
-                  }
-
-                     // The integer number of epochs is advanced
-                  nepochs++;
-                  if (nepochsToRead > -1 && nepochs >= nepochsToRead)
-                  {
-                     break;
-                  }
+      stats.loaded      = true;
+      stats.readSeconds = fd.readSeconds;
+      stats.epochs      = fd.epochsRead;
+      stats.error       = fd.error;
+      StringUtils::stripTrailing(stats.error, '\n');
 
-                     // prepare output rod
-                  outrod.time        = rod.time;
-                  outrod.clockOffset = rod.clockOffset;
-                  outrod.epochFlag   = rod.epochFlag;
-                  //?? outrod.auxHeader.clear();
-                  outrod.numSVs = 0;
-                  outrod.obs.clear();
-
-                     // loop over satellites, counting data per ObsID
-                  Rinex3ObsData::DataMap::const_iterator it;
-                  for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
-                  {
-                        /* Create new RinexSatID variable called sat, initialize
-                           with the it->first pointer from rod.obs current
-                           iteration */
-                     RinexSatID sat(it->first);
-
-                        /* is the sat excluded?  NB it does not exclude
-                           sat=(sys,-1) */
-                     if (exSats.size() > 0 && find(exSats.begin(), exSats.end(),
-                                                   sat) != exSats.end())
-                     {
-                        continue;
-                     }
+      if (!fd.headerRead)
+      {
+         oss << fd.error;
+         stats.mergeSeconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t0).count();
+         return;
+      }
 
-                        /* Exract GNSS system from sat ID, creating new string
-                           variable sys */
-                     string sys(sat.toString().substr(0, 1));
-                        /* Extract the observation types from the rinex obs header
-                           object roh corresponding to the GNSS system from the sat
-                           ID, creating new RinexObsID vector types */
-                     const vector<RinexObsID> types(roh.mapObsTypes[sys]);
+         /* update list of wanted obs types, adding those found in this file
+            in the order in which they appear in the header */
+      for (i = 0; i < fd.types.size(); i++)
+      {
+         const string& srot(fd.types[i]);
+         if (vectorindex(wantedObsTypes, srot) != -1)
+         {
+            continue; // already there
+         }
+         for (j = 0; j < inputWantedObsTypes.size(); j++)
+         {
+            if (isWantedObsID(inputWantedObsTypes[j], srot))
+            {
+               break;
+            }
+         }
+            // ok add it
+         wantedObsTypes.push_back(srot); // add it
+            // the number of observations for each observation type
+         countWantedObsTypes.push_back(0);
+
+         ossx << " Add obs type " << srot << " =~ "
+              << inputWantedObsTypes[j] << " from "
+              << filename << endl;
+      }
 
-                        // loop over obs
-                     for (i = 0; i < it->second.size(); i++)
-                     {
-                           /* if the obs data is equal to zero, then do not
-                              consider that obs value (equivalent to missing data) */
-                        if (it->second[i].data == 0.0)
-                        {
-                           continue; // don't count missing
-                        }
-
-                           /* combine the system and obs type into total rinex obs
-                              ID */
-                        string srot = sys + types[i].asString(
-                                               currVer); // 4-char RinexObsID
-
-                           /* is it wanted? nint is the index into
-                              wantedObsTypes, SatObsCountMap and outrod.obs
-                              vectorindex returns the index of the value srot in
-                              wantedObsTypes if it doesn't exist in that vector,
-                              return -1 */
-                        nint = vectorindex(wantedObsTypes, srot);
-                        if (nint == -1)
-                        {
-                           continue;
-                        }
-
-                           /* count the sat/obs
-                              map<RinexSatID, std::vector<int>> */
-                        soit = SatObsCountMap.find(sat);
-                        if (soit == SatObsCountMap.end())
-                        { // add the sat
-                           vector<int> v(wantedObsTypes.size(),
-                                         0);        // keep parallel
-                           SatObsCountMap[sat] = v; // creates map entry
-                        }
-                        SatObsCountMap[sat][nint]++;
-                        countWantedObsTypes[nint]++;
-
-                           // add it to outrod
-                        if (saveData)
-                        {
-                              // if the satellite is not in outrod.obs
-                           if (outrod.obs.find(sat) == outrod.obs.end())
-                           {
-                              vector<RinexDatum> v(wantedObsTypes.size());
-                              outrod.obs[sat] = v;
-                              outrod.numSVs++;
-                           }
-                           outrod.obs[sat][nint] = it->second[i];
-                        }
-                     }
-                  }
+         // must keep SatObsCountMap vectors parallel to wantedObsTypes
+      if (SatObsCountMap.size() > 0)
+      { // table exists
+         j = wantedObsTypes.size();
+         if (SatObsCountMap.begin()->second.size() < j)
+         { // vectors are short
+            soit = SatObsCountMap.begin();
+            for (; soit != SatObsCountMap.end(); ++soit)
+               soit->second.resize(j, 0); // extend with zeros
+         }
+      }
 
-                     // if saving data, save
-                  if (saveData && outrod.obs.size() > 0)
-                  {
-                     datastore.push_back(outrod);
-                  }
+         // and keep colstore columns parallel to wantedObsTypes
+      for (j = colstore.numObsTypes(); j < wantedObsTypes.size(); j++)
+         colstore.addObsType(wantedObsTypes[j]);
 
-               } // end loop over epochs
+      headers.push_back(roh);
 
-                  // time steps
-               rawdt = mcv.bestDT();
-               nominalDT =
-                  (dtdec > 0.0 ? (dtdec > rawdt ? dtdec : rawdt) : rawdt);
+         // index into wantedObsTypes of each of the file's obs types
+      vector<int> wantedIndex(fd.types.size());
+      for (i = 0; i < fd.types.size(); i++)
+         wantedIndex[i] = vectorindex(wantedObsTypes, fd.types[i]);
 
-               strm.close();
+         // declare and initialize onOrder to false
+      bool onOrder(false);
+      vector<int> nOrder;
+      vector<CommonTime> timeOrder;
+         // true if all the epochs that were read are considered
+      bool complete(true);
 
-               break; // mandatory
-            }         // end for(;;)
+         // loop over epochs ---------------------------------------------------
+      for (size_t ne = 0; ne < fd.epochs.size(); ne++)
+      {
+         const FileData::Epoch& epoch(fd.epochs[ne]);
 
-            nread++;
+            // consider timestep
+         if (prevtime != CommonTime::BEGINNING_OF_TIME)
+         {
+               // compute time since the previous epoch
+            dt = epoch.time - prevtime;
 
-               // warn of time order problems
-            if (timeOrder.size() > 0)
-            {
-               for (i = 0; i < timeOrder.size(); i++)
-                  oss << "Warning - in file " << filename << " " << nOrder[i]
-                      << " data records following epoch "
-                      << printTime(timeOrder[i], timefmt)
-                      << " are out of time order" << endl;
+            if (dt >= dttol)
+            { // positive dt only
+                  // add to the timestep estimator
+               mcv.add(dt);
             }
-
-            if (nepochsToRead > -1 && nepochs >= nepochsToRead)
-            {
-               break;
+            else if (dt < dttol)
+            {  // negative, and positive but tiny (< dttol)
+               if (!onOrder)
+               {
+                  nOrder.push_back(0);
+                  timeOrder.push_back(prevtime);
+                  onOrder = true;
+               }
+               nOrder[nOrder.size() - 1]++;
+               continue;
             }
+            onOrder = false;
+         }
 
-         } // end loop over files
+            // set previous time to current time
+         prevtime = epoch.time;
+            // ignore data outside of time limits given by user
+         if (epoch.time < startTime)
+         {
+            continue;
+         }
+         if (epoch.time > stopTime)
+         {
+            complete = false;
+            break;
+         }
+         if (epoch.time < begDataTime)
+         {
+            begDataTime = epoch.time;
+         }
+         if (epoch.time > endDataTime)
+         {
+            endDataTime = epoch.time;
+         }
 
-         if (!errmsg.empty())
+            // The integer number of epochs is advanced
+         nepochs++;
+         if (nepochsToRead > -1 && nepochs >= nepochsToRead)
          {
-            errmsg += string("\n");
+            complete = false;
+            break;
          }
-         errmsg += oss.str();
-         if (!errmsg.empty())
+
+            // prepare output rod
+         outrod.time        = epoch.time;
+         outrod.clockOffset = epoch.clockOffset;
+         outrod.epochFlag   = epoch.epochFlag;
+         outrod.numSVs = 0;
+         outrod.obs.clear();
+         bool colEpoch(false); // epoch has been added to colstore
+         size_t colrow(0);     // row of sat in colstore
+         bool colRowAdded(false);
+
+            // loop over data, which are in satellite order
+         for (size_t k = epoch.begin; k < epoch.end; k++)
          {
-            StringUtils::stripTrailing(errmsg, '\n');
-            StringUtils::stripTrailing(errmsg, '\r');
+            const FileData::Datum& datum(fd.data[k]);
+            const RinexSatID& sat(datum.sat);
+            if (k == epoch.begin || !(sat == fd.data[k-1].sat))
+            {
+               colRowAdded = false;
+            }
+
+               // nint is the index into wantedObsTypes, SatObsCountMap
+               // and outrod.obs
+            int nint(wantedIndex[datum.type]);
+
+               /* count the sat/obs
+                  map<RinexSatID, std::vector<int>> */
+            soit = SatObsCountMap.find(sat);
+            if (soit == SatObsCountMap.end())
+            { // add the sat
+               vector<int> v(wantedObsTypes.size(), 0); // keep parallel
+               soit = SatObsCountMap.insert(make_pair(sat, v)).first;
+            }
+            soit->second[nint]++;
+            countWantedObsTypes[nint]++;
+
+               // add it to outrod
+            if (saveData && columnar)
+            {
+                  // fill colstore directly, no outrod
+               if (!colEpoch)
+               {
+                  colstore.addEpoch(epoch.time, epoch.epochFlag,
+                                    epoch.clockOffset);
+                  colEpoch = true;
+               }
+               if (!colRowAdded)
+               {
+                  colrow = colstore.addRow(sat);
+                  colRowAdded = true;
+               }
+               colstore.setDatum(colrow, nint, datum.datum);
+            }
+            else if (saveData)
+            {
+                  // if the satellite is not in outrod.obs
+               Rinex3ObsData::DataMap::iterator ot(outrod.obs.find(sat));
+               if (ot == outrod.obs.end())
+               {
+                  vector<RinexDatum> v(wantedObsTypes.size());
+                  ot = outrod.obs.insert(make_pair(sat, v)).first;
+                  outrod.numSVs++;
+               }
+               ot->second[nint] = datum.datum;
+            }
          }
-         msg = ossx.str();
-         if (!msg.empty())
+
+            // if saving data, save
+         if (saveData && !columnar && outrod.obs.size() > 0)
          {
-            StringUtils::stripTrailing(msg, '\n');
-            StringUtils::stripTrailing(msg, '\r');
+            datastore.push_back(outrod);
          }
 
-         return nread;
-      }
-      catch (Exception& e)
+      } // end loop over epochs
+
+         // a read error is only reached if all the epochs before it were used
+      if (complete && fd.dataError)
       {
-         GNSSTK_RETHROW(e);
+         oss << fd.error;
       }
-      catch (exception& e)
+
+         // time steps
+      rawdt = mcv.bestDT();
+      nominalDT =
+         (dtdec > 0.0 ? (dtdec > rawdt ? dtdec : rawdt) : rawdt);
+
+         // warn of time order problems
+      if (timeOrder.size() > 0)
       {
-         Exception E("std except: " + string(e.what()));
-         GNSSTK_THROW(E);
+         for (i = 0; i < timeOrder.size(); i++)
+         {
+            oss << "Warning - in file " << filename << " " << nOrder[i]
+                << " data records following epoch "
+                << printTime(timeOrder[i], timefmt)
+                << " are out of time order" << endl;
+            stats.outOfOrder += nOrder[i];
+         }
       }
-      catch (...)
+
+      stats.mergeSeconds = std::chrono::duration<double>(
+         std::chrono::steady_clock::now() - t0).count();
+   }
+
+   //---------------------------------------------------------------------------------
+   void Rinex3ObsFileLoader::dumpFileStats(ostream& s) const
+   {
+      s << "Table of per-file statistics\n"
+        << "   n    epochs  out-of-order    read(s)   merge(s)  file\n";
+      for (unsigned int i = 0; i < fileStats.size(); i++)
       {
-         Exception e("Unknown exception");
-         GNSSTK_THROW(e);
+         const FileStats& fs(fileStats[i]);
+         if (!fs.loaded)
+         {
+            continue;
+         }
+         s << setw(4) << i + 1 << setw(10) << fs.epochs
+           << setw(14) << fs.outOfOrder
+           << fixed << setprecision(3) << setw(11) << fs.readSeconds
+           << setw(11) << fs.mergeSeconds << "  " << filenames[i] << "\n";
+         if (!fs.error.empty())
+         {
+            s << "      " << fs.error << "\n";
+         }
       }
    }
 
@@ -506,7 +763,7 @@ namespace gnsstk
           << "sec, obs types";
       for (i = 0; i < wantedObsTypes.size(); i++)
          oss << " " << wantedObsTypes[i];
-      oss << ", store size " << datastore.size();
+      oss << ", store size " << getStoreSize();
       oss << "\n";
       oss << " Time limits: begin  " << printTime(begDataTime, longfmt) << "\n"
           << "                end  " << printTime(endDataTime, longfmt) << "\n";
@@ -542,7 +799,7 @@ namespace gnsstk
          {
             return -3;
          }
-         if (datastore.size() == 0)
+         if (getStoreSize() == 0)
          {
             return -4;
          }
@@ -577,9 +834,14 @@ namespace gnsstk
          vector<double> data(nobs, 0.0);
          vector<unsigned short> ssi(nobs, 0), lli(nobs, 0);
 
-            // loop over the data store = vector<Rinex3ObsData>
-         for (unsigned int nds = 0; nds < datastore.size(); nds++)
+            // loop over the data store = vector<Rinex3ObsData>, or the
+            // column store, one epoch at a time
+         Rinex3ObsData colrod;
+         for (int nds = 0; nds < getStoreSize(); nds++)
          {
+            if (columnar)
+               colstore.getEpoch(nds, colrod);
+            const Rinex3ObsData& rod(columnar ? colrod : datastore[nds]);
 
                // LOG(INFO) << "WriteSPL " <<
                // printTime(datastore[nds].time,timefmt)
@@ -589,8 +851,7 @@ namespace gnsstk
                // loop over satellites
             Rinex3ObsData::DataMap::const_iterator it;
             map<char, vector<int>>::const_iterator jt;
-            for (it = datastore[nds].obs.begin();
-                 it != datastore[nds].obs.end(); ++it)
+            for (it = rod.obs.begin(); it != rod.obs.end(); ++it)
             {
                sys = it->first.systemChar();
                jt  = indexLoadOT.find(sys);
@@ -655,7 +916,7 @@ namespace gnsstk
                do
                {
                   i = SPList[satit->second].addData(
-                     datastore[nds].time, obsit->second, data, lli, ssi, flag);
+                     rod.time, obsit->second, data, lli, ssi, flag);
 
                   if (i == -1)
                   { // there was a gap - break into two passes
@@ -749,10 +1010,13 @@ namespace gnsstk
          param ostream s to which to write */
    void Rinex3ObsFileLoader::dumpStoreData(ostream& s) const
    {
-      s << "\nDump the ROFL data(" << datastore.size() << "):" << endl;
-      for (unsigned int i = 0; i < datastore.size(); i++)
+      s << "\nDump the ROFL data(" << getStoreSize() << "):" << endl;
+      Rinex3ObsData colrod;
+      for (int i = 0; i < getStoreSize(); i++)
       {
-         const Rinex3ObsData &rod(datastore[i]);
+         if (columnar)
+            colstore.getEpoch(i, colrod);
+         const Rinex3ObsData &rod(columnar ? colrod : datastore[i]);
          dumpStoreEpoch(s, rod);
       }
    }
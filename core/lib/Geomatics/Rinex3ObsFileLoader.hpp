@@ -44,6 +44,7 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,7 @@
 #include "CommonTime.hpp"
 #include "Exception.hpp"
 #include "MostCommonValue.hpp"
+#include "Rinex3ObsColumnStore.hpp"
 #include "Rinex3ObsData.hpp"
 #include "Rinex3ObsHeader.hpp"
 #include "stl_helpers.hpp" // vectorindex
@@ -84,6 +86,22 @@ namespace gnsstk
       */
    class Rinex3ObsFileLoader
    {
+   public:
+         /// statistics for one input file, filled by loadFiles()
+      struct FileStats
+      {
+         FileStats()
+               : loaded(false), readSeconds(0.0), mergeSeconds(0.0),
+                 epochs(0), outOfOrder(0)
+         {}
+         bool loaded;         ///< true if the file was processed
+         double readSeconds;  ///< wall clock time to open, read and decode
+         double mergeSeconds; ///< wall clock time to merge into the store
+         int epochs;          ///< number of records read from the file
+         int outOfOrder;      ///< number of records out of time order
+         std::string error;   ///< error reading the file, blank if none
+      };
+
    private:
       static const double dttol; ///< tolerance in comparing times
 
@@ -91,6 +109,8 @@ namespace gnsstk
       std::vector<std::string> filenames; ///< input RINEX obs file names
       int nepochsToRead;                  ///< number of epochs to read (default:all)
       bool saveData;                      ///< if true save the data (F)
+      bool columnar;                      ///< if true save in colstore (F)
+      unsigned numThreads;                ///< threads reading files (1)
       std::string timefmt;                ///< format for time tags in output
       // editing
       double dtdec;                       ///< decimate to this time step
@@ -137,10 +157,41 @@ namespace gnsstk
          /// vector of all input data - filled only if saveData is true.
       std::vector<Rinex3ObsData> datastore;
 
+         /** all input data by column - filled instead of datastore if
+             saveData and columnar are true. Columns are parallel to
+             wantedObsTypes. */
+      Rinex3ObsColumnStore colstore;
+
+         /// statistics for each of filenames, from the last loadFiles()
+      std::vector<FileStats> fileStats;
+
+         /// data read from one file, see readFile()
+      struct FileData;
+
+         /**
+          Read one file, keeping wanted data; uses only the configuration,
+          so it may be called concurrently for different files.
+          @param[in] filename name of the RINEX obs file
+          @param[out] fd the data read, and any error
+         */
+      void readFile(const std::string& filename, FileData& fd) const;
+
+         /**
+          Merge the data of one file into the output, in file order.
+          @param[in] fd the data read by readFile()
+          @param[in,out] oss error and warning messages
+          @param[in,out] ossx informative messages
+          @param[out] stats statistics for the file
+         */
+      void mergeFile(FileData& fd, std::ostringstream& oss,
+                     std::ostringstream& ossx, FileStats& stats);
+
          /// initialization used by the constructors
       void init()
       {
          saveData      = false;
+         columnar      = false;
+         numThreads    = 1;
          nepochsToRead = -1;
          timefmt       = std::string("%04Y/%02m/%02d %02H:%02M:%02S");
          reset();
@@ -194,11 +245,13 @@ namespace gnsstk
          obstypes.clear();
          mcv.reset();
          datastore.clear();
+         colstore = Rinex3ObsColumnStore();
          exSats.clear();
          headers.clear();
          inputWantedObsTypes.clear();
          wantedObsTypes.clear();
          SatObsCountMap.clear();
+         fileStats.clear();
       }
 
          /**
@@ -271,6 +324,35 @@ namespace gnsstk
          */
       inline bool dataSaved() { return saveData; }
 
+         /**
+          set the column store flag; when saving data, save it in a
+          Rinex3ObsColumnStore (see getColumnStore()) rather than a
+          vector<Rinex3ObsData> (see getStore()). This uses far less memory.
+          @param b if true, then save the data in the column store
+         */
+      inline void useColumnStore(bool b) { columnar = b; }
+
+         /**
+          access the column store flag
+          @return if true, then data is saved in the column store
+         */
+      inline bool columnStoreUsed() const { return columnar; }
+
+         /**
+          set the number of threads used to read files. Files are read
+          concurrently, at most n at a time and at most n files ahead of the
+          one being merged, and merged in the order given, so the output does
+          not depend on n.
+          @param n number of threads; 0 means one per hardware thread
+         */
+      inline void setNumThreads(unsigned n) { numThreads = n; }
+
+         /**
+          access the number of threads used to read files
+          @return number of threads, 0 means one per hardware thread
+         */
+      inline unsigned getNumThreads() const { return numThreads; }
+
          /**
           set the start time
           @param[in] tt start time, ignore data before this time
@@ -378,7 +460,10 @@ namespace gnsstk
           get the size of the data store
           @return size (number of epochs) in the store
          */
-      inline const int getStoreSize() const { return datastore.size(); }
+      inline const int getStoreSize() const
+      {
+         return (columnar ? colstore.numEpochs() : datastore.size());
+      }
 
          /**
           access the data store
@@ -389,6 +474,17 @@ namespace gnsstk
          return datastore;
       }
 
+         /**
+          access the column store, filled instead of the datastore when
+          useColumnStore(true) has been called
+          @return const ref to the column store, whose obs types are
+          wantedObsTypes
+         */
+      inline const Rinex3ObsColumnStore& getColumnStore() const
+      {
+         return colstore;
+      }
+
       // Read the files ----------------------------------------------------
 
          /**
@@ -399,6 +495,15 @@ namespace gnsstk
          */
       int loadFiles(std::string& errmsg, std::string& msg);
 
+         /**
+          access the per-file statistics of the last loadFiles()
+          @return vector parallel to the file names
+         */
+      inline const std::vector<FileStats>& getFileStats() const
+      {
+         return fileStats;
+      }
+
       // Utilities ---------------------------------------------------------
 
          /**
@@ -429,6 +534,12 @@ namespace gnsstk
          */
       void dumpSatObsTable(std::ostream& s) const;
 
+         /**
+          Dump the per-file statistics of the last loadFiles()
+          @param s to which to write the table
+         */
+      void dumpFileStats(std::ostream& s) const;
+
          /**
           Dump the stored data for one epoch - NB setTimeFormat()
           @param s to which to write the data
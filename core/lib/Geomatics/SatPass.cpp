@@ -109,6 +109,7 @@ namespace gnsstk
          indexForLabel[obstypes[i]] = i;
          labelForIndex[i]           = obstypes[i];
       }
+      spdvector = SatPassStore(obstypes.size());
    }
 
    SatPass& SatPass::operator=(const SatPass& right)
@@ -123,9 +124,7 @@ namespace gnsstk
          firstTime     = right.firstTime;
          lastTime      = right.lastTime;
          ngood         = right.ngood;
-         spdvector.resize(right.spdvector.size());
-         for (int i = 0; i < right.spdvector.size(); i++)
-            spdvector[i] = right.spdvector[i];
+         spdvector     = right.spdvector;
       }
 
       return *this;
@@ -164,29 +163,70 @@ namespace gnsstk
                      StringUtils::asString(ssi.size()));
          GNSSTK_THROW(e);
       }
-      if (spdvector.size() > 0 && spdvector[0].data.size() != data.size())
+      if (obstypes.size() < data.size())
       {
-         Exception e(
-            "Error - addData passed different dimension that earlier!" +
-            StringUtils::asString(data.size()) +
-            " != " + StringUtils::asString(spdvector[0].data.size()));
+         Exception e("Error - addData passed fewer obs types than data!" +
+                     StringUtils::asString(obstypes.size()) + " < " +
+                     StringUtils::asString(data.size()));
          GNSSTK_THROW(e);
       }
+         // obs types not given are left zero
+      for (int k = 0; k < data.size(); k++)
+      {
+         if (indexForLabel.find(obstypes[k]) == indexForLabel.end())
+         {
+            Exception e("Invalid obs type in addData() " + obstypes[k]);
+            GNSSTK_THROW(e);
+         }
+      }
 
-         // create a new SatPassData
-      SatPassData spd(data.size());
-      spd.flag = flag;
+         // push_back defines count and
+         // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
+      int n = pushBack(tt, flag);
+      if (n < 0)
+      {
+         return n;
+      }
+      SatPassStore::Row spd(spdvector[n]);
       for (int k = 0; k < data.size(); k++)
       {
-         int i       = indexForLabel[obstypes[k]];
+         int i       = indexForLabel.find(obstypes[k])->second;
          spd.data[i] = data[k];
          spd.lli[i]  = lli[k];
          spd.ssi[i]  = ssi[k];
       }
+      return n;
+   }
 
-         // push_back defines count and
-         // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
-      return pushBack(tt, spd);
+   int SatPass::addData(const Epoch& tt, const std::vector<double>& data,
+                        const std::vector<unsigned short>& lli,
+                        const std::vector<unsigned short>& ssi,
+                        const unsigned short flag)
+   {
+      if (data.size() != spdvector.nobs() || lli.size() != data.size() ||
+          ssi.size() != data.size())
+      {
+         Exception e("Dimensions do not match in addData()" +
+                     StringUtils::asString(data.size()) + "," +
+                     StringUtils::asString(lli.size()) + "," +
+                     StringUtils::asString(ssi.size()) + " obs types " +
+                     StringUtils::asString(spdvector.nobs()));
+         GNSSTK_THROW(e);
+      }
+
+      int n = pushBack(tt, flag);
+      if (n < 0)
+      {
+         return n;
+      }
+      SatPassStore::Row spd(spdvector[n]);
+      for (int k = 0; k < data.size(); k++)
+      {
+         spd.data[k] = data[k];
+         spd.lli[k]  = lli[k];
+         spd.ssi[k]  = ssi[k];
+      }
+      return n;
    }
 
       /* return -4 robs was not obs data (header info)
@@ -204,42 +244,44 @@ namespace gnsstk
       RinexObsData::RinexSatMap::const_iterator it;
       RinexObsData::RinexObsTypeMap::const_iterator jt;
       map<string, unsigned int>::const_iterator kt;
-      SatPassData spd(indexForLabel.size());
 
-         // loop over satellites
-      for (it = robs.obs.begin(); it != robs.obs.end(); it++)
+         // find this->sat
+      if ((it = robs.obs.find(sat)) == robs.obs.end())
       {
-         if (it->first == sat)
-         { // sat is this->sat
-            spd.flag = OK;
-               // loop over obs
-            for (kt = indexForLabel.begin(); kt != indexForLabel.end(); kt++)
-            {
-               if ((jt = it->second.find(RinexObsHeader::convertObsType(
-                       kt->first))) == it->second.end())
-               {
-                  spd.data[kt->second] = 0.0;
-                  spd.lli[kt->second]  = 0;
-                  spd.ssi[kt->second]  = 0;
-                     // spd.flag = BAD;// don't do this b/c spd may have 'empty'
-                     // obs types
-               }
-               else
-               {
-                  spd.data[kt->second] = jt->second.data;
-                  spd.lli[kt->second]  = jt->second.lli;
-                  spd.ssi[kt->second]  = jt->second.ssi;
-                  if (jt->second.data == 0.0)
-                  {
-                     spd.flag = BAD;
-                  }
-               }
-            } // end loop over obs
+         return -3; // sat was not found
+      }
 
-            return pushBack(robs.time, spd);
+         // add the epoch, then fill it in place; missing obs are left zero
+      int n = pushBack(robs.time, OK);
+      if (n < 0)
+      {
+         return n;
+      }
+      SatPassStore::Row spd(spdvector[n]);
+      bool bad(false);
+         // loop over obs
+      for (kt = indexForLabel.begin(); kt != indexForLabel.end(); kt++)
+      {
+            // don't set flag BAD for missing obs b/c spd may have 'empty'
+            // obs types
+         if ((jt = it->second.find(RinexObsHeader::convertObsType(
+                 kt->first))) != it->second.end())
+         {
+            spd.data[kt->second] = jt->second.data;
+            spd.lli[kt->second]  = jt->second.lli;
+            spd.ssi[kt->second]  = jt->second.ssi;
+            if (jt->second.data == 0.0)
+            {
+               bad = true;
+            }
          }
+      } // end loop over obs
+      if (bad)
+      {
+         setFlag(n, BAD);
       }
-      return -3; // sat was not found
+
+      return n;
    }
 
       /* Truncate all data at and after the given time.
@@ -267,7 +309,8 @@ namespace gnsstk
             return -1;
          }
 
-         unsigned int i, j, n(0); // count for ngood
+         unsigned int i, n(0); // count for ngood
+         int j(-1);
          for (i = 0; i < spdvector.size(); i++)
          {
             if (spdvector[i].ndt >= static_cast<unsigned int>(count))
@@ -937,6 +980,71 @@ namespace gnsstk
       return spdvector[i].ssi[it->second];
    }
 
+   double& SatPass::data(unsigned int i, unsigned int k)
+   {
+      if (i >= spdvector.size())
+      {
+         Exception e("Invalid index in data() " + asString(i));
+         GNSSTK_THROW(e);
+      }
+      if (k >= spdvector.nobs())
+      {
+         Exception e("Invalid obs type handle in data() " + asString(k));
+         GNSSTK_THROW(e);
+      }
+      return spdvector[i].data[k];
+   }
+
+   unsigned short& SatPass::LLI(unsigned int i, unsigned int k)
+   {
+      if (i >= spdvector.size())
+      {
+         Exception e("Invalid index in LLI() " + asString(i));
+         GNSSTK_THROW(e);
+      }
+      if (k >= spdvector.nobs())
+      {
+         Exception e("Invalid obs type handle in LLI() " + asString(k));
+         GNSSTK_THROW(e);
+      }
+      return spdvector[i].lli[k];
+   }
+
+   unsigned short& SatPass::SSI(unsigned int i, unsigned int k)
+   {
+      if (i >= spdvector.size())
+      {
+         Exception e("Invalid index in SSI() " + asString(i));
+         GNSSTK_THROW(e);
+      }
+      if (k >= spdvector.nobs())
+      {
+         Exception e("Invalid obs type handle in SSI() " + asString(k));
+         GNSSTK_THROW(e);
+      }
+      return spdvector[i].ssi[k];
+   }
+
+   double *SatPass::dataColumn(unsigned int k)
+   {
+      if (k >= spdvector.nobs())
+      {
+         Exception e("Invalid obs type handle in dataColumn() " + asString(k));
+         GNSSTK_THROW(e);
+      }
+      return spdvector.column(k);
+   }
+
+   const double *SatPass::dataColumn(unsigned int k) const
+   {
+      if (k >= spdvector.nobs())
+      {
+         Exception e("Invalid obs type handle in dataColumn() " + asString(k));
+         GNSSTK_THROW(e);
+      }
+      return spdvector.column(k);
+   }
+
       // ---------------------------------- set routines
       // ----------------------------
    void SatPass::setFlag(unsigned int i, unsigned short f)
@@ -1140,6 +1248,7 @@ namespace gnsstk
          newSP.Status        = Status;
          newSP.indexForLabel = indexForLabel;
          newSP.labelForIndex = labelForIndex;
+         newSP.spdvector     = SatPassStore(spdvector.nobs());
 
          oldgood = ngood;
          ngood = ilast = 0;
@@ -1165,7 +1274,7 @@ namespace gnsstk
                j                    = newSP.countForTime(tt);
                spdvector[i].ndt     = j;
                spdvector[i].toffset = tt - newSP.firstTime - j * dt;
-               newSP.spdvector.push_back(spdvector[i]);
+               newSP.spdvector.push_back(spdvector, i);
             }
          }
 
@@ -1232,7 +1341,7 @@ namespace gnsstk
                spdvector[i].toffset =
                   tt - newfirstTime - spdvector[i].ndt * N * dt;
             }
-            spdvector[j] = spdvector[i];
+            spdvector.copy(j, i);
             if (spdvector[j].flag != BAD)
             {
                ngood++;
@@ -1388,10 +1497,10 @@ namespace gnsstk
       return os;
    }
 
-      /* ---------------------------- private SatPassData functions
+      /* ---------------------------- private SatPassStore functions
          -------------------- add data to the arrays at timetag tt (private) return
          >=0 ok (index of added data), -1 gap, -2 timetag out of order */
-   int SatPass::pushBack(const Epoch tt, SatPassData& spd)
+   int SatPass::pushBack(const Epoch tt, unsigned short flag)
    {
       unsigned int n;
          // if this is the first point, save first time
@@ -1417,27 +1526,15 @@ namespace gnsstk
       }
 
          /* add it
-            spd.flag = 1;
             ngood is useless unless it's changed whenever any flag is... */
-      if (spd.flag != SatPass::BAD)
+      if (flag != SatPass::BAD)
       {
          ngood++;
       }
-      spd.ndt     = n;
-      spd.toffset = tt - firstTime - n * dt;
-      spdvector.push_back(spd);
-      return (spdvector.size() - 1);
-   }
-
-      // get one element of the data array of this SatPass (private)
-   struct SatPass::SatPassData SatPass::getData(unsigned int i) const
-   {
-      if (i >= spdvector.size())
-      { // TD ?? keep this - its private
-         Exception e("invalid in getData() " + asString(i));
-         GNSSTK_THROW(e);
-      }
-      return spdvector[i];
+      unsigned int i       = spdvector.push_back(flag);
+      spdvector[i].ndt     = n;
+      spdvector[i].toffset = tt - firstTime - n * dt;
+      return i;
    }
 
 } // end namespace gnsstk
@@ -44,6 +44,7 @@
 #include <map>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "gnsstk_export.h"
@@ -71,82 +72,239 @@ namespace gnsstk
    class SatPass
    {
    protected:
-      // --------------- SatPassData data structure for internal use only
+      // --------------- SatPassStore data structure for internal use only
          /**
-          struct SatPassData, for internal use only, stores the data and flag
-          arrays (data, lli, ssi) plus a time offset, a SatPass flag, a user flag,
-          and the offset n in time (n*dt) since FirstTime. class SatPass will
-          include a vector of these structs.
+          class SatPassStore, for internal use only, stores all the data in the
+          pass in columns: one contiguous array per obs type for each of data,
+          lli and ssi, plus arrays of the time offset, SatPass flag, user flag,
+          and the offset n in time (n*dt) since FirstTime. Thus a pass costs a
+          handful of allocations rather than several per epoch, and a single
+          obs type may be read as one array. operator[](i) returns a light
+          proxy for epoch i, so that spdvector[i].data[k], spdvector[i].flag,
+          etc. read and write the columns directly.
          */
-      struct SatPassData
+      class SatPassStore
       {
-         // member data ----------------------------------
+      public:
             /**
-             a flag (cf. SatPass::BAD, etc.) that is set to OK at creation
-             then reset by other processing.
+             view of the values of one epoch across obs types, in one of the
+             column sets (data, lli or ssi); V is const-qualified for
+             read-only access.
             */
-         unsigned short flag;
+         template <class V>
+         class ObsRow
+         {
+         public:
+            typedef typename std::remove_const<V>::type value_type;
+            typedef typename std::conditional<
+               std::is_const<V>::value,
+               const std::vector<std::vector<value_type> >,
+               std::vector<std::vector<value_type> > >::type Columns;
+
+            ObsRow(Columns& c, unsigned int i) : cols(c), n(i) {}
+               /// value for obs type k at this epoch
+            V& operator[](unsigned int k) const { return cols[k][n]; }
+               /// number of obs types
+            size_t size() const { return cols.size(); }
+
+         private:
+            Columns& cols;
+            unsigned int n;
+         };
+
+            /// references to everything stored for one epoch
+         struct Row
+         {
+            unsigned short& flag;
+            unsigned int& userflag;
+            unsigned int& ndt;
+            double& toffset;
+            ObsRow<double> data;
+            ObsRow<unsigned short> lli, ssi;
+         };
+
+            /// read-only references to everything stored for one epoch
+         struct ConstRow
+         {
+            const unsigned short& flag;
+            const unsigned int& userflag;
+            const unsigned int& ndt;
+            const double& toffset;
+            ObsRow<const double> data;
+            ObsRow<const unsigned short> lli, ssi;
+         };
 
             /**
-             a flag for arbitrary use by the user; SatPass ONLY has
-             set/getUserFlag()
+             constructor
+             @param n the number of data types to be stored, default 4
             */
-         unsigned int userflag;
+         SatPassStore(unsigned short n = 4)
+            : obs(n), llis(n), ssis(n)
+         {}
 
-            /// time 'count' : time of data = FirstTime + ndt * dt + offset
-         unsigned int ndt;
+            /// number of epochs stored
+         size_t size() const { return ndts.size(); }
 
-            /// offset of time from integer number * dt since FirstTime.
-         double toffset;
+            /// number of obs types stored
+         size_t nobs() const { return obs.size(); }
 
-            /// data for one epoch of RINEX data
-         std::vector<double> data;
+         Row operator[](unsigned int i)
+         {
+            Row r = { flags[i], userflags[i], ndts[i], toffsets[i],
+                      ObsRow<double>(obs, i), ObsRow<unsigned short>(llis, i),
+                      ObsRow<unsigned short>(ssis, i) };
+            return r;
+         }
 
-            /**
-             loss-of-lock and signal-strength indicators (from RINEX) for data
-             parallel to data vector
-            */
-         std::vector<unsigned short> lli, ssi;
+         ConstRow operator[](unsigned int i) const
+         {
+            ConstRow r = { flags[i], userflags[i], ndts[i], toffsets[i],
+                           ObsRow<const double>(obs, i),
+                           ObsRow<const unsigned short>(llis, i),
+                           ObsRow<const unsigned short>(ssis, i) };
+            return r;
+         }
 
-         // private member functions ---------------------
+            /// contiguous data for obs type k, size() long
+         double *column(unsigned int k) { return obs[k].data(); }
+         const double *column(unsigned int k) const { return obs[k].data(); }
 
             /**
-             constructor
-             @param n the number of data types to be stored, default 4
+             append an epoch with flag f, all data, lli and ssi zero
+             @return the index of the new epoch
             */
-         SatPassData(unsigned short n = 4)
-            : flag(SatPass::OK), userflag(0), ndt(0), toffset(0.0)
+         unsigned int push_back(unsigned short f = SatPass::OK)
+         {
+            flags.push_back(f);
+            userflags.push_back(0);
+            ndts.push_back(0);
+            toffsets.push_back(0.0);
+            for (size_t k = 0; k < obs.size(); k++)
+            {
+               obs[k].push_back(0.0);
+               llis[k].push_back(0);
+               ssis[k].push_back(0);
+            }
+            return ndts.size() - 1;
+         }
+
+            /// append a copy of epoch i of store src, which has the same obs
+         void push_back(const SatPassStore& src, unsigned int i)
+         {
+            flags.push_back(src.flags[i]);
+            userflags.push_back(src.userflags[i]);
+            ndts.push_back(src.ndts[i]);
+            toffsets.push_back(src.toffsets[i]);
+            for (size_t k = 0; k < obs.size(); k++)
+            {
+               obs[k].push_back(src.obs[k][i]);
+               llis[k].push_back(src.llis[k][i]);
+               ssis[k].push_back(src.ssis[k][i]);
+            }
+         }
+
+            /// copy everything at epoch from to epoch to
+         void copy(unsigned int to, unsigned int from)
+         {
+            flags[to]     = flags[from];
+            userflags[to] = userflags[from];
+            ndts[to]      = ndts[from];
+            toffsets[to]  = toffsets[from];
+            for (size_t k = 0; k < obs.size(); k++)
+            {
+               obs[k][to]  = obs[k][from];
+               llis[k][to] = llis[k][from];
+               ssis[k][to] = ssis[k][from];
+            }
+         }
+
+            /// truncate to, or extend with zeros to, n epochs
+         void resize(size_t n)
+         {
+            flags.resize(n, SatPass::OK);
+            userflags.resize(n, 0);
+            ndts.resize(n, 0);
+            toffsets.resize(n, 0.0);
+            for (size_t k = 0; k < obs.size(); k++)
+            {
+               obs[k].resize(n, 0.0);
+               llis[k].resize(n, 0);
+               ssis[k].resize(n, 0);
+            }
+         }
+
+            /// reserve room for n epochs in every column
+         void reserve(size_t n)
          {
-            data = std::vector<double>(n, 0.0);
-            lli  = std::vector<unsigned short>(n, 0);
-            ssi  = std::vector<unsigned short>(n, 0);
+            flags.reserve(n);
+            userflags.reserve(n);
+            ndts.reserve(n);
+            toffsets.reserve(n);
+            for (size_t k = 0; k < obs.size(); k++)
+            {
+               obs[k].reserve(n);
+               llis[k].reserve(n);
+               ssis[k].reserve(n);
+            }
          }
 
-         // d'tor, copy c'tor and operator= are built by compiler,
-         // but operator= will not work correctly, b/c a deep copy is needed.
-         SatPassData& operator=(const SatPassData& right)
+            /// release unused capacity in every column
+         void shrink_to_fit()
          {
-            if (&right != this)
+            flags.shrink_to_fit();
+            userflags.shrink_to_fit();
+            ndts.shrink_to_fit();
+            toffsets.shrink_to_fit();
+            for (size_t k = 0; k < obs.size(); k++)
             {
-               flag     = right.flag;
-               userflag = right.userflag;
-               ndt      = right.ndt;
-               toffset  = right.toffset;
-               data.resize(right.data.size());
-               lli.resize(right.lli.size());
-               ssi.resize(right.ssi.size());
-               int i;
-               for (i = 0; i < right.data.size(); i++)
-                  data[i] = right.data[i];
-               for (i = 0; i < right.lli.size(); i++)
-                  lli[i] = right.lli[i];
-               for (i = 0; i < right.ssi.size(); i++)
-                  ssi[i] = right.ssi[i];
+               obs[k].shrink_to_fit();
+               llis[k].shrink_to_fit();
+               ssis[k].shrink_to_fit();
             }
+         }
+
+            /// remove all epochs, keeping the obs types
+         void clear() { resize(0); }
 
-            return *this;
+            /// bytes of heap storage held by the columns (capacity, not size)
+         size_t capacityBytes() const
+         {
+            size_t nb = flags.capacity() * sizeof(unsigned short) +
+                        userflags.capacity() * sizeof(unsigned int) +
+                        ndts.capacity() * sizeof(unsigned int) +
+                        toffsets.capacity() * sizeof(double);
+            for (size_t k = 0; k < obs.size(); k++)
+            {
+               nb += obs[k].capacity() * sizeof(double) +
+                     (llis[k].capacity() + ssis[k].capacity()) *
+                        sizeof(unsigned short);
+            }
+            return nb;
          }
-      }; // end struct SatPassData
+
+      private:
+            /**
+             a flag (cf. SatPass::BAD, etc.) that is set to OK at creation
+             then reset by other processing.
+            */
+         std::vector<unsigned short> flags;
+            /**
+             a flag for arbitrary use by the user; SatPass ONLY has
+             set/getUserFlag()
+            */
+         std::vector<unsigned int> userflags;
+            /// time 'count' : time of data = FirstTime + ndt * dt + offset
+         std::vector<unsigned int> ndts;
+            /// offset of time from integer number * dt since FirstTime.
+         std::vector<double> toffsets;
+            /// data, one array per obs type
+         std::vector<std::vector<double> > obs;
+            /**
+             loss-of-lock and signal-strength indicators (from RINEX), one
+             array per obs type, parallel to obs
+            */
+         std::vector<std::vector<unsigned short> > llis, ssis;
+      }; // end class SatPassStore
 
       // --------------- private member data -----------------------------
          /**
@@ -164,7 +322,7 @@ namespace gnsstk
 
          /**
           STL map relating strings identifying obs types with indexes in
-          SatPassData. E.g. index = indexForLabel[label].
+          SatPassStore. E.g. index = indexForLabel[label].
          */
       std::map<std::string, unsigned int> indexForLabel;
       std::map<unsigned int, std::string> labelForIndex;
@@ -181,8 +339,8 @@ namespace gnsstk
          /// number of timetags with good data in the data arrays.
       unsigned int ngood;
 
-         /// ALL data in the pass, stored in SatPassData objects, in time order
-      std::vector<SatPassData> spdvector;
+         /// ALL data in the pass, stored in columns, in time order
+      SatPassStore spdvector;
 
       // --------------- private member functions ------------------------
 
@@ -191,18 +349,14 @@ namespace gnsstk
                 std::vector<std::string> obstypes);
 
          /**
-          add a complete SatPassData at time tt
-          @return n>=0 if data was added successfully, n is the index of the new
-          data
+          add an epoch at time tt with the given flag; data, lli and ssi are
+          zero, to be filled by the caller
+          @return n>=0 if the epoch was added successfully, n is the index of
+          the new data
                      -1 if a gap is found (no data is added),
                      -2 if time tag is out of order (no data is added)
          */
-      int pushBack(const Epoch tt, SatPassData& spd);
-
-         /** get a complete SatPassData at count i
-          * @throw Exception
-          */
-      struct SatPassData getData(unsigned int i) const;
+      int pushBack(const Epoch tt, unsigned short flag);
 
    public:
       // ------------------ friends --------------------------------------
@@ -335,6 +489,25 @@ namespace gnsstk
          */
       int addData(const RinexObsData& robs);
 
+         /**
+          Add vectors of data, LLI and SSI at tt, all parallel to the obs types
+          given to the constructor (cf. getObsTypes()), so that no obs type
+          labels are looked up. Flag is set using input.
+          @param tt        the time tag of interest
+          @param data      a vector of data values, one per obs type
+          @param lli       a vector of LLI values, parallel to data
+          @param ssi       a vector of SSI values, parallel to data
+          @param flag      SatPass flag for this epoch (e.g. SatPass::BAD)
+          @return n>=0 if data was added successfully, n is the index of the new data
+                 -1 if a gap is found (no data is added),
+                 -2 if time tag is out of order (no data is added)
+          @throw Exception if the vector sizes do not match the obs types
+         */
+      int addData(const Epoch& tt, const std::vector<double>& data,
+                  const std::vector<unsigned short>& lli,
+                  const std::vector<unsigned short>& ssi,
+                  const unsigned short flag = SatPass::OK);
+
       // -------------------------- get and set routines
       // -------------------------- can change ssi, lli, data, but not
       // times,sat,dt,ngood,count get and set flag so you can update ngood
@@ -385,6 +558,50 @@ namespace gnsstk
          */
       unsigned short& SSI(unsigned int i, const std::string& type);
 
+      // Access by obs type handle (cf. obsIndex()); resolve the label once,
+      // outside of loops over the epochs, and use these inside.
+
+         /**
+          Access the data for one obs type at one index, as either l-value or
+          r-value
+          @param  i    index of the data of interest
+          @param  k    handle of the obs type, from obsIndex()
+          @return the data of the given type at the given index
+          @throw Exception
+         */
+      double& data(unsigned int i, unsigned int k);
+
+         /**
+          Access the LLI for one obs type at one index, as either l-value or
+          r-value
+          @param  i    index of the data of interest
+          @param  k    handle of the obs type, from obsIndex()
+          @return the LLI of the given type at the given index
+          @throw Exception
+         */
+      unsigned short& LLI(unsigned int i, unsigned int k);
+
+         /**
+          Access the SSI for one obs type at one index, as either l-value or
+          r-value
+          @param  i    index of the data of interest
+          @param  k    handle of the obs type, from obsIndex()
+          @return the SSI of the given type at the given index
+          @throw Exception
+         */
+      unsigned short& SSI(unsigned int i, unsigned int k);
+
+         /**
+          Access all the data for one obs type, in time order, as a contiguous
+          array of size() values, without copying. The pointer is invalidated
+          by anything that adds or removes data.
+          @param  k    handle of the obs type, from obsIndex()
+          @return pointer to the first value
+          @throw Exception
+         */
+      double *dataColumn(unsigned int k);
+      const double *dataColumn(unsigned int k) const;
+
       // -------------------------------- set only
       // --------------------------------
          /**
@@ -578,6 +795,19 @@ namespace gnsstk
          return (indexForLabel.find(type) != indexForLabel.end());
       }
 
+         /**
+          Get the handle of an obs type, for use with data(i,k), LLI(i,k),
+          SSI(i,k) and dataColumn(k).
+          @param  type observation type (e.g. "L1")
+          @return the handle, or -1 if this obs type was not passed to the c'tor
+         */
+      int obsIndex(const std::string& type) const
+      {
+         std::map<std::string, unsigned int>::const_iterator it;
+         it = indexForLabel.find(type);
+         return (it == indexForLabel.end() ? -1 : int(it->second));
+      }
+
          /// Access the obstypes (as strings)
       std::vector<std::string> getObstypes()
       {
@@ -83,6 +83,35 @@ namespace gnsstk
       FirstTime = SPList[0].getFirstTime();
       LastTime  = SPList[0].getLastTime();
 
+         /* convert the obs type labels to RinexObsType once here, rather than
+            for every satellite at every epoch in next(robs); passes that share
+            a list of labels share one table */
+      otIndex.resize(SPList.size());
+      for (i = 0; i < SPList.size(); i++)
+      {
+         for (j = 0; j < i; j++)
+         {
+            if (SPList[j].labelForIndex == SPList[i].labelForIndex)
+            {
+               otIndex[i] = otIndex[j];
+               break;
+            }
+         }
+         if (j < i)
+         {
+            continue;
+         }
+         otIndex[i] = otTables.size();
+         otTables.push_back(vector<RinexObsType>());
+         map<unsigned int, string>::const_iterator it;
+         for (it = SPList[i].labelForIndex.begin();
+              it != SPList[i].labelForIndex.end(); ++it)
+         {
+            otTables.back().push_back(
+               RinexObsHeader::convertObsType(it->second));
+         }
+      }
+
          // loop over the list
       for (i = 0; i < SPList.size(); i++)
       {
@@ -431,10 +460,12 @@ namespace gnsstk
 
          bool found = false;
          bool flag  = (SPList[i].spdvector[j].flag != SatPass::BAD);
-         for (int k = 0; k < SPList[i].labelForIndex.size(); k++)
+         const vector<RinexObsType>& ots(otTables[otIndex[i]]);
+         SatPass::SatPassStore::ConstRow spd(
+            static_cast<const SatPass&>(SPList[i]).spdvector[j]);
+         for (int k = 0; k < ots.size(); k++)
          {
-            RinexObsType ot;
-            ot = RinexObsHeader::convertObsType(SPList[i].labelForIndex[k]);
+            const RinexObsType& ot(ots[k]);
             if (ot == RinexObsHeader::UN)
             {
                ; // LOG(DEBUG1) << " Error - this sat has UN obstype"; // TD
@@ -449,9 +480,10 @@ namespace gnsstk
                      : 0.; robs.obs[sat][ot].lli  = flag ?
                      SPList[i].spdvector[j].lli[k] : 0; robs.obs[sat][ot].ssi  =
                      flag ? SPList[i].spdvector[j].ssi[k] : 0; */
-               robs.obs[sat][ot].data = SPList[i].spdvector[j].data[k];
-               robs.obs[sat][ot].lli  = SPList[i].spdvector[j].lli[k];
-               robs.obs[sat][ot].ssi  = SPList[i].spdvector[j].ssi[k];
+               RinexDatum& rd(robs.obs[sat][ot]);
+               rd.data = spd.data[k];
+               rd.lli  = spd.lli[k];
+               rd.ssi  = spd.ssi[k];
             }
          }
          if (found)
@@ -200,6 +200,15 @@ namespace gnsstk
          */
       std::map<unsigned int, unsigned int> nextIndexMap;
 
+         /**
+          distinct lists of obs types in SPList, converted to RinexObsType,
+          in the order of the SatPass data; used by next(RinexObsData&)
+         */
+      std::vector<std::vector<RinexObsType> > otTables;
+
+         /// vector parallel to SPList giving the index in otTables of each pass
+      std::vector<unsigned int> otIndex;
+
    }; // end class SatPassIterator
 
 } // namespace gnsstk
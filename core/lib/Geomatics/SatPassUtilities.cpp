@@ -301,6 +301,13 @@ namespace gnsstk
          for (i = 0; i < SPList.size(); i++)
             indexForSat[SPList[i].getSat()] = i;
 
+            /* obstypes converted to RinexObsType, once; and for each SatPass
+               already there, whether its obs types are NOT in the order of
+               obstypes, so data must be added by label */
+         vector<RinexObsType> rotypes;
+         const int nPrior(SPList.size());
+         vector<bool> byLabel(nPrior, false);
+
             // loop over file names
          for (int nfile = 0; nfile < filenames.size(); nfile++)
          {
@@ -350,6 +357,15 @@ namespace gnsstk
                lli  = vector<unsigned short>(obstypes.size(), 0);
             }
                // NB do not change obstypes past this, but may create newobstypes
+            if (rotypes.size() != obstypes.size())
+            {
+               rotypes.clear();
+               for (j = 0; j < obstypes.size(); j++)
+                  rotypes.push_back(
+                     RinexObsHeader::convertObsType(obstypes[j]));
+               for (j = 0; j < nPrior; j++)
+                  byLabel[j] = (SPList[j].getObsTypes() != obstypes);
+            }
 
                // loop over epochs in the file
             while (1)
@@ -503,8 +519,8 @@ namespace gnsstk
                      // loop over obs
                   for (j = 0; j < obstypes.size(); j++)
                   {
-                     if ((jt = it->second.find(RinexObsHeader::convertObsType(
-                             obstypes[j]))) == it->second.end())
+                     if ((jt = it->second.find(rotypes[j])) ==
+                         it->second.end())
                      {
                         data[j] = 0.0;
                         lli[j] = ssi[j] = 0;
@@ -540,8 +556,16 @@ namespace gnsstk
                      // add the data to the SatPass
                   do
                   {
-                     i = SPList[satit->second].addData(obsdata.time, obstypes,
-                                                       data, lli, ssi, flag);
+                     if (satit->second < nPrior && byLabel[satit->second])
+                     {
+                        i = SPList[satit->second].addData(
+                           obsdata.time, obstypes, data, lli, ssi, flag);
+                     }
+                     else
+                     { // data is parallel to the obs types of the SatPass
+                        i = SPList[satit->second].addData(obsdata.time, data,
+                                                          lli, ssi, flag);
+                     }
                      if (i == -1)
                      { // gap
                         SatPass newSP(sat, dtin, obstypes);
@@ -608,6 +632,10 @@ namespace gnsstk
                                   asString(dt, 2) + ")"));
          }
 
+            // release the extra room left by growing the columns
+         for (i = 0; i < SPList.size(); i++)
+            SPList[i].spdvector.shrink_to_fit();
+
          string msg = oss.str();
          if (!msg.empty())
          {
@@ -744,14 +772,15 @@ namespace gnsstk
                }
                SatID sat = SPList[ii].getSat();
                RinexObsData::RinexObsTypeMap rotm;
+               const bool good(SPList[ii].getFlag(jj) != SatPass::BAD);
                for (ngood = 0, j = 0; j < header.obsTypeList.size(); j++)
                {
                   RinexDatum rd;
+                  int k(good ? SPList[ii].obsIndex(obstypes[j]) : -1);
 
-                  if (SPList[ii].getFlag(jj) != SatPass::BAD &&
-                      SPList[ii].hasType(obstypes[j]))
+                  if (k >= 0)
                   {
-                     rd.data = SPList[ii].data(jj, obstypes[j]);
+                     rd.data = SPList[ii].data(jj, unsigned(k));
                      ngood++;
                   }
                      // else rd is all zeros
@@ -92,6 +92,7 @@
 
 #include "RobustStats.hpp"
 #include "Stats.hpp"
+#include <algorithm>
 #include <deque>
 #include <vector>
 //#include "StringUtils.hpp"       // TEMP
@@ -144,6 +145,14 @@ namespace gnsstk
          /// Subtract data from the statistics; in 1-sample stats the x is ignored
       virtual void Subtract(const T& x, const T& y) = 0;
 
+         /**
+          Add contiguous arrays of n data to the statistics; if flags is not
+          null, only data with flags[i]==0 are added. In 1-sample stats x is
+          ignored.
+         */
+      virtual void Add(const T *x, const T *y, size_t n,
+                       const int *flags = nullptr) = 0;
+
          /// return computed standard deviation, in 2-sample stats this is SigmaYX()
       virtual T StdDev() const = 0;
 
@@ -192,6 +201,12 @@ namespace gnsstk
          /// Subtract data from the statistics; in 1-sample stats the x is ignored
       void Subtract(const T& x, const T& y) { S.Subtract(y); }
 
+         /// Add arrays of data to the statistics; x is ignored
+      void Add(const T *x, const T *y, size_t n, const int *flags = nullptr)
+      {
+         S.Add(y, n, flags);
+      }
+
          /// return computed standard deviation
       T StdDev() const { return S.StdDev(); }
 
@@ -246,6 +261,18 @@ namespace gnsstk
          /// Subtract data from the statistics
       void Subtract(const T& x, const T& y) { TSS.Subtract(x, y); }
 
+         /// Add arrays of data to the statistics
+      void Add(const T *x, const T *y, size_t n, const int *flags = nullptr)
+      {
+         for (size_t i = 0; i < n; i++)
+         {
+            if (!flags || flags[i] == 0)
+            {
+               TSS.Add(x[i], y[i]);
+            }
+         }
+      }
+
          /// return computed standard deviation; in 2-sample stats this is SigmaYX()
       T StdDev() const
       {
@@ -558,17 +585,19 @@ namespace gnsstk
 
       // create stats for "past" and "future" sliding windows
       // ---------------------
+      OneSampleStatsFilter<T> oneSamplePast, oneSampleFuture;
+      TwoSampleStatsFilter<T> twoSamplePast, twoSampleFuture;
       StatsFilterBase<T> *ptrPast, *ptrFuture;
 
       if (twoSample)
       {
-         ptrPast   = new TwoSampleStatsFilter<T>();
-         ptrFuture = new TwoSampleStatsFilter<T>();
+         ptrPast   = &twoSamplePast;
+         ptrFuture = &twoSampleFuture;
       }
       else
       {
-         ptrPast   = new OneSampleStatsFilter<T>();
-         ptrFuture = new OneSampleStatsFilter<T>();
+         ptrPast   = &oneSamplePast;
+         ptrFuture = &oneSampleFuture;
       }
 
       // stick a little buffer, length buffsize, holding indexes, between past
@@ -627,6 +656,7 @@ namespace gnsstk
 
       // clear the analysis vector
       analvec.clear();
+      analvec.reserve(dsize);
 
 // try to make index handling clean and neat
 #define dvec(i) (data[i])
@@ -919,9 +949,6 @@ namespace gnsstk
 
       } // end loop over all data
 
-      delete ptrPast;
-      delete ptrFuture;
-
 #undef xvec
 #undef dvec
 #undef inc
@@ -1130,8 +1157,47 @@ namespace gnsstk
          double weight = (rmax ? 0.25 : 0) + (smin ? 0.25 : 0) +
                          0.5 * fmpcount / double(2 * halfwidth);
 
+         // tests 1a-1c below reject the point before it is scored; decide
+         // that here, once, so the deque dump can be skipped for them
+         enum { NotRejected, SmallRatio, SmallStep, Begin, End, Marginal }
+            reject(NotRejected);
+         // test 1a. ratio must be > minratio(2)
+         if (::fabs(analvec[i].step / analvec[i].sigma) <= minratio)
+         {
+            reject = SmallRatio;
+         }
+         // test 1b. step must be > 0.8
+         else if (::fabs(analvec[i].step) < minstep)
+         {
+            reject = SmallStep;
+         }
+         // its too early - before we can compute score
+         // usually ratio|step will be small, so not reach here
+         else if (i == 0)
+         {
+            reject = Begin;
+         }
+         // approaching the end
+         else if (i == analvec.size() - 1)
+         {
+            reject = End;
+         }
+         // test 1c. exclude case where step AND ratio are very close to limit
+         else if (::fabs(analvec[i].step / analvec[i].sigma) / minratio +
+                     ::fabs(analvec[i].step) / minstep - 2. <
+                  minmargin)
+         {
+            reject = Marginal;
+         }
+
          // dump all the deque to a string, for debug and dumpAnalMsg (verbose)
-         // output
+         // output; only needed if debugging or if the point is scored
+         const bool needmsg(debug || reject == NotRejected);
+         ratmsg.clear();
+         sigmsg.clear();
+         fmpmsg.clear();
+         wtmsg.clear();
+         if (needmsg)
          {
             std::ostringstream oss;
             oss << " F-P" << std::fixed << std::setprecision(3);
@@ -1190,7 +1256,7 @@ namespace gnsstk
 
          // ---------------------- do the tests ----------------------
          // test 1a. ratio must be > minratio(2)
-         if (::fabs(analvec[i].step / analvec[i].sigma) <= minratio)
+         if (reject == SmallRatio)
          {
             if (debug)
             {
@@ -1201,7 +1267,7 @@ namespace gnsstk
          }
 
          // test 1b. step must be > 0.8
-         else if (::fabs(analvec[i].step) < minstep)
+         else if (reject == SmallStep)
          {
             if (debug)
             {
@@ -1213,7 +1279,7 @@ namespace gnsstk
 
          // its too early - before we can compute score
          // usually ratio|step will be small, so not reach here
-         else if (i == 0)
+         else if (reject == Begin)
          {
             if (debug)
             {
@@ -1224,7 +1290,7 @@ namespace gnsstk
          }
 
          // approaching the end
-         else if (i == analvec.size() - 1)
+         else if (reject == End)
          {
             if (debug)
             {
@@ -1235,9 +1301,7 @@ namespace gnsstk
          }
 
          // test 1c. exclude case where step AND ratio are very close to limit
-         else if (::fabs(analvec[i].step / analvec[i].sigma) / minratio +
-                     ::fabs(analvec[i].step) / minstep - 2. <
-                  minmargin)
+         else if (reject == Marginal)
          {
             if (debug)
             {
@@ -1453,26 +1517,22 @@ namespace gnsstk
          return;
       }
 
-      bool notfound(true);
-      for (i = 0; i < analvec.size(); i++)
-      {
-         if (analvec[i].index == sg.index)
-         {
-            j        = i;
-            notfound = false;
-            break;
-         }
-      }
-      if (notfound)
+      // analvec is sorted on index, so use a binary search
+      typename std::vector<Analysis>::const_iterator it(std::lower_bound(
+         analvec.begin(), analvec.end(), sg.index,
+         [](const Analysis& A, unsigned int ind) { return A.index < ind; }));
+      if (it == analvec.end() || it->index != sg.index)
       {
          return;
       }
+      j = it - analvec.begin();
 
       // stats on sigma       // TD would like the same for step....how to
       // implement
       bool first(true);
       T sd;
       std::vector<T> sdv;
+      sdv.reserve(sg.ngood);
       for (i = 0; i < sg.ngood; i++)
       {
          if (skip)
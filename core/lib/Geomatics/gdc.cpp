@@ -44,6 +44,9 @@
     RinexEditor).
 */
 
+#include <atomic>
+#include <exception>
+#include <thread>
 #include "gdc.hpp"
 #include "GNSSconstants.hpp"
 #include "logstream.hpp"
@@ -179,8 +182,29 @@ namespace gnsstk
          outfmt    = SP.getOutputFormat();
          Epoch beg = SP.getFirstTime();
 
+            // resolve the obs types once, then read the data columns directly
+         const int kL1(SP.obsIndex(L1)), kL2(SP.obsIndex(L2)),
+            kP1(SP.obsIndex(P1)), kP2(SP.obsIndex(P2));
+         if (SP.size() > 0 && (kL1 < 0 || kL2 < 0 || kP1 < 0 || kP2 < 0))
+         {
+            Exception e("Invalid obs type in data(): require " + L1 + " " +
+                        L2 + " " + P1 + " " + P2);
+            GNSSTK_THROW(e);
+         }
+         const SatPass& cSP(SP);
+         const double *pL1(SP.size() ? cSP.dataColumn(kL1) : NULL),
+            *pL2(SP.size() ? cSP.dataColumn(kL2) : NULL),
+            *pP1(SP.size() ? cSP.dataColumn(kP1) : NULL),
+            *pP2(SP.size() ? cSP.dataColumn(kP2) : NULL);
+
          vector<double> L1_in, L2_in, P1_in, P2_in, dt_in;
          vector<int> flags_in;
+         L1_in.reserve(SP.size());
+         L2_in.reserve(SP.size());
+         P1_in.reserve(SP.size());
+         P2_in.reserve(SP.size());
+         dt_in.reserve(SP.size());
+         flags_in.reserve(SP.size());
 
             // loop over the pass - MUST keep flags_in, dt_in, arrays all parallel
          for (unsigned int i = 0; i < SP.size(); i++)
@@ -191,9 +215,8 @@ namespace gnsstk
 
                // test for good data
                // must consistently mark bad data in SP with SatPass::BAD
-            if (!(SP.spdvector[i].flag & SatPass::OK) ||
-                SP.data(i, L1) == 0.0 || SP.data(i, L2) == 0.0 ||
-                SP.data(i, P1) == 0.0 || SP.data(i, P2) == 0.0)
+            if (!(SP.spdvector[i].flag & SatPass::OK) || pL1[i] == 0.0 ||
+                pL2[i] == 0.0 || pP1[i] == 0.0 || pP2[i] == 0.0)
             {
                flags_in.push_back(0); // 0 bad - as in SatPass
                L1_in.push_back(0.0);
@@ -205,10 +228,10 @@ namespace gnsstk
 
                // good data
             flags_in.push_back(1); // 1 good data - as in SatPass
-            L1_in.push_back(SP.data(i, L1));
-            L2_in.push_back(SP.data(i, L2));
-            P1_in.push_back(SP.data(i, P1));
-            P2_in.push_back(SP.data(i, P2));
+            L1_in.push_back(pL1[i]);
+            L2_in.push_back(pL2[i]);
+            P1_in.push_back(pP1[i]);
+            P2_in.push_back(pP2[i]);
          }
 
             // save the first GDC output line from SatPass (SPS)
@@ -240,6 +263,127 @@ namespace gnsstk
       }
    } // end int gdc::DiscontinuityCorrector(SatPass& SP, string& retMsg, int GLOn)
 
+   //---------------------------------------------------------------------------------
+      /* Call to DC for a collection of SatPass, using a pool of threads.
+         Each pass is processed by a new copy of this gdc, so the results do not
+         depend on which thread processes it, or on which passes that thread
+         processed before. */
+   int gdc::DiscontinuityCorrector(vector<SatPass>& SPs, vector<string>& retMsgs,
+                                   vector<vector<string>>& cmds,
+                                   vector<int>& irets, unsigned nThreads,
+                                   const vector<int>& GLOn)
+   {
+      try
+      {
+         const size_t npass(SPs.size());
+         if (!GLOn.empty() && GLOn.size() != npass)
+         {
+            GNSSTK_THROW(Exception("GLOn is not parallel to SatPass vector"));
+         }
+
+         retMsgs = vector<string>(npass);
+         cmds    = vector<vector<string>>(npass);
+         irets   = vector<int>(npass, 0);
+         if (npass == 0)
+         {
+            return 0;
+         }
+
+         if (nThreads == 0)
+         {
+            nThreads = std::thread::hardware_concurrency();
+         }
+         if (nThreads > npass)
+         {
+            nThreads = npass;
+         }
+
+            // pass i is given the unique number it would get in a sequential run
+         const int unique0(unique);
+         unique += npass;
+
+            // log output of each pass, written in order at the end
+         ostream *plog(pLOGstrm);
+         const bool collect(nThreads > 1 && plog != nullptr);
+         vector<string> logs(collect ? npass : 0);
+         vector<std::exception_ptr> errors(npass);
+
+         std::atomic<size_t> nextPass(0);
+         auto worker = [&]()
+         {
+            for (size_t i = nextPass++; i < npass; i = nextPass++)
+            {
+               ostringstream oss;
+               if (collect)
+               {
+                  ConfigureLOGstream::ThreadStream() = &oss;
+               }
+               try
+               {
+                  gdc pass(*this);
+                  pass.ForceUniqueNumber(unique0 + i);
+                  irets[i] = pass.DiscontinuityCorrector(
+                     SPs[i], retMsgs[i], cmds[i],
+                     (GLOn.empty() ? -99 : GLOn[i]));
+               }
+               catch (...)
+               {
+                  errors[i] = std::current_exception();
+               }
+               if (collect)
+               {
+                  ConfigureLOGstream::ThreadStream() = nullptr;
+                  logs[i] = oss.str();
+               }
+            }
+         };
+
+         if (nThreads <= 1)
+         {
+            worker();
+         }
+         else
+         {
+            vector<std::thread> threads;
+            for (unsigned t = 0; t < nThreads; t++)
+            {
+               threads.emplace_back(worker);
+            }
+            for (auto& thr : threads)
+            {
+               thr.join();
+            }
+         }
+
+         int nok(0);
+         for (size_t i = 0; i < npass; i++)
+         {
+            if (collect)
+            {
+               *plog << logs[i];
+            }
+            if (errors[i])
+            {
+               std::rethrow_exception(errors[i]);
+            }
+            if (irets[i] == 0)
+            {
+               nok++;
+            }
+         }
+         if (collect)
+         {
+            *plog << flush;
+         }
+
+         return nok;
+      }
+      catch (Exception& e)
+      {
+         GNSSTK_RETHROW(e);
+      }
+   } // end int gdc::DiscontinuityCorrector(vector<SatPass>& SPs, ...)
+
    //---------------------------------------------------------------------------------
       /* Call to DC without SatPass.
          Flags on input must be either 1(OK) or 0(BAD), as in SatPass */
@@ -1005,51 +1149,52 @@ namespace gnsstk
          param which is either WL or GF */
    void gdc::getArcStats(map<int, Arc>::iterator& ait, const unsigned which)
    {
-      StatsFilterBase<double> *ptrStats = nullptr;
       try
       {
          bool isWL(which == WL);
-         int i, index, npts;
-         map<int, Arc>::iterator cit(ait);
-
+         OneSampleStatsFilter<double> oneSample;
+         TwoSampleStatsFilter<double> twoSample;
+         StatsFilterBase<double> *ptrStats(&twoSample);
          if (isWL)
          {
-            ptrStats = new OneSampleStatsFilter<double>();
-         }
-         else
-         {
-            ptrStats = new TwoSampleStatsFilter<double>();
+            ptrStats = &oneSample;
          }
-         i = index = cit->second.index;
-         npts      = cit->second.npts;
+         const vector<double>& data(isWL ? dataWL : dataGF);
+         const size_t size(xdata.size());
+         map<int, Arc>::iterator cit(ait);
 
-            // loop over continuous data in the arc
-         while (cit != Arcs.end() && i < xdata.size())
+            // loop over the continuous data in the arc, one arc at a time
+         while (cit != Arcs.end())
          {
+            size_t index(cit->second.index);
+            if (index >= size)
+            {
+               break;
+            }
+            size_t npts(std::min<size_t>(cit->second.npts, size - index));
+
                // add to stats (xdata is ignored in OneSampleStats)
                // don't include bad data, unless this is a REJ arc...
-            if (flags[i] == OK || cit->second.mark == Arc::REJ)
+            ptrStats->Add(&xdata[index], &data[index], npts,
+                          (cit->second.mark == Arc::REJ ? nullptr
+                                                        : &flags[index]));
+            if (index + npts < index + cit->second.npts) // reached end of data
             {
-               ptrStats->Add(xdata[i], (isWL ? dataWL[i] : dataGF[i]));
+               break;
             }
-            i++;
-            if (i == index + npts)
-            {                         // reached end of Arc
-               cit++;                 // go to the next one..
-               if (cit == Arcs.end()) // ..unless there isn't one
-               {
-                  break;
-               }
-               if (!(cit->second.mark & SLIP[which])) // ..or its not a slip
-               {
-                  break;
-               }
-               if (!(cit->second.mark & FIX[which])) // ..or its not been fixed
-               {
-                  break;
-               }
-               index = cit->second.index;
-               npts  = cit->second.npts;
+
+            cit++;                 // go to the next one..
+            if (cit == Arcs.end()) // ..unless there isn't one
+            {
+               break;
+            }
+            if (!(cit->second.mark & SLIP[which])) // ..or its not a slip
+            {
+               break;
+            }
+            if (!(cit->second.mark & FIX[which])) // ..or its not been fixed
+            {
+               break;
             }
          }
 
@@ -1062,10 +1207,8 @@ namespace gnsstk
       }
       catch (Exception& e)
       {
-         delete ptrStats;
          GNSSTK_RETHROW(e);
       }
-      delete ptrStats;
    } // end void gdc::getArcStats()
 
    //---------------------------------------------------------------------------------
@@ -1197,8 +1340,8 @@ namespace gnsstk
          int i, nslips(0);
          long N;
          double step, istep;
-         static const double GFfactor(wl2 / wlGF);
-         static const double IFfactor(
+         const double GFfactor(wl2 / wlGF);
+         const double IFfactor(
             isGLO ? 3.5 : 3.52941176470588); // TD what is this?
 
             // loop over Arcs using iterator ait //, with dummy copy cit
@@ -1608,6 +1751,8 @@ namespace gnsstk
 
          double dL1, dL2; // just double versions of nL1, nL2
          const string L1("L1"), L2("L2");
+            // obs type handles, resolved once; -1 fails in SP.data() below
+         const unsigned int kL1(SP.obsIndex(L1)), kL2(SP.obsIndex(L2));
 
          nL1 = nL2 = 0; // running total slip
          ait       = Arcs.begin();
@@ -1682,11 +1827,11 @@ namespace gnsstk
             {
                if (nL1)
                {
-                  SP.data(i, L1) -= dL1;
+                  SP.data(i, kL1) -= dL1;
                }
                if (nL2)
                {
-                  SP.data(i, L2) -= dL2;
+                  SP.data(i, kL2) -= dL2;
                }
             }
          } // end loop over data in SP
@@ -1711,7 +1856,7 @@ namespace gnsstk
          long long nGF, nWL, nL1, nL2;
          Epoch ttag, tbeg, tend;
          map<int, Arc>::iterator ait;
-         static const string L1(cfg(doRINEX3) ? "L1C" : "L1"),
+         const string L1(cfg(doRINEX3) ? "L1C" : "L1"),
             L2(cfg(doRINEX3) ? "L2W" : "L2");
 
             // generate commands
@@ -484,6 +484,37 @@ namespace gnsstk
          std::vector<std::string>& cmds, int GLOn = -99,
          std::string outfmt = std::string("%4F %10.3g"));
 
+      //---------------------------------------------------------------------------
+         /**
+          Overloaded version that processes a collection of SatPass, e.g. all
+          the passes of a station-day, using a pool of threads. Each pass is
+          processed, exactly as by the SatPass version, by its own copy of this
+          gdc, and the passes are given unique numbers in order, as if they
+          were processed one after the other; on return getUniqueNumber() is as
+          if they had been. The log output of each pass is collected and
+          written to the log stream in pass order once all the passes are done.
+          Thus neither the results nor the output depend on the number of
+          threads.
+          @param SPs      SatPass objects containing the input data; each is
+                          modified as by the SatPass version.
+          @param retMsgs  output, parallel to SPs: string summary of results
+          @param cmds     output, parallel to SPs: editing commands
+          @param irets    output, parallel to SPs: return value for each pass
+          @param nThreads number of threads; 0 means one per hardware thread.
+          @param GLOn     GLONASS frequency channels, parallel to SPs; if empty,
+                          -99 (UNKNOWN) for all passes.
+          @return the number of passes for which the return value is 0.
+          @throw Exception if the processing of a pass throws; the exception
+                 of the first such pass is rethrown, after all are done.
+         */
+      int DiscontinuityCorrector(std::vector<SatPass>& SPs,
+                                 std::vector<std::string>& retMsgs,
+                                 std::vector<std::vector<std::string>>& cmds,
+                                 std::vector<int>& irets,
+                                 unsigned nThreads = 0,
+                                 const std::vector<int>& GLOn =
+                                    std::vector<int>());
+
    private:
          /// helper routine to initialize vectors
       static std::vector<unsigned> create_vector_SLIP()
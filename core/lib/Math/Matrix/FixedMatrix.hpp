@@ -0,0 +1,543 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FixedMatrix.hpp
+ * Matrix with its dimensions fixed at compile time, and the
+ * decompositions and inverses for small square FixedMatrix.
+ */
+
+#ifndef GNSSTK_FIXEDMATRIX_HPP
+#define GNSSTK_FIXEDMATRIX_HPP
+
+#include "Matrix.hpp"
+#include "FixedVector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A R x C matrix of type T where R and C are fixed at compile
+       * time. The elements are stored in the object itself in row
+       * major order, so FixedMatrix never allocates and the loops
+       * over it have constant bounds. Use it for the small rotations,
+       * covariances and normal matrices (3x3, 4x4, 6x6...) where the
+       * heap allocation in Matrix<T> costs more than the arithmetic.
+       *
+       * FixedMatrix is a RefMatrixBase, so all the general Matrix
+       * operators and functors (SVD, Householder, ...) accept it and
+       * return a Matrix<T>. The operators, functors and inverses
+       * declared below that take only FixedMatrix/FixedVector
+       * arguments return fixed types.
+       */
+   template <class T, size_t R, size_t C>
+   class FixedMatrix : public RefMatrixBase<T, FixedMatrix<T,R,C> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor, all elements zero.
+      FixedMatrix()
+      {
+         for (size_t i = 0; i < R*C; i++)
+            m[i] = T(0);
+      }
+
+         /// Constructor with all elements set to initialValue.
+      explicit FixedMatrix(const T initialValue)
+      {
+         for (size_t i = 0; i < R*C; i++)
+            m[i] = initialValue;
+      }
+
+         /**
+          * Copy constructor from a ConstMatrixBase type.
+          * @throw MatrixException if the dimensions are not R x C
+          */
+      template <class E>
+      FixedMatrix(const ConstMatrixBase<T, E>& mat)
+      {
+         if ((mat.rows() != R) || (mat.cols() != C))
+         {
+            MatrixException e("Invalid dimensions for FixedMatrix(ConstMatrixBase)");
+            GNSSTK_THROW(e);
+         }
+         for (size_t i = 0; i < R; i++)
+            for (size_t j = 0; j < C; j++)
+               m[i*C+j] = mat(i,j);
+      }
+
+         /// STL iterator begin
+      iterator begin() { return m; }
+         /// STL const iterator begin
+      const_iterator begin() const { return m; }
+         /// STL iterator end
+      iterator end() { return m + R*C; }
+         /// STL const iterator end
+      const_iterator end() const { return m + R*C; }
+         /// STL size
+      constexpr size_t size() const { return R*C; }
+         /// The number of rows in the matrix
+      constexpr size_t rows() const { return R; }
+         /// The number of columns in the matrix
+      constexpr size_t cols() const { return C; }
+         /// Pointer to the R*C contiguous elements, row major.
+      T* data() { return m; }
+         /// Pointer to the R*C contiguous elements, row major.
+      const T* data() const { return m; }
+
+         /// Non-const matrix operator(row, col)
+      T& operator() (size_t rowNum, size_t colNum)
+      { return m[rowNum*C + colNum]; }
+         /// Const matrix operator(row, col)
+      T operator() (size_t rowNum, size_t colNum) const
+      { return m[rowNum*C + colNum]; }
+
+         /**
+          * Assign from any matrix of the same dimensions.
+          * @throw MatrixException if the dimensions are not R x C
+          */
+      template <class E>
+      FixedMatrix& operator=(const ConstMatrixBase<T, E>& mat)
+      {
+         if ((mat.rows() != R) || (mat.cols() != C))
+         {
+            MatrixException e("Invalid dimensions for FixedMatrix assignment");
+            GNSSTK_THROW(e);
+         }
+         return this->assignFrom(mat);
+      }
+         /// Set all the elements to t.
+      FixedMatrix& operator=(const T t)
+      { return this->assignFrom(t); }
+
+         /// Swaps rows row1 and row2 in this matrix.
+      FixedMatrix& swapRows(size_t row1, size_t row2)
+      {
+         for (size_t j = 0; j < C; j++)
+         {
+            T temp = m[row1*C+j];
+            m[row1*C+j] = m[row2*C+j];
+            m[row2*C+j] = temp;
+         }
+         return *this;
+      }
+
+         /// Copy of row i.
+      FixedVector<T,C> rowCopy(size_t i) const
+      {
+         FixedVector<T,C> toReturn;
+         for (size_t j = 0; j < C; j++)
+            toReturn[j] = m[i*C+j];
+         return toReturn;
+      }
+         /// Copy of column j.
+      FixedVector<T,R> colCopy(size_t j) const
+      {
+         FixedVector<T,R> toReturn;
+         for (size_t i = 0; i < R; i++)
+            toReturn[i] = m[i*C+j];
+         return toReturn;
+      }
+
+         /// Convert to a Matrix<T>.
+      Matrix<T> toMatrix() const
+      { return Matrix<T>(*this); }
+
+         /// The N x N identity matrix; only valid when R == C.
+      static FixedMatrix identity()
+      {
+         static_assert(R == C, "identity() requires a square FixedMatrix");
+         FixedMatrix toReturn;
+         for (size_t i = 0; i < R; i++)
+            toReturn.m[i*C+i] = T(1);
+         return toReturn;
+      }
+
+   private:
+         /// the data, row major
+      T m[R*C];
+   };
+
+      /// FixedMatrix * FixedMatrix : row by column multiplication.
+   template <class T, size_t R, size_t K, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,K>& l,
+                                       const FixedMatrix<T,K,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+         {
+            T sum(l(i,0)*r(0,j));
+            for (size_t k = 1; k < K; k++)
+               sum += l(i,k)*r(k,j);
+            toReturn(i,j) = sum;
+         }
+      return toReturn;
+   }
+
+      /// FixedMatrix * FixedVector : matrix times column vector.
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,R> operator*(const FixedMatrix<T,R,C>& m,
+                                     const FixedVector<T,C>& v)
+   {
+      FixedVector<T,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+      {
+         T sum(m(i,0)*v[0]);
+         for (size_t j = 1; j < C; j++)
+            sum += m(i,j)*v[j];
+         toReturn[i] = sum;
+      }
+      return toReturn;
+   }
+
+      /// FixedVector * FixedMatrix : row vector times matrix.
+   template <class T, size_t R, size_t C>
+   inline FixedVector<T,C> operator*(const FixedVector<T,R>& v,
+                                     const FixedMatrix<T,R,C>& m)
+   {
+      FixedVector<T,C> toReturn;
+      for (size_t j = 0; j < C; j++)
+      {
+         T sum(v[0]*m(0,j));
+         for (size_t i = 1; i < R; i++)
+            sum += v[i]*m(i,j);
+         toReturn[j] = sum;
+      }
+      return toReturn;
+   }
+
+      /// Element by element sum of two FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator+(const FixedMatrix<T,R,C>& l,
+                                       const FixedMatrix<T,R,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn(l);
+      for (size_t i = 0; i < R*C; i++)
+         toReturn.data()[i] += r.data()[i];
+      return toReturn;
+   }
+
+      /// Element by element difference of two FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator-(const FixedMatrix<T,R,C>& l,
+                                       const FixedMatrix<T,R,C>& r)
+   {
+      FixedMatrix<T,R,C> toReturn(l);
+      for (size_t i = 0; i < R*C; i++)
+         toReturn.data()[i] -= r.data()[i];
+      return toReturn;
+   }
+
+      /// FixedMatrix times a scalar
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const FixedMatrix<T,R,C>& m, const T d)
+   {
+      FixedMatrix<T,R,C> toReturn(m);
+      for (size_t i = 0; i < R*C; i++)
+         toReturn.data()[i] *= d;
+      return toReturn;
+   }
+
+      /// Scalar times a FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,R,C> operator*(const T d, const FixedMatrix<T,R,C>& m)
+   { return m * d; }
+
+      /// Transpose of a FixedMatrix
+   template <class T, size_t R, size_t C>
+   inline FixedMatrix<T,C,R> transpose(const FixedMatrix<T,R,C>& m)
+   {
+      FixedMatrix<T,C,R> toReturn;
+      for (size_t i = 0; i < R; i++)
+         for (size_t j = 0; j < C; j++)
+            toReturn(j,i) = m(i,j);
+      return toReturn;
+   }
+
+      /** LU decomposition PA = LU of a square FixedMatrix; the same
+       * algorithm (Crout with implicit row scaling) and interface
+       * as LUDecomp, with fixed storage for LU and Pivot. */
+   template <class T, size_t N>
+   class FixedLUDecomp
+   {
+   public:
+      FixedLUDecomp() : parity(1) {}
+
+         /** Does the decomposition.
+          * @throw SingularMatrixException if m is singular
+          */
+      void operator() (const FixedMatrix<T,N,N>& m)
+      {
+         size_t i,j,k,imax(0);
+         T big,t,d;
+         T V[N];
+
+         LU = m;
+         parity = 1;
+
+         for(i=0; i<N; i++) {    // get scale of each row
+            big = T(0);
+            for(j=0; j<N; j++) {
+               t = ABS(LU(i,j));
+               if(t > big) big=t;
+            }
+            if(big <= T(0)) {    // m is singular
+               SingularMatrixException e("singular matrix!");
+               GNSSTK_THROW(e);
+            }
+            V[i] = T(1)/big;
+         }
+
+         for(j=0; j<N; j++) {    // loop over columns
+            for(i=0; i<j; i++) {
+               t = LU(i,j);
+               for(k=0; k<i; k++) t -= LU(i,k)*LU(k,j);
+               LU(i,j) = t;
+            }
+            big = T(0);          // find largest pivot
+            for(i=j; i<N; i++) {
+               t = LU(i,j);
+               for(k=0; k<j; k++) t -= LU(i,k)*LU(k,j);
+               LU(i,j) = t;
+               d = V[i]*ABS(t);
+               if(d >= big) {
+                  big = d;
+                  imax = i;
+               }
+            }
+            if(j != imax) {
+               LU.swapRows(imax,j);
+               V[imax] = V[j];
+               parity = -parity;
+            }
+            Pivot[j] = imax;
+
+            t = LU(j,j);
+            if(t == 0.0) {       // m is singular
+               SingularMatrixException e("singular matrix!");
+               GNSSTK_THROW(e);
+            }
+            if(j != N-1) {
+               d = T(1)/t;
+               for(i=j+1; i<N; i++) LU(i,j) *= d;
+            }
+         }
+      }
+
+         /** Compute inverse(m)*v, where *this is LUD(m), via back
+          * substitution. The solution overwrites v. */
+      void backSub(FixedVector<T,N>& v) const
+      {
+         bool first=true;
+         size_t i,j,ii(0);
+         T sum;
+
+            // un-pivot
+         for(i=0; i<N; i++) {
+            sum = v(Pivot[i]);
+            v(Pivot[i]) = v(i);
+            if(first && sum != T(0)) {
+               ii = i;
+               first = false;
+            }
+            else for(j=ii; j<i; j++) sum -= LU(i,j)*v(j);
+            v(i) = sum;
+         }
+            // back substitution
+         for(i=N-1; ; i--) {
+            sum = v(i);
+            for(j=i+1; j<N; j++) sum -= LU(i,j)*v(j);
+            v(i) = sum / LU(i,i);
+            if(i == 0) break;       // b/c i is unsigned
+         }
+      }
+
+         /// compute determinant from LUD
+      T det() const
+      {
+         T d(static_cast<T>(parity));
+         for(size_t i=0; i<N; i++) d *= LU(i,i);
+         return d;
+      }
+
+         /// The matrix in LU-decomposed form: L and U together;
+         /// all diagonal elements of L are implied 1.
+      FixedMatrix<T,N,N> LU;
+         /// The pivot array
+      size_t Pivot[N];
+         /// Parity
+      int parity;
+   }; // end class FixedLUDecomp
+
+      /** Cholesky decomposition m = L*transpose(L) of a square,
+       * symmetric, positive definite FixedMatrix, computed with the
+       * Cholesky-Crout algorithm as in CholeskyCrout. Only L is
+       * computed. */
+   template <class T, size_t N>
+   class FixedCholesky
+   {
+   public:
+      FixedCholesky() {}
+
+         /** Does the decomposition.
+          * @throw MatrixException if m is not positive definite
+          */
+      void operator() (const FixedMatrix<T,N,N>& m)
+      {
+         size_t i,j,k;
+         T sum;
+         L = T(0);
+         for(j=0; j<N; j++) {
+            sum = m(j,j);
+            for(k=0; k<j; k++) sum -= L(j,k)*L(j,k);
+            if(sum <= T(0)) {
+               MatrixException e("Cholesky fails - eigenvalue <= 0");
+               GNSSTK_THROW(e);
+            }
+            L(j,j) = SQRT(sum);
+            for(i=j+1; i<N; i++) {
+               sum = m(i,j);
+               for(k=0; k<j; k++) sum -= L(i,k)*L(j,k);
+               L(i,j) = sum/L(j,j);
+            }
+         }
+      }
+
+         /** Solve A*x=b where A = L*transpose(L) has been
+          * decomposed by *this; x is returned as b. */
+      void backSub(FixedVector<T,N>& b) const
+      {
+         size_t i,j;
+         for(i=0; i<N; i++) {
+            for(j=0; j<i; j++) b(i) -= L(i,j)*b(j);
+            b(i) /= L(i,i);
+         }
+         for(i=N-1; ; i--) {
+            for(j=i+1; j<N; j++) b(i) -= L(j,i)*b(j);
+            b(i) /= L(i,i);
+            if(i==0) break;
+         }
+      }
+
+         /// Lower triangular Cholesky decomposition
+      FixedMatrix<T,N,N> L;
+   }; // end class FixedCholesky
+
+      /**
+       * Inverts the square FixedMatrix m using LU decomposition.
+       * @throw SingularMatrixException if m is singular
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseLUD(const FixedMatrix<T,N,N>& m)
+   {
+      FixedLUDecomp<T,N> LUD;
+      LUD(m);
+      FixedMatrix<T,N,N> inv;
+      for(size_t j=0; j<N; j++) {
+         FixedVector<T,N> col;
+         col[j] = T(1);
+         LUD.backSub(col);
+         for(size_t i=0; i<N; i++) inv(i,j) = col[i];
+      }
+      return inv;
+   }
+
+      /**
+       * Inverts the square FixedMatrix m using LU decomposition, and
+       * returns its determinant in determ.
+       * @throw SingularMatrixException if m is singular
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseLUD(const FixedMatrix<T,N,N>& m, T& determ)
+   {
+      FixedLUDecomp<T,N> LUD;
+      LUD(m);
+      determ = LUD.det();
+      FixedMatrix<T,N,N> inv;
+      for(size_t j=0; j<N; j++) {
+         FixedVector<T,N> col;
+         col[j] = T(1);
+         LUD.backSub(col);
+         for(size_t i=0; i<N; i++) inv(i,j) = col[i];
+      }
+      return inv;
+   }
+
+      /**
+       * Inverts the square, symmetric, positive definite FixedMatrix
+       * m using the Cholesky decomposition: inverse(m) =
+       * transpose(inverse(L))*inverse(L).
+       * @throw MatrixException if m is not positive definite
+       */
+   template <class T, size_t N>
+   inline FixedMatrix<T,N,N> inverseChol(const FixedMatrix<T,N,N>& m)
+   {
+      FixedCholesky<T,N> CC;
+      CC(m);
+      size_t i,j,k;
+      T sum;
+      FixedMatrix<T,N,N> LI;     // inverse of L, lower triangular
+      for(i=0; i<N; i++) {
+         LI(i,i) = T(1) / CC.L(i,i);
+         for(j=0; j<i; j++) {
+            sum = T(0);
+            for(k=j; k<i; k++) sum += CC.L(i,k)*LI(k,j);
+            LI(i,j) = -sum*LI(i,i);
+         }
+      }
+      return transpose(LI) * LI;
+   }
+
+      //@}
+
+}  // namespace gnsstk
+
+#endif
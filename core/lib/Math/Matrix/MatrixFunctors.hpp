@@ -45,9 +45,119 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include "MatrixKernels.hpp"
 
 namespace gnsstk
 {
+      /// @cond
+      // Glue between the Matrix operators and functors and
+      // MatrixKernels. Each returns false, doing nothing, unless T is
+      // double and MatrixKernels::use() is true for the dimensions,
+      // in which case it does the whole computation.
+
+      /// Contiguous column-major data of m, copied into copy if needed.
+   inline const double *kernelData(const Matrix<double>& m, Matrix<double>&)
+   { return m.begin(); }
+
+   template <class BaseClass>
+   inline const double *kernelData(const ConstMatrixBase<double, BaseClass>& m,
+                                   Matrix<double>& copy)
+   {
+      copy = Matrix<double>(m);
+      return copy.begin();
+   }
+
+   template <class T, class BaseClass1, class BaseClass2>
+   inline bool kernelMultiply(const ConstMatrixBase<T, BaseClass1>&,
+                              const ConstMatrixBase<T, BaseClass2>&,
+                              Matrix<T>&)
+   { return false; }
+
+      // out must be zero on input
+   template <class BaseClass1, class BaseClass2>
+   inline bool kernelMultiply(const ConstMatrixBase<double, BaseClass1>& l,
+                              const ConstMatrixBase<double, BaseClass2>& r,
+                              Matrix<double>& out)
+   {
+      if(!MatrixKernels::use(l.rows(), r.cols(), l.cols()))
+         return false;
+      Matrix<double> lcopy, rcopy;
+      const double *lp = kernelData(static_cast<const BaseClass1&>(l), lcopy);
+      const double *rp = kernelData(static_cast<const BaseClass2&>(r), rcopy);
+      MatrixKernels::gemm(l.rows(), r.cols(), l.cols(), 1.0,
+                          lp, 1, l.rows(), rp, 1, r.rows(),
+                          out.begin(), out.rows());
+      return true;
+   }
+
+   template <class T>
+   inline bool kernelLUDecomp(Matrix<T>&, Vector<int>&, int&)
+   { return false; }
+
+      // LU holds the matrix on input
+   inline bool kernelLUDecomp(Matrix<double>& LU, Vector<int>& Pivot,
+                              int& parity)
+   {
+      size_t N = LU.rows();
+      if(!MatrixKernels::use(N, N, N))
+         return false;
+      std::vector<size_t> piv;
+      if(!MatrixKernels::lu(N, LU.begin(), N, piv, parity)) {
+         SingularMatrixException e("singular matrix!");
+         GNSSTK_THROW(e);
+      }
+      Pivot = Vector<int>(N);
+      for(size_t i=0; i<N; i++) Pivot(i) = piv[i];
+      return true;
+   }
+
+   template <class T, class BaseClass>
+   inline bool kernelCholesky(const ConstMatrixBase<T, BaseClass>&,
+                              Matrix<T>*, Matrix<T>&, const char*)
+   { return false; }
+
+      // L (and U, if not null, with m = U*transpose(U)) from square m
+   template <class BaseClass>
+   inline bool kernelCholesky(const ConstMatrixBase<double, BaseClass>& m,
+                              Matrix<double>* U, Matrix<double>& L,
+                              const char* failMessage)
+   {
+      size_t N = m.rows(), i, j;
+      if(!MatrixKernels::use(N, N, N))
+         return false;
+      if(U) {
+            // U is L of m with the order of rows and columns reversed
+         Matrix<double> R(N,N);
+         for(j=0; j<N; j++)
+            for(i=0; i<N; i++) R(i,j) = m(N-1-i,N-1-j);
+         if(!MatrixKernels::cholesky(N, R.begin(), N)) {
+            MatrixException e(failMessage);
+            GNSSTK_THROW(e);
+         }
+         *U = Matrix<double>(N,N);
+         for(j=0; j<N; j++)
+            for(i=0; i<N; i++) (*U)(i,j) = R(N-1-i,N-1-j);
+      }
+      L = Matrix<double>(m);
+      if(!MatrixKernels::cholesky(N, L.begin(), N)) {
+         MatrixException e(failMessage);
+         GNSSTK_THROW(e);
+      }
+      return true;
+   }
+
+   template <class T>
+   inline bool kernelHouseholder(Matrix<T>&)
+   { return false; }
+
+   inline bool kernelHouseholder(Matrix<double>& A)
+   {
+      if(!MatrixKernels::use(A.rows(), A.cols(), A.cols()))
+         return false;
+      MatrixKernels::householder(A.rows(), A.cols(), A.begin(), A.rows());
+      return true;
+   }
+      /// @endcond
 
       /// @ingroup MathGroup
       //@{
@@ -452,6 +562,8 @@ namespace gnsstk
          Vector<T> V(N,T(0));
 
          LU = m;
+         if(kernelLUDecomp(LU, Pivot, parity))
+            return;
          Pivot = Vector<int>(N);
          parity = 1;
 
@@ -603,6 +715,8 @@ namespace gnsstk
             MatrixException e("Cholesky requires a square matrix");
             GNSSTK_THROW(e);
          }
+         if(kernelCholesky(m, &U, L, "Cholesky fails - eigenvalue <= 0"))
+            return;
 
          size_t N=m.rows(),i,j,k;
          double d;
@@ -710,6 +824,11 @@ namespace gnsstk
             MatrixException e("CholeskyCrout requires a square matrix");
             GNSSTK_THROW(e);
          }
+         if(kernelCholesky(m, static_cast<Matrix<T>*>(0), (*this).L,
+                           "CholeskyCrout fails - eigenvalue <= 0")) {
+            (*this).U = transpose((*this).L);
+            return;
+         }
 
          int N = m.rows(), i, j, k;
          double sum;
@@ -765,6 +884,8 @@ namespace gnsstk
       inline void operator() (const ConstMatrixBase<T, BaseClass>& m)
       {
          A = m;
+         if(kernelHouseholder(A))
+            return;
          size_t i,j,k;
          Vector<T> v(A.rows());
          T sum,alpha;
@@ -0,0 +1,570 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MatrixKernels.cpp
+ * Blocked matrix product and decompositions, with run-time
+ * selection of the micro-kernel.
+ */
+
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include "MatrixKernels.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+   (defined(__x86_64__) || defined(__i386__))
+#define GNSSTK_MATRIX_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace gnsstk
+{
+   namespace
+   {
+         /// Micro-kernel: ab (mr x nr, column-major) = a * b, where a
+         /// holds kc packed columns of mr rows and b kc packed rows of
+         /// nr columns.
+      typedef void (*MicroKernel)(size_t kc, const double *a, const double *b,
+                                  double *ab);
+
+         /// Register (mr x nr) and cache (mc, kc, nc) blocking for a
+         /// micro-kernel. mc is a multiple of mr and nc of nr.
+      struct KernelShape
+      {
+         size_t mr, nr, mc, kc, nc;
+         MicroKernel kernel;
+      };
+
+         /// The largest mr*nr of all the kernels.
+      const size_t maxTile = 16*6;
+         /// Panel width of the blocked decompositions.
+      const size_t panelWidth = 64;
+
+      void kernelPortable(size_t kc, const double *a, const double *b,
+                          double *ab)
+      {
+         double c[16] = { 0. };
+         for (size_t p = 0; p < kc; p++, a += 4, b += 4)
+            for (size_t j = 0; j < 4; j++)
+               for (size_t i = 0; i < 4; i++)
+                  c[j*4+i] += a[i] * b[j];
+         std::memcpy(ab, c, sizeof(c));
+      }
+
+#ifdef GNSSTK_MATRIX_KERNELS_X86
+      __attribute__((target("avx2,fma")))
+      void kernelAVX2(size_t kc, const double *a, const double *b, double *ab)
+      {
+         __m256d c00 = _mm256_setzero_pd(), c10 = _mm256_setzero_pd();
+         __m256d c01 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+         __m256d c02 = _mm256_setzero_pd(), c12 = _mm256_setzero_pd();
+         __m256d c03 = _mm256_setzero_pd(), c13 = _mm256_setzero_pd();
+         __m256d c04 = _mm256_setzero_pd(), c14 = _mm256_setzero_pd();
+         __m256d c05 = _mm256_setzero_pd(), c15 = _mm256_setzero_pd();
+         for (size_t p = 0; p < kc; p++, a += 8, b += 6)
+         {
+            __m256d a0 = _mm256_loadu_pd(a), a1 = _mm256_loadu_pd(a+4), bj;
+            bj = _mm256_broadcast_sd(b);
+            c00 = _mm256_fmadd_pd(a0, bj, c00); c10 = _mm256_fmadd_pd(a1, bj, c10);
+            bj = _mm256_broadcast_sd(b+1);
+            c01 = _mm256_fmadd_pd(a0, bj, c01); c11 = _mm256_fmadd_pd(a1, bj, c11);
+            bj = _mm256_broadcast_sd(b+2);
+            c02 = _mm256_fmadd_pd(a0, bj, c02); c12 = _mm256_fmadd_pd(a1, bj, c12);
+            bj = _mm256_broadcast_sd(b+3);
+            c03 = _mm256_fmadd_pd(a0, bj, c03); c13 = _mm256_fmadd_pd(a1, bj, c13);
+            bj = _mm256_broadcast_sd(b+4);
+            c04 = _mm256_fmadd_pd(a0, bj, c04); c14 = _mm256_fmadd_pd(a1, bj, c14);
+            bj = _mm256_broadcast_sd(b+5);
+            c05 = _mm256_fmadd_pd(a0, bj, c05); c15 = _mm256_fmadd_pd(a1, bj, c15);
+         }
+         _mm256_storeu_pd(ab,    c00); _mm256_storeu_pd(ab+4,  c10);
+         _mm256_storeu_pd(ab+8,  c01); _mm256_storeu_pd(ab+12, c11);
+         _mm256_storeu_pd(ab+16, c02); _mm256_storeu_pd(ab+20, c12);
+         _mm256_storeu_pd(ab+24, c03); _mm256_storeu_pd(ab+28, c13);
+         _mm256_storeu_pd(ab+32, c04); _mm256_storeu_pd(ab+36, c14);
+         _mm256_storeu_pd(ab+40, c05); _mm256_storeu_pd(ab+44, c15);
+      }
+
+      __attribute__((target("avx512f")))
+      void kernelAVX512(size_t kc, const double *a, const double *b,
+                        double *ab)
+      {
+         __m512d c00 = _mm512_setzero_pd(), c10 = _mm512_setzero_pd();
+         __m512d c01 = _mm512_setzero_pd(), c11 = _mm512_setzero_pd();
+         __m512d c02 = _mm512_setzero_pd(), c12 = _mm512_setzero_pd();
+         __m512d c03 = _mm512_setzero_pd(), c13 = _mm512_setzero_pd();
+         __m512d c04 = _mm512_setzero_pd(), c14 = _mm512_setzero_pd();
+         __m512d c05 = _mm512_setzero_pd(), c15 = _mm512_setzero_pd();
+         for (size_t p = 0; p < kc; p++, a += 16, b += 6)
+         {
+            __m512d a0 = _mm512_loadu_pd(a), a1 = _mm512_loadu_pd(a+8), bj;
+            bj = _mm512_set1_pd(b[0]);
+            c00 = _mm512_fmadd_pd(a0, bj, c00); c10 = _mm512_fmadd_pd(a1, bj, c10);
+            bj = _mm512_set1_pd(b[1]);
+            c01 = _mm512_fmadd_pd(a0, bj, c01); c11 = _mm512_fmadd_pd(a1, bj, c11);
+            bj = _mm512_set1_pd(b[2]);
+            c02 = _mm512_fmadd_pd(a0, bj, c02); c12 = _mm512_fmadd_pd(a1, bj, c12);
+            bj = _mm512_set1_pd(b[3]);
+            c03 = _mm512_fmadd_pd(a0, bj, c03); c13 = _mm512_fmadd_pd(a1, bj, c13);
+            bj = _mm512_set1_pd(b[4]);
+            c04 = _mm512_fmadd_pd(a0, bj, c04); c14 = _mm512_fmadd_pd(a1, bj, c14);
+            bj = _mm512_set1_pd(b[5]);
+            c05 = _mm512_fmadd_pd(a0, bj, c05); c15 = _mm512_fmadd_pd(a1, bj, c15);
+         }
+         _mm512_storeu_pd(ab,    c00); _mm512_storeu_pd(ab+8,  c10);
+         _mm512_storeu_pd(ab+16, c01); _mm512_storeu_pd(ab+24, c11);
+         _mm512_storeu_pd(ab+32, c02); _mm512_storeu_pd(ab+40, c12);
+         _mm512_storeu_pd(ab+48, c03); _mm512_storeu_pd(ab+56, c13);
+         _mm512_storeu_pd(ab+64, c04); _mm512_storeu_pd(ab+72, c14);
+         _mm512_storeu_pd(ab+80, c05); _mm512_storeu_pd(ab+88, c15);
+      }
+#endif
+
+      const KernelShape shapePortable = { 4, 4, 128, 256, 2048, kernelPortable };
+#ifdef GNSSTK_MATRIX_KERNELS_X86
+      const KernelShape shapeAVX2 = { 8, 6, 96, 256, 3072, kernelAVX2 };
+      const KernelShape shapeAVX512 = { 16, 6, 128, 256, 3072, kernelAVX512 };
+#endif
+
+      MatrixKernels::Level detectLevel()
+      {
+#ifdef GNSSTK_MATRIX_KERNELS_X86
+         __builtin_cpu_init();
+         if (__builtin_cpu_supports("avx512f"))
+            return MatrixKernels::AVX512;
+         if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return MatrixKernels::AVX2;
+#endif
+         return MatrixKernels::Portable;
+      }
+
+         /// Selected level, or -1 for bestLevel().
+      std::atomic<int> selectedLevel(-1);
+      std::atomic<size_t> crossoverDim(64);
+
+      const KernelShape& shapeFor(MatrixKernels::Level level)
+      {
+#ifdef GNSSTK_MATRIX_KERNELS_X86
+         if (level == MatrixKernels::AVX512)
+            return shapeAVX512;
+         if (level == MatrixKernels::AVX2)
+            return shapeAVX2;
+#endif
+         return shapePortable;
+      }
+
+         /// Pack mc x kc of A into panels of mr rows, zero padded.
+      void packA(size_t mc, size_t kc, const double *A, size_t rsa,
+                 size_t csa, size_t mr, double *dest)
+      {
+         for (size_t ir = 0; ir < mc; ir += mr, dest += mr*kc)
+         {
+            size_t mrr = std::min(mr, mc-ir);
+            for (size_t p = 0; p < kc; p++)
+            {
+               const double *src = A + ir*rsa + p*csa;
+               double *d = dest + p*mr;
+               size_t i;
+               for (i = 0; i < mrr; i++)
+                  d[i] = src[i*rsa];
+               for ( ; i < mr; i++)
+                  d[i] = 0.;
+            }
+         }
+      }
+
+         /// Pack kc x nc of B into panels of nr columns, zero padded.
+      void packB(size_t kc, size_t nc, const double *B, size_t rsb,
+                 size_t csb, size_t nr, double *dest)
+      {
+         for (size_t jr = 0; jr < nc; jr += nr, dest += nr*kc)
+         {
+            size_t nrr = std::min(nr, nc-jr);
+            for (size_t p = 0; p < kc; p++)
+            {
+               const double *src = B + p*rsb + jr*csb;
+               double *d = dest + p*nr;
+               size_t j;
+               for (j = 0; j < nrr; j++)
+                  d[j] = src[j*csb];
+               for ( ; j < nr; j++)
+                  d[j] = 0.;
+            }
+         }
+      }
+   } // anonymous namespace
+
+
+   MatrixKernels::Level MatrixKernels::bestLevel()
+   {
+      static const Level best = detectLevel();
+      return best;
+   }
+
+
+   MatrixKernels::Level MatrixKernels::getLevel()
+   {
+      int level = selectedLevel.load(std::memory_order_relaxed);
+      return (level < 0 ? bestLevel() : static_cast<Level>(level));
+   }
+
+
+   MatrixKernels::Level MatrixKernels::setLevel(Level level)
+   {
+      if (level > bestLevel())
+         level = bestLevel();
+      selectedLevel.store(level);
+      return level;
+   }
+
+
+   const char* MatrixKernels::levelName(Level level)
+   {
+      switch (level)
+      {
+         case Reference: return "Reference";
+         case Portable:  return "Portable";
+         case AVX2:      return "AVX2";
+         case AVX512:    return "AVX512";
+      }
+      return "Unknown";
+   }
+
+
+   size_t MatrixKernels::crossover()
+   {
+      return crossoverDim.load(std::memory_order_relaxed);
+   }
+
+
+   void MatrixKernels::setCrossover(size_t n)
+   {
+      crossoverDim.store(n);
+   }
+
+
+   void MatrixKernels::gemm(size_t m, size_t n, size_t k, double alpha,
+                            const double *A, size_t rsa, size_t csa,
+                            const double *B, size_t rsb, size_t csb,
+                            double *C, size_t ldc)
+   {
+      if (m == 0 || n == 0 || k == 0 || alpha == 0.)
+         return;
+
+      const KernelShape& s(shapeFor(getLevel()));
+         // packing buffers, no larger than this product needs
+      size_t mcMax = std::min(s.mc, (m + s.mr - 1) / s.mr * s.mr),
+         kcMax = std::min(s.kc, k),
+         ncMax = std::min(s.nc, (n + s.nr - 1) / s.nr * s.nr);
+      std::unique_ptr<double[]> apack(new double[mcMax * kcMax]),
+         bpack(new double[kcMax * ncMax]);
+      double ab[maxTile];
+
+      for (size_t jc = 0; jc < n; jc += s.nc)
+      {
+         size_t nc = std::min(s.nc, n-jc);
+         for (size_t pc = 0; pc < k; pc += s.kc)
+         {
+            size_t kc = std::min(s.kc, k-pc);
+            packB(kc, nc, B + pc*rsb + jc*csb, rsb, csb, s.nr, bpack.get());
+            for (size_t ic = 0; ic < m; ic += s.mc)
+            {
+               size_t mc = std::min(s.mc, m-ic);
+               packA(mc, kc, A + ic*rsa + pc*csa, rsa, csa, s.mr, apack.get());
+               for (size_t jr = 0; jr < nc; jr += s.nr)
+               {
+                  size_t nrr = std::min(s.nr, nc-jr);
+                  for (size_t ir = 0; ir < mc; ir += s.mr)
+                  {
+                     size_t mrr = std::min(s.mr, mc-ir);
+                     s.kernel(kc, &apack[ir*kc], &bpack[jr*kc], ab);
+                     double *c = C + (ic+ir) + (jc+jr)*ldc;
+                     for (size_t j = 0; j < nrr; j++)
+                        for (size_t i = 0; i < mrr; i++)
+                           c[i + j*ldc] += alpha * ab[j*s.mr + i];
+                  }
+               }
+            }
+         }
+      }
+   }
+
+
+   bool MatrixKernels::lu(size_t n, double *A, size_t lda,
+                          std::vector<size_t>& pivot, int& parity)
+   {
+      size_t i, j, c, j0, imax;
+      double big, d, t;
+      std::vector<double> scale(n);
+
+      pivot.assign(n, 0);
+      parity = 1;
+
+         // get scale of each row
+      for (i = 0; i < n; i++)
+      {
+         big = 0.;
+         for (j = 0; j < n; j++)
+            big = std::max(big, std::fabs(A[i + j*lda]));
+         if (big <= 0.)
+            return false;
+         scale[i] = 1. / big;
+      }
+
+      for (j0 = 0; j0 < n; j0 += panelWidth)
+      {
+         size_t j1 = std::min(n, j0 + panelWidth);
+
+            // unblocked, right-looking on the panel
+         for (j = j0; j < j1; j++)
+         {
+            big = 0.;
+            imax = j;
+            for (i = j; i < n; i++)
+            {
+               d = scale[i] * std::fabs(A[i + j*lda]);
+               if (d >= big)
+               {
+                  big = d;
+                  imax = i;
+               }
+            }
+            if (imax != j)
+            {
+               for (c = 0; c < n; c++)
+                  std::swap(A[j + c*lda], A[imax + c*lda]);
+               scale[imax] = scale[j];
+               parity = -parity;
+            }
+            pivot[j] = imax;
+
+            t = A[j + j*lda];
+            if (t == 0.)
+               return false;
+            if (j != n-1)
+            {
+               d = 1. / t;
+               for (i = j+1; i < n; i++)
+                  A[i + j*lda] *= d;
+            }
+            for (c = j+1; c < j1; c++)
+            {
+               t = A[j + c*lda];
+               if (t != 0.)
+                  for (i = j+1; i < n; i++)
+                     A[i + c*lda] -= A[i + j*lda] * t;
+            }
+         }
+
+         if (j1 < n)
+         {
+               // U12 = inverse(L11) * A12
+            for (c = j1; c < n; c++)
+               for (j = j0; j < j1; j++)
+               {
+                  t = A[j + c*lda];
+                  if (t != 0.)
+                     for (i = j+1; i < j1; i++)
+                        A[i + c*lda] -= A[i + j*lda] * t;
+               }
+               // A22 -= L21 * U12
+            gemm(n-j1, n-j1, j1-j0, -1.,
+                 A + j1 + j0*lda, 1, lda,
+                 A + j0 + j1*lda, 1, lda,
+                 A + j1 + j1*lda, lda);
+         }
+      }
+      return true;
+   }
+
+
+   bool MatrixKernels::cholesky(size_t n, double *A, size_t lda)
+   {
+      size_t i, j, c, j0, c0;
+      double d;
+
+      for (j0 = 0; j0 < n; j0 += panelWidth)
+      {
+         size_t j1 = std::min(n, j0 + panelWidth);
+
+            // unblocked, right-looking on the panel (all rows below j0)
+         for (j = j0; j < j1; j++)
+         {
+            d = A[j + j*lda];
+            if (!(d > 0.))
+               return false;
+            d = std::sqrt(d);
+            A[j + j*lda] = d;
+            d = 1. / d;
+            for (i = j+1; i < n; i++)
+               A[i + j*lda] *= d;
+            for (c = j+1; c < j1; c++)
+            {
+               d = A[c + j*lda];
+               for (i = c; i < n; i++)
+                  A[i + c*lda] -= A[i + j*lda] * d;
+            }
+         }
+
+            // A22 -= L21 * transpose(L21), lower triangle by column panels
+         for (c0 = j1; c0 < n; c0 += panelWidth)
+         {
+            size_t cb = std::min(panelWidth, n-c0);
+            gemm(n-c0, cb, j1-j0, -1.,
+                 A + c0 + j0*lda, 1, lda,
+                 A + c0 + j0*lda, lda, 1,
+                 A + c0 + c0*lda, lda);
+         }
+      }
+
+      for (c = 1; c < n; c++)
+         for (i = 0; i < c; i++)
+            A[i + c*lda] = 0.;
+      return true;
+   }
+
+
+   void MatrixKernels::householder(size_t m, size_t n, double *A, size_t lda)
+   {
+      if (m < 2 || n < 2)
+         return;
+
+      const double EPS(1.e-200);
+      const size_t nb = 32;
+      const size_t jend = std::min(m, n) - 1;
+      size_t i, j, k, q, r, jj, j0;
+      double sum, alpha;
+      std::vector<double> V, T(nb*nb), W, tau(nb), w(nb);
+
+      for (j0 = 0; j0 < jend; j0 += nb)
+      {
+         const size_t j1 = std::min(jend, j0 + nb), jb = j1 - j0, mv = m - j0;
+            // V(i,jj) holds u for column j0+jj at row j0+i
+         V.assign(mv*jb, 0.);
+
+            // reflect the panel columns one at a time, exactly as the
+            // Householder functor does
+         for (jj = 0; jj < jb; jj++)
+         {
+            j = j0 + jj;
+            double *v = &V[jj*mv + jj];   // v[i-j] is row i
+            sum = 0.;
+            for (i = j; i < m; i++)
+            {
+               v[i-j] = A[i + j*lda];
+               A[i + j*lda] = 0.;
+               sum += v[i-j] * v[i-j];
+            }
+            tau[jj] = 0.;
+            if (sum < EPS)
+            {
+               for (i = j; i < m; i++)
+                  v[i-j] = 0.;
+               continue;
+            }
+            sum = std::sqrt(sum);
+            if (v[0] > 0.)
+               sum = -sum;
+            A[j + j*lda] = sum;
+            v[0] -= sum;
+            sum = 1. / (sum * v[0]);
+            tau[jj] = -sum;
+
+            for (k = j+1; k < j1; k++)
+            {
+               alpha = 0.;
+               for (i = j; i < m; i++)
+                  alpha += A[i + k*lda] * v[i-j];
+               alpha *= sum;
+               if (alpha*alpha < EPS)
+                  continue;
+               for (i = j; i < m; i++)
+                  A[i + k*lda] += alpha * v[i-j];
+            }
+         }
+
+         if (j1 >= n)
+            continue;
+
+            // T, upper triangular, with H(0)...H(jb-1) = I - V*T*VT
+         for (jj = 0; jj < jb; jj++)
+         {
+            for (q = 0; q < jb; q++)
+               T[q + jj*nb] = 0.;
+            T[jj + jj*nb] = tau[jj];
+            if (tau[jj] == 0.)
+               continue;
+            for (q = 0; q < jj; q++)
+            {
+               w[q] = 0.;
+               for (i = jj; i < mv; i++)
+                  w[q] += V[i + q*mv] * V[i + jj*mv];
+            }
+            for (q = 0; q < jj; q++)
+            {
+               sum = 0.;
+               for (r = q; r < jj; r++)
+                  sum += T[q + r*nb] * w[r];
+               T[q + jj*nb] = -tau[jj] * sum;
+            }
+         }
+
+            // A2 = (I - V*TT*VT) * A2 for the trailing columns
+         const size_t nt = n - j1;
+         double *A2 = A + j0 + j1*lda;
+         W.assign(jb*nt, 0.);
+         gemm(jb, nt, mv, 1., &V[0], mv, 1, A2, 1, lda, &W[0], jb);
+         for (k = 0; k < nt; k++)
+         {
+            double *wk = &W[k*jb];
+            for (q = jb; q-- > 0; )
+            {
+               sum = 0.;
+               for (r = 0; r <= q; r++)
+                  sum += T[r + q*nb] * wk[r];
+               wk[q] = sum;
+            }
+         }
+         gemm(mv, nt, jb, -1., &V[0], 1, mv, &W[0], 1, jb, A2, lda);
+      }
+   }
+
+}  // namespace gnsstk
@@ -0,0 +1,162 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file MatrixKernels.hpp
+ * Cache-blocked, vectorized kernels for large double precision
+ * matrix products and decompositions, and the glue used by the
+ * Matrix operators and functors to call them.
+ */
+
+#ifndef GNSSTK_MATRIX_KERNELS_HPP
+#define GNSSTK_MATRIX_KERNELS_HPP
+
+#include <vector>
+#include <cstddef>
+#include "gnsstk_export.h"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * Blocked kernels for double precision linear algebra on
+       * column-major arrays. Matrix<double> stores its elements
+       * column-major and contiguously, so operator*, LUDecomp,
+       * Cholesky, CholeskyCrout and Householder call these kernels
+       * directly when all dimensions reach crossover(); smaller
+       * problems, and all other element types, use the original
+       * loops unchanged.
+       *
+       * The product is computed the usual way for blocked GEMM:
+       * panels of the operands are packed into contiguous buffers
+       * sized for the caches, and a register-blocked micro-kernel
+       * accumulates each small tile of the result. The
+       * decompositions are right-looking blocked algorithms that do
+       * the bulk of their work in that product.
+       *
+       * The micro-kernel is chosen at run time from the instruction
+       * sets the processor supports (AVX-512F, AVX2+FMA, or portable
+       * C++), and may be restricted with setLevel(), e.g. to
+       * compare against the reference loops. The blocked results
+       * differ from the reference loops only by rounding.
+       */
+   class MatrixKernels
+   {
+   public:
+         /// Implementations, in increasing order of preference.
+      enum Level
+      {
+         Reference = 0,  ///< Original loops, kernels not used.
+         Portable,       ///< Blocked, portable C++ micro-kernel.
+         AVX2,           ///< Blocked, AVX2 and FMA micro-kernel.
+         AVX512          ///< Blocked, AVX-512F micro-kernel.
+      };
+
+         /// Best level supported by this processor and build.
+      GNSSTK_EXPORT static Level bestLevel();
+         /// Level currently in use; initially bestLevel().
+      GNSSTK_EXPORT static Level getLevel();
+         /** Select the level to use, for all threads. A level above
+          * bestLevel() is reduced to bestLevel().
+          * @return the level actually selected. */
+      GNSSTK_EXPORT static Level setLevel(Level level);
+         /// Name of a level, e.g. "AVX2".
+      GNSSTK_EXPORT static const char* levelName(Level level);
+
+         /// Smallest dimension for which the kernels are used.
+      GNSSTK_EXPORT static size_t crossover();
+         /// Set the smallest dimension for which the kernels are used.
+      GNSSTK_EXPORT static void setCrossover(size_t n);
+
+         /// True if the kernels should be used for dimensions m,n,k.
+      static bool use(size_t m, size_t n, size_t k)
+      {
+         size_t x = crossover();
+         return (getLevel() != Reference && m >= x && n >= x && k >= x);
+      }
+
+         /**
+          * C += alpha * A * B, where A is m x k, B is k x n and C is
+          * m x n, column-major with leading dimension ldc. Element
+          * (i,p) of A is A[i*rsa + p*csa], and likewise for B, so a
+          * transposed operand is given by swapping its strides.
+          */
+      GNSSTK_EXPORT static void gemm(size_t m, size_t n, size_t k,
+                                     double alpha,
+                                     const double *A, size_t rsa, size_t csa,
+                                     const double *B, size_t rsb, size_t csb,
+                                     double *C, size_t ldc);
+
+         /**
+          * In-place LU decomposition with partial pivoting of the
+          * n x n column-major matrix A, PA = LU, choosing pivots
+          * with the implicit row scaling used by LUDecomp.
+          * @param[out] pivot row exchanged with row j at step j.
+          * @param[out] parity +1 or -1 for an even or odd number of
+          *   row exchanges.
+          * @return false if A is singular.
+          */
+      GNSSTK_EXPORT static bool lu(size_t n, double *A, size_t lda,
+                                   std::vector<size_t>& pivot, int& parity);
+
+         /**
+          * In-place Cholesky decomposition A = L*transpose(L) of the
+          * n x n column-major symmetric positive definite matrix A.
+          * Only the lower triangle is read; on return it holds L and
+          * the strict upper triangle is zero.
+          * @return false if A is not positive definite.
+          */
+      GNSSTK_EXPORT static bool cholesky(size_t n, double *A, size_t lda);
+
+         /**
+          * In-place Householder triangularization of the m x n
+          * column-major matrix A, as done by the Householder functor:
+          * columns j < min(m,n)-1 are reflected, the diagonal holds
+          * the result and the reflected part below it is zeroed.
+          */
+      GNSSTK_EXPORT static void householder(size_t m, size_t n,
+                                            double *A, size_t lda);
+   };
+
+      //@}
+
+}  // namespace gnsstk
+
+#endif
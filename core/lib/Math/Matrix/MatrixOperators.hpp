@@ -821,6 +821,8 @@ namespace gnsstk
       }
 
       Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      if (kernelMultiply(l, r, toReturn))
+         return toReturn;
       size_t i, j, k;
       for (i = 0; i < toReturn.rows(); i++)
          for (j = 0; j < toReturn.cols(); j++)
@@ -128,13 +128,17 @@ gnsstk::Vector<double> RACRotation::convertToRAC( const gnsstk::Vector<double>&
 
 gnsstk::Triple RACRotation::convertToRAC( const gnsstk::Triple& inVec )
 {
-   gnsstk::Vector<double> v(3);
-   v[0] = inVec[0];
-   v[1] = inVec[1];
-   v[2] = inVec[2];
-
-   gnsstk::Vector<double> vOut = convertToRAC( v );
-   gnsstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
+      // Same sums as convertToRAC(Vector), without the two temporary
+      // Vectors; this is called twice per Xvt.
+   gnsstk::Triple outVec;
+   size_t i, j;
+   for (i = 0; i < 3; i++)
+   {
+      for (j = 0; j < 3; j++)
+      {
+         outVec[i] += (*this)(i,j) * inVec[j];
+      }
+   }
    return(outVec);
 }
 
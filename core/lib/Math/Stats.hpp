@@ -213,6 +213,44 @@ namespace gnsstk
          for(size_t i=0; i<X.size(); i++) Subtract(X[i]);
       }
 
+      /// add a contiguous array of nx samples to the computation of statistics;
+      /// if flags is not null, only samples with flags[i]==0 are added.
+      /// The result is identical to calling Add(x[i]) for each sample, but the
+      /// sums are kept in registers rather than in the object.
+      void Add(const T *x, size_t nx, const int *flags=nullptr)   // Stats
+      {
+         size_t i(0);
+         // the first sample and the scale are set by the fundamental Add()
+         for( ; i<nx && (n == 0 || !setScale); i++)
+            if(!flags || flags[i] == 0) Add(x[i]);
+         if(i >= nx) return;
+
+         T s(sum), s2(sum2), mn(min), mx(max), sx;
+         const T sc(scale);
+         unsigned int nn(n);
+         for( ; i<nx; i++) {
+            if(flags && flags[i] != 0) continue;
+            sx = x[i]/sc;
+            s += sx;
+            s2 += sx*sx;
+            if(x[i] < mn) mn = x[i];
+            if(x[i] > mx) mx = x[i];
+            nn++;
+         }
+         sum = s; sum2 = s2; min = mn; max = mx; n = nn;
+      }
+
+      /// remove a contiguous array of nx samples from the computation of
+      /// statistics; if flags is not null, only samples with flags[i]==0 are
+      /// removed.
+      /// NB. Assumes that these samples were previously added.
+      /// NB. Minimum() and Maximum() may no longer be valid.
+      void Subtract(const T *x, size_t nx, const int *flags=nullptr) // Stats
+      {
+         for(size_t i=0; i<nx; i++)
+            if(!flags || flags[i] == 0) Subtract(x[i]);
+      }
+
       // combine two Stats objects -------------------------------------
 
       /// combine two Stats (assumed taken from the same or equivalent ensembles)
@@ -50,7 +50,6 @@ namespace gnsstk
    using namespace std;
 
    Triple :: Triple()
-         : theArray(0., 3)
    {
    }
 
@@ -62,7 +61,6 @@ namespace gnsstk
    Triple :: Triple(double a,
                     double b,
                     double c)
-      : theArray(3)
    {
       theArray[0] = a;
       theArray[1] = b;
@@ -82,7 +80,9 @@ namespace gnsstk
          GNSSTK_THROW(GeometryException("Incorrect vector size"));
       }
 
-      theArray = right;
+      theArray[0] = right[0];
+      theArray[1] = right[1];
+      theArray[2] = right[2];
       return *this;
    }
 
@@ -107,10 +107,7 @@ namespace gnsstk
    double Triple :: dot(const Triple& right) const
       noexcept
    {
-      Triple z;
-      z = (this->theArray)*(right.theArray);
-      double a = z.theArray.sum();
-      return a;
+      return gnsstk::dot(theArray, right.theArray);
    }
 
 
@@ -175,8 +172,7 @@ namespace gnsstk
    {
       Triple z;
       z = right.theArray - this->theArray;
-      double r = z.mag();
-      return r;
+      return z.mag();
    }
 
 
@@ -48,6 +48,7 @@
 #include <vector>
 #include "Exception.hpp"
 #include "Vector.hpp"
+#include "FixedVector.hpp"
 
 namespace gnsstk
 {
@@ -90,6 +91,10 @@ namespace gnsstk
           */
       Triple& operator=(const std::valarray<double>& right);
 
+         /// Assign from a three element FixedVector.
+      Triple& operator=(const FixedVector<double,3>& right)
+      { theArray = right; return *this; }
+
 
          /// Return the data as a Vector<double> object
       Vector<double> toVector();
@@ -248,7 +253,10 @@ namespace gnsstk
       friend std::ostream& operator<<(std::ostream& s,
                                       const gnsstk::Triple& v);
 
-      std::valarray<double> theArray;
+         /** The three elements, held in the object so that
+          * constructing and copying a Triple (and so a Position or
+          * Xvt) does not allocate. */
+      FixedVector<double,3> theArray;
 
    }; // class Triple
 
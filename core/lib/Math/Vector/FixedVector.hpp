@@ -0,0 +1,244 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/**
+ * @file FixedVector.hpp
+ * Vector with its size fixed at compile time
+ */
+
+#ifndef GNSSTK_FIXEDVECTOR_HPP
+#define GNSSTK_FIXEDVECTOR_HPP
+
+#include <cmath>
+#include "Vector.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A vector of N elements of type T, where N is fixed at compile
+       * time. The elements are stored in the object itself, so that
+       * constructing, copying and returning a FixedVector never
+       * allocates, and the loops over its elements have constant
+       * bounds that the compiler can unroll and vectorize. This is
+       * intended for the small vectors (positions, velocities,
+       * residuals of a few states) used throughout the library.
+       *
+       * FixedVector is a RefVectorBase, so it can be used wherever a
+       * ConstVectorBase or RefVectorBase is accepted, e.g. dot(),
+       * norm(), a Vector constructor or Matrix * Vector. The
+       * operators below that take only FixedVector (or FixedMatrix)
+       * arguments return a FixedVector; mixing with Vector<T> uses
+       * the general operators and returns a Vector<T>.
+       */
+   template <class T, size_t N>
+   class FixedVector : public RefVectorBase<T, FixedVector<T,N> >
+   {
+   public:
+         /// STL value type
+      typedef T value_type;
+         /// STL reference type
+      typedef T& reference;
+         /// STL const reference type
+      typedef const T& const_reference;
+         /// STL iterator type
+      typedef T* iterator;
+         /// STL const iterator type
+      typedef const T* const_iterator;
+
+         /// Default constructor, all elements zero.
+      FixedVector()
+      {
+         for (size_t i = 0; i < N; i++)
+            v[i] = T(0);
+      }
+
+         /// Constructor with all elements set to defaultValue.
+      explicit FixedVector(const T defaultValue)
+      {
+         for (size_t i = 0; i < N; i++)
+            v[i] = defaultValue;
+      }
+
+         /**
+          * Copy constructor from a ConstVectorBase type.
+          * @throw VectorException if r.size() != N
+          */
+      template <class E>
+      FixedVector(const ConstVectorBase<T, E>& r)
+      {
+         if (r.size() != N)
+         {
+            VectorException e("Invalid size for FixedVector(ConstVectorBase)");
+            GNSSTK_THROW(e);
+         }
+         for (size_t i = 0; i < N; i++)
+            v[i] = r[i];
+      }
+
+         /// STL iterator begin
+      iterator begin() { return v; }
+         /// STL const iterator begin
+      const_iterator begin() const { return v; }
+         /// STL iterator end
+      iterator end() { return v + N; }
+         /// STL const iterator end
+      const_iterator end() const { return v + N; }
+         /// STL size
+      constexpr size_t size() const { return N; }
+         /// Pointer to the N contiguous elements.
+      T* data() { return v; }
+         /// Pointer to the N contiguous elements.
+      const T* data() const { return v; }
+
+         /// Non-const operator []
+      T& operator[] (size_t i)
+      { return v[i]; }
+         /// Const operator []
+      T operator[] (size_t i) const
+      { return v[i]; }
+         /// Non-const operator ()
+      T& operator() (size_t i)
+      { return v[i]; }
+         /// Const operator ()
+      T operator() (size_t i) const
+      { return v[i]; }
+
+         /**
+          * Assign from any vector of the same size.
+          * @throw VectorException if x.size() != N
+          */
+      template <class E>
+      FixedVector& operator=(const ConstVectorBase<T, E>& x)
+      {
+         if (x.size() != N)
+         {
+            VectorException e("Invalid size for FixedVector assignment");
+            GNSSTK_THROW(e);
+         }
+         return this->assignFrom(x);
+      }
+         /// Set all the elements to x.
+      FixedVector& operator=(const T x)
+      { return this->assignFrom(x); }
+
+         /// Convert to a Vector<T>.
+      Vector<T> toVector() const
+      { return Vector<T>(*this); }
+
+   private:
+         /// the data
+      T v[N];
+   };
+
+      /// Element by element sum of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator+(const FixedVector<T,N>& l,
+                                     const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn(l);
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] += r[i];
+      return toReturn;
+   }
+
+      /// Element by element difference of two FixedVectors
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator-(const FixedVector<T,N>& l,
+                                     const FixedVector<T,N>& r)
+   {
+      FixedVector<T,N> toReturn(l);
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] -= r[i];
+      return toReturn;
+   }
+
+      /// FixedVector times a scalar
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const FixedVector<T,N>& l, const T r)
+   {
+      FixedVector<T,N> toReturn(l);
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] *= r;
+      return toReturn;
+   }
+
+      /// Scalar times a FixedVector
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator*(const T l, const FixedVector<T,N>& r)
+   { return r * l; }
+
+      /// FixedVector divided by a scalar
+   template <class T, size_t N>
+   inline FixedVector<T,N> operator/(const FixedVector<T,N>& l, const T r)
+   {
+      FixedVector<T,N> toReturn(l);
+      for (size_t i = 0; i < N; i++)
+         toReturn[i] /= r;
+      return toReturn;
+   }
+
+      /// Dot product of two FixedVectors; the sum is taken in index order.
+   template <class T, size_t N>
+   inline T dot(const FixedVector<T,N>& l, const FixedVector<T,N>& r)
+   {
+      T sum(l[0]*r[0]);
+      for (size_t i = 1; i < N; i++)
+         sum += l[i]*r[i];
+      return sum;
+   }
+
+      /// Cross product of two three-element FixedVectors
+   template <class T>
+   inline FixedVector<T,3> cross(const FixedVector<T,3>& l,
+                                 const FixedVector<T,3>& r)
+   {
+      FixedVector<T,3> toReturn;
+      toReturn[0] = l[1] * r[2] - l[2] * r[1];
+      toReturn[1] = l[2] * r[0] - l[0] * r[2];
+      toReturn[2] = l[0] * r[1] - l[1] * r[0];
+      return toReturn;
+   }
+
+      //@}
+
+}  // namespace gnsstk
+
+#endif
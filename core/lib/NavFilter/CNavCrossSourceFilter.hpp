@@ -99,10 +99,17 @@ namespace gnsstk
       virtual void dump(std::ostream& s) const;
 
    protected:
-         /// Map from subframe data to source list
-      typedef std::map<CNavFilterData*, NavMsgList, CNavMsgSort> MessageMap;
+         /** Map from subframe data to source list.  The per-epoch
+          * maps draw their nodes from a pool, which recycles them
+          * when groupedNav is cleared at the end of each epoch. */
+      typedef std::map<CNavFilterData*, NavMsgList, CNavMsgSort,
+                       NavFilterPoolAllocator<
+                          std::pair<CNavFilterData* const, NavMsgList> > >
+      MessageMap;
          /// Map from PRN to SubframeMap
-      typedef std::map<uint32_t, MessageMap> NavMap;
+      typedef std::map<uint32_t, MessageMap, std::less<uint32_t>,
+                       NavFilterPoolAllocator<
+                          std::pair<const uint32_t, MessageMap> > > NavMap;
 
          /// Nav subframes grouped by prn and unique nav bits
       NavMap groupedNav;
@@ -87,10 +87,17 @@ namespace gnsstk
       { return "CrossSource"; }
 
    protected:
-         /// Map from subframe data to source list
-      typedef std::map<LNavFilterData*, NavMsgList, LNavMsgSort> SubframeMap;
+         /** Map from subframe data to source list.  The per-epoch
+          * maps draw their nodes from a pool, which recycles them
+          * when groupedNav is cleared at the end of each epoch. */
+      typedef std::map<LNavFilterData*, NavMsgList, LNavMsgSort,
+                       NavFilterPoolAllocator<
+                          std::pair<LNavFilterData* const, NavMsgList> > >
+      SubframeMap;
          /// Map from PRN to SubframeMap
-      typedef std::map<uint32_t, SubframeMap> NavMap;
+      typedef std::map<uint32_t, SubframeMap, std::less<uint32_t>,
+                       NavFilterPoolAllocator<
+                          std::pair<const uint32_t, SubframeMap> > > NavMap;
 
          /// Nav subframes grouped by prn and unique nav bits
       NavMap groupedNav;
@@ -122,7 +122,9 @@ namespace gnsstk
       unsigned procDepth;
 
    protected:
-      typedef std::set<LNavFilterData*, LNavTimeSort> SubframeSet;
+         /// Pooled set nodes, as one is made for every subframe.
+      typedef std::set<LNavFilterData*, LNavTimeSort,
+                       NavFilterPoolAllocator<LNavFilterData*> > SubframeSet;
 
          /// Ordered set of nav message subframes
       SubframeSet orderedNav;
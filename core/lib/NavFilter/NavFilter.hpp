@@ -44,6 +44,7 @@
 #include <list>
 #include "ObsID.hpp"
 #include "NavFilterKey.hpp"
+#include "NavFilterPool.hpp"
 
 namespace gnsstk
 {
@@ -55,7 +56,11 @@ namespace gnsstk
    class NavFilter
    {
    public:
-      typedef std::list<NavFilterKey*> NavMsgList;
+         /** List of messages passed between filters.  The list
+          * nodes come from a pool so that passing messages from
+          * filter to filter doesn't allocate memory. */
+      typedef std::list<NavFilterKey*,
+                        NavFilterPoolAllocator<NavFilterKey*> > NavMsgList;
 
       NavFilter();
 
@@ -0,0 +1,270 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file NavFilterPool.hpp Define a pool allocator for the
+ * containers passing NavFilterKey pointers between filters. */
+
+#ifndef NAVFILTERPOOL_HPP
+#define NAVFILTERPOOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace gnsstk
+{
+      /// @ingroup NavFilter
+      //@{
+
+      /** A pool of fixed-size memory blocks, used by
+       * NavFilterPoolAllocator.  Every thread keeps a cache of free
+       * blocks, so allocating and freeing a block is normally just a
+       * pointer swap with no locking.  The caches are refilled from
+       * and overflow into a shared free list, and new blocks are
+       * carved out of chunks of blockBatch blocks when that is empty.
+       *
+       * Memory is never returned to the system: chunks live until
+       * the program exits, and a thread's cache is moved to the
+       * shared list when the thread ends.  This keeps blocks valid
+       * no matter which thread, or which static destructor, frees
+       * them, and bounds the memory used to the peak number of
+       * blocks in use.
+       * @param Size The size of the blocks in bytes. */
+   template <std::size_t Size>
+   class NavFilterBlockPool
+   {
+   public:
+         /// Number of blocks moved between a cache and the shared list.
+      static const std::size_t blockBatch = 256;
+
+         /// Return an uninitialized block of Size bytes.
+      static void* allocate()
+      {
+         Cache& c(cache());
+         if (c.head == nullptr)
+            refill(c);
+         Block *b = c.head;
+         c.head = b->next;
+         c.count--;
+         return b;
+      }
+
+         /// Return a block obtained from allocate() to the pool.
+      static void deallocate(void *p) noexcept
+      {
+         Cache& c(cache());
+         Block *b = static_cast<Block*>(p);
+         b->next = c.head;
+         c.head = b;
+         c.count++;
+            // Don't let one thread hoard the blocks another frees.
+         if (c.count > 2*blockBatch)
+            release(c, blockBatch);
+      }
+
+   private:
+         /// A free block, or the storage of one in use.
+      union Block
+      {
+         Block *next;
+         alignas(std::max_align_t) char data[Size];
+      };
+
+         /** Free blocks owned by one thread.  This is a POD so that
+          * it is usable at any point in the life of the thread. */
+      struct Cache
+      {
+         Block *head;
+         std::size_t count;
+         bool registered; ///< true once the Flusher exists.
+         bool dead;       ///< true once the Flusher has run.
+      };
+
+         /// Blocks shared by all threads.
+      struct Shared
+      {
+         std::mutex lock;
+         Block *head = nullptr;
+         std::size_t count = 0;
+         std::vector<std::unique_ptr<Block[]> > chunks;
+      };
+
+         /// Moves a thread's cache to the shared list on thread exit.
+      struct Flusher
+      {
+         ~Flusher()
+         {
+            Cache& c(threadCache());
+            release(c, c.count);
+            c.dead = true;
+         }
+      };
+
+      static Cache& threadCache()
+      {
+         static thread_local Cache c;
+         return c;
+      }
+
+      static Cache& cache()
+      {
+         Cache& c(threadCache());
+         if (!c.registered && !c.dead)
+         {
+            c.registered = true;
+            static thread_local Flusher f;
+            (void)f;
+         }
+         return c;
+      }
+
+         /** The shared list is intentionally never destroyed, as
+          * blocks may be freed by static destructors in any order. */
+      static Shared& shared()
+      {
+         static Shared *s = new Shared;
+         return *s;
+      }
+
+         /// Move up to blockBatch blocks into the empty cache c.
+      static void refill(Cache& c)
+      {
+         Shared& s(shared());
+         std::lock_guard<std::mutex> guard(s.lock);
+         if (s.head == nullptr)
+         {
+            Block *chunk = new Block[blockBatch];
+            s.chunks.emplace_back(chunk);
+            for (std::size_t i = 0; i < blockBatch; i++)
+            {
+               chunk[i].next = s.head;
+               s.head = &chunk[i];
+            }
+            s.count += blockBatch;
+         }
+         while ((s.head != nullptr) && (c.count < blockBatch))
+         {
+            Block *b = s.head;
+            s.head = b->next;
+            s.count--;
+            b->next = c.head;
+            c.head = b;
+            c.count++;
+         }
+      }
+
+         /// Move num blocks from cache c to the shared list.
+      static void release(Cache& c, std::size_t num)
+      {
+         if (num == 0)
+            return;
+         Block *first = c.head, *last = c.head;
+         for (std::size_t i = 1; i < num; i++)
+            last = last->next;
+         c.head = last->next;
+         c.count -= num;
+         Shared& s(shared());
+         std::lock_guard<std::mutex> guard(s.lock);
+         last->next = s.head;
+         s.head = first;
+         s.count += num;
+      }
+   }; // class NavFilterBlockPool
+
+
+      /** A stateless allocator drawing single objects from a
+       * NavFilterBlockPool.  This is used by NavFilter::NavMsgList
+       * and the per-epoch containers of the filters, whose nodes are
+       * created and destroyed for every subframe passing through a
+       * filter.  Blocks are recycled rather than going back to the
+       * heap, so in steady state moving messages between filters
+       * does no heap allocation.  Any two instances compare equal,
+       * so containers using it may splice and swap freely.
+       * @param T The type of object allocated. */
+   template <class T>
+   class NavFilterPoolAllocator
+   {
+   public:
+      typedef T value_type;
+
+         /// Blocks are rounded to 16 bytes so similar types share a pool.
+      typedef NavFilterBlockPool<(sizeof(T) + 15) / 16 * 16> Pool;
+
+      NavFilterPoolAllocator() noexcept
+      {}
+
+      template <class U>
+      NavFilterPoolAllocator(const NavFilterPoolAllocator<U>&) noexcept
+      {}
+
+         /// Allocate space for n objects, from the pool if n is 1.
+      T* allocate(std::size_t n)
+      {
+         if (n == 1)
+            return static_cast<T*>(Pool::allocate());
+         return static_cast<T*>(::operator new(n * sizeof(T)));
+      }
+
+         /// Free space obtained from allocate().
+      void deallocate(T* p, std::size_t n) noexcept
+      {
+         if (n == 1)
+            Pool::deallocate(p);
+         else
+            ::operator delete(p);
+      }
+   }; // class NavFilterPoolAllocator
+
+
+   template <class T, class U>
+   inline bool operator==(const NavFilterPoolAllocator<T>&,
+                          const NavFilterPoolAllocator<U>&) noexcept
+   { return true; }
+
+   template <class T, class U>
+   inline bool operator!=(const NavFilterPoolAllocator<T>&,
+                          const NavFilterPoolAllocator<U>&) noexcept
+   { return false; }
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // NAVFILTERPOOL_HPP
@@ -122,7 +122,9 @@ namespace gnsstk
       unsigned procDepth;
 
    protected:
-      typedef std::set<NavFilterKey*, NavTimeSort> SubframeSet;
+         /// Pooled set nodes, as one is made for every subframe.
+      typedef std::set<NavFilterKey*, NavTimeSort,
+                       NavFilterPoolAllocator<NavFilterKey*> > SubframeSet;
 
          /// Ordered set of nav message subframes
       SubframeSet orderedNav;
@@ -100,6 +100,14 @@ namespace gnsstk
       {
          unsigned idx = 0; // computed cache 1D array index
          double t = (15.0 * cacheHour - 180.0) * PI / 180.0;            //eq.49
+            // sin(k*t) and cos(k*t) are the same for every degree,
+            // so compute them once for k=[1,6].
+         double sinkt[6], coskt[6];
+         for (unsigned order = 0; order < 6; order++)
+         {
+            sinkt[order] = sin((order+1)*t);
+            coskt[order] = cos((order+1)*t);
+         }
             // compute Fourier time series for foF2
          for (unsigned degree = 0; degree < F2MaxDegree; degree++)
          {
@@ -112,10 +120,10 @@ namespace gnsstk
                   // k=[1,6] while order/index=[0,5]
                idx = degree*F2MaxOrder+(order*2+1);
                DEBUGTRACE("  j=" << order);
-               DEBUGTRACE("    term 1=" << (cacheF2[idx] * sin((order+1)*t)));
-               DEBUGTRACE("    term 2=" << (cacheF2[idx+1] * cos((order+1)*t)));
-               cacheCF2[degree] += cacheF2[idx] * sin((order+1)*t) +
-                  cacheF2[idx+1] * cos((order+1)*t);
+               DEBUGTRACE("    term 1=" << (cacheF2[idx] * sinkt[order]));
+               DEBUGTRACE("    term 2=" << (cacheF2[idx+1] * coskt[order]));
+               cacheCF2[degree] += cacheF2[idx] * sinkt[order] +
+                  cacheF2[idx+1] * coskt[order];
                DEBUGTRACE("    CF2[i] (final) = " << cacheCF2[degree]);
             }
          }
@@ -126,8 +134,8 @@ namespace gnsstk
             for (unsigned order = 0; order < 4; order++)
             {
                idx = degree*FM3MaxOrder+(order*2+1);
-               cacheCM3[degree] += cacheFM3[idx] * sin((order+1)*t) +
-                  cacheFM3[idx+1] * cos((order+1)*t);
+               cacheCM3[degree] += cacheFM3[idx] * sinkt[order] +
+                  cacheFM3[idx+1] * coskt[order];
             }
          }
          cacheFourierGood = true;
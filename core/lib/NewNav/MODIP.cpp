@@ -69,6 +69,14 @@ namespace gnsstk
    double MODIP ::
    stModip(const Position& pos)
       const
+   {
+      return stModip(pos.geodeticLatitude(), pos.longitude());
+   }
+
+
+   double MODIP ::
+   stModip(double phi, double lambda)
+      const
    {
       DEBUGTRACE_FUNCTION();
          // awk script for generating this from
@@ -295,8 +303,6 @@ namespace gnsstk
           * intentional as at one point the tweaking of longGridIdx
           * cause the attempts to compute the fractional portions led
           * to incorrect results. */
-      double phi = pos.geodeticLatitude();
-      double lambda = pos.longitude();
          // Compute the grid longitude position
       double longGridPos = (lambda + LongMax) / LongStep;               // eq.14
          // Truncate the grid longitude position to get the array index
@@ -61,6 +61,12 @@ namespace gnsstk
           * @return The modeled latitude. */
       double stModip(const Position& pos) const;
 
+         /** Get the MODIP value at a lat and lon in degrees.
+          * @param[in] phi The observer geodetic latitude in degrees.
+          * @param[in] lambda The observer longitude in degrees.
+          * @return The modeled latitude. */
+      double stModip(double phi, double lambda) const;
+
          /** Perform third-order interpolation across a set of data points.
           * @param[in] z An array of 4 points to perform interpolation over.
           * @param[in] x A fractional offset relative to z[1] that is
@@ -148,6 +148,36 @@ namespace gnsstk
    }
 
 
+   void MultiFormatNavDataFactory ::
+   freeze()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->freeze();
+         }
+      }
+   }
+
+
+   void MultiFormatNavDataFactory ::
+   thaw()
+   {
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(*myFactories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->thaw();
+         }
+      }
+   }
+
+
    CommonTime MultiFormatNavDataFactory ::
    getInitialTime() const
    {
@@ -139,6 +139,13 @@ namespace gnsstk
          /// Remove all data from the internal store.
       void clear() override;
 
+         /** Build the frozen search index of each of the factories.
+          * @see NavDataFactoryWithStore::freeze() */
+      void freeze() override;
+
+         /// Discard the frozen search index of each of the factories.
+      void thaw() override;
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @note In the case that data from multiple systems is
@@ -36,6 +36,7 @@
 //                            release, distribution is unlimited.
 //
 //==============================================================================
+#include <algorithm>
 #include <iterator>
 #include "NavDataFactoryWithStore.hpp"
 #include "TimeString.hpp"
@@ -53,6 +54,7 @@ namespace gnsstk
 {
    NavDataFactoryWithStore ::
    NavDataFactoryWithStore()
+         : frozen(false)
    {
          // We are NOT using END_OF_TIME or BEGINNING_OF_TIME here
          // because of issues with static initialization order.  As
@@ -108,6 +110,10 @@ namespace gnsstk
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
+      if (frozen)
+      {
+         return findUserFrozen(nmid, when, navData, xmitHealth, valid);
+      }
          /** Class for gathering matches in findUser().  It's only
           * used in findUser so it is declared and implemented here
           * alone. */
@@ -124,7 +130,7 @@ namespace gnsstk
          bool finished;
          NavMap::iterator it;
       };
-      typedef std::list<FindMatches> MatchList;
+      typedef std::vector<FindMatches> MatchList;
 
       DEBUGTRACE("nmid=" << nmid << "  when=" << gnsstk::printTime(when,dts));
 
@@ -294,6 +300,10 @@ namespace gnsstk
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("class: " << getClassName());
+      if (frozen)
+      {
+         return findNearestFrozen(nmid, when, navData, xmitHealth, valid);
+      }
          /** Class for gathering matches in findNearest().  It's only
           * used in findNearest so it is declared and implemented here
           * alone. */
@@ -325,7 +335,7 @@ namespace gnsstk
          NavNearMap::iterator itGT, itLT;
          const CommonTime& when;
       };
-      typedef std::list<FindMatches> MatchList;
+      typedef std::vector<FindMatches> MatchList;
 
          // dig through the maps of maps, matching keys with nmid along the way
       auto dataIt = nearestData.find(nmid.messageType);
@@ -555,6 +565,7 @@ namespace gnsstk
    void NavDataFactoryWithStore ::
    edit(const CommonTime& fromTime, const CommonTime& toTime)
    {
+      thaw();
          // edit transmit time storage
       for (auto mti = data.begin(); mti != data.end();)
       {
@@ -684,6 +695,7 @@ namespace gnsstk
    edit(const CommonTime& fromTime, const CommonTime& toTime,
         const NavSatelliteID& satID)
    {
+      thaw();
          // edit transmit time storage
       for (auto mti = data.begin(); mti != data.end();)
       {
@@ -839,6 +851,7 @@ namespace gnsstk
    void NavDataFactoryWithStore ::
    clear()
    {
+      thaw();
       data.clear();
       nearestData.clear();
       offsetData.clear();
@@ -858,6 +871,7 @@ namespace gnsstk
       TimeOffsetData *todp = nullptr;
       DEBUGTRACE("addNavData user = " << nd->getUserTime()
                  << "  nearest = " << nd->getNearTime());
+      thaw();
       SatID satID = nd->signal.sat;
          // transmit satellite to use as key
       SatID xsat(nd->signal.xmitSat);
@@ -1180,7 +1194,6 @@ namespace gnsstk
                  SVHealth xmitHealth,
                  const CommonTime& when)
    {
-      bool rv = true;
          // One last check for fit interval validity, but it only
          // applies to classes that inherit from NavFit.
       NavFit *nf = dynamic_cast<NavFit*>(ndp.get());
@@ -1191,6 +1204,30 @@ namespace gnsstk
             return false;
          }
       }
+      return validHealthCheck(ndp, valid, xmitHealth);
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   validityCheck(const FrozenEntry& fe,
+                 NavValidityType valid,
+                 SVHealth xmitHealth,
+                 const CommonTime& when)
+   {
+      if (fe.hasFit && ((when < fe.beginFit) || (when > fe.endFit)))
+      {
+         return false;
+      }
+      return validHealthCheck(fe.data, valid, xmitHealth);
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   validHealthCheck(const NavDataPtr& ndp,
+                    NavValidityType valid,
+                    SVHealth xmitHealth)
+   {
+      bool rv = true;
       switch (valid)
       {
          case NavValidityType::ValidOnly:
@@ -1454,6 +1491,408 @@ namespace gnsstk
    }
 
 
+   void NavDataFactoryWithStore ::
+   freeze()
+   {
+      DEBUGTRACE_FUNCTION();
+      thaw();
+      size_t numTypes = static_cast<size_t>(NavMessageType::Last);
+      frozenData.resize(numTypes);
+      frozenNearData.resize(numTypes);
+      for (const auto& mti : data)
+      {
+         FrozenSatIndex& fsi(frozenData[static_cast<size_t>(mti.first)]);
+         FrozenSatArray& fsa(fsi.sats);
+         fsa.reserve(mti.second.size());
+            // NavSatMap is already sorted by NavSatelliteID, so
+            // fsa is too.
+         for (const auto& sati : mti.second)
+         {
+            fsa.emplace_back();
+            FrozenNavMap& fnm(fsa.back());
+            fnm.sat = sati.first;
+            fnm.entries.reserve(sati.second.size());
+            for (const auto& ti : sati.second)
+            {
+               fnm.entries.emplace_back(ti.first, ti.second);
+            }
+         }
+         fsi.buildIndex();
+      }
+      for (const auto& mti : nearestData)
+      {
+         FrozenSatIndex& fsi(frozenNearData[static_cast<size_t>(mti.first)]);
+         FrozenSatArray& fsa(fsi.sats);
+         fsa.reserve(mti.second.size());
+         for (const auto& sati : mti.second)
+         {
+            fsa.emplace_back();
+            FrozenNavMap& fnm(fsa.back());
+            fnm.sat = sati.first;
+            fnm.groups.reserve(sati.second.size()+1);
+            for (const auto& ti : sati.second)
+            {
+               fnm.groups.push_back(fnm.entries.size());
+               for (const auto& ndpli : ti.second)
+               {
+                  fnm.entries.emplace_back(ti.first, ndpli);
+               }
+            }
+            fnm.groups.push_back(fnm.entries.size());
+         }
+         fsi.buildIndex();
+      }
+      frozen = true;
+   }
+
+
+   void NavDataFactoryWithStore ::
+   thaw()
+   {
+      frozen = false;
+      frozenData.clear();
+      frozenNearData.clear();
+   }
+
+
+   NavDataFactoryWithStore::FrozenEntry ::
+   FrozenEntry(const CommonTime& t, const NavDataPtr& ndp)
+         : time(t), hasFit(false), data(ndp)
+   {
+      NavFit *nf = dynamic_cast<NavFit*>(ndp.get());
+      if (nf != nullptr)
+      {
+         hasFit = true;
+         beginFit = nf->beginFit;
+         endFit = nf->endFit;
+      }
+   }
+
+
+   void NavDataFactoryWithStore::FrozenSatIndex ::
+   buildIndex()
+   {
+      bySat.clear();
+      wildSats.clear();
+      for (size_t i = 0; i < sats.size(); i++)
+      {
+         const SatID& sat(sats[i].sat.sat);
+         if (sat.isWild())
+         {
+            wildSats.push_back(i);
+         }
+         else
+         {
+            bySat[satKey(sat)].push_back(i);
+         }
+      }
+   }
+
+
+   void NavDataFactoryWithStore::FrozenSatIndex ::
+   getCandidates(const NavSatelliteID& nsid, FrozenCandidates& cands) const
+   {
+      if (nsid.sat.isWild())
+      {
+            // Can't use the index, so fall back on a linear search.
+         for (const auto& fnm : sats)
+         {
+            if (fnm.sat == nsid)
+            {
+               cands.push_back(&fnm);
+            }
+         }
+         return;
+      }
+      static const std::vector<size_t> empty;
+      auto bsi = bySat.find(satKey(nsid.sat));
+      const std::vector<size_t>& bucket(
+         bsi == bySat.end() ? empty : bsi->second);
+         // Merge the bucket with wildSats, preserving the order of
+         // sats so that the results are the same as a linear search.
+      cands.reserve(cands.size() + bucket.size() + wildSats.size());
+      auto bi = bucket.begin();
+      auto wi = wildSats.begin();
+      while ((bi != bucket.end()) || (wi != wildSats.end()))
+      {
+         size_t idx;
+         if ((wi == wildSats.end()) ||
+             ((bi != bucket.end()) && (*bi < *wi)))
+         {
+            idx = *bi++;
+         }
+         else
+         {
+            idx = *wi++;
+         }
+         if (sats[idx].sat == nsid)
+         {
+            cands.push_back(&sats[idx]);
+         }
+      }
+   }
+
+
+   NavDataFactoryWithStore::FrozenNavMap* NavDataFactoryWithStore ::
+   findFrozen(FrozenMessageArray& fma, const NavMessageID& nmid)
+   {
+      size_t idx = static_cast<size_t>(nmid.messageType);
+      if (idx >= fma.size())
+      {
+         return nullptr;
+      }
+      FrozenSatArray& fsa(fma[idx].sats);
+      const NavSatelliteID& key(nmid);
+      auto fnmi = std::lower_bound(
+         fsa.begin(), fsa.end(), key,
+         [](const FrozenNavMap& fnm, const NavSatelliteID& k)
+         { return fnm.sat < k; });
+      if ((fnmi == fsa.end()) || (key < fnmi->sat))
+      {
+         return nullptr;
+      }
+      return &(*fnmi);
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   findUserFrozen(const NavMessageID& nmid, const CommonTime& when,
+                  NavDataPtr& navData, SVHealth xmitHealth,
+                  NavValidityType valid)
+   {
+      DEBUGTRACE_FUNCTION();
+         /** Class for gathering matches in findUserFrozen().  This
+          * is the same as FindMatches in findUser(), except that the
+          * iterator is replaced by an index into the frozen array,
+          * with npos taking the place of end(). */
+      class FindMatches
+      {
+      public:
+         FindMatches(const FrozenNavArray *theArr, size_t theIdx)
+               : arr(theArr), finished(false), idx(theIdx)
+         {}
+         const FrozenNavArray *arr;
+         bool finished;
+         size_t idx;
+      };
+      typedef std::vector<FindMatches> MatchList;
+      static const size_t npos = static_cast<size_t>(-1);
+      size_t mtIdx = static_cast<size_t>(nmid.messageType);
+      if (mtIdx >= frozenData.size())
+      {
+         return false;
+      }
+         // Index of the last entry at or before when, or npos if none.
+      auto lastAtOrBefore = [&when](const FrozenNavArray& fna) -> size_t
+      {
+         auto ti = std::upper_bound(
+            fna.begin(), fna.end(), when,
+            [](const CommonTime& t, const FrozenEntry& fe)
+            { return t < fe.time; });
+         return (ti == fna.begin()
+                 ? npos
+                 : static_cast<size_t>(ti - fna.begin()) - 1);
+      };
+      MatchList itList;
+      if (nmid.isWild())
+      {
+         DEBUGTRACE("wildcard search: " << nmid);
+         FrozenCandidates cands;
+         frozenData[mtIdx].getCandidates(nmid, cands);
+         itList.reserve(cands.size());
+         for (const auto& fnm : cands)
+         {
+            size_t idx = lastAtOrBefore(fnm->entries);
+            if (idx != npos)
+            {
+               itList.push_back(FindMatches(&fnm->entries, idx));
+            }
+         }
+      }
+      else
+      {
+         DEBUGTRACE("non-wildcard search: " << nmid);
+         FrozenNavMap *fnm = findFrozen(frozenData, nmid);
+         if (fnm != nullptr)
+         {
+            size_t idx = lastAtOrBefore(fnm->entries);
+            if (idx != npos)
+            {
+               itList.push_back(FindMatches(&fnm->entries, idx));
+            }
+         }
+      }
+      DEBUGTRACE("itList.size() = " << itList.size());
+      gnsstk::CommonTime mostRecent = gnsstk::CommonTime::BEGINNING_OF_TIME;
+      mostRecent.setTimeSystem(gnsstk::TimeSystem::Any);
+      bool done = itList.empty();
+      bool rv = false;
+         // This loop intentionally mirrors the one in findUser() so
+         // that results are identical.
+      while (!done)
+      {
+         for (auto& imi : itList)
+         {
+            done = true; // default to being done.  Gets reset to false below.
+            if (imi.finished)
+            {
+                  // no need to process this iterator any further
+               continue;
+            }
+            else if ((imi.idx != npos) &&
+                     ((*imi.arr)[imi.idx].time < mostRecent))
+            {
+                  // Data is less recent than the most recent good data, so stop
+                  // processing this iterator.
+               imi.finished = true;
+            }
+            else if (((imi.idx != npos) &&
+                      ((*imi.arr)[imi.idx].time > when)) ||
+                     ((imi.idx != npos) &&
+                      !validityCheck((*imi.arr)[imi.idx], valid, xmitHealth,
+                                     when)))
+            {
+               imi.idx = (imi.idx == 0 ? npos : imi.idx-1);
+               done = false;
+            }
+            else if (imi.idx == npos)
+            {
+                  // give up.
+               imi.finished = true;
+            }
+            else
+            {
+               const FrozenEntry& fe((*imi.arr)[imi.idx]);
+               if (fe.time > mostRecent)
+               {
+                  mostRecent = fe.time;
+                  navData = fe.data;
+                  DEBUGTRACE("result is now " << navData->signal);
+               }
+               imi.finished = true;
+               rv = true;
+            }
+         }
+      }
+      return rv;
+   }
+
+
+   bool NavDataFactoryWithStore ::
+   findNearestFrozen(const NavMessageID& nmid, const CommonTime& when,
+                     NavDataPtr& navData, SVHealth xmitHealth,
+                     NavValidityType valid)
+   {
+      DEBUGTRACE_FUNCTION();
+      static const size_t npos = static_cast<size_t>(-1);
+         /** Class for gathering matches in findNearestFrozen().  This
+          * is the same as FindMatches in findNearest(), except that
+          * the iterators are replaced by indices into
+          * FrozenNavMap::groups, with npos taking the place of
+          * end(). */
+      class FindMatches
+      {
+      public:
+         FindMatches(const FrozenNavMap *theMap, size_t theGT)
+               : map(theMap), itGT(theGT)
+         {
+            size_t numGroups = map->groups.size()-1;
+            if (itGT == numGroups)
+               itGT = npos;
+               // set the "less than" index to an appropriate value
+            itLT = (theGT == 0 ? npos : theGT-1);
+         }
+            /// Get the time of the given group.
+         const CommonTime& groupTime(size_t g) const
+         { return map->entries[map->groups[g]].time; }
+         const FrozenNavMap *map;
+         size_t itGT, itLT;
+      };
+      typedef std::vector<FindMatches> MatchList;
+      size_t mtIdx = static_cast<size_t>(nmid.messageType);
+      if (mtIdx >= frozenNearData.size())
+      {
+         return false;
+      }
+         // Index of the first group at or after when.
+      auto firstAtOrAfter = [&when](const FrozenNavMap& fnm) -> size_t
+      {
+         auto gi = std::lower_bound(
+            fnm.groups.begin(), fnm.groups.end()-1, when,
+            [&fnm](size_t g, const CommonTime& t)
+            { return fnm.entries[g].time < t; });
+         return static_cast<size_t>(gi - fnm.groups.begin());
+      };
+      MatchList itList;
+      if (nmid.isWild())
+      {
+         DEBUGTRACE("wildcard search: " << nmid);
+         FrozenCandidates cands;
+         frozenNearData[mtIdx].getCandidates(nmid, cands);
+         itList.reserve(cands.size());
+         for (const auto& fnm : cands)
+         {
+            itList.push_back(FindMatches(fnm, firstAtOrAfter(*fnm)));
+         }
+      }
+      else
+      {
+         DEBUGTRACE("non-wildcard search: " << nmid);
+         FrozenNavMap *fnm = findFrozen(frozenNearData, nmid);
+         if (fnm != nullptr)
+         {
+            itList.push_back(FindMatches(fnm, firstAtOrAfter(*fnm)));
+         }
+      }
+         // This loop intentionally mirrors the one in findNearest()
+         // so that results are identical.
+      bool done = itList.empty();
+      while (!done)
+      {
+         for (auto& imi : itList)
+         {
+            done = true; // default to being done.  Gets reset to false below.
+            if ((imi.itGT == npos) && (imi.itLT == npos))
+            {
+                  // nothing more to do, we've reached the end of both
+                  // directions
+               break;
+            }
+            size_t grp;
+            if ((imi.itGT != npos) &&
+                ((imi.itLT == npos) ||
+                 (fabs(imi.groupTime(imi.itGT) - when) <
+                  fabs(imi.groupTime(imi.itLT) - when))))
+            {
+                  // time for itGT is nearer to time of interest, try it first.
+               grp = imi.itGT;
+               imi.itGT = (imi.itGT+2 == imi.map->groups.size()
+                           ? npos : imi.itGT+1);
+            }
+            else
+            {
+                  // time for itLT is nearer to time of interest, try it first.
+               grp = imi.itLT;
+               imi.itLT = (imi.itLT == 0 ? npos : imi.itLT-1);
+            }
+            for (size_t i = imi.map->groups[grp]; i < imi.map->groups[grp+1];
+                 i++)
+            {
+               if (validityCheck(imi.map->entries[i], valid, xmitHealth, when))
+               {
+                     // got a match
+                  navData = imi.map->entries[i].data;
+                  return true;
+               }
+            }
+               // no match, so try the next nearest group
+            done = false;
+         }
+      }
+      return false;
+   }
+
+
    void NavDataFactoryWithStore ::
    dump(std::ostream& s, DumpDetail dl) const
    {
@@ -39,6 +39,8 @@
 #ifndef GNSSTK_NAVDATAFACTORYWITHSTORE_HPP
 #define GNSSTK_NAVDATAFACTORYWITHSTORE_HPP
 
+#include <unordered_map>
+#include <vector>
 #include "NavDataFactory.hpp"
 #include "TimeOffsetData.hpp"
 #include "StdNavTimeOffset.hpp"
@@ -353,6 +355,34 @@ namespace gnsstk
           * @return The resulting NavMap if available or nullptr if not. */
       const NavMap* getNavMap(const NavMessageID& nmid) const;
 
+         /** Build a compact, read-only search index from the
+          * contents of the store.  Once loading is complete, calling
+          * this method copies the nav data into contiguous
+          * per-satellite arrays sorted by time, with the search
+          * times and fit intervals stored inline, so that find() can
+          * use binary searches rather than walking the nested maps.
+          * The search results are identical to those of the unfrozen
+          * store.
+          * @note Any subsequent change to the store via addNavData(),
+          *   edit() or clear() discards the index.  Call freeze()
+          *   again after making changes.
+          * @note The index holds additional references to the nav
+          *   data, so the store's memory use increases somewhat
+          *   while frozen.
+          * @note While frozen, find() and the other search methods
+          *   do not modify the store and may be called concurrently
+          *   from multiple threads, as long as no thread modifies
+          *   the store at the same time. */
+      virtual void freeze();
+
+         /// Discard the search index created by freeze(), if any.
+      virtual void thaw();
+
+         /** Return true if the search index is current, i.e. freeze()
+          * has been called and the store has not been changed since. */
+      bool isFrozen() const
+      { return frozen; }
+
    protected:
          /** Search the store to find the navigation message that meets
           * the specified criteria using User-oriented data.
@@ -452,6 +482,129 @@ namespace gnsstk
           * @post initialTime and/or finalTime may be updated. */
       bool updateInitialFinal(const CommonTime& begin, const CommonTime& end);
 
+         /** A single nav message in the frozen search index.  The
+          * time the entry is sorted by and the fit interval, if any,
+          * are copied inline so that searches don't have to go
+          * through the NavDataPtr to reject most entries. */
+      class FrozenEntry
+      {
+      public:
+            /** Copy the search information for a nav message.
+             * @param[in] t The time the message is sorted by (user
+             *   time or nearest time, depending on the index).
+             * @param[in] ndp The nav message. */
+         FrozenEntry(const CommonTime& t, const NavDataPtr& ndp);
+         CommonTime time;     ///< User or nearest time of data.
+         CommonTime beginFit; ///< Copy of NavFit::beginFit if hasFit.
+         CommonTime endFit;   ///< Copy of NavFit::endFit if hasFit.
+         bool hasFit;         ///< true if data is derived from NavFit.
+         NavDataPtr data;     ///< The nav message.
+      };
+         /// Time-ordered nav messages for a single satellite/signal.
+      typedef std::vector<FrozenEntry> FrozenNavArray;
+         /** Frozen equivalent of a NavMap or NavNearMap for one
+          * NavSatelliteID. */
+      class FrozenNavMap
+      {
+      public:
+            /// Key in the NavSatMap or NavNearSatMap this came from.
+         NavSatelliteID sat;
+            /// All the nav data for sat, sorted by time.
+         FrozenNavArray entries;
+            /** Nearest index only, the index in entries of the
+             * first of each run of identical times, terminated by
+             * entries.size().  This is equivalent to the keys of a
+             * NavNearMap. */
+         std::vector<size_t> groups;
+      };
+         /** Frozen equivalent of a NavSatMap or NavNearSatMap,
+          * sorted by NavSatelliteID. */
+      typedef std::vector<FrozenNavMap> FrozenSatArray;
+         /// Pointers to the FrozenNavMap objects matching a search.
+      typedef std::vector<const FrozenNavMap*> FrozenCandidates;
+         /** Frozen data for a single NavMessageType, along with a
+          * secondary index by subject satellite so that searches
+          * with wildcard signals, transmit satellites, etc. only
+          * need to look at the data for the satellite of interest
+          * rather than everything. */
+      class FrozenSatIndex
+      {
+      public:
+            /// Build bySat and wildSats from the contents of sats.
+         void buildIndex();
+            /** Get the data matching a possibly wildcard
+             * NavSatelliteID, in the same order as a linear search
+             * of sats would yield.
+             * @param[in] nsid The satellite/signal to match.
+             * @param[out] cands The matching data is appended here. */
+         void getCandidates(const NavSatelliteID& nsid,
+                            FrozenCandidates& cands) const;
+            /// Get the key used in bySat for a given subject satellite.
+         static uint64_t satKey(const SatID& sat)
+         {
+            return ((static_cast<uint64_t>(sat.system) << 32) |
+                    static_cast<uint32_t>(sat.id));
+         }
+            /// All data for this message type, sorted by NavSatelliteID.
+         FrozenSatArray sats;
+            /** Indices into sats, in increasing order, of the data
+             * for each subject satellite, keyed by satKey(). */
+         std::unordered_map<uint64_t, std::vector<size_t> > bySat;
+            /** Indices into sats, in increasing order, of the data
+             * whose subject satellite is itself a wildcard and thus
+             * can't be found via bySat. */
+         std::vector<size_t> wildSats;
+      };
+         /// Frozen NavSatMaps indexed by NavMessageType.
+      typedef std::vector<FrozenSatIndex> FrozenMessageArray;
+
+         /** Locate the frozen data for a non-wildcard NavSatelliteID.
+          * @param[in] fma The frozen index to search.
+          * @param[in] nmid The message type and satellite to look for.
+          * @return A pointer to the matching data or nullptr if none. */
+      static FrozenNavMap* findFrozen(FrozenMessageArray& fma,
+                                      const NavMessageID& nmid);
+
+         /// findUser() implementation using the frozen index.
+      bool findUserFrozen(const NavMessageID& nmid, const CommonTime& when,
+                          NavDataPtr& navData, SVHealth xmitHealth,
+                          NavValidityType valid);
+
+         /// findNearest() implementation using the frozen index.
+      bool findNearestFrozen(const NavMessageID& nmid, const CommonTime& when,
+                             NavDataPtr& navData, SVHealth xmitHealth,
+                             NavValidityType valid);
+
+         /** Performs an appropriate validity check based on the
+          * desired validity, using the fit interval stored in the
+          * frozen index rather than casting the nav data.
+          * @param[in] fe The frozen index entry to check.
+          * @param[in] valid The desired validity for navigation data.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] when The time of interest.
+          * @return true if the validity of fe matches the requested
+          *   validity described by valid and the health status of the
+          *   transmitting satellite matches xmitHealth. */
+      bool validityCheck(const FrozenEntry& fe,
+                         NavValidityType valid,
+                         SVHealth xmitHealth,
+                         const CommonTime& when);
+
+         /** Check the validity and transmitting satellite health of
+          * nav data, without regard to fit interval.
+          * @param[in] ndp The NavDataPtr object whose validity is to
+          *   be checked.
+          * @param[in] valid The desired validity for navigation data.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @return true if the validity of ndp matches the requested
+          *   validity described by valid and the health status of the
+          *   transmitting satellite matches xmitHealth. */
+      bool validHealthCheck(const NavDataPtr& ndp,
+                            NavValidityType valid,
+                            SVHealth xmitHealth);
+
          /// Internal storage of navigation data for User searches
       NavMessageMap data;
          /// Internal storage of navigation data for Nearest searches
@@ -465,6 +618,12 @@ namespace gnsstk
       CommonTime finalTime;
          /// Map subject satellite ID to time stamp pair (oldest,newest).
       std::map<SatID,std::pair<CommonTime,CommonTime> > firstLastMap;
+         /// true if frozenData and frozenNearData are current.
+      bool frozen;
+         /// Frozen search index of data for User searches.
+      FrozenMessageArray frozenData;
+         /// Frozen search index of nearestData for Nearest searches.
+      FrozenMessageArray frozenNearData;
 
          /// Grant access to MultiFormatNavDataFactory for various functions.
       friend class MultiFormatNavDataFactory;
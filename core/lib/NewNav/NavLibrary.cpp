@@ -37,6 +37,7 @@
 //
 //==============================================================================
 #include "NavLibrary.hpp"
+#include "NavDataFactoryWithStore.hpp"
 #include "OrbitData.hpp"
 #include "NavHealthData.hpp"
 #include "TimeOffsetData.hpp"
@@ -48,6 +49,9 @@
 
 namespace gnsstk
 {
+   const size_t NavLibrary::minXvtsPerThread = 500;
+
+
    bool NavLibrary ::
    getXvt(const NavSatelliteID& sat, const CommonTime& when, Xvt& xvt,
           bool useAlm, SVHealth xmitHealth, NavValidityType valid,
@@ -108,6 +112,55 @@ namespace gnsstk
    }
 
 
+   size_t NavLibrary ::
+   getXvts(const std::vector<NavSatelliteID>& sats,
+           const std::vector<CommonTime>& times, std::vector<Xvt>& xvts,
+           const ObsID& oid, SVHealth xmitHealth, NavValidityType valid,
+           NavSearchOrder order, ThreadPool *pool)
+   {
+      DEBUGTRACE_FUNCTION();
+      const size_t numTimes = times.size();
+      xvts.assign(sats.size() * numTimes, Xvt());
+      std::vector<size_t> counts(sats.size(), 0);
+         // Compute the Xvts for the satellites in [first,last),
+         // counting the successes for each satellite.
+      auto worker = [&](size_t first, size_t last)
+      {
+         for (size_t i = first; i < last; i++)
+         {
+            Xvt *out = &xvts[i * numTimes];
+            for (size_t j = 0; j < numTimes; j++)
+            {
+               if (getXvt(sats[i], times[j], out[j], oid, xmitHealth, valid,
+                          order))
+               {
+                  counts[i]++;
+               }
+               else
+               {
+                  out[j].health = Xvt::Unavailable;
+               }
+            }
+         }
+      };
+      if ((pool == nullptr) || (numTimes == 0))
+      {
+         worker(0, sats.size());
+      }
+      else
+      {
+         pool->run(sats.size(), worker,
+                   (minXvtsPerThread + numTimes - 1) / numTimes);
+      }
+      size_t rv = 0;
+      for (size_t count : counts)
+      {
+         rv += count;
+      }
+      return rv;
+   }
+
+
    bool NavLibrary ::
    getHealth(const NavSatelliteID& sat, const CommonTime& when,
              SVHealth& healthOut, SVHealth xmitHealth, NavValidityType valid,
@@ -537,6 +590,22 @@ namespace gnsstk
    }
 
 
+   void NavLibrary ::
+   freeze()
+   {
+      DEBUGTRACE_FUNCTION();
+      for (auto& fi : NDFUniqIterator<NavDataFactoryMap>(factories))
+      {
+         NavDataFactoryWithStore *ndfs =
+            dynamic_cast<NavDataFactoryWithStore*>(fi.second.get());
+         if (ndfs != nullptr)
+         {
+            ndfs->freeze();
+         }
+      }
+   }
+
+
    CommonTime NavLibrary ::
    getInitialTime() const
    {
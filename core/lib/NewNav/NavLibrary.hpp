@@ -43,6 +43,8 @@
 #include "Xvt.hpp"
 #include "SVHealth.hpp"
 #include "Position.hpp"
+#include "ThreadPool.hpp"
+#include <vector>
 
 namespace gnsstk
 {
@@ -738,6 +740,41 @@ namespace gnsstk
        * @todo Determine if a URA in meters should be added to
        * OrbitDataKepler or OrbitData.
        *
+       * @section NavFactoryThreads Concurrent Searches
+       *
+       * A single NavLibrary may be searched from many threads at once
+       * so that large data sets need only be loaded into memory one
+       * time.  To do so:
+       *
+       * \li Load all the nav data and configure all the filters
+       *     (NavLibrary::setValidityFilter(),
+       *     NavLibrary::setTypeFilter() etc.) from a single thread.
+       * \li Call NavLibrary::freeze() to seal the data.  This
+       *     builds the read-only search index in each factory that
+       *     supports it.
+       * \li Call any of the search methods (find(), getXvt(),
+       *     getXvts(), getHealth(), getOffset(), getIonoCorr(),
+       *     getISC() and so on) from any number of threads.  No
+       *     locks are taken on this path.  Each call's results are
+       *     identical to those of the same call in a single thread.
+       *
+       * While the searches are running, nothing may modify the
+       * library or its factories.  This includes adding factories,
+       * loading data, changing filters, NavLibrary::edit() and
+       * NavLibrary::clear().  Any such change requires that all the
+       * searching threads have finished first.  Changes to the data
+       * also discard the frozen index, so freeze() should be called
+       * again before resuming concurrent searches.
+       *
+       * The NavData objects returned by find() are shared between
+       * threads and should be treated as read-only.  Some factories,
+       * e.g. SP3NavDataFactory, construct a new object for each
+       * search, but this requires no synchronization.  The
+       * exception is the optional SP3NavDataFactory interpolation
+       * cache (see SP3NavDataFactory::setInterpCacheSize()), which
+       * when enabled is briefly locked by each search of that
+       * factory.
+       *
        * @section NavFactoryDesignOverview NavFactory Design Overview
        *
        * The NavFactory classes are designed with several goals in
@@ -1043,6 +1080,64 @@ namespace gnsstk
                   NavValidityType valid = NavValidityType::ValidOnly,
                   NavSearchOrder order = NavSearchOrder::User);
 
+         /** Get the position and velocity of many satellites at many
+          * times.  Each result is identical to what would be obtained
+          * by calling getXvt(const NavSatelliteID&, const CommonTime&,
+          * Xvt&, const ObsID&, SVHealth, NavValidityType,
+          * NavSearchOrder) for each satellite and time, but the
+          * computation is done one satellite at a time, all times in
+          * turn, and optionally distributed over the threads of a
+          * ThreadPool.
+          *
+          * Every result does its own search, as in getXvt(): in
+          * receiver (User) order a newer ephemeris may become
+          * available in the middle of the previous one's fit
+          * interval, so reusing the message found for the previous
+          * time would change the results.
+          * @warning When using a pool, the nav data
+          *   must not be modified (e.g. by loading data, edit() or
+          *   clear()) until this method returns.  Searches are
+          *   fastest when freeze() has been called first.
+          * @param[in] sats Satellites to get the position/velocity for.
+          * @param[in] times The times that the position should be
+          *   computed for.  These should be in increasing order for
+          *   best performance.
+          * @param[out] xvts The computed position and velocity of each
+          *   satellite at each time.  This will be resized to
+          *   sats.size()*times.size() and the result for sats[i] at
+          *   times[j] is stored in xvts[i*times.size()+j].  Any
+          *   results that couldn't be computed have their health set
+          *   to Xvt::Unavailable.
+          * @param[in] oid When it is possible to have different
+          *   antenna phase centers on a single SV, this parameter
+          *   allows you to specify a different APC than the
+          *   navigation data was being transmitted from.
+          * @param[in] xmitHealth The desired health status of the
+          *   transmitting satellite.
+          * @param[in] valid Specify whether to search only for valid
+          *   or invalid messages, or both.
+          * @param[in] order Specify whether to search by receiver
+          *   behavior or by nearest to when in time.
+          * @param[in] pool If not null, the satellites are divided
+          *   evenly among the pool's threads, giving each thread at
+          *   least minXvtsPerThread results.  Smaller batches are
+          *   computed by the calling thread alone.  Reuse one pool
+          *   for many calls rather than creating one per call.
+          * @return The number of results that were successfully
+          *   computed. */
+      size_t getXvts(const std::vector<NavSatelliteID>& sats,
+                     const std::vector<CommonTime>& times,
+                     std::vector<Xvt>& xvts, const ObsID& oid = ObsID(),
+                     SVHealth xmitHealth = SVHealth::Any,
+                     NavValidityType valid = NavValidityType::ValidOnly,
+                     NavSearchOrder order = NavSearchOrder::User,
+                     ThreadPool *pool = nullptr);
+
+         /** The smallest number of results getXvts() gives to a
+          * thread.  Below this, waking another thread costs more
+          * than it saves. */
+      static const size_t minXvtsPerThread;
+
          /** Get the health status of a satellite at a specific time.
           * @param[in] sat Satellite to get the health status for.
           * @param[in] when The time that the health should be retrieved.
@@ -1307,6 +1402,14 @@ namespace gnsstk
          /// Remove all data from the library's factories.
       void clear();
 
+         /** Build the frozen search index in each of the library's
+          * factories that supports it.  This should be called after
+          * all the nav data has been loaded, and must be called
+          * before searching from multiple threads.
+          * @see NavDataFactoryWithStore::freeze()
+          * @see \ref NavFactoryThreads */
+      void freeze();
+
          /** Determine the earliest time for which this object can successfully
           * determine the Xvt for any object.
           * @return The initial time, or CommonTime::END_OF_TIME if no
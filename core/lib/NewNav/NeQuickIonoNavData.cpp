@@ -194,6 +194,24 @@ namespace gnsstk
    }
 
 
+   void NeQuickIonoNavData ::
+   getIonoCorr(const CommonTime& when,
+               const Position& rxgeo,
+               const std::vector<Position>& svgeo,
+               CarrierBand band,
+               std::vector<double>& corr) const
+   {
+      DEBUGTRACE_FUNCTION();
+      getTEC(when, rxgeo, svgeo, corr);
+         // Obtain correction by converting STEC to code delay
+      double f = getFrequency(band);
+      for (unsigned i = 0; i < corr.size(); i++)
+      {
+         corr[i] = corr[i] * TECU_SCALE_FACTOR * 40.3/(f*f);            // eq.1
+      }
+   }
+
+
    double NeQuickIonoNavData ::
    getTEC(const CommonTime& when,
           const Position& rxgeo,
@@ -201,11 +219,41 @@ namespace gnsstk
       const
    {
       DEBUGTRACE_FUNCTION();
-         // Get the time in civil units for later math
-      CivilTime civ(when);
-         // Obtain receiver modified dip latitude
-      MODIP modip;
-      CCIR ccir;
+      EpochParameters ep(*this, when, rxgeo);
+      double rv = integrateRay(rxgeo, svgeo, ep);
+         // scale as per eq.151 and eq.202
+      rv *= TEC_SCALE_FACTOR;
+      return rv;
+   }
+
+
+   void NeQuickIonoNavData ::
+   getTEC(const CommonTime& when,
+          const Position& rxgeo,
+          const std::vector<Position>& svgeo,
+          std::vector<double>& tec)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
+         // Everything that depends only on the time and the receiver
+         // is computed here, once, rather than for every satellite.
+      EpochParameters ep(*this, when, rxgeo);
+      tec.resize(svgeo.size());
+      for (unsigned i = 0; i < svgeo.size(); i++)
+      {
+         double rv = integrateRay(rxgeo, svgeo[i], ep);
+            // scale as per eq.151 and eq.202
+         tec[i] = rv * TEC_SCALE_FACTOR;
+      }
+   }
+
+
+   double NeQuickIonoNavData ::
+   integrateRay(const Position& rxgeo, const Position& svgeo,
+                const EpochParameters& ep)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
          // pre-determine in a somewhat clumsy, but probably faster
          // method than elevation() if the satellite is directly above
          // the station.
@@ -215,10 +263,7 @@ namespace gnsstk
           (fabs(svgeo.longitude()-rxgeo.longitude()) < ABOVE_ELEV_EPSILON));
       Position Pp(rxgeo.getRayPerigee(svgeo));
       IntegrationParameters ip(rxgeo, svgeo, Pp, vertical);
-      DEBUGTRACE("computing azu");
-      double modip_u = modip.stModip(rxgeo);
-      double azu = getEffIonoLevel(modip_u);
-      DEBUGTRACE("azu = " << azu);
+      DEBUGTRACE("azu = " << ep.azu);
       DEBUGTRACE("vertical=" << vertical);
       DEBUGTRACE("rxgeo.geodeticLatitude()=" << rxgeo.geodeticLatitude());
       DEBUGTRACE("rxgeo.longitude()=" << rxgeo.longitude());
@@ -237,7 +282,7 @@ namespace gnsstk
       DEBUGTRACE("pPosition->longitude.cos=" << scientific << debugAngle.cos());
       DEBUGTRACE("pPosition->height()=" << scientific << (rxgeo.height() / 1000.0));
       DEBUGTRACE("pPosition->radius_km()=" << scientific << (rxgeo.radius() / 1000.0));
-      DEBUGTRACE("# pContext->modip_degree=" << scientific << modip_u);
+      DEBUGTRACE("# pContext->modip_degree=" << scientific << ep.modip_u);
       DEBUGTRACE("# a_sfu[0]=" << scientific << ai[0]);
       DEBUGTRACE("# a_sfu[1]=" << scientific << ai[1]);
       DEBUGTRACE("# a_sfu[2]=" << scientific << ai[2]);
@@ -249,12 +294,10 @@ namespace gnsstk
          {
             rv += integrateGaussKronrod(ip.integHeights[i-1],
                                         ip.integHeights[i],
-                                        rxgeo, svgeo, modip, modip_u, ccir, civ,
-                                        azu, ip.intThresh[i-1], vertical);
+                                        rxgeo, ip, ep,
+                                        ip.intThresh[i-1], vertical);
          }
       }
-         // scale as per eq.151 and eq.202
-      rv *= TEC_SCALE_FACTOR;
       return rv;
    }
 
@@ -282,18 +325,24 @@ namespace gnsstk
 
 
    double NeQuickIonoNavData ::
-   getSED(double dist, const Position& rxgeo, const Position& svgeo,
-          const MODIP& modip, CCIR& ccirData, const CivilTime& when,
-          double azu)
+   getSED(double dist, const Position& rxgeo, const IntegrationParameters& ip,
+          const EpochParameters& ep)
       const
    {
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("height_km=" << setprecision(15) << dist);
-      Position current(rxgeo.getRayPosition(dist * 1000.0, svgeo));
-      double modip_u = modip.stModip(current);
+      Position current(ip.getRayPosition(dist * 1000.0, rxgeo));
+         // Take the longitude before converting, as the conversion
+         // zeroes it at the poles.  Everything else is wanted in
+         // geodetic coordinates, so convert once rather than in
+         // every accessor call below.
+      double lambda = current.longitude();
+      current.transformTo(Position::Geodetic);
+      double phi = current.geodeticLatitude();
+      double modip_u = ep.modip.stModip(phi, lambda);
       DEBUGTRACE("constructing SED iono");
-      ModelParameters iono(modip_u, current, azu, ccirData, when);
-      double electronDensity = iono.electronDensity(current);
+      ModelParameters iono(modip_u, phi, lambda, ep);
+      double electronDensity = iono.electronDensity(current.height() / 1000.0);
       DEBUGTRACE("electron density=" << setprecision(15) << scientific
                  << electronDensity);
       return electronDensity;
@@ -301,9 +350,7 @@ namespace gnsstk
 
 
    double NeQuickIonoNavData ::
-   getVED(double dist, const Position& rxgeo, const Position& svgeo,
-          double modip_u, CCIR& ccirData, const CivilTime& when,
-          double azu)
+   getVED(double dist, const Position& rxgeo, const EpochParameters& ep)
       const
    {
       DEBUGTRACE_FUNCTION();
@@ -312,8 +359,9 @@ namespace gnsstk
       Position current(rxgeo.geocentricLatitude(), rxgeo.longitude(), dist*1000,
                        Position::Geodetic, &elModel);
       DEBUGTRACE("constructing VED iono");
-      ModelParameters iono(modip_u, current, azu, ccirData, when);
-      double electronDensity = iono.electronDensity(current);
+      ModelParameters iono(ep.modip_u, current.geodeticLatitude(),
+                           current.longitude(), ep);
+      double electronDensity = iono.electronDensity(current.height() / 1000.0);
       return electronDensity;
    }
 
@@ -333,20 +381,61 @@ namespace gnsstk
    }
 
 
+   NeQuickIonoNavData::EpochParameters ::
+   EpochParameters(const NeQuickIonoNavData& nav, const CommonTime& when,
+                   const Position& rxgeo)
+         : civ(when),
+           utHour(civ.getUTHour()),
+           deltaSun(ModelParameters::solarDeclination(civ)),
+           modip_u(modip.stModip(rxgeo)),
+           azu(nav.getEffIonoLevel(modip_u)),
+           azr(sqrt(167273+(azu-DEFAULT_IONO_LEVEL)*1123.6)-408.99)     //eq.19
+   {
+      DEBUGTRACE_FUNCTION();
+         // The Fourier coefficients depend only on the time and Azr,
+         // so compute them once here for every ModelParameters that
+         // refers to this object.
+      ccir.fourier(civ, azr);
+   }
+
+
    NeQuickIonoNavData::ModelParameters ::
    ModelParameters(double modip_u, const Position& pos, double az,
                    CCIR& ccirData, const CivilTime& when)
-         : fXeff(effSolarZenithAngle(pos,when)),
-           ffoF1(0.0), // default to 0, see eq.37
-           ccir(ccirData)
+         : ccir(ccirData),
+           fAzr(sqrt(167273+(az-DEFAULT_IONO_LEVEL)*1123.6)-408.99),    //eq.19
+           fXeff(effSolarZenithAngle(pos,when))
    {
       DEBUGTRACE_FUNCTION();
-      int seas;
       DEBUGTRACE("pos = " << pos);
+         // Compute the fourier time series for foF2 and M(3000)F2
+      ccirData.fourier(when, fAzr);
+      compute(modip_u, pos.geodeticLatitude(), pos.longitude(), az,
+              when.month);
+   }
+
+
+   NeQuickIonoNavData::ModelParameters ::
+   ModelParameters(double modip_u, double phi, double lambda,
+                   const EpochParameters& ep)
+         : ccir(ep.ccir),
+           fAzr(ep.azr),
+           fXeff(effSolarZenithAngle(phi, lambda, ep.utHour, ep.deltaSun))
+   {
+      DEBUGTRACE_FUNCTION();
+      compute(modip_u, phi, lambda, ep.azu, ep.civ.month);
+   }
+
+
+   void NeQuickIonoNavData::ModelParameters ::
+   compute(double modip_u, double phi, double lambda, double az,
+           unsigned month)
+   {
+      DEBUGTRACE_FUNCTION();
+      int seas;
       DEBUGTRACE("solar_12_month_running_mean_of_2800_MHZ_noise_flux=" << az);
-         // get the effective sunspot number
-      fAzr = sqrt(167273+(az-DEFAULT_IONO_LEVEL)*1123.6)-408.99;        // eq.19
-      switch (when.month)
+      ffoF1 = 0.0; // default to 0, see eq.37
+      switch (month)
       {
          case 1:
          case 2:
@@ -370,8 +459,6 @@ namespace gnsstk
             GNSSTK_THROW(Exception("Invalid month"));
             break;
       }
-      double phi = pos.geodeticLatitude();
-      double lambda = pos.longitude();
       DEBUGTRACE("power=" << (0.3 * phi));
       DEBUGTRACE("# pSolar_activity->effective_ionisation_level_sfu="
                  << scientific << az);
@@ -408,15 +495,13 @@ namespace gnsstk
       DEBUGTRACE("seas=" << seas);
       DEBUGTRACE("ee=" << scientific << ee);
       DEBUGTRACE("seasp=" << seasp);
-         // Compute the fourier time series for foF2 and M(3000)F2
-      ccir.fourier(when, fAzr);
-      legendre(modip_u, pos);
+      legendre(modip_u, phi, lambda);
       fNmF2 = FREQ2NE_D * ffoF2 * ffoF2;                                //eq.77
          // Compute peak electron density height for each layer
       height();
          // Compute thickness parameters for each layer
       thickness();
-      exosphereAdjust(when.month);
+      exosphereAdjust(month);
       peakAmplitudes();
    }
 
@@ -474,11 +559,19 @@ namespace gnsstk
    solarZenithAngle(const Position& pos, const CivilTime& when)
    {
       DEBUGTRACE_FUNCTION();
-      double phiRad = pos.geodeticLatitude() * DEG2RAD;
-      double lambda = pos.longitude();
-      AngleReduced deltaSun = solarDeclination(when);
          // leave the UTC check up to solarDeclination
-      double lt = when.getUTHour() + (lambda / 15.0);                   //eq.4
+      return solarZenithAngle(pos.geodeticLatitude(), pos.longitude(),
+                              when.getUTHour(), solarDeclination(when));
+   }
+
+
+   Angle NeQuickIonoNavData::ModelParameters ::
+   solarZenithAngle(double phi, double lambda, double utHour,
+                    const AngleReduced& deltaSun)
+   {
+      DEBUGTRACE_FUNCTION();
+      double phiRad = phi * DEG2RAD;
+      double lt = utHour + (lambda / 15.0);                             //eq.4
          // X is really chi.
       double cosX=sin(phiRad) * sin(deltaSun) +                         //eq.26
          cos(phiRad) * cos(deltaSun) * cos(PI/12*(12-lt));
@@ -488,11 +581,21 @@ namespace gnsstk
 
    Angle NeQuickIonoNavData::ModelParameters ::
    effSolarZenithAngle(const Position& pos, const CivilTime& when)
+   {
+      DEBUGTRACE_FUNCTION();
+      return effSolarZenithAngle(pos.geodeticLatitude(), pos.longitude(),
+                                 when.getUTHour(), solarDeclination(when));
+   }
+
+
+   Angle NeQuickIonoNavData::ModelParameters ::
+   effSolarZenithAngle(double phi, double lambda, double utHour,
+                       const AngleReduced& deltaSun)
    {
       DEBUGTRACE_FUNCTION();
          // x is really chi.
       static const double x0 = 86.23292796211615;                       //eq.28
-      Angle x = solarZenithAngle(pos, when);
+      Angle x = solarZenithAngle(phi, lambda, utHour, deltaSun);
       double exp2 = neExp(12*(x.deg()-x0));                             //eq.29
       return Angle((x.deg()+(90-0.24*neExp(20-0.2*x.deg()))*exp2) / (1+exp2),
                    AngleType::Deg);
@@ -501,6 +604,14 @@ namespace gnsstk
 
    void NeQuickIonoNavData::ModelParameters ::
    legendre(double modip_u, const Position& pos)
+   {
+      DEBUGTRACE_FUNCTION();
+      legendre(modip_u, pos.geodeticLatitude(), pos.longitude());
+   }
+
+
+   void NeQuickIonoNavData::ModelParameters ::
+   legendre(double modip_u, double phi, double lambda)
    {
       DEBUGTRACE_FUNCTION();
          // sine modified dip latitude coefficients
@@ -518,27 +629,41 @@ namespace gnsstk
       const unsigned R[] {7,8,6,3,2,1,1};                               //eq.71
       const int H[] {-7,7,23,35,41,45,47};                              //eq.74
       double modip_uRad = modip_u * DEG2RAD;
-      double phiRad = pos.geodeticLatitude() * DEG2RAD;
-      double lambdaRad = pos.longitude() * DEG2RAD;
+      double phiRad = phi * DEG2RAD;
+      double lambdaRad = lambda * DEG2RAD;
       DEBUGTRACE("lambdaRad = " << scientific << lambdaRad);
       DEBUGTRACE("lat.rad = " << scientific << phiRad);
-      DEBUGTRACE("lat.deg = " << scientific << pos.geodeticLatitude());
+      DEBUGTRACE("lat.deg = " << scientific << phi);
       DEBUGTRACE("cos_lat = " << scientific << cos(phiRad));
+         // This is evaluated for every integration sample point, so
+         // the sines and cosines are computed once each and the
+         // multiples of lambda are obtained by angle addition rather
+         // than by calling sin() and cos() 16 times.
+      double sinModip = sin(modip_uRad);
+      double cosPhi = cos(phiRad);
+      double sinLambda = sin(lambdaRad);
+      double cosLambda = cos(lambdaRad);
          // compute sine modififed dip latitude coefficients
       for (unsigned k = 1; k<F2LayerMODIPCoeffCount; k++)
       {
-         M[k] = M[k-1] * sin(modip_uRad);                               //eq.57
+         M[k] = M[k-1] * sinModip;                                      //eq.57
       }
       P[0] = 1.0; // not used except for initialization convenience
+      S[0] = sinLambda;                                                 //eq.59
+      C[0] = cosLambda;                                                 //eq.60
          // compute cos lat, sin long, cos long coefficients
       for (unsigned n = 1; n < F2LayerLongCoeffCount; n++)
       {
-         P[n] = P[n-1] * cos(phiRad);                                   //eq.58
-         S[n-1] = sin(n * lambdaRad);                                   //eq.59
-         C[n-1] = cos(n * lambdaRad);                                   //eq.60
+         P[n] = P[n-1] * cosPhi;                                        //eq.58
+         if (n > 1)
+         {
+               // sin(n*lambda) and cos(n*lambda) by angle addition
+            S[n-1] = S[n-2] * cosLambda + C[n-2] * sinLambda;           //eq.59
+            C[n-1] = C[n-2] * cosLambda - S[n-2] * sinLambda;           //eq.60
+         }
          DEBUGTRACE("lambda[" << n << "]=" << scientific << (n*lambdaRad));
-         DEBUGTRACE("S[" << n << "]=" << scientific << S[n]);
-         DEBUGTRACE("C[" << n << "]=" << scientific << C[n]);
+         DEBUGTRACE("S[" << n << "]=" << scientific << S[n-1]);
+         DEBUGTRACE("C[" << n << "]=" << scientific << C[n-1]);
       }
          // initialize higher order terms to zero before summation
       ffoF2 = 0;
@@ -722,17 +847,39 @@ namespace gnsstk
 
    double NeQuickIonoNavData::ModelParameters ::
    electronDensity(const Position& pos)
+   {
+         // must convert height from m to km first
+      return electronDensity(pos.height() / 1000.0);
+   }
+
+
+   double NeQuickIonoNavData::ModelParameters ::
+   electronDensityTop(const Position& pos)
+   {
+      return electronDensityTop(pos.height() / 1000.0);
+   }
+
+
+   double NeQuickIonoNavData::ModelParameters ::
+   electronDensityBottom(const Position& pos)
+   {
+      return electronDensityBottom(pos.height() / 1000.0);
+   }
+
+
+   double NeQuickIonoNavData::ModelParameters ::
+   electronDensity(double h)
+      const
    {
       DEBUGTRACE_FUNCTION();
       double rv = 0;
-         // must convert height from m to km first
-      if ((pos.height() / 1000.0) <= fhmF2)
+      if (h <= fhmF2)
       {
-         rv = electronDensityBottom(pos);
+         rv = electronDensityBottom(h);
       }
       else
       {
-         rv = electronDensityTop(pos);
+         rv = electronDensityTop(h);
       }
       DEBUGTRACE("electron density=" << scientific << rv);
       return rv;
@@ -740,12 +887,12 @@ namespace gnsstk
 
 
    double NeQuickIonoNavData::ModelParameters ::
-   electronDensityTop(const Position& pos)
+   electronDensityTop(double h)
+      const
    {
       DEBUGTRACE_FUNCTION();
       static constexpr double g = 0.125;                                //eq.122
       static constexpr double r = 100;                                  //eq.123
-      double h = pos.height() / 1000.0; // height in km
       double deltah = h - fhmF2;                                        //eq.124
       double z = deltah / (fH0*(1+(r*g*deltah)/(r*fH0+g*deltah)));      //eq.125
       double ea = neExp(z);                                             //eq.126
@@ -763,10 +910,10 @@ namespace gnsstk
 
 
    double NeQuickIonoNavData::ModelParameters ::
-   electronDensityBottom(const Position& pos)
+   electronDensityBottom(double h)
+      const
    {
       DEBUGTRACE_FUNCTION();
-      double h = pos.height() / 1000.0; // height in km
       double BE = (h > hmE) ? fBEtop : BEbot;                           //eq.109
       double BF1 = (h > fhmF1) ? fB1top : fB1bot;                       //eq.110
       double mh = std::max(h, 100.0); // see note after eq.113
@@ -817,6 +964,7 @@ namespace gnsstk
    NeQuickIonoNavData::IntegrationParameters ::
    IntegrationParameters(const Position& rx, const Position& sv,
                          const Position& Pp, bool vertical)
+         : perigeeRadius(0)
    {
       DEBUGTRACE_FUNCTION();
       GalileoIonoEllipsoid elModel;
@@ -903,17 +1051,72 @@ namespace gnsstk
          DEBUGTRACE("sa = " << sa);
          DEBUGTRACE("sb = " << sb);
          DEBUGTRACE("s2 = " << s2);
+            // The remainder is the part of Position::getRayPosition()
+            // that doesn't depend on the distance along the ray.
+         Position p2(sv);
+         p2.transformTo(Position::Geodetic);
+         Angle phi2(p2.geodeticLatitude(), AngleType::Deg);
+         Angle lambda2(p2.longitude(), AngleType::Deg);
+         phip = Angle(Pp.geodeticLatitude(), AngleType::Deg);
+         lambdap = Angle(Pp.longitude(), AngleType::Deg);
+         Angle dLambda(lambda2 - lambdap);
+            // Great circle angle from ray-perigee to satellite
+         AngleReduced psi;
+         if (fabs(fabs(phip.deg())-90.0) < 1e-10)
+         {
+            psi.setValue(fabs(p2.geodeticLatitude()-Pp.geodeticLatitude()),
+                         AngleType::Deg);                               //eq.168
+               // see Position::getRayPosition() regarding phip == 0
+            sigmap = (phip.deg() > 0) ? Angle(0.0, -1.0) :              //eq.173
+               Angle(0.0, 1.0);
+         }
+         else
+         {
+            psi = AngleReduced(sin(phip)*sin(phi2) +                    //eq.169
+                               cos(phip)*cos(phi2)*cos(dLambda),
+                               AngleType::Cos);
+            sigmap = AngleReduced(cos(phi2)*sin(dLambda)/sin(psi),      //eq.174
+                                  (sin(phi2)-sin(phip)*cos(psi)) /      //eq.175
+                                  (cos(phip)*sin(psi)));
+         }
+         perigeeRadius = Pp.radius(); // radius in m
       }
       DEBUGTRACE("integHeights.size() = " << integHeights.size());
       DEBUGTRACE("intThresh.size() = " << intThresh.size());
    }
 
 
+   Position NeQuickIonoNavData::IntegrationParameters ::
+   getRayPosition(double dist, const Position& rx)
+      const
+   {
+      DEBUGTRACE_FUNCTION();
+         // rs is in meters rather than km per the equation, as in
+         // Position::getRayPosition().
+      double rp = perigeeRadius;
+      double rs = sqrt(dist*dist + rp*rp);                              //eq.178
+      double tanDeltas = dist / rp;                                     //eq.179
+      double cosDeltas = 1/sqrt(1+tanDeltas*tanDeltas);                 //eq.180
+      double sinDeltas = tanDeltas * cosDeltas;                         //eq.181
+         // Only the sine and degrees of phis and the degrees of
+         // dlambda are needed, so skip constructing Angle objects.
+      double sinPhis = sin(phip)*cosDeltas +                            //eq.182
+         cos(phip)*sinDeltas*cos(sigmap);
+      double phis = asin(sinPhis) * RAD2DEG;
+      double dlambda = atan2(sinDeltas*sin(sigmap)*cos(phip),           //eq.185
+                             cosDeltas-sin(phip)*sinPhis) * RAD2DEG;    //eq.186
+      double lambdas = dlambda + lambdap.deg();                         //eq.187
+      Position rv(phis, lambdas, rs, Position::Geocentric);
+      rv.copyEllipsoidModelFrom(rx);
+      return rv;
+   }
+
+
    double NeQuickIonoNavData ::
    integrateGaussKronrod(double heightPt1, double heightPt2,
-                         const Position& rxgeo, const Position& svgeo,
-                         const MODIP& modip, double modipSta, CCIR& ccirData,
-                         const CivilTime& when, double azu, double tolerance,
+                         const Position& rxgeo,
+                         const IntegrationParameters& ip,
+                         const EpochParameters& ep, double tolerance,
                          bool vertical, unsigned recursionLevel)
       const
    {
@@ -979,30 +1182,34 @@ namespace gnsstk
       double intk = 0.0;
          // G7 integration results
       double intg = 0.0;
-         // G7 counter/index
-      unsigned gind = 0;
+         // electron density at each of the K15 sample points
+      double y[15];
       DEBUGTRACE("mid_point=" << hh);
       DEBUGTRACE("half_diff=" << h2);
-         // Iterating over K15, which is defined to have 15 values
+         // Evaluate all 15 K15 sample points first, then form the
+         // weighted sums over the whole set.
       for (unsigned i = 0; i < 15; i++)
       {
          double x = h2 * xi[i] + hh;
-         double y = 0;
          DEBUGTRACE("i=" << i << "  x=" << x);
          if (vertical)
          {
-            y = getVED(x, rxgeo, svgeo, modipSta, ccirData, when, azu);
+            y[i] = getVED(x, rxgeo, ep);
          }
          else
          {
-            y = getSED(x, rxgeo, svgeo, modip, ccirData, when, azu);
+            y[i] = getSED(x, rxgeo, ip, ep);
          }
-         DEBUGTRACE("GKI ED = " << scientific << y);
-            // Accumulate on to the k15 total
-         intk += y * wi[i];
+         DEBUGTRACE("GKI ED = " << scientific << y[i]);
+      }
+         // Accumulate the K15 total, and the G7 total over the odd
+         // sample points, in the same order as the reference code.
+      for (unsigned i = 0; i < 15; i++)
+      {
+         intk += y[i] * wi[i];
          if (i % 2)
          {
-            intg += y * wig[gind++];
+            intg += y[i] * wig[i/2];
          }
       }
          // Complete the calculation of the integration results
@@ -1026,12 +1233,10 @@ namespace gnsstk
       {
             // Result is not within tolerance.  Split portion into
             // equal halves and recurse.
-         rv = integrateGaussKronrod(heightPt1, heightPt1 + h2, rxgeo, svgeo,
-                                    modip, modipSta, ccirData, when, azu,
+         rv = integrateGaussKronrod(heightPt1, heightPt1 + h2, rxgeo, ip, ep,
                                     tolerance, vertical, recursionLevel+1);
          DEBUGTRACE("pResult(4) = " << scientific << rv);
-         rv += integrateGaussKronrod(heightPt1 + h2, heightPt2, rxgeo, svgeo,
-                                     modip, modipSta, ccirData, when, azu,
+         rv += integrateGaussKronrod(heightPt1 + h2, heightPt2, rxgeo, ip, ep,
                                      tolerance, vertical, recursionLevel+1);
          DEBUGTRACE("pResult(5) = " << scientific << rv);
       }
@@ -119,6 +119,38 @@ namespace gnsstk
                     const Position& rxgeo,
                     const Position& svgeo) const;
 
+         /** Get the ionospheric corrections in meters for all the
+          * satellites in view of a receiver at one time.  The model
+          * terms that depend only on the time and receiver position
+          * are computed once and shared by every satellite, which
+          * makes this considerably faster than calling getIonoCorr()
+          * for each satellite in turn.
+          * @param[in] when The time of the observations to correct.
+          * @param[in] rxgeo The receiver's geodetic position.
+          * @param[in] svgeo The observed satellites' geodetic positions.
+          * @param[in] band The carrier band of the signals being corrected.
+          * @param[out] corr The ionospheric delay, in meters, on band
+          *   for each satellite in svgeo, in the same order. */
+      void getIonoCorr(const CommonTime& when,
+                       const Position& rxgeo,
+                       const std::vector<Position>& svgeo,
+                       CarrierBand band,
+                       std::vector<double>& corr) const;
+
+         /** Get the total electron content between rxgeo and each of
+          * the satellites in svgeo at the given time.  As with the
+          * batch getIonoCorr(), the per-epoch model terms are
+          * computed only once.
+          * @param[in] when The time when the RF signal was received.
+          * @param[in] rxgeo The position of the GNSS receiver's antenna.
+          * @param[in] svgeo The positions of the transmitting satellites.
+          * @param[out] tec The total electron content in TEC units
+          *   for each satellite in svgeo, in the same order. */
+      void getTEC(const CommonTime& when,
+                  const Position& rxgeo,
+                  const std::vector<Position>& svgeo,
+                  std::vector<double>& tec) const;
+
          /** a<sub>i</sub> terms of NeQuick model in solar flux units,
           * solar flux units/degree, solar flux
           * units/degree<sup>2</sup>.  Refer to Galileo-OS-SIS-ICD. */
@@ -150,6 +182,33 @@ namespace gnsstk
           * @return The effective ionization level Az in solar flux units. */
       double getEffIonoLevel(double modip_u) const;
 
+         /** Model terms that depend only on the time and the receiver
+          * position, and so are shared by every sample point on every
+          * ray from the receiver at that time. */
+      class EpochParameters
+      {
+      public:
+            /** Compute the solar declination, the receiver's modified
+             * dip latitude and effective ionization level, and the
+             * CCIR Fourier coefficients for the given time.
+             * @param[in] nav The NeQuick data whose coefficients
+             *   (ai) are to be used.
+             * @param[in] when The time when the RF signal was received.
+             * @param[in] rxgeo The position of the GNSS receiver's
+             *   antenna. */
+         EpochParameters(const NeQuickIonoNavData& nav, const CommonTime& when,
+                         const Position& rxgeo);
+
+         CivilTime civ;         ///< The time of interest in civil units.
+         double utHour;         ///< Fractional UT hour of day of civ.
+         AngleReduced deltaSun; ///< Solar declination at civ.
+         MODIP modip;           ///< Modified dip latitude lookup.
+         double modip_u;        ///< Modified dip latitude of receiver in deg.
+         double azu;            ///< Effective ionization level in sfu.
+         double azr;            ///< Effective sunspot number derived from azu.
+         CCIR ccir;             ///< Fourier coefficients for civ and azr.
+      };
+
          /// Aggregate the model parameters as defined in section 2.5.5
       class ModelParameters
       {
@@ -167,6 +226,18 @@ namespace gnsstk
          ModelParameters(double modip_u, const Position& pos, double az,
                          CCIR& ccirData, const CivilTime& when);
 
+            /** Compute the various NeQuickG model parameters using
+             * the time and receiver dependent terms in ep rather than
+             * recomputing them.
+             * @param[in] modip_u Modified dip latitude in degrees.
+             * @param[in] phi The geodetic latitude of the observer
+             *   in degrees.
+             * @param[in] lambda The longitude of the observer in degrees.
+             * @param[in] ep The precomputed epoch parameters.
+             * @post fAzr, ffoE, fNmE, ffoF1, fNmF1, fNmF2 are set. */
+         ModelParameters(double modip_u, double phi, double lambda,
+                         const EpochParameters& ep);
+
             /** Compute the sine and cosine of the solar
              * declination. (sec 2.5.4.6)
              * @param[in] when The time at which to compute the solar
@@ -181,6 +252,17 @@ namespace gnsstk
          static Angle solarZenithAngle(const Position& pos,
                                        const CivilTime& when);
 
+            /** Compute the solar zenith angle.
+             * @param[in] phi The geodetic latitude of the observer
+             *   in degrees.
+             * @param[in] lambda The longitude of the observer in degrees.
+             * @param[in] utHour The fractional UT hour of day.
+             * @param[in] deltaSun The solar declination at utHour.
+             * @return The solar zenith angle. */
+         static Angle solarZenithAngle(double phi, double lambda,
+                                       double utHour,
+                                       const AngleReduced& deltaSun);
+
             /** Compute the effective solar zenith angle.
              * @param[in] pos The geodetic position of the observer.
              * @param[in] when The time at which to compute the solar zenith.
@@ -188,12 +270,31 @@ namespace gnsstk
          static Angle effSolarZenithAngle(const Position& pos,
                                           const CivilTime& when);
 
+            /** Compute the effective solar zenith angle.
+             * @param[in] phi The geodetic latitude of the observer
+             *   in degrees.
+             * @param[in] lambda The longitude of the observer in degrees.
+             * @param[in] utHour The fractional UT hour of day.
+             * @param[in] deltaSun The solar declination at utHour.
+             * @return The effective solar zenith angle. */
+         static Angle effSolarZenithAngle(double phi, double lambda,
+                                          double utHour,
+                                          const AngleReduced& deltaSun);
+
             /** Compute foF2 and M(3000)F2 by Legendre calculation.
              * @param[in] modip_u Modified dip latitude in degrees.
              * @param[in] pos The geodetic position of the observer.
              * @post ffoF2, fM3000F2 are set. */
          void legendre(double modip_u, const Position& pos);
 
+            /** Compute foF2 and M(3000)F2 by Legendre calculation.
+             * @param[in] modip_u Modified dip latitude in degrees.
+             * @param[in] phi The geodetic latitude of the observer
+             *   in degrees.
+             * @param[in] lambda The longitude of the observer in degrees.
+             * @post ffoF2, fM3000F2 are set. */
+         void legendre(double modip_u, double phi, double lambda);
+
             /** Compute hmF2 and hmF1 (maximum density height).
              * @pre ffoE, ffoF2, fM3000F2 must be set.
              * @post fhmF2 and fhmF1 are set. */
@@ -260,7 +361,30 @@ namespace gnsstk
              * @return The electron density in TECU. */
          double electronDensityBottom(const Position& pos);
 
-         CCIR &ccir;      ///< Reference to iono model data.
+            /** Compute electron density.
+             * @pre fhmF2, fH0, fNmF2, fBEtop, fhmF1, fB1top, fB1bot,
+             *   fB2bot, fA must be set.
+             * @param[in] h The height above the ellipsoid in km at
+             *   which to compute electron density.
+             * @return The electron density in TECU. */
+         double electronDensity(double h) const;
+
+            /** Compute the topside electron density.
+             * @pre fhmF2, fH0, fNmF2 must be set.
+             * @param[in] h The height above the ellipsoid in km at
+             *   which to compute electron density.
+             * @return The electron density in TECU. */
+         double electronDensityTop(double h) const;
+
+            /** Compute the bottomside electron density.
+             * @pre fBEtop, fhmF1, fB1top, fB1bot, fhmF2, fB2bot, fA
+             *   must be set.
+             * @param[in] h The height above the ellipsoid in km at
+             *   which to compute electron density.
+             * @return The electron density in TECU. */
+         double electronDensityBottom(double h) const;
+
+         const CCIR &ccir; ///< Reference to iono model data.
          double fAzr;     ///< Effective sunspot number.
          double ffoE;     ///< E layer critical frequency in MHz.
          double fNmE;     ///< E layer maximum electron density in el m**-2.
@@ -284,6 +408,20 @@ namespace gnsstk
             /// Constructor for testing only.
          ModelParameters(CCIR& ccirData);
 
+            /** Compute the layer parameters common to both public
+             * constructors.
+             * @pre fAzr and fXeff are set and ccir holds the Fourier
+             *   coefficients for the time of interest and fAzr.
+             * @param[in] modip_u Modified dip latitude in degrees.
+             * @param[in] phi The geodetic latitude of the observer
+             *   in degrees.
+             * @param[in] lambda The longitude of the observer in degrees.
+             * @param[in] az The effective ionization level in solar
+             *   flux units.
+             * @param[in] month Month 1-12 for ionospheric model. */
+         void compute(double modip_u, double phi, double lambda, double az,
+                      unsigned month);
+
          friend class ::NeQuickIonoNavData_T;
       };
 
@@ -304,6 +442,19 @@ namespace gnsstk
              *   to use for integration intervals. */
          IntegrationParameters(const Position& rx, const Position& sv,
                                const Position& Pp, bool vertical);
+            /** Get the position of a point on a slant ray.  This is
+             * the same computation as Position::getRayPosition(),
+             * but with the ray perigee and azimuth, which are the
+             * same for every point on the ray, computed only once in
+             * the constructor.
+             * @pre The constructor was called with vertical=false.
+             * @param[in] dist The distance in m along the ray from
+             *   the ray perigee.
+             * @param[in] rx The position of the receiving antenna,
+             *   whose ellipsoid model is used for the result.
+             * @return The position of the point on the ray, in the
+             *   Geocentric coordinate system. */
+         Position getRayPosition(double dist, const Position& rx) const;
             /** A vector containing the set of relevant integration
              * intervals, which for slant rays is essentially s1, s2,
              * and sa, sb if they're in between s1 and s2.  Put
@@ -315,24 +466,26 @@ namespace gnsstk
             /** Integration thresholds used for integHeights.
              * @note the size of intThresh will be integHeights.size()-1. */
          std::vector<double> intThresh;
+         double perigeeRadius; ///< Ray perigee radius in m (slant only).
+         Angle phip;           ///< Ray perigee latitude (slant only).
+         Angle lambdap;        ///< Ray perigee longitude (slant only).
+         AngleReduced sigmap;  ///< Azimuth of sv from perigee (slant only).
       };
 
          /** Get the electron density at a distance along a path where
           * svgeo is not directly overhead rxgeo.
-          * @param[in] dist The height above the ellipsoid in km at
-          *   which to get the electron density.
+          * @param[in] dist The distance in km along the ray from the
+          *   ray perigee at which to get the electron density.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
-          * @param[in] svgeo The position of the transmitting satellite.
-          * @param[in] modip A pre-constructed MODIP object to use.
-          * @param[in] ccirData A pre-constructed CCIR object to use.
-          * @param[in] when The time when the RF signal was received.
-          * @param[in] azu Effective ionization level, in solar flux
-          *   units, at the modified dip latitude of the receiver.
+          * @param[in] ip The integration parameters for the ray
+          *   from rxgeo to the satellite.
+          * @param[in] ep The precomputed time and receiver dependent
+          *   model terms.
           * @return The electron density in TECU.
           */
-      double getSED(double dist, const Position& rxgeo, const Position& svgeo,
-                    const MODIP& modip, CCIR& ccirData, const CivilTime& when,
-                    double azu)
+      double getSED(double dist, const Position& rxgeo,
+                    const IntegrationParameters& ip,
+                    const EpochParameters& ep)
          const;
 
          /** Get the electron density at a distance along a path where
@@ -340,33 +493,38 @@ namespace gnsstk
           * @param[in] dist The height above the ellipsoid in km at
           *   which to get the electron density.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
-          * @param[in] svgeo The position of the transmitting satellite.
-          * @param[in] modip_u The modified dip latitude in degrees for rxgeo.
-          * @param[in] ccirData A pre-constructed CCIR object to use.
-          * @param[in] when The time when the RF signal was received.
-          * @param[in] azu Effective ionization level, in solar flux
-          *   units, at the modified dip latitude of the receiver.
+          * @param[in] ep The precomputed time and receiver dependent
+          *   model terms.
           * @return The electron density in TECU.
           */
-      double getVED(double dist, const Position& rxgeo, const Position& svgeo,
-                    double modip_u, CCIR& ccirData, const CivilTime& when,
-                    double azu)
+      double getVED(double dist, const Position& rxgeo,
+                    const EpochParameters& ep)
+         const;
+
+         /** Integrate the TEC along the ray from rxgeo to one
+          * satellite.
+          * @param[in] rxgeo The position of the GNSS receiver's antenna.
+          * @param[in] svgeo The position of the transmitting satellite.
+          * @param[in] ep The precomputed time and receiver dependent
+          *   model terms.
+          * @return The integrated TEC, before scaling to TEC units. */
+      double integrateRay(const Position& rxgeo, const Position& svgeo,
+                          const EpochParameters& ep)
          const;
 
          /** Perform Gauss-Kronrod integration of the TEC along the
           * ray between rxgeo and svgeo from heightPt1 to heightPt2.
+          * The electron density is evaluated at all 15 Kronrod
+          * sample points before the K15 and G7 sums are formed.
           * @param[in] heightPt1 The height above the ellipsoid at
           *   which integration should start.
           * @param[in] heightPt2 The height above the ellipsoid at
           *   which integration should end.
           * @param[in] rxgeo The position of the GNSS receiver's antenna.
-          * @param[in] svgeo The position of the transmitting satellite.
-          * @param[in] modip A pre-constructed MODIP object to use.
-          * @param[in] modipSta The modified dip latitude in degrees for rxgeo.
-          * @param[in] ccirData A pre-constructed CCIR object to use.
-          * @param[in] when The time when the RF signal was received.
-          * @param[in] azu Effective ionization level, in solar flux
-          *   units, at the modified dip latitude of the receiver.
+          * @param[in] ip The integration parameters for the ray
+          *   from rxgeo to the satellite.
+          * @param[in] ep The precomputed time and receiver dependent
+          *   model terms.
           * @param[in] tolerance If the delta between K15 and G7
           *   integration results is less than this number,
           *   integration will complete.
@@ -377,10 +535,9 @@ namespace gnsstk
           *   RecursionMax (defined in cpp file) times.
           * @return The integrated TEC. */
       double integrateGaussKronrod(double heightPt1, double heightPt2,
-                                   const Position& rxgeo, const Position& svgeo,
-                                   const MODIP& modip, double modipSta,
-                                   CCIR& ccirData,
-                                   const CivilTime& when, double azu,
+                                   const Position& rxgeo,
+                                   const IntegrationParameters& ip,
+                                   const EpochParameters& ep,
                                    double tolerance, bool vertical,
                                    unsigned recursionLevel = 0)
          const;
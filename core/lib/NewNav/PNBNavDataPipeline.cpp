@@ -0,0 +1,555 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "PNBNavDataPipeline.hpp"
+#include "PNBGPSLNavDataFactory.hpp"
+#include "PNBGPSCNavDataFactory.hpp"
+#include "PNBGPSCNav2DataFactory.hpp"
+#include "PNBGalINavDataFactory.hpp"
+#include "PNBGalFNavDataFactory.hpp"
+#include "PNBBDSD1NavDataFactory.hpp"
+#include "PNBBDSD2NavDataFactory.hpp"
+#include "PNBGLOFNavDataFactory.hpp"
+#include "PNBGLOCNavDataFactory.hpp"
+#include "TimeSystem.hpp"
+
+namespace gnsstk
+{
+      /// The GNSS whose decoder worker handles each nav type.
+   static const std::map<NavType, SatelliteSystem> pipelineNavTypes
+   {
+      { NavType::GPSLNAV,   SatelliteSystem::GPS },
+      { NavType::GPSCNAVL2, SatelliteSystem::GPS },
+      { NavType::GPSCNAVL5, SatelliteSystem::GPS },
+      { NavType::GPSCNAV2,  SatelliteSystem::GPS },
+      { NavType::GalINAV,   SatelliteSystem::Galileo },
+      { NavType::GalFNAV,   SatelliteSystem::Galileo },
+      { NavType::BeiDou_D1, SatelliteSystem::BeiDou },
+      { NavType::BeiDou_D2, SatelliteSystem::BeiDou },
+      { NavType::GloCivilF, SatelliteSystem::Glonass },
+      { NavType::GloCivilC, SatelliteSystem::Glonass }
+   };
+
+
+   PNBNavDataPipeline::LatencyHistogram ::
+   LatencyHistogram()
+         : count(0), minSec(0), maxSec(0), totalSec(0), bins(numBins, 0)
+   {
+   }
+
+
+   void PNBNavDataPipeline::LatencyHistogram ::
+   add(double seconds)
+   {
+      if ((count == 0) || (seconds < minSec))
+         minSec = seconds;
+      if ((count == 0) || (seconds > maxSec))
+         maxSec = seconds;
+      count++;
+      totalSec += seconds;
+      double us = seconds * 1e6;
+      unsigned bin = 0;
+      while ((us >= 1.0) && (bin < numBins-1))
+      {
+         us /= 2.0;
+         bin++;
+      }
+      bins[bin]++;
+   }
+
+
+   double PNBNavDataPipeline::LatencyHistogram ::
+   percentile(double pct) const
+   {
+      if (count == 0)
+         return 0;
+      double target = pct / 100.0 * count;
+      unsigned long sum = 0;
+      for (unsigned bin = 0; bin < numBins; bin++)
+      {
+         sum += bins[bin];
+         if ((sum >= target) && (sum > 0))
+         {
+            double edge = ldexp(1e-6, bin);
+            return edge < maxSec ? edge : maxSec;
+         }
+      }
+      return maxSec;
+   }
+
+
+   PNBNavDataPipeline ::
+   PNBNavDataPipeline(NavDataFactoryWithStore& storeArg,
+                      size_t queueSize,
+                      Overflow overflowArg)
+         : store(storeArg),
+           overflow(overflowArg),
+           sinkQueue(queueSize),
+           stopAdding(false),
+           stopWorkers(false),
+           stopSink(false),
+           numAccepted(0),
+           numDropped(0),
+           numRejected(0),
+           numDecoded(0),
+           numQueued(0),
+           numStored(0),
+           numAdding(0)
+   {
+      for (const auto& nti : pipelineNavTypes)
+      {
+         std::unique_ptr<Worker>& w(workers[nti.second]);
+         if (!w)
+            w.reset(new Worker(queueSize));
+         w->factories[nti.first] = newFactory(nti.first);
+         workerByType[nti.first] = w.get();
+      }
+      for (auto& wi : workers)
+      {
+         Worker *w = wi.second.get();
+         w->thread = std::thread([this, w] { decodeLoop(*w); });
+      }
+      sinkThread = std::thread([this] { sinkLoop(); });
+   }
+
+
+   PNBNavDataPipeline ::
+   ~PNBNavDataPipeline()
+   {
+      stop();
+   }
+
+
+   void PNBNavDataPipeline::EventCount ::
+   notify()
+   {
+         // Pairs with the fence in prepareWait(): either the waiter
+         // sees the change when it retries, or this sees the waiter.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (waiters.load(std::memory_order_relaxed) == 0)
+         return;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         epoch++;
+      }
+      cond.notify_all();
+   }
+
+
+   unsigned long PNBNavDataPipeline::EventCount ::
+   prepareWait()
+   {
+      waiters++;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      return epoch.load(std::memory_order_relaxed);
+   }
+
+
+   void PNBNavDataPipeline::EventCount ::
+   wait(unsigned long key)
+   {
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         cond.wait(lock, [this, key] { return epoch != key; });
+      }
+      waiters--;
+   }
+
+
+   template <class Func>
+   void PNBNavDataPipeline ::
+   forEachFactory(Func func)
+   {
+      for (auto& wi : workers)
+      {
+         std::lock_guard<std::mutex> lock(wi.second->factoryMutex);
+         for (auto& fi : wi.second->factories)
+         {
+            func(*fi.second);
+         }
+      }
+   }
+
+
+   void PNBNavDataPipeline ::
+   setValidityFilter(NavValidityType nvt)
+   {
+      forEachFactory([nvt](PNBNavDataFactory& f)
+                     { f.setValidityFilter(nvt); });
+   }
+
+
+   void PNBNavDataPipeline ::
+   setTypeFilter(const NavMessageTypeSet& nmts)
+   {
+      forEachFactory([&nmts](PNBNavDataFactory& f)
+                     { f.setTypeFilter(nmts); });
+   }
+
+
+   void PNBNavDataPipeline ::
+   setControl(const FactoryControl& ctrl)
+   {
+      forEachFactory([&ctrl](PNBNavDataFactory& f)
+                     { f.setControl(ctrl); });
+   }
+
+
+   bool PNBNavDataPipeline ::
+   addData(const PackedNavBitsPtr& navIn, double cadence)
+   {
+      auto wi = workerByType.find(navIn->getNavID().navType);
+      if (wi == workerByType.end())
+      {
+         return false;
+      }
+      Worker& w(*wi->second);
+         // stop() waits for numAdding to reach 0 after setting
+         // stopAdding, and only then stops the workers, so either
+         // this sees stopAdding or the worker decodes the subframe.
+      numAdding++;
+      if (stopAdding)
+      {
+         numAdding--;
+         progress.notify();
+         return false;
+      }
+         // Count the subframe before queueing it so that flush()
+         // never sees it decoded but not yet accepted.
+      numAccepted++;
+      InItem item { navIn, cadence, Clock::now() };
+      bool pushed = w.queue.tryPush(std::move(item));
+      if (!pushed && (overflow == Overflow::Block))
+      {
+         w.popped.waitUntil(
+            [&] { return ((pushed = w.queue.tryPush(std::move(item))) ||
+                          stopAdding); });
+      }
+      if (pushed)
+      {
+         w.pushed.notify();
+      }
+      else
+      {
+         numAccepted--;
+         if (!stopAdding)
+            numDropped++;
+      }
+      numAdding--;
+      progress.notify();
+      return pushed;
+   }
+
+
+   void PNBNavDataPipeline ::
+   flush()
+   {
+         // numQueued is incremented before numDecoded, so reading
+         // numDecoded first ensures all of a subframe's messages are
+         // counted in numQueued.
+      progress.waitUntil(
+         [this] { return ((numDecoded >= numAccepted) &&
+                          (numStored >= numQueued)); });
+   }
+
+
+   void PNBNavDataPipeline ::
+   resetState()
+   {
+      flush();
+      forEachFactory([](PNBNavDataFactory& f) { f.resetState(); });
+   }
+
+
+   PNBNavDataPipeline::LatencyMap PNBNavDataPipeline ::
+   getLatency() const
+   {
+      std::lock_guard<std::mutex> lock(latencyMutex);
+      return latency;
+   }
+
+
+   void PNBNavDataPipeline ::
+   resetLatency()
+   {
+      std::lock_guard<std::mutex> lock(latencyMutex);
+      latency.clear();
+   }
+
+
+   void PNBNavDataPipeline ::
+   decodeLoop(Worker& w)
+   {
+      InItem item;
+      NavDataPtrList navOut;
+      while (true)
+      {
+         bool popped = false;
+            // Only stop once the queue has been drained.
+         w.pushed.waitUntil(
+            [&] { return (popped = w.queue.tryPop(item)) || stopWorkers; });
+         if (!popped && !(popped = w.queue.tryPop(item)))
+            break;
+         w.popped.notify();
+         navOut.clear();
+         bool ok = false;
+         {
+            std::lock_guard<std::mutex> lock(w.factoryMutex);
+            auto fi = w.factories.find(item.pnb->getNavID().navType);
+            try
+            {
+               ok = fi->second->addData(item.pnb, navOut, item.cadence);
+            }
+            catch (Exception&)
+            {
+               ok = false;
+            }
+            catch (std::exception&)
+            {
+               ok = false;
+            }
+            catch (...)
+            {
+               ok = false;
+            }
+         }
+         if (!ok)
+         {
+            numRejected++;
+         }
+         for (auto& nd : navOut)
+         {
+            numQueued++;
+            OutItem out { nd, item.when };
+            sinkPopped.waitUntil(
+               [&] { return sinkQueue.tryPush(std::move(out)); });
+            sinkPushed.notify();
+         }
+         item.pnb.reset();
+         numDecoded++;
+         progress.notify();
+      }
+   }
+
+
+   void PNBNavDataPipeline ::
+   sinkLoop()
+   {
+      OutItem item;
+      while (true)
+      {
+         bool popped = false;
+         sinkPushed.waitUntil(
+            [&] { return (popped = sinkQueue.tryPop(item)) || stopSink; });
+         if (!popped && !(popped = sinkQueue.tryPop(item)))
+            break;
+         sinkPopped.notify();
+         store.addNavData(item.nd);
+         double sec = std::chrono::duration<double>(
+            Clock::now() - item.when).count();
+         {
+            std::lock_guard<std::mutex> lock(latencyMutex);
+            latency[item.nd->signal.messageType].add(sec);
+         }
+         item.nd.reset();
+         numStored++;
+         progress.notify();
+      }
+   }
+
+
+   void PNBNavDataPipeline ::
+   stop()
+   {
+      stopAdding = true;
+         // Wake any addData() waiting for space, and wait for those
+         // in progress, which may still queue a subframe.
+      for (auto& wi : workers)
+      {
+         wi.second->popped.notify();
+      }
+      progress.waitUntil([this] { return numAdding == 0; });
+      stopWorkers = true;
+      for (auto& wi : workers)
+      {
+         wi.second->pushed.notify();
+         if (wi.second->thread.joinable())
+            wi.second->thread.join();
+      }
+         // The workers are done, so nothing more will be queued.
+      stopSink = true;
+      sinkPushed.notify();
+      if (sinkThread.joinable())
+         sinkThread.join();
+   }
+
+
+   void PNBNavDataPipeline ::
+   writeRecord(std::ostream& s, const PackedNavBits& pnb)
+   {
+      long day, sod;
+      double fsod;
+      TimeSystem ts;
+      pnb.getTransmitTime().get(day, sod, fsod, ts);
+      SatID sat(pnb.getsatSys());
+      ObsID oid(pnb.getobsID());
+      std::string rx(pnb.getRxID());
+      size_t numBits = pnb.getNumBits();
+      std::ostringstream line;
+      line << day << " " << sod << " " << std::setprecision(17) << fsod
+           << " " << StringUtils::asString(ts)
+           << " " << StringUtils::asString(sat.system) << " " << sat.id
+           << " " << StringUtils::asString(oid.band)
+           << " " << StringUtils::asString(oid.code)
+           << " " << StringUtils::asString(pnb.getNavID().navType)
+           << " " << (rx.empty() ? std::string("-") : rx)
+           << " " << numBits << std::hex << std::setfill('0');
+      for (size_t i = 0; i < numBits; i += 32)
+      {
+         unsigned n = (numBits - i < 32) ? numBits - i : 32;
+         unsigned long word = pnb.asUnsignedLong(i, n, 1) << (32 - n);
+         line << " 0x" << std::setw(8) << word;
+      }
+      s << line.str() << std::endl;
+   }
+
+
+   PackedNavBitsPtr PNBNavDataPipeline ::
+   readRecord(const std::string& line)
+   {
+      std::istringstream iss(line);
+      long day, sod;
+      double fsod;
+      int id;
+      std::string tsStr, sysStr, bandStr, codeStr, navStr, rx;
+      if (!(iss >> day >> sod >> fsod >> tsStr >> sysStr >> id >> bandStr
+            >> codeStr >> navStr >> rx))
+      {
+         InvalidParameter exc("Malformed PackedNavBits record: " + line);
+         GNSSTK_THROW(exc);
+      }
+      NavType navType = StringUtils::asNavType(navStr);
+      if (navType == NavType::Unknown)
+      {
+         InvalidParameter exc("Unknown nav type in record: " + line);
+         GNSSTK_THROW(exc);
+      }
+      CommonTime when;
+      when.set(day, sod, fsod, StringUtils::asTimeSystem(tsStr));
+      SatID sat(id, StringUtils::asSatelliteSystem(sysStr));
+      ObsID oid(ObservationType::NavMsg, StringUtils::asCarrierBand(bandStr),
+                StringUtils::asTrackingCode(codeStr));
+      PackedNavBitsPtr rv = std::make_shared<PackedNavBits>(
+         sat, oid, NavID(navType), (rx == "-" ? std::string() : rx), when);
+         // The remainder is the bit count and hex words.
+      std::string bits;
+      std::getline(iss, bits);
+      std::string::size_type begin = bits.find_first_not_of(" \t");
+      if (begin == std::string::npos)
+      {
+         InvalidParameter exc("Missing bits in record: " + line);
+         GNSSTK_THROW(exc);
+      }
+      rv->rawBitInput(bits.substr(begin));
+      return rv;
+   }
+
+
+   size_t PNBNavDataPipeline ::
+   replay(std::istream& s, double cadence)
+   {
+      size_t rv = 0;
+      std::string line;
+      while (std::getline(s, line))
+      {
+         std::string::size_type begin = line.find_first_not_of(" \t\r");
+         if ((begin == std::string::npos) || (line[begin] == '#'))
+            continue;
+         if (addData(readRecord(line), cadence))
+            rv++;
+      }
+      return rv;
+   }
+
+
+   size_t PNBNavDataPipeline ::
+   replay(const std::string& fileName, double cadence)
+   {
+      std::ifstream s(fileName.c_str());
+      if (!s)
+      {
+         FileMissingException exc("Unable to open " + fileName);
+         GNSSTK_THROW(exc);
+      }
+      return replay(s, cadence);
+   }
+
+
+   PNBNavDataFactoryPtr PNBNavDataPipeline ::
+   newFactory(NavType navType)
+   {
+      switch (navType)
+      {
+         case NavType::GPSLNAV:
+            return std::make_shared<PNBGPSLNavDataFactory>();
+         case NavType::GPSCNAVL2:
+         case NavType::GPSCNAVL5:
+            return std::make_shared<PNBGPSCNavDataFactory>();
+         case NavType::GPSCNAV2:
+            return std::make_shared<PNBGPSCNav2DataFactory>();
+         case NavType::GalINAV:
+            return std::make_shared<PNBGalINavDataFactory>();
+         case NavType::GalFNAV:
+            return std::make_shared<PNBGalFNavDataFactory>();
+         case NavType::BeiDou_D1:
+            return std::make_shared<PNBBDSD1NavDataFactory>();
+         case NavType::BeiDou_D2:
+            return std::make_shared<PNBBDSD2NavDataFactory>();
+         case NavType::GloCivilF:
+            return std::make_shared<PNBGLOFNavDataFactory>();
+         case NavType::GloCivilC:
+            return std::make_shared<PNBGLOCNavDataFactory>();
+         default:
+            return PNBNavDataFactoryPtr();
+      }
+   }
+
+} // namespace gnsstk
@@ -0,0 +1,381 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file PNBNavDataPipeline.hpp Define an asynchronous pipeline that
+ * decodes PackedNavBits into a NavDataFactoryWithStore. */
+
+#ifndef GNSSTK_PNBNAVDATAPIPELINE_HPP
+#define GNSSTK_PNBNAVDATAPIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "PNBNavDataFactory.hpp"
+#include "NavDataFactoryWithStore.hpp"
+#include "MPSCQueue.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup NavFactory
+      //@{
+
+      /** Decode PackedNavBits asynchronously into a
+       * NavDataFactoryWithStore.  This is intended for live use
+       * behind one or more receivers, where calling
+       * PNBMultiGNSSNavDataFactory::addData() synchronously would
+       * let a slow decoder for one GNSS stall every receiver.
+       *
+       * Data flows through three stages:
+       *   1. Any number of threads call addData().  Each subframe is
+       *      routed by its NavType to the input queue of the decoder
+       *      worker for its GNSS.
+       *   2. One worker thread per GNSS (GPS and QZSS, Galileo,
+       *      BeiDou and GLONASS) owns a private set of
+       *      PNBNavDataFactory objects and decodes its subframes in
+       *      the order they were queued.
+       *   3. A single sink thread adds the resulting NavData objects
+       *      to the store with NavDataFactoryWithStore::addNavData().
+       *
+       * The queues between the stages are bounded lock-free
+       * MPSCQueue objects.  When a worker's input queue is full,
+       * addData() either waits for space or drops the subframe,
+       * depending on the Overflow setting.  When the sink queue is
+       * full, the workers wait, so a slow store eventually pushes
+       * back on addData() as well.  Threads with nothing to do
+       * sleep until another stage wakes them, rather than polling.
+       *
+       * The time from addData() to addNavData() is recorded in a
+       * LatencyHistogram for each NavMessageType.
+       *
+       * Subframes may also be recorded to and replayed from text
+       * files (see writeRecord() and replay()) so that live data
+       * can be processed again offline.
+       *
+       * @warning The store is modified by the sink thread.  Call
+       *   flush() before searching or otherwise using the store
+       *   while data is still being added.
+       *
+       * @code
+       * gnsstk::RinexNavDataFactory store;
+       * gnsstk::PNBNavDataPipeline pipe(store);
+       * pipe.setTypeFilter(gnsstk::allNavMessageTypes);
+       * // from any number of receiver threads:
+       * pipe.addData(pnb);
+       * // then, before using the store:
+       * pipe.flush();
+       * @endcode
+       */
+   class PNBNavDataPipeline
+   {
+   public:
+         /// What addData() does when a worker's input queue is full.
+      enum class Overflow
+      {
+         Block, ///< Wait for the worker to make room.
+         Drop   ///< Discard the subframe and return false.
+      };
+
+         /** Histogram of latencies in power-of-two bins of
+          * microseconds.  Bin 0 counts latencies under 1 us, bin i
+          * counts latencies in [2^(i-1),2^i) us, and the last bin
+          * also counts anything longer. */
+      class LatencyHistogram
+      {
+      public:
+            /// Number of bins, covering latencies up to about 18 min.
+         static const unsigned numBins = 32;
+            /// Initialize to empty.
+         LatencyHistogram();
+            /** Add a latency.
+             * @param[in] seconds The latency in seconds. */
+         void add(double seconds);
+            /** Get an upper bound for a percentile of the latencies.
+             * @param[in] pct The percentile (0-100).
+             * @return The upper edge in seconds of the bin holding
+             *   the given percentile, limited to maxSec, or 0 if
+             *   the histogram is empty. */
+         double percentile(double pct) const;
+            /// Return the mean latency in seconds.
+         double mean() const
+         { return count ? totalSec / count : 0; }
+         unsigned long count;  ///< Number of latencies recorded.
+         double minSec;        ///< Smallest latency in seconds.
+         double maxSec;        ///< Largest latency in seconds.
+         double totalSec;      ///< Sum of the latencies in seconds.
+         std::vector<unsigned long> bins; ///< Counts in each bin.
+      };
+
+         /// Latency statistics for each kind of message stored.
+      typedef std::map<NavMessageType, LatencyHistogram> LatencyMap;
+
+         /** Create the decoders and start the threads.
+          * @param[in] store The store to add decoded data to.  It
+          *   must outlive this object.
+          * @param[in] queueSize The capacity of each queue.
+          * @param[in] overflow What to do when an input queue is
+          *   full. */
+      PNBNavDataPipeline(NavDataFactoryWithStore& store,
+                         size_t queueSize = 1024,
+                         Overflow overflow = Overflow::Block);
+
+         /// Process any remaining data and stop the threads.
+      ~PNBNavDataPipeline();
+
+      PNBNavDataPipeline(const PNBNavDataPipeline&) = delete;
+      PNBNavDataPipeline& operator=(const PNBNavDataPipeline&) = delete;
+
+         /** Set the decoders' handling of valid and invalid
+          * navigation data.  This may be called at any time; each
+          * decoder is changed between subframes, so subframes
+          * already queued may be decoded with either setting.
+          * @param[in] nvt The new nav data loading filter method. */
+      void setValidityFilter(NavValidityType nvt);
+
+         /** Indicate what nav message types the decoders should be
+          * loading.  This may be called at any time, as
+          * setValidityFilter().
+          * @param[in] nmts The set of nav message types to be
+          *   processed by the decoders. */
+      void setTypeFilter(const NavMessageTypeSet& nmts);
+
+         /** Set the configuration parameters of the decoders.  This
+          * may be called at any time, as setValidityFilter().
+          * @param[in] ctrl The configuration for the decoders. */
+      void setControl(const FactoryControl& ctrl);
+
+         /** Queue a PackedNavBits object for decoding.  This may be
+          * called by any number of threads at once, but not once
+          * the pipeline is being destroyed.
+          * @param[in] navIn The PackedNavBits data to process.
+          * @param[in] cadence The data rate of the navigation
+          *   messages being processed, as for
+          *   PNBNavDataFactory::addData().
+          * @return false if there is no decoder for the nav type of
+          *   navIn, if the input queue was full and overflow is
+          *   Overflow::Drop, or if the pipeline has been stopped. */
+      bool addData(const PackedNavBitsPtr& navIn, double cadence = -1);
+
+         /** Wait until everything accepted by addData() so far has
+          * been decoded and added to the store. */
+      void flush();
+
+         /** Stop accepting data, finish decoding and storing what
+          * was accepted, and stop the threads.  Any addData() calls
+          * waiting for queue space, and all later ones, return
+          * false.  This is done by the destructor, and does nothing
+          * if already done. */
+      void stop();
+
+         /** Flush the pipeline, then reset the state of the decoders
+          * as PNBNavDataFactory::resetState() does, e.g. before
+          * adding discontinuous data. */
+      void resetState();
+
+         /// Return the number of subframes accepted by addData().
+      unsigned long getNumAccepted() const
+      { return numAccepted; }
+         /// Return the number of subframes dropped due to full queues.
+      unsigned long getNumDropped() const
+      { return numDropped; }
+         /** Return the number of subframes the decoders reported
+          * errors on or threw an exception for. */
+      unsigned long getNumRejected() const
+      { return numRejected; }
+         /// Return the number of NavData objects added to the store.
+      unsigned long getNumStored() const
+      { return numStored; }
+
+         /// Get a copy of the latency statistics.
+      LatencyMap getLatency() const;
+         /// Clear the latency statistics.
+      void resetLatency();
+
+         /** Write a PackedNavBits object as a single line of text
+          * that can be read by readRecord().  The format is
+          * "day sod fsod timeSystem satSystem satID carrier code
+          * navType rxID numBits hexWords", where the first four
+          * fields are the transmit time as stored in CommonTime and
+          * the bits are left-justified 32-bit words as read by
+          * PackedNavBits::rawBitInput().  An empty rxID is written
+          * as "-".
+          * @param[in,out] s The stream to write to.
+          * @param[in] pnb The data to write. */
+      static void writeRecord(std::ostream& s, const PackedNavBits& pnb);
+
+         /** Decode a line written by writeRecord().
+          * @param[in] line The text to decode.
+          * @return The decoded PackedNavBits object.
+          * @throw InvalidParameter if the line is malformed. */
+      static PackedNavBitsPtr readRecord(const std::string& line);
+
+         /** Pass every record in a stream to addData().  Blank lines
+          * and lines starting with '#' are ignored.
+          * @param[in,out] s The stream of records.
+          * @param[in] cadence The cadence to pass to addData().
+          * @return The number of records accepted by addData().
+          * @throw InvalidParameter if a record is malformed. */
+      size_t replay(std::istream& s, double cadence = -1);
+
+         /** Pass every record in a file to addData().
+          * @param[in] fileName The path of the recorded file.
+          * @param[in] cadence The cadence to pass to addData().
+          * @return The number of records accepted by addData().
+          * @throw FileMissingException if the file can't be opened.
+          * @throw InvalidParameter if a record is malformed. */
+      size_t replay(const std::string& fileName, double cadence = -1);
+
+         /** Create a new decoder for the given nav type.
+          * @param[in] navType The nav message type to be decoded.
+          * @return The new factory, or nullptr if navType isn't
+          *   supported. */
+      static PNBNavDataFactoryPtr newFactory(NavType navType);
+
+   private:
+      typedef std::chrono::steady_clock Clock;
+
+         /** Lets a thread sleep until another thread changes what it
+          * is waiting for, e.g. pushes to an empty queue.  The
+          * waiting thread retries its operation after announcing
+          * itself, so notify() only has to wake it if there is a
+          * waiter, which keeps notify() cheap while the pipeline is
+          * busy. */
+      class EventCount
+      {
+      public:
+         EventCount() : epoch(0), waiters(0) {}
+            /** Call tryOp() until it returns true, sleeping between
+             * calls until notify() is called. */
+         template <class TryOp>
+         void waitUntil(TryOp tryOp)
+         {
+            while (!tryOp())
+            {
+               unsigned long key = prepareWait();
+               if (tryOp())
+               {
+                  waiters--;
+                  return;
+               }
+               wait(key);
+            }
+         }
+            /// Wake the waiting threads, after changing the state.
+         void notify();
+      private:
+            /// Announce a waiter and return the current epoch.
+         unsigned long prepareWait();
+            /// Sleep until the epoch changes from key.
+         void wait(unsigned long key);
+         std::mutex mutex;
+         std::condition_variable cond;
+         std::atomic<unsigned long> epoch;
+         std::atomic<unsigned> waiters;
+      };
+
+         /// A subframe waiting to be decoded.
+      struct InItem
+      {
+         PackedNavBitsPtr pnb;
+         double cadence;
+         Clock::time_point when; ///< Time passed to addData().
+      };
+         /// A decoded message waiting to be stored.
+      struct OutItem
+      {
+         NavDataPtr nd;
+         Clock::time_point when; ///< Time its subframe was queued.
+      };
+         /// The input queue, decoders and thread for one GNSS.
+      struct Worker
+      {
+         explicit Worker(size_t queueSize) : queue(queueSize) {}
+         MPSCQueue<InItem> queue;
+            /// Notified when an item is pushed to queue.
+         EventCount pushed;
+            /// Notified when an item is popped from queue.
+         EventCount popped;
+            /// Held by the worker thread while decoding.
+         std::mutex factoryMutex;
+         PNBNavDataFactoryMap factories;
+         std::thread thread;
+      };
+
+         /// Decode the data queued for worker w until stopped.
+      void decodeLoop(Worker& w);
+         /// Store the decoded data until stopped.
+      void sinkLoop();
+         /// Call func for each decoder, under its worker's lock.
+      template <class Func>
+      void forEachFactory(Func func);
+
+      NavDataFactoryWithStore& store;
+      Overflow overflow;
+         /// Workers indexed by the GNSS of their nav types.
+      std::map<SatelliteSystem, std::unique_ptr<Worker> > workers;
+         /// Worker for each supported nav type.
+      std::map<NavType, Worker*> workerByType;
+      MPSCQueue<OutItem> sinkQueue;
+         /// Notified when an item is pushed to sinkQueue.
+      EventCount sinkPushed;
+         /// Notified when an item is popped from sinkQueue.
+      EventCount sinkPopped;
+         /// Notified when a count flush() or stop() waits on changes.
+      EventCount progress;
+      std::thread sinkThread;
+      std::atomic<bool> stopAdding, stopWorkers, stopSink;
+
+      std::atomic<unsigned long> numAccepted, numDropped, numRejected,
+         numDecoded, numQueued, numStored;
+         /// Number of addData() calls in progress.
+      std::atomic<unsigned> numAdding;
+
+      mutable std::mutex latencyMutex;
+      LatencyMap latency;
+   }; // class PNBNavDataPipeline
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_PNBNAVDATAPIPELINE_HPP
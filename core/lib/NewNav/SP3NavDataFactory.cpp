@@ -1013,58 +1013,21 @@ namespace gnsstk
       DEBUGTRACE_FUNCTION();
       DEBUGTRACE("start interpolating ephemeris, distance = "
                  << std::distance(ti1,ti3));
-      std::vector<double> tdata(2*halfOrderPos);
-      std::vector<std::vector<double>> posData(3), posSigData(3), velData(3),
-         velSigData(3), accData(3), accSigData(3);
-      CommonTime firstTime(ti1->second->timeStamp);
+      std::shared_ptr<const EphSamples> samples(getEphSamples(ti1, ti3));
+      const CommonTime& firstTime(samples->firstTime);
+      const std::vector<double>& tdata(samples->tdata);
+      const std::vector<std::vector<double>>& posData(samples->posData);
+      const std::vector<std::vector<double>>& posSigData(samples->posSigData);
+      const std::vector<std::vector<double>>& velData(samples->velData);
+      const std::vector<std::vector<double>>& velSigData(samples->velSigData);
+      const std::vector<std::vector<double>>& accData(samples->accData);
+      const std::vector<std::vector<double>>& accSigData(samples->accSigData);
          // This flag is only used to decide whether to compute sigmas
          // or use existing ones.  It is expected that for exact time
          // matches, navData will already have any sigma data filled
          // in.
-      bool isExact = false;
-      unsigned idx = 0;
-         // posData etc are 2D arrays, where the first dimension
-         // is positional, x=0,y=1,z=2 and the 2nd dimension is
-         // the data index for the fit.
-      for (unsigned i = 0; i < 3; i++)
-      {
-         posData[i].resize(2*halfOrderPos);
-         posSigData[i].resize(2*halfOrderPos);
-         velData[i].resize(2*halfOrderPos);
-         velSigData[i].resize(2*halfOrderPos);
-         accData[i].resize(2*halfOrderPos);
-         accSigData[i].resize(2*halfOrderPos);
-      }
-      DEBUGTRACE("resized");
-      bool haveVel = false, haveAcc = false;
-      NavMap::iterator ti2;
-      for (ti2 = ti1, idx=0; ti2 != ti3; ++ti2, ++idx)
-      {
-         DEBUGTRACE("idx=" << idx);
-         tdata[idx] = ti2->second->timeStamp - firstTime;
-         if ((idx == halfOrderPos) && (ti2->second->timeStamp == when))
-            isExact = true;
-         OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(
-            ti2->second.get());
-         DEBUGTRACE("nav=" << nav);
-         // ti2->second->dump(cerr, DumpDetail::Full);
-         for (unsigned i = 0; i < 3; i++)
-         {
-            DEBUGTRACE("i=" << i);
-            DEBUGTRACE(posData.size() << " " << velData.size() << " "
-                       << accData.size());
-            DEBUGTRACE(nav->pos.size() << " " << nav->vel.size() << " "
-                       << nav->acc.size());
-            posData[i][idx] = nav->pos[i];
-            velData[i][idx] = nav->vel[i];
-            accData[i][idx] = nav->acc[i];
-            posSigData[i][idx] = nav->posSig[i];
-            velSigData[i][idx] = nav->velSig[i];
-            accSigData[i][idx] = nav->accSig[i];
-            haveVel |= (nav->vel[i] != 0.0);
-            haveAcc |= (nav->acc[i] != 0.0);
-         }
-      }
+      bool isExact = (samples->haveMid && (samples->midTime == when));
+      bool haveVel = samples->haveVel, haveAcc = samples->haveAcc;
       double dt = when - firstTime, err;
       OrbitDataSP3 *osp3 = dynamic_cast<OrbitDataSP3*>(navData.get());
       DEBUGTRACE(printTime(when, "when=%Y/%02m/%02d %02H:%02M:%02S"));
@@ -1188,38 +1151,22 @@ namespace gnsstk
       DEBUGTRACE("start interpolating clock, distance = "
                  << std::distance(ti1,ti3));
       unsigned Nhi = halfOrderClk, Nlow = halfOrderClk-1;
-      std::vector<double> tdata(2*halfOrderClk),
-         biasData(2*halfOrderClk), biasSigData(2*halfOrderClk),
-         driftData(2*halfOrderClk), driftSigData(2*halfOrderClk),
-         drRateData(2*halfOrderClk), drRateSigData(2*halfOrderClk);
-      CommonTime firstTime(ti1->second->timeStamp);
+      std::shared_ptr<const ClkSamples> samples(getClkSamples(ti1, ti3));
+      const CommonTime& firstTime(samples->firstTime);
+      const std::vector<double>& tdata(samples->tdata);
+      const std::vector<double>& biasData(samples->biasData);
+      const std::vector<double>& biasSigData(samples->biasSigData);
+      const std::vector<double>& driftData(samples->driftData);
+      const std::vector<double>& driftSigData(samples->driftSigData);
+      const std::vector<double>& drRateData(samples->drRateData);
+      const std::vector<double>& drRateSigData(samples->drRateSigData);
          // This flag is only used to decide whether to compute sigmas
          // or use existing ones.  It is expected that for exact time
          // matches, navData will already have any sigma data filled
          // in.
-      bool isExact = false;
-      unsigned idx = 0;
-      bool haveDrift = false, haveDriftRate = false;
-      NavMap::iterator ti2;
-      for (ti2 = ti1, idx=0; ti2 != ti3; ++ti2, ++idx)
-      {
-         DEBUGTRACE("idx=" << idx);
-         tdata[idx] = ti2->second->timeStamp - firstTime;
-         if ((idx == halfOrderClk) && (ti2->second->timeStamp == when))
-            isExact = true;
-         OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(
-            ti2->second.get());
-         DEBUGTRACE("nav=" << nav);
-         // ti2->second->dump(cerr, DumpDetail::Full);
-         biasData[idx] = nav->clkBias;
-         driftData[idx] = nav->clkDrift;
-         drRateData[idx] = nav->clkDrRate;
-         biasSigData[idx] = nav->biasSig;
-         driftSigData[idx] = nav->driftSig;
-         drRateSigData[idx] = nav->drRateSig;
-         haveDrift |= (nav->clkDrift != 0.0);
-         haveDriftRate |= (nav->clkDrRate != 0.0);
-      }
+      bool isExact = (samples->haveMid && (samples->midTime == when));
+      bool haveDrift = samples->haveDrift,
+         haveDriftRate = samples->haveDriftRate;
       double dt = when - firstTime, err, slope,
          slopedt = tdata[Nhi]-tdata[Nlow];
       OrbitDataSP3 *osp3 = dynamic_cast<OrbitDataSP3*>(navData.get());
@@ -1329,6 +1276,164 @@ namespace gnsstk
    }
 
 
+   std::shared_ptr<const SP3NavDataFactory::EphSamples> SP3NavDataFactory ::
+   getEphSamples(const NavMap::iterator& ti1, const NavMap::iterator& ti3)
+   {
+      DEBUGTRACE_FUNCTION();
+      InterpKey key(&(*ti1), halfOrderPos);
+      if (interpCache.maxWindows > 0)
+      {
+         std::lock_guard<std::mutex> lock(interpCache.mtx);
+         interpCache.dropStale();
+         auto ci = interpCache.eph.find(key);
+         if (ci != interpCache.eph.end())
+         {
+            interpCache.hits++;
+            return ci->second;
+         }
+         interpCache.misses++;
+      }
+      std::shared_ptr<EphSamples> rv(std::make_shared<EphSamples>());
+      rv->firstTime = ti1->second->timeStamp;
+      rv->haveMid = rv->haveVel = rv->haveAcc = false;
+      rv->tdata.resize(2*halfOrderPos);
+      rv->posData.resize(3);
+      rv->posSigData.resize(3);
+      rv->velData.resize(3);
+      rv->velSigData.resize(3);
+      rv->accData.resize(3);
+      rv->accSigData.resize(3);
+      unsigned idx = 0;
+         // posData etc are 2D arrays, where the first dimension
+         // is positional, x=0,y=1,z=2 and the 2nd dimension is
+         // the data index for the fit.
+      for (unsigned i = 0; i < 3; i++)
+      {
+         rv->posData[i].resize(2*halfOrderPos);
+         rv->posSigData[i].resize(2*halfOrderPos);
+         rv->velData[i].resize(2*halfOrderPos);
+         rv->velSigData[i].resize(2*halfOrderPos);
+         rv->accData[i].resize(2*halfOrderPos);
+         rv->accSigData[i].resize(2*halfOrderPos);
+      }
+      DEBUGTRACE("resized");
+      NavMap::iterator ti2;
+      for (ti2 = ti1, idx=0; ti2 != ti3; ++ti2, ++idx)
+      {
+         DEBUGTRACE("idx=" << idx);
+         rv->tdata[idx] = ti2->second->timeStamp - rv->firstTime;
+         if (idx == halfOrderPos)
+         {
+            rv->haveMid = true;
+            rv->midTime = ti2->second->timeStamp;
+         }
+         OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(
+            ti2->second.get());
+         DEBUGTRACE("nav=" << nav);
+         for (unsigned i = 0; i < 3; i++)
+         {
+            rv->posData[i][idx] = nav->pos[i];
+            rv->velData[i][idx] = nav->vel[i];
+            rv->accData[i][idx] = nav->acc[i];
+            rv->posSigData[i][idx] = nav->posSig[i];
+            rv->velSigData[i][idx] = nav->velSig[i];
+            rv->accSigData[i][idx] = nav->accSig[i];
+            rv->haveVel |= (nav->vel[i] != 0.0);
+            rv->haveAcc |= (nav->acc[i] != 0.0);
+         }
+      }
+      if (interpCache.maxWindows > 0)
+      {
+         std::lock_guard<std::mutex> lock(interpCache.mtx);
+         interpCache.dropStale();
+            // setInterpCacheSize may have run since the check above.
+         size_t limit = interpCache.maxWindows;
+         if ((interpCache.eph.size() + interpCache.clk.size()) >= limit)
+         {
+            DEBUGTRACE("interpolation cache full, emptying");
+            interpCache.eph.clear();
+            interpCache.clk.clear();
+         }
+         if (limit > 0)
+         {
+            interpCache.eph[key] = rv;
+         }
+      }
+      return rv;
+   }
+
+
+   std::shared_ptr<const SP3NavDataFactory::ClkSamples> SP3NavDataFactory ::
+   getClkSamples(const NavMap::iterator& ti1, const NavMap::iterator& ti3)
+   {
+      DEBUGTRACE_FUNCTION();
+      InterpKey key(&(*ti1), halfOrderClk);
+      if (interpCache.maxWindows > 0)
+      {
+         std::lock_guard<std::mutex> lock(interpCache.mtx);
+         interpCache.dropStale();
+         auto ci = interpCache.clk.find(key);
+         if (ci != interpCache.clk.end())
+         {
+            interpCache.hits++;
+            return ci->second;
+         }
+         interpCache.misses++;
+      }
+      std::shared_ptr<ClkSamples> rv(std::make_shared<ClkSamples>());
+      rv->firstTime = ti1->second->timeStamp;
+      rv->haveMid = rv->haveDrift = rv->haveDriftRate = false;
+      rv->tdata.resize(2*halfOrderClk);
+      rv->biasData.resize(2*halfOrderClk);
+      rv->biasSigData.resize(2*halfOrderClk);
+      rv->driftData.resize(2*halfOrderClk);
+      rv->driftSigData.resize(2*halfOrderClk);
+      rv->drRateData.resize(2*halfOrderClk);
+      rv->drRateSigData.resize(2*halfOrderClk);
+      unsigned idx = 0;
+      NavMap::iterator ti2;
+      for (ti2 = ti1, idx=0; ti2 != ti3; ++ti2, ++idx)
+      {
+         DEBUGTRACE("idx=" << idx);
+         rv->tdata[idx] = ti2->second->timeStamp - rv->firstTime;
+         if (idx == halfOrderClk)
+         {
+            rv->haveMid = true;
+            rv->midTime = ti2->second->timeStamp;
+         }
+         OrbitDataSP3 *nav = dynamic_cast<OrbitDataSP3*>(
+            ti2->second.get());
+         DEBUGTRACE("nav=" << nav);
+         rv->biasData[idx] = nav->clkBias;
+         rv->driftData[idx] = nav->clkDrift;
+         rv->drRateData[idx] = nav->clkDrRate;
+         rv->biasSigData[idx] = nav->biasSig;
+         rv->driftSigData[idx] = nav->driftSig;
+         rv->drRateSigData[idx] = nav->drRateSig;
+         rv->haveDrift |= (nav->clkDrift != 0.0);
+         rv->haveDriftRate |= (nav->clkDrRate != 0.0);
+      }
+      if (interpCache.maxWindows > 0)
+      {
+         std::lock_guard<std::mutex> lock(interpCache.mtx);
+         interpCache.dropStale();
+            // setInterpCacheSize may have run since the check above.
+         size_t limit = interpCache.maxWindows;
+         if ((interpCache.eph.size() + interpCache.clk.size()) >= limit)
+         {
+            DEBUGTRACE("interpolation cache full, emptying");
+            interpCache.eph.clear();
+            interpCache.clk.clear();
+         }
+         if (limit > 0)
+         {
+            interpCache.clk[key] = rv;
+         }
+      }
+      return rv;
+   }
+
+
    bool SP3NavDataFactory ::
    setSignal(const SatID& sat, NavMessageID& signal)
    {
@@ -1586,4 +1691,70 @@ namespace gnsstk
         << "End dump SP3NavDataFactory." << endl;
    }
 
+
+   void SP3NavDataFactory ::
+   setInterpCacheSize(size_t maxWindows)
+   {
+      std::lock_guard<std::mutex> lock(interpCache.mtx);
+      interpCache.maxWindows = maxWindows;
+      interpCache.stale = false;
+      interpCache.eph.clear();
+      interpCache.clk.clear();
+   }
+
+
+   unsigned long SP3NavDataFactory ::
+   getInterpCacheHits() const
+   {
+      std::lock_guard<std::mutex> lock(interpCache.mtx);
+      return interpCache.hits;
+   }
+
+
+   unsigned long SP3NavDataFactory ::
+   getInterpCacheMisses() const
+   {
+      std::lock_guard<std::mutex> lock(interpCache.mtx);
+      return interpCache.misses;
+   }
+
+
+   void SP3NavDataFactory ::
+   clearInterpCache()
+   {
+      interpCache.clear();
+      std::lock_guard<std::mutex> lock(interpCache.mtx);
+      interpCache.hits = interpCache.misses = 0;
+   }
+
+
+   void SP3NavDataFactory ::
+   thaw()
+   {
+      NavDataFactoryWithStoreFile::thaw();
+      interpCache.stale = true;
+   }
+
+
+   SP3NavDataFactory::InterpCache& SP3NavDataFactory::InterpCache ::
+   operator=(const InterpCache& right)
+   {
+      if (this != &right)
+      {
+         clear();
+         maxWindows = right.maxWindows.load();
+      }
+      return *this;
+   }
+
+
+   void SP3NavDataFactory::InterpCache ::
+   clear()
+   {
+      std::lock_guard<std::mutex> lock(mtx);
+      stale = false;
+      eph.clear();
+      clk.clear();
+   }
+
 } // namespace gnsstk
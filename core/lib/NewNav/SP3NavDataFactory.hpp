@@ -39,6 +39,10 @@
 #ifndef GNSSTK_SP3NAVDATAFACTORY_HPP
 #define GNSSTK_SP3NAVDATAFACTORY_HPP
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
 #include "NavDataFactoryWithStoreFile.hpp"
 #include "SP3Data.hpp"
 #include "SP3Header.hpp"
@@ -165,7 +169,7 @@ namespace gnsstk
          /** Clear the clock dataset only, meaning remove all clock
           * data from the internal store. */
       void clearClock()
-      { data.erase(NavMessageType::Clock); }
+      { data.erase(NavMessageType::Clock); interpCache.clear(); }
 
          /** Choose to load the clock data tables from RINEX clock
           * files. This will clear the clock store if the state
@@ -320,7 +324,161 @@ namespace gnsstk
           * given stream. */
       void dumpConfig(std::ostream& s) const;
 
+         /** Set the maximum number of interpolation windows to keep
+          * in the interpolation cache.  Each window holds the data
+          * samples gathered from the internal store for one
+          * satellite's ephemeris or clock interpolation, so that
+          * subsequent searches that use the same records (e.g. a
+          * dense sequence of times) do not need to gather them
+          * again.  A window uses roughly 56 bytes per interpolation
+          * point (e.g. 560 bytes for the default order of 10) plus
+          * container overhead.  When the limit is reached, the cache
+          * is emptied and refilled as needed.  For best results when
+          * processing many satellites at each time, the limit should
+          * be at least twice the number of satellites (ephemeris and
+          * clock).  Only the gathering of samples is cached; the
+          * interpolation weights depend on the time of interest and
+          * are computed for every search.  The cache only affects
+          * performance, the search results are identical with or
+          * without it.
+          * @param[in] maxWindows The maximum number of windows to
+          *   cache.  A value of 0 (the default) disables caching.
+          * @note Searches that use the cache take a lock on it, see
+          *   \ref NavFactoryThreads. */
+      void setInterpCacheSize(size_t maxWindows);
+
+         /// Get the maximum number of interpolation windows to cache.
+      size_t getInterpCacheSize() const
+      { return interpCache.maxWindows.load(); }
+
+         /** Get the number of interpolations that used data from the
+          * interpolation cache. */
+      unsigned long getInterpCacheHits() const;
+
+         /** Get the number of interpolations that had to gather data
+          * from the internal store while the interpolation cache was
+          * enabled. */
+      unsigned long getInterpCacheMisses() const;
+
+         /// Empty the interpolation cache and reset its counters.
+      void clearInterpCache();
+
+         /** Discard the frozen search index and mark the
+          * interpolation cache as stale.  The cache is emptied by
+          * the next search that uses it, so loading many records
+          * empties it only once. */
+      void thaw() override;
+
    private:
+         /** Data samples gathered from a sequence of records in the
+          * internal store for ephemeris interpolation. */
+      class EphSamples
+      {
+      public:
+            /// Time stamp of the first record.
+         CommonTime firstTime;
+            /// Time stamp of the record at index halfOrderPos.
+         CommonTime midTime;
+            /// True if there are enough records for midTime to be set.
+         bool haveMid;
+            /// True if any record has non-zero velocity.
+         bool haveVel;
+            /// True if any record has non-zero acceleration.
+         bool haveAcc;
+            /// Record times in seconds relative to firstTime.
+         std::vector<double> tdata;
+            /** Record data indexed by axis (x=0,y=1,z=2), then by
+             * record. */
+         std::vector<std::vector<double>> posData, posSigData, velData,
+            velSigData, accData, accSigData;
+      };
+
+         /** Data samples gathered from a sequence of records in the
+          * internal store for clock interpolation. */
+      class ClkSamples
+      {
+      public:
+            /// Time stamp of the first record.
+         CommonTime firstTime;
+            /// Time stamp of the record at index halfOrderClk.
+         CommonTime midTime;
+            /// True if there are enough records for midTime to be set.
+         bool haveMid;
+            /// True if any record has a non-zero drift.
+         bool haveDrift;
+            /// True if any record has a non-zero drift rate.
+         bool haveDriftRate;
+            /// Record times in seconds relative to firstTime.
+         std::vector<double> tdata;
+            /// Record data indexed by record.
+         std::vector<double> biasData, biasSigData, driftData, driftSigData,
+            drRateData, drRateSigData;
+      };
+
+         /** Identify a window of records by the first record in the
+          * internal store and the number of records.  The store's
+          * map nodes do not move, and any change to the store marks
+          * the cache stale so it is emptied before its next use, so
+          * the address is a stable key. */
+      typedef std::pair<const NavMap::value_type*, unsigned> InterpKey;
+
+         /** Cache of data samples for interpolation.  The samples
+          * are shared so that a search can keep using them after
+          * releasing the lock even if another thread empties the
+          * cache. */
+      class InterpCache
+      {
+      public:
+            /// Initialize an empty, disabled cache.
+         InterpCache()
+               : maxWindows(0), stale(false), hits(0), misses(0)
+         {}
+            /// Copy the size limit only.  The contents are not copied.
+         InterpCache(const InterpCache& right)
+               : maxWindows(right.maxWindows.load()), stale(false),
+                 hits(0), misses(0)
+         {}
+            /// Copy the size limit only.  The contents are discarded.
+         InterpCache& operator=(const InterpCache& right);
+            /// Remove all the cached windows.
+         void clear();
+            /** Remove all the cached windows if the store has changed
+             * since they were gathered.  Call with mtx locked. */
+         void dropStale()
+         {
+            if (stale.exchange(false))
+            {
+               eph.clear();
+               clk.clear();
+            }
+         }
+            /** Maximum number of windows (eph + clk), 0 = disabled.
+             * Atomic so searches can skip the lock when disabled. */
+         std::atomic<size_t> maxWindows;
+            /// Set when the store changes, cleared by dropStale().
+         std::atomic<bool> stale;
+            /// Number of searches that found their window in the cache.
+         unsigned long hits;
+            /// Number of searches that did not.
+         unsigned long misses;
+            /// Cached ephemeris windows.
+         std::map<InterpKey, std::shared_ptr<const EphSamples> > eph;
+            /// Cached clock windows.
+         std::map<InterpKey, std::shared_ptr<const ClkSamples> > clk;
+            /// Serialize access to all the above.
+         mutable std::mutex mtx;
+      };
+
+         /** Gather the data for interpolateEph() from the records
+          * in [ti1,ti3), using the cache if it's enabled. */
+      std::shared_ptr<const EphSamples>
+      getEphSamples(const NavMap::iterator& ti1, const NavMap::iterator& ti3);
+
+         /** Gather the data for interpolateClk() from the records
+          * in [ti1,ti3), using the cache if it's enabled. */
+      std::shared_ptr<const ClkSamples>
+      getClkSamples(const NavMap::iterator& ti1, const NavMap::iterator& ti3);
+
          /** Load a RINEX clock file into internal store.
           * @post If RINEX clock data is successfully loaded, the
           *   factory will be automatically switched to use RINEX
@@ -518,6 +676,9 @@ namespace gnsstk
 
          /// Clock data interpolation method.
       ClkInterpType interpType;
+
+         /// Gathered data for recently used interpolation windows.
+      InterpCache interpCache;
    };
 
       //@}
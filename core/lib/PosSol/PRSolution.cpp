@@ -40,6 +40,11 @@
 /// Pseudorange navigation solution, either a simple solution using all the
 /// given data, or a solution including editing via a RAIM algorithm.
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
 #include "MathBase.hpp"
 #include "PRSolution.hpp"
 #include "GPSEllipsoid.hpp"
@@ -516,6 +521,489 @@ namespace gnsstk
    } // end PRSolution::SimplePRSolution
 
 
+   // -------------------------------------------------------------------------
+   // Norm of the vector v of length n, computed as norm(Vector) does.
+   static double scaledNorm(const double *v, size_t n)
+   {
+      double mag(0.0);
+      if(n == 0) return mag;
+      mag = ::fabs(v[0]);
+      for(size_t i=1; i<n; i++) {
+         if(mag > ::fabs(v[i]))
+            mag *= SQRT(1.0+(v[i]/mag)*(v[i]/mag));
+         else if(::fabs(v[i]) > mag)
+            mag = ::fabs(v[i])*SQRT(1.0+(mag/v[i])*(mag/v[i]));
+         else
+            mag *= SQRT(2.0);
+      }
+      return mag;
+   }
+
+   // -------------------------------------------------------------------------
+   // Invert the symmetric positive definite n x n matrix A (row major) by
+   // Cholesky decomposition, using work (2*n*n) as scratch. Return false if A
+   // is not positive definite, or is so poorly conditioned that inverseSVD()
+   // might edit its singular values (trace(A)*trace(inverse) bounds the
+   // condition number from above).
+   static bool invertCholesky(const double *A, double *Ainv, double *work,
+                              size_t n)
+   {
+      size_t i,j,k;
+      double sum, traceA(0.0), traceInv(0.0);
+      double *L(work), *Linv(work+n*n);
+
+      // A = L*L'
+      for(j=0; j<n; j++) {
+         traceA += A[j*n+j];
+         sum = A[j*n+j];
+         for(k=0; k<j; k++) sum -= L[j*n+k]*L[j*n+k];
+         if(!(sum > 0.0)) return false;
+         L[j*n+j] = SQRT(sum);
+         for(i=j+1; i<n; i++) {
+            sum = A[i*n+j];
+            for(k=0; k<j; k++) sum -= L[i*n+k]*L[j*n+k];
+            L[i*n+j] = sum/L[j*n+j];
+         }
+      }
+
+      // inverse of L, lower triangular
+      for(i=0; i<n; i++) {
+         Linv[i*n+i] = 1.0/L[i*n+i];
+         for(j=0; j<i; j++) {
+            sum = 0.0;
+            for(k=j; k<i; k++) sum += L[i*n+k]*Linv[k*n+j];
+            Linv[i*n+j] = -sum/L[i*n+i];
+         }
+      }
+
+      // inverse(A) = Linv'*Linv
+      for(i=0; i<n; i++) {
+         for(j=0; j<=i; j++) {
+            sum = 0.0;
+            for(k=i; k<n; k++) sum += Linv[k*n+i]*Linv[k*n+j];
+            Ainv[i*n+j] = Ainv[j*n+i] = sum;
+         }
+         traceInv += Ainv[i*n+i];
+      }
+
+      return (traceA*traceInv < 1.e8);
+   }
+
+   // -------------------------------------------------------------------------
+   void PRSolution::prepareSubsets(const vector<SatID>& Sats,
+                                   const Matrix<double>& SVP,
+                                   const Matrix<double>& invMC)
+   {
+      SubsetEpoch& ep(subsetEpoch);
+      const size_t nall(3+allowedGNSS.size());
+      size_t i,j,k,n;
+      int a;
+      GPSEllipsoid ellip;
+
+      // good satellites and their systems
+      ep.good.clear();
+      ep.sys.clear();
+      ep.nsys.assign(allowedGNSS.size(),0);
+      for(i=0; i<Sats.size(); i++) {
+         if(Sats[i].id <= 0) continue;
+         a = vectorindex(allowedGNSS, Sats[i].system);
+         if(a == -1) continue;
+         ep.good.push_back(i);
+         ep.sys.push_back(a);
+         ep.nsys[a]++;
+      }
+      const size_t ngood(ep.good.size());
+
+      // apriori state
+      ep.apriori.assign(nall,0.0);
+      if(hasMemory) {
+         for(i=0; i<nall && i<APSolution.size(); i++)
+            ep.apriori[i] = APSolution[i];
+      }
+
+      // weighting
+      ep.weighted = (invMC.rows() > 0);
+      ep.diagonal = true;
+      ep.weight.assign(ngood,1.0);
+      if(ep.weighted) {
+         for(i=0; i<ngood; i++) {
+            ep.weight[i] = invMC(ep.good[i],ep.good[i]);
+            for(j=0; j<ngood; j++)
+               if(j != i && invMC(ep.good[i],ep.good[j]) != 0.0)
+                  ep.diagonal = false;
+         }
+      }
+
+      // first iteration: time of flight guess 70ms, no trop
+      ep.dirCos.resize(3*ngood);
+      ep.cRange.resize(ngood);
+      ep.resid.resize(ngood);
+      const double wt(ellip.angVelocity()*0.070);
+      for(n=0; n<ngood; n++) {
+         i = ep.good[n];
+         double svxyz[3];
+         svxyz[0] =  ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1);
+         svxyz[1] = -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1);
+         svxyz[2] = SVP(i,2);
+         double rho = RSS(svxyz[0]-ep.apriori[0],
+                          svxyz[1]-ep.apriori[1],
+                          svxyz[2]-ep.apriori[2]);
+         for(k=0; k<3; k++)
+            ep.dirCos[3*n+k] = (ep.apriori[k]-svxyz[k])/rho;
+         ep.cRange[n] = SVP(i,3) - rho;
+         ep.resid[n] = ep.cRange[n] - ep.apriori[3+ep.sys[n]];
+      }
+
+      // first iteration normal equations for all the good satellites, in the
+      // state of all allowed systems; not used for non-diagonal weights
+      ep.info.assign(nall*nall,0.0);
+      ep.infoState.assign(nall,0.0);
+      if(!ep.diagonal) return;
+      for(n=0; n<ngood; n++) {
+         const double *p(&ep.dirCos[3*n]);
+         const size_t c(3+ep.sys[n]);
+         const double w(ep.weight[n]);
+         for(j=0; j<3; j++) {
+            for(k=0; k<3; k++)
+               ep.info[j*nall+k] += w*p[j]*p[k];
+            ep.info[j*nall+c] += w*p[j];
+            ep.info[c*nall+j] += w*p[j];
+            ep.infoState[j] += w*p[j]*ep.resid[n];
+         }
+         ep.info[c*nall+c] += w;
+         ep.infoState[c] += w*ep.resid[n];
+      }
+   }
+
+   // -------------------------------------------------------------------------
+   int PRSolution::solveSubset(const CommonTime& T,
+                               const Matrix<double>& SVP,
+                               const Matrix<double>& invMC,
+                               const int *excluded,
+                               int nexcluded,
+                               TropModel *pTropModel,
+                               std::mutex *tropMutex,
+                               int niterLimit,
+                               double convLimit,
+                               SubsetWork& ws) const
+   {
+      const SubsetEpoch& ep(subsetEpoch);
+      const size_t nall(3+allowedGNSS.size()), ngood(ep.good.size());
+      size_t i,j,k,r,c;
+      int m;
+      GPSEllipsoid ellip;
+
+      // satellites used, and the systems they have
+      ws.use.clear();
+      ws.col.assign(allowedGNSS.size(),-1);
+      for(m=0,i=0; i<ngood; i++) {
+         if(m < nexcluded && excluded[m] == int(i)) { m++; continue; }
+         ws.use.push_back(i);
+         ws.col[ep.sys[i]] = 0;
+      }
+
+      // states are X,Y,Z and a clock for each system, as in allowedGNSS
+      ws.currGNSS.clear();
+      ws.full.resize(nall);
+      for(k=0; k<3; k++) ws.full[k] = k;
+      ws.dim = 3;
+      for(i=0; i<allowedGNSS.size(); i++) {
+         if(ws.col[i] == -1) continue;
+         ws.full[ws.dim] = 3+i;
+         ws.col[i] = ws.dim++;
+         ws.currGNSS.push_back(allowedGNSS[i]);
+      }
+      const size_t n(ws.use.size()), dim(ws.dim);
+
+      // require number of good satellites to be >= number unknowns
+      if(n < dim) return -3;
+
+      // weight matrix, and storage
+      if(ep.weighted) {
+         ws.W.resize(n*n);
+         for(r=0; r<n; r++)
+            for(c=0; c<n; c++)
+               ws.W[r*n+c] = invMC(ep.good[ws.use[r]],ep.good[ws.use[c]]);
+      }
+      ws.P.resize(n*dim);
+      ws.PW.resize(dim*n);
+      ws.info.resize(dim*dim);
+      ws.infoState.resize(dim);
+      ws.cov.resize(dim*dim);
+      ws.sol.resize(dim);
+      ws.apriori.resize(dim);
+      ws.dX.resize(dim);
+      ws.resid.resize(n);
+      ws.work.resize(2*nall*nall);
+      for(k=0; k<dim; k++) ws.sol[k] = ws.apriori[k] = ep.apriori[ws.full[k]];
+
+      // iterate at least twice so that trop model gets evaluated
+      int iret(0), niter(0), niter_limit(niterLimit < 2 ? 2 : niterLimit);
+      double converge(0.0);
+      GlobalTropModel *pGlobal(dynamic_cast<GlobalTropModel*>(pTropModel));
+
+      do {
+         ws.tropFlag = false;    // true means the trop corr was NOT applied
+         std::fill(ws.P.begin(), ws.P.end(), 0.0);
+
+         if(niter == 0) {
+            // partials and residuals are those computed for all the subsets
+            for(r=0; r<n; r++) {
+               i = ws.use[r];
+               for(k=0; k<3; k++) ws.P[r*dim+k] = ep.dirCos[3*i+k];
+               ws.P[r*dim+ws.col[ep.sys[i]]] = 1.0;
+               ws.resid[r] = ep.resid[i];
+            }
+         }
+         else {
+            // receiver position, and whether the trop correction can be applied
+            Position R;
+            R.setECEF(ws.sol[0],ws.sol[1],ws.sol[2]);
+            // must test R for reasonableness to avoid corrupting TropModel
+            double ht(R.getHeight());
+            // Global model sets the upper limit - first test it
+            bool bad((pGlobal && ht > pGlobal->getHeightLimit()) || ht < -1000.0);
+
+            for(r=0; r<n; r++) {
+               i = ep.good[ws.use[r]];
+               double svxyz[3];
+
+               // rho is time of flight (sec)
+               double rho = RSS(SVP(i,0)-ws.sol[0],
+                                SVP(i,1)-ws.sol[1], SVP(i,2)-ws.sol[2])/ellip.c();
+
+               // correct for earth rotation
+               double wt = ellip.angVelocity()*rho;       // radians
+               svxyz[0] =  ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1);
+               svxyz[1] = -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1);
+               svxyz[2] = SVP(i,2);
+
+               // rho is now geometric range
+               rho = RSS(svxyz[0]-ws.sol[0],
+                         svxyz[1]-ws.sol[1],
+                         svxyz[2]-ws.sol[2]);
+
+               // partials: direction cosines and clock
+               for(k=0; k<3; k++) ws.P[r*dim+k] = (ws.sol[k]-svxyz[k])/rho;
+               j = ws.col[ep.sys[ws.use[r]]];
+               ws.P[r*dim+j] = 1.0;
+
+               // corrected pseudorange (m) minus geometric range
+               double cRange(SVP(i,3) - rho);
+
+               // correct for troposphere
+               Position S;
+               S.setECEF(svxyz[0],svxyz[1],svxyz[2]);
+               double tc(0.0);
+               if(bad || R.elevation(S) < 0.0) {
+                  ws.tropFlag = true;     // true means failed to apply trop corr
+               }
+               else if(tropMutex) {
+                  std::lock_guard<std::mutex> lock(*tropMutex);
+                  tc = pTropModel->correction(R,S,T);   // pTropModel not const
+               }
+               else {
+                  tc = pTropModel->correction(R,S,T);
+               }
+               cRange -= tc;
+
+               // data vector: corrected range residual
+               ws.resid[r] = cRange - ws.sol[j];
+            }
+         }
+
+         // ------------------------------------------------------
+         // normal equations
+         if(niter == 0 && ep.diagonal) {
+            // those of all the satellites, less those of excluded satellites
+            double *info(&ws.work[0]), *infoState(&ws.work[nall*nall]);
+            std::copy(ep.info.begin(), ep.info.end(), info);
+            std::copy(ep.infoState.begin(), ep.infoState.end(), infoState);
+            for(m=0; m<nexcluded; m++) {
+               const int x(excluded[m]);
+               const double *p(&ep.dirCos[3*x]);
+               const size_t cx(3+ep.sys[x]);
+               const double w(ep.weight[x]);
+               for(j=0; j<3; j++) {
+                  for(k=0; k<3; k++)
+                     info[j*nall+k] -= w*p[j]*p[k];
+                  info[j*nall+cx] -= w*p[j];
+                  info[cx*nall+j] -= w*p[j];
+                  infoState[j] -= w*p[j]*ep.resid[x];
+               }
+               info[cx*nall+cx] -= w;
+               infoState[cx] -= w*ep.resid[x];
+            }
+            for(j=0; j<dim; j++) {
+               ws.infoState[j] = infoState[ws.full[j]];
+               for(k=0; k<dim; k++)
+                  ws.info[j*dim+k] = info[ws.full[j]*nall+ws.full[k]];
+            }
+         }
+         else {
+            // PW = P'*W
+            for(j=0; j<dim; j++) {
+               for(c=0; c<n; c++) {
+                  if(!ep.weighted)
+                     ws.PW[j*n+c] = ws.P[c*dim+j];
+                  else if(ep.diagonal)
+                     ws.PW[j*n+c] = ws.P[c*dim+j]*ws.W[c*n+c];
+                  else {
+                     double sum(0.0);
+                     for(r=0; r<n; r++) sum += ws.P[r*dim+j]*ws.W[r*n+c];
+                     ws.PW[j*n+c] = sum;
+                  }
+               }
+            }
+            // info = P'*W*P, infoState = P'*W*resid
+            for(j=0; j<dim; j++) {
+               double sum(0.0);
+               for(r=0; r<n; r++) sum += ws.PW[j*n+r]*ws.resid[r];
+               ws.infoState[j] = sum;
+               for(k=0; k<=j; k++) {
+                  sum = 0.0;
+                  for(r=0; r<n; r++) sum += ws.PW[j*n+r]*ws.P[r*dim+k];
+                  ws.info[j*dim+k] = ws.info[k*dim+j] = sum;
+               }
+            }
+         }
+
+         // covariance = inverse(info); only a (nearly) singular info needs SVD
+         if(!invertCholesky(&ws.info[0], &ws.cov[0], &ws.work[0], dim)) {
+            Matrix<double> Info(dim,dim);
+            for(j=0; j<dim; j++)
+               for(k=0; k<dim; k++) Info(j,k) = ws.info[j*dim+k];
+            try {
+               Matrix<double> Cov(inverseSVD(Info));
+               for(j=0; j<dim; j++)
+                  for(k=0; k<dim; k++) ws.cov[j*dim+k] = Cov(j,k);
+            }
+            catch(MatrixException& sme) { return -2; }
+         }
+
+         niter++;                         // increment number iterations
+
+         // ------------------------------------------------------
+         // compute solution
+         for(j=0; j<dim; j++) {
+            double sum(0.0);
+            for(k=0; k<dim; k++) sum += ws.cov[j*dim+k]*ws.infoState[k];
+            ws.dX[j] = sum;
+         }
+         for(j=0; j<dim; j++) ws.sol[j] += ws.dX[j];
+
+         // ------------------------------------------------------
+         // test for convergence
+         converge = scaledNorm(&ws.dX[0], dim);
+         if(niter > 1 && converge < convLimit) {             // success: quit
+            iret = 0;
+            break;
+         }
+         if(niter >= niter_limit || converge > 1.e10) {      // failure: quit
+            iret = -1;
+            break;
+         }
+
+      } while(1);    // end iteration loop
+
+      ws.niter = niter;
+      ws.converge = converge;
+      ws.rms = scaledNorm(&ws.resid[0], n)/SQRT(double(n));
+      ws.iret = iret;
+
+      return iret;
+
+   }  // end PRSolution::solveSubset
+
+   // -------------------------------------------------------------------------
+   void PRSolution::subsetSlopes(SubsetWork& ws) const
+   {
+      const size_t n(ws.use.size()), dim(ws.dim);
+      size_t j,k,r;
+
+      // compute slopes and find max member; slope(r) uses column r of the
+      // generalized inverse G = Cov*P'*W
+      ws.maxSlope = 0.0;
+      ws.slopes.assign(n,0.0);
+      // (PW is P'*W from the last iteration, which is never the first)
+      if(ws.iret == 0) {
+         double *g(&ws.work[0]);
+         for(r=0; r<n; r++) {
+            double PG(0.0);
+            for(j=0; j<dim; j++) {
+               double sum(0.0);
+               for(k=0; k<dim; k++) sum += ws.cov[j*dim+k]*ws.PW[k*n+r];
+               g[j] = sum;
+               PG += ws.P[r*dim+j]*sum;
+            }
+
+            // NB when one (few) sats have their own clock, PG(r,r) = 1 (nearly 1)
+            // and slope is inf (large); this ends the computation of slopes.
+            if(::fabs(1.0-PG) < 1.e-8) break;
+
+            for(j=0; j<dim; j++) ws.slopes[r] += g[j]*g[j];
+            ws.slopes[r] = SQRT(ws.slopes[r]*double(n-dim)/(1.0-PG));
+            if(ws.slopes[r] > ws.maxSlope) ws.maxSlope = ws.slopes[r];
+         }
+      }
+
+   }  // end PRSolution::subsetSlopes
+
+   // -------------------------------------------------------------------------
+   void PRSolution::saveSubset(const CommonTime& T,
+                               const vector<SatID>& Sats,
+                               const SubsetWork& ws,
+                               Vector<double>& Resids,
+                               Vector<double>& Slopes)
+   {
+      const size_t n(ws.use.size()), dim(ws.dim);
+      size_t i,j;
+
+      Solution.resize(dim);
+      Covariance.resize(dim,dim);
+      Partials.resize(n,dim);
+      Resids.resize(n);
+      Slopes.resize(n);
+      for(i=0; i<dim; i++) {
+         Solution(i) = ws.sol[i];
+         for(j=0; j<dim; j++) Covariance(i,j) = ws.cov[i*dim+j];
+      }
+      for(i=0; i<n; i++) {
+         Resids(i) = ws.resid[i];
+         Slopes(i) = ws.slopes[i];
+         for(j=0; j<dim; j++) Partials(i,j) = ws.P[i*dim+j];
+      }
+      if(subsetEpoch.weighted) {
+         invMeasCov.resize(n,n);
+         for(i=0; i<n; i++)
+            for(j=0; j<n; j++) invMeasCov(i,j) = ws.W[i*n+j];
+      }
+      else invMeasCov = Matrix<double>();
+
+      // compute pre-fit residuals
+      if(hasMemory) {
+         PreFitResidual.resize(n);
+         for(i=0; i<n; i++) {
+            double sum(0.0);
+            for(j=0; j<dim; j++) sum += ws.P[i*dim+j]*(ws.sol[j]-ws.apriori[j]);
+            PreFitResidual(i) = sum - ws.resid[i];
+         }
+      }
+
+      // save to member data
+      RMSResidual = ws.rms;
+      MaxSlope = ws.maxSlope;
+      TropFlag = ws.tropFlag;
+      currTime = T;
+      SatelliteIDs = Sats;
+      dataGNSS = ws.currGNSS;
+      Nsvs = n;
+      NIterations = ws.niter;
+      Convergence = ws.converge;
+      Valid = true;
+   }
+
+
    // -------------------------------------------------------------------------
    // Compute a RAIM solution with no measurement covariance matrix (no weighting)
    int PRSolution::RAIMComputeUnweighted(const CommonTime& Tr,
@@ -552,18 +1040,9 @@ namespace gnsstk
 
          LOG(DEBUG) << "RAIMCompute at time " << printTime(Tr,gpsfmt);
 
-         int iret,N;
-         size_t i,j;
-         vector<int> GoodIndexes;
-         // use these to save the 'best' solution within the loop.
-         // BestRMS marks the 'Best' set as unused.
-         bool BestTropFlag(false);
-         int BestNIter(0),BestIret(-5);
-         double BestRMS(-1.0),BestSL(0.0),BestConv(0.0);
-         Vector<double> BestSol(3,0.0),BestPFR;
-         vector<SatID> BestSats,SaveSats;
-         Matrix<double> SVP,BestCov,BestInvMCov,BestPartials;
-         vector<SatelliteSystem> BestGNSS;
+         int N;
+         size_t i;
+         Matrix<double> SVP;
 
          // initialize
          Valid = false;
@@ -596,16 +1075,60 @@ namespace gnsstk
          // return is >=0(number of good sats) or -4(no ephemeris)
          if(N <= 0) return -4;
 
+         return RAIMCompute(Tr, Sats, SVP, invMC, pTropModel);
+      }
+      catch(Exception& e) {
+         GNSSTK_RETHROW(e);
+      }
+   }  // end PRSolution::RAIMCompute()
+
+
+   // -------------------------------------------------------------------------
+   // Compute a solution using RAIM, given the output of PreparePRSolution().
+   int PRSolution::RAIMCompute(const CommonTime& Tr,
+                               vector<SatID>& Sats,
+                               const Matrix<double>& SVP,
+                               const Matrix<double>& invMC,
+                               TropModel *pTropModel)
+   {
+      if(!pTropModel) {
+         Exception e("Undefined tropospheric model");
+         GNSSTK_THROW(e);
+      }
+      if(Sats.size() != SVP.rows() ||
+         (invMC.rows() > 0 && invMC.rows() != Sats.size())) {
+         Exception e("Invalid dimensions");
+         GNSSTK_THROW(e);
+      }
+      if(allowedGNSS.size() == 0) {
+         Exception e("Must define systems vector allowedGNSS before processing");
+         GNSSTK_THROW(e);
+      }
+
+      try {
+         int iret(0);
+         size_t i,j,k;
+         // use these to find the 'best' solution within the loop.
+         // BestRMS marks the 'Best' set as unused.
+         int BestIret(-5);
+         double BestRMS(-1.0);
+         vector<int> BestExcluded;
+         size_t last(0);               // subset of the last solution tried
+         int lastStage(0);             // and its stage
+
+         // initialize
+         Valid = false;
+         currTime = Tr;
+         TropFlag = SlopeFlag = RMSFlag = false;
+
          // ----------------------------------------------------------------
-         // Build GoodIndexes based on Sats; save Sats as SaveSats.
-         // Sats is used to mark good sats (id > 0) and those to ignore (id <= 0).
-         // SaveSats saves the original so it can be reused for each RAIM solution.
-         // Let GoodIndexes be all the indexes of Sats that are good:
-         // Sats[GoodIndexes[.]].id > 0 by definition.
-         SaveSats = Sats;
-         for(i=0; i<Sats.size(); i++)
-            if(Sats[i].id > 0)
-               GoodIndexes.push_back(i);
+         // Find the good satellites, and compute what is common to all the
+         // solutions. Sats[subsetEpoch.good[.]].id > 0 by definition.
+         // SaveSats saves the original so it can be marked for the result.
+         prepareSubsets(Sats, SVP, invMC);
+         const vector<int>& GoodIndexes(subsetEpoch.good);
+         const int N(GoodIndexes.size());
+         const vector<SatID> SaveSats(Sats);
 
          // dump good satellites for debug
          if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
@@ -616,57 +1139,109 @@ namespace gnsstk
             LOG(DEBUG) << oss.str();
          }
 
+         unsigned nthreads(NThreads > 0 ? NThreads
+                                        : std::thread::hardware_concurrency());
+         if(nthreads == 0) nthreads = 1;
+         if(subsetWork.size() < nthreads) subsetWork.resize(nthreads);
+         if(subsetBest.size() < nthreads) subsetBest.resize(nthreads);
+         vector<int> threadBest(nthreads);
+         std::mutex tropMutex;
+         vector<int> nsys;
+
          // ----------------------------------------------------------------
          // now compute the solution, first with all the data. If this fails,
          // RAIM: reject 1 satellite at a time and try again, then 2, etc.
 
-         // Slopes for each satellite are computed (cf. the RAIM algorithm)
-         Vector<double> Slopes;
-         // Resids stores the post-fit data residuals.
-         Vector<double> Resids;
-
          // stage is the number of satellites to reject.
          int stage(0);
 
          do {
-            // compute all the combinations of N satellites taken stage at a time
+            // list all the combinations of N satellites taken stage at a time,
+            // up to the first with too few satellites for a solution, as
+            // that one ends the stage.
             Combinations Combo(N,stage);
-
-            // compute a solution for each combination of marked satellites
+            stageExcluded.clear();
+            size_t nsub(0);
             do {
-               // Mark the satellites for this combination
-               Sats = SaveSats;
-               for(i=0; i<GoodIndexes.size(); i++)
-                  if(Combo.isSelected(i))
-                     Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
-
-               if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
-                  ostringstream oss;
-                  oss << " RAIM: Try the combo ";
-                  for(i=0; i<Sats.size(); i++) {
-                     RinexSatID rs(::abs(Sats[i].id), Sats[i].system);
-                     oss << " " << (Sats[i].id < 0 ? "-" : " ") << rs;
+               nsys = subsetEpoch.nsys;
+               for(int m=0; m<stage; m++) {
+                  stageExcluded.push_back(Combo.Selection(m));
+                  nsys[subsetEpoch.sys[Combo.Selection(m)]]--;
+               }
+               nsub++;
+               int dim(3);
+               for(i=0; i<nsys.size(); i++)
+                  if(nsys[i] > 0) dim++;
+               if(N-stage < dim) break;
+            } while(Combo.Next() != -1);
+
+            // ----------------------------------------------------------------
+            // Compute a solution for each subset, ignoring the excluded
+            // satellites, in nthreads contiguous chunks. Each thread keeps
+            // the workspace of its best subset (lowest RMS, the first of
+            // equals), which is the best of the stage if in its chunk.
+            // Return 0  ok
+            //       -1  failed to converge
+            //       -2  singular problem
+            //       -3  not enough good data
+            stageIret.resize(nsub);
+            stageRMS.resize(nsub);
+            const unsigned nth(nsub < nthreads ? nsub : nthreads);
+            auto worker = [&](unsigned t, size_t first, size_t end)
+            {
+               threadBest[t] = -1;
+               for(size_t s=first; s<end; s++) {
+                  stageIret[s] = solveSubset(Tr, SVP, invMC,
+                                             stageExcluded.data()+s*stage, stage,
+                                             pTropModel,
+                                             (nth > 1 ? &tropMutex : 0),
+                                             MaxNIterations, ConvergenceLimit,
+                                             subsetWork[t]);
+                  stageRMS[s] = subsetWork[t].rms;
+                  if(stageIret[s] == 0 &&
+                     (threadBest[t] == -1 || stageRMS[s] < subsetBest[t].rms)) {
+                     std::swap(subsetWork[t], subsetBest[t]);
+                     threadBest[t] = s;
                   }
-                  LOG(DEBUG) << oss.str();
                }
+            };
+            if(nth <= 1) {
+               worker(0, 0, nsub);
+            }
+            else {
+               vector<std::thread> threads;
+               vector<std::exception_ptr> errors(nth);
+               const size_t chunk((nsub + nth - 1) / nth);
+               for(unsigned t=0; t<nth; t++) {
+                  const size_t first(t*chunk), end(std::min(first+chunk, nsub));
+                  threads.emplace_back(
+                     [&worker, &errors, t, first, end]()
+                     {
+                        try {
+                           worker(t, first, end);
+                        }
+                        catch(...) {
+                           errors[t] = std::current_exception();
+                        }
+                     });
+               }
+               for(auto& thr : threads)
+                  thr.join();
+               for(unsigned t=0; t<nth; t++)
+                  if(errors[t]) std::rethrow_exception(errors[t]);
+            }
 
-               // ----------------------------------------------------------------
-               // Compute a solution given the data; ignore ranges for marked
-               // satellites. Fill Vector 'Slopes' with slopes for each unmarked
-               // satellite.
-               // Return 0  ok
-               //       -1  failed to converge
-               //       -2  singular problem
-               //       -3  not enough good data
-               //       -4  no ephemeris
-               iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
-                       MaxNIterations, ConvergenceLimit, Resids, Slopes);
-
+            // ----------------------------------------------------------------
+            // deal with the results, in order, as though computed one by one
+            lastStage = stage;
+            int stageBest(-1);
+            for(k=0; k<nsub; k++) {
+               last = k;
+               iret = stageIret[k];
                LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
                if(iret <= 0 && iret > BestIret) BestIret = iret;
 
-               // ----------------------------------------------------------------
-               // if error, either quit or continue with next combo (SPS sets Valid F)
+               // if error, either quit or continue with next combo
                if(iret < 0) {
                   if(iret == -1) {
                      LOG(DEBUG) << " SPS: Failed to converge - go on";
@@ -680,43 +1255,30 @@ namespace gnsstk
                      LOG(DEBUG) <<" SPS: not enough satellites: quit";
                      break;
                   }
-                  else if(iret == -4) {
-                     LOG(DEBUG) <<" SPS: no ephemeris: quit";
-                     break;
-                  }
                }
 
-               // ----------------------------------------------------------------
-               // print solution with diagnostic information
-               LOG(DEBUG) << outputString(string("RPS"),iret);
-
-               // do again for residuals
-               // if memory exists, output residuals
-               //if(hasMemory) LOG(DEBUG) << outputString(string("RAP"), -99,
-                     //(Solution-memory.APSolution));
-
-               // deal with the results of SimplePRSolution()
                // save 'best' solution for later
-               if(BestRMS < 0.0 || RMSResidual < BestRMS) {
-                  BestRMS = RMSResidual;
-                  BestSol = Solution;
-                  BestSats = SatelliteIDs;
-                  BestGNSS = dataGNSS;
-                  BestSL = MaxSlope;
-                  BestConv = Convergence;
-                  BestNIter = NIterations;
-                  BestCov = Covariance;
-                  BestInvMCov = invMeasCov;
-                  BestPartials = Partials;
-                  BestPFR = PreFitResidual;
-                  BestTropFlag = TropFlag;
+               if(BestRMS < 0.0 || stageRMS[k] < BestRMS) {
+                  BestRMS = stageRMS[k];
+                  BestExcluded.assign(stageExcluded.begin()+k*stage,
+                                      stageExcluded.begin()+(k+1)*stage);
                   BestIret = iret;
+                  stageBest = k;
                }
 
-               if(stage==0 && RMSResidual < RMSLimit)
+               if(stage==0 && stageRMS[k] < RMSLimit)
                   break;
+            }
 
-            } while(Combo.Next() != -1);  // get the next combinations and repeat
+            // keep the workspace of a new best subset
+            if(stageBest != -1) {
+               for(i=0; i<nth; i++) {
+                  if(threadBest[i] == stageBest) {
+                     std::swap(subsetBest[i], bestWork);
+                     break;
+                  }
+               }
+            }
 
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
@@ -736,9 +1298,9 @@ namespace gnsstk
             }
 
             // already broke out of the combo loop...
-            if(iret == -3 || iret == -4) {
+            if(iret == -3) {
                LOG(DEBUG) << " RAIM: break before stage " << stage
-                  << "; " << (iret==-3 ? "too few sats" : "no ephemeris");
+                  << "; too few sats";
                break;
             }
 
@@ -747,70 +1309,36 @@ namespace gnsstk
          } while(1);    // end loop over stages
 
          // ----------------------------------------------------------------
-         // copy out the best solution
+         // mark the excluded satellites: those of the best solution, or, on
+         // failure, those of the last solution tried
+         Sats = SaveSats;
+         if(iret < 0) {
+            for(j=0; j<size_t(lastStage); j++)
+               Sats[GoodIndexes[stageExcluded[last*lastStage+j]]].id =
+                  -::abs(Sats[GoodIndexes[stageExcluded[last*lastStage+j]]].id);
+         }
+         else {
+            for(j=0; j<BestExcluded.size(); j++)
+               Sats[GoodIndexes[BestExcluded[j]]].id =
+                  -::abs(Sats[GoodIndexes[BestExcluded[j]]].id);
+         }
+
+         // ----------------------------------------------------------------
+         // finish the best solution, and copy it out
          if(iret >= 0) {
-            Sats = SatelliteIDs = BestSats;
-            dataGNSS = BestGNSS;
-            Solution = BestSol;
-            Covariance = BestCov;
-            invMeasCov = BestInvMCov;
-            Partials = BestPartials;
-            PreFitResidual = BestPFR;
-            Convergence = BestConv;
-            NIterations = BestNIter;
-            RMSResidual = BestRMS;
-            MaxSlope = BestSL;
-            TropFlag = BestTropFlag;
+            Vector<double> Resids, Slopes;
+            subsetSlopes(bestWork);
+            saveSubset(Tr, Sats, bestWork, Resids, Slopes);
             iret = BestIret;
 
-            // must add zeros to state, covariance and partials if these don't match
-            if(dataGNSS.size() != BestGNSS.size()) {
-               N = 3+dataGNSS.size();
-               Solution = Vector<double>(N,0.0);
-               Covariance = Matrix<double>(N,N,0.0);
-               Partials = Matrix<double>(BestPartials.rows(),N,0.0);
-
-               // build a little map of indexes; note systems are sorted alike
-               vector<int> indexes;
-               for(j=0,i=0; i<dataGNSS.size(); i++) {
-                  indexes.push_back(dataGNSS[i] == BestGNSS[j] ? j++ : -1);
-               }
-
-               // copy over position and position,clk parts
-               for(i=0; i<3; i++) {
-                  Solution(i) = BestSol(i);
-                  for(j=0; j<Partials.rows(); j++) Partials(j,i) = BestPartials(j,i);
-                  for(j=0; j<3; j++) Covariance(i,j) = BestCov(i,j);
-                  for(j=0; j<indexes.size(); j++) {
-                     Covariance(i,3+j)=(indexes[j]==-1 ? 0.:BestCov(i,3+indexes[j]));
-                     Covariance(3+j,i)=(indexes[j]==-1 ? 0.:BestCov(3+indexes[j],i));
-                  }
-               }
-
-               // copy the clock part, inserting zeros where needed
-               for(j=0; j<indexes.size(); j++) {
-                  int n(indexes[j]);
-                  bool ok(n != -1);
-                  Solution(3+j) = (ok ? BestSol(3+n) : 0.0);
-                  for(i=0; i<Partials.rows(); i++)
-                     Partials(i,3+j) = (ok ? BestPartials(i,3+n) : 0.0);
-                  for(i=0; i<indexes.size(); i++) {
-                     Covariance(3+i,3+j) = (ok ? BestCov(3+i,3+n) : 0.0);
-                     Covariance(3+j,3+i) = (ok ? BestCov(3+n,3+i) : 0.0);
-                  }
-               }
-            }
-
-            // compute number of satellites actually used
-            for(Nsvs=0,i=0; i<SatelliteIDs.size(); i++)
-               if(SatelliteIDs[i].id > 0)
-                  Nsvs++;
+            LOG(DEBUG) << outputString(string("RPS"),iret);
 
             if(iret==0)
                DOPCompute();           // compute DOPs
             if(hasMemory && iret==0) {
                // update memory solution
-               addToMemory(Solution,Covariance,PreFitResidual,Partials,invMeasCov);
+               addToMemory(Solution,Covariance,PreFitResidual,Partials,
+                           invMeasCov);
                // update apriori solution
                updateAPSolution(Solution);
             }
@@ -819,13 +1347,13 @@ namespace gnsstk
 
          // ----------------------------------------------------------------
          if(iret==0) {
-            if(BestSL > SlopeLimit) { iret = 1; SlopeFlag = true; }
-            if(BestSL > SlopeLimit/2.0 && Nsvs == 5) { iret = 1; SlopeFlag = true; }
+            if(MaxSlope > SlopeLimit) { iret = 1; SlopeFlag = true; }
+            if(MaxSlope > SlopeLimit/2.0 && Nsvs == 5) { iret = 1; SlopeFlag = true; }
             if(BestRMS >= RMSLimit) { iret = 1; RMSFlag = true; }
             if(TropFlag) iret = 1;
             Valid = true;
          }
-         else if(iret == -1) Valid = false;
+         else Valid = false;
 
          LOG(DEBUG) << " RAIM exit with ret value " << iret
                      << " and Valid " << (Valid ? "T":"F");
@@ -838,6 +1366,172 @@ namespace gnsstk
    }  // end PRSolution::RAIMCompute()
 
 
+   // -------------------------------------------------------------------------
+   // Compute RAIM solutions for a series of epochs, using a pool of threads.
+   int PRSolution::RAIMComputeEpochs(vector<PRSolutionEpoch>& Epochs,
+                                     NavLibrary& eph,
+                                     const vector<TropModel*>& pTropModels,
+                                     unsigned BlockSize,
+                                     NavSearchOrder order)
+   {
+      if(pTropModels.size() == 0) {
+         Exception e("Undefined tropospheric model");
+         GNSSTK_THROW(e);
+      }
+
+      try {
+         const size_t nep(Epochs.size());
+         if(nep == 0) return 0;
+         const size_t nthreads(pTropModels.size());
+         const size_t blk(BlockSize > 0 ? BlockSize
+                                        : (nep + nthreads - 1) / nthreads);
+         const size_t nblk((nep + blk - 1) / blk);
+         const unsigned nth(nblk < nthreads ? nblk : nthreads);
+
+         // run worker(t,i) for every epoch i, in blocks of blk epochs taken
+         // in turn by nth threads
+         auto forEachEpoch = [&](std::function<void(unsigned,size_t)> worker)
+         {
+            std::atomic<size_t> nextBlock(0);
+            auto blocks = [&](unsigned t)
+            {
+               for(size_t b=nextBlock++; b<nblk; b=nextBlock++)
+                  for(size_t i=b*blk; i<nep && i<(b+1)*blk; i++)
+                     worker(t, i);
+            };
+            if(nth <= 1) {
+               blocks(0);
+               return;
+            }
+            vector<std::thread> threads;
+            vector<std::exception_ptr> errors(nth);
+            for(unsigned t=0; t<nth; t++) {
+               threads.emplace_back(
+                  [&blocks, &errors, t]()
+                  {
+                     try {
+                        blocks(t);
+                     }
+                     catch(...) {
+                        errors[t] = std::current_exception();
+                     }
+                  });
+            }
+            for(auto& thr : threads)
+               thr.join();
+            for(unsigned t=0; t<nth; t++)
+               if(errors[t]) std::rethrow_exception(errors[t]);
+         };
+
+         int nsols(0);
+         if(!hasMemory) {
+            // ----------------------------------------------------------------
+            // The epochs are independent: each block is computed by a copy
+            // of this object, exactly as RAIMCompute() would.
+            vector<PRSolution> prs(nth, *this);
+            for(unsigned t=0; t<nth; t++)
+               prs[t].NThreads = 1;
+            forEachEpoch([&](unsigned t, size_t i)
+            {
+               PRSolutionEpoch& ep(Epochs[i]);
+               ep.iret = prs[t].RAIMCompute(ep.time, ep.Satellites,
+                                            ep.Pseudorange, ep.invMC, eph,
+                                            pTropModels[t], order);
+               prs[t].saveEpoch(ep);
+            });
+            for(size_t i=0; i<nep; i++)
+               if(Epochs[i].iret >= 0) nsols++;
+            loadEpoch(Epochs[nep-1]);
+            return nsols;
+         }
+
+         // ----------------------------------------------------------------
+         // Each epoch starts from the solution of the previous one, so only
+         // the satellite positions, which do not depend on it, are computed
+         // in parallel; then RAIMCompute() is called for each epoch in
+         // turn, its subsets computed by NThreads threads.
+         vector<Matrix<double> > SVP(nep);
+         vector<int> ngood(nep);
+         forEachEpoch([&](unsigned, size_t i)
+         {
+            PRSolutionEpoch& ep(Epochs[i]);
+            ngood[i] = PreparePRSolution(ep.time, ep.Satellites,
+                                         ep.Pseudorange, eph, SVP[i], order);
+         });
+         for(size_t i=0; i<nep; i++) {
+            PRSolutionEpoch& ep(Epochs[i]);
+            // as RAIMCompute(Tr,Sats,Pseudorange,...)
+            if(ngood[i] <= 0) {
+               Valid = false;
+               currTime = ep.time;
+               TropFlag = SlopeFlag = RMSFlag = false;
+               ep.iret = -4;
+            }
+            else
+               ep.iret = RAIMCompute(ep.time, ep.Satellites, SVP[i], ep.invMC,
+                                     pTropModels[0]);
+            saveEpoch(ep);
+            if(ep.iret >= 0) nsols++;
+         }
+
+         return nsols;
+      }
+      catch(Exception& e) {
+         GNSSTK_RETHROW(e);
+      }
+   }  // end PRSolution::RAIMComputeEpochs()
+
+
+   // -------------------------------------------------------------------------
+   void PRSolution::saveEpoch(PRSolutionEpoch& ep) const
+   {
+      ep.Valid = Valid;
+      ep.Solution = Solution;
+      ep.Covariance = Covariance;
+      ep.invMeasCov = invMeasCov;
+      ep.Partials = Partials;
+      ep.PreFitResidual = PreFitResidual;
+      ep.dataGNSS = dataGNSS;
+      ep.RMSResidual = RMSResidual;
+      ep.MaxSlope = MaxSlope;
+      ep.TDOP = TDOP;
+      ep.PDOP = PDOP;
+      ep.GDOP = GDOP;
+      ep.NIterations = NIterations;
+      ep.Convergence = Convergence;
+      ep.Nsvs = Nsvs;
+      ep.TropFlag = TropFlag;
+      ep.RMSFlag = RMSFlag;
+      ep.SlopeFlag = SlopeFlag;
+   }
+
+
+   // -------------------------------------------------------------------------
+   void PRSolution::loadEpoch(const PRSolutionEpoch& ep)
+   {
+      currTime = ep.time;
+      SatelliteIDs = ep.Satellites;
+      Valid = ep.Valid;
+      Solution = ep.Solution;
+      Covariance = ep.Covariance;
+      invMeasCov = ep.invMeasCov;
+      Partials = ep.Partials;
+      PreFitResidual = ep.PreFitResidual;
+      dataGNSS = ep.dataGNSS;
+      RMSResidual = ep.RMSResidual;
+      MaxSlope = ep.MaxSlope;
+      TDOP = ep.TDOP;
+      PDOP = ep.PDOP;
+      GDOP = ep.GDOP;
+      NIterations = ep.NIterations;
+      Convergence = ep.Convergence;
+      Nsvs = ep.Nsvs;
+      TropFlag = ep.TropFlag;
+      RMSFlag = ep.RMSFlag;
+      SlopeFlag = ep.SlopeFlag;
+   }
+
+
    // -------------------------------------------------------------------------
    int PRSolution::DOPCompute(void)
    {
@@ -44,6 +44,7 @@
 #define PRS_POSITION_SOLUTION_HPP
 
 #include <vector>
+#include <mutex>
 #include <ostream>
 #include "gnsstk_export.h"
 #include "stl_helpers.hpp"
@@ -186,6 +187,56 @@ namespace gnsstk
 
    }; // end class WtdAveStats
 
+   /// Class PRSolutionEpoch holds the pseudorange data of one epoch, to be
+   /// processed by PRSolution::RAIMComputeEpochs(), and the results. The output
+   /// members have the same meaning as those of PRSolution after a call to
+   /// RAIMCompute().
+   class PRSolutionEpoch
+   {
+   public:
+      /// Constructor
+      PRSolutionEpoch() : iret(-99), Valid(false), RMSResidual(0.0),
+                          MaxSlope(0.0), TDOP(0.0), PDOP(0.0), GDOP(0.0),
+                          NIterations(0), Convergence(0.0), Nsvs(0),
+                          TropFlag(false), RMSFlag(false), SlopeFlag(false)
+         {}
+
+      // input: -------------------------------------------------
+
+      /// Measured time of reception of the data.
+      CommonTime time;
+
+      /// Satellites, as for RAIMCompute(); on output, satellites excluded by the
+      /// algorithm are marked by a negative 'id' member.
+      std::vector<SatID> Satellites;
+
+      /// Raw pseudoranges (m), parallel to Satellites.
+      std::vector<double> Pseudorange;
+
+      /// Measurement covariance matrix inverse (m^-2), or empty for no weighting.
+      Matrix<double> invMC;
+
+      // output: -------------------------------------------------
+
+      /// Return value of RAIMCompute() for this epoch.
+      int iret;
+      bool Valid;
+      Vector<double> Solution;
+      Matrix<double> Covariance;
+      Matrix<double> invMeasCov;
+      Matrix<double> Partials;
+      Vector<double> PreFitResidual;
+      std::vector<SatelliteSystem> dataGNSS;
+      double RMSResidual;
+      double MaxSlope;
+      double TDOP,PDOP,GDOP;
+      int NIterations;
+      double Convergence;
+      int Nsvs;
+      bool TropFlag, RMSFlag, SlopeFlag;
+
+   }; // end class PRSolutionEpoch
+
    /// This class defines an interface to routines which compute a position
    /// and time solution from pseudorange data, with a data editing algorithm
    /// based on Receiver Autonomous Integrity Monitoring (RAIM) concepts.
@@ -222,6 +273,7 @@ namespace gnsstk
                       NSatsReject(-1),
                       MaxNIterations(10),
                       ConvergenceLimit(3.e-7),
+                      NThreads(1),
                       hasMemory(true),
                       fixedAPriori(false),
                       nsol(0), ndata(0), APV(0.0),
@@ -256,6 +308,12 @@ namespace gnsstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /// Number of threads used by RAIMCompute() to compute the solutions for the
+      /// satellite subsets of each RAIM stage; 0 means one per hardware thread.
+      /// The result does not depend on this. The TropModel is shared by the
+      /// threads, and is called by only one at a time.
+      unsigned NThreads;
+
       /// vector<SatelliteSystem> containing the satellite systems allowed
       /// in the solution. **This vector MUST be defined before computing solutions.**
       /// It is used to determine which clock biases are included in the solution,
@@ -479,6 +537,58 @@ namespace gnsstk
                       TropModel *pTropModel,
                       NavSearchOrder order = NavSearchOrder::User);
 
+      /// Compute a RAIM solution, as RAIMCompute() above, but given the output
+      /// of PreparePRSolution() rather than pseudoranges and ephemeris.
+      /// @param Tr          Measured time of reception of the data.
+      /// @param Satellites  std::vector<SatID> of satellites, as returned by
+      ///                    PreparePRSolution(); on successful return, satellites
+      ///                    that were excluded by the algorithm are marked by a
+      ///                    negative 'id' member.
+      /// @param SVP         Matrix<double> of dimension (N,4) returned by
+      ///                    PreparePRSolution().
+      /// @param invMC       gnsstk::Matrix<double> NXN measurement covariance matrix
+      ///                    inverse (meter^-2), or empty for no weighting.
+      /// @param pTropModel  pointer to gnsstk::TropModel for trop correction.
+      /// @return as RAIMCompute() above, except -4 is not returned.
+      int RAIMCompute(const CommonTime& Tr,
+                      std::vector<SatID>& Satellites,
+                      const Matrix<double>& SVP,
+                      const Matrix<double>& invMC,
+                      TropModel *pTropModel);
+
+      /// Compute RAIM solutions, as RAIMCompute() does, for a series of epochs
+      /// in time order, using a pool of threads. The results, in Epochs, the
+      /// member data on return (the results of the last epoch) and the
+      /// memory (APSolution, APV and the statistics) are identical to those
+      /// of calling RAIMCompute() for each epoch in turn, for any number of
+      /// threads and any BlockSize.
+      ///
+      /// When hasMemory is false the epochs are independent, and they are
+      /// computed in parallel, in blocks of BlockSize epochs, each thread
+      /// using its own copy of this object with NThreads = 1. Otherwise each
+      /// epoch starts from the solution of the previous one; then only the
+      /// satellite positions (PreparePRSolution()) are computed in parallel,
+      /// and the RAIM solutions are computed in turn by this object, using
+      /// NThreads threads for the satellite subsets of each epoch.
+      ///
+      /// NavLibrary eph is searched from several threads at once, and so
+      /// should have been frozen (see NavLibrary::freeze()).
+      /// @param Epochs      the data, in time order, and on output the results.
+      /// @param eph         NavLibrary to be used in the algorithm.
+      /// @param pTropModels one gnsstk::TropModel per thread (TropModel is not
+      ///                    thread-safe); the size of this vector is the number
+      ///                    of threads used. With memory only the first is used.
+      /// @param BlockSize   number of epochs given to a thread at a time; 0
+      ///                    means the epochs are divided evenly among the
+      ///                    threads.
+      /// @param order       How NavLibrary searches are performed.
+      /// @return the number of epochs with a solution (iret >= 0).
+      int RAIMComputeEpochs(std::vector<PRSolutionEpoch>& Epochs,
+                            NavLibrary& eph,
+                            const std::vector<TropModel*>& pTropModels,
+                            unsigned BlockSize = 0,
+                            NavSearchOrder order = NavSearchOrder::User);
+
       /// Compute DOPs using the partials matrix from the last successful solution.
       /// RAIMCompute(), if successful, calls this before returning.
       /// Results stored in PRSolution::TDOP,PDOP,GDOP.
@@ -648,6 +758,115 @@ namespace gnsstk
       /// empty vector used to detect default
       GNSSTK_EXPORT static const Vector<double> PRSNullVector;
 
+      /// Data shared by all the subsets of satellites tried at one epoch,
+      /// computed once by prepareSubsets(). The first iteration of every
+      /// subset starts from the same apriori solution, so its partials and
+      /// residuals are the same for all subsets, and its normal equations are
+      /// those of all the satellites less the excluded ones.
+      struct SubsetEpoch
+      {
+         std::vector<int> good;       ///< index in Sats of each good satellite
+         std::vector<int> sys;        ///< index in allowedGNSS of each good sat
+         std::vector<int> nsys;       ///< number of good sats in each system
+         std::vector<double> apriori; ///< apriori state, 3+allowedGNSS.size()
+         std::vector<double> dirCos;  ///< first iteration direction cosines
+         std::vector<double> cRange;  ///< first iteration corrected range - rho
+         std::vector<double> resid;   ///< first iteration residual
+         bool weighted;               ///< true if invMC is not empty
+         bool diagonal;               ///< true if invMC is diagonal (or empty)
+         std::vector<double> weight;  ///< diagonal of invMC, if diagonal
+         std::vector<double> info;    ///< first iteration information, all sats
+         std::vector<double> infoState; ///< first iteration partials'*W*resid
+      };
+
+      /// Workspace for solving one subset of satellites. Storage is reused, so
+      /// that solving a subset does not allocate after the first few.
+      struct SubsetWork
+      {
+         std::vector<int> use;        ///< index in good of each satellite used
+         std::vector<int> col;        ///< column of the clock of each system
+         std::vector<int> full;       ///< index in apriori of each state
+         std::vector<SatelliteSystem> currGNSS; ///< systems in the subset
+         size_t dim;                  ///< dimension of the solution
+         std::vector<double> W;       ///< weight matrix, n x n
+         std::vector<double> P;       ///< partials matrix, n x dim
+         std::vector<double> PW;      ///< P'*W, dim x n
+         std::vector<double> info;    ///< information matrix, dim x dim
+         std::vector<double> infoState; ///< P'*W*resid, dim
+         std::vector<double> cov;     ///< covariance, dim x dim
+         std::vector<double> sol;     ///< solution, dim
+         std::vector<double> apriori; ///< apriori solution, dim
+         std::vector<double> dX;      ///< solution update, dim
+         std::vector<double> resid;   ///< residuals, n
+         std::vector<double> slopes;  ///< RAIM slopes, n
+         std::vector<double> work;    ///< scratch, 3+allowedGNSS.size() squared
+         double rms;                  ///< RMS residual
+         double maxSlope;             ///< largest slope
+         double converge;             ///< final RSS change in solution
+         int niter;                   ///< number of iterations
+         int iret;                    ///< return value of solveSubset()
+         bool tropFlag;               ///< trop correction was not applied
+      };
+
+      /// Epoch data used by solveSubset()
+      SubsetEpoch subsetEpoch;
+
+      /// Workspaces used by RAIMCompute(), one per thread
+      std::vector<SubsetWork> subsetWork;
+
+      /// The best subset solved by each thread in a RAIM stage, and the best
+      /// subset so far; these are swapped with subsetWork rather than copied.
+      std::vector<SubsetWork> subsetBest;
+      SubsetWork bestWork;
+
+      /// Satellites excluded, and the results, for each subset in a RAIM stage
+      std::vector<int> stageExcluded;
+      std::vector<int> stageIret;
+      std::vector<double> stageRMS;
+
+      /// Fill subsetEpoch for the good satellites in Sats, which are those with
+      /// positive id and system in allowedGNSS.
+      void prepareSubsets(const std::vector<SatID>& Sats,
+                          const Matrix<double>& SVP,
+                          const Matrix<double>& invMC);
+
+      /// Compute the solution using all the good satellites except those given,
+      /// as SimplePRSolution() does, leaving the results in ws, except for the
+      /// slopes (see subsetSlopes()). This changes no member data, so it may
+      /// be called by several threads at once, each with its own workspace.
+      /// @param excluded  indexes in subsetEpoch.good of satellites to exclude,
+      ///                  in increasing order.
+      /// @param nexcluded number of satellites excluded.
+      /// @param tropMutex if not null, lock this while calling pTropModel.
+      /// @return as SimplePRSolution()
+      int solveSubset(const CommonTime& T,
+                      const Matrix<double>& SVP,
+                      const Matrix<double>& invMC,
+                      const int *excluded,
+                      int nexcluded,
+                      TropModel *pTropModel,
+                      std::mutex *tropMutex,
+                      int niterLimit,
+                      double convLimit,
+                      SubsetWork& ws) const;
+
+      /// Compute the RAIM slopes, and the largest, of a subset solved by
+      /// solveSubset(); they are needed only for the subset chosen.
+      void subsetSlopes(SubsetWork& ws) const;
+
+      /// Copy the results of RAIMCompute() to an epoch
+      void saveEpoch(PRSolutionEpoch& ep) const;
+
+      /// Copy the results of an epoch to the member data
+      void loadEpoch(const PRSolutionEpoch& ep);
+
+      /// Copy a full result of solveSubset() to the member data.
+      void saveSubset(const CommonTime& T,
+                      const std::vector<SatID>& Sats,
+                      const SubsetWork& ws,
+                      Vector<double>& Resids,
+                      Vector<double>& Slopes);
+
    }; // end class PRSolution
 
    //@}
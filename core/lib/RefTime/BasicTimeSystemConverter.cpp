@@ -37,7 +37,7 @@
 //==============================================================================
 
 #include "BasicTimeSystemConverter.hpp"
-#include "CivilTime.hpp"
+#include "TimeConstants.hpp"
 
 namespace gnsstk
 {
@@ -59,11 +59,15 @@ namespace gnsstk
          offs = toffs;
          return true;
       }
-      CivilTime civ(t);
+         // The offset is computed for the start of the day, as it
+         // was when this went through CivilTime and passed an integer
+         // day of month to getTimeSystemCorrection.
+      long jday, msod;
+      double fsod;
+      t.getInternal(jday, msod, fsod);
       try
       {
-         offs = getTimeSystemCorrection(fromSys, toSys, civ.year, civ.month,
-                                        civ.day);
+         offs = getTimeSystemCorrectionMJD(fromSys, toSys, jday - MJD_JDAY);
       }
       catch (gnsstk::Exception& exc)
       {
@@ -74,6 +78,43 @@ namespace gnsstk
    }
 
 
+   bool BasicTimeSystemConverter ::
+   changeTimeSystem(std::vector<CommonTime>& times, TimeSystem toSys)
+   {
+         // The offset depends only on the source time system and the
+         // day, so it is only looked up when either changes.
+      bool rv = true, valid = false, looked = false;
+      TimeSystem lastSys = TimeSystem::Unknown;
+      long lastDay = 0;
+      double offs = 0.;
+      for (unsigned i = 0; i < times.size(); i++)
+      {
+         CommonTime& t(times[i]);
+         long jday, msod;
+         double fsod;
+         TimeSystem sys;
+         t.getInternal(jday, msod, fsod, sys);
+         if (!looked || (sys != lastSys) || (jday != lastDay))
+         {
+            valid = getOffset(sys, toSys, t, offs);
+            looked = true;
+            lastSys = sys;
+            lastDay = jday;
+         }
+         if (valid)
+         {
+            t -= offs;
+            t.setTimeSystem(toSys);
+         }
+         else
+         {
+            rv = false;
+         }
+      }
+      return rv;
+   }
+
+
    bool BasicTimeSystemConverter ::
    explore(TimeSystem fromSys, TimeSystem toSys,
            const CommonTime& fromTime, const CommonTime& toTime)
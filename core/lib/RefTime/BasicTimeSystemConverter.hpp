@@ -61,6 +61,18 @@ namespace gnsstk
       bool getOffset(TimeSystem fromSys, TimeSystem toSys,
                      const CommonTime& t, double& offs) override;
 
+         /** Convert each of a set of times to another time system.
+          * The offset only changes from one day to the next, so it
+          * is computed once for each run of times that share a day
+          * and source time system, which makes converting a sorted
+          * epoch array a subtraction per time.
+          * @param[in,out] times The times to convert.  Any that can
+          *   not be converted are left unchanged.
+          * @param[in] toSys The time system to convert to.
+          * @return true if every time was converted. */
+      bool changeTimeSystem(std::vector<CommonTime>& times,
+                            TimeSystem toSys) override;
+
          /** Attempt to "prime" internal data over a desired time
           * range so that when doing a large number of conversions
           * over a time range, if the offset is the same across that
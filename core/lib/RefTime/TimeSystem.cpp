@@ -37,9 +37,11 @@
 //==============================================================================
 
 #include <cmath>
+#include <vector>
 #include "TimeSystem.hpp"
 #include "TimeConverters.hpp"
 #include "Exception.hpp"
+#include "TimeConstants.hpp"
 
 using namespace std;
 
@@ -50,18 +52,16 @@ namespace gnsstk
       return os << StringUtils::asString(ts);
    }
 
-   double getLeapSeconds(const int year,
-                         const int month,
-                         const double day)
+   namespace
    {
          // Leap second data
          // number of changes before leap seconds (1960-1971) - this
          // should never change.
-      static const int NPRE=14;
+      const int NPRE=14;
 
          // epoch year, epoch month(1-12), delta t(sec), rate
          // (sec/day) for [1960,1972).
-      static const struct {
+      const struct {
          int year, month;
          double delt, rate;
       } preleap[NPRE] = {
@@ -83,7 +83,7 @@ namespace gnsstk
 
          // Leap seconds history
          // ***** This table must be updated for new leap seconds **************
-      static const struct {
+      const struct {
          int year, month, nleap;
       } leaps[] = {
          { 1972,  1, 10 },
@@ -119,13 +119,223 @@ namespace gnsstk
       };
 
          // the number of leaps (do not change this)
-      static const int NLEAPS = sizeof(leaps)/sizeof(leaps[0]);
-
-         // last year in leaps
-         //static const int MAXYEAR = leaps[NLEAPS-1].year;
+      const int NLEAPS = sizeof(leaps)/sizeof(leaps[0]);
 
          // END static data
 
+         /** TAI-UTC over the whole of preleap and leaps, indexed by
+          * MJD day so no calendar conversion or search is needed.
+          * Each entry of the tables above becomes a segment starting
+          * on the first of its month, and every day from the start of
+          * preleap to the start of the last leap records which
+          * segment it falls in. */
+      class LeapTable
+      {
+      public:
+         LeapTable()
+         {
+            for (int i = 0; i < NPRE; i++)
+            {
+               Segment seg = { monthStart(preleap[i].year,preleap[i].month),
+                               preleap[i].delt, preleap[i].rate };
+               segments.push_back(seg);
+            }
+            for (int i = 0; i < NLEAPS; i++)
+            {
+               Segment seg = { monthStart(leaps[i].year,leaps[i].month),
+                               double(leaps[i].nleap), 0.0 };
+               segments.push_back(seg);
+            }
+            firstMJD = segments.front().mjd;
+            lastMJD = segments.back().mjd;
+            index.resize(lastMJD - firstMJD);
+            unsigned char seg = 0;
+            for (long mjd = firstMJD; mjd < lastMJD; mjd++)
+            {
+               if (segments[seg+1].mjd <= mjd)
+                  seg++;
+               index[mjd - firstMJD] = seg;
+            }
+         }
+
+            /// TAI-UTC in seconds on the given MJD day.
+         double get(long mjd) const
+         {
+            if (mjd < firstMJD)
+               return 0.0;
+            const Segment& seg(mjd >= lastMJD ? segments.back()
+                               : segments[index[mjd - firstMJD]]);
+               // Same expression as getLeapSeconds(year,month,day).
+            return (seg.delt + double(mjd - seg.mjd) * seg.rate);
+         }
+
+      private:
+         struct Segment
+         {
+            long mjd;     ///< MJD day the segment starts.
+            double delt;  ///< TAI-UTC at the start, seconds.
+            double rate;  ///< Rate of change of TAI-UTC, sec/day.
+         };
+
+         static long monthStart(int year, int month)
+         { return convertCalendarToJD(year, month, 1) - MJD_JDAY; }
+
+         std::vector<Segment> segments;
+            /// Index into segments for each day in [firstMJD,lastMJD).
+         std::vector<unsigned char> index;
+         long firstMJD, lastMJD;
+      };
+
+      const LeapTable& getLeapTable()
+      {
+         static const LeapTable table;
+         return table;
+      }
+
+         // Time system conversions constants
+      const double TAI_minus_GPSGAL_EPOCH = 19.;
+      const double TAI_minus_BDT_EPOCH = 33.;
+      const double TAI_minus_TT_EPOCH = -32.184;
+
+         /// How the offset from a time system to TAI is determined.
+      enum OffsetType
+      {
+         otInvalid,   ///< Not convertible.
+         otFixed,     ///< TAI minus the system is a constant.
+         otLeap,      ///< TAI minus the system is TAI-UTC.
+         otTDB        ///< TAI minus the system is TAI-TT less TDB-TT.
+      };
+
+         /// TAI minus each time system, indexed by TimeSystem.
+      const struct {
+         OffsetType type;
+         double offset;
+      } taiOffsets[] = {
+         { otInvalid, 0. },                     // Unknown
+         { otInvalid, 0. },                     // Any
+         { otFixed,   TAI_minus_GPSGAL_EPOCH }, // GPS
+         { otLeap,    0. },                     // GLO
+         { otFixed,   TAI_minus_GPSGAL_EPOCH }, // GAL
+         { otFixed,   TAI_minus_GPSGAL_EPOCH }, // QZS
+         { otFixed,   TAI_minus_BDT_EPOCH },    // BDT
+         { otFixed,   TAI_minus_GPSGAL_EPOCH }, // IRN
+         { otLeap,    0. },                     // UTC
+         { otFixed,   0. },                     // TAI
+         { otFixed,   TAI_minus_TT_EPOCH },     // TT
+         { otTDB,     TAI_minus_TT_EPOCH },     // TDB
+      };
+      static_assert(sizeof(taiOffsets)/sizeof(taiOffsets[0]) ==
+                    static_cast<size_t>(TimeSystem::Last),
+                    "taiOffsets must have an entry for every TimeSystem");
+
+         /** Compute TDB-TT; ref Astronomical Almanac B7
+          * @param[in] jday Julian day number of the date.
+          * @param[in] frac Fraction of the day. */
+      double getTDBminusTT(long jday, double frac)
+      {
+         double TJ2000(jday-2451545.5+frac);     // t-J2000
+            //       0.0001657 sec * sin(357.53 + 0.98560028 * TJ2000 deg)
+         frac = ::fmod(0.017201969994578 * TJ2000, 6.2831853071796);
+         double TDBmTT = 0.0001657 * ::sin(6.240075674 + frac);
+            //        0.000022 sec * sin(246.11 + 0.90251792 * TJ2000 deg)
+         frac = ::fmod(0.015751909262251 * TJ2000, 6.2831853071796);
+         TDBmTT += 0.000022  * ::sin(4.295429822 + frac);
+         return TDBmTT;
+      }
+
+         /** Common part of the getTimeSystemCorrection functions:
+          * look up the offset of each system from TAI and combine
+          * them.  TAI-UTC is supplied by leapSec, which is only
+          * called if needed.
+          * @param[in] jday Julian day number, for TDB.
+          * @param[in] frac Fraction of the day, for TDB. */
+      template <class LeapFunc>
+      double correction(const TimeSystem inTS, const TimeSystem outTS,
+                        long jday, double frac, LeapFunc leapSec)
+      {
+         double dt(0.0);
+
+            // identity
+         if (inTS == outTS)
+            return dt;
+
+            // cannot convert unknowns
+         if (inTS == TimeSystem::Unknown || outTS == TimeSystem::Unknown)
+         {
+            Exception e("Cannot compute correction for TimeSystem::Unknown");
+            GNSSTK_THROW(e);
+         }
+
+         unsigned inIdx = static_cast<unsigned>(inTS),
+            outIdx = static_cast<unsigned>(outTS);
+         OffsetType inType = (inIdx < sizeof(taiOffsets)/sizeof(taiOffsets[0])
+                              ? taiOffsets[inIdx].type : otInvalid),
+            outType = (outIdx < sizeof(taiOffsets)/sizeof(taiOffsets[0])
+                       ? taiOffsets[outIdx].type : otInvalid);
+
+         double TDBmTT(0.0);
+         if (inType == otTDB || outType == otTDB)
+         {
+            TDBmTT = getTDBminusTT(jday, frac);
+         }
+
+            // -----------------------------------------------------------
+            // conversions: first convert inTS->TAI ...
+            // TAI = GPS + 19s
+            // TAI = UTC + getLeapSeconds()
+            // TAI = TT - 32.184s
+         switch (inType)
+         {
+            case otFixed:
+               dt = taiOffsets[inIdx].offset;
+               break;
+            case otLeap:
+               dt = leapSec();
+               break;
+            case otTDB:
+               dt = taiOffsets[inIdx].offset + TDBmTT;
+               break;
+            default:
+               {
+                  Exception e("Invalid input TimeSystem " +
+                              StringUtils::asString(inTS));
+                  GNSSTK_THROW(e);
+               }
+         }
+
+            // -----------------------------------------------------------
+            // ... then convert TAI->outTS
+            // GPS = TAI - 19s
+            // UTC = TAI - getLeapSeconds()
+            // TT = TAI + 32.184s
+         switch (outType)
+         {
+            case otFixed:
+               dt -= taiOffsets[outIdx].offset;
+               break;
+            case otLeap:
+               dt -= leapSec();
+               break;
+            case otTDB:
+               dt -= taiOffsets[outIdx].offset + TDBmTT;
+               break;
+            default:
+               {
+                  Exception e("Invalid output TimeSystem " +
+                              StringUtils::asString(outTS));
+                  GNSSTK_THROW(e);
+               }
+         }
+
+         return dt;
+      }
+   } // anonymous namespace
+
+
+   double getLeapSeconds(const int year,
+                         const int month,
+                         const double day)
+   {
          // search for the input year, month
       if (year < 1960)
       {
@@ -163,138 +373,43 @@ namespace gnsstk
       }
       else
       {                                    // [1972- leap seconds
-         for (int i=NLEAPS-1; i>=0; i--)
-         {
-            if (leaps[i].year > year ||
-                (leaps[i].year == year && leaps[i].month > month))
-            {
-               continue;
-            }
-            return double(leaps[i].nleap);
-         }
+            // leap seconds only change on the first of a month
+         return getLeapTable().get(convertCalendarToJD(year,month,1) -
+                                   MJD_JDAY);
       }
 
       return 0.0;
    }
 
 
+   double getLeapSecondsMJD(const long mjd)
+   {
+      return getLeapTable().get(mjd);
+   }
+
+
    double getTimeSystemCorrection(const TimeSystem inTS,
                                   const TimeSystem outTS,
                                   const int year,
                                   const int month,
                                   const double day)
    {
-      double dt(0.0);
-
-         // identity
       if (inTS == outTS)
-         return dt;
-
-         // cannot convert unknowns
-      if (inTS == TimeSystem::Unknown || outTS == TimeSystem::Unknown)
-      {
-         Exception e("Cannot compute correction for TimeSystem::Unknown");
-         GNSSTK_THROW(e);
-      }
-
-         // compute TT-TDB here; ref Astronomical Almanac B7
-      double TDBmTT(0.0);
-      if (inTS == TimeSystem::TDB || outTS == TimeSystem::TDB)
-      {
-         int iday = int(day);
-         long jday = convertCalendarToJD(year, month, iday) ;
-         double frac(day-iday);
-         double TJ2000(jday-2451545.5+frac);     // t-J2000
-            //       0.0001657 sec * sin(357.53 + 0.98560028 * TJ2000 deg)
-         frac = ::fmod(0.017201969994578 * TJ2000, 6.2831853071796);
-         TDBmTT = 0.0001657 * ::sin(6.240075674 + frac);
-            //        0.000022 sec * sin(246.11 + 0.90251792 * TJ2000 deg)
-         frac = ::fmod(0.015751909262251 * TJ2000, 6.2831853071796);
-         TDBmTT += 0.000022  * ::sin(4.295429822 + frac);
-      }
-
-         // Time system conversions constants
-      static const double TAI_minus_GPSGAL_EPOCH = 19.;
-      static const double TAI_minus_BDT_EPOCH = 33.;
-      static const double TAI_minus_TT_EPOCH = -32.184;
-
-         // -----------------------------------------------------------
-         // conversions: first convert inTS->TAI ...
-         // TAI = GPS + 19s
-         // TAI = UTC + getLeapSeconds()
-         // TAI = TT - 32.184s
-      if (inTS == TimeSystem::GPS ||       // GPS -> TAI
-          inTS == TimeSystem::GAL ||       // GAL -> TAI
-          inTS == TimeSystem::QZS ||       // QZS -> TAI
-          inTS == TimeSystem::IRN )        // IRN -> TAI
-      {
-         dt = TAI_minus_GPSGAL_EPOCH;
-      }
-      else if (inTS == TimeSystem::UTC ||  // UTC -> TAI
-               inTS == TimeSystem::GLO)    // GLO -> TAI
-      {
-         dt = getLeapSeconds(year, month, day);
-      }
-      else if (inTS == TimeSystem::BDT)    // BDT -> TAI
-      {
-         dt = TAI_minus_BDT_EPOCH;
-      }
-      else if (inTS == TimeSystem::TAI)    // TAI
-      {
-      }
-      else if (inTS == TimeSystem::TT)     // TT -> TAI
-      {
-         dt = TAI_minus_TT_EPOCH;
-      }
-      else if (inTS == TimeSystem::TDB)    // TDB -> TAI
-      {
-         dt = TAI_minus_TT_EPOCH + TDBmTT;
-      }
-      else
-      {                              // other
-         Exception e("Invalid input TimeSystem " + StringUtils::asString(inTS));
-         GNSSTK_THROW(e);
-      }
+         return 0.0;
+      int iday = int(day);
+      return correction(inTS, outTS, convertCalendarToJD(year, month, iday),
+                        day-iday,
+                        [=]() { return getLeapSeconds(year, month, day); });
+   }
 
-         // -----------------------------------------------------------
-         // ... then convert TAI->outTS
-         // GPS = TAI - 19s
-         // UTC = TAI - getLeapSeconds()
-         // TT = TAI + 32.184s
-      if (outTS == TimeSystem::GPS ||      // TAI -> GPS
-          outTS == TimeSystem::GAL ||      // TAI -> GAL
-          outTS == TimeSystem::QZS ||      // TAI -> QZS
-          outTS == TimeSystem::IRN )       // TAI -> IRN
-      {
-         dt -= TAI_minus_GPSGAL_EPOCH;
-      }
-      else if (outTS == TimeSystem::UTC || // TAI -> UTC
-               outTS == TimeSystem::GLO)   // TAI -> GLO
-      {
-         dt -= getLeapSeconds(year, month, day);
-      }
-      else if (outTS == TimeSystem::BDT)   // TAI -> BDT
-      {
-         dt -= TAI_minus_BDT_EPOCH;
-      }
-      else if (outTS == TimeSystem::TAI)   // TAI
-      {
-      }
-      else if (outTS == TimeSystem::TT)    // TAI -> TT
-      {
-         dt -= TAI_minus_TT_EPOCH;
-      }
-      else if (outTS == TimeSystem::TDB)   // TAI -> TDB
-      {
-         dt -= TAI_minus_TT_EPOCH + TDBmTT;
-      }
-      else
-      {                              // other
-         Exception e("Invalid output TimeSystem "+StringUtils::asString(outTS));
-         GNSSTK_THROW(e);
-      }
 
-      return dt;
+   double getTimeSystemCorrectionMJD(const TimeSystem inTS,
+                                     const TimeSystem outTS,
+                                     const long mjd,
+                                     const double fracDay)
+   {
+      return correction(inTS, outTS, mjd + MJD_JDAY, fracDay,
+                        [=]() { return getLeapSecondsMJD(mjd); });
    }
 
 
@@ -101,6 +101,16 @@ namespace gnsstk
        */
    double getLeapSeconds(const int yr, const int mon, const double day);
 
+      /** Return TAI-UTC, as getLeapSeconds(), for the day with the
+       * given Modified Julian Date.  The value comes from a table
+       * indexed by day that is built once from the leap second
+       * history, so no calendar conversion or search is done.
+       * @param[in] mjd integer MJD of the day of interest
+       * @return the same value as getLeapSeconds(yr, mon, day) for
+       *   the calendar date of mjd.
+       */
+   double getLeapSecondsMJD(const long mjd);
+
       /** Compute the conversion (in seconds) from one time system
        * (inTS) to another (outTS), given the year and month of the
        * time to be converted.  Result is to be added to the first
@@ -119,6 +129,23 @@ namespace gnsstk
       const TimeSystem inTS, const TimeSystem outTS,
       const int year, const int month, const double day);
 
+      /** Compute the conversion (in seconds) from one time system
+       * (inTS) to another (outTS), as getTimeSystemCorrection(), for
+       * a time given as an MJD day and fraction of a day.  The
+       * offsets of the fixed-offset systems are looked up directly
+       * and TAI-UTC comes from getLeapSecondsMJD(), so this is
+       * suited to converting many times.
+       * @param[in] inTS input system
+       * @param[in] outTS output system
+       * @param[in] mjd integer MJD of the time to be converted.
+       * @param[in] fracDay fraction of the day, only used for TDB.
+       * @return correction (sec) to be added to t(in) to yield t(out).
+       * @throw if input system(s) are invalid or Unknown.
+       */
+   double getTimeSystemCorrectionMJD(
+      const TimeSystem inTS, const TimeSystem outTS,
+      const long mjd, const double fracDay = 0.0);
+
       /** Write name (asString()) of a TimeSystem to an output stream.
        * @param[in,out] os The output stream
        * @param[in] ts The TimeSystem to be written
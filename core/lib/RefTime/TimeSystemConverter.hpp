@@ -46,6 +46,7 @@ namespace gnsstk
    class CommonTime;
 }
 
+#include <vector>
 #include "CommonTime.hpp"
 
 namespace gnsstk
@@ -67,6 +68,17 @@ namespace gnsstk
           * @return true if successful, false if unavailable. */
       virtual bool getOffset(TimeSystem fromSys, TimeSystem toSys,
                              const CommonTime& t, double& offs) = 0;
+
+         /** Convert each of a set of times to another time system,
+          * as CommonTime::changeTimeSystem(toSys, this) does for a
+          * single time.  Derived classes may override this to share
+          * work between times.
+          * @param[in,out] times The times to convert.  Any that can
+          *   not be converted are left unchanged.
+          * @param[in] toSys The time system to convert to.
+          * @return true if every time was converted. */
+      virtual bool changeTimeSystem(std::vector<CommonTime>& times,
+                                    TimeSystem toSys);
    };
 
       //@}
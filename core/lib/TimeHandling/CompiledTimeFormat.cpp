@@ -0,0 +1,1008 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file CompiledTimeFormat.cpp  pre-parsed printTime()/scanTime() formats.
+
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "CompiledTimeFormat.hpp"
+#include "TimeString.hpp"
+
+#include "ANSITime.hpp"
+#include "CivilTime.hpp"
+#include "GPSWeekSecond.hpp"
+#include "BDSWeekSecond.hpp"
+#include "GALWeekSecond.hpp"
+#include "QZSWeekSecond.hpp"
+#include "IRNWeekSecond.hpp"
+#include "GPSWeekZcount.hpp"
+#include "JulianDate.hpp"
+#include "MJD.hpp"
+#include "UnixTime.hpp"
+#include "PosixTime.hpp"
+#include "YDSTime.hpp"
+
+#include "TimeConverters.hpp"
+#include "TimeConstants.hpp"
+
+using namespace std;
+
+namespace gnsstk
+{
+   namespace
+   {
+         /** The TimeTag classes in the order printTime() applies
+          * them.  An identifier is printed by the first class in this
+          * order that both recognizes it and can represent the time. */
+      enum Handler
+      {
+         hANSI, hCivil, hGPSWS, hGPSWZ, hJulian, hMJD, hUnix, hPosix,
+         hYDS, hGALWS, hBDSWS, hQZSWS, hIRNWS,
+         hCount,
+         hNone = hCount
+      };
+
+         /// How printTime() prints one identifier.
+      struct PrintSpec
+      {
+            /// true if the identifier accepts a precision (%06.3f).
+         bool isFloat;
+            /// sprintf conversion that replaces the identifier.
+         const char *conv;
+            /// TimeTag classes that print the identifier, hNone ended.
+         const unsigned char *handlers;
+      };
+
+      const unsigned char handK[] = { hANSI, hNone };
+      const unsigned char handP[] =
+      {
+         hANSI, hCivil, hGPSWS, hGPSWZ, hJulian, hMJD, hUnix, hPosix,
+         hYDS, hGALWS, hBDSWS, hQZSWS, hIRNWS, hNone
+      };
+      const unsigned char handCivilYDS[] = { hCivil, hYDS, hNone };
+      const unsigned char handCivil[] = { hCivil, hNone };
+      const unsigned char handGPSWeek[] = { hGPSWS, hGPSWZ, hNone };
+      const unsigned char handDOW[] =
+      { hGPSWS, hGPSWZ, hGALWS, hBDSWS, hQZSWS, hIRNWS, hNone };
+      const unsigned char handSOW[] =
+      { hGPSWS, hGALWS, hBDSWS, hQZSWS, hIRNWS, hNone };
+      const unsigned char handZcount[] = { hGPSWZ, hNone };
+      const unsigned char handJulian[] = { hJulian, hNone };
+      const unsigned char handMJD[] = { hMJD, hNone };
+      const unsigned char handUnix[] = { hUnix, hNone };
+      const unsigned char handPosix[] = { hPosix, hNone };
+      const unsigned char handYDS[] = { hYDS, hNone };
+      const unsigned char handGAL[] = { hGALWS, hNone };
+      const unsigned char handBDS[] = { hBDSWS, hNone };
+      const unsigned char handQZS[] = { hQZSWS, hNone };
+      const unsigned char handIRN[] = { hIRNWS, hNone };
+
+         /** Look up the printTime() treatment of an identifier.
+          * @return the PrintSpec or NULL if no TimeTag prints id. */
+      const PrintSpec* findSpec(char id)
+      {
+         static const PrintSpec specK = { false, "lu", handK };
+         static const PrintSpec specP = { false, "s", handP };
+         static const PrintSpec specYear = { false, "d", handCivilYDS };
+         static const PrintSpec specCivilInt = { false, "u", handCivil };
+         static const PrintSpec specCivilStr = { false, "s", handCivil };
+         static const PrintSpec specCivilSec = { true, "f", handCivil };
+         static const PrintSpec specGPSWeek = { false, "u", handGPSWeek };
+         static const PrintSpec specDOW = { false, "u", handDOW };
+         static const PrintSpec specSOW = { true, "f", handSOW };
+         static const PrintSpec specDayName = { false, "s", handZcount };
+         static const PrintSpec specZcount = { false, "u", handZcount };
+         static const PrintSpec specJulian = { true, "Lf", handJulian };
+         static const PrintSpec specMJD = { true, "Lf", handMJD };
+         static const PrintSpec specUnix = { false, "lu", handUnix };
+         static const PrintSpec specPosix = { false, "lu", handPosix };
+         static const PrintSpec specDOY = { false, "u", handYDS };
+         static const PrintSpec specSOD = { true, "f", handYDS };
+         static const PrintSpec specGAL = { false, "u", handGAL };
+         static const PrintSpec specBDS = { false, "u", handBDS };
+         static const PrintSpec specQZS = { false, "u", handQZS };
+         static const PrintSpec specIRN = { false, "u", handIRN };
+         switch (id)
+         {
+            case 'K': return &specK;
+            case 'P': return &specP;
+            case 'Y':
+            case 'y': return &specYear;
+            case 'm':
+            case 'd':
+            case 'H':
+            case 'M':
+            case 'S': return &specCivilInt;
+            case 'b':
+            case 'B': return &specCivilStr;
+            case 'f': return &specCivilSec;
+            case 'E':
+            case 'F':
+            case 'G': return &specGPSWeek;
+            case 'w': return &specDOW;
+            case 'g': return &specSOW;
+            case 'a':
+            case 'A': return &specDayName;
+            case 'z':
+            case 'Z':
+            case 'c':
+            case 'C': return &specZcount;
+            case 'J': return &specJulian;
+            case 'Q': return &specMJD;
+            case 'U':
+            case 'u': return &specUnix;
+            case 'W':
+            case 'N': return &specPosix;
+            case 'j': return &specDOY;
+            case 's': return &specSOD;
+            case 'T':
+            case 'L':
+            case 'l': return &specGAL;
+            case 'R':
+            case 'D':
+            case 'e': return &specBDS;
+            case 'V':
+            case 'h':
+            case 'i': return &specQZS;
+            case 'X':
+            case 'O':
+            case 'o': return &specIRN;
+            default:  return NULL;
+         }
+      }
+
+         // Same names GPSWeekZcount::printf() uses for %a and %A.
+      const char *weekdayAbbr[] =
+      {
+         "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+      };
+      const char *weekday[] =
+      {
+         "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday",
+         "Saturday"
+      };
+
+         /** The TimeTag representations of one time, converted on
+          * first use.  Conversions that throw InvalidRequest are
+          * remembered so that printTime()'s fall-through to the next
+          * TimeTag (or to leaving the identifier unchanged) is
+          * reproduced. */
+      class Conversions
+      {
+      public:
+         Conversions(const CommonTime& t)
+               : when(t)
+         { memset(state, 0, sizeof(state)); }
+
+            /// @return true if the time can be represented by handler h.
+         bool have(unsigned h)
+         {
+            if (state[h] == 0)
+            {
+               try
+               {
+                  tag(h).convertFromCommonTime(when);
+                  state[h] = 1;
+               }
+               catch (gnsstk::InvalidRequest& e)
+               {
+                  state[h] = 2;
+               }
+            }
+            return (state[h] == 1);
+         }
+
+         TimeTag& tag(unsigned h)
+         {
+            switch (h)
+            {
+               case hANSI:   return ansi;
+               case hCivil:  return civil;
+               case hGPSWS:  return gpsws;
+               case hGPSWZ:  return gpswz;
+               case hJulian: return julian;
+               case hMJD:    return mjd;
+               case hUnix:   return unixTime;
+               case hPosix:  return posix;
+               case hYDS:    return yds;
+               case hGALWS:  return galws;
+               case hBDSWS:  return bdsws;
+               case hQZSWS:  return qzsws;
+               default:      return irnws;
+            }
+         }
+
+            /// Week/second representation for handler h.
+         const WeekSecond& weekSecond(unsigned h)
+         {
+            switch (h)
+            {
+               case hGALWS: return galws;
+               case hBDSWS: return bdsws;
+               case hQZSWS: return qzsws;
+               case hIRNWS: return irnws;
+               default:     return gpsws;
+            }
+         }
+
+         const CommonTime& when;
+         unsigned char state[hCount];
+         ANSITime ansi;
+         CivilTime civil;
+         GPSWeekSecond gpsws;
+         GPSWeekZcount gpswz;
+         JulianDate julian;
+         MJD mjd;
+         UnixTime unixTime;
+         PosixTime posix;
+         YDSTime yds;
+         GALWeekSecond galws;
+         BDSWeekSecond bdsws;
+         QZSWeekSecond qzsws;
+         IRNWeekSecond irnws;
+      };
+
+         /** Print the value of an identifier as supplied by handler
+          * h, passing sprintf the same types the TimeTag printf()
+          * methods pass. */
+      int printValue(char *dst, string::size_type rem, const char *spec,
+                     char id, unsigned h, Conversions& cv)
+      {
+         switch (id)
+         {
+            case 'K':
+               return snprintf(dst, rem, spec, cv.ansi.time);
+            case 'P':
+               return snprintf(
+                  dst, rem, spec,
+                  StringUtils::asString(cv.tag(h).getTimeSystem()).c_str());
+            case 'Y':
+               return snprintf(dst, rem, spec,
+                               (h == hCivil ? cv.civil.year : cv.yds.year));
+            case 'y':
+               return snprintf(dst, rem, spec, static_cast<short>(
+                                  (h == hCivil ? cv.civil.year : cv.yds.year)
+                                  % 100));
+            case 'm':
+               return snprintf(dst, rem, spec, cv.civil.month);
+            case 'b':
+               return snprintf(dst, rem, spec,
+                               CivilTime::MonthAbbrevNames[cv.civil.month]);
+            case 'B':
+               return snprintf(dst, rem, spec,
+                               CivilTime::MonthNames[cv.civil.month]);
+            case 'd':
+               return snprintf(dst, rem, spec, cv.civil.day);
+            case 'H':
+               return snprintf(dst, rem, spec, cv.civil.hour);
+            case 'M':
+               return snprintf(dst, rem, spec, cv.civil.minute);
+            case 'S':
+               return snprintf(dst, rem, spec,
+                               static_cast<short>(cv.civil.second));
+            case 'f':
+               return snprintf(dst, rem, spec, cv.civil.second);
+            case 'E':
+               return snprintf(dst, rem, spec, (h == hGPSWS
+                                                ? cv.gpsws.getEpoch()
+                                                : cv.gpswz.getEpoch()));
+            case 'F':
+               return snprintf(dst, rem, spec, (h == hGPSWS
+                                                ? cv.gpsws.week
+                                                : cv.gpswz.week));
+            case 'G':
+               return snprintf(dst, rem, spec, (h == hGPSWS
+                                                ? cv.gpsws.getModWeek()
+                                                : cv.gpswz.getWeek10()));
+            case 'w':
+               return snprintf(dst, rem, spec, (h == hGPSWZ
+                                                ? cv.gpswz.getDayOfWeek()
+                                                : cv.weekSecond(h)
+                                                .getDayOfWeek()));
+            case 'g':
+               return snprintf(dst, rem, spec, cv.weekSecond(h).sow);
+            case 'a':
+               return snprintf(dst, rem, spec,
+                               weekdayAbbr[cv.gpswz.getDayOfWeek()]);
+            case 'A':
+               return snprintf(dst, rem, spec,
+                               weekday[cv.gpswz.getDayOfWeek()]);
+            case 'z':
+            case 'Z':
+               return snprintf(dst, rem, spec, cv.gpswz.zcount);
+            case 'c':
+               return snprintf(dst, rem, spec, cv.gpswz.getZcount29());
+            case 'C':
+               return snprintf(dst, rem, spec, cv.gpswz.getZcount32());
+            case 'J':
+               return snprintf(dst, rem, spec, cv.julian.jd);
+            case 'Q':
+               return snprintf(dst, rem, spec, cv.mjd.mjd);
+            case 'U':
+               return snprintf(dst, rem, spec, cv.unixTime.tv.tv_sec);
+            case 'u':
+               return snprintf(dst, rem, spec, cv.unixTime.tv.tv_usec);
+            case 'W':
+               return snprintf(dst, rem, spec, cv.posix.ts.tv_sec);
+            case 'N':
+               return snprintf(dst, rem, spec, cv.posix.ts.tv_nsec);
+            case 'j':
+               return snprintf(dst, rem, spec, cv.yds.doy);
+            case 's':
+               return snprintf(dst, rem, spec, cv.yds.sod);
+            case 'T':
+            case 'R':
+            case 'V':
+            case 'X':
+               return snprintf(dst, rem, spec,
+                               cv.weekSecond(h).getEpoch());
+            case 'L':
+            case 'D':
+            case 'h':
+            case 'O':
+               return snprintf(dst, rem, spec, cv.weekSecond(h).week);
+            case 'l':
+            case 'e':
+            case 'i':
+            case 'o':
+               return snprintf(dst, rem, spec,
+                               cv.weekSecond(h).getModWeek());
+            default:
+               return 0;
+         }
+      }
+
+         /// A field of a time string being scanned.
+      struct Field
+      {
+         const char *p;
+         string::size_type len;
+      };
+
+         /// Same as StringUtils::asInt(string(f.p, f.len)).
+      long fieldInt(const Field& f)
+      {
+         char tmp[32];
+         if (f.len >= sizeof(tmp))
+            return StringUtils::asInt(string(f.p, f.len));
+         memcpy(tmp, f.p, f.len);
+         tmp[f.len] = 0;
+         return strtol(tmp, 0, 10);
+      }
+
+      double fieldDouble(const Field& f)
+      { return StringUtils::asDouble(f.p, f.len); }
+
+      string fieldString(const Field& f)
+      { return string(f.p, f.len); }
+
+         /// Identifier characters used by one of the WeekSecond classes.
+      struct WeekIds
+      {
+         char epoch, fullWeek, modWeek;
+      };
+   } // anonymous namespace
+
+
+   CompiledTimeFormat ::
+   CompiledTimeFormat(const std::string& fmt)
+   {
+      compile(fmt);
+   }
+
+
+   void CompiledTimeFormat ::
+   compile(const std::string& fmt)
+   {
+      format = fmt;
+      compilePrint();
+      compileScan();
+   }
+
+
+   void CompiledTimeFormat ::
+   compilePrint()
+   {
+      printOps.clear();
+      string::size_type n = format.size(), i = 0, lit = 0;
+      while (i < n)
+      {
+         if (format[i] != '%')
+         {
+            i++;
+            continue;
+         }
+            // Match the regular expressions TimeTag::getFormatPrefixInt()
+            // and getFormatPrefixFloat() followed by the identifier.
+         string::size_type j = i + 1;
+         if ((j < n) &&
+             ((format[j] == ' ') || (format[j] == '0') || (format[j] == '-')))
+            j++;
+         while ((j < n) && isdigit((unsigned char)format[j]))
+            j++;
+         bool precision = false;
+         if ((j + 1 < n) && (format[j] == '.') &&
+             isdigit((unsigned char)format[j+1]))
+         {
+            precision = true;
+            j++;
+            while ((j < n) && isdigit((unsigned char)format[j]))
+               j++;
+         }
+         const PrintSpec *ps = ((j < n) ? findSpec(format[j]) : NULL);
+         if ((ps == NULL) || (precision && !ps->isFloat))
+         {
+               // not an identifier, left as is like printTime() does
+            i++;
+            continue;
+         }
+         PrintOp op;
+         if (i > lit)
+         {
+            op.id = 0;
+            op.pos = lit;
+            op.len = i - lit;
+            printOps.push_back(op);
+         }
+         op.id = format[j];
+         op.pos = i;
+         op.len = j + 1 - i;
+         op.spec = format.substr(i, j - i) + ps->conv;
+         op.handlers = ps->handlers;
+         printOps.push_back(op);
+         i = lit = j + 1;
+      }
+      if (n > lit)
+      {
+         PrintOp op;
+         op.id = 0;
+         op.pos = lit;
+         op.len = n - lit;
+         op.handlers = NULL;
+         printOps.push_back(op);
+      }
+   }
+
+
+   void CompiledTimeFormat ::
+   compileScan()
+   {
+      scanOps.clear();
+      slotIds.clear();
+      slotSource.clear();
+      scanTail = 0;
+      scanTailField = false;
+      hasSOD = hasHMS = false;
+
+         // Walk the format the way TimeTag::getInfo() does, recording
+         // how far to skip and how each field is delimited.
+      vector<char> opIds;
+      string::size_type n = format.size(), i = 0, skip = 0;
+      while (i < n)
+      {
+         if (format[i] != '%')
+         {
+            skip++;
+            i++;
+            continue;
+         }
+         i++;
+         ScanOp op;
+         op.skip = skip;
+         op.width = 0;
+         op.delim = 0;
+         op.slot = 0;
+         skip = 0;
+         if ((i >= n) || !isalpha((unsigned char)format[i]))
+         {
+            op.mode = fmWidth;
+            op.width = strtol(format.c_str() + i, 0, 10);
+            while ((i < n) && !isalpha((unsigned char)format[i]))
+               i++;
+            if (i >= n)
+            {
+                  // getInfo() stops here without reading a field
+               scanTailField = true;
+               skip = op.skip;
+               break;
+            }
+         }
+         else if (n - i > 1)
+         {
+            if (format[i+1] != '%')
+            {
+               op.mode = fmDelimit;
+               op.delim = format[i+1];
+            }
+            else
+            {
+               op.mode = fmOne;
+            }
+         }
+         else
+         {
+            op.mode = fmRest;
+         }
+         opIds.push_back(format[i]);
+         i++;
+         if (op.mode == fmDelimit)
+            i++;
+         scanOps.push_back(op);
+      }
+      scanTail = skip;
+
+         // Fields are applied in TimeTag::IdToValue order, with the
+         // last occurrence of an identifier winning, and scanTime()
+         // copies %f into %S.
+      slotIds = opIds;
+      bool hasFrac = (find(opIds.begin(), opIds.end(), 'f') != opIds.end());
+      if (hasFrac)
+         slotIds.push_back('S');
+      sort(slotIds.begin(), slotIds.end());
+      slotIds.erase(unique(slotIds.begin(), slotIds.end()), slotIds.end());
+      for (unsigned k = 0; k < scanOps.size(); k++)
+      {
+         scanOps[k].slot = lower_bound(slotIds.begin(), slotIds.end(),
+                                       opIds[k]) - slotIds.begin();
+      }
+      for (unsigned k = 0; k < slotIds.size(); k++)
+      {
+         slotSource.push_back(k);
+      }
+      if (hasFrac)
+      {
+         slotSource[lower_bound(slotIds.begin(), slotIds.end(), 'S') -
+                    slotIds.begin()] =
+            lower_bound(slotIds.begin(), slotIds.end(), 'f') -
+            slotIds.begin();
+      }
+
+         // Make the same choice of TimeTag that scanTime() makes.
+      bool has[128];
+      memset(has, 0, sizeof(has));
+      for (unsigned k = 0; k < slotIds.size(); k++)
+      {
+         if ((unsigned char)slotIds[k] < 128)
+            has[(unsigned char)slotIds[k]] = true;
+      }
+      bool hyear = has['Y'] || has['y'],
+         hmonth = has['m'] || has['b'] || has['B'],
+         hday = has['d'],
+         hzcount = has['z'] || has['Z'],
+         hzcount29 = has['c'],
+         hzcount32 = has['C'],
+         hbdse = has['R'], hgale = has['T'], hqzse = has['V'],
+         hirne = has['X'],
+         hepoch = has['E'] || hbdse || hgale || hqzse || hirne,
+         hbdsfw = has['D'], hgalfw = has['L'], hqzsfw = has['h'],
+         hirnfw = has['O'],
+         hfullweek = has['F'] || hbdsfw || hgalfw || hqzsfw || hirnfw,
+         hbdsw = has['e'], hgalw = has['l'], hqzsw = has['i'],
+         hirnw = has['o'],
+         hweek = has['G'] || hbdsw || hgalw || hqzsw || hirnw;
+      hasSOD = has['s'];
+      hasHMS = has['H'] && has['M'] && has['S'];
+
+      if ((slotIds.size() > MAX_SLOTS) || has['a'] || has['A'])
+      {
+            // Too many fields to track, or %a/%A, whose effect
+            // depends on whether the string holds a day name.
+         scanTarget = stScanTime;
+      }
+      else if (hyear)
+      {
+         scanTarget = ((hmonth && hday) ? stCivil : stYDS);
+      }
+      else if (hzcount32 ||
+               (hfullweek && (hzcount || hzcount29)) ||
+               (hepoch && (hzcount29 || (hweek && hzcount))))
+      {
+         scanTarget = stScanTime;
+      }
+      else if ((hepoch && hweek) || hfullweek)
+      {
+         if (hbdse || hbdsfw || hbdsw)
+            scanTarget = stBDSWeek;
+         else if (hqzse || hqzsfw || hqzsw)
+            scanTarget = stQZSWeek;
+         else if (hgale || hgalfw || hgalw)
+            scanTarget = stGALWeek;
+         else if (hirne || hirnfw || hirnw)
+            scanTarget = stIRNWeek;
+         else
+            scanTarget = stGPSWeek;
+      }
+      else if (has['Q'])
+      {
+         scanTarget = stMJD;
+      }
+      else if (has['J'])
+      {
+         scanTarget = stJulian;
+      }
+      else
+      {
+            // ANSI, Unix and POSIX time, or an incomplete format
+         scanTarget = stScanTime;
+      }
+   }
+
+
+   std::string::size_type CompiledTimeFormat ::
+   print(const CommonTime& t, char *buf, std::string::size_type len) const
+   {
+      Conversions cv(t);
+      string::size_type rv = 0;
+      for (unsigned k = 0; k < printOps.size(); k++)
+      {
+         const PrintOp& op(printOps[k]);
+         char *dst = (rv < len ? buf + rv : NULL);
+         string::size_type rem = (rv < len ? len - rv : 0);
+         unsigned h = hNone;
+         if (op.id != 0)
+         {
+            for (const unsigned char *hp = op.handlers; *hp != hNone; hp++)
+            {
+               if (cv.have(*hp))
+               {
+                  h = *hp;
+                  break;
+               }
+            }
+         }
+         if (h == hNone)
+         {
+               // literal text, or an identifier no TimeTag could print
+            if (rem > 0)
+               memcpy(dst, format.data() + op.pos, std::min(rem, op.len));
+            rv += op.len;
+         }
+         else
+         {
+            int w = printValue(dst, rem, op.spec.c_str(), op.id, h, cv);
+            if (w > 0)
+               rv += w;
+         }
+      }
+      if (len > 0)
+         buf[std::min(rv, len - 1)] = 0;
+      return rv;
+   }
+
+
+   std::string CompiledTimeFormat ::
+   print(const CommonTime& t) const
+   {
+      char buf[256];
+      string::size_type len = print(t, buf, sizeof(buf));
+      if (len < sizeof(buf))
+         return string(buf, len);
+      string rv(len + 1, ' ');
+      print(t, &rv[0], len + 1);
+      rv.resize(len);
+      return rv;
+   }
+
+
+   void CompiledTimeFormat ::
+   scan(CommonTime& t, const std::string& str) const
+   {
+      if (scanTarget == stScanTime)
+      {
+         scanTime(t, str, format);
+         return;
+      }
+
+         // Split str into fields exactly as TimeTag::getInfo() does.
+         // Anything that would make getInfo() fail is left to
+         // scanTime() to report.
+      Field fields[MAX_SLOTS];
+      string::size_type n = str.size(), pos = 0;
+      for (unsigned k = 0; k < scanOps.size(); k++)
+      {
+         const ScanOp& op(scanOps[k]);
+         if (n - pos <= op.skip)
+         {
+            scanTime(t, str, format);
+            return;
+         }
+         pos += op.skip;
+         string::size_type flen;
+         switch (op.mode)
+         {
+            case fmWidth:
+               flen = std::min(op.width, n - pos);
+               break;
+            case fmDelimit:
+               {
+                  while ((pos < n) && (str[pos] == ' '))
+                     pos++;
+                  string::size_type d = str.find(op.delim, pos);
+                  flen = (d == string::npos ? n - pos : d - pos);
+               }
+               break;
+            case fmOne:
+               flen = 1;
+               break;
+            default:
+               flen = n - pos;
+               break;
+         }
+         fields[op.slot].p = str.data() + pos;
+         fields[op.slot].len = flen;
+         pos += flen;
+         if ((op.mode == fmDelimit) && (pos < n))
+            pos++;
+      }
+      if (scanTailField ? (n - pos <= scanTail) : (n - pos < scanTail))
+      {
+         scanTime(t, str, format);
+         return;
+      }
+
+         // Apply the fields in IdToValue order as the TimeTag
+         // setFromInfo() methods do, then make scanTime()'s
+         // adjustments.
+      unsigned numSlots = slotIds.size();
+      const Field *sod = NULL, *hour = NULL, *minute = NULL, *second = NULL,
+         *dow = NULL;
+      bool hsow = false;
+      for (unsigned k = 0; k < numSlots; k++)
+      {
+         const Field *f = &fields[slotSource[k]];
+         switch (slotIds[k])
+         {
+            case 's': sod = f; break;
+            case 'H': hour = f; break;
+            case 'M': minute = f; break;
+            case 'S': second = f; break;
+            case 'w': dow = f; break;
+            case 'g': hsow = true; break;
+            default: break;
+         }
+      }
+
+      switch (scanTarget)
+      {
+         case stCivil:
+            {
+               CivilTime tt;
+               for (unsigned k = 0; k < numSlots; k++)
+               {
+                  const Field& f(fields[slotSource[k]]);
+                  bool ok = true;
+                  switch (slotIds[k])
+                  {
+                     case 'Y': tt.year = fieldInt(f); break;
+                     case 'y':
+                        if (f.len > 2)
+                        {
+                           ok = false;
+                           break;
+                        }
+                        tt.year = fieldInt(f);
+                        tt.year += (tt.year >= 69 ? 1900 : 2000);
+                        break;
+                     case 'm': tt.month = fieldInt(f); break;
+                     case 'b':
+                        tt.month = CivilTime::monthAbbrev(fieldString(f));
+                        ok = (tt.month >= 1);
+                        break;
+                     case 'B':
+                        tt.month = CivilTime::monthLong(fieldString(f));
+                        ok = (tt.month >= 1);
+                        break;
+                     case 'd': tt.day = fieldInt(f); break;
+                     case 'H': tt.hour = fieldInt(f); break;
+                     case 'M': tt.minute = fieldInt(f); break;
+                     case 'S': tt.second = floor(fieldDouble(f)); break;
+                     case 'f': tt.second = fieldDouble(f); break;
+                     case 'P':
+                        tt.setTimeSystem(
+                           StringUtils::asTimeSystem(fieldString(f)));
+                        break;
+                     default: break;
+                  }
+                  if (!ok)
+                     break;
+               }
+               if (hasSOD)
+               {
+                  convertSODtoTime(fieldDouble(*sod),
+                                   tt.hour, tt.minute, tt.second);
+               }
+               t = tt.convertToCommonTime();
+            }
+            break;
+
+         case stYDS:
+            {
+               YDSTime tt;
+               for (unsigned k = 0; k < numSlots; k++)
+               {
+                  const Field& f(fields[slotSource[k]]);
+                  bool ok = true;
+                  switch (slotIds[k])
+                  {
+                     case 'Y': tt.year = fieldInt(f); break;
+                     case 'y':
+                        if (f.len > 2)
+                        {
+                           ok = false;
+                           break;
+                        }
+                        tt.year = fieldInt(f);
+                        tt.year += (tt.year >= 69 ? 1900 : 2000);
+                        break;
+                     case 'j': tt.doy = fieldInt(f); break;
+                     case 's': tt.sod = fieldDouble(f); break;
+                     case 'P':
+                        tt.setTimeSystem(
+                           StringUtils::asTimeSystem(fieldString(f)));
+                        break;
+                     default: break;
+                  }
+                  if (!ok)
+                     break;
+               }
+               if (hasHMS)
+               {
+                  tt.sod = convertTimeToSOD(fieldInt(*hour),
+                                            fieldInt(*minute),
+                                            fieldDouble(*second));
+               }
+               t = tt.convertToCommonTime();
+            }
+            break;
+
+         case stGPSWeek:
+         case stGALWeek:
+         case stBDSWeek:
+         case stQZSWeek:
+         case stIRNWeek:
+            {
+               GPSWeekSecond gps;
+               GALWeekSecond gal;
+               BDSWeekSecond bds;
+               QZSWeekSecond qzs;
+               IRNWeekSecond irn;
+               WeekSecond *ptt;
+               WeekIds ids;
+               switch (scanTarget)
+               {
+                  case stGALWeek:
+                     ptt = &gal;
+                     ids.epoch = 'T'; ids.fullWeek = 'L'; ids.modWeek = 'l';
+                     break;
+                  case stBDSWeek:
+                     ptt = &bds;
+                     ids.epoch = 'R'; ids.fullWeek = 'D'; ids.modWeek = 'e';
+                     break;
+                  case stQZSWeek:
+                     ptt = &qzs;
+                     ids.epoch = 'V'; ids.fullWeek = 'h'; ids.modWeek = 'i';
+                     break;
+                  case stIRNWeek:
+                     ptt = &irn;
+                     ids.epoch = 'X'; ids.fullWeek = 'O'; ids.modWeek = 'o';
+                     break;
+                  default:
+                     ptt = &gps;
+                     ids.epoch = 'E'; ids.fullWeek = 'F'; ids.modWeek = 'G';
+                     break;
+               }
+               for (unsigned k = 0; k < numSlots; k++)
+               {
+                  const Field& f(fields[slotSource[k]]);
+                  char id = slotIds[k];
+                  if (id == ids.epoch)
+                     ptt->setEpoch(fieldInt(f));
+                  else if (id == ids.fullWeek)
+                     ptt->week = fieldInt(f);
+                  else if (id == ids.modWeek)
+                     ptt->setModWeek(fieldInt(f));
+                  else if (id == 'w')
+                     ptt->sow = static_cast<double>(fieldInt(f))*SEC_PER_DAY;
+                  else if (id == 'g')
+                     ptt->sow = fieldDouble(f);
+                  else if (id == 'P')
+                     ptt->setTimeSystem(
+                        StringUtils::asTimeSystem(fieldString(f)));
+               }
+               if ((dow != NULL) && !hsow)
+               {
+                  ptt->sow = fieldInt(*dow) * SEC_PER_DAY;
+                  if (hasSOD)
+                  {
+                     ptt->sow += fieldDouble(*sod);
+                  }
+                  else if (hasHMS)
+                  {
+                     ptt->sow += convertTimeToSOD(fieldInt(*hour),
+                                                  fieldInt(*minute),
+                                                  fieldDouble(*second));
+                  }
+               }
+               t = ptt->convertToCommonTime();
+            }
+            break;
+
+         case stMJD:
+            {
+               MJD tt;
+               for (unsigned k = 0; k < numSlots; k++)
+               {
+                  const Field& f(fields[slotSource[k]]);
+                  if (slotIds[k] == 'Q')
+                     tt.mjd = StringUtils::asLongDouble(fieldString(f));
+                  else if (slotIds[k] == 'P')
+                     tt.setTimeSystem(
+                        StringUtils::asTimeSystem(fieldString(f)));
+               }
+               t = tt.convertToCommonTime();
+            }
+            break;
+
+         case stJulian:
+            {
+               JulianDate tt;
+               for (unsigned k = 0; k < numSlots; k++)
+               {
+                  const Field& f(fields[slotSource[k]]);
+                  if (slotIds[k] == 'J')
+                     tt.jd = StringUtils::asLongDouble(fieldString(f));
+                  else if (slotIds[k] == 'P')
+                     tt.setTimeSystem(
+                        StringUtils::asTimeSystem(fieldString(f)));
+               }
+               t = tt.convertToCommonTime();
+            }
+            break;
+
+         default:
+            scanTime(t, str, format);
+            break;
+      }
+   }
+
+} // namespace gnsstk
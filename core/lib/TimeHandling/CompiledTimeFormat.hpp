@@ -0,0 +1,219 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file CompiledTimeFormat.hpp  pre-parsed printTime()/scanTime() formats.
+
+#ifndef GNSSTK_COMPILEDTIMEFORMAT_HPP
+#define GNSSTK_COMPILEDTIMEFORMAT_HPP
+
+#include <string>
+#include <vector>
+#include "CommonTime.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * A time format string that has been parsed once so that it can
+       * be used to print or scan many times.
+       *
+       * printTime() and scanTime() rediscover the layout of the
+       * format on every call: printTime() runs each TimeTag's
+       * printf(), which compiles and applies a regular expression for
+       * every identifier that TimeTag understands, and scanTime()
+       * walks the format with TimeTag::getInfo() to build a map of
+       * strings.  File writers and readers use the same handful of
+       * formats for every record, so this class does that work up
+       * front.  The constructor splits the format into literal text
+       * and identifiers, works out which TimeTag conversion supplies
+       * each identifier and the sprintf conversion used to print it,
+       * and records how each field is delimited when scanning.
+       *
+       * The output of print() is identical to printTime() and the
+       * result of scan() is identical to scanTime() for the same
+       * format, including the identifiers listed in TimeString.hpp
+       * and their handling when a TimeTag cannot represent the time.
+       * Formats whose scanning depends on the field contents (weekday
+       * names) or on a TimeTag with no fast path (Z-count, ANSI, Unix
+       * and POSIX time) are handed to scanTime() itself.
+       *
+       * @code
+       * CompiledTimeFormat fmt("%4Y %02m %02d %02H %02M %06.3f %P");
+       * char buf[64];
+       * fmt.print(t, buf, sizeof(buf));
+       * @endcode
+       */
+   class CompiledTimeFormat
+   {
+   public:
+         /** Parse a format string.
+          * @param[in] fmt The format, using the identifiers described
+          *   for printTime(). */
+      CompiledTimeFormat(const std::string& fmt = "");
+
+         /// Replace the current format with a new one.
+      void compile(const std::string& fmt);
+
+         /// Return the format string this object was compiled from.
+      const std::string& getFormat() const
+      { return format; }
+
+         /** Print a time into a caller-supplied buffer without
+          * allocating memory.  At most len-1 characters are written,
+          * followed by a terminating NUL (if len is not 0).
+          * @param[in] t The time to print.
+          * @param[out] buf The buffer to write to.
+          * @param[in] len The size of buf in bytes.
+          * @return The length of the complete formatted time, which
+          *   is len or more if the output was truncated (as snprintf).
+          * @throw StringUtils::StringException */
+      std::string::size_type print(const CommonTime& t, char *buf,
+                                   std::string::size_type len) const;
+
+         /** Print a time to a string.
+          * @param[in] t The time to print.
+          * @return The same string as printTime(t, getFormat()).
+          * @throw StringUtils::StringException */
+      std::string print(const CommonTime& t) const;
+
+         /** Set a time from a string formatted according to this
+          * format, with the same results as scanTime(t, str,
+          * getFormat()).
+          * @param[in,out] t The time to set.
+          * @param[in] str The formatted time.
+          * @throw InvalidRequest if the format does not fully
+          *   specify a time.
+          * @throw StringUtils::StringException if str does not match
+          *   the format. */
+      void scan(CommonTime& t, const std::string& str) const;
+
+   private:
+         /// One piece of output: either literal text or an identifier.
+      struct PrintOp
+      {
+            /// Identifier character, or 0 for literal text.
+         char id;
+            /// Offset of the text in format (literal or whole token).
+         std::string::size_type pos;
+            /// Length of the text in format.
+         std::string::size_type len;
+            /// sprintf conversion, e.g. "%02u" for "%02m".
+         std::string spec;
+            /// TimeTag classes that can print the identifier, in
+            /// printTime() order (see CompiledTimeFormat.cpp).
+         const unsigned char *handlers;
+      };
+
+         /// How TimeTag::getInfo() determines the extent of a field.
+      enum FieldMode
+      {
+         fmWidth,     ///< Explicit width from the format, e.g. %02m.
+         fmDelimit,   ///< Up to the literal character following it.
+         fmOne,       ///< One character, when followed by another field.
+         fmRest,      ///< The remainder of the string.
+         fmNone       ///< Truncated identifier, no field is read.
+      };
+
+         /// One field to extract when scanning.
+      struct ScanOp
+      {
+            /// Literal characters to skip before the field.
+         std::string::size_type skip;
+            /// How the field length is determined.
+         FieldMode mode;
+            /// Field width for fmWidth.
+         std::string::size_type width;
+            /// Delimiting character for fmDelimit.
+         char delim;
+            /// Index into the field slots of the identifier's value.
+         unsigned slot;
+      };
+
+         /// TimeTag that scan() sets directly (the choice scanTime makes).
+      enum ScanTarget
+      {
+         stScanTime,  ///< Defer to scanTime().
+         stCivil,     ///< CivilTime, possibly with second-of-day.
+         stYDS,       ///< YDSTime, possibly with hour/minute/second.
+         stGPSWeek,   ///< GPSWeekSecond.
+         stGALWeek,   ///< GALWeekSecond.
+         stBDSWeek,   ///< BDSWeekSecond.
+         stQZSWeek,   ///< QZSWeekSecond.
+         stIRNWeek,   ///< IRNWeekSecond.
+         stMJD,       ///< MJD.
+         stJulian     ///< JulianDate.
+      };
+
+         /// Largest number of distinct identifiers in a scan format.
+      static const unsigned MAX_SLOTS = 64;
+
+         /// Build printOps from format.
+      void compilePrint();
+         /// Build scanOps, the slot table and scanTarget from format.
+      void compileScan();
+
+         /// The format as given by the user.
+      std::string format;
+         /// Output pieces in order.
+      std::vector<PrintOp> printOps;
+         /// Fields to read in order.
+      std::vector<ScanOp> scanOps;
+         /// Literal characters that must follow the last field.
+      std::string::size_type scanTail;
+         /// True if the format ends in a truncated identifier.
+      bool scanTailField;
+         /** Identifier for each slot, sorted the way TimeTag::IdToValue
+          * orders them, so setFromInfo() semantics (later identifiers
+          * override earlier ones) are preserved. */
+      std::vector<char> slotIds;
+         /** Slot whose value each slot takes when applied; used for
+          * scanTime()'s treatment of %f as %S. */
+      std::vector<unsigned> slotSource;
+         /// Which TimeTag scan() will fill.
+      ScanTarget scanTarget;
+         /// Set when the format contains these identifier groups.
+      bool hasSOD, hasHMS;
+   }; // class CompiledTimeFormat
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_COMPILEDTIMEFORMAT_HPP
@@ -0,0 +1,93 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file FixedPointTime.cpp  Integer time representation for keys and sorting.
+
+#include <cmath>
+#include "FixedPointTime.hpp"
+#include "TimeConstants.hpp"
+
+namespace gnsstk
+{
+   constexpr int64_t FixedPointTime::ATTO_PER_SEC;
+
+      /// Attoseconds in one millisecond, the unit of CommonTime's m_fsod.
+   static const int64_t ATTO_PER_MS = FixedPointTime::ATTO_PER_SEC / MS_PER_SEC;
+
+
+   FixedPointTime ::
+   FixedPointTime(const CommonTime& ct)
+   {
+      long day, msod;
+      double fsod;
+      ct.getInternal(day, msod, fsod, m_timeSystem);
+         // fsod is in [0, 0.001) so this is at most ATTO_PER_MS, and
+         // the constructor carries any overflow into the seconds.
+      int64_t atto = (msod % MS_PER_SEC) * ATTO_PER_MS +
+         std::llround(fsod * ATTO_PER_SEC);
+      *this = FixedPointTime(static_cast<int64_t>(day) * SEC_PER_DAY +
+                             msod / MS_PER_SEC, atto, m_timeSystem);
+   }
+
+
+   CommonTime FixedPointTime ::
+   toCommonTime() const
+   {
+      int64_t day = m_sec / SEC_PER_DAY;
+      int64_t sod = m_sec % SEC_PER_DAY;
+      if (sod < 0)
+      {
+         sod += SEC_PER_DAY;
+         day--;
+      }
+      CommonTime rv;
+      rv.setInternal(static_cast<long>(day),
+                     static_cast<long>(sod * MS_PER_SEC + m_atto / ATTO_PER_MS),
+                     static_cast<double>(m_atto % ATTO_PER_MS) / ATTO_PER_SEC,
+                     m_timeSystem);
+      return rv;
+   }
+
+
+   std::ostream& operator<<(std::ostream& s, const FixedPointTime& t)
+   {
+      s << t.toCommonTime();
+      return s;
+   }
+
+} // namespace gnsstk
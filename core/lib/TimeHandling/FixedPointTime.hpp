@@ -0,0 +1,228 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file FixedPointTime.hpp  Integer time representation for keys and sorting.
+
+#ifndef GNSSTK_FIXEDPOINTTIME_HPP
+#define GNSSTK_FIXEDPOINTTIME_HPP
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include "CommonTime.hpp"
+
+namespace gnsstk
+{
+      /// @ingroup TimeHandling
+      //@{
+
+      /**
+       * A time held as two integers: whole seconds since the start of
+       * Julian day 0 (the origin of CommonTime) and attoseconds
+       * (1e-18 s) within that second, plus a time system.
+       *
+       * CommonTime splits time across a day, milliseconds of day and
+       * a double fraction of a millisecond, so every comparison,
+       * difference and addition has to walk and renormalize those
+       * three fields.  FixedPointTime is meant for the places where
+       * times are mostly compared, sorted and subtracted, such as the
+       * keys of maps and sorted arrays of epochs.  Comparison is a
+       * lexicographic test of two integers and the time system,
+       * differences are two integer subtractions, and all of it is
+       * constexpr.
+       *
+       * The attosecond resolution is finer than CommonTime::eps, and
+       * 64-bit seconds cover the whole CommonTime range
+       * (BEGINNING_OF_TIME to END_OF_TIME), so conversion from
+       * CommonTime and back again compares equal to the original.
+       *
+       * Unlike CommonTime, the comparison operators order by time
+       * system when two times are at the same instant in different
+       * systems, and do not treat TimeSystem::Any as a wild card.
+       * This gives the strict ordering needed for a key; convert to
+       * CommonTime to compare with its semantics.
+       *
+       * Arithmetic is not range checked.  toCommonTime() throws if
+       * the result is outside the range that CommonTime supports.
+       */
+   class FixedPointTime
+   {
+   public:
+         /// Attoseconds in one second.
+      static constexpr int64_t ATTO_PER_SEC = 1000000000000000000LL;
+
+         /// Default to the start of Julian day 0 in an unknown system.
+      constexpr FixedPointTime()
+            : m_sec(0), m_atto(0), m_timeSystem(TimeSystem::Unknown)
+      {}
+
+         /** Construct from integer parts.  The attoseconds may be
+          * negative or exceed one second, the result is normalized.
+          * @param[in] sec Seconds since the start of Julian day 0.
+          * @param[in] atto Attoseconds to add to sec.
+          * @param[in] ts Time system of the time. */
+      constexpr FixedPointTime(int64_t sec, int64_t atto,
+                               TimeSystem ts = TimeSystem::Unknown)
+            : m_sec(sec + floorDiv(atto)),
+              m_atto(atto - floorDiv(atto) * ATTO_PER_SEC),
+              m_timeSystem(ts)
+      {}
+
+         /// Convert from CommonTime.
+      explicit FixedPointTime(const CommonTime& ct);
+
+         /** Convert to CommonTime.
+          * @throw InvalidParameter if the time is outside the range
+          *   of CommonTime. */
+      CommonTime toCommonTime() const;
+
+         /// Whole seconds since the start of Julian day 0.
+      constexpr int64_t getSeconds() const
+      { return m_sec; }
+         /// Attoseconds in [0, ATTO_PER_SEC) past getSeconds().
+      constexpr int64_t getAttoseconds() const
+      { return m_atto; }
+         /// Time system of this time.
+      constexpr TimeSystem getTimeSystem() const
+      { return m_timeSystem; }
+         /// Change the time system tag without changing the time.
+      FixedPointTime& setTimeSystem(TimeSystem ts)
+      { m_timeSystem = ts; return *this; }
+
+         /// Return this time plus the given integer seconds and attoseconds.
+      constexpr FixedPointTime add(int64_t sec, int64_t atto = 0) const
+      { return FixedPointTime(m_sec + sec, m_atto + atto, m_timeSystem); }
+
+         /** Return this time plus a number of seconds.  The fractional
+          * part of sec is rounded to the nearest attosecond. */
+      constexpr FixedPointTime addSeconds(double sec) const
+      {
+         return add(static_cast<int64_t>(sec),
+                    roundAtto(sec - static_cast<int64_t>(sec)));
+      }
+
+         /// Difference, this - right, in attoseconds.  Only valid for
+         /// differences less than about 9.2 seconds in magnitude.
+      constexpr int64_t diffAtto(const FixedPointTime& right) const
+      { return (m_sec - right.m_sec) * ATTO_PER_SEC + (m_atto - right.m_atto); }
+
+         /// Difference, this - right, in seconds.  The time system is
+         /// ignored.
+      constexpr double operator-(const FixedPointTime& right) const
+      {
+         return static_cast<double>(m_sec - right.m_sec) +
+            static_cast<double>(m_atto - right.m_atto) / ATTO_PER_SEC;
+      }
+      constexpr FixedPointTime operator+(double sec) const
+      { return addSeconds(sec); }
+      constexpr FixedPointTime operator-(double sec) const
+      { return addSeconds(-sec); }
+      FixedPointTime& operator+=(double sec)
+      { return *this = addSeconds(sec); }
+      FixedPointTime& operator-=(double sec)
+      { return *this = addSeconds(-sec); }
+
+         /// Equal if the same instant in the same time system.
+      constexpr bool operator==(const FixedPointTime& right) const
+      {
+         return ((m_sec == right.m_sec) & (m_atto == right.m_atto) &
+                 (m_timeSystem == right.m_timeSystem));
+      }
+      constexpr bool operator!=(const FixedPointTime& right) const
+      { return !operator==(right); }
+         /// Order by time, then by time system.
+      constexpr bool operator<(const FixedPointTime& right) const
+      {
+         return (m_sec != right.m_sec ? m_sec < right.m_sec :
+                 m_atto != right.m_atto ? m_atto < right.m_atto :
+                 m_timeSystem < right.m_timeSystem);
+      }
+      constexpr bool operator>(const FixedPointTime& right) const
+      { return right.operator<(*this); }
+      constexpr bool operator<=(const FixedPointTime& right) const
+      { return !right.operator<(*this); }
+      constexpr bool operator>=(const FixedPointTime& right) const
+      { return !operator<(right); }
+
+         /// Hash suitable for std::unordered_map keys.
+      std::size_t hash() const
+      {
+         return std::hash<uint64_t>()(
+            static_cast<uint64_t>(m_sec) * 1000003u ^
+            static_cast<uint64_t>(m_atto)) ^
+            static_cast<std::size_t>(m_timeSystem);
+      }
+
+   private:
+         /// Seconds carried out of an attosecond count (floor division).
+      static constexpr int64_t floorDiv(int64_t atto)
+      { return atto / ATTO_PER_SEC - (atto % ATTO_PER_SEC < 0 ? 1 : 0); }
+         /// Round a fraction of a second (|frac| < 1) to attoseconds.
+      static constexpr int64_t roundAtto(double frac)
+      {
+         return static_cast<int64_t>(frac * ATTO_PER_SEC +
+                                     (frac < 0 ? -0.5 : 0.5));
+      }
+
+         /// Whole seconds since the start of Julian day 0.
+      int64_t m_sec;
+         /// Attoseconds past m_sec, in [0, ATTO_PER_SEC).
+      int64_t m_atto;
+         /// Time system of the time.
+      TimeSystem m_timeSystem;
+   };
+
+      /// Write the time as its CommonTime equivalent.
+   std::ostream& operator<<(std::ostream& s, const FixedPointTime& t);
+
+      //@}
+
+} // namespace gnsstk
+
+namespace std
+{
+      /// Allow FixedPointTime as an unordered container key.
+   template <>
+   struct hash<gnsstk::FixedPointTime>
+   {
+      std::size_t operator()(const gnsstk::FixedPointTime& t) const
+      { return t.hash(); }
+   };
+}
+
+#endif // GNSSTK_FIXEDPOINTTIME_HPP
@@ -0,0 +1,173 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file MPSCQueue.hpp Define a bounded lock-free queue with many
+ * producers and a single consumer. */
+
+#ifndef GNSSTK_MPSCQUEUE_HPP
+#define GNSSTK_MPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace gnsstk
+{
+      /// @ingroup datastructsgroup
+      //@{
+
+      /** A bounded first-in first-out queue that may be pushed to by
+       * any number of threads at once but popped from by only one
+       * thread at a time.  Neither operation blocks or locks; a
+       * push to a full queue or a pop from an empty one simply
+       * fails, leaving the caller to decide whether to wait, retry
+       * or drop the item.  Items pushed by any one thread are popped
+       * in the order they were pushed.
+       *
+       * Each slot carries a sequence number that tells producers
+       * when it is free and the consumer when it is filled, so
+       * producers only contend on the atomic increment of the push
+       * position.
+       * @param T The type of item, which must be default
+       *   constructible and move assignable. */
+   template <class T>
+   class MPSCQueue
+   {
+   public:
+         /** Allocate the slots.
+          * @param[in] capacity The minimum number of items the queue
+          *   can hold.  This is rounded up to a power of two. */
+      explicit MPSCQueue(size_t capacity)
+            : slots(nullptr), mask(0), pushPos(0), popPos(0)
+      {
+         size_t cap = 2;
+         while (cap < capacity)
+            cap <<= 1;
+         mask = cap - 1;
+         slots.reset(new Slot[cap]);
+         for (size_t i = 0; i < cap; i++)
+            slots[i].seq.store(i, std::memory_order_relaxed);
+      }
+
+      MPSCQueue(const MPSCQueue&) = delete;
+      MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+         /** Add an item to the end of the queue.  May be called by
+          * any number of threads at once.
+          * @param[in] item The item to add, moved from on success.
+          * @return false if the queue is full. */
+      bool tryPush(T&& item)
+      {
+         size_t pos = pushPos.load(std::memory_order_relaxed);
+         Slot *slot;
+         while (true)
+         {
+            slot = &slots[pos & mask];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0)
+            {
+                  // The slot is free, try to claim it.
+               if (pushPos.compare_exchange_weak(pos, pos+1,
+                                                 std::memory_order_relaxed))
+                  break;
+            }
+            else if (diff < 0)
+            {
+                  // The consumer hasn't freed this slot yet.
+               return false;
+            }
+            else
+            {
+                  // Another producer claimed the slot first.
+               pos = pushPos.load(std::memory_order_relaxed);
+            }
+         }
+         slot->item = std::move(item);
+         slot->seq.store(pos+1, std::memory_order_release);
+         return true;
+      }
+
+         /** Remove the item at the front of the queue.  Must only be
+          * called by one thread at a time.
+          * @param[out] item The item removed.
+          * @return false if the queue is empty. */
+      bool tryPop(T& item)
+      {
+         Slot *slot = &slots[popPos & mask];
+         size_t seq = slot->seq.load(std::memory_order_acquire);
+         if ((intptr_t)seq - (intptr_t)(popPos+1) < 0)
+            return false;
+         item = std::move(slot->item);
+         slot->item = T();
+         slot->seq.store(popPos + mask + 1, std::memory_order_release);
+         popPos++;
+         return true;
+      }
+
+         /// Return the number of items the queue can hold.
+      size_t capacity() const
+      { return mask + 1; }
+
+   private:
+         /// One queue entry and its sequence number.
+      struct Slot
+      {
+         std::atomic<size_t> seq;
+         T item;
+      };
+      std::unique_ptr<Slot[]> slots;
+         /// capacity()-1, for wrapping positions into slots.
+      size_t mask;
+         /** Next position to push to, shared by producers.  The
+          * padding keeps the producers' and consumer's positions on
+          * separate cache lines.  (alignas is not used because
+          * operator new need not honor it before C++17.) */
+      char pad1[64];
+      std::atomic<size_t> pushPos;
+      char pad2[64];
+         /// Next position to pop from, owned by the consumer.
+      size_t popPos;
+   }; // class MPSCQueue
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_MPSCQUEUE_HPP
@@ -59,6 +59,61 @@ namespace gnsstk
 {
    namespace StringUtils
    {
+      double asDouble(const char *s, std::string::size_type len)
+      {
+            // Powers of ten that are exactly representable as doubles.
+         static const double pow10[] =
+            { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+              1e11, 1e12, 1e13, 1e14, 1e15 };
+         std::string::size_type i = 0;
+         while ((i < len) && (s[i] == ' '))
+            i++;
+         bool neg = false;
+         if ((i < len) && ((s[i] == '-') || (s[i] == '+')))
+         {
+            neg = (s[i] == '-');
+            i++;
+         }
+         unsigned long long mant = 0;
+         unsigned digits = 0, fracDigits = 0;
+         bool point = false;
+         for (; i < len; i++)
+         {
+            char c = s[i];
+            if ((c >= '0') && (c <= '9'))
+            {
+               mant = mant * 10 + (c - '0');
+               digits++;
+               if (point)
+                  fracDigits++;
+            }
+            else if ((c == '.') && !point)
+            {
+               point = true;
+            }
+            else
+            {
+               break;
+            }
+         }
+            // Anything following the number must be blank.
+         bool simple = (digits > 0) && (digits <= 15);
+         for (; simple && (i < len); i++)
+         {
+            simple = (s[i] == ' ');
+         }
+         if (!simple)
+         {
+            return asDouble(std::string(s, len));
+         }
+            // With fewer than 16 digits, both the mantissa and the
+            // power of ten are exact, so the IEEE division is
+            // correctly rounded, i.e. identical to strtod.
+         double rv = static_cast<double>(mant) / pow10[fracDigits];
+         return (neg ? -rv : rv);
+      }
+
+
       void hexDumpData(const std::string& data, std::ostream& s,
                        const HexDumpDataConfig& cfg)
       {
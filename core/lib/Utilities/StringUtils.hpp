@@ -705,6 +705,19 @@ namespace gnsstk
       inline double asDouble(const std::string& s)
       { return strtod(s.c_str(), 0); }
 
+         /**
+          * Convert a fixed-width field of characters to a double
+          * precision floating point number without making a temporary
+          * string.  Plain decimal fields of up to 15 digits, such as
+          * RINEX F14.3 observations, are decoded directly; anything
+          * else is handed to strtod.  The result is the same as
+          * asDouble(std::string(s, len)).
+          * @param s pointer to the first character of the field.
+          * @param len number of characters in the field.
+          * @return double representation of the field.
+          */
+      double asDouble(const char *s, std::string::size_type len);
+
          /**
           * Convert a string to an integer.
           * @param s string containing a number.
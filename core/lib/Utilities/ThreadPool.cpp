@@ -0,0 +1,171 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file ThreadPool.cpp Implement a fixed set of worker threads
+ * that are reused for parallel loops. */
+
+#include "ThreadPool.hpp"
+
+namespace gnsstk
+{
+   ThreadPool ::
+   ThreadPool(unsigned numThreads)
+         : numThreads(numThreads), func(nullptr), loopSize(0), numRanges(0),
+           generation(0), pending(0), stopping(false)
+   {
+      if (this->numThreads == 0)
+      {
+         this->numThreads = std::thread::hardware_concurrency();
+      }
+      if (this->numThreads == 0)
+      {
+         this->numThreads = 1;
+      }
+      workers.reserve(this->numThreads - 1);
+      for (unsigned idx = 1; idx < this->numThreads; idx++)
+      {
+         workers.emplace_back(&ThreadPool::workerLoop, this, idx);
+      }
+   }
+
+
+   ThreadPool ::
+   ~ThreadPool()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         stopping = true;
+      }
+      startCond.notify_all();
+      for (auto& thr : workers)
+      {
+         thr.join();
+      }
+   }
+
+
+   void ThreadPool ::
+   run(size_t n, const RangeFunc& func, size_t minPerRange)
+   {
+      std::lock_guard<std::mutex> runLock(runMtx);
+      unsigned ranges = numThreads;
+      if (minPerRange == 0)
+      {
+         minPerRange = 1;
+      }
+      if (n / minPerRange < ranges)
+      {
+         ranges = n / minPerRange;
+      }
+      if (ranges <= 1)
+      {
+         if (n > 0)
+         {
+            func(0, n);
+         }
+         return;
+      }
+      {
+         std::lock_guard<std::mutex> lock(mtx);
+         this->func = &func;
+         loopSize = n;
+         numRanges = ranges;
+         pending = ranges - 1;
+         errors.assign(ranges, std::exception_ptr());
+         generation++;
+      }
+      startCond.notify_all();
+         // The calling thread does the first range.
+      runRange(0);
+      std::unique_lock<std::mutex> lock(mtx);
+      doneCond.wait(lock, [this] { return pending == 0; });
+      this->func = nullptr;
+      for (auto& err : errors)
+      {
+         if (err)
+         {
+            std::rethrow_exception(err);
+         }
+      }
+   }
+
+
+   void ThreadPool ::
+   workerLoop(unsigned idx)
+   {
+      unsigned long seen = 0;
+      std::unique_lock<std::mutex> lock(mtx);
+      while (true)
+      {
+         startCond.wait(lock, [this, seen]
+                        { return stopping || (generation != seen); });
+         if (stopping)
+         {
+            return;
+         }
+         seen = generation;
+         if (idx >= numRanges)
+         {
+               // Not needed for this (short) loop.
+            continue;
+         }
+         lock.unlock();
+         runRange(idx);
+         lock.lock();
+         if (--pending == 0)
+         {
+            doneCond.notify_one();
+         }
+      }
+   }
+
+
+   void ThreadPool ::
+   runRange(unsigned idx)
+   {
+      size_t first = loopSize * idx / numRanges;
+      size_t last = loopSize * (idx + 1) / numRanges;
+      try
+      {
+         (*func)(first, last);
+      }
+      catch (...)
+      {
+         errors[idx] = std::current_exception();
+      }
+   }
+}
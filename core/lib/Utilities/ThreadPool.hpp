@@ -0,0 +1,141 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+/** @file ThreadPool.hpp Define a fixed set of worker threads that
+ * are reused for parallel loops. */
+
+#ifndef GNSSTK_THREADPOOL_HPP
+#define GNSSTK_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gnsstk
+{
+      /// @ingroup datastructsgroup
+      //@{
+
+      /** A fixed set of worker threads that are started once and
+       * reused for every parallel loop run on them, so that a loop
+       * costs a wake-up and a wait rather than creating and joining
+       * threads each time.  The calling thread does one share of
+       * the work itself, so a pool of size() N starts N-1 threads.
+       *
+       * run() may be called from any thread, but calls are
+       * serialized; a pool runs one loop at a time. */
+   class ThreadPool
+   {
+   public:
+         /** The work for one contiguous range [first,last) of a loop.
+          * Ranges given to different threads never overlap. */
+      typedef std::function<void(size_t first, size_t last)> RangeFunc;
+
+         /** Start the worker threads.
+          * @param[in] numThreads The number of threads that share the
+          *   work of each loop, including the caller of run().  0
+          *   means one per hardware thread. */
+      explicit ThreadPool(unsigned numThreads = 0);
+
+         /// Stop and join the worker threads.
+      ~ThreadPool();
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+         /// Get the number of threads that share each loop.
+      unsigned size() const
+      { return numThreads; }
+
+         /** Split [0,n) into at most size() contiguous ranges of
+          * nearly equal length and call func once for each range,
+          * each on a different thread, returning when all have
+          * finished.
+          * @param[in] n The number of loop iterations.
+          * @param[in] func The work for one range.
+          * @param[in] minPerRange The smallest number of iterations
+          *   worth giving to a thread.  Fewer ranges are used if
+          *   needed so that each has at least this many, and a loop
+          *   shorter than twice this is run entirely by the caller.
+          * @throw any exception thrown by func.  When several ranges
+          *   throw, the one for the lowest range is rethrown, after
+          *   all the ranges have finished. */
+      void run(size_t n, const RangeFunc& func, size_t minPerRange = 1);
+
+   private:
+         /// The loop run by worker thread number idx (1..size()-1).
+      void workerLoop(unsigned idx);
+         /// Call func for range number idx of the current loop.
+      void runRange(unsigned idx);
+
+         /// Threads sharing each loop, including the caller of run().
+      unsigned numThreads;
+         /// Worker threads, numThreads-1 of them.
+      std::vector<std::thread> workers;
+         /// Serialize calls to run().
+      std::mutex runMtx;
+         /// Protect the loop state below.
+      std::mutex mtx;
+         /// Signal workers that a loop has started or the pool stops.
+      std::condition_variable startCond;
+         /// Signal run() that the last worker range has finished.
+      std::condition_variable doneCond;
+         /// Work for the current loop.
+      const RangeFunc *func;
+         /// Number of iterations in the current loop.
+      size_t loopSize;
+         /// Number of ranges in the current loop.
+      unsigned numRanges;
+         /// Incremented each time a loop starts.
+      unsigned long generation;
+         /// Number of worker ranges of the current loop not finished.
+      unsigned pending;
+         /// Exception thrown by each range of the current loop.
+      std::vector<std::exception_ptr> errors;
+         /// Set when the pool is being destroyed.
+      bool stopping;
+   }; // class ThreadPool
+
+      //@}
+
+} // namespace gnsstk
+
+#endif // GNSSTK_THREADPOOL_HPP
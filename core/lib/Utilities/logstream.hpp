@@ -281,16 +281,30 @@ public:
    /// @endcode
    static std::ostream*& Stream();
 
+   /// redirect log stream output from the calling thread only, for example to
+   /// collect the output of a worker thread and write it later, in order; while
+   /// this is non-null, Stream() returns it in this thread. Reset to null to
+   /// resume writing to the shared stream.
+   static std::ostream*& ThreadStream();
+
    /// used internally
    static void Output(const std::string& msg);
 };
 
 inline std::ostream*& ConfigureLOGstream::Stream()
 {
+   std::ostream*& pThreadStream(ThreadStream());
+   if(pThreadStream) return pThreadStream;
    static std::ostream *pStream = &(std::cout);
    return pStream;
 }
 
+inline std::ostream*& ConfigureLOGstream::ThreadStream()
+{
+   static thread_local std::ostream *pStream = nullptr;
+   return pStream;
+}
+
 inline void ConfigureLOGstream::Output(const std::string& msg)
 {
    std::ostream *pStream = Stream();
@@ -0,0 +1,544 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "FFTextStream.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TestUtil.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Text used for the line-reading tests.
+static const std::string testText(
+   "first line\n"
+   "\n"
+   "  indented, CR LF line\r\n"
+   "12 34 last line without newline");
+
+/// A short RINEX 3 observation file.
+static const std::string rinexText(
+   "     3.04           OBSERVATION DATA    M                   RINEX VERSION / TYPE\n"
+   "test                test                20200311 120000 UTC PGM / RUN BY / DATE \n"
+   "TEST                                                        MARKER NAME         \n"
+   "obs                 agency                                  OBSERVER / AGENCY   \n"
+   "1                   rcv                 1                   REC # / TYPE / VERS \n"
+   "1                   ant                                     ANT # / TYPE        \n"
+   "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ \n"
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+   "G    3 C1C L1C S1C                                          SYS / # / OBS TYPES \n"
+   "R    2 C1C L1C                                              SYS / # / OBS TYPES \n"
+   "    30.000                                                  INTERVAL            \n"
+   "  2020     3    11    12     0    0.0000000     GPS         TIME OF FIRST OBS   \n"
+   "                                                            END OF HEADER       \n"
+   "> 2020 03 11 12 00  0.0000000  0  2\n"
+   "G01  20000010.12507  20000011.12517  20000012.12527\n"
+   "G07  20000070.12507  20000071.12517  20000072.12527\n"
+   "> 2020 03 11 12 00 30.0000000  0  3\n"
+   "G01  20001010.12517  20001011.12527  20001012.12507\n"
+   "G05  20001050.12517  20001051.12527  20001052.12507\n"
+   "R12  20001120.12517  20001121.12527\n");
+
+/// rinexText in Compact RINEX 3.0 format.
+static const std::string crinex3Text(
+   "3.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE\n"
+   "RNX2CRX ver.4.1.0                       16-Oct-26 00:00     CRINEX PROG / DATE\n"
+   "     3.04           OBSERVATION DATA    M                   RINEX VERSION / TYPE\n"
+   "test                test                20200311 120000 UTC PGM / RUN BY / DATE \n"
+   "TEST                                                        MARKER NAME         \n"
+   "obs                 agency                                  OBSERVER / AGENCY   \n"
+   "1                   rcv                 1                   REC # / TYPE / VERS \n"
+   "1                   ant                                     ANT # / TYPE        \n"
+   "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ \n"
+   "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n"
+   "G    3 C1C L1C S1C                                          SYS / # / OBS TYPES \n"
+   "R    2 C1C L1C                                              SYS / # / OBS TYPES \n"
+   "    30.000                                                  INTERVAL            \n"
+   "  2020     3    11    12     0    0.0000000     GPS         TIME OF FIRST OBS   \n"
+   "                                                            END OF HEADER       \n"
+   "> 2020 03 11 12 00  0.0000000  0  2      G01G07\n"
+   "\n"
+   "3&20000010125 3&20000011125 3&20000012125 071727\n"
+   "3&20000070125 3&20000071125 3&20000072125 071727\n"
+   "                   3              3           5R12\n"
+   "\n"
+   "1000000 1000000 1000000 1 2 0\n"
+   "3&20001050125 3&20001051125 3&20001052125 172707\n"
+   "3&20001120125 3&20001121125 1727\n");
+
+/// A RINEX 2 observation file with an event, a clock offset and
+/// missing data.
+static const std::string rinex2Text(
+   "     2.11           OBSERVATION DATA    M (MIXED)           RINEX VERSION / TYPE\n"
+   "test                test                20200311 120000 UTC PGM / RUN BY / DATE \n"
+   "TEST                                                        MARKER NAME         \n"
+   "     3    C1    L1    S1                                    # / TYPES OF OBSERV \n"
+   "                                                            END OF HEADER       \n"
+   " 20  3 11 12  0  0.0000000  0  3G01G07R12                            0.000123456\n"
+   "  20000010.125 7  20000011.12517        45.250\n"
+   "  20000070.125    20000071.12517        41.000\n"
+   "  20000120.125    20000121.125 1        39.750\n"
+   "                            4  1\n"
+   "event comment                                               COMMENT             \n"
+   " 20  3 11 12  0 30.0000000  0  3G01G05R12                           -0.000123400\n"
+   "  20001010.125 7                        45.500\n"
+   "  20001050.125    20001051.125          40.000\n"
+   "  20001120.125    20001121.125 1        -0.250\n"
+   " 20  3 11 12  1  0.0000000  0  3G01G05R12\n"
+   "  20002010.125 7  20002011.125          45.750\n"
+   "  20002050.125    20002051.125          40.250\n"
+   "  20002120.125    20002121.125 1        -0.750\n");
+
+/// rinex2Text in Compact RINEX 1.0 format.
+static const std::string crinex1Text(
+   "1.0                 COMPACT RINEX FORMAT                    CRINEX VERS   / TYPE\n"
+   "RNX2CRX ver.4.1.0                       16-Oct-26 00:00     CRINEX PROG / DATE\n"
+   "     2.11           OBSERVATION DATA    M (MIXED)           RINEX VERSION / TYPE\n"
+   "test                test                20200311 120000 UTC PGM / RUN BY / DATE \n"
+   "TEST                                                        MARKER NAME         \n"
+   "     3    C1    L1    S1                                    # / TYPES OF OBSERV \n"
+   "                                                            END OF HEADER       \n"
+   "&20  3 11 12  0  0.0000000  0  3G01G07R12\n"
+   "2&123456\n"
+   "3&20000010125 3&20000011125 3&45250  717\n"
+   "3&20000070125 3&20000071125 3&41000   17\n"
+   "3&20000120125 3&20000121125 3&39750    1\n"
+   "&                           4  1\n"
+   "event comment                                               COMMENT             \n"
+   "&20  3 11 12  0 30.0000000  0  3G01G05R12\n"
+   "-246856\n"
+   "3&20001010125  3&45500  7\n"
+   "3&20001050125 3&20001051125 3&40000\n"
+   "3&20001120125 3&20001121125 3&-250    1\n"
+   "              1 &\n"
+   "\n"
+   "1000000 3&20002011125 250\n"
+   "1000000 1000000 250\n"
+   "1000000 1000000 -500\n");
+
+class FFTextStream_T
+{
+public:
+      /// Make sure memory-mapped input reads the same as file input.
+   unsigned openMappedTest();
+      /// Test reading from a caller-supplied buffer.
+   unsigned openBufferTest();
+      /// Make sure an existing reader works unchanged from memory.
+   unsigned readerTest();
+      /// Make sure Compact RINEX 3 is expanded to the original RINEX.
+   unsigned crinex3Test();
+      /// Make sure Compact RINEX 1 is expanded to the original RINEX.
+   unsigned crinex1Test();
+      /** Make sure Compact RINEX 1 made from real data is expanded
+       * to the expected RINEX, byte for byte. */
+   unsigned crinex1FileTest();
+      /// Make sure openCompressed reads uncompressed files as usual.
+   unsigned plainTest();
+      /// Make sure invalid Compact RINEX results in an exception.
+   unsigned crinexErrorTest();
+      /// Read all the lines of strm, up to EOF.
+   void readLines(gnsstk::FFTextStream& strm, std::vector<std::string>& lines,
+                  std::vector<unsigned>& lineNums);
+      /** Split text into lines.
+       * @return the lines of text, without newlines. */
+   std::vector<std::string> splitLines(const std::string& text);
+      /// Write text to a file in the test temp directory.
+   std::string writeTemp(const std::string& name, const std::string& text);
+};
+
+
+void FFTextStream_T ::
+readLines(gnsstk::FFTextStream& strm, std::vector<std::string>& lines,
+          std::vector<unsigned>& lineNums)
+{
+   lines.clear();
+   lineNums.clear();
+   try
+   {
+      while (true)
+      {
+         std::string line;
+         strm.formattedGetLine(line, true);
+         lines.push_back(line);
+         lineNums.push_back(strm.lineNumber);
+      }
+   }
+   catch (gnsstk::EndOfFile&)
+   {
+   }
+}
+
+
+std::vector<std::string> FFTextStream_T ::
+splitLines(const std::string& text)
+{
+   std::vector<std::string> rv;
+   std::string::size_type pos = 0, nl;
+   while ((nl = text.find('\n', pos)) != std::string::npos)
+   {
+      rv.push_back(text.substr(pos, nl - pos));
+      pos = nl + 1;
+   }
+   if (pos < text.size())
+      rv.push_back(text.substr(pos));
+   return rv;
+}
+
+
+std::string FFTextStream_T ::
+writeTemp(const std::string& name, const std::string& text)
+{
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() + name;
+   std::ofstream ofs(fn.c_str(), std::ios::out | std::ios::binary);
+   ofs << text;
+   return fn;
+}
+
+
+unsigned FFTextStream_T ::
+openMappedTest()
+{
+   TUDEF("FFTextStream", "openMapped");
+   std::string fn = writeTemp("FFTextStream_T.txt", testText);
+   std::vector<std::string> expLines, gotLines;
+   std::vector<unsigned> expNums, gotNums;
+   gnsstk::FFTextStream expStrm(fn.c_str());
+   TUASSERTE(bool, false, expStrm.isInMemory());
+   readLines(expStrm, expLines, expNums);
+   TUASSERTE(size_t, 4, expLines.size());
+   TUASSERTE(std::string, "  indented, CR LF line", expLines[2]);
+   gnsstk::FFTextStream uut;
+   TUASSERTE(bool, true, uut.openMapped(fn));
+   TUASSERTE(bool, true, uut.isInMemory());
+   TUASSERTE(bool, true, uut.is_open());
+   TUASSERTE(std::string, fn, uut.filename);
+   readLines(uut, gotLines, gotNums);
+   TUASSERTE(bool, true, expLines == gotLines);
+   TUASSERTE(bool, true, expNums == gotNums);
+   TUASSERTE(bool, true, uut.eof());
+   TUASSERTE(bool, true, uut.fail());
+      // reopening resets to reading the file normally
+   TUCSM("open");
+   uut.open(fn, std::ios::in);
+   TUASSERTE(bool, false, uut.isInMemory());
+   readLines(uut, gotLines, gotNums);
+   TUASSERTE(bool, true, expLines == gotLines);
+   TUCSM("openMapped");
+      // missing files fail the same as open()
+   TUASSERTE(bool, false, uut.openMapped(fn + ".missing"));
+   TUASSERTE(bool, false, uut.isInMemory());
+   TUASSERTE(bool, true, uut.fail());
+      // empty files are fine
+   std::string emptyfn = writeTemp("FFTextStream_T_empty.txt", "");
+   TUASSERTE(bool, true, uut.openMapped(emptyfn));
+   readLines(uut, gotLines, gotNums);
+   TUASSERTE(size_t, 0, gotLines.size());
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+openBufferTest()
+{
+   TUDEF("FFTextStream", "openBuffer");
+   gnsstk::FFTextStream uut;
+   uut.openBuffer(testText.data(), testText.size(), "test buffer");
+   TUASSERTE(bool, true, uut.isInMemory());
+   TUASSERTE(bool, false, uut.is_open());
+   TUASSERTE(bool, true, uut.good());
+   TUASSERTE(std::string, "test buffer", uut.filename);
+   TUCSM("formattedGetLine");
+      // the lines point into the buffer
+   const char *line;
+   std::size_t len;
+   uut.formattedGetLine(line, len);
+   TUASSERTE(const void*, testText.data(), line);
+   TUASSERTE(std::size_t, 10, len);
+   TUASSERTE(unsigned, 1, uut.lineNumber);
+   uut.formattedGetLine(line, len);
+   TUASSERTE(std::size_t, 0, len);
+   uut.formattedGetLine(line, len);
+   TUASSERTE(std::string, "  indented, CR LF line", std::string(line, len));
+      // other stream operations work too
+   std::streampos pos = uut.tellg();
+   int i1 = 0, i2 = 0;
+   uut >> i1 >> i2;
+   TUASSERTE(int, 12, i1);
+   TUASSERTE(int, 34, i2);
+   uut.seekg(pos);
+   TUASSERTE(std::streampos, pos, uut.tellg());
+   uut.formattedGetLine(line, len);
+   TUASSERTE(std::string, "12 34 last line without newline",
+             std::string(line, len));
+   TUASSERTE(bool, true, uut.eof());
+   TUASSERTE(bool, false, uut.fail());
+   TUTHROW(uut.formattedGetLine(line, len));
+   TUASSERTE(bool, true, uut.fail());
+      // EOF is reported the same as for files
+   uut.clear();
+   uut.seekg(0);
+   std::vector<std::string> lines;
+   std::vector<unsigned> lineNums;
+   readLines(uut, lines, lineNums);
+   TUASSERTE(size_t, 4, lines.size());
+      // non-text is rejected
+   std::string bad("ok\nnot\001ok\n");
+   uut.openBuffer(bad.data(), bad.size());
+   std::string sline;
+   TUCATCH(uut.formattedGetLine(sline));
+   TUASSERTE(std::string, "ok", sline);
+   try
+   {
+      uut.formattedGetLine(sline);
+      TUFAIL("Expected FFStreamError");
+   }
+   catch (gnsstk::FFStreamError& e)
+   {
+      TUPASS("FFStreamError");
+   }
+      // the line-pointer interface also works when reading files
+   std::string fn = writeTemp("FFTextStream_T.txt", testText);
+   uut.open(fn.c_str(), std::ios::in);
+   TUASSERTE(bool, false, uut.isInMemory());
+   uut.formattedGetLine(line, len);
+   TUASSERTE(std::string, "first line", std::string(line, len));
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+readerTest()
+{
+   TUDEF("FFTextStream", "openMapped");
+   std::string fn = writeTemp("FFTextStream_T.rnx", rinexText);
+   gnsstk::Rinex3ObsStream expStrm(fn.c_str());
+   gnsstk::Rinex3ObsStream mapStrm, bufStrm;
+   TUASSERTE(bool, true, mapStrm.openMapped(fn));
+   bufStrm.openBuffer(rinexText.data(), rinexText.size());
+   gnsstk::Rinex3ObsHeader expHdr, mapHdr, bufHdr;
+   expStrm >> expHdr;
+   mapStrm >> mapHdr;
+   bufStrm >> bufHdr;
+   TUASSERTE(bool, true, expHdr.isValid());
+   TUASSERTE(bool, true, mapHdr.isValid());
+   TUASSERTE(bool, true, bufHdr.isValid());
+   TUASSERTE(bool, true, expHdr.valid == mapHdr.valid);
+   TUASSERTE(bool, true, expHdr.valid == bufHdr.valid);
+   gnsstk::Rinex3ObsData expRod, mapRod, bufRod;
+   unsigned epochs = 0;
+   while (expStrm >> expRod)
+   {
+      epochs++;
+      mapStrm >> mapRod;
+      bufStrm >> bufRod;
+      TUASSERTE(bool, true, static_cast<bool>(mapStrm));
+      TUASSERTE(bool, true, static_cast<bool>(bufStrm));
+      TUASSERTE(gnsstk::CommonTime, expRod.time, mapRod.time);
+      TUASSERTE(gnsstk::CommonTime, expRod.time, bufRod.time);
+      TUASSERTE(size_t, expRod.obs.size(), mapRod.obs.size());
+      TUASSERTE(size_t, expRod.obs.size(), bufRod.obs.size());
+      TUASSERTE(std::string, expRod.obs.rbegin()->second[1].asString(),
+                mapRod.obs.rbegin()->second[1].asString());
+      TUASSERTE(std::string, expRod.obs.rbegin()->second[1].asString(),
+                bufRod.obs.rbegin()->second[1].asString());
+   }
+   TUASSERTE(unsigned, 2, epochs);
+   TUASSERTE(bool, false, static_cast<bool>(mapStrm >> mapRod));
+   TUASSERTE(bool, false, static_cast<bool>(bufStrm >> bufRod));
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+crinex3Test()
+{
+   TUDEF("FFTextStream", "openCompressed");
+   std::string fn = writeTemp("FFTextStream_T.crx", crinex3Text);
+   std::vector<std::string> expLines(splitLines(rinexText)), gotLines;
+   std::vector<unsigned> gotNums;
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true, strm.openCompressed(fn));
+   readLines(strm, gotLines, gotNums);
+   TUASSERTE(size_t, expLines.size(), gotLines.size());
+   for (size_t i = 0; (i < expLines.size()) && (i < gotLines.size()); i++)
+   {
+      TUASSERTE(std::string, expLines[i], gotLines[i]);
+      TUASSERTE(unsigned, i+1, gotNums[i]);
+   }
+      // read the same data through an existing reader
+   gnsstk::Rinex3ObsStream expStrm, gotStrm;
+   expStrm.openBuffer(rinexText.data(), rinexText.size());
+   TUASSERTE(bool, true, gotStrm.openCompressed(fn));
+   gnsstk::Rinex3ObsHeader expHdr, gotHdr;
+   expStrm >> expHdr;
+   gotStrm >> gotHdr;
+   TUASSERTE(bool, true, gotHdr.isValid());
+   gnsstk::Rinex3ObsData expRod, gotRod;
+   unsigned epochs = 0;
+   while (expStrm >> expRod)
+   {
+      epochs++;
+      gotStrm >> gotRod;
+      TUASSERTE(bool, true, static_cast<bool>(gotStrm));
+      TUASSERTE(gnsstk::CommonTime, expRod.time, gotRod.time);
+      TUASSERTE(size_t, expRod.obs.size(), gotRod.obs.size());
+      TUASSERTE(std::string, expRod.obs.rbegin()->second[1].asString(),
+                gotRod.obs.rbegin()->second[1].asString());
+   }
+   TUASSERTE(unsigned, 2, epochs);
+   TUASSERTE(bool, false, static_cast<bool>(gotStrm >> gotRod));
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+crinex1Test()
+{
+   TUDEF("FFTextStream", "openCompressed");
+   std::string fn = writeTemp("FFTextStream_T.15d", crinex1Text);
+   std::vector<std::string> expLines(splitLines(rinex2Text)), gotLines;
+   std::vector<unsigned> gotNums;
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true, strm.openCompressed(fn));
+   readLines(strm, gotLines, gotNums);
+   TUASSERTE(size_t, expLines.size(), gotLines.size());
+   for (size_t i = 0; (i < expLines.size()) && (i < gotLines.size()); i++)
+   {
+      TUASSERTE(std::string, expLines[i], gotLines[i]);
+   }
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+crinex1FileTest()
+{
+   TUDEF("FFTextStream", "openCompressed");
+   std::string dp = gnsstk::getPathData() + gnsstk::getFileSep();
+   std::ifstream ifs((dp + "test_output_crinex1_bahr1620.04o").c_str(),
+                     std::ios::in | std::ios::binary);
+   std::string expText((std::istreambuf_iterator<char>(ifs)),
+                       std::istreambuf_iterator<char>());
+   TUASSERT(!expText.empty());
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true,
+             strm.openCompressed(dp + "test_input_crinex1_bahr1620.04d"));
+   std::string gotText((std::istreambuf_iterator<char>(strm)),
+                       std::istreambuf_iterator<char>());
+   TUASSERTE(size_t, expText.size(), gotText.size());
+   if (expText.size() == gotText.size())
+   {
+         // the offset of the first difference, if any
+      TUASSERTE(size_t, expText.size(),
+                std::mismatch(expText.begin(), expText.end(),
+                              gotText.begin()).first - expText.begin());
+   }
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+plainTest()
+{
+   TUDEF("FFTextStream", "openCompressed");
+   std::string fn = writeTemp("FFTextStream_T.rnx", rinexText);
+   std::vector<std::string> expLines(splitLines(rinexText)), gotLines;
+   std::vector<unsigned> gotNums;
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true, strm.openCompressed(fn));
+   TUASSERTE(bool, false, strm.isInMemory());
+   readLines(strm, gotLines, gotNums);
+   TUASSERTE(size_t, expLines.size(), gotLines.size());
+   for (size_t i = 0; (i < expLines.size()) && (i < gotLines.size()); i++)
+   {
+      TUASSERTE(std::string, expLines[i], gotLines[i]);
+   }
+   TUASSERTE(bool, false,
+             strm.openCompressed(gnsstk::getPathTestTemp() +
+                                 gnsstk::getFileSep() + "no-such-file"));
+   TURETURN();
+}
+
+
+unsigned FFTextStream_T ::
+crinexErrorTest()
+{
+   TUDEF("FFTextStream", "openCompressed");
+      // a difference for a satellite with no data arc
+   std::string text(crinex3Text);
+   std::string::size_type pos = text.find("3&20001050125");
+   text.replace(pos, 2, "12");
+   std::string fn = writeTemp("FFTextStream_T.bad.crx", text);
+   std::vector<std::string> gotLines;
+   std::vector<unsigned> gotNums;
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true, strm.openCompressed(fn));
+   try
+   {
+      readLines(strm, gotLines, gotNums);
+      TUFAIL("Expected an exception for invalid Compact RINEX");
+   }
+   catch (gnsstk::FFStreamError& e)
+   {
+      TUPASS("invalid Compact RINEX");
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   FFTextStream_T testClass;
+
+   errorTotal += testClass.openMappedTest();
+   errorTotal += testClass.openBufferTest();
+   errorTotal += testClass.readerTest();
+   errorTotal += testClass.crinex3Test();
+   errorTotal += testClass.crinex1Test();
+   errorTotal += testClass.crinex1FileTest();
+   errorTotal += testClass.plainTest();
+   errorTotal += testClass.crinexErrorTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
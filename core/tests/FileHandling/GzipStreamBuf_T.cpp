@@ -0,0 +1,179 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+
+#include "FFTextStream.hpp"
+#include "GzipStreamBuf.hpp"
+#include "TestUtil.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+using namespace std;
+
+/// Exit status ctest reports as a skipped test (SKIP_RETURN_CODE).
+static const int skipReturnCode = 77;
+
+class GzipStreamBuf_T
+{
+public:
+   GzipStreamBuf_T();
+      /// Make sure gzip-compressed Compact RINEX reads as the RINEX.
+   unsigned gzipTest();
+      /// Make sure truncated gzip data is an error, not EOF.
+   unsigned truncatedTest();
+      /// Make sure openCompressed fails cleanly without zlib.
+   unsigned unavailableTest();
+      /// Read a whole file, as is.
+   static std::string readFile(const std::string& fn);
+
+      /// Path to the test data, with a trailing separator.
+   std::string dp;
+};
+
+
+GzipStreamBuf_T ::
+GzipStreamBuf_T()
+      : dp(gnsstk::getPathData() + gnsstk::getFileSep())
+{
+}
+
+
+std::string GzipStreamBuf_T ::
+readFile(const std::string& fn)
+{
+   std::ifstream ifs(fn.c_str(), std::ios::in | std::ios::binary);
+   return std::string((std::istreambuf_iterator<char>(ifs)),
+                      std::istreambuf_iterator<char>());
+}
+
+
+unsigned GzipStreamBuf_T ::
+gzipTest()
+{
+   TUDEF("GzipStreamBuf", "underflow");
+   std::string expText(readFile(dp + "test_output_crinex1_bahr1620.04o"));
+   TUASSERT(!expText.empty());
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true,
+             strm.openCompressed(dp + "test_input_crinex1_bahr1620.04d.gz"));
+   std::string gotText((std::istreambuf_iterator<char>(strm)),
+                       std::istreambuf_iterator<char>());
+   TUASSERTE(size_t, expText.size(), gotText.size());
+   if (expText.size() == gotText.size())
+   {
+         // the offset of the first difference, if any
+      TUASSERTE(size_t, expText.size(),
+                std::mismatch(expText.begin(), expText.end(),
+                              gotText.begin()).first - expText.begin());
+   }
+   TURETURN();
+}
+
+
+unsigned GzipStreamBuf_T ::
+truncatedTest()
+{
+   TUDEF("GzipStreamBuf", "underflow");
+   std::string gz(readFile(dp + "test_input_crinex1_bahr1620.04d.gz"));
+   TUASSERT(!gz.empty());
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+      "GzipStreamBuf_T.trunc.gz";
+   {
+      std::ofstream ofs(fn.c_str(), std::ios::out | std::ios::binary);
+      ofs << gz.substr(0, gz.size() / 2);
+   }
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, true, strm.openCompressed(fn));
+   try
+   {
+      std::string line;
+      while (true)
+         strm.formattedGetLine(line, true);
+   }
+   catch (gnsstk::EndOfFile&)
+   {
+      TUFAIL("Expected an exception for truncated gzip data, got EOF");
+   }
+   catch (gnsstk::FFStreamError& e)
+   {
+      TUPASS("truncated gzip data");
+   }
+   TURETURN();
+}
+
+
+unsigned GzipStreamBuf_T ::
+unavailableTest()
+{
+   TUDEF("GzipStreamBuf", "available");
+   gnsstk::FFTextStream strm;
+   TUASSERTE(bool, false,
+             strm.openCompressed(dp + "test_input_crinex1_bahr1620.04d.gz"));
+   TUASSERTE(bool, true, strm.fail());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   GzipStreamBuf_T testClass;
+
+   if (!gnsstk::GzipStreamBuf::available())
+   {
+      errorTotal += testClass.unavailableTest();
+      if (errorTotal == 0)
+      {
+         cout << "GzipStreamBuf_T skipped: built without zlib" << endl;
+         return skipReturnCode;
+      }
+   }
+   else
+   {
+      errorTotal += testClass.gzipTest();
+      errorTotal += testClass.truncatedTest();
+   }
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
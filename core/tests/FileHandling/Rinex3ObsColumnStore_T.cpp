@@ -0,0 +1,352 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "Rinex3ObsColumnStore.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+class Rinex3ObsColumnStore_T
+{
+public:
+      /// Test adding and looking up observation types.
+   unsigned obsTypeTest();
+      /// Test storing and retrieving data in the parallel layout.
+   unsigned parallelTest();
+      /// Test storing and retrieving data using a header.
+   unsigned headerTest();
+      /// Test the epoch and satellite views.
+   unsigned viewTest();
+      /// Make some test data.
+   void fillData(gnsstk::Rinex3ObsData& rod, unsigned epoch);
+};
+
+
+void Rinex3ObsColumnStore_T ::
+fillData(gnsstk::Rinex3ObsData& rod, unsigned epoch)
+{
+   rod.time = gnsstk::CivilTime(2020,3,11,12,0,30.0*epoch,
+                                gnsstk::TimeSystem::GPS);
+   rod.epochFlag = (epoch == 1 ? 1 : 0);
+   rod.clockOffset = 1e-6 * epoch;
+   rod.obs.clear();
+      // G01 in every epoch, G05 in even epochs and R12 in odd epochs
+   std::vector<gnsstk::RinexSatID> sats;
+   sats.push_back(gnsstk::RinexSatID(1, gnsstk::SatelliteSystem::GPS));
+   if (epoch % 2)
+      sats.push_back(gnsstk::RinexSatID(12,gnsstk::SatelliteSystem::Glonass));
+   else
+      sats.push_back(gnsstk::RinexSatID(5, gnsstk::SatelliteSystem::GPS));
+   for (unsigned s = 0; s < sats.size(); s++)
+   {
+      std::vector<gnsstk::RinexDatum>& obs(rod.obs[sats[s]]);
+      obs.resize(3);
+      for (unsigned i = 0; i < obs.size(); i++)
+      {
+         obs[i].data = 2e7 + epoch * 1000 + sats[s].id * 10 + i + 0.125;
+         obs[i].lli = (epoch + i) % 8;
+         obs[i].ssi = (sats[s].id + i) % 10;
+         obs[i].dataBlank = (i == 2) && (epoch == 2);
+         obs[i].lliBlank = (i == 1);
+         obs[i].ssiBlank = (s == 1);
+      }
+   }
+   rod.numSVs = rod.obs.size();
+}
+
+
+unsigned Rinex3ObsColumnStore_T ::
+obsTypeTest()
+{
+   TUDEF("Rinex3ObsColumnStore", "addObsType");
+   gnsstk::Rinex3ObsColumnStore uut;
+   TUASSERTE(size_t, 0, uut.numObsTypes());
+   TUASSERTE(size_t, 0, uut.addObsType("GC1C"));
+   TUASSERTE(size_t, 1, uut.addObsType("GL1C"));
+   TUTHROW(uut.addObsType("GC1C"));
+   TUASSERTE(size_t, 2, uut.numObsTypes());
+   TUCSM("getObsIndex");
+   TUASSERTE(int, 0, uut.getObsIndex("GC1C"));
+   TUASSERTE(int, 1, uut.getObsIndex("GL1C"));
+   TUASSERTE(int, -1, uut.getObsIndex("RC1C"));
+   TUCSM("Rinex3ObsColumnStore");
+   std::vector<std::string> types;
+   types.push_back("GC1C");
+   types.push_back("GC1C");
+   TUTHROW(gnsstk::Rinex3ObsColumnStore dup(types));
+   types[1] = "GL1C";
+   gnsstk::Rinex3ObsColumnStore uut2(types);
+   TUASSERTE(bool, true, types == uut2.getObsTypes());
+      // columns added after data get default values
+   TUCSM("addObsType");
+   uut2.addEpoch(gnsstk::CommonTime::BEGINNING_OF_TIME, 0, 0);
+   size_t row = uut2.addRow(gnsstk::RinexSatID(3,gnsstk::SatelliteSystem::GPS));
+   gnsstk::RinexDatum rd;
+   rd.data = 12.5;
+   rd.lli = 1;
+   uut2.setDatum(row, 0, rd);
+   TUASSERTE(size_t, 2, uut2.addObsType("GD1C"));
+   TUASSERTE(size_t, 1, uut2.getData(2).size());
+   TUASSERTE(double, 0, uut2.getData(row, 2));
+   TUASSERTE(double, 12.5, uut2.getData(row, 0));
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsColumnStore_T ::
+parallelTest()
+{
+   TUDEF("Rinex3ObsColumnStore", "addEpoch");
+   std::vector<std::string> types;
+   types.push_back("GC1C");
+   types.push_back("GL1C");
+   types.push_back("GS1C");
+   gnsstk::Rinex3ObsColumnStore uut(types);
+   std::vector<gnsstk::Rinex3ObsData> expected(4);
+   for (unsigned e = 0; e < expected.size(); e++)
+   {
+      fillData(expected[e], e);
+      TUCATCH(uut.addEpoch(expected[e]));
+   }
+   TUASSERTE(size_t, 4, uut.numEpochs());
+   TUASSERTE(size_t, 8, uut.numRows());
+   TUASSERTE(size_t, 3, uut.getSats().size());
+   TUASSERTE(size_t, 8, uut.getData(1).size());
+   TUASSERTE(size_t, 8, uut.getFlags(1).size());
+   TUCSM("getEpoch");
+   for (unsigned e = 0; e < expected.size(); e++)
+   {
+      gnsstk::Rinex3ObsData rod;
+      uut.getEpoch(e, rod);
+      TUASSERTE(gnsstk::CommonTime, expected[e].time, rod.time);
+      TUASSERTE(short, expected[e].epochFlag, rod.epochFlag);
+      TUASSERTE(double, expected[e].clockOffset, rod.clockOffset);
+      TUASSERTE(short, expected[e].numSVs, rod.numSVs);
+      TUASSERTE(size_t, expected[e].obs.size(), rod.obs.size());
+      gnsstk::Rinex3ObsData::DataMap::const_iterator ei, gi;
+      for (ei = expected[e].obs.begin(), gi = rod.obs.begin();
+           (ei != expected[e].obs.end()) && (gi != rod.obs.end()); ++ei, ++gi)
+      {
+         TUASSERTE(gnsstk::RinexSatID, ei->first, gi->first);
+         TUASSERTE(size_t, ei->second.size(), gi->second.size());
+         for (unsigned i = 0; i < ei->second.size(); i++)
+         {
+            const gnsstk::RinexDatum& exp(ei->second[i]);
+            const gnsstk::RinexDatum& got(gi->second[i]);
+            TUASSERTFE(exp.data, got.data);
+            TUASSERTE(short, exp.lli, got.lli);
+            TUASSERTE(short, exp.ssi, got.ssi);
+            TUASSERTE(bool, exp.dataBlank, got.dataBlank);
+            TUASSERTE(bool, exp.lliBlank, got.lliBlank);
+            TUASSERTE(bool, exp.ssiBlank, got.ssiBlank);
+         }
+      }
+   }
+      // bad data shouldn't be partially stored
+   TUCSM("addEpoch");
+   gnsstk::Rinex3ObsData bad;
+   fillData(bad, 4);
+   bad.obs.rbegin()->second[1].ssi = 16;
+   TUTHROW(uut.addEpoch(bad));
+   fillData(bad, 4);
+   bad.obs.rbegin()->second[1].lli = -1;
+   TUTHROW(uut.addEpoch(bad));
+   fillData(bad, 4);
+   bad.obs.rbegin()->second.resize(4);
+   TUTHROW(uut.addEpoch(bad));
+   TUASSERTE(size_t, 4, uut.numEpochs());
+   TUASSERTE(size_t, 8, uut.numRows());
+      // short observation vectors leave defaults
+   fillData(bad, 4);
+   bad.obs.begin()->second.resize(1);
+   TUCATCH(uut.addEpoch(bad));
+   TUASSERTE(size_t, 5, uut.numEpochs());
+   TUASSERTFE(bad.obs.begin()->second[0].data, uut.getData(8, 0));
+   TUASSERTE(double, 0, uut.getData(8, 2));
+   TUASSERTE(uint16_t, 0, uut.getFlags(2)[8]);
+   TUCSM("clear");
+   uut.clear();
+   TUASSERTE(size_t, 0, uut.numEpochs());
+   TUASSERTE(size_t, 0, uut.numRows());
+   TUASSERTE(size_t, 0, uut.getSats().size());
+   TUASSERTE(size_t, 3, uut.numObsTypes());
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsColumnStore_T ::
+headerTest()
+{
+   TUDEF("Rinex3ObsColumnStore", "addEpoch");
+   gnsstk::Rinex3ObsHeader hdr;
+   hdr.version = 3.04;
+   hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GC1C", hdr.version));
+   hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GL1C", hdr.version));
+   hdr.mapObsTypes["G"].push_back(gnsstk::RinexObsID("GS1C", hdr.version));
+   hdr.mapObsTypes["R"].push_back(gnsstk::RinexObsID("RC1C", hdr.version));
+   hdr.mapObsTypes["R"].push_back(gnsstk::RinexObsID("RL1C", hdr.version));
+   hdr.mapObsTypes["R"].push_back(gnsstk::RinexObsID("RS1C", hdr.version));
+      // store only a subset of the header's types, in a different order
+   std::vector<std::string> types;
+   types.push_back("RC1C");
+   types.push_back("GL1C");
+   types.push_back("GC1C");
+   gnsstk::Rinex3ObsColumnStore uut(types);
+   std::vector<gnsstk::Rinex3ObsData> expected(4);
+   for (unsigned e = 0; e < expected.size(); e++)
+   {
+      fillData(expected[e], e);
+      TUCATCH(uut.addEpoch(expected[e], hdr));
+   }
+   TUASSERTE(size_t, 4, uut.numEpochs());
+   TUASSERTE(size_t, 8, uut.numRows());
+      // check the columns directly, G01 is the first row of epoch 0
+   const gnsstk::RinexSatID g01(1, gnsstk::SatelliteSystem::GPS);
+   const std::vector<gnsstk::RinexDatum>& g01e0(expected[0].obs[g01]);
+   TUASSERTE(gnsstk::RinexSatID, g01, uut.getRowSat(0));
+   TUASSERTFE(g01e0[0].data, uut.getData(0, 2));
+   TUASSERTFE(g01e0[1].data, uut.getData(0, 1));
+   TUASSERTE(double, 0, uut.getData(0, 0));
+   TUCSM("getEpoch");
+   for (unsigned e = 0; e < expected.size(); e++)
+   {
+      gnsstk::Rinex3ObsData rod;
+      uut.getEpoch(e, hdr, rod);
+      TUASSERTE(gnsstk::CommonTime, expected[e].time, rod.time);
+      TUASSERTE(size_t, expected[e].obs.size(), rod.obs.size());
+      gnsstk::Rinex3ObsData::DataMap::const_iterator ei, gi;
+      for (ei = expected[e].obs.begin(), gi = rod.obs.begin();
+           (ei != expected[e].obs.end()) && (gi != rod.obs.end()); ++ei, ++gi)
+      {
+         TUASSERTE(gnsstk::RinexSatID, ei->first, gi->first);
+         TUASSERTE(size_t, 3, gi->second.size());
+         bool isGPS = (ei->first.system == gnsstk::SatelliteSystem::GPS);
+            // GPS C1C and L1C and GLONASS C1C are stored
+         TUASSERTFE(ei->second[0].data, gi->second[0].data);
+         TUASSERTE(short, ei->second[0].ssi, gi->second[0].ssi);
+         TUASSERTFE((isGPS ? ei->second[1].data : 0), gi->second[1].data);
+         TUASSERTE(bool, (isGPS ? ei->second[1].lliBlank : false),
+                   gi->second[1].lliBlank);
+         TUASSERTE(double, 0, gi->second[2].data);
+      }
+   }
+      // a system missing from the header isn't output
+   hdr.mapObsTypes.erase("R");
+   gnsstk::Rinex3ObsData rod;
+   uut.getEpoch(1, hdr, rod);
+   TUASSERTE(size_t, 1, rod.obs.size());
+   TUASSERTE(short, 1, rod.numSVs);
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsColumnStore_T ::
+viewTest()
+{
+   TUDEF("Rinex3ObsColumnStore", "getEpochView");
+   std::vector<std::string> types;
+   types.push_back("GC1C");
+   types.push_back("GL1C");
+   types.push_back("GS1C");
+   gnsstk::Rinex3ObsColumnStore uut(types);
+   std::vector<gnsstk::Rinex3ObsData> expected(4);
+   for (unsigned e = 0; e < expected.size(); e++)
+   {
+      fillData(expected[e], e);
+      uut.addEpoch(expected[e]);
+   }
+   for (unsigned e = 0; e < expected.size(); e++)
+   {
+      gnsstk::Rinex3ObsColumnStore::EpochView ev(uut.getEpochView(e));
+      TUASSERTE(size_t, e, ev.getEpoch());
+      TUASSERTE(size_t, 2, ev.size());
+      TUASSERTE(gnsstk::CommonTime, expected[e].time, ev.getTime());
+      TUASSERTE(short, expected[e].epochFlag, ev.getEpochFlag());
+      TUASSERTE(double, expected[e].clockOffset, ev.getClockOffset());
+      unsigned i = 0;
+      gnsstk::Rinex3ObsData::DataMap::const_iterator ei;
+      for (ei = expected[e].obs.begin(); ei != expected[e].obs.end(); ++ei)
+      {
+         TUASSERTE(gnsstk::RinexSatID, ei->first, ev.getSat(i));
+         TUASSERTE(size_t, e, uut.getRowEpoch(ev.getRow(i)));
+         TUASSERTFE(ei->second[1].data, ev.getData(i, 1));
+         TUASSERTE(short, ei->second[2].lli, ev.getDatum(i, 2).lli);
+         i++;
+      }
+   }
+   TUCSM("getSatView");
+   const gnsstk::RinexSatID g01(1, gnsstk::SatelliteSystem::GPS);
+   const gnsstk::RinexSatID g05(5, gnsstk::SatelliteSystem::GPS);
+   const gnsstk::RinexSatID g07(7, gnsstk::SatelliteSystem::GPS);
+   gnsstk::Rinex3ObsColumnStore::SatView sv(uut.getSatView(g01));
+   TUASSERTE(gnsstk::RinexSatID, g01, sv.getSat());
+   TUASSERTE(size_t, 4, sv.size());
+   for (unsigned i = 0; i < sv.size(); i++)
+   {
+      TUASSERTE(size_t, i, sv.getEpoch(i));
+      TUASSERTE(gnsstk::CommonTime, expected[i].time, sv.getTime(i));
+      TUASSERTFE(expected[i].obs[g01][0].data, sv.getData(i, 0));
+      TUASSERTE(short, expected[i].obs[g01][0].ssi, sv.getDatum(i, 0).ssi);
+   }
+   sv = uut.getSatView(g05);
+   TUASSERTE(size_t, 2, sv.size());
+   TUASSERTE(size_t, 0, sv.getEpoch(0));
+   TUASSERTE(size_t, 2, sv.getEpoch(1));
+   TUASSERTFE(expected[2].obs[g05][2].data, sv.getData(1, 2));
+   TUASSERTE(bool, true, sv.getDatum(1, 2).dataBlank);
+   sv = uut.getSatView(g07);
+   TUASSERTE(size_t, 0, sv.size());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Rinex3ObsColumnStore_T testClass;
+
+   errorTotal += testClass.obsTypeTest();
+   errorTotal += testClass.parallelTest();
+   errorTotal += testClass.headerTest();
+   errorTotal += testClass.viewTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -66,6 +66,9 @@ public:
    unsigned ionoDelayTest();
       /// Make sure reusing a stream object doesn't break.
    unsigned reopenTest();
+      /** Make sure data at the end of a line with its trailing
+       * blanks removed are decoded as blanks. */
+   unsigned shortLineTest();
       /// generic filling of generic data.
    void setObs(gnsstk::TestUtil& testFramework, const std::string& system,
                gnsstk::Rinex3ObsHeader& hdr, gnsstk::Rinex3ObsData& rod);
@@ -624,6 +627,79 @@ reopenTest()
 }
 
 
+unsigned Rinex3ObsOther_T ::
+shortLineTest()
+{
+   TUDEF("RinexDatum", "fromString");
+   const std::string field("  23619095.450 5");
+   for (std::string::size_type len = 0; len <= 16; len++)
+   {
+      std::string padded(field.substr(0, len) + std::string(16-len, ' '));
+      gnsstk::RinexDatum exp(padded), got;
+      got.fromString(field.data(), len);
+      TUASSERTE(double, exp.data, got.data);
+      TUASSERTE(bool, exp.dataBlank, got.dataBlank);
+      TUASSERTE(short, exp.lli, got.lli);
+      TUASSERTE(bool, exp.lliBlank, got.lliBlank);
+      TUASSERTE(short, exp.ssi, got.ssi);
+      TUASSERTE(bool, exp.ssiBlank, got.ssiBlank);
+   }
+
+   TUCSM("reallyGetRecord");
+   const std::string text =
+      "     3.04           OBSERVATION DATA    G                   "
+      "RINEX VERSION / TYPE\n"
+      "test                test                20200311 120000 UTC "
+      "PGM / RUN BY / DATE\n"
+      "TEST                                                        "
+      "MARKER NAME\n"
+      "obs                 agency                                  "
+      "OBSERVER / AGENCY\n"
+      "1                   rcv                 1                   "
+      "REC # / TYPE / VERS\n"
+      "1                   ant                                     "
+      "ANT # / TYPE\n"
+      "        0.0000        0.0000        0.0000                  "
+      "APPROX POSITION XYZ\n"
+      "        0.0000        0.0000        0.0000                  "
+      "ANTENNA: DELTA H/E/N\n"
+      "G    3 C1C L1C S1C                                          "
+      "SYS / # / OBS TYPES\n"
+      "  2020     3    11     0     0    0.0000000     GPS         "
+      "TIME OF FIRST OBS\n"
+      "                                                            "
+      "END OF HEADER\n"
+      "> 2020 03 11 00 00  0.0000000  0  3\n"
+      "G01  20000000.000 7  10000000.000 7        30.000 7\n"
+      "G02  21000000.000    10500000.0\n"
+      "G03\n";
+   gnsstk::Rinex3ObsStream strm;
+   strm.openBuffer(text.data(), text.size());
+   gnsstk::Rinex3ObsData rod;
+   TUCATCH(strm >> rod);
+   TUASSERTE(int, 3, rod.numSVs);
+   const std::vector<gnsstk::RinexDatum>& g01(rod.obs[gnsstk::RinexSatID("G01")]);
+   const std::vector<gnsstk::RinexDatum>& g02(rod.obs[gnsstk::RinexSatID("G02")]);
+   const std::vector<gnsstk::RinexDatum>& g03(rod.obs[gnsstk::RinexSatID("G03")]);
+   TUASSERTE(size_t, 3, g01.size());
+   TUASSERTE(double, 30.0, g01[2].data);
+   TUASSERTE(short, 7, g01[2].ssi);
+   TUASSERTE(size_t, 3, g02.size());
+   TUASSERTE(double, 21000000.0, g02[0].data);
+   TUASSERTE(bool, true, g02[0].lliBlank);
+   TUASSERTE(double, 10500000.0, g02[1].data);
+   TUASSERTE(bool, true, g02[1].ssiBlank);
+   TUASSERTE(bool, true, g02[2].dataBlank);
+   TUASSERTE(size_t, 3, g03.size());
+   for (const auto& datum : g03)
+   {
+      TUASSERTE(bool, true, datum.dataBlank);
+      TUASSERTE(double, 0.0, datum.data);
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -634,6 +710,7 @@ int main()
    errorTotal += testClass.ionoDelayTest();
    errorTotal += testClass.obsIDVersionTest();
    errorTotal += testClass.reopenTest();
+   errorTotal += testClass.shortLineTest();
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
    return errorTotal;
 }
@@ -36,18 +36,244 @@
 //
 //==============================================================================
 
+#include "TropModel.hpp"
+#include "GlobalTropModel.hpp"
+#include "NeillTropModel.hpp"
+#include "SaasTropModel.hpp"
+#include "GCATTropModel.hpp"
+#include "MOPSTropModel.hpp"
+#include "SimpleTropModel.hpp"
+#include "CivilTime.hpp"
 #include "TestUtil.hpp"
+#include <cmath>
 #include <iostream>
+#include <memory>
+
+using namespace gnsstk;
+using namespace std;
 
 class TropModel_T
 {
-        public:
-		TropModel_T(){}// Default Constructor, set the precision value
-		~TropModel_T() {} // Default Desructor
+public:
+   TropModel_T();
+      /// Compare batchCorrection(elevation) with correction(elevation).
+   unsigned batchElevationTest();
+      /// Compare batchCorrection(RX,SV,tt) with correction(RX,SV,tt).
+   unsigned batchPositionTest();
+      /// Check the GlobalTropModel coefficient cache.
+   unsigned coefficientCacheTest();
+
+      /// Create each model under test, set up for rx and when.
+   void makeModels(vector<shared_ptr<TropModel> >& models);
+      /// Count the entries of a and b that differ by more than 1e-12.
+   static unsigned countDiffs(const vector<double>& a,
+                              const vector<double>& b);
+
+   Position rx;
+   CommonTime when;
+      /// Satellites spread over the sky, including below the horizon.
+   vector<Position> svs;
 };
 
 
-int main() //Main function to initialize and run all tests above
+TropModel_T ::
+TropModel_T()
+      : rx(30.38, -97.73, 250.0, Position::Geodetic),
+        when(CivilTime(2022,6,15,12,0,0.0,TimeSystem::GPS))
+{
+   Position rxECEF(rx);
+   rxECEF.transformTo(Position::Cartesian);
+   Triple up(rxECEF.X(), rxECEF.Y(), rxECEF.Z());
+   up = up.unitVector();
+   Triple east(-rxECEF.Y(), rxECEF.X(), 0.0);
+   east = east.unitVector();
+   Triple north = up.cross(east);
+   const double range = 2.2e7;
+   for (double az = 0; az < 360; az += 37)
+   {
+      for (double el = -10; el <= 90; el += 2.5)
+      {
+         double ce = ::cos(el*DEG_TO_RAD), se = ::sin(el*DEG_TO_RAD);
+         double ca = ::cos(az*DEG_TO_RAD), sa = ::sin(az*DEG_TO_RAD);
+         svs.push_back(Position(rxECEF.X() + range*(ce*ca*north[0] +
+                                                    ce*sa*east[0] + se*up[0]),
+                                rxECEF.Y() + range*(ce*ca*north[1] +
+                                                    ce*sa*east[1] + se*up[1]),
+                                rxECEF.Z() + range*(ce*ca*north[2] +
+                                                    ce*sa*east[2] + se*up[2])));
+      }
+   }
+}
+
+
+void TropModel_T ::
+makeModels(vector<shared_ptr<TropModel> >& models)
+{
+   models.clear();
+   models.push_back(make_shared<GlobalTropModel>(rx, when));
+   models.push_back(make_shared<NeillTropModel>(rx, when));
+   shared_ptr<SaasTropModel> saas = make_shared<SaasTropModel>();
+   saas->setWeather(20.0, 1013.0, 50.0);
+   models.push_back(saas);
+   models.push_back(make_shared<GCATTropModel>(rx.getAltitude()));
+   models.push_back(make_shared<MOPSTropModel>(rx, when));
+   models.push_back(make_shared<SimpleTropModel>(20.0, 1013.0, 50.0));
+      // set up any receiver and time state
+   for (auto& model : models)
+      model->correction(rx, svs.back(), when);
+}
+
+
+unsigned TropModel_T ::
+countDiffs(const vector<double>& a, const vector<double>& b)
+{
+   if (a.size() != b.size())
+      return a.size() + b.size();
+   unsigned rv = 0;
+   for (unsigned i = 0; i < a.size(); i++)
+   {
+      if (std::abs(a[i] - b[i]) > 1e-12)
+         rv++;
+   }
+   return rv;
+}
+
+
+unsigned TropModel_T ::
+batchElevationTest()
 {
-	return 0; //Return the total number of errors
+   TUDEF("TropModel", "batchCorrection(elevation)");
+   vector<shared_ptr<TropModel> > models;
+   makeModels(models);
+   vector<double> elevation;
+   for (double el = -5; el <= 90; el += 0.25)
+      elevation.push_back(el);
+   for (auto& model : models)
+   {
+      TUCSM("batchCorrection(elevation) " + model->name());
+      vector<double> expected, got;
+      for (double el : elevation)
+         expected.push_back(model->correction(el));
+      model->batchCorrection(elevation, got);
+      TUASSERTE(unsigned, 0, countDiffs(expected, got));
+   }
+      // invalid models throw as correction() does
+   GlobalTropModel invalid;
+   vector<double> got;
+   TUTHROW(invalid.batchCorrection(elevation, got));
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+batchPositionTest()
+{
+   TUDEF("TropModel", "batchCorrection(RX,SV,tt)");
+   vector<shared_ptr<TropModel> > models, batchModels;
+   makeModels(models);
+   makeModels(batchModels);
+   CommonTime t2(when + 86400*40);
+   Position rx2(-33.9, 18.4, 40.0, Position::Geodetic);
+   for (unsigned m = 0; m < models.size(); m++)
+   {
+      TUCSM("batchCorrection(RX,SV,tt) " + models[m]->name());
+         // a second epoch and receiver exercise the set up
+      const CommonTime epochs[] = { when, t2, t2 };
+      const Position rxs[] = { rx, rx, rx2 };
+      for (unsigned e = 0; e < 3; e++)
+      {
+         vector<double> expected, got;
+         for (const auto& sv : svs)
+            expected.push_back(models[m]->correction(rxs[e], sv, epochs[e]));
+         batchModels[m]->batchCorrection(rxs[e], svs, epochs[e], got);
+         TUASSERTE(unsigned, 0, countDiffs(expected, got));
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned TropModel_T ::
+coefficientCacheTest()
+{
+   TUDEF("GlobalTropModel", "setCoefficientCacheSize");
+   const double elev[] = { 5.0, 15.0, 45.0, 90.0 };
+   CommonTime t2(when + 86400*40);
+   Position rx2(-33.9, 18.4, 40.0, Position::Geodetic);
+      // reference values without the cache
+   GlobalTropModel::setCoefficientCacheSize(0);
+   GlobalTropModel::clearCoefficientCache();
+   GlobalTropModel ref1, ref2;
+   ref1.setParameters(when, rx);
+   ref2.setParameters(t2, rx2);
+   TUASSERTE(unsigned long, 0, GlobalTropModel::getCoefficientCacheHits());
+   TUASSERTE(unsigned long, 0, GlobalTropModel::getCoefficientCacheMisses());
+
+   GlobalTropModel::setCoefficientCacheSize(
+      GlobalTropModel::DEFAULT_COEFF_CACHE_SIZE);
+   TUASSERTE(size_t, GlobalTropModel::DEFAULT_COEFF_CACHE_SIZE,
+             GlobalTropModel::getCoefficientCacheSize());
+   GlobalTropModel a;
+   a.setParameters(when, rx);
+   TUASSERTE(unsigned long, 0, GlobalTropModel::getCoefficientCacheHits());
+   TUASSERTE(unsigned long, 1, GlobalTropModel::getCoefficientCacheMisses());
+   for (double el : elev)
+      TUASSERTE(double, ref1.correction(el), a.correction(el));
+      // a new time or height for the same station does not need them
+   a.setParameters(t2, rx);
+   a.setReceiverHeight(1000.0);
+   a.setReceiverHeight(rx.getHeight());
+   a.setParameters(when, rx);
+   TUASSERTE(unsigned long, 0, GlobalTropModel::getCoefficientCacheHits());
+   TUASSERTE(unsigned long, 1, GlobalTropModel::getCoefficientCacheMisses());
+   for (double el : elev)
+      TUASSERTE(double, ref1.correction(el), a.correction(el));
+      // another model for the same station uses the cached values
+   GlobalTropModel b(rx, when);
+   TUASSERTE(unsigned long, 1, GlobalTropModel::getCoefficientCacheHits());
+   TUASSERTE(unsigned long, 1, GlobalTropModel::getCoefficientCacheMisses());
+   for (double el : elev)
+      TUASSERTE(double, ref1.correction(el), b.correction(el));
+      // a copy needs nothing from the cache
+   GlobalTropModel c(a);
+   c.setParameters(t2, rx);
+   c.setParameters(when, rx);
+   TUASSERTE(unsigned long, 1, GlobalTropModel::getCoefficientCacheHits());
+   TUASSERTE(unsigned long, 1, GlobalTropModel::getCoefficientCacheMisses());
+   for (double el : elev)
+      TUASSERTE(double, ref1.correction(el), c.correction(el));
+   c.setParameters(t2, rx2);
+   TUASSERTE(unsigned long, 2, GlobalTropModel::getCoefficientCacheMisses());
+   for (double el : elev)
+      TUASSERTE(double, ref2.correction(el), c.correction(el));
+      // a full cache starts over
+   GlobalTropModel::setCoefficientCacheSize(1);
+   GlobalTropModel::clearCoefficientCache();
+   a.setParameters(when, rx2);
+   a.setParameters(when, rx);
+   a.setParameters(t2, rx2);
+   TUASSERTE(unsigned long, 0, GlobalTropModel::getCoefficientCacheHits());
+   TUASSERTE(unsigned long, 3, GlobalTropModel::getCoefficientCacheMisses());
+   for (double el : elev)
+      TUASSERTE(double, ref2.correction(el), a.correction(el));
+   GlobalTropModel::setCoefficientCacheSize(
+      GlobalTropModel::DEFAULT_COEFF_CACHE_SIZE);
+   GlobalTropModel::clearCoefficientCache();
+   TURETURN();
+}
+
+
+int main()
+{
+   TropModel_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.batchElevationTest();
+   errorTotal += testClass.batchPositionTest();
+   errorTotal += testClass.coefficientCacheTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
 }
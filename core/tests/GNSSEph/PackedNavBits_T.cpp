@@ -40,6 +40,7 @@
  * @file PackedNavBits_T.cpp
  * Tests for gnsstk/ext/lib/GNSSEph/PackedNavBits
  */
+#include <random>
 #include "CivilTime.hpp"
 #include "CommonTime.hpp"
 #include "GNSSconstants.hpp"
@@ -65,6 +66,7 @@ public:
    unsigned equalityTest();
    unsigned ancillaryMethods();
    unsigned addDataVecTest();
+   unsigned wordStorageTest();
 
    double eps;
 };
@@ -863,6 +865,164 @@ addDataVecTest()
 }
 
 
+   /// Extract a field one bit at a time, as the original decoder did.
+uint64_t refField(const std::vector<bool>& ref, size_t start, size_t num)
+{
+   uint64_t rv = 0;
+   for (size_t i = start; i < start+num; i++)
+   {
+      rv <<= 1;
+      if (ref[i]) rv++;
+   }
+   return rv;
+}
+
+
+   /// Build a PackedNavBits of numBits random bits along with a copy
+   /// of those bits in a vector<bool>.
+void randomPNB(std::mt19937& gen, size_t numBits, PackedNavBits& pnb,
+               std::vector<bool>& ref)
+{
+   ref.clear();
+   while (ref.size() < numBits)
+   {
+      int n = 1 + gen() % 32;
+      if (ref.size() + n > numBits)
+         n = numBits - ref.size();
+      unsigned long value = gen() & (0xFFFFFFFFUL >> (32-n));
+      pnb.addUnsignedLong(value, n, 1);
+      for (int i = n-1; i >= 0; i--)
+         ref.push_back((value >> i) & 1);
+   }
+   pnb.trimsize();
+}
+
+
+unsigned PackedNavBits_T ::
+wordStorageTest()
+{
+   TUDEF("PackedNavBits", "word storage");
+   std::mt19937 gen(20231016);
+      // Use more than the default 900 bits and a size that is not a
+      // multiple of 64 to exercise growth and the partial last word.
+   const size_t numBits = 1517;
+   PackedNavBits uut;
+   std::vector<bool> ref;
+   randomPNB(gen, numBits, uut, ref);
+   TUASSERTE(size_t, numBits, uut.getNumBits());
+   TUASSERT(ref == uut.getBits());
+
+      // Single fields of every width, compared with the bit-by-bit
+      // extraction.
+   bool allMatch = true;
+   for (unsigned i = 0; i < 5000; i++)
+   {
+      unsigned n = 1 + i % 64;
+      unsigned start = gen() % (numBits - n + 1);
+      uint64_t expU = refField(ref, start, n);
+      int64_t expS = (n < 64 && (expU >> (n-1))) ?
+         (int64_t)(expU | (~UINT64_C(0) << n)) : (int64_t)expU;
+      allMatch &= (uut.asUnsignedLong(start, n, 1) == (unsigned long)expU);
+      allMatch &= (uut.asLong(start, n, 1) == (long)expS);
+   }
+   TUASSERT(allMatch);
+
+      // Split fields
+   allMatch = true;
+   for (unsigned i = 0; i < 1000; i++)
+   {
+      unsigned startBits[3], nBits[3];
+      uint64_t expU = 0;
+      for (unsigned j = 0; j < 3; j++)
+      {
+         nBits[j] = 1 + gen() % 21;
+         startBits[j] = gen() % (numBits - nBits[j] + 1);
+         expU = (expU << nBits[j]) | refField(ref, startBits[j], nBits[j]);
+      }
+      allMatch &= (uut.asUnsignedLong(startBits, nBits, 3, 1) ==
+                   (unsigned long)expU);
+      allMatch &= (uut.asUnsignedDouble(startBits, nBits, 3, -5) ==
+                   ldexp((double)expU, -5));
+   }
+   TUASSERT(allMatch);
+   try
+   {
+      uut.asUnsignedLong(numBits-3, 4, 1);
+      TUFAIL("Expected an exception reading past the end");
+   }
+   catch (InvalidParameter&)
+   {
+      TUPASS("Reading past the end");
+   }
+
+      // Copies, concatenation and comparison.
+   PackedNavBits copy(uut);
+   TUASSERT(copy.matchBits(uut));
+   TUASSERT(!(copy < uut));
+   TUASSERT(!(uut < copy));
+   PackedNavBits other;
+   std::vector<bool> otherRef;
+   randomPNB(gen, 333, other, otherRef);
+   copy.addPackedNavBits(other);
+   std::vector<bool> catRef(ref);
+   catRef.insert(catRef.end(), otherRef.begin(), otherRef.end());
+   TUASSERT(catRef == copy.getBits());
+   copy.trimsize();
+   copy.reset_num_bits(numBits);
+   copy.trimsize();
+   TUASSERT(copy.matchBits(uut));
+
+      // Flip a single bit and check operator< and matchBits find it.
+   const unsigned flip = 1000;
+   copy.insertUnsignedLong(ref[flip] ? 0 : 1, flip, 1);
+   TUASSERT(!copy.matchBits(uut));
+   TUASSERT(copy.matchBits(uut, 0, flip-1));
+   TUASSERT(copy.matchBits(uut, flip+1, numBits-1));
+   TUASSERTE(bool, ref[flip], copy < uut);
+   TUASSERTE(bool, !ref[flip], uut < copy);
+
+      // Insert and copy ranges that span word boundaries.
+   allMatch = true;
+   std::vector<bool> insRef(ref);
+   for (unsigned i = 0; i < 500; i++)
+   {
+      unsigned n = 1 + gen() % 32;
+      unsigned start = gen() % (numBits - n + 1);
+      unsigned long value = gen() & (0xFFFFFFFFUL >> (32-n));
+      copy.insertUnsignedLong(value, start, n);
+      for (unsigned j = 0; j < n; j++)
+         insRef[start+j] = (value >> (n-1-j)) & 1;
+   }
+   TUASSERT(insRef == copy.getBits());
+   copy.copyBits(uut, 61, 700);
+   for (unsigned j = 61; j <= 700; j++)
+      insRef[j] = ref[j];
+   TUASSERT(insRef == copy.getBits());
+
+      // invert must leave the unused bits of the last word clear so
+      // comparisons stay consistent.
+   copy.copyBits(uut);
+   copy.invert();
+   std::vector<bool> invRef(ref);
+   invRef.flip();
+   TUASSERT(invRef == copy.getBits());
+   copy.invert();
+   TUASSERT(copy.matchBits(uut));
+   TUASSERT(!(copy < uut));
+
+      // Fill constructor and addBitset.
+   PackedNavBits ones(SatID(), ObsID(), NavID(), "", CommonTime(), 70,
+                      true);
+   TUASSERTE(unsigned long, 0x3f, ones.asUnsignedLong(64, 6, 1));
+   PackedNavBits bs;
+   bs.clearBits();
+   bs.addBitset(std::bitset<70>(0x2aaaaaaaaaULL));
+   TUASSERTE(size_t, 70, bs.getNumBits());
+   TUASSERTE(unsigned long, 0x2aaaaaaaaaUL, bs.asUnsignedLong(30, 40, 1));
+   TURETURN();
+}
+
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -874,6 +1034,7 @@ int main()
    errorTotal += testClass.equalityTest();
    errorTotal += testClass.ancillaryMethods();
    errorTotal += testClass.addDataVecTest();
+   errorTotal += testClass.wordStorageTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
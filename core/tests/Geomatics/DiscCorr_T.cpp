@@ -0,0 +1,261 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file DiscCorr_T.cpp Test the GDCconfiguration discontinuity corrector
+/// over many SatPass
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CivilTime.hpp"
+#include "DiscCorr.hpp"
+#include "FreqConsts.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+
+   /** Build synthetic dual-frequency GPS passes for one site, 30 second
+    * data, for a handful of satellites. Some passes have slips, bad data and
+    * gaps.
+    * @return the passes, in time order. */
+static vector<SatPass> makePasses()
+{
+   static const double wl1(WAVELENGTH_GPS_L1), wl2(WAVELENGTH_GPS_L2);
+   static const double gamma((FREQ_GPS_L1 / FREQ_GPS_L2) *
+                             (FREQ_GPS_L1 / FREQ_GPS_L2));
+   vector<string> ots;
+   ots.push_back("L1");
+   ots.push_back("L2");
+   ots.push_back("P1");
+   ots.push_back("P2");
+   vector<double> data(4);
+   vector<unsigned short> lli(4, 0), ssi(4, 0);
+      // simple LCG, so the data are the same everywhere
+   unsigned long long seed(12345);
+   auto noise = [&seed](double sig)
+   {
+      double sum(0.0);
+      for (int k = 0; k < 4; k++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         sum += double(seed >> 11) / 9007199254740992.0 - 0.5;
+      }
+      return sum * sig * std::sqrt(3.0);
+   };
+
+   Epoch t0(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   vector<SatPass> passes;
+   unsigned n(0);
+   const unsigned site(0);
+   {
+      for (int prn = 1; prn <= 6; prn++)
+      {
+         for (int p = 0; p < 3; p++, n++)
+         {
+            SatPass sp(RinexSatID(prn, SatelliteSystem::GPS), 30.0, ots);
+            int start = (p * 8 + (prn * 7 + site * 3) % 8) * 120;
+            int npts = 300 + (prn * 37 + p * 53 + site * 11) % 300;
+            double N1(1000.0 * prn), N2(800.0 * prn + 17.0 * p);
+            for (int i = 0; i < npts; i++)
+            {
+                  // gap of 5 points in every 4th pass
+               if (n % 4 == 1 && i >= npts / 3 && i < npts / 3 + 5)
+               {
+                  continue;
+               }
+                  // slips on L1 and L2 in every 3rd pass
+               if (n % 3 == 0 && i == npts / 2)
+               {
+                  N1 += 9.0;
+                  N2 += 7.0;
+               }
+               if (n % 5 == 0 && i == 2 * npts / 3)
+               {
+                  N1 += 1.0;
+               }
+               double x = double(i) / npts;
+               double rho = 2.0e7 + 4.0e6 * std::cos(3.14159 * (x - 0.5));
+               double iono = 3.0 + 4.0 * std::sin(3.14159 * x);
+               data[0] = (rho - iono) / wl1 + N1 + noise(0.003);
+               data[1] = (rho - gamma * iono) / wl2 + N2 + noise(0.003);
+               data[2] = rho + iono + noise(0.3);
+               data[3] = rho + gamma * iono + noise(0.3);
+               Epoch tt(t0);
+               tt += 30.0 * (start + i);
+               unsigned short flag(SatPass::OK);
+                  // an outlier in every 7th pass
+               if (n % 7 == 2 && i == npts / 4)
+               {
+                  flag = SatPass::BAD;
+               }
+               sp.addData(tt, ots, data, lli, ssi, flag);
+            }
+            passes.push_back(sp);
+         }
+      }
+   }
+   return passes;
+}
+
+
+
+   /// Write the L1, L2 and flags of all passes to a string.
+static string dumpPasses(vector<SatPass>& passes)
+{
+   ostringstream oss;
+   oss << setprecision(17);
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      for (unsigned j = 0; j < passes[i].size(); j++)
+      {
+         oss << i << " " << j << " " << passes[i].getFlag(j) << " "
+             << passes[i].data(j, "L1") << " " << passes[i].data(j, "L2")
+             << "\n";
+      }
+   }
+   return oss.str();
+}
+
+
+   /// Remove the wall-clock time in the debug output of each pass.
+static string stripRunTime(const string& log)
+{
+   istringstream iss(log);
+   ostringstream oss;
+   string line;
+   while (getline(iss, line))
+   {
+      string::size_type pos(line.find(" Run "));
+      if (pos != string::npos)
+      {
+         line.erase(pos);
+      }
+      oss << line << "\n";
+   }
+   return oss.str();
+}
+
+
+class DiscCorr_T
+{
+public:
+      /// Make sure the threaded batch gives the same results and debug output
+      /// as processing the passes one after the other.
+   unsigned batchTest();
+};
+
+
+unsigned DiscCorr_T ::
+batchTest()
+{
+   TUDEF("DiscCorr", "DiscontinuityCorrector(vector<SatPass>)");
+
+   const vector<SatPass> input(makePasses());
+
+      // reference: one pass at a time
+   vector<SatPass> seqPasses(input);
+   vector<string> seqMsgs(input.size());
+   vector<vector<string>> seqCmds(input.size());
+   vector<int> seqRets(input.size());
+   ostringstream seqLog;
+   GDCconfiguration seqConfig;
+   seqConfig.setParameter("DT", 30.0);
+   seqConfig.setParameter("Debug", 2);
+   seqConfig.setDebugStream(seqLog);
+   seqConfig.setParameter("ResetUnique", 1);
+   for (unsigned i = 0; i < seqPasses.size(); i++)
+   {
+      seqRets[i] = DiscontinuityCorrector(seqPasses[i], seqConfig, seqCmds[i],
+                                          seqMsgs[i]);
+   }
+   const string seqLogStr(stripRunTime(seqLog.str()));
+   TUASSERT(!seqLogStr.empty());
+
+   int expok(0);
+   unsigned ncmds(0);
+   for (unsigned i = 0; i < seqRets.size(); i++)
+   {
+      if (seqRets[i] == 0)
+      {
+         expok++;
+      }
+      ncmds += seqCmds[i].size();
+   }
+   TUASSERT(expok > 0);
+   TUASSERT(ncmds > 0);
+
+   unsigned nthreads[] = { 1, 3, 8 };
+   for (unsigned t = 0; t < 3; t++)
+   {
+      vector<SatPass> passes(input);
+      vector<string> msgs;
+      vector<vector<string>> cmds;
+      vector<int> rets;
+      ostringstream log;
+      GDCconfiguration config;
+      config.setParameter("DT", 30.0);
+      config.setParameter("Debug", 2);
+      config.setDebugStream(log);
+      config.setParameter("ResetUnique", 1);
+      int nok = DiscontinuityCorrector(passes, config, cmds, msgs, rets,
+                                       nthreads[t]);
+      TUASSERTE(int, expok, nok);
+      TUASSERT(seqRets == rets);
+      TUASSERT(seqMsgs == msgs);
+      TUASSERT(seqCmds == cmds);
+      TUASSERT(seqLogStr == stripRunTime(log.str()));
+      TUASSERT(dumpPasses(seqPasses) == dumpPasses(passes));
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   DiscCorr_T testClass;
+
+   errorTotal += testClass.batchTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
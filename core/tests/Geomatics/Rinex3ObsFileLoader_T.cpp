@@ -0,0 +1,443 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file Rinex3ObsFileLoader_T.cpp Test reading files with Rinex3ObsFileLoader
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Rinex3ObsFileLoader.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class Rinex3ObsFileLoader_T
+{
+public:
+   Rinex3ObsFileLoader_T();
+      /// Make sure reading with several threads gives the same results.
+   unsigned threadsTest();
+      /// Test the per-file statistics.
+   unsigned fileStatsTest();
+      /// Make sure reading stops at the same epoch with several threads.
+   unsigned nEpochsTest();
+      /** Compare the loaded data for a real RINEX 2 file with a
+       * direct read of the file using Rinex3ObsStream. */
+   unsigned goldenTest();
+
+      /** Write a RINEX 3 observation file to the test temp directory.
+       * @param[in] name file name, without directory.
+       * @param[in] hour hour of the first epoch of 2020/03/11.
+       * @param[in] nepochs number of 30 second epochs.
+       * @param[in] withC2W if true, include GPS C2W in the header.
+       * @param[in] swapEpoch if >= 0, swap this epoch with the next one,
+       *   so they are out of time order.
+       * @return the path of the file. */
+   std::string writeFile(const std::string& name, int hour, int nepochs,
+                         bool withC2W, int swapEpoch);
+
+      /** Load the test files.
+       * @param[in] nthreads number of threads reading files.
+       * @param[in] columnar if true, save data in the column store.
+       * @param[in] nepochs number of epochs to read, -1 for all.
+       * @param[out] errmsg error message from loadFiles.
+       * @param[out] msg informative message from loadFiles.
+       * @param[out] dump dumpSatObsTable() and dump of the data.
+       * @return value of loadFiles. */
+   int load(unsigned nthreads, bool columnar, int nepochs,
+            std::string& errmsg, std::string& msg, std::string& dump,
+            gnsstk::Rinex3ObsFileLoader& rofl);
+
+   std::vector<std::string> files;
+};
+
+
+Rinex3ObsFileLoader_T ::
+Rinex3ObsFileLoader_T()
+{
+   files.push_back(writeFile("Rinex3ObsFileLoader_T.1.rnx", 12, 20, false,
+                             -1));
+   files.push_back(writeFile("Rinex3ObsFileLoader_T.2.rnx", 13, 20, true, 5));
+   files.push_back("");
+   files.push_back(gnsstk::getPathTestTemp() + gnsstk::getFileSep() +
+                   "Rinex3ObsFileLoader_T.missing.rnx");
+   files.push_back(writeFile("Rinex3ObsFileLoader_T.3.rnx", 14, 20, false,
+                             -1));
+   files.push_back(writeFile("Rinex3ObsFileLoader_T.4.rnx", 15, 20, true, -1));
+}
+
+
+std::string Rinex3ObsFileLoader_T ::
+writeFile(const std::string& name, int hour, int nepochs, bool withC2W,
+          int swapEpoch)
+{
+   static const int prns[] = { 1, 5, 7, 12 };
+   std::ostringstream oss;
+   char buf[128];
+   oss << "     3.04           OBSERVATION DATA    M                   RINEX VERSION / TYPE\n"
+       << "test                test                20200311 120000 UTC PGM / RUN BY / DATE \n"
+       << "TEST                                                        MARKER NAME         \n"
+       << "obs                 agency                                  OBSERVER / AGENCY   \n"
+       << "1                   rcv                 1                   REC # / TYPE / VERS \n"
+       << "1                   ant                                     ANT # / TYPE        \n"
+       << "        0.0000        0.0000        0.0000                  APPROX POSITION XYZ \n"
+       << "        0.0000        0.0000        0.0000                  ANTENNA: DELTA H/E/N\n";
+   if (withC2W)
+      oss << "G    4 C1C L1C S1C C2W                                      SYS / # / OBS TYPES \n";
+   else
+      oss << "G    3 C1C L1C S1C                                          SYS / # / OBS TYPES \n";
+   oss << "R    2 C1C L1C                                              SYS / # / OBS TYPES \n"
+       << "    30.000                                                  INTERVAL            \n";
+   std::snprintf(buf, sizeof(buf), "  2020     3    11    %2d     0    0.0000000     GPS         TIME OF FIRST OBS   \n", hour);
+   oss << buf
+       << "                                                            END OF HEADER       \n";
+   for (int i = 0; i < nepochs; i++)
+   {
+      int ep = i;
+      if (i == swapEpoch)
+         ep = i + 1;
+      else if (i == swapEpoch + 1 && swapEpoch >= 0)
+         ep = i - 1;
+      int sec = ep * 30;
+      std::snprintf(buf, sizeof(buf), "> 2020 03 11 %02d %02d %10.7f  0  4\n",
+                    hour, sec / 60, double(sec % 60));
+      oss << buf;
+      for (int s = 0; s < 4; s++)
+      {
+         double r = 20000000.0 + 1000.0 * prns[s] + 10.0 * ep + hour;
+         if (prns[s] == 12)
+         {
+            std::snprintf(buf, sizeof(buf), "R%02d%14.3f  %14.3f  \n",
+                          prns[s], r, r + 1.0);
+         }
+         else
+         {
+               // G05 has no L1C in the first epoch, to count missing data
+            std::snprintf(buf, sizeof(buf), "G%02d%14.3f  ", prns[s], r);
+            oss << buf;
+            if (prns[s] == 5 && ep == 0)
+               oss << "                ";
+            else
+            {
+               std::snprintf(buf, sizeof(buf), "%14.3f  ", r + 1.0);
+               oss << buf;
+            }
+            std::snprintf(buf, sizeof(buf), "%14.3f  ", 45.0 + s);
+            oss << buf;
+            if (withC2W)
+            {
+               std::snprintf(buf, sizeof(buf), "%14.3f  ", r + 2.0);
+               oss << buf;
+            }
+            std::snprintf(buf, sizeof(buf), "\n");
+         }
+         oss << buf;
+      }
+   }
+   std::string fn = gnsstk::getPathTestTemp() + gnsstk::getFileSep() + name;
+   std::ofstream ofs(fn.c_str(), std::ios::out | std::ios::binary);
+   ofs << oss.str();
+   return fn;
+}
+
+
+int Rinex3ObsFileLoader_T ::
+load(unsigned nthreads, bool columnar, int nepochs, std::string& errmsg,
+     std::string& msg, std::string& dump, gnsstk::Rinex3ObsFileLoader& rofl)
+{
+   rofl.files(files);
+   rofl.loadObsID("GC1*");
+   rofl.loadObsID("*L1C");
+   rofl.loadObsID("GC2*");
+   rofl.loadObsID("RC1C");
+   rofl.saveTheData(true);
+   rofl.useColumnStore(columnar);
+   rofl.nEpochsToRead(nepochs);
+   rofl.setNumThreads(nthreads);
+   int rv = rofl.loadFiles(errmsg, msg);
+   std::ostringstream oss;
+   rofl.dumpSatObsTable(oss);
+   if (columnar)
+   {
+      const gnsstk::Rinex3ObsColumnStore& cs(rofl.getColumnStore());
+      for (size_t i = 0; i < cs.numEpochs(); i++)
+      {
+         gnsstk::Rinex3ObsColumnStore::EpochView ev(cs.getEpochView(i));
+         oss << ev.getTime() << "\n";
+         for (size_t row = 0; row < ev.size(); row++)
+         {
+            oss << ev.getSat(row);
+            for (size_t j = 0; j < cs.numObsTypes(); j++)
+               oss << " " << ev.getData(row, j);
+            oss << "\n";
+         }
+      }
+   }
+   else
+   {
+      rofl.dumpStoreData(oss);
+   }
+   dump = oss.str();
+   return rv;
+}
+
+
+unsigned Rinex3ObsFileLoader_T ::
+threadsTest()
+{
+   TUDEF("Rinex3ObsFileLoader", "loadFiles");
+   for (int columnar = 0; columnar < 2; columnar++)
+   {
+      std::string expErr, expMsg, expDump;
+      gnsstk::Rinex3ObsFileLoader expRofl;
+      int expRV = load(1, columnar, -1, expErr, expMsg, expDump, expRofl);
+      TUASSERTE(int, 5, expRV);
+         // one epoch of file 2 is out of time order and dropped
+      TUASSERTE(int, 79, expRofl.getStoreSize());
+      TUASSERT(expErr.find("file name 3 is blank") != std::string::npos);
+      TUASSERT(expErr.find("could not open file") != std::string::npos);
+      TUASSERT(expErr.find("are out of time order") != std::string::npos);
+      TUASSERT(expMsg.find("Add obs type GC2W =~ GC2* from") !=
+               std::string::npos);
+      for (unsigned nthreads = 0; nthreads < 8; nthreads++)
+      {
+         std::string err, msg, dump;
+         gnsstk::Rinex3ObsFileLoader rofl;
+         int rv = load(nthreads, columnar, -1, err, msg, dump, rofl);
+         TUASSERTE(int, expRV, rv);
+         TUASSERTE(std::string, expErr, err);
+         TUASSERTE(std::string, expMsg, msg);
+         TUASSERTE(std::string, expDump, dump);
+         TUASSERTE(size_t, expRofl.getWantedObsTypes().size(),
+                   rofl.getWantedObsTypes().size());
+         TUASSERTE(double, expRofl.getDT(), rofl.getDT());
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsFileLoader_T ::
+fileStatsTest()
+{
+   TUDEF("Rinex3ObsFileLoader", "getFileStats");
+   std::string err, msg, dump;
+   gnsstk::Rinex3ObsFileLoader rofl;
+   load(3, false, -1, err, msg, dump, rofl);
+   const std::vector<gnsstk::Rinex3ObsFileLoader::FileStats>&
+      stats(rofl.getFileStats());
+   TUASSERTE(size_t, files.size(), stats.size());
+   TUASSERTE(bool, true, stats[0].loaded);
+   TUASSERTE(int, 20, stats[0].epochs);
+   TUASSERTE(int, 0, stats[0].outOfOrder);
+   TUASSERTE(std::string, "", stats[0].error);
+   TUASSERTE(int, 20, stats[1].epochs);
+   TUASSERTE(int, 1, stats[1].outOfOrder);
+   TUASSERTE(bool, false, stats[2].loaded);
+   TUASSERTE(bool, true, stats[3].loaded);
+   TUASSERTE(int, 0, stats[3].epochs);
+   TUASSERT(stats[3].error.find("could not open file") != std::string::npos);
+   TUASSERTE(int, 20, stats[5].epochs);
+   TUASSERT(stats[5].readSeconds >= 0.0);
+   TUASSERT(stats[5].mergeSeconds >= 0.0);
+   std::ostringstream oss;
+   rofl.dumpFileStats(oss);
+   TUASSERT(oss.str().find(files[5]) != std::string::npos);
+   TUASSERT(oss.str().find(files[2] + "\n") == std::string::npos ||
+            files[2].empty());
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsFileLoader_T ::
+nEpochsTest()
+{
+   TUDEF("Rinex3ObsFileLoader", "nEpochsToRead");
+   std::string expErr, expMsg, expDump;
+   gnsstk::Rinex3ObsFileLoader expRofl;
+   int expRV = load(1, false, 30, expErr, expMsg, expDump, expRofl);
+   TUASSERTE(int, 2, expRV);
+   TUASSERTE(int, 29, expRofl.getStoreSize());
+   for (unsigned nthreads = 2; nthreads < 6; nthreads++)
+   {
+      std::string err, msg, dump;
+      gnsstk::Rinex3ObsFileLoader rofl;
+      int rv = load(nthreads, false, 30, err, msg, dump, rofl);
+      TUASSERTE(int, expRV, rv);
+      TUASSERTE(std::string, expErr, err);
+      TUASSERTE(std::string, expMsg, msg);
+      TUASSERTE(std::string, expDump, dump);
+      TUASSERTE(bool, false, rofl.getFileStats()[4].loaded);
+   }
+   TURETURN();
+}
+
+
+unsigned Rinex3ObsFileLoader_T ::
+goldenTest()
+{
+   TUDEF("Rinex3ObsFileLoader", "loadFiles");
+   std::string fn(gnsstk::getPathSrc() + gnsstk::getFileSep() + "examples" +
+                  gnsstk::getFileSep() + "bahr1620.04o");
+      // Read the file directly, keeping what the loader should keep.
+   std::vector<gnsstk::Rinex3ObsData> expData;
+   std::vector<std::string> expTypes;
+   gnsstk::Rinex3ObsStream strm(fn.c_str());
+   gnsstk::Rinex3ObsHeader hdr;
+   gnsstk::Rinex3ObsData rod;
+   strm >> hdr;
+   for (const auto& rot : hdr.mapObsTypes["G"])
+   {
+      expTypes.push_back("G" + rot.asString(
+                            gnsstk::Rinex3ObsBase::currentVersion));
+   }
+   while (strm >> rod)
+   {
+      if ((rod.epochFlag == 0) || (rod.epochFlag == 1))
+      {
+         rod.time.setTimeSystem(gnsstk::TimeSystem::Any);
+         expData.push_back(rod);
+      }
+   }
+   TUASSERTE(size_t, 120, expData.size());
+   TUASSERTE(size_t, 9, expTypes.size());
+   for (int columnar = 0; columnar < 2; columnar++)
+   {
+      for (unsigned nthreads = 1; nthreads < 4; nthreads += 2)
+      {
+         std::string err, msg;
+         gnsstk::Rinex3ObsFileLoader rofl(fn);
+         for (const auto& type : expTypes)
+         {
+            rofl.loadObsID(type);
+         }
+         rofl.saveTheData(true);
+         rofl.useColumnStore(columnar);
+         rofl.setNumThreads(nthreads);
+         TUASSERTE(int, 1, rofl.loadFiles(err, msg));
+         TUASSERTE(std::string, "", err);
+         std::vector<std::string> types(rofl.getWantedObsTypes());
+         TUASSERTE(size_t, expTypes.size(), types.size());
+            // index into types of each expTypes
+         std::vector<int> index;
+         for (const auto& type : expTypes)
+         {
+            index.push_back(gnsstk::vectorindex(types, type));
+            TUASSERT(index.back() >= 0);
+         }
+         TUASSERTE(int, expData.size(), rofl.getStoreSize());
+         unsigned epochErrs = 0, satErrs = 0, datumErrs = 0, numData = 0;
+         for (size_t i = 0; i < expData.size() &&
+                 i < (size_t)rofl.getStoreSize(); i++)
+         {
+            gnsstk::Rinex3ObsData colrod;
+            if (columnar)
+            {
+               rofl.getColumnStore().getEpoch(i, colrod);
+            }
+            const gnsstk::Rinex3ObsData& got(
+               columnar ? colrod : rofl.getStore()[i]);
+            const gnsstk::Rinex3ObsData& exp(expData[i]);
+            if ((got.time != exp.time) || (got.epochFlag != exp.epochFlag) ||
+                (got.clockOffset != exp.clockOffset))
+            {
+               epochErrs++;
+            }
+            for (const auto& expSat : exp.obs)
+            {
+               bool anyData = false;
+               for (const auto& datum : expSat.second)
+               {
+                  anyData |= (datum.data != 0.0);
+               }
+               auto gotSat = got.obs.find(expSat.first);
+               if (gotSat == got.obs.end())
+               {
+                     // the loader drops satellites with no data
+                  satErrs += (anyData ? 1 : 0);
+                  continue;
+               }
+               for (size_t j = 0; j < expSat.second.size(); j++)
+               {
+                  const gnsstk::RinexDatum& e(expSat.second[j]);
+                  const gnsstk::RinexDatum& g(gotSat->second[index[j]]);
+                     // the loader keeps only non-zero data
+                  if (e.data == 0.0)
+                  {
+                     datumErrs += (g.data == 0.0 ? 0 : 1);
+                     continue;
+                  }
+                  numData++;
+                  if ((g.data != e.data) || (g.lli != e.lli) ||
+                      (g.ssi != e.ssi))
+                  {
+                     datumErrs++;
+                  }
+               }
+            }
+            satErrs += (got.obs.size() > exp.obs.size() ? 1 : 0);
+         }
+         TUASSERTE(unsigned, 0, epochErrs);
+         TUASSERTE(unsigned, 0, satErrs);
+         TUASSERTE(unsigned, 0, datumErrs);
+            // make sure the comparison covered the file
+         TUASSERTE(unsigned, 8444, numData);
+      }
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Rinex3ObsFileLoader_T testClass;
+
+   errorTotal += testClass.threadsTest();
+   errorTotal += testClass.fileStatsTest();
+   errorTotal += testClass.nEpochsTest();
+   errorTotal += testClass.goldenTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
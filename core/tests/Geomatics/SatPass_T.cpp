@@ -0,0 +1,466 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+
+/// @file SatPass_T.cpp Test SatPass storage, access and iteration
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "CivilTime.hpp"
+#include "SatPass.hpp"
+#include "SatPassIterator.hpp"
+#include "SatPassUtilities.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+
+   /// synthetic value for obs type k of prn at count n; exact in F14.3
+static double value(int prn, int k, int n)
+{
+   return 20000000.0 + 1000000.0 * k + 1000.0 * prn + 0.125 * n;
+}
+
+
+   /** Build nprn satellites with three passes each of 30 second data, with
+    * obs types L1 L2 C1 P2 S1, filled by label or by handle. */
+static vector<SatPass> makePasses(int nprn, bool byHandle)
+{
+   vector<string> ots;
+   ots.push_back("L1");
+   ots.push_back("L2");
+   ots.push_back("C1");
+   ots.push_back("P2");
+   ots.push_back("S1");
+      // labels in another order, to add data by label
+   vector<string> rots(ots.rbegin(), ots.rend());
+   vector<double> data(ots.size());
+   vector<unsigned short> lli(ots.size()), ssi(ots.size());
+
+   Epoch t0(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   vector<SatPass> passes;
+   for (int p = 0; p < 3; p++)
+   {
+      for (int prn = 1; prn <= nprn; prn++)
+      {
+         SatPass sp(RinexSatID(prn, SatelliteSystem::GPS), 30.0, ots);
+         int start = p * 1000 + (prn * 7) % 50;
+         int npts = 200 + (prn * 37 + p * 53) % 300;
+         for (int i = 0; i < npts; i++)
+         {
+            Epoch tt(t0);
+            tt += 30.0 * (start + i);
+            for (unsigned k = 0; k < ots.size(); k++)
+            {
+               unsigned kk(byHandle ? k : ots.size() - 1 - k);
+               data[kk] = value(prn, k, start + i);
+               lli[kk] = (i % 11 == 0 ? 1 : 0);
+               ssi[kk] = 5 + k;
+            }
+            if (byHandle)
+               sp.addData(tt, data, lli, ssi);
+            else
+               sp.addData(tt, rots, data, lli, ssi);
+         }
+         passes.push_back(sp);
+      }
+   }
+   return passes;
+}
+
+
+class SatPass_T
+{
+public:
+      /// Access by label, by handle and by column must agree.
+   unsigned accessTest();
+      /// split, decimate, trimAfter and copy keep the data with its epoch.
+   unsigned editTest();
+      /// SatPassIterator returns all the data in time order.
+   unsigned iteratorTest();
+      /// Data written to RINEX and read back by SatPassFromRinexFiles.
+   unsigned rinexTest();
+};
+
+
+unsigned SatPass_T ::
+accessTest()
+{
+   TUDEF("SatPass", "data");
+   vector<SatPass> byLabel(makePasses(4, false)), byHandle(makePasses(4, true));
+   const Epoch t0(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   TUASSERTE(size_t, byLabel.size(), byHandle.size());
+   for (unsigned p = 0; p < byLabel.size(); p++)
+   {
+      SatPass& spl(byLabel[p]);
+      SatPass& sph(byHandle[p]);
+      TUASSERTE(unsigned, spl.size(), sph.size());
+      TUASSERTE(int, spl.getNgood(), sph.getNgood());
+      vector<string> ots(spl.getObsTypes());
+      for (unsigned k = 0; k < ots.size(); k++)
+      {
+         int h = sph.obsIndex(ots[k]);
+         TUASSERTE(int, k, h);
+         const double *col = sph.dataColumn(h);
+         const int n0 = int((spl.getFirstTime() - t0) / 30.0 + 0.5);
+         bool ok(true);
+         for (unsigned i = 0; i < spl.size(); i++)
+         {
+            if (spl.data(i, ots[k]) !=
+                   value(spl.getSat().id, k, n0 + spl.getCount(i)) ||
+                spl.data(i, ots[k]) != sph.data(i, h) ||
+                col[i] != sph.data(i, h) ||
+                spl.LLI(i, ots[k]) != sph.LLI(i, h) ||
+                spl.SSI(i, ots[k]) != sph.SSI(i, h) ||
+                spl.time(i) != sph.time(i) ||
+                spl.getFlag(i) != sph.getFlag(i))
+            {
+               ok = false;
+            }
+         }
+         TUASSERT(ok);
+      }
+   }
+
+   SatPass& sp(byHandle[0]);
+   TUASSERTE(int, -1, sp.obsIndex("D1"));
+   TUASSERT(!sp.hasType("D1"));
+   TUTHROW(sp.data(0, 5u));
+   TUTHROW(sp.data(sp.size(), 0u));
+   TUTHROW(sp.dataColumn(5));
+      // writes by handle are seen by label, and vice versa
+   sp.data(3, 1u) = 1.5;
+   TUASSERTFE(1.5, sp.data(3, "L2"));
+   sp.LLI(3, "P2") = 7;
+   TUASSERTE(unsigned short, 7, sp.LLI(3, 3u));
+   TUASSERTE(unsigned short, 7, sp.LLI(3, "C2", "P2"));
+   TUASSERTFE(value(1, 2, sp.getCount(3) + 7), sp.data(3, "P1", "C1"));
+
+      // add by label with a label that is not in the pass
+   vector<string> bad(1, "D1");
+   vector<double> d1(1, 1.0);
+   vector<unsigned short> z1(1, 0);
+   unsigned n(sp.size());
+   Epoch tt(sp.getLastTime());
+   tt += 30.0;
+   TUTHROW(sp.addData(tt, bad, d1, z1, z1));
+   TUASSERTE(unsigned, n, sp.size());
+      // by handle, the size must match
+   TUTHROW(sp.addData(tt, d1, z1, z1));
+      // a subset of the obs types by label; the others are zero
+   vector<string> one(1, "S1");
+   TUASSERTE(int, n, sp.addData(tt, one, d1, z1, z1));
+   TUASSERTFE(1.0, sp.data(n, "S1"));
+   TUASSERTFE(0.0, sp.data(n, "L1"));
+      // out of order, and a gap
+   TUASSERTE(int, -2, sp.addData(tt, one, d1, z1, z1));
+   tt += 2 * SatPass::maxGap;
+   TUASSERTE(int, -1, sp.addData(tt, one, d1, z1, z1));
+   TUASSERTE(unsigned, n + 1, sp.size());
+
+      // add from RinexObsData
+   SatPass spr(RinexSatID(9, SatelliteSystem::GPS), 30.0);
+   RinexObsData robs;
+   robs.time = sp.getFirstTime();
+   robs.epochFlag = 0;
+   robs.obs[RinexSatID(9, SatelliteSystem::GPS)][RinexObsHeader::L1].data = 3.0;
+   robs.obs[RinexSatID(9, SatelliteSystem::GPS)][RinexObsHeader::L1].lli = 1;
+   robs.obs[RinexSatID(9, SatelliteSystem::GPS)][RinexObsHeader::P1].data = 4.0;
+   TUASSERTE(int, 0, spr.addData(robs));
+   TUASSERTFE(3.0, spr.data(0, "L1"));
+   TUASSERTE(unsigned short, 1, spr.LLI(0, "L1"));
+   TUASSERTFE(4.0, spr.data(0, "P1"));
+   TUASSERTFE(0.0, spr.data(0, "L2"));
+   TUASSERTE(unsigned short, SatPass::OK, spr.getFlag(0));
+   TUASSERTE(int, 1, spr.getNgood());
+   robs.time += 30.0;
+   robs.obs[RinexSatID(9, SatelliteSystem::GPS)][RinexObsHeader::L2].data = 0.0;
+   TUASSERTE(int, 1, spr.addData(robs));
+   TUASSERTE(unsigned short, SatPass::BAD, spr.getFlag(1));
+   TUASSERTE(int, 1, spr.getNgood());
+   robs.obs.clear();
+   TUASSERTE(int, -3, spr.addData(robs));
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+editTest()
+{
+   TUDEF("SatPass", "split");
+   vector<SatPass> passes(makePasses(2, true));
+   SatPass sp(passes[0]);
+   const SatPass orig(sp);
+   const unsigned n(sp.size());
+   for (unsigned i = 0; i < n; i++)
+   {
+      sp.setUserFlag(i, i);
+   }
+   sp.setFlag(5, SatPass::BAD);
+   sp.setFlag(n - 5, SatPass::BAD);
+   const int ngood(sp.getNgood());
+   TUASSERTE(int, n - 2, ngood);
+
+   SatPass copy(RinexSatID(1, SatelliteSystem::GPS), 1.0);
+   copy = sp;
+   TUASSERTE(unsigned, n, copy.size());
+   TUASSERTE(int, ngood, copy.getNgood());
+
+   SatPass second(sp.getSat(), sp.getDT());
+   const int N(n / 2);
+   TUASSERT(sp.split(N, second));
+   TUASSERTE(unsigned, N, sp.size());
+   TUASSERTE(unsigned, n - N, second.size());
+   TUASSERTE(int, ngood, sp.getNgood() + second.getNgood());
+   TUASSERTE(unsigned, 0, second.getCount(0));
+   bool ok(true);
+   for (unsigned i = 0; i < n; i++)
+   {
+      SatPass& s(i < N ? sp : second);
+      unsigned j(i < N ? i : i - N);
+      if (s.time(j) != copy.time(i) || s.data(j, "P2") != copy.data(i, "P2") ||
+          s.SSI(j, "S1") != copy.SSI(i, "S1") ||
+          s.getFlag(j) != copy.getFlag(i) ||
+          s.getUserFlag(j) != copy.getUserFlag(i))
+      {
+         ok = false;
+      }
+   }
+   TUASSERT(ok);
+
+   TUCSM("decimate");
+   sp = copy;
+   sp.decimate(4, orig.getFirstTime() - 60.0);
+   TUASSERTFE(120.0, sp.getDT());
+   TUASSERT(sp.getFirstTime() == orig.getFirstTime() + 60.0);
+   ok = true;
+   for (unsigned i = 0; i < sp.size(); i++)
+   {
+      unsigned j(4 * i + 2);
+      if (sp.time(i) != copy.time(j) || sp.getCount(i) != i ||
+          sp.data(i, "L1") != copy.data(j, "L1") ||
+          sp.LLI(i, "L1") != copy.LLI(j, "L1") ||
+          sp.getUserFlag(i) != copy.getUserFlag(j))
+      {
+         ok = false;
+      }
+   }
+   TUASSERT(ok);
+   TUASSERTE(unsigned, (n - 2 + 3) / 4, sp.size());
+
+   TUCSM("trimAfter");
+   sp = copy;
+   TUASSERTE(int, 0, sp.trimAfter(copy.time(20)));
+   TUASSERTE(unsigned, 21, sp.size());
+   TUASSERTE(int, 19, sp.getNgood());
+   TUASSERT(sp.getLastTime() == copy.time(20));
+   TUASSERTFE(copy.data(20, "C1"), sp.data(20, "C1"));
+
+   TUCSM("clear");
+   sp.clear();
+   TUASSERTE(unsigned, 0, sp.size());
+   TUASSERTE(size_t, 5, sp.getObsTypes().size());
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+iteratorTest()
+{
+   TUDEF("SatPassIterator", "next");
+   vector<SatPass> passes(makePasses(6, true));
+   size_t total(0);
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      total += passes[i].size();
+   }
+
+   SatPassIterator spit(passes);
+   RinexObsData robs;
+   size_t count(0);
+   bool ok(true), inorder(true);
+   Epoch prev(CommonTime::BEGINNING_OF_TIME);
+   while (spit.next(robs))
+   {
+      if (robs.time <= prev)
+      {
+         inorder = false;
+      }
+      prev = robs.time;
+      map<unsigned int, unsigned int> indexes(spit.getIndexes());
+      map<unsigned int, unsigned int>::const_iterator it;
+      for (it = indexes.begin(); it != indexes.end(); ++it)
+      {
+         SatPass& sp(passes[it->first]);
+         RinexObsData::RinexObsTypeMap& otm(robs.obs[sp.getSat()]);
+         if (otm.size() != 5 || sp.time(it->second) != robs.time ||
+             otm[RinexObsHeader::L2].data != sp.data(it->second, "L2") ||
+             otm[RinexObsHeader::S1].data != sp.data(it->second, "S1") ||
+             otm[RinexObsHeader::C1].lli != sp.LLI(it->second, "C1") ||
+             otm[RinexObsHeader::P2].ssi != sp.SSI(it->second, "P2"))
+         {
+            ok = false;
+         }
+         count++;
+      }
+      if (robs.obs.size() != indexes.size())
+      {
+         ok = false;
+      }
+   }
+   TUASSERT(ok);
+   TUASSERT(inorder);
+   TUASSERTE(size_t, total, count);
+   TURETURN();
+}
+
+
+unsigned SatPass_T ::
+rinexTest()
+{
+   TUDEF("SatPass", "SatPassFromRinexFiles");
+   vector<SatPass> passes(makePasses(5, true));
+   vector<string> ots(passes[0].getObsTypes());
+
+   RinexObsHeader header;
+   header.version = 2.11;
+   header.fileType = "Observation";
+   header.system = RinexSatID(-1, SatelliteSystem::GPS);
+   header.fileProgram = "SatPass_T";
+   header.fileAgency = "GNSSTk";
+   header.date = "20200311";
+   header.markerName = "TEST";
+   header.observer = "nobody";
+   header.agency = "GNSSTk";
+   header.recNo = "1";
+   header.recType = "none";
+   header.recVers = "0";
+   header.antNo = "1";
+   header.antType = "none";
+   header.wavelengthFactor[0] = header.wavelengthFactor[1] = 1;
+   for (unsigned k = 0; k < ots.size(); k++)
+   {
+      header.obsTypeList.push_back(RinexObsHeader::convertObsType(ots[k]));
+   }
+   header.valid = RinexObsHeader::versionValid | RinexObsHeader::runByValid |
+                  RinexObsHeader::markerNameValid |
+                  RinexObsHeader::observerValid |
+                  RinexObsHeader::receiverValid |
+                  RinexObsHeader::antennaTypeValid |
+                  RinexObsHeader::antennaPositionValid |
+                  RinexObsHeader::antennaOffsetValid |
+                  RinexObsHeader::waveFactValid |
+                  RinexObsHeader::obsTypeValid | RinexObsHeader::endValid;
+
+   string fn = getPathTestTemp() + getFileSep() + "SatPass_T.obs";
+   TUASSERTE(int, 0, SatPassToRinex2File(fn, header, passes));
+
+   vector<string> files(1, fn);
+   vector<string> readots;
+   vector<SatPass> read;
+   TUASSERTE(int, 1, SatPassFromRinexFiles(files, readots, 30.0, read));
+   TUASSERTE(size_t, ots.size(), readots.size());
+   TUASSERTE(size_t, passes.size(), read.size());
+   sort(passes.begin(), passes.end());
+   sort(read.begin(), read.end());
+   bool ok(true);
+   for (unsigned p = 0; p < passes.size() && p < read.size(); p++)
+   {
+      if (read[p].getSat() != passes[p].getSat() ||
+          read[p].size() != passes[p].size() ||
+          read[p].getNgood() != passes[p].getNgood())
+      {
+         ok = false;
+         continue;
+      }
+      for (unsigned i = 0; i < passes[p].size(); i++)
+      {
+         if (read[p].time(i) != passes[p].time(i))
+         {
+            ok = false;
+         }
+         for (unsigned k = 0; k < ots.size(); k++)
+         {
+            if (read[p].data(i, ots[k]) != passes[p].data(i, ots[k]))
+            {
+               ok = false;
+            }
+         }
+      }
+   }
+   TUASSERT(ok);
+
+      // reading into an existing list with the obs types in another order
+   vector<string> rots(ots.rbegin(), ots.rend());
+   vector<SatPass> prior;
+   prior.push_back(SatPass(RinexSatID(2, SatelliteSystem::GPS), 30.0, rots));
+   TUASSERTE(int, 1, SatPassFromRinexFiles(files, ots, 30.0, prior));
+   TUASSERTE(size_t, passes.size(), prior.size());
+   sort(prior.begin(), prior.end());
+   ok = true;
+   for (unsigned p = 0; p < passes.size() && p < prior.size(); p++)
+   {
+      for (unsigned i = 0; i < passes[p].size() && i < prior[p].size(); i++)
+      {
+         if (prior[p].data(i, "L2") != passes[p].data(i, "L2") ||
+             prior[p].data(i, "S1") != passes[p].data(i, "S1"))
+         {
+            ok = false;
+         }
+      }
+   }
+   TUASSERT(ok);
+   std::remove(fn.c_str());
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SatPass_T testClass;
+
+   errorTotal += testClass.accessTest();
+   errorTotal += testClass.editTest();
+   errorTotal += testClass.iteratorTest();
+   errorTotal += testClass.rinexTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
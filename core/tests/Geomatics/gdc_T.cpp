@@ -0,0 +1,409 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/// @file gdc_T.cpp Test the discontinuity corrector over many SatPass
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "CivilTime.hpp"
+#include "FreqConsts.hpp"
+#include "gdc.hpp"
+#include "logstream.hpp"
+#include "SatPassUtilities.hpp"
+#include "StringUtils.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+
+   /** Build a day of synthetic dual-frequency GPS passes for nsites sites,
+    * 30 second data. Some passes have slips, bad data and gaps.
+    * @param[in] nsites number of sites; each has about 90 passes.
+    * @return the passes, in site and time order. */
+static vector<SatPass> makePasses(unsigned nsites)
+{
+   static const double wl1(WAVELENGTH_GPS_L1), wl2(WAVELENGTH_GPS_L2);
+   static const double gamma((FREQ_GPS_L1 / FREQ_GPS_L2) *
+                             (FREQ_GPS_L1 / FREQ_GPS_L2));
+   vector<string> ots;
+   ots.push_back("L1");
+   ots.push_back("L2");
+   ots.push_back("P1");
+   ots.push_back("P2");
+   vector<double> data(4);
+   vector<unsigned short> lli(4, 0), ssi(4, 0);
+      // simple LCG, so the data are the same everywhere
+   unsigned long long seed(12345);
+   auto noise = [&seed](double sig)
+   {
+      double sum(0.0);
+      for (int k = 0; k < 4; k++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         sum += double(seed >> 11) / 9007199254740992.0 - 0.5;
+      }
+      return sum * sig * std::sqrt(3.0);
+   };
+
+   Epoch t0(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   vector<SatPass> passes;
+   unsigned n(0);
+   for (unsigned site = 0; site < nsites; site++)
+   {
+      for (int prn = 1; prn <= 30; prn++)
+      {
+         for (int p = 0; p < 3; p++, n++)
+         {
+            SatPass sp(RinexSatID(prn, SatelliteSystem::GPS), 30.0, ots);
+            int start = (p * 8 + (prn * 7 + site * 3) % 8) * 120;
+            int npts = 300 + (prn * 37 + p * 53 + site * 11) % 300;
+            double N1(1000.0 * prn), N2(800.0 * prn + 17.0 * p);
+            for (int i = 0; i < npts; i++)
+            {
+                  // gap of 5 points in every 4th pass
+               if (n % 4 == 1 && i >= npts / 3 && i < npts / 3 + 5)
+               {
+                  continue;
+               }
+                  // slips on L1 and L2 in every 3rd pass
+               if (n % 3 == 0 && i == npts / 2)
+               {
+                  N1 += 9.0;
+                  N2 += 7.0;
+               }
+               if (n % 5 == 0 && i == 2 * npts / 3)
+               {
+                  N1 += 1.0;
+               }
+               double x = double(i) / npts;
+               double rho = 2.0e7 + 4.0e6 * std::cos(3.14159 * (x - 0.5));
+               double iono = 3.0 + 4.0 * std::sin(3.14159 * x);
+               data[0] = (rho - iono) / wl1 + N1 + noise(0.003);
+               data[1] = (rho - gamma * iono) / wl2 + N2 + noise(0.003);
+               data[2] = rho + iono + noise(0.3);
+               data[3] = rho + gamma * iono + noise(0.3);
+               Epoch tt(t0);
+               tt += 30.0 * (start + i);
+               unsigned short flag(SatPass::OK);
+                  // an outlier in every 7th pass
+               if (n % 7 == 2 && i == npts / 4)
+               {
+                  flag = SatPass::BAD;
+               }
+               sp.addData(tt, ots, data, lli, ssi, flag);
+            }
+            passes.push_back(sp);
+         }
+      }
+   }
+   return passes;
+}
+
+
+   /// Return a gdc configured to fix slips and generate commands.
+static gdc makeGDC()
+{
+   gdc dc;
+   dc.setParameter("doFix", 1);
+   dc.setParameter("doCmds", 1);
+   dc.setParameter("verbose", 1);
+   return dc;
+}
+
+
+   /// Write the L1, L2 and flags of all passes to a string.
+static string dumpPasses(vector<SatPass>& passes)
+{
+   ostringstream oss;
+   oss << setprecision(17);
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      for (unsigned j = 0; j < passes[i].size(); j++)
+      {
+         oss << i << " " << j << " " << passes[i].getFlag(j) << " "
+             << passes[i].data(j, "L1") << " " << passes[i].data(j, "L2")
+             << "\n";
+      }
+   }
+   return oss.str();
+}
+
+
+   /** Run gdc, one pass at a time, on the passes in bahr1620.04o, and on
+    * a copy of each with slips added on L1 and L2 half way through.
+    * @param[in] fn path of bahr1620.04o.
+    * @return return values, messages, commands, log output and the
+    *   corrected L1, L2 and flags, one per line. */
+static string gdcBahr(const string& fn)
+{
+   vector<string> fns(1, fn);
+   vector<string> ots;
+   ots.push_back("L1");
+   ots.push_back("L2");
+   ots.push_back("P1");
+   ots.push_back("P2");
+   vector<SatPass> passes;
+   SatPassFromRinexFiles(fns, ots, 30.0, passes);
+   const unsigned npass(passes.size());
+   for (unsigned i = 0; i < npass; i++)
+   {
+      SatPass sp(passes[i]);
+      for (unsigned j = sp.size() / 2; j < sp.size(); j++)
+      {
+         sp.data(j, "L1") += 9.0;
+         sp.data(j, "L2") += 7.0;
+      }
+      passes.push_back(sp);
+   }
+   ostream *saveLog = ConfigureLOGstream::Stream();
+   ostringstream log;
+   ConfigureLOGstream::Stream() = &log;
+   gdc dc(makeGDC());
+      // include the window filter results and their analysis messages
+   dc.setParameter("WLW", 1);
+   dc.setParameter("GFW", 1);
+   dc.ForceUniqueNumber(10);
+   ostringstream oss;
+   for (unsigned i = 0; i < passes.size(); i++)
+   {
+      string msg;
+      vector<string> cmds;
+      int rv = dc.DiscontinuityCorrector(passes[i], msg, cmds);
+      oss << "pass " << i << " " << passes[i].getSat() << " rv " << rv
+          << "\n" << msg << "\n";
+      for (unsigned j = 0; j < cmds.size(); j++)
+      {
+         oss << cmds[j] << "\n";
+      }
+   }
+   ConfigureLOGstream::Stream() = saveLog;
+   oss << "log\n" << log.str() << "data\n" << dumpPasses(passes);
+   return oss.str();
+}
+
+
+class gdc_T
+{
+public:
+      /// Make sure the threaded batch gives the same results and log output as
+      /// processing the passes one after the other.
+   unsigned batchTest();
+      /// Make sure exceptions and GLONASS channel input are handled.
+   unsigned argsTest();
+      /** Compare the results for a real data file, with and without
+       * slips, with those of the toolkit before the batch interface
+       * was added. */
+   unsigned bahrTest();
+};
+
+
+unsigned gdc_T ::
+batchTest()
+{
+   TUDEF("gdc", "DiscontinuityCorrector(vector<SatPass>)");
+   ostream *saveLog = ConfigureLOGstream::Stream();
+
+   const vector<SatPass> input(makePasses(1));
+
+      // reference: one pass at a time
+   vector<SatPass> seqPasses(input);
+   vector<string> seqMsgs(input.size());
+   vector<vector<string>> seqCmds(input.size());
+   vector<int> seqRets(input.size());
+   ostringstream seqLog;
+   gdc seqDC(makeGDC());
+   seqDC.ForceUniqueNumber(10);
+   ConfigureLOGstream::Stream() = &seqLog;
+   for (unsigned i = 0; i < seqPasses.size(); i++)
+   {
+      seqRets[i] = seqDC.DiscontinuityCorrector(seqPasses[i], seqMsgs[i],
+                                                seqCmds[i]);
+   }
+   ConfigureLOGstream::Stream() = saveLog;
+   const string seqDump(dumpPasses(seqPasses));
+   TUASSERTE(int, 10 + input.size(), seqDC.getUniqueNumber());
+
+      // the synthetic slips must have been found and fixed
+   unsigned nslips(0);
+   for (unsigned i = 0; i < seqCmds.size(); i++)
+   {
+      for (unsigned j = 0; j < seqCmds[i].size(); j++)
+      {
+         if (seqCmds[i][j].find("--BD+") == 0)
+         {
+            nslips++;
+         }
+      }
+   }
+   TUASSERT(nslips > 2 * input.size());
+   TUASSERT(seqDump != dumpPasses(const_cast<vector<SatPass>&>(input)));
+
+   unsigned nthreads[] = { 1, 2, 4, 7 };
+   for (unsigned t = 0; t < 4; t++)
+   {
+      vector<SatPass> passes(input);
+      vector<string> msgs;
+      vector<vector<string>> cmds;
+      vector<int> rets;
+      ostringstream log;
+      gdc dc(makeGDC());
+      dc.ForceUniqueNumber(10);
+      ConfigureLOGstream::Stream() = &log;
+      int nok = dc.DiscontinuityCorrector(passes, msgs, cmds, rets,
+                                          nthreads[t]);
+      ConfigureLOGstream::Stream() = saveLog;
+
+      int expok(0);
+      for (unsigned i = 0; i < seqRets.size(); i++)
+      {
+         if (seqRets[i] == 0)
+         {
+            expok++;
+         }
+      }
+      TUASSERTE(int, expok, nok);
+      TUASSERTE(int, 10 + input.size(), dc.getUniqueNumber());
+      TUASSERTE(size_t, input.size(), msgs.size());
+      TUASSERT(seqRets == rets);
+      TUASSERT(seqMsgs == msgs);
+      TUASSERT(seqCmds == cmds);
+      TUASSERTE(string, seqLog.str(), log.str());
+      TUASSERT(seqDump == dumpPasses(passes));
+   }
+
+   ConfigureLOGstream::Stream() = saveLog;
+   TURETURN();
+}
+
+
+unsigned gdc_T ::
+argsTest()
+{
+   TUDEF("gdc", "DiscontinuityCorrector(vector<SatPass>)");
+   ostream *saveLog = ConfigureLOGstream::Stream();
+   ostringstream log;
+   ConfigureLOGstream::Stream() = &log;
+
+   vector<string> msgs;
+   vector<vector<string>> cmds;
+   vector<int> rets;
+   gdc dc(makeGDC());
+
+      // empty input
+   vector<SatPass> passes;
+   TUASSERTE(int, 0, dc.DiscontinuityCorrector(passes, msgs, cmds, rets, 4));
+   TUASSERTE(size_t, 0, rets.size());
+
+      // GLOn must be parallel to the passes
+   passes = makePasses(1);
+   passes.erase(passes.begin() + 3, passes.end());
+   TUTHROW(dc.DiscontinuityCorrector(passes, msgs, cmds, rets, 2,
+                                     vector<int>(2, 0)));
+
+      // a pass without P2 throws; the others are still processed
+   vector<string> ots(3);
+   ots[0] = "L1";
+   ots[1] = "L2";
+   ots[2] = "P1";
+   SatPass bad(RinexSatID(5, SatelliteSystem::GPS), 30.0, ots);
+   vector<double> data(3, 1.0);
+   vector<unsigned short> lli(3, 0), ssi(3, 0);
+   Epoch tt(CivilTime(2020, 3, 11, 0, 0, 0.0, TimeSystem::GPS));
+   for (int i = 0; i < 100; i++, tt += 30.0)
+   {
+      bad.addData(tt, ots, data, lli, ssi);
+   }
+   passes.insert(passes.begin() + 1, bad);
+   TUTHROW(dc.DiscontinuityCorrector(passes, msgs, cmds, rets, 2));
+   TUASSERTE(size_t, 4, rets.size());
+   TUASSERT(!msgs[3].empty());
+
+   ConfigureLOGstream::Stream() = saveLog;
+   TURETURN();
+}
+
+
+unsigned gdc_T ::
+bahrTest()
+{
+   TUDEF("gdc", "DiscontinuityCorrector(SatPass)");
+   string fs(getFileSep());
+   istringstream got(gdcBahr(getPathSrc() + fs + "examples" + fs +
+                             "bahr1620.04o"));
+   ifstream exp((getPathData() + fs + "test_output_gdc_bahr1620.txt").c_str());
+   TUASSERT(exp.good());
+   string expLine, gotLine;
+   unsigned lines(0), diffs(0);
+   while (getline(exp, expLine))
+   {
+      lines++;
+      if (!getline(got, gotLine) || gotLine != expLine)
+      {
+         if (diffs == 0)
+         {
+            TUFAIL("first difference at line " + StringUtils::asString(lines)
+                   + "\nexpected: " + expLine + "\n     got: " + gotLine);
+         }
+         diffs++;
+      }
+   }
+   TUASSERTE(unsigned, 0, diffs);
+   TUASSERT(!getline(got, gotLine));
+      // make sure the file is the full output, including slips found
+   TUASSERTE(unsigned, 5770, lines);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   gdc_T testClass;
+
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.argsTest();
+   errorTotal += testClass.bahrTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}
@@ -0,0 +1,253 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "FixedMatrix.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace gnsstk;
+
+class FixedMatrix_T
+{
+public:
+   FixedMatrix_T()
+         : eps(1e-12)
+   {
+         // symmetric positive definite 4x4, and a general 3x3
+      const double s[16] = { 10., 1., 2., 3.,
+                             1., 9., 0.5, 1.,
+                             2., 0.5, 8., 0.25,
+                             3., 1., 0.25, 7. };
+      const double g[9] = { 2., -1., 4.,
+                            3., 5., -2.,
+                            1., 0.5, 6. };
+      spd = Matrix<double>(4,4);
+      spd = s;
+      gen = Matrix<double>(3,3);
+      gen = g;
+   }
+
+      /// construction, sizes, and interoperation with Vector/Matrix
+   int basicTest()
+   {
+      TUDEF("FixedMatrix", "FixedMatrix");
+      FixedVector<double,3> v0;
+      TUASSERTE(size_t, 3, v0.size());
+      TUASSERTE(double, 0., v0[0]+v0[1]+v0[2]);
+      FixedVector<double,3> v1(2.5);
+      TUASSERTE(double, 7.5, v1[0]+v1[1]+v1[2]);
+      Vector<double> vec(3);
+      vec[0] = 1.; vec[1] = 2.; vec[2] = 3.;
+      FixedVector<double,3> v2(vec);
+      TUASSERTE(double, 2., v2(1));
+      Vector<double> back(v2);
+      TUASSERTE(size_t, 3, back.size());
+      TUASSERTE(double, 3., back[2]);
+      TUASSERTFE(14., dot(v2,v2));
+      TUASSERTFE(14., dot(vec,v2));
+      TUASSERTFEPS(sqrt(14.), norm(v2), eps);
+      FixedVector<double,3> v3 = v2 + v1 * 2.;
+      TUASSERTE(double, 6., v3[0]);
+      v3 -= v2;
+      TUASSERTE(double, 5., v3[2]);
+      FixedVector<double,3> c = cross(v2, v3);
+      Vector<double> cv = cross(vec, Vector<double>(v3));
+      for (size_t i = 0; i < 3; i++)
+         TUASSERTFE(cv[i], c[i]);
+      try
+      {
+         FixedVector<double,4> bad(vec);
+         TUFAIL("Expected VectorException");
+      }
+      catch (VectorException& e)
+      {
+         TUPASS("size mismatch");
+      }
+
+      FixedMatrix<double,3,3> m(gen);
+      TUASSERTE(size_t, 3, m.rows());
+      TUASSERTE(size_t, 3, m.cols());
+      TUASSERTE(double, -2., m(1,2));
+      Matrix<double> mm(m);
+      TUASSERTE(double, 0.5, mm(2,1));
+      try
+      {
+         FixedMatrix<double,4,4> bad(gen);
+         TUFAIL("Expected MatrixException");
+      }
+      catch (MatrixException& e)
+      {
+         TUPASS("size mismatch");
+      }
+      FixedMatrix<double,3,3> id = FixedMatrix<double,3,3>::identity();
+      TUASSERTE(double, 3., id(0,0)+id(1,1)+id(2,2));
+      TUASSERTE(double, 0., id(0,1));
+      TURETURN();
+   }
+
+      /// products and transpose agree with Matrix<double>
+   int productTest()
+   {
+      TUDEF("FixedMatrix", "operator*");
+      FixedMatrix<double,3,3> m(gen);
+      FixedMatrix<double,3,4> a;
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 4; j++)
+            a(i,j) = double(i+1) - 0.5*double(j);
+      Matrix<double> am(a);
+      FixedMatrix<double,3,4> p = m * a;
+      Matrix<double> pm = gen * am;
+      compare(testFramework, pm, p);
+      FixedMatrix<double,4,3> t = transpose(a);
+      compare(testFramework, transpose(am), t);
+      compare(testFramework, gen + gen, m + m);
+      compare(testFramework, gen - 2.*gen, m - 2.*m);
+
+      FixedVector<double,3> v;
+      v[0] = 1.; v[1] = -2.; v[2] = 0.5;
+      Vector<double> vv(v);
+      FixedVector<double,3> mv = m * v;
+      Vector<double> mvv = gen * vv;
+      FixedVector<double,4> va = v * a;
+      Vector<double> vav = vv * am;
+      for (size_t i = 0; i < 3; i++)
+         TUASSERTFE(mvv[i], mv[i]);
+      for (size_t i = 0; i < 4; i++)
+         TUASSERTFE(vav[i], va[i]);
+         // general operators accept FixedMatrix and return Matrix
+      Matrix<double> mixed = gen * m;
+      compare(testFramework, gen * gen, mixed);
+      TURETURN();
+   }
+
+      /// LU, Cholesky and inverses agree with the Matrix functors
+   int decompTest()
+   {
+      TUDEF("FixedMatrix", "inverse");
+      FixedMatrix<double,3,3> m(gen);
+      FixedLUDecomp<double,3> flu;
+      flu(m);
+      LUDecomp<double> lu;
+      lu(gen);
+      compare(testFramework, lu.LU, flu.LU);
+      TUASSERTFEPS(lu.det(), flu.det(), eps);
+      double d;
+      FixedMatrix<double,3,3> inv = inverseLUD(m, d);
+      compare(testFramework, inverseLUD(gen), inv);
+      TUASSERTFEPS(lu.det(), d, eps);
+      compare(testFramework, ident<double>(3), inv * m);
+
+      FixedVector<double,3> b;
+      b[0] = 1.; b[1] = 2.; b[2] = 3.;
+      Vector<double> bv(b);
+      flu.backSub(b);
+      lu.backSub(bv);
+      for (size_t i = 0; i < 3; i++)
+         TUASSERTFEPS(bv[i], b[i], eps);
+
+      FixedMatrix<double,4,4> s(spd);
+      FixedCholesky<double,4> fch;
+      fch(s);
+      CholeskyCrout<double> ch;
+      ch(spd);
+      compare(testFramework, ch.L, fch.L);
+      compare(testFramework, spd, fch.L * transpose(fch.L));
+      FixedVector<double,4> y(1.);
+      fch.backSub(y);
+      FixedVector<double,4> sy = s * y;
+      for (size_t i = 0; i < 4; i++)
+         TUASSERTFEPS(1., sy[i], eps);
+      compare(testFramework, inverseChol(spd), inverseChol(s));
+      compare(testFramework, inverseLUD(spd), inverseChol(s));
+
+      FixedMatrix<double,3,3> sing;
+      sing(0,0) = 1.; sing(1,1) = 1.;
+      try
+      {
+         inverseLUD(sing);
+         TUFAIL("Expected SingularMatrixException");
+      }
+      catch (SingularMatrixException& e)
+      {
+         TUPASS("singular");
+      }
+      try
+      {
+         inverseChol(FixedMatrix<double,3,3>::identity() * -1.);
+         TUFAIL("Expected MatrixException");
+      }
+      catch (MatrixException& e)
+      {
+         TUPASS("not positive definite");
+      }
+      TURETURN();
+   }
+
+private:
+   template <class E1, class E2>
+   void compare(TestUtil& testFramework,
+                const ConstMatrixBase<double,E1>& expected,
+                const ConstMatrixBase<double,E2>& got)
+   {
+      TUASSERTE(size_t, expected.rows(), got.rows());
+      TUASSERTE(size_t, expected.cols(), got.cols());
+      for (size_t i = 0; i < expected.rows(); i++)
+         for (size_t j = 0; j < expected.cols(); j++)
+            TUASSERTFEPS(expected(i,j), got(i,j), eps);
+   }
+
+   double eps;
+   Matrix<double> spd, gen;
+};
+
+
+int main()
+{
+   FixedMatrix_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.basicTest();
+   errorTotal += testClass.productTest();
+   errorTotal += testClass.decompTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
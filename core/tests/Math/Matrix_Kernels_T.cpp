@@ -0,0 +1,294 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+/** @file Matrix_Kernels_T.cpp
+ * Accuracy of the blocked MatrixKernels against the reference
+ * loops, at every kernel level this processor supports.
+ */
+
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+#include <cmath>
+
+using namespace std;
+using namespace gnsstk;
+
+   /// deterministic matrix with elements in [-1,1)
+Matrix<double> randomMatrix(size_t r, size_t c, unsigned long seed)
+{
+   Matrix<double> m(r,c);
+   for (size_t i = 0; i < r; i++)
+      for (size_t j = 0; j < c; j++)
+      {
+         seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+         m(i,j) = double(seed >> 11) / double(1UL << 52) - 1.;
+      }
+   return m;
+}
+
+   /// symmetric positive definite n x n
+Matrix<double> spdMatrix(size_t n, unsigned long seed)
+{
+   Matrix<double> a(randomMatrix(n, n, seed));
+   MatrixKernels::Level level = MatrixKernels::getLevel();
+   MatrixKernels::setLevel(MatrixKernels::Reference);
+   Matrix<double> s(a * transpose(a));
+   MatrixKernels::setLevel(level);
+   for (size_t i = 0; i < n; i++)
+      s(i,i) += double(n);
+   return s;
+}
+
+class Matrix_Kernels_T
+{
+public:
+   Matrix_Kernels_T()
+         : sizes{ 1, 3, 7, 17, 64, 65, 130, 203 }
+   {}
+
+      /// products of square, rectangular and non-Matrix operands
+   int multiplyTest()
+   {
+      TUDEF("MatrixKernels", "gemm");
+      for (unsigned s = 0; s < nsizes; s++)
+      {
+         size_t n = sizes[s];
+         Matrix<double> a(randomMatrix(n, n+5, n)),
+            b(randomMatrix(n+5, 2*n+1, n+1));
+         Matrix<double> ref, got;
+         MatrixKernels::setLevel(MatrixKernels::Reference);
+         ref = a * b;
+         for (unsigned l = MatrixKernels::Portable; l <= best; l++)
+         {
+            MatrixKernels::setLevel(MatrixKernels::Level(l));
+            got = a * b;
+            compare(testFramework, ref, got, n+5, "a*b");
+            got = transpose(b) * transpose(a);
+            compare(testFramework, transpose(ref), got, n+5, "bT*aT");
+         }
+      }
+      TURETURN();
+   }
+
+      /// LU decomposition, determinant and inverse
+   int luTest()
+   {
+      TUDEF("MatrixKernels", "lu");
+      for (unsigned s = 0; s < nsizes; s++)
+      {
+         size_t n = sizes[s];
+         Matrix<double> a(randomMatrix(n, n, 3*n));
+         MatrixKernels::setLevel(MatrixKernels::Reference);
+         LUDecomp<double> ref;
+         ref(a);
+         double refDet = ref.det();
+         Matrix<double> refInv(inverseLUD(a));
+         for (unsigned l = MatrixKernels::Portable; l <= best; l++)
+         {
+            MatrixKernels::setLevel(MatrixKernels::Level(l));
+            LUDecomp<double> got;
+            got(a);
+            TUASSERTE(int, ref.parity, got.parity);
+            bool samePivot = true;
+            for (size_t i = 0; i < n; i++)
+               samePivot &= (ref.Pivot(i) == got.Pivot(i));
+            TUASSERT(samePivot);
+            compare(testFramework, ref.LU, got.LU, n, "LU");
+            TUASSERTFEPS(1., got.det()/refDet, 1e-9);
+            compare(testFramework, refInv, inverseLUD(a), n, "inverseLUD",
+                    1e-9);
+         }
+      }
+      Matrix<double> sing(randomMatrix(100, 100, 7));
+      for (size_t i = 0; i < 100; i++)
+         sing(i,50) = 2. * sing(i,10);
+      try
+      {
+         LUDecomp<double> lu;
+         lu(sing);
+            // rounding may leave a tiny pivot instead of an exact zero
+         TUPASS("nearly singular");
+      }
+      catch (SingularMatrixException& e)
+      {
+         TUPASS("singular");
+      }
+      Matrix<double> zero(randomMatrix(100, 100, 8));
+      for (size_t j = 0; j < 100; j++)
+         zero(40,j) = 0.;
+      try
+      {
+         LUDecomp<double> lu;
+         lu(zero);
+         TUFAIL("Expected SingularMatrixException");
+      }
+      catch (SingularMatrixException& e)
+      {
+         TUPASS("singular");
+      }
+      TURETURN();
+   }
+
+      /// Cholesky, CholeskyCrout and inverseChol
+   int choleskyTest()
+   {
+      TUDEF("MatrixKernels", "cholesky");
+      for (unsigned s = 0; s < nsizes; s++)
+      {
+         size_t n = sizes[s];
+         Matrix<double> a(spdMatrix(n, 5*n));
+         MatrixKernels::setLevel(MatrixKernels::Reference);
+         Cholesky<double> ref;
+         ref(a);
+         CholeskyCrout<double> refCC;
+         refCC(a);
+         Matrix<double> refInv(inverseChol(a));
+         for (unsigned l = MatrixKernels::Portable; l <= best; l++)
+         {
+            MatrixKernels::setLevel(MatrixKernels::Level(l));
+            Cholesky<double> got;
+            got(a);
+            compare(testFramework, ref.L, got.L, n, "Cholesky L");
+            compare(testFramework, ref.U, got.U, n, "Cholesky U");
+            CholeskyCrout<double> gotCC;
+            gotCC(a);
+            compare(testFramework, refCC.L, gotCC.L, n, "CholeskyCrout L");
+            compare(testFramework, refCC.U, gotCC.U, n, "CholeskyCrout U");
+            compare(testFramework, refInv, inverseChol(a), n, "inverseChol");
+         }
+      }
+      Matrix<double> notpd(spdMatrix(100, 9));
+      notpd(70,70) = -1.;
+      try
+      {
+         CholeskyCrout<double> ch;
+         ch(notpd);
+         TUFAIL("Expected MatrixException");
+      }
+      catch (MatrixException& e)
+      {
+         TUPASS("not positive definite");
+      }
+      TURETURN();
+   }
+
+      /// Householder triangularization of square, tall and wide matrices
+   int householderTest()
+   {
+      TUDEF("MatrixKernels", "householder");
+      for (unsigned s = 0; s < nsizes; s++)
+      {
+         size_t n = sizes[s];
+         const size_t dims[3][2] = { {n, n}, {2*n+3, n}, {n, n+40} };
+         for (unsigned d = 0; d < 3; d++)
+         {
+            Matrix<double> a(randomMatrix(dims[d][0], dims[d][1], 7*n+d));
+            MatrixKernels::setLevel(MatrixKernels::Reference);
+            Householder<double> ref;
+            ref(a);
+            for (unsigned l = MatrixKernels::Portable; l <= best; l++)
+            {
+               MatrixKernels::setLevel(MatrixKernels::Level(l));
+               Householder<double> got;
+               got(a);
+               compare(testFramework, ref.A, got.A, dims[d][0], "Householder");
+            }
+         }
+      }
+      TURETURN();
+   }
+
+      /// Test at all sizes; the default crossover is restored by main
+   void setup()
+   {
+      best = MatrixKernels::bestLevel();
+      MatrixKernels::setCrossover(1);
+      cout << "Best MatrixKernels level: "
+           << MatrixKernels::levelName(MatrixKernels::bestLevel()) << endl;
+   }
+
+private:
+      /// elements agree to eps relative to the largest, times depth
+   void compare(TestUtil& testFramework, const Matrix<double>& expected,
+                const Matrix<double>& got, size_t depth, const string& what,
+                double eps = 1e-14)
+   {
+      TUASSERTE(size_t, expected.rows(), got.rows());
+      TUASSERTE(size_t, expected.cols(), got.cols());
+      if (expected.rows() != got.rows() || expected.cols() != got.cols())
+         return;
+      double big = 1., worst = 0.;
+      for (size_t i = 0; i < expected.rows(); i++)
+         for (size_t j = 0; j < expected.cols(); j++)
+            big = max(big, fabs(expected(i,j)));
+      for (size_t i = 0; i < expected.rows(); i++)
+         for (size_t j = 0; j < expected.cols(); j++)
+            worst = max(worst, fabs(expected(i,j) - got(i,j)));
+      testFramework.assert(worst <= eps * big * double(depth+1),
+                           what + " " + MatrixKernels::levelName(
+                              MatrixKernels::getLevel()) + " size "
+                           + to_string(expected.rows()) + " differs by "
+                           + to_string(worst), __LINE__);
+   }
+
+   static const unsigned nsizes = 8;
+   size_t sizes[nsizes];
+   unsigned best;
+};
+
+
+int main()
+{
+   Matrix_Kernels_T testClass;
+   size_t crossover = MatrixKernels::crossover();
+   unsigned errorTotal = 0;
+
+   testClass.setup();
+   errorTotal += testClass.multiplyTest();
+   errorTotal += testClass.luTest();
+   errorTotal += testClass.choleskyTest();
+   errorTotal += testClass.householderTest();
+   MatrixKernels::setCrossover(crossover);
+   MatrixKernels::setLevel(MatrixKernels::bestLevel());
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,223 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+#include <thread>
+#include <vector>
+#include "TestUtil.hpp"
+#include "NavFilterMgr.hpp"
+#include "NavFilterPool.hpp"
+#include "LNavFilterData.hpp"
+#include "LNavCrossSourceFilter.hpp"
+#include "LNavEmptyFilter.hpp"
+#include "LNavOrderFilter.hpp"
+#include "GPSWeekSecond.hpp"
+
+using namespace std;
+using namespace gnsstk;
+
+   /// A subframe 1 with good parity.
+static uint32_t sfGood[10] =
+{ 0x22C34D21, 0x000029D4, 0x34D44000, 0x091B1DE7, 0x1C33746E,
+  0x2F701369, 0x39F53CB5, 0x128070A8, 0x003FF454, 0x3EAFC2F0 };
+   /// The same subframe with a bit error in word 3.
+static uint32_t sfBad[10] =
+{ 0x22C34D21, 0x000029D4, 0x34D44001, 0x091B1DE7, 0x1C33746E,
+  0x2F701369, 0x39F53CB5, 0x128070A8, 0x003FF454, 0x3EAFC2F0 };
+
+
+class NavFilterPool_T
+{
+public:
+   unsigned reuseTest();
+   unsigned spliceTest();
+   unsigned threadTest();
+   unsigned crossSourceTest();
+};
+
+
+unsigned NavFilterPool_T ::
+reuseTest()
+{
+   TUDEF("NavFilterPoolAllocator", "allocate");
+   NavFilterPoolAllocator<NavFilterKey*> alloc;
+   NavFilterKey **p1 = alloc.allocate(1);
+   alloc.deallocate(p1, 1);
+   NavFilterKey **p2 = alloc.allocate(1);
+      // the most recently freed block is handed out first
+   TUASSERTE(NavFilterKey**, p1, p2);
+   NavFilterKey **p3 = alloc.allocate(1);
+   TUASSERT(p3 != p2);
+   alloc.deallocate(p3, 1);
+   alloc.deallocate(p2, 1);
+      // arrays don't come from the pool
+   NavFilterKey **arr = alloc.allocate(5);
+   for (unsigned i = 0; i < 5; i++)
+      arr[i] = nullptr;
+   alloc.deallocate(arr, 5);
+      // rebound copies are interchangeable
+   NavFilterPoolAllocator<double> other(alloc);
+   TUASSERT(other == alloc);
+   TUASSERT(!(other != alloc));
+   TURETURN();
+}
+
+
+unsigned NavFilterPool_T ::
+spliceTest()
+{
+   TUDEF("NavFilter::NavMsgList", "splice");
+   LNavFilterData fd[10];
+   NavFilter::NavMsgList l1, l2;
+   for (unsigned i = 0; i < 10; i++)
+      ((i & 1) ? l1 : l2).push_back(&fd[i]);
+   l1.splice(l1.end(), l2);
+   TUASSERTE(size_t, 10, l1.size());
+   TUASSERT(l2.empty());
+   l2.swap(l1);
+   TUASSERTE(size_t, 10, l2.size());
+   TUASSERT(l1.empty());
+   NavFilter::NavMsgList l3(l2);
+   TUASSERT(l3 == l2);
+   l2.clear();
+   TUASSERTE(size_t, 10, l3.size());
+   TURETURN();
+}
+
+
+unsigned NavFilterPool_T ::
+threadTest()
+{
+   TUDEF("NavFilter::NavMsgList", "allocate");
+   LNavFilterData fd;
+   const unsigned count = 5000;
+   NavFilter::NavMsgList fromThread;
+      // nodes allocated in a thread that exits before they are freed
+   std::thread producer([&fromThread, &fd]()
+                        {
+                           for (unsigned i = 0; i < count; i++)
+                              fromThread.push_back(&fd);
+                        });
+   producer.join();
+   TUASSERTE(size_t, count, fromThread.size());
+   fromThread.clear();
+      // several threads churning through the pool at once
+   std::vector<std::thread> workers;
+   std::vector<size_t> sizes(4, 0);
+   for (unsigned t = 0; t < sizes.size(); t++)
+   {
+      workers.push_back(std::thread(
+         [t, &sizes, &fd]()
+         {
+            NavFilter::NavMsgList held, scratch;
+            for (unsigned rep = 0; rep < 200; rep++)
+            {
+               for (unsigned i = 0; i < 100; i++)
+                  scratch.push_back(&fd);
+               held.splice(held.end(), scratch, scratch.begin());
+               scratch.clear();
+            }
+            sizes[t] = held.size();
+         }));
+   }
+   for (unsigned t = 0; t < workers.size(); t++)
+      workers[t].join();
+   for (unsigned t = 0; t < sizes.size(); t++)
+      TUASSERTE(size_t, 200, sizes[t]);
+   TURETURN();
+}
+
+
+unsigned NavFilterPool_T ::
+crossSourceTest()
+{
+   TUDEF("LNavCrossSourceFilter", "validate");
+   CommonTime t1(GPSWeekSecond(1869, 6.0)), t2(GPSWeekSecond(1869, 12.0));
+   LNavFilterData fd[6];
+   uint32_t *words[6] = { sfGood, sfGood, sfBad, sfGood, sfGood, sfGood };
+   NavFilterMgr mgr;
+   LNavCrossSourceFilter filtXS;
+   mgr.addFilter(&filtXS);
+   NavFilter::NavMsgList l;
+   for (unsigned rep = 0; rep < 3; rep++)
+   {
+      for (unsigned i = 0; i < 6; i++)
+      {
+         fd[i].sf = words[i];
+         fd[i].prn = 1;
+         fd[i].stationID = std::string(1, 'a' + (i % 3));
+         fd[i].timeStamp = (i < 3) ? t1 : t2;
+      }
+      for (unsigned i = 0; i < 3; i++)
+      {
+         l = mgr.validate(&fd[i]);
+         TUASSERT(l.empty());
+      }
+         // the next epoch triggers the vote on the first
+      l = mgr.validate(&fd[3]);
+      TUASSERTE(size_t, 2, l.size());
+      TUASSERT(l.front() == &fd[0] || l.front() == &fd[1]);
+      TUASSERT(l.back() == &fd[0] || l.back() == &fd[1]);
+      TUASSERTE(size_t, 1, filtXS.rejected.size());
+      TUASSERT(filtXS.rejected.front() == &fd[2]);
+      filtXS.rejected.clear();
+      mgr.validate(&fd[4]);
+      mgr.validate(&fd[5]);
+      l = mgr.finalize();
+      TUASSERTE(size_t, 3, l.size());
+      TUASSERT(filtXS.rejected.empty());
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+
+   NavFilterPool_T testClass;
+
+   errorTotal += testClass.reuseTest();
+   errorTotal += testClass.spliceTest();
+   errorTotal += testClass.threadTest();
+   errorTotal += testClass.crossSourceTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal; // Return the total number of errors
+}
@@ -164,6 +164,11 @@ public:
    unsigned isPresentTest();
    unsigned countTest();
    unsigned getFirstLastTimeTest();
+      /// Make sure frozen searches yield the same results as unfrozen.
+   unsigned freezeTest();
+      /** Make sure frozen wildcard searches using the per-satellite
+       * index yield the same results as unfrozen. */
+   unsigned freezeWildTest();
 
       /// Fill fact with test data
    void fillFactory(gnsstk::TestUtil& testFramework, TestClass& fact);
@@ -2143,6 +2148,219 @@ getFirstLastTimeTest()
    TURETURN();
 }
 
+unsigned NavDataFactoryWithStore_T ::
+freezeTest()
+{
+   TUDEF("NavDataFactoryWithStore", "freeze");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refsf1ct = gnsstk::GPSWeekSecond(2101, 0);
+   gnsstk::CommonTime refpg2ct = gnsstk::GPSWeekSecond(2101, 54);
+   const std::vector<gnsstk::NavMessageID> nmids {
+      {gnsstk::NavSatelliteID(2, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+       MT::Almanac},
+      {gnsstk::NavSatelliteID(2, SS::GPS, CB::Any, TC::Any, NT::Any),
+       MT::Almanac},
+      {gnsstk::NavSatelliteID(2, 1, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+       MT::Almanac},
+      {gnsstk::NavSatelliteID(2, 3, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+       MT::Almanac},
+      {gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+       MT::Health},
+      {gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+       MT::Ephemeris},
+      {gnsstk::NavSatelliteID(1, SS::GPS, CB::Any, TC::Any, NT::Any),
+       MT::Ephemeris},
+      {gnsstk::NavSatelliteID(3, SS::GPS, CB::L2, TC::Y, NT::GPSLNAV),
+       MT::Ephemeris},
+      {gnsstk::NavSatelliteID(4, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+       MT::Ephemeris},
+      {gnsstk::NavSatelliteID(1, SS::GPS, CB::L1, TC::CA, NT::GPSLNAV),
+       MT::Clock},
+   };
+      // fill with "almanac pages"
+   for (unsigned i = 0; i < 10; i++)
+   {
+      for (unsigned long xmit = 1; xmit <= 3; xmit += 2)
+      {
+         addData(testFramework, uut, refpg2ct + (750*i), 2, xmit, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV, SH::Healthy, MT::Almanac);
+         addData(testFramework, uut, refpg2ct + (750*i), 2, xmit, SS::GPS,
+                 CB::L2, TC::Y, NT::GPSLNAV, SH::Healthy, MT::Almanac);
+      }
+   }
+      // add health and ephemerides, with some unhealthy periods
+   for (unsigned i = 0; i < 228; i++)
+   {
+      for (unsigned long sat = 1; sat <= 3; sat++)
+      {
+         SH hea = (((i >= 57) && (sat == 1)) ? SH::Unhealthy : SH::Healthy);
+         addData(testFramework, uut, refsf1ct + (30*i), sat, sat, SS::GPS,
+                 CB::L1, TC::CA, NT::GPSLNAV, hea, MT::Health);
+         addData(testFramework, uut, refsf1ct + (30*i), sat, sat, SS::GPS,
+                 CB::L2, TC::Y, NT::GPSLNAV, hea, MT::Health);
+         if ((i % 20) == 0)
+         {
+            addData(testFramework, uut, refsf1ct + (30*i), sat, sat, SS::GPS,
+                    CB::L1, TC::CA, NT::GPSLNAV, hea, MT::Ephemeris);
+            addData(testFramework, uut, refsf1ct + (30*i), sat, sat, SS::GPS,
+                    CB::L2, TC::Y, NT::GPSLNAV, hea, MT::Ephemeris);
+         }
+      }
+   }
+   TestClass frozenUut(uut);
+   TUASSERTE(bool, false, frozenUut.isFrozen());
+   frozenUut.freeze();
+   TUASSERTE(bool, true, frozenUut.isFrozen());
+   TUASSERTE(size_t, uut.size(), frozenUut.size());
+   unsigned numFound = 0;
+   for (const auto& nmid : nmids)
+   {
+      for (double offs = -100; offs < 9000; offs += 97)
+      {
+         gnsstk::CommonTime when(refsf1ct + offs);
+         for (SO order : {SO::User, SO::Nearest})
+         {
+            for (SH hea : {SH::Any, SH::Healthy, SH::Unhealthy})
+            {
+               for (VT valid : {VT::Any, VT::ValidOnly, VT::InvalidOnly})
+               {
+                  gnsstk::NavDataPtr expected, got;
+                  bool expRV = uut.find(nmid, when, expected, hea, valid,
+                                        order);
+                  bool gotRV = frozenUut.find(nmid, when, got, hea, valid,
+                                              order);
+                  TUASSERTE(bool, expRV, gotRV);
+                  TUASSERT(expected == got);
+                  if (expRV)
+                     numFound++;
+               }
+            }
+         }
+      }
+   }
+      // make sure the comparisons above weren't all trivially empty
+   TUASSERT(numFound > 1000);
+      // changing the store must discard the index
+   addData(testFramework, frozenUut, refsf1ct + 9000, 1, 1);
+   TUASSERTE(bool, false, frozenUut.isFrozen());
+   frozenUut.freeze();
+   TUASSERTE(bool, true, frozenUut.isFrozen());
+   frozenUut.edit(refsf1ct, refsf1ct + 60);
+   TUASSERTE(bool, false, frozenUut.isFrozen());
+   frozenUut.freeze();
+   frozenUut.clear();
+   TUASSERTE(bool, false, frozenUut.isFrozen());
+   TURETURN();
+}
+
+
+unsigned NavDataFactoryWithStore_T ::
+freezeWildTest()
+{
+   TUDEF("NavDataFactoryWithStore", "freeze");
+   TestClass uut;
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using MT = gnsstk::NavMessageType;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::CommonTime refct = gnsstk::GPSWeekSecond(2101, 0);
+   const std::vector<SS> systems {
+      SS::GPS, SS::Galileo, SS::BeiDou, SS::QZSS };
+      // Fill with almanac data for 10 satellites in each system,
+      // transmitted by 3 different satellites on 2 signals, and
+      // ephemerides on 2 signals.
+   for (SS sys : systems)
+   {
+      for (unsigned long sat = 1; sat <= 10; sat++)
+      {
+         for (unsigned i = 0; i < 8; i++)
+         {
+            gnsstk::CommonTime t(refct + (750*i) + sat);
+            for (unsigned long xmit = sat; xmit < sat+3; xmit++)
+            {
+               addData(testFramework, uut, t, sat, xmit, sys, CB::L1,
+                       TC::CA, NT::GPSLNAV, SH::Healthy, MT::Almanac);
+               addData(testFramework, uut, t, sat, xmit, sys, CB::L2,
+                       TC::Y, NT::GPSLNAV, SH::Healthy, MT::Almanac);
+            }
+            addData(testFramework, uut, t, sat, sat, sys, CB::L1,
+                    TC::CA, NT::GPSLNAV, SH::Healthy, MT::Ephemeris);
+            addData(testFramework, uut, t, sat, sat, sys, CB::L2,
+                    TC::Y, NT::GPSLNAV, SH::Healthy, MT::Ephemeris);
+         }
+      }
+   }
+   TestClass frozenUut(uut);
+   frozenUut.freeze();
+   TUASSERTE(bool, true, frozenUut.isFrozen());
+   std::vector<gnsstk::NavMessageID> nmids;
+   for (SS sys : systems)
+   {
+      for (unsigned long sat = 0; sat <= 11; sat += 3)
+      {
+         for (MT mt : {MT::Almanac, MT::Ephemeris})
+         {
+               // all signals and transmitting satellites
+            nmids.push_back(gnsstk::NavMessageID(
+                               gnsstk::NavSatelliteID(gnsstk::SatID(sat,sys)),
+                               mt));
+               // specific signal, any transmitting satellite
+            nmids.push_back(gnsstk::NavMessageID(
+                               gnsstk::NavSatelliteID(sat, sys, CB::L2, TC::Y,
+                                                      NT::GPSLNAV),
+                               mt));
+               // specific transmitting satellite, any signal
+            nmids.push_back(gnsstk::NavMessageID(
+                               gnsstk::NavSatelliteID(sat, sat+1, sys, CB::Any,
+                                                      TC::Any, NT::Any),
+                               mt));
+         }
+      }
+         // any satellite in the system
+      gnsstk::NavMessageID nmid(
+         gnsstk::NavSatelliteID(gnsstk::SatID(sys)), MT::Almanac);
+      nmid.sat.makeWild();
+      nmid.sat.system = sys;
+      nmid.sat.wildSys = false;
+      nmids.push_back(nmid);
+   }
+   unsigned numFound = 0;
+   for (const auto& nmid : nmids)
+   {
+      for (double offs = -100; offs < 7000; offs += 331)
+      {
+         gnsstk::CommonTime when(refct + offs);
+         for (SO order : {SO::User, SO::Nearest})
+         {
+            gnsstk::NavDataPtr expected, got;
+            bool expRV = uut.find(nmid, when, expected, SH::Any, VT::Any,
+                                  order);
+            bool gotRV = frozenUut.find(nmid, when, got, SH::Any, VT::Any,
+                                        order);
+            TUASSERTE(bool, expRV, gotRV);
+            TUASSERT(expected == got);
+            if (expRV)
+               numFound++;
+         }
+      }
+   }
+   TUASSERT(numFound > 500);
+   TURETURN();
+}
+
+
 
 int main()
 {
@@ -2164,6 +2382,8 @@ int main()
    errorTotal += testClass.isPresentTest();
    errorTotal += testClass.countTest();
    errorTotal += testClass.getFirstLastTimeTest();
+   errorTotal += testClass.freezeTest();
+   errorTotal += testClass.freezeWildTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
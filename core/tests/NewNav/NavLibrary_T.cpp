@@ -43,6 +43,9 @@
 #include "GPSLNavHealth.hpp"
 #include "GPSLNavTimeOffset.hpp"
 #include "TimeString.hpp"
+#include <algorithm>
+#include <cmath>
+#include <thread>
 
 namespace gnsstk
 {
@@ -136,6 +139,9 @@ public:
       /** Make sure that NavLibrary::getXvt pulls the correct
        * ephemeris and computes the correct xvt. */
    unsigned getXvtTest();
+      /** Make sure that NavLibrary::getXvts produces the same
+       * results as NavLibrary::getXvt. */
+   unsigned getXvtsTest();
    unsigned getHealthTest();
    unsigned getOffsetTest();
    unsigned findTest();
@@ -157,6 +163,9 @@ public:
    unsigned isPresentTest();
    unsigned getIonoCorrTest();
    unsigned getISCTest();
+      /** Make sure that searches of a frozen NavLibrary from
+       * multiple threads give the same results as a single thread. */
+   unsigned concurrentTest();
 
    gnsstk::CivilTime civ;
    gnsstk::CommonTime ct;
@@ -209,6 +218,96 @@ getXvtTest()
 }
 
 
+unsigned NavLibrary_T ::
+getXvtsTest()
+{
+   TUDEF("NavLibrary", "getXvts");
+   gnsstk::NavLibrary navLib;
+   gnsstk::NavDataFactoryPtr
+      ndfp(std::make_shared<RinexTestFactory>());
+   std::string fname = gnsstk::getPathData() + gnsstk::getFileSep() +
+      "arlm2000.15n";
+   TUCATCH(navLib.addFactory(ndfp));
+   RinexTestFactory *rndfp =
+      dynamic_cast<RinexTestFactory*>(ndfp.get());
+   TUASSERT(rndfp->addDataSource(fname));
+   std::vector<gnsstk::NavSatelliteID> sats;
+      // PRN 33 is not in the data and should produce failed results.
+   for (unsigned long prn : {1, 5, 7, 33, 12, 30})
+   {
+      sats.push_back(gnsstk::NavSatelliteID(
+                        prn, prn, gnsstk::SatelliteSystem::GPS,
+                        gnsstk::CarrierBand::L1, gnsstk::TrackingCode::CA,
+                        gnsstk::NavType::GPSLNAV));
+   }
+   std::vector<gnsstk::CommonTime> times;
+      // enough times for getXvts to use more than one thread
+   for (double offs = -7200; offs < 86400; offs += 120)
+   {
+      times.push_back(ct + offs);
+   }
+   std::vector<gnsstk::Xvt> expXvts(sats.size() * times.size());
+   size_t expCount = 0;
+   for (size_t i = 0; i < sats.size(); i++)
+   {
+      for (size_t j = 0; j < times.size(); j++)
+      {
+         gnsstk::Xvt& xvt(expXvts[i*times.size()+j]);
+         if (navLib.getXvt(sats[i], times[j], xvt, gnsstk::ObsID()))
+         {
+            expCount++;
+         }
+         else
+         {
+            xvt.health = gnsstk::Xvt::Unavailable;
+         }
+      }
+   }
+      // make sure the test data is actually exercising something
+   TUASSERT(expCount > 0);
+   TUASSERT(expCount < expXvts.size());
+   TUASSERT(times.size() > gnsstk::NavLibrary::minXvtsPerThread);
+   gnsstk::ThreadPool pool2(2), pool4(4), pool64(64);
+   for (gnsstk::ThreadPool *pool : {(gnsstk::ThreadPool*)nullptr, &pool2,
+                                    &pool4, &pool64})
+   {
+      std::vector<gnsstk::Xvt> xvts;
+      TUASSERTE(size_t, expCount,
+                navLib.getXvts(sats, times, xvts, gnsstk::ObsID(),
+                               gnsstk::SVHealth::Any,
+                               gnsstk::NavValidityType::ValidOnly,
+                               gnsstk::NavSearchOrder::User, pool));
+      TUASSERTE(size_t, expXvts.size(), xvts.size());
+         // count rather than assert each of the many results
+      unsigned mismatches = 0;
+      for (size_t k = 0; k < expXvts.size() && k < xvts.size(); k++)
+      {
+         if ((expXvts[k].health != xvts[k].health) ||
+             ((expXvts[k].health != gnsstk::Xvt::Unavailable) &&
+              (!(expXvts[k].x == xvts[k].x) ||
+               !(expXvts[k].v == xvts[k].v) ||
+               (expXvts[k].clkbias != xvts[k].clkbias) ||
+               (expXvts[k].clkdrift != xvts[k].clkdrift) ||
+               (expXvts[k].relcorr != xvts[k].relcorr))))
+         {
+            mismatches++;
+         }
+      }
+      TUASSERTE(unsigned, 0, mismatches);
+   }
+      // empty input should produce empty output
+   std::vector<gnsstk::Xvt> xvts(3);
+   TUASSERTE(size_t, 0, navLib.getXvts(sats, std::vector<gnsstk::CommonTime>(),
+                                       xvts, gnsstk::ObsID(),
+                                       gnsstk::SVHealth::Any,
+                                       gnsstk::NavValidityType::ValidOnly,
+                                       gnsstk::NavSearchOrder::User,
+                                       &pool4));
+   TUASSERTE(size_t, 0, xvts.size());
+   TURETURN();
+}
+
+
 unsigned NavLibrary_T ::
 getHealthTest()
 {
@@ -631,12 +730,174 @@ getISCTest()
 }
 
 
+unsigned NavLibrary_T ::
+concurrentTest()
+{
+   TUDEF("NavLibrary", "freeze");
+   using SS = gnsstk::SatelliteSystem;
+   using CB = gnsstk::CarrierBand;
+   using TC = gnsstk::TrackingCode;
+   using NT = gnsstk::NavType;
+   using SH = gnsstk::SVHealth;
+   using VT = gnsstk::NavValidityType;
+   using SO = gnsstk::NavSearchOrder;
+   gnsstk::NavLibrary navLib;
+   std::shared_ptr<TestFactory> fact(std::make_shared<TestFactory>());
+   gnsstk::NavDataFactoryPtr ndfp(fact);
+   TUCATCH(navLib.addFactory(ndfp));
+      // Generate two-hourly ephemerides and half-minute health for
+      // a day, with a PRN that goes unhealthy part way through.
+   unsigned addFails = 0;
+   for (unsigned long prn = 1; prn <= 12; prn++)
+   {
+      gnsstk::NavSatelliteID sat(prn, prn, SS::GPS, CB::L1, TC::CA,
+                                 NT::GPSLNAV);
+      for (unsigned i = 0; i < 2880; i++)
+      {
+         std::shared_ptr<gnsstk::GPSLNavHealth> hea(
+            std::make_shared<gnsstk::GPSLNavHealth>());
+         hea->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Health);
+         hea->timeStamp = ct + (30.0*i);
+         hea->svHealth = (((prn == 7) && (i > 1500)) ? 1 : 0);
+         addFails += (fact->addNavData(hea) ? 0 : 1);
+         if ((i % 240) != 0)
+            continue;
+         std::shared_ptr<gnsstk::GPSLNavEph> eph(
+            std::make_shared<gnsstk::GPSLNavEph>());
+         eph->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Ephemeris);
+         eph->timeStamp = hea->timeStamp;
+         eph->xmitTime = eph->xmit2 = eph->xmit3 = eph->timeStamp;
+         eph->Toe = eph->Toc = eph->timeStamp + 7200.0;
+         eph->A = 26559700.0 + prn;
+         eph->Ahalf = ::sqrt(eph->A);
+         eph->ecc = 0.001 * prn;
+         eph->i0 = 0.95;
+         eph->M0 = 0.5 * prn + 0.001 * i;
+         eph->OMEGA0 = 0.25 * prn;
+         eph->w = 0.1;
+         eph->af0 = 1e-5 * prn;
+         eph->healthBits = hea->svHealth;
+         eph->health = (hea->svHealth ? SH::Unhealthy : SH::Healthy);
+         eph->fixFit();
+         addFails += (fact->addNavData(eph) ? 0 : 1);
+      }
+   }
+   TUASSERTE(unsigned, 0, addFails);
+   TUCATCH(navLib.freeze());
+   TUASSERTE(bool, true, fact->isFrozen());
+      // Satellites including a wildcard and one with no data.
+   std::vector<gnsstk::NavSatelliteID> sats;
+   for (unsigned long prn = 1; prn <= 13; prn++)
+   {
+      sats.push_back(gnsstk::NavSatelliteID(prn, prn, SS::GPS, CB::L1,
+                                            TC::CA, NT::GPSLNAV));
+   }
+   sats.push_back(gnsstk::NavSatelliteID(7, SS::GPS, CB::Any, TC::Any,
+                                         NT::Any));
+   std::vector<gnsstk::CommonTime> times;
+   for (double offs = -600; offs < 90000; offs += 317)
+   {
+      times.push_back(ct + offs);
+   }
+      // Search results in the order they're computed by search().
+   class Results
+   {
+   public:
+      std::vector<gnsstk::Xvt> xvts;
+      std::vector<bool> xvtOK, healthOK;
+      std::vector<SH> health;
+   };
+   auto search = [&](Results& res)
+   {
+      for (SO order : {SO::User, SO::Nearest})
+      {
+         for (const auto& sat : sats)
+         {
+            for (const auto& when : times)
+            {
+               gnsstk::Xvt xvt;
+               SH hea = SH::Unknown;
+               res.xvtOK.push_back(navLib.getXvt(sat, when, xvt,
+                                                 gnsstk::ObsID(), SH::Any,
+                                                 VT::Any, order));
+               res.xvts.push_back(xvt);
+               res.healthOK.push_back(navLib.getHealth(sat, when, hea,
+                                                       SH::Any, VT::Any,
+                                                       order));
+               res.health.push_back(hea);
+            }
+         }
+      }
+   };
+   Results expected;
+   search(expected);
+   size_t numOK = std::count(expected.xvtOK.begin(), expected.xvtOK.end(),
+                             true);
+      // make sure the test data is actually exercising something
+   TUASSERT(numOK > expected.xvtOK.size() / 2);
+   TUASSERT(numOK < expected.xvtOK.size());
+   TUASSERT(std::count(expected.health.begin(), expected.health.end(),
+                       SH::Unhealthy) > 0);
+      // Now do the same searches repeatedly from several threads.
+      // The test framework isn't thread-safe, so just count
+      // differences in each thread and check them after joining.
+   const unsigned numThreads = 8, numPasses = 4;
+   std::vector<unsigned> errors(numThreads, 0);
+   std::vector<std::thread> threads;
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      threads.emplace_back(
+         [&search, &expected, &errors, t]()
+         {
+            for (unsigned pass = 0; pass < numPasses; pass++)
+            {
+               Results got;
+               search(got);
+               if ((got.xvtOK != expected.xvtOK) ||
+                   (got.healthOK != expected.healthOK) ||
+                   (got.health != expected.health) ||
+                   (got.xvts.size() != expected.xvts.size()))
+               {
+                  errors[t]++;
+                  continue;
+               }
+               for (size_t i = 0; i < got.xvts.size(); i++)
+               {
+                     // bit-identical results are expected
+                  if (!(got.xvts[i].x == expected.xvts[i].x) ||
+                      !(got.xvts[i].v == expected.xvts[i].v) ||
+                      (got.xvts[i].clkbias != expected.xvts[i].clkbias) ||
+                      (got.xvts[i].clkdrift != expected.xvts[i].clkdrift) ||
+                      (got.xvts[i].relcorr != expected.xvts[i].relcorr) ||
+                      (got.xvts[i].health != expected.xvts[i].health))
+                  {
+                     errors[t]++;
+                  }
+               }
+            }
+         });
+   }
+   for (auto& thr : threads)
+   {
+      thr.join();
+   }
+   for (unsigned t = 0; t < numThreads; t++)
+   {
+      TUASSERTE(unsigned, 0, errors[t]);
+   }
+   TURETURN();
+}
+
+
 int main()
 {
    NavLibrary_T testClass;
    unsigned errorTotal = 0;
 
    errorTotal += testClass.getXvtTest();
+   errorTotal += testClass.getXvtsTest();
    errorTotal += testClass.getHealthTest();
    errorTotal += testClass.getOffsetTest();
    errorTotal += testClass.findTest();
@@ -649,6 +910,7 @@ int main()
    errorTotal += testClass.isPresentTest();
    errorTotal += testClass.getIonoCorrTest();
    errorTotal += testClass.getISCTest();
+   errorTotal += testClass.concurrentTest();
       /// @todo test edit(), clear()
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
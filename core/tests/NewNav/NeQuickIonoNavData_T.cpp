@@ -96,6 +96,15 @@ public:
    unsigned getTECTest();
       /// Test NeQuickIonoNavData::getIonoCorr
    unsigned getIonoCorrTest();
+      /// Test the all-satellites NeQuickIonoNavData::getTEC
+   unsigned getTECBatchTest();
+      /// Test the all-satellites NeQuickIonoNavData::getIonoCorr
+   unsigned getIonoCorrBatchTest();
+      /** Split testDataTEC into runs of consecutive entries sharing
+       * the same coefficients, time and station, i.e. the satellites
+       * seen by one receiver at one epoch.
+       * @return [begin,end) index pairs into testDataTEC. */
+   static std::vector<std::pair<unsigned,unsigned> > getTECEpochs();
 
       /// Hold input/truth data for legendreTest
    class TestData
@@ -930,6 +939,107 @@ getIonoCorrTest()
 }
 
 
+std::vector<std::pair<unsigned,unsigned> > NeQuickIonoNavData_T ::
+getTECEpochs()
+{
+   std::vector<std::pair<unsigned,unsigned> > rv;
+   unsigned numTests = sizeof(testDataTEC)/sizeof(testDataTEC[0]);
+   unsigned begin = 0;
+   for (unsigned testNum = 1; testNum <= numTests; testNum++)
+   {
+      if ((testNum == numTests) ||
+          (testDataTEC[testNum].coefficients !=
+           testDataTEC[begin].coefficients) ||
+          (testDataTEC[testNum].ct != testDataTEC[begin].ct) ||
+          (testDataTEC[testNum].station != testDataTEC[begin].station))
+      {
+         rv.push_back(std::make_pair(begin, testNum));
+         begin = testNum;
+      }
+   }
+   return rv;
+}
+
+
+unsigned NeQuickIonoNavData_T ::
+getTECBatchTest()
+{
+   using namespace std;
+   TUDEF("NeQuickIonoNavData", "getTEC(vector)");
+   vector<pair<unsigned,unsigned> > epochs(getTECEpochs());
+   TestClass uut;
+      // the test vectors are 3 satellites per epoch, except for
+      // the vertical one at the end.
+   TUASSERTE(size_t, 37, epochs.size());
+   for (unsigned e = 0; e < epochs.size(); e++)
+   {
+      const TestDataTEC& first(testDataTEC[epochs[e].first]);
+      uut.ai[0] = first.coefficients[0];
+      uut.ai[1] = first.coefficients[1];
+      uut.ai[2] = first.coefficients[2];
+      vector<gnsstk::Position> svgeo;
+      for (unsigned i = epochs[e].first; i < epochs[e].second; i++)
+      {
+         svgeo.push_back(testDataTEC[i].satellite);
+      }
+      vector<double> tec;
+      TUCATCH(uut.getTEC(first.ct, first.station, svgeo, tec));
+      TUASSERTE(size_t, svgeo.size(), tec.size());
+      for (unsigned i = epochs[e].first; i < epochs[e].second; i++)
+      {
+         const TestDataTEC& td(testDataTEC[i]);
+         unsigned j = i - epochs[e].first;
+         TUASSERTFEPS(td.expTEC, tec[j], docEps);
+            // must be the same as doing one satellite at a time
+         TUASSERTFE(uut.getTEC(td.ct, td.station, td.satellite), tec[j]);
+      }
+   }
+      // no satellites, no results
+   vector<double> tec(3, 1.0);
+   TUCATCH(uut.getTEC(testDataTEC[0].ct, testDataTEC[0].station,
+                      vector<gnsstk::Position>(), tec));
+   TUASSERTE(size_t, 0, tec.size());
+   TURETURN();
+}
+
+
+unsigned NeQuickIonoNavData_T ::
+getIonoCorrBatchTest()
+{
+   using namespace std;
+   TUDEF("NeQuickIonoNavData", "getIonoCorr(vector)");
+   vector<pair<unsigned,unsigned> > epochs(getTECEpochs());
+   TestClass uut;
+   const double factorL1 = getFactor(gnsstk::CarrierBand::L1);
+   for (unsigned e = 0; e < epochs.size(); e++)
+   {
+      const TestDataTEC& first(testDataTEC[epochs[e].first]);
+      uut.ai[0] = first.coefficients[0];
+      uut.ai[1] = first.coefficients[1];
+      uut.ai[2] = first.coefficients[2];
+      vector<gnsstk::Position> svgeo;
+      for (unsigned i = epochs[e].first; i < epochs[e].second; i++)
+      {
+         svgeo.push_back(testDataTEC[i].satellite);
+      }
+      vector<double> corr;
+      TUCATCH(uut.getIonoCorr(first.ct, first.station, svgeo,
+                              gnsstk::CarrierBand::L1, corr));
+      TUASSERTE(size_t, svgeo.size(), corr.size());
+      for (unsigned i = epochs[e].first; i < epochs[e].second; i++)
+      {
+         const TestDataTEC& td(testDataTEC[i]);
+         unsigned j = i - epochs[e].first;
+         TUASSERTFEPS(td.expTEC * factorL1 * 1e16, corr[j], docEps);
+         TUASSERTFE(uut.getIonoCorr(td.ct, td.station, td.satellite,
+                                    gnsstk::CarrierBand::L1),
+                    corr[j]);
+      }
+   }
+   TURETURN();
+}
+
+
 int main(int argc, char *argv[])
 {
    NeQuickIonoNavData_T testClass;
@@ -946,6 +1056,8 @@ int main(int argc, char *argv[])
    errorTotal += testClass.thicknessTest();
    errorTotal += testClass.getTECTest();
    errorTotal += testClass.getIonoCorrTest();
+   errorTotal += testClass.getTECBatchTest();
+   errorTotal += testClass.getIonoCorrBatchTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
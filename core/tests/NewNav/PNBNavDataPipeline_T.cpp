@@ -0,0 +1,472 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "PNBNavDataPipeline.hpp"
+#include "PNBMultiGNSSNavDataFactory.hpp"
+#include "RinexNavDataFactory.hpp"
+#include "GPSWeekSecond.hpp"
+#include "TestUtil.hpp"
+
+namespace gnsstk
+{
+   std::ostream& operator<<(std::ostream& s, gnsstk::NavMessageType e)
+   {
+      s << StringUtils::asString(e);
+      return s;
+   }
+}
+
+
+class PNBNavDataPipeline_T
+{
+public:
+   PNBNavDataPipeline_T();
+   unsigned newFactoryTest();
+   unsigned addDataTest();
+   unsigned recordTest();
+   unsigned overflowTest();
+      /// Make sure stop() releases a blocked addData() and rejects later ones.
+   unsigned stopTest();
+      /// Change the decoders' filters while data is being decoded.
+   unsigned filterTest();
+      /// Make sure idle threads sleep rather than poll.
+   unsigned idleTest();
+
+      /// Compare the contents of two stores, message type by message type.
+   void compareStores(gnsstk::TestUtil& testFramework,
+                      gnsstk::NavDataFactoryWithStore& expected,
+                      gnsstk::NavDataFactoryWithStore& got);
+
+#include "LNavTestDataDecl.hpp"
+#include "CNavTestDataDecl.hpp"
+
+      /// All the test subframes, in transmit order within each signal.
+   std::vector<gnsstk::PackedNavBitsPtr> allPNB;
+};
+
+
+PNBNavDataPipeline_T ::
+PNBNavDataPipeline_T()
+{
+#include "LNavTestDataDef.hpp"
+#include "CNavTestDataDef.hpp"
+   allPNB = { ephLNAVGPSSF1, ephLNAVGPSSF2, ephLNAVGPSSF3, almLNAVGPS25,
+              almLNAVGPS26, pg56LNAVGPS, pg63LNAVGPS, pg51LNAVGPS,
+              ephLNAVQZSSSF1, ephLNAVQZSSSF2, ephLNAVQZSSSF3, almLNAVQZSS1,
+              almLNAVQZSS2, pg56LNAVQZSS, pg61LNAVQZSS, pg51LNAVQZSS,
+              msg10CNAVGPSL2, msg11CNAVGPSL2, msg30CNAVGPSL2, msg32CNAVGPSL2,
+              msg33CNAVGPSL2, msg10CNAVQZSSL5, msg11CNAVQZSSL5,
+              msg30CNAVQZSSL5, msg31CNAVQZSSL5, msg12CNAVQZSSL5,
+              msg32CNAVQZSSL5, msg35CNAVQZSSL5,
+              msg37CNAVQZSSL5 };
+}
+
+
+void PNBNavDataPipeline_T ::
+compareStores(gnsstk::TestUtil& testFramework,
+              gnsstk::NavDataFactoryWithStore& expected,
+              gnsstk::NavDataFactoryWithStore& got)
+{
+   TUASSERTE(size_t, expected.size(), got.size());
+   for (const auto& nmt : gnsstk::allNavMessageTypes)
+   {
+      TUCSM(
+         "compareStores " + gnsstk::StringUtils::asString(nmt));
+      TUASSERTE(size_t, expected.count(nmt), got.count(nmt));
+   }
+}
+
+
+unsigned PNBNavDataPipeline_T ::
+newFactoryTest()
+{
+   TUDEF("PNBNavDataPipeline", "newFactory()");
+   TUASSERT(gnsstk::PNBNavDataPipeline::newFactory(gnsstk::NavType::GPSLNAV)
+            != nullptr);
+   TUASSERT(gnsstk::PNBNavDataPipeline::newFactory(gnsstk::NavType::GalINAV)
+            != nullptr);
+   TUASSERT(gnsstk::PNBNavDataPipeline::newFactory(gnsstk::NavType::Unknown)
+            == nullptr);
+   TUASSERT(gnsstk::PNBNavDataPipeline::newFactory(gnsstk::NavType::GPSMNAV)
+            == nullptr);
+   TURETURN();
+}
+
+
+unsigned PNBNavDataPipeline_T ::
+addDataTest()
+{
+   TUDEF("PNBNavDataPipeline", "addData()");
+      // Decode everything synchronously for comparison.
+   gnsstk::RinexNavDataFactory expected;
+   gnsstk::PNBMultiGNSSNavDataFactory direct;
+   direct.setTypeFilter(gnsstk::allNavMessageTypes);
+   direct.setValidityFilter(gnsstk::NavValidityType::Any);
+   gnsstk::NavDataPtrList navOut;
+   for (const auto& pnb : allPNB)
+   {
+      direct.addData(pnb, navOut);
+   }
+   for (const auto& nd : navOut)
+   {
+      expected.addNavData(nd);
+   }
+   TUASSERT(expected.size() > 0);
+
+   gnsstk::RinexNavDataFactory store;
+   {
+      gnsstk::PNBNavDataPipeline uut(store);
+      uut.setTypeFilter(gnsstk::allNavMessageTypes);
+      uut.setValidityFilter(gnsstk::NavValidityType::Any);
+      for (const auto& pnb : allPNB)
+      {
+         TUASSERTE(bool, true, uut.addData(pnb));
+      }
+         // no decoder for this nav type
+      gnsstk::PackedNavBitsPtr mnav =
+         std::make_shared<gnsstk::PackedNavBits>(*ephLNAVGPSSF1);
+      mnav->setNavID(gnsstk::NavType::GPSMNAV);
+      TUASSERTE(bool, false, uut.addData(mnav));
+      uut.flush();
+      TUASSERTE(unsigned long, allPNB.size(), uut.getNumAccepted());
+      TUASSERTE(unsigned long, 0, uut.getNumDropped());
+      TUASSERTE(unsigned long, 0, uut.getNumRejected());
+      TUASSERTE(unsigned long, navOut.size(), uut.getNumStored());
+      compareStores(testFramework, expected, store);
+      TUCSM("addData()");
+         // every stored message has a latency
+      gnsstk::PNBNavDataPipeline::LatencyMap lat(uut.getLatency());
+      unsigned long latCount = 0;
+      for (const auto& li : lat)
+      {
+         unsigned long binCount = 0;
+         for (unsigned long b : li.second.bins)
+            binCount += b;
+         TUASSERTE(unsigned long, li.second.count, binCount);
+         TUASSERT(li.second.minSec <= li.second.maxSec);
+         TUASSERT(li.second.percentile(50) <= li.second.maxSec);
+         TUASSERTE(size_t, store.count(li.first), li.second.count);
+         latCount += li.second.count;
+      }
+      TUASSERTE(unsigned long, navOut.size(), latCount);
+      uut.resetLatency();
+      TUASSERTE(size_t, 0, uut.getLatency().size());
+   }
+
+      // Several producers at once.  Each signal is added by its own
+      // thread so that its subframes stay in order.
+   gnsstk::RinexNavDataFactory store2;
+   {
+      gnsstk::PNBNavDataPipeline uut(store2, 4);
+      uut.setTypeFilter(gnsstk::allNavMessageTypes);
+      uut.setValidityFilter(gnsstk::NavValidityType::Any);
+      std::vector<std::thread> threads;
+      for (unsigned t = 0; t < 4; t++)
+      {
+         threads.emplace_back([&, t] {
+            for (const auto& pnb : allPNB)
+            {
+               if ((pnb->getsatSys().system ==
+                    gnsstk::SatelliteSystem::QZSS) == (t / 2 == 1) &&
+                   (pnb->getNavID().navType ==
+                    gnsstk::NavType::GPSLNAV) == (t % 2 == 0))
+               {
+                  uut.addData(pnb);
+               }
+            }
+         });
+      }
+      for (auto& thr : threads)
+         thr.join();
+      uut.flush();
+      TUASSERTE(unsigned long, allPNB.size(), uut.getNumAccepted());
+   }
+   compareStores(testFramework, expected, store2);
+   TURETURN();
+}
+
+
+unsigned PNBNavDataPipeline_T ::
+recordTest()
+{
+   TUDEF("PNBNavDataPipeline", "writeRecord()");
+   std::stringstream recording;
+   recording << "# recorded test data" << std::endl << std::endl;
+   for (const auto& pnb : allPNB)
+   {
+      gnsstk::PNBNavDataPipeline::writeRecord(recording, *pnb);
+   }
+   std::string line;
+   std::getline(recording, line);
+   std::getline(recording, line);
+   TUCSM("readRecord()");
+   bool allMatch = true;
+   for (const auto& pnb : allPNB)
+   {
+      std::getline(recording, line);
+      gnsstk::PackedNavBitsPtr read =
+         gnsstk::PNBNavDataPipeline::readRecord(line);
+      allMatch &= (*read == *pnb);
+      allMatch &= (read->getNumBits() == pnb->getNumBits());
+      allMatch &= (read->getNavID() == pnb->getNavID());
+   }
+   TUASSERT(allMatch);
+   TUTHROW(gnsstk::PNBNavDataPipeline::readRecord("1 2 3"));
+   TUTHROW(gnsstk::PNBNavDataPipeline::readRecord(
+              "2457389 6 0 GPS GPS 4 L1 CA Bogus - 32 0x00000000"));
+
+   TUCSM("replay()");
+   recording.clear();
+   recording.seekg(0);
+   gnsstk::RinexNavDataFactory expected, store;
+   {
+      gnsstk::PNBNavDataPipeline uut(expected);
+      uut.setTypeFilter(gnsstk::allNavMessageTypes);
+      uut.setValidityFilter(gnsstk::NavValidityType::Any);
+      for (const auto& pnb : allPNB)
+         uut.addData(pnb);
+   }
+   {
+      gnsstk::PNBNavDataPipeline uut(store);
+      uut.setTypeFilter(gnsstk::allNavMessageTypes);
+      uut.setValidityFilter(gnsstk::NavValidityType::Any);
+      TUASSERTE(size_t, allPNB.size(), uut.replay(recording));
+   }
+   compareStores(testFramework, expected, store);
+   TUCSM("replay()");
+   try
+   {
+      gnsstk::RinexNavDataFactory ignored;
+      gnsstk::PNBNavDataPipeline uut(ignored);
+      uut.replay(std::string("no/such/recording.txt"));
+      TUFAIL("replay of a missing file did not throw");
+   }
+   catch (gnsstk::FileMissingException&)
+   {
+      TUPASS("replay of a missing file");
+   }
+   TURETURN();
+}
+
+
+unsigned PNBNavDataPipeline_T ::
+overflowTest()
+{
+   TUDEF("PNBNavDataPipeline", "addData() overflow");
+   const unsigned numAdd = 2000;
+   gnsstk::RinexNavDataFactory store;
+   {
+         // Drop: everything is either accepted or dropped.
+      gnsstk::PNBNavDataPipeline uut(store, 2,
+                                     gnsstk::PNBNavDataPipeline::Overflow::Drop);
+      unsigned numTrue = 0;
+      for (unsigned i = 0; i < numAdd; i++)
+      {
+         if (uut.addData(allPNB[i % allPNB.size()]))
+            numTrue++;
+      }
+      uut.flush();
+      TUASSERTE(unsigned long, numTrue, uut.getNumAccepted());
+      TUASSERTE(unsigned long, numAdd, uut.getNumAccepted() +
+                uut.getNumDropped());
+   }
+   {
+         // Block: nothing is dropped, however small the queues.
+      gnsstk::PNBNavDataPipeline uut(store, 2);
+      for (unsigned i = 0; i < numAdd; i++)
+      {
+         TUASSERTE(bool, true, uut.addData(allPNB[i % allPNB.size()]));
+      }
+      uut.flush();
+      TUASSERTE(unsigned long, numAdd, uut.getNumAccepted());
+      TUASSERTE(unsigned long, 0, uut.getNumDropped());
+   }
+   TURETURN();
+}
+
+
+/// A store whose sink thread can be held up, by blocking thaw().
+class GatedStore : public gnsstk::RinexNavDataFactory
+{
+public:
+   GatedStore() : open(true), numWaiting(0) {}
+   void thaw() override
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      numWaiting++;
+      cond.wait(lock, [this] { return open; });
+      numWaiting--;
+      gnsstk::RinexNavDataFactory::thaw();
+   }
+   void setOpen(bool o)
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         open = o;
+      }
+      cond.notify_all();
+   }
+   std::mutex mutex;
+   std::condition_variable cond;
+   bool open;
+   unsigned numWaiting;
+};
+
+
+unsigned PNBNavDataPipeline_T ::
+stopTest()
+{
+   TUDEF("PNBNavDataPipeline", "stop()");
+   GatedStore store;
+   store.setOpen(false);
+   gnsstk::PNBNavDataPipeline uut(store, 2);
+   uut.setTypeFilter(gnsstk::allNavMessageTypes);
+   uut.setValidityFilter(gnsstk::NavValidityType::Any);
+      // Fill every queue, until an addData() blocks.
+   std::atomic<unsigned> numAdded(0);
+   std::atomic<bool> lastResult(true);
+   std::thread adder([&]
+   {
+      while (lastResult)
+      {
+         lastResult = uut.addData(allPNB[numAdded % allPNB.size()]);
+         numAdded++;
+      }
+   });
+   unsigned prev = ~0u;
+   while (prev != numAdded)
+   {
+      prev = numAdded;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   }
+      // Stop while addData() is blocked, then let the store proceed.
+   std::thread stopper([&] { uut.stop(); });
+   adder.join();
+   TUASSERTE(bool, false, lastResult);
+   store.setOpen(true);
+   stopper.join();
+   TUASSERTE(bool, false, uut.addData(allPNB[0]));
+   TUASSERTE(unsigned long, numAdded-1, uut.getNumAccepted());
+   TUASSERTE(unsigned long, 0, uut.getNumDropped());
+      // Everything accepted was decoded and stored.
+   uut.flush();
+   TUASSERT(uut.getNumStored() > 0);
+   TUASSERT(store.size() > 0);
+   uut.stop();
+   TURETURN();
+}
+
+
+unsigned PNBNavDataPipeline_T ::
+filterTest()
+{
+   TUDEF("PNBNavDataPipeline", "setTypeFilter()");
+   gnsstk::RinexNavDataFactory store;
+   gnsstk::PNBNavDataPipeline uut(store, 4);
+   uut.setValidityFilter(gnsstk::NavValidityType::Any);
+   std::atomic<bool> done(false);
+   std::thread changer([&]
+   {
+      gnsstk::NavMessageTypeSet eph { gnsstk::NavMessageType::Ephemeris };
+      for (unsigned i = 0; !done; i++)
+      {
+         uut.setTypeFilter(i & 1 ? eph : gnsstk::allNavMessageTypes);
+         uut.setValidityFilter(i & 2 ? gnsstk::NavValidityType::ValidOnly
+                               : gnsstk::NavValidityType::Any);
+      }
+   });
+   for (unsigned i = 0; i < 5000; i++)
+   {
+      TUASSERTE(bool, true, uut.addData(allPNB[i % allPNB.size()]));
+   }
+   uut.flush();
+   done = true;
+   changer.join();
+   TUASSERTE(unsigned long, 5000, uut.getNumAccepted());
+   TUASSERT(store.size() > 0);
+   TURETURN();
+}
+
+
+unsigned PNBNavDataPipeline_T ::
+idleTest()
+{
+   TUDEF("PNBNavDataPipeline", "idle");
+   gnsstk::RinexNavDataFactory store;
+   gnsstk::PNBNavDataPipeline uut(store);
+   for (const auto& pnb : allPNB)
+      uut.addData(pnb);
+   uut.flush();
+      // Five worker and sink threads polling would use a good
+      // fraction of a CPU; sleeping threads use next to none.
+   std::clock_t cpu0 = std::clock();
+   std::this_thread::sleep_for(std::chrono::milliseconds(500));
+   double cpuSec = double(std::clock() - cpu0) / CLOCKS_PER_SEC;
+   TUASSERT(cpuSec < 0.05);
+      // and they still wake up for new data
+   uut.addData(allPNB[0]);
+   uut.flush();
+   TUASSERTE(unsigned long, allPNB.size()+1, uut.getNumAccepted());
+   TURETURN();
+}
+
+
+int main()
+{
+   PNBNavDataPipeline_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.newFactoryTest();
+   errorTotal += testClass.addDataTest();
+   errorTotal += testClass.recordTest();
+   errorTotal += testClass.overflowTest();
+   errorTotal += testClass.stopTest();
+   errorTotal += testClass.filterTest();
+   errorTotal += testClass.idleTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
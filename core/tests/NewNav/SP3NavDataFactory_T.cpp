@@ -41,6 +41,7 @@
 #include "OrbitDataSP3.hpp"
 #include "CivilTime.hpp"
 #include "GPSWeekSecond.hpp"
+#include <cmath>
 
 namespace gnsstk
 {
@@ -119,6 +120,9 @@ public:
                                  bool rcAfter);
       /// Test loading of RINEX clock data.
    unsigned addRinexClockTest();
+      /** Make sure the interpolation cache gives the same results as
+       * no cache, and that its counters and invalidation work. */
+   unsigned interpCacheTest();
       /** Use dynamic_cast to verify that the contents of nmm are the
        * right class.
        * @param[in] testFramework The test framework created by TUDEF,
@@ -1393,6 +1397,179 @@ nomTimeStepTest()
 }
 
 
+unsigned SP3NavDataFactory_T ::
+interpCacheTest()
+{
+   TUDEF("SP3NavDataFactory", "setInterpCacheSize");
+   using SS = gnsstk::SatelliteSystem;
+   using MT = gnsstk::NavMessageType;
+   TestClass fact;
+   gnsstk::CommonTime t0 = gnsstk::GPSWeekSecond(2100, 0);
+   unsigned addFails = 0;
+      // PRN 1 has velocity and clock drift, PRN 2 has neither, so
+      // both the interpolated and the derived values get exercised.
+   for (unsigned long prn = 1; prn <= 2; prn++)
+   {
+      gnsstk::SatID sat(prn, SS::GPS);
+      gnsstk::NavSatelliteID nsid(sat, sat, gnsstk::SP3NavDataFactory::oidGPS,
+                                  gnsstk::NavID(
+                                     gnsstk::SP3NavDataFactory::ntGPS));
+      for (unsigned i = 0; i < 96; i++)
+      {
+         double t = 900.0 * i, w = 1.4584e-4 + 1e-7 * prn;
+         std::shared_ptr<gnsstk::OrbitDataSP3> eph(
+            std::make_shared<gnsstk::OrbitDataSP3>());
+         std::shared_ptr<gnsstk::OrbitDataSP3> clk(
+            std::make_shared<gnsstk::OrbitDataSP3>());
+         eph->signal = gnsstk::NavMessageID(nsid, MT::Ephemeris);
+         clk->signal = gnsstk::NavMessageID(nsid, MT::Clock);
+         eph->timeStamp = clk->timeStamp = t0 + t;
+         eph->pos[0] = 26560.0 * ::cos(w * t);
+         eph->pos[1] = 26560.0 * ::sin(w * t);
+         eph->pos[2] = 100.0 * prn;
+         for (unsigned j = 0; j < 3; j++)
+         {
+            eph->posSig[j] = 0.001 * (i % 7);
+         }
+         clk->clkBias = 100.0 * prn + 1e-3 * t + 1e-9 * t * t;
+         clk->biasSig = 0.01 * (i % 5);
+         if (prn == 1)
+         {
+            eph->vel[0] = -26560.0 * w * ::sin(w * t) * 1e4;
+            eph->vel[1] = 26560.0 * w * ::cos(w * t) * 1e4;
+            clk->clkDrift = 1e-9 + 2e-15 * t;
+            clk->driftSig = 1e-12;
+         }
+         addFails += (fact.addNavData(eph) ? 0 : 1);
+         addFails += (fact.addNavData(clk) ? 0 : 1);
+      }
+   }
+   TUASSERTE(unsigned, 0, addFails);
+   TUASSERTE(size_t, 0, fact.getInterpCacheSize());
+      // The copy uses the same (shared) data but its own cache.
+   TestClass cached(fact);
+   cached.setInterpCacheSize(1000);
+   TUASSERTE(size_t, 1000, cached.getInterpCacheSize());
+   TUASSERTE(unsigned long, 0, cached.getInterpCacheHits());
+   TUASSERTE(unsigned long, 0, cached.getInterpCacheMisses());
+      // A cache that is too small to hold both satellites' windows.
+   TestClass tiny(fact);
+   tiny.setInterpCacheSize(3);
+   unsigned numFound = 0, mismatches = 0, tinyMismatches = 0;
+   auto same = [](const gnsstk::NavDataPtr& left,
+                  const gnsstk::NavDataPtr& right) -> bool
+   {
+      gnsstk::OrbitDataSP3 *l = dynamic_cast<gnsstk::OrbitDataSP3*>(
+         left.get());
+      gnsstk::OrbitDataSP3 *r = dynamic_cast<gnsstk::OrbitDataSP3*>(
+         right.get());
+         // bit-identical results are expected
+      return ((l != nullptr) && (r != nullptr) &&
+              (l->timeStamp == r->timeStamp) &&
+              (l->pos == r->pos) && (l->posSig == r->posSig) &&
+              (l->vel == r->vel) && (l->velSig == r->velSig) &&
+              (l->acc == r->acc) && (l->accSig == r->accSig) &&
+              (l->clkBias == r->clkBias) && (l->biasSig == r->biasSig) &&
+              (l->clkDrift == r->clkDrift) && (l->driftSig == r->driftSig) &&
+              (l->clkDrRate == r->clkDrRate) &&
+              (l->drRateSig == r->drRateSig));
+   };
+      // Search at a 30 second interval, including the exact epochs.
+   for (double t = -900.0; t < 87300.0; t += 30.0)
+   {
+      for (unsigned long prn = 1; prn <= 3; prn++)
+      {
+         gnsstk::NavMessageID nmid(
+            gnsstk::NavSatelliteID(prn, prn, SS::GPS, gnsstk::CarrierBand::L1,
+                                   gnsstk::TrackingCode::CA,
+                                   gnsstk::NavType::GPSLNAV),
+            MT::Ephemeris);
+         gnsstk::NavDataPtr exp, got, gotTiny;
+         bool expRC = fact.find(nmid, t0 + t, exp, gnsstk::SVHealth::Any,
+                                gnsstk::NavValidityType::ValidOnly,
+                                gnsstk::NavSearchOrder::User);
+         bool gotRC = cached.find(nmid, t0 + t, got, gnsstk::SVHealth::Any,
+                                  gnsstk::NavValidityType::ValidOnly,
+                                  gnsstk::NavSearchOrder::User);
+         bool tinyRC = tiny.find(nmid, t0 + t, gotTiny,
+                                 gnsstk::SVHealth::Any,
+                                 gnsstk::NavValidityType::ValidOnly,
+                                 gnsstk::NavSearchOrder::User);
+         if (expRC)
+         {
+            numFound++;
+            mismatches += ((gotRC && same(exp, got)) ? 0 : 1);
+            tinyMismatches += ((tinyRC && same(exp, gotTiny)) ? 0 : 1);
+         }
+         else
+         {
+            mismatches += (gotRC ? 1 : 0);
+            tinyMismatches += (tinyRC ? 1 : 0);
+         }
+      }
+   }
+      // make sure the test data is actually exercising something
+   TUASSERT(numFound > 5000);
+   TUASSERTE(unsigned, 0, mismatches);
+   TUASSERTE(unsigned, 0, tinyMismatches);
+      // The uncached factory never counts.
+   TUASSERTE(unsigned long, 0, fact.getInterpCacheHits());
+   TUASSERTE(unsigned long, 0, fact.getInterpCacheMisses());
+      // At most one lookup each for ephemeris and clock per search
+      // (none when an exact match can't be interpolated).
+   unsigned long lookups = (cached.getInterpCacheHits() +
+                            cached.getInterpCacheMisses());
+   TUASSERT(lookups <= 2*numFound);
+   TUASSERT(lookups > numFound);
+   TUASSERTE(unsigned long, lookups,
+             tiny.getInterpCacheHits() + tiny.getInterpCacheMisses());
+      // The larger cache should need to gather each window only
+      // once, i.e. once per epoch for each satellite and type.
+   TUASSERT(cached.getInterpCacheMisses() <= 2*2*96);
+   TUASSERT(tiny.getInterpCacheMisses() > cached.getInterpCacheMisses());
+      // Adding data should empty the cache, once for the whole load.
+   unsigned long misses = cached.getInterpCacheMisses();
+   gnsstk::NavMessageID nmid1(
+      gnsstk::NavSatelliteID(1, 1, SS::GPS, gnsstk::CarrierBand::L1,
+                             gnsstk::TrackingCode::CA,
+                             gnsstk::NavType::GPSLNAV),
+      MT::Ephemeris);
+   gnsstk::NavDataPtr nd;
+   TUASSERT(cached.find(nmid1, t0 + 43215.0, nd, gnsstk::SVHealth::Any,
+                        gnsstk::NavValidityType::ValidOnly,
+                        gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned long, misses, cached.getInterpCacheMisses());
+   std::shared_ptr<gnsstk::OrbitDataSP3> extra(
+      std::make_shared<gnsstk::OrbitDataSP3>(
+         *dynamic_cast<gnsstk::OrbitDataSP3*>(nd.get())));
+   extra->signal.sat = extra->signal.xmitSat = gnsstk::SatID(5, SS::GPS);
+   TUASSERT(cached.addNavData(extra));
+   std::shared_ptr<gnsstk::OrbitDataSP3> extra2(
+      std::make_shared<gnsstk::OrbitDataSP3>(*extra));
+   extra2->signal.sat = extra2->signal.xmitSat = gnsstk::SatID(6, SS::GPS);
+   TUASSERT(cached.addNavData(extra2));
+   nd.reset();
+   TUASSERT(cached.find(nmid1, t0 + 43215.0, nd, gnsstk::SVHealth::Any,
+                        gnsstk::NavValidityType::ValidOnly,
+                        gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned long, misses+2, cached.getInterpCacheMisses());
+      // clearInterpCache resets the counters.
+   cached.clearInterpCache();
+   TUASSERTE(unsigned long, 0, cached.getInterpCacheHits());
+   TUASSERTE(unsigned long, 0, cached.getInterpCacheMisses());
+   TUASSERTE(size_t, 1000, cached.getInterpCacheSize());
+      // Disabling the cache stops the counters.
+   cached.setInterpCacheSize(0);
+   nd.reset();
+   TUASSERT(cached.find(nmid1, t0 + 43215.0, nd, gnsstk::SVHealth::Any,
+                        gnsstk::NavValidityType::ValidOnly,
+                        gnsstk::NavSearchOrder::User));
+   TUASSERTE(unsigned long, 0, cached.getInterpCacheHits());
+   TUASSERTE(unsigned long, 0, cached.getInterpCacheMisses());
+   TURETURN();
+}
+
+
 int main()
 {
    SP3NavDataFactory_T testClass;
@@ -1422,6 +1599,7 @@ int main()
    errorTotal += testClass.addRinexClockTest();
    errorTotal += testClass.gapTest();
    errorTotal += testClass.nomTimeStepTest();
+   errorTotal += testClass.interpCacheTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
              << std::endl;
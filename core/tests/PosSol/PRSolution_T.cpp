@@ -0,0 +1,780 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+
+/// @file PRSolution_T.cpp Test PRSolution with synthetic data
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "PRSolution.hpp"
+#include "Combinations.hpp"
+#include "RinexNavDataFactory.hpp"
+#include "GPSLNavEph.hpp"
+#include "GPSEllipsoid.hpp"
+#include "GGTropModel.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class PRSolution_T
+{
+public:
+   PRSolution_T();
+      /// Make sure SimplePRSolution() gives the same results, bit for bit,
+      /// as before RAIMCompute() had its own subset solver.
+   unsigned simplePRSolutionTest();
+      /// Compare RAIMCompute() with a RAIM computed as it used to be, by
+      /// calling SimplePRSolution() for every subset, for unweighted,
+      /// diagonal and non-diagonal weights.
+   unsigned raimComputeTest();
+      /// Make sure a singular problem returns -2.
+   unsigned singularTest();
+      /// Make sure RAIMCompute() gives the same results for any NThreads.
+   unsigned nThreadsTest();
+      /// Make sure RAIMComputeEpochs() gives the same results as
+      /// RAIMCompute(), for any number of threads.
+   unsigned raimComputeEpochsTest();
+
+private:
+      /// Fill navLib with ephemerides for 30 GPS satellites.
+   void makeEphemeris();
+      /// Fill eps with count epochs of the pseudoranges of the visible
+      /// satellites, every interval seconds.
+   void makeData(std::vector<gnsstk::PRSolutionEpoch>& eps, unsigned count,
+                 double interval);
+      /// Compute a RAIM solution as RAIMCompute() did before it solved the
+      /// subsets itself: SimplePRSolution() for each combination of
+      /// excluded satellites, keeping the best. Returns as RAIMCompute(),
+      /// and the results in ep.
+   static int referenceRAIM(gnsstk::PRSolution& prs,
+                            gnsstk::PRSolutionEpoch& ep,
+                            const gnsstk::Matrix<double>& SVP,
+                            gnsstk::TropModel *pTropModel);
+      /// The measurement covariance inverse for n satellites: empty,
+      /// diagonal or not diagonal.
+   static gnsstk::Matrix<double> makeInvMC(unsigned n, int kind);
+      /// Count the differences between two results
+   static unsigned compare(const gnsstk::PRSolutionEpoch& a,
+                           const gnsstk::PRSolutionEpoch& b,
+                           double tol);
+      /// Count the differences between all the results of two epochs
+   static unsigned compareAll(const gnsstk::PRSolutionEpoch& a,
+                              const gnsstk::PRSolutionEpoch& b);
+      /// Copy the results of RAIMCompute() to an epoch
+   static void saveResults(const gnsstk::PRSolution& prs,
+                           gnsstk::PRSolutionEpoch& ep);
+      /// Count the differences between two vectors
+   static unsigned compare(const gnsstk::Vector<double>& a,
+                           const gnsstk::Vector<double>& b);
+      /// Count the differences between two matrices
+   static unsigned compare(const gnsstk::Matrix<double>& a,
+                           const gnsstk::Matrix<double>& b);
+      /// Configure a PRSolution for the data
+   static void configure(gnsstk::PRSolution& prs);
+
+   gnsstk::CommonTime ct;
+   gnsstk::NavLibrary navLib;
+   gnsstk::Position rx;
+   std::vector<gnsstk::PRSolutionEpoch> epochs;
+};
+
+
+PRSolution_T ::
+PRSolution_T()
+      : ct(gnsstk::CivilTime(2015,7,19,2,0,0.0,gnsstk::TimeSystem::GPS))
+{
+   rx.setECEF(-740290.0, -5457071.7, 3207245.6);
+   makeEphemeris();
+   makeData(epochs, 240, 15.0);
+}
+
+
+void PRSolution_T ::
+makeEphemeris()
+{
+   std::shared_ptr<gnsstk::RinexNavDataFactory> fact(
+      std::make_shared<gnsstk::RinexNavDataFactory>());
+   gnsstk::NavDataFactoryPtr ndfp(fact);
+   navLib.addFactory(ndfp);
+   for (unsigned long prn = 1; prn <= 30; prn++)
+   {
+      gnsstk::NavSatelliteID sat(prn, prn, gnsstk::SatelliteSystem::GPS,
+                                 gnsstk::CarrierBand::L1,
+                                 gnsstk::TrackingCode::CA,
+                                 gnsstk::NavType::GPSLNAV);
+      for (unsigned i = 0; i < 3; i++)
+      {
+         std::shared_ptr<gnsstk::GPSLNavEph> eph(
+            std::make_shared<gnsstk::GPSLNavEph>());
+         eph->signal = gnsstk::NavMessageID(
+            sat, gnsstk::NavMessageType::Ephemeris);
+         eph->timeStamp = ct + (7200.0*i - 7200.0);
+         eph->xmitTime = eph->xmit2 = eph->xmit3 = eph->timeStamp;
+         eph->Toe = eph->Toc = eph->timeStamp + 7200.0;
+         eph->A = 26559700.0;
+         eph->Ahalf = ::sqrt(eph->A);
+         eph->ecc = 0.005;
+         eph->i0 = 0.96;
+            // six planes of five satellites
+         eph->OMEGA0 = 1.0472 * ((prn-1) % 6);
+         eph->M0 = 1.2566 * ((prn-1) / 6) + 0.2 * ((prn-1) % 6)
+            + 0.000146 * 7200.0 * i;
+         eph->w = 0.1;
+         eph->af0 = 1e-5 * prn;
+         eph->health = gnsstk::SVHealth::Healthy;
+         eph->fixFit();
+         fact->addNavData(eph);
+      }
+   }
+   navLib.freeze();
+}
+
+
+void PRSolution_T ::
+makeData(std::vector<gnsstk::PRSolutionEpoch>& eps, unsigned count,
+         double interval)
+{
+   gnsstk::GPSEllipsoid ellip;
+   gnsstk::GGTropModel trop;
+   gnsstk::PRSolution prs;
+   configure(prs);
+   unsigned seed = 12345;
+   for (unsigned e = 0; e < count; e++)
+   {
+      gnsstk::PRSolutionEpoch ep;
+      ep.time = ct + interval*e;
+         // receiver clock (m)
+      double clk = 1000.0 + 0.1*e;
+      for (unsigned long prn = 1; prn <= 30; prn++)
+      {
+         gnsstk::SatID sat(prn, gnsstk::SatelliteSystem::GPS);
+         gnsstk::Xvt xvt;
+         if (!navLib.getXvt(gnsstk::NavSatelliteID(sat), ep.time, xvt))
+            continue;
+         gnsstk::Position sv(xvt.x[0], xvt.x[1], xvt.x[2]);
+         if (rx.elevation(sv) < 10.0)
+            continue;
+         ep.Satellites.push_back(sat);
+         ep.Pseudorange.push_back(2.2e7);
+      }
+         // iterate to get the transmit time right
+      for (unsigned iter = 0; iter < 3; iter++)
+      {
+         std::vector<gnsstk::SatID> sats(ep.Satellites);
+         gnsstk::Matrix<double> SVP;
+         prs.PreparePRSolution(ep.time, sats, ep.Pseudorange, navLib, SVP);
+         for (unsigned i = 0; i < sats.size(); i++)
+         {
+            double corr = SVP(i,3) - ep.Pseudorange[i];
+            double rho = gnsstk::RSS(SVP(i,0)-rx.X(), SVP(i,1)-rx.Y(),
+                                     SVP(i,2)-rx.Z());
+            double wt = ellip.angVelocity()*rho/ellip.c();
+            gnsstk::Position sv( ::cos(wt)*SVP(i,0) + ::sin(wt)*SVP(i,1),
+                                -::sin(wt)*SVP(i,0) + ::cos(wt)*SVP(i,1),
+                                 SVP(i,2));
+            rho = gnsstk::RSS(sv.X()-rx.X(), sv.Y()-rx.Y(), sv.Z()-rx.Z());
+            ep.Pseudorange[i] = rho + clk - corr
+               + trop.correction(rx, sv, ep.time);
+         }
+      }
+         // uniform noise of about a meter, and a fault every fifth epoch
+      for (unsigned i = 0; i < ep.Pseudorange.size(); i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         ep.Pseudorange[i] += ((seed >> 8) % 2000) / 1000.0 - 1.0;
+      }
+      if ((e % 5) == 0)
+      {
+         ep.Pseudorange[e % ep.Pseudorange.size()] += 100.0;
+      }
+      eps.push_back(ep);
+   }
+}
+
+
+void PRSolution_T ::
+configure(gnsstk::PRSolution& prs)
+{
+   prs.allowedGNSS.push_back(gnsstk::SatelliteSystem::GPS);
+   prs.RMSLimit = 3.0;
+}
+
+
+unsigned PRSolution_T ::
+compare(const gnsstk::PRSolutionEpoch& a, const gnsstk::PRSolutionEpoch& b,
+        double tol)
+{
+   unsigned diffs = 0;
+   if ((a.iret != b.iret) || (a.Satellites != b.Satellites) ||
+       (a.Solution.size() != b.Solution.size()))
+   {
+      return 1;
+   }
+   for (unsigned i = 0; i < a.Solution.size(); i++)
+   {
+      if (::fabs(a.Solution[i] - b.Solution[i]) > tol)
+         diffs++;
+   }
+   if (::fabs(a.RMSResidual - b.RMSResidual) > tol)
+      diffs++;
+   return diffs;
+}
+
+
+unsigned PRSolution_T ::
+compareAll(const gnsstk::PRSolutionEpoch& a, const gnsstk::PRSolutionEpoch& b)
+{
+   unsigned diffs = compare(a, b, 0.0);
+   diffs += compare(a.Covariance, b.Covariance);
+   diffs += compare(a.invMeasCov, b.invMeasCov);
+   diffs += compare(a.Partials, b.Partials);
+   diffs += compare(a.PreFitResidual, b.PreFitResidual);
+   if ((a.Valid != b.Valid) ||
+       (a.dataGNSS != b.dataGNSS) ||
+       (a.MaxSlope != b.MaxSlope) ||
+       (a.TDOP != b.TDOP) || (a.PDOP != b.PDOP) || (a.GDOP != b.GDOP) ||
+       (a.NIterations != b.NIterations) ||
+       (a.Convergence != b.Convergence) ||
+       (a.Nsvs != b.Nsvs) ||
+       (a.TropFlag != b.TropFlag) ||
+       (a.RMSFlag != b.RMSFlag) ||
+       (a.SlopeFlag != b.SlopeFlag))
+   {
+      diffs++;
+   }
+   return diffs;
+}
+
+
+void PRSolution_T ::
+saveResults(const gnsstk::PRSolution& prs, gnsstk::PRSolutionEpoch& ep)
+{
+   ep.Valid = prs.isValid();
+   ep.Solution = prs.Solution;
+   ep.Covariance = prs.Covariance;
+   ep.invMeasCov = prs.invMeasCov;
+   ep.Partials = prs.Partials;
+   ep.PreFitResidual = prs.PreFitResidual;
+   ep.dataGNSS = prs.dataGNSS;
+   ep.RMSResidual = prs.RMSResidual;
+   ep.MaxSlope = prs.MaxSlope;
+   ep.TDOP = prs.TDOP;
+   ep.PDOP = prs.PDOP;
+   ep.GDOP = prs.GDOP;
+   ep.NIterations = prs.NIterations;
+   ep.Convergence = prs.Convergence;
+   ep.Nsvs = prs.Nsvs;
+   ep.TropFlag = prs.TropFlag;
+   ep.RMSFlag = prs.RMSFlag;
+   ep.SlopeFlag = prs.SlopeFlag;
+}
+
+
+unsigned PRSolution_T ::
+compare(const gnsstk::Matrix<double>& a, const gnsstk::Matrix<double>& b)
+{
+   if ((a.rows() != b.rows()) || (a.cols() != b.cols()))
+      return 1;
+   unsigned diffs = 0;
+   for (unsigned i = 0; i < a.rows(); i++)
+   {
+      for (unsigned j = 0; j < a.cols(); j++)
+      {
+         if (a(i,j) != b(i,j))
+            diffs++;
+      }
+   }
+   return diffs;
+}
+
+
+unsigned PRSolution_T ::
+compare(const gnsstk::Vector<double>& a, const gnsstk::Vector<double>& b)
+{
+   if (a.size() != b.size())
+      return 1;
+   unsigned diffs = 0;
+   for (unsigned i = 0; i < a.size(); i++)
+   {
+      if (a[i] != b[i])
+         diffs++;
+   }
+   return diffs;
+}
+
+
+int PRSolution_T ::
+referenceRAIM(gnsstk::PRSolution& prs, gnsstk::PRSolutionEpoch& ep,
+              const gnsstk::Matrix<double>& SVP, gnsstk::TropModel *pTropModel)
+{
+   const std::vector<gnsstk::SatID> saveSats(ep.Satellites);
+   std::vector<gnsstk::SatID>& sats(ep.Satellites);
+   std::vector<int> good;
+   for (unsigned i = 0; i < sats.size(); i++)
+   {
+      if (sats[i].id > 0)
+         good.push_back(i);
+   }
+   const int N = good.size();
+   gnsstk::Vector<double> resids, slopes;
+   std::vector<gnsstk::SatID> bestSats;
+   int iret = 0, bestIret = -5;
+   double bestRMS = -1.0;
+
+   for (int stage = 0; ; stage++)
+   {
+      gnsstk::Combinations combo(N, stage);
+      do
+      {
+         sats = saveSats;
+         for (int i = 0; i < N; i++)
+         {
+            if (combo.isSelected(i))
+               sats[good[i]].id = -::abs(sats[good[i]].id);
+         }
+         iret = prs.SimplePRSolution(ep.time, sats, SVP, ep.invMC,
+                                     pTropModel, prs.MaxNIterations,
+                                     prs.ConvergenceLimit, resids, slopes);
+         if (iret <= 0 && iret > bestIret)
+            bestIret = iret;
+         if (iret == -1 || iret == -2)
+            continue;
+         if (iret == -3)
+            break;
+         if (bestRMS < 0.0 || prs.RMSResidual < bestRMS)
+         {
+            bestRMS = prs.RMSResidual;
+            bestSats = sats;
+            bestIret = iret;
+            ep.Solution = prs.Solution;
+            ep.RMSResidual = prs.RMSResidual;
+            ep.MaxSlope = prs.MaxSlope;
+            ep.Nsvs = prs.Nsvs;
+            ep.TropFlag = prs.TropFlag;
+         }
+         if (stage == 0 && prs.RMSResidual < prs.RMSLimit)
+            break;
+      } while (combo.Next() != -1);
+
+      if (bestRMS > 0.0 && bestRMS < prs.RMSLimit)
+      {
+         iret = 0;
+         break;
+      }
+      if ((prs.NSatsReject > -1 && stage+1 > prs.NSatsReject) || iret == -3)
+         break;
+   }
+
+   if (iret >= 0)
+   {
+      sats = bestSats;
+      iret = bestIret;
+      if (iret == 0 &&
+          (ep.MaxSlope > prs.SlopeLimit ||
+           (ep.MaxSlope > prs.SlopeLimit/2.0 && ep.Nsvs == 5) ||
+           bestRMS >= prs.RMSLimit || ep.TropFlag))
+      {
+         iret = 1;
+      }
+   }
+   ep.iret = iret;
+   return iret;
+}
+
+
+gnsstk::Matrix<double> PRSolution_T ::
+makeInvMC(unsigned n, int kind)
+{
+   if (kind == 0)
+      return gnsstk::Matrix<double>();
+   gnsstk::Matrix<double> invMC(n, n, 0.0);
+   for (unsigned i = 0; i < n; i++)
+   {
+         // sigma from 0.5 to 1.5 m
+      invMC(i,i) = 1.0 / ((0.5 + 0.1*(i % 11)) * (0.5 + 0.1*(i % 11)));
+         // diagonally dominant, so still positive definite
+      if (kind == 2 && i > 0)
+         invMC(i,i-1) = invMC(i-1,i) = -0.3;
+   }
+   return invMC;
+}
+
+
+unsigned PRSolution_T ::
+simplePRSolutionTest()
+{
+   TUDEF("PRSolution", "SimplePRSolution");
+      // results of the SimplePRSolution() of gnsstk 14 (Matrix and
+      // inverseSVD()), for all the satellites of some of the epochs, for
+      // each weighting of makeInvMC(), printed with %.17g
+   struct Expected
+   {
+      int kind;
+      unsigned epoch;
+      int iret;
+      int niter;
+      double sol[4];
+      double rms;
+      double maxSlope;
+   };
+   static const Expected expected[] =
+   {
+   { 0,   0, 0, 6,
+        { -740244.08939982136, -5456982.664964796, 3207168.6962768333, 929.53708231043458 }, 25.01391786804745, 7.3634681180014816 },
+   { 0,   1, 0, 6,
+        { -740290.22254843707, -5457073.2499638228, 3207245.7713531475, 1000.8707170601954 }, 0.37177409790161214, 7.4406475344894245 },
+   { 0,   2, 0, 6,
+        { -740290.02649170544, -5457071.6539421733, 3207246.8474295149, 1000.6263488890432 }, 0.33588062015002224, 7.4944211425859413 },
+   { 0,   5, 0, 6,
+        { -740286.93638210616, -5457024.3441010071, 3207256.645244942, 994.36738266249699 }, 28.402220763474933, 7.6578751058357302 },
+   { 0, 100, 0, 6,
+        { -740296.57077624358, -5457038.352437417, 3207208.4412337774, 994.87200111201867 }, 28.333516504110847, 8.4732165766652745 },
+   { 0, 239, 0, 6,
+        { -740290.62083350052, -5457072.3513337579, 3207245.7817556253, 1024.5217786682549 }, 0.22926055995365854, 2.0230027278513609 },
+   { 1,   0, 0, 6,
+        { -740237.67760885844, -5456950.4920945605, 3207143.9573078277, 909.62106827872151 }, 27.499623738933771, 7.6901385353086349 },
+   { 1,   1, 0, 6,
+        { -740290.32244984503, -5457073.5634575589, 3207246.0808825684, 1001.0681006128938 }, 0.39727956064936332, 7.7541385116202584 },
+   { 1,   2, 0, 6,
+        { -740290.14377647953, -5457071.9138605762, 3207247.1496543428, 1000.817851203386 }, 0.3572535478939341, 7.7989701222263115 },
+   { 1,   5, 0, 6,
+        { -740294.33168926043, -5457046.528671382, 3207275.7723224843, 1013.6787536050322 }, 29.024038120807695, 7.9358847142235129 },
+   { 1, 100, 0, 6,
+        { -740298.01691828924, -5457049.6164638791, 3207227.3986213021, 1005.338197255559 }, 29.136476606674627, 8.4252233879263816 },
+   { 1, 239, 0, 6,
+        { -740290.65542384516, -5457072.342776305, 3207245.7905202713, 1024.4847681741082 }, 0.23306562189358693, 3.5333195661288221 },
+   { 2,   0, 0, 6,
+        { -740235.09387897979, -5456962.5955580082, 3207161.8630141504, 929.57942063285623 }, 29.490093687918279, 8.6403406334029018 },
+   { 2,   1, 0, 6,
+        { -740290.38177657034, -5457073.4221685836, 3207245.8954650732, 1000.8459056786513 }, 0.42322159816533544, 8.712300184679977 },
+   { 2,   2, 0, 6,
+        { -740290.20279794664, -5457071.7893451657, 3207246.9748799023, 1000.614593590961 }, 0.38079545677715182, 8.7626441312888996 },
+   { 2,   5, 0, 6,
+        { -740294.44689237012, -5457039.034216702, 3207260.1971592028, 998.83946494196721 }, 29.313830736350852, 8.9162576077915521 },
+   { 2, 100, 0, 6,
+        { -740303.90150915307, -5457052.5066447314, 3207223.0502507016, 1003.7974376144709 }, 29.059761680910405, 6.8406863951464087 },
+   { 2, 239, 0, 6,
+        { -740290.72640740208, -5457072.4537393367, 3207245.5574750272, 1024.3397170767462 }, 0.31480820677276194, 3.7586212336851994 }
+   };
+   gnsstk::GGTropModel trop;
+   for (const auto& exp : expected)
+   {
+      gnsstk::PRSolution prs;
+      configure(prs);
+      prs.hasMemory = false;
+      gnsstk::PRSolutionEpoch ep(epochs[exp.epoch]);
+      gnsstk::Matrix<double> SVP;
+      prs.PreparePRSolution(ep.time, ep.Satellites, ep.Pseudorange, navLib,
+                            SVP);
+      gnsstk::Matrix<double> invMC(makeInvMC(ep.Satellites.size(), exp.kind));
+      gnsstk::Vector<double> resids, slopes;
+      TUASSERTE(int, exp.iret,
+                prs.SimplePRSolution(ep.time, ep.Satellites, SVP, invMC,
+                                     &trop, prs.MaxNIterations,
+                                     prs.ConvergenceLimit, resids, slopes));
+      TUASSERTE(int, exp.niter, prs.NIterations);
+      for (unsigned i = 0; i < 4; i++)
+      {
+         TUASSERTE(double, exp.sol[i], prs.Solution[i]);
+      }
+      TUASSERTE(double, exp.rms, prs.RMSResidual);
+      TUASSERTE(double, exp.maxSlope, prs.MaxSlope);
+   }
+
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+raimComputeTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   gnsstk::GGTropModel trop;
+
+   for (int kind = 0; kind < 3; kind++)
+   {
+      gnsstk::PRSolution prs, ref;
+      configure(prs);
+      configure(ref);
+         // independent epochs, so each starts from the same apriori
+      prs.hasMemory = ref.hasMemory = false;
+      unsigned diffs = 0, nExcluded = 0, nOK = 0;
+      double maxDiff = 0.0;
+      for (const auto& input : epochs)
+      {
+         gnsstk::PRSolutionEpoch ep(input);
+         gnsstk::Matrix<double> SVP;
+         prs.PreparePRSolution(ep.time, ep.Satellites, ep.Pseudorange,
+                               navLib, SVP);
+         ep.invMC = makeInvMC(ep.Satellites.size(), kind);
+         gnsstk::PRSolutionEpoch exp(ep);
+         referenceRAIM(ref, exp, SVP, &trop);
+         ep.iret = prs.RAIMCompute(ep.time, ep.Satellites, SVP, ep.invMC,
+                                   &trop);
+         ep.Solution = prs.Solution;
+         ep.RMSResidual = prs.RMSResidual;
+         if (ep.iret != exp.iret || ep.Satellites != exp.Satellites ||
+             ep.Solution.size() != exp.Solution.size())
+         {
+            diffs++;
+            continue;
+         }
+         nOK += (ep.iret >= 0 ? 1 : 0);
+         for (const auto& sat : ep.Satellites)
+            nExcluded += (sat.id < 0 ? 1 : 0);
+         for (unsigned i = 0; i < ep.Solution.size(); i++)
+            maxDiff = std::max(maxDiff,
+                               ::fabs(ep.Solution[i] - exp.Solution[i]));
+         maxDiff = std::max(maxDiff, ::fabs(ep.RMSResidual-exp.RMSResidual));
+         maxDiff = std::max(maxDiff, ::fabs(prs.MaxSlope - exp.MaxSlope));
+      }
+      TUASSERTE(unsigned, 0, diffs);
+      TUASSERTE(unsigned, 240, nOK);
+      TUASSERT(nExcluded >= 48);
+         // the subset solver of RAIMCompute() (downdated normal equations,
+         // Cholesky inversion) differs from the Matrix and inverseSVD()
+         // arithmetic of SimplePRSolution() only by rounding; the converged
+         // solutions differ by about 1e-8 m.
+      TUASSERT(maxDiff < 1e-7);
+   }
+
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+singularTest()
+{
+   TUDEF("PRSolution", "SimplePRSolution");
+   gnsstk::GGTropModel trop;
+   gnsstk::PRSolution prs;
+   configure(prs);
+   gnsstk::PRSolutionEpoch ep(epochs[1]);
+   gnsstk::Matrix<double> SVP;
+   prs.PreparePRSolution(ep.time, ep.Satellites, ep.Pseudorange, navLib, SVP);
+      // zero weights make the normal equations the zero matrix, which
+      // Cholesky cannot invert and inverseSVD() rejects
+   ep.invMC = gnsstk::Matrix<double>(ep.Satellites.size(),
+                                     ep.Satellites.size(), 0.0);
+   gnsstk::Vector<double> resids, slopes;
+   TUASSERTE(int, -2, prs.SimplePRSolution(ep.time, ep.Satellites, SVP,
+                                           ep.invMC, &trop,
+                                           prs.MaxNIterations,
+                                           prs.ConvergenceLimit,
+                                           resids, slopes));
+   TUASSERT(!prs.isValid());
+
+   TUCSM("RAIMCompute");
+      // every subset is singular, so RAIM fails when it may reject no more
+   const std::vector<gnsstk::SatID> sats(ep.Satellites);
+   const int nReject[] = { 0, 1, -1 }, expIret[] = { -2, -2, -3 };
+   for (unsigned i = 0; i < 3; i++)
+   {
+      prs.NSatsReject = nReject[i];
+      ep.Satellites = sats;
+      gnsstk::PRSolutionEpoch exp(ep);
+      TUASSERTE(int, expIret[i], prs.RAIMCompute(ep.time, ep.Satellites, SVP,
+                                                 ep.invMC, &trop));
+      TUASSERT(!prs.isValid());
+         // the satellites of the last subset tried are marked
+      TUASSERTE(int, expIret[i], referenceRAIM(prs, exp, SVP, &trop));
+      TUASSERT(ep.Satellites == exp.Satellites);
+   }
+
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+nThreadsTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+   gnsstk::GGTropModel trop;
+
+   for (int kind = 0; kind < 3; kind++)
+   {
+      gnsstk::PRSolution prs1, prs4;
+      configure(prs1);
+      configure(prs4);
+      prs4.NThreads = 4;
+      unsigned diffs = 0;
+      for (const auto& input : epochs)
+      {
+         gnsstk::PRSolutionEpoch ep1(input);
+         ep1.invMC = makeInvMC(ep1.Satellites.size(), kind);
+         gnsstk::PRSolutionEpoch ep4(ep1);
+         ep1.iret = prs1.RAIMCompute(ep1.time, ep1.Satellites,
+                                     ep1.Pseudorange, ep1.invMC, navLib,
+                                     &trop);
+         ep1.Solution = prs1.Solution;
+         ep1.RMSResidual = prs1.RMSResidual;
+         ep4.iret = prs4.RAIMCompute(ep4.time, ep4.Satellites,
+                                     ep4.Pseudorange, ep4.invMC, navLib,
+                                     &trop);
+         ep4.Solution = prs4.Solution;
+         ep4.RMSResidual = prs4.RMSResidual;
+         diffs += compare(ep1, ep4, 0.0);
+         diffs += (prs1.MaxSlope != prs4.MaxSlope ? 1 : 0);
+      }
+      TUASSERTE(unsigned, 0, diffs);
+      TUASSERTE(double, prs1.getAPV(), prs4.getAPV());
+      TUASSERTE(unsigned, 0, compare(prs1.APSolution, prs4.APSolution));
+   }
+
+   TURETURN();
+}
+
+
+unsigned PRSolution_T ::
+raimComputeEpochsTest()
+{
+   TUDEF("PRSolution", "RAIMComputeEpochs");
+   gnsstk::GGTropModel trop[4];
+   std::vector<gnsstk::TropModel*> trop1(1, &trop[0]), trop4;
+   for (unsigned i = 0; i < 4; i++)
+      trop4.push_back(&trop[i]);
+
+   for (int kind = 0; kind < 3; kind++)
+   {
+      for (bool memory : { true, false })
+      {
+            // reference: RAIMCompute() one epoch at a time
+         gnsstk::PRSolution serial;
+         configure(serial);
+         serial.hasMemory = memory;
+         std::vector<gnsstk::PRSolutionEpoch> expected(epochs);
+         unsigned nExcluded = 0, nFailed = 0;
+         for (auto& ep : expected)
+         {
+            ep.invMC = makeInvMC(ep.Satellites.size(), kind);
+            ep.iret = serial.RAIMCompute(ep.time, ep.Satellites,
+                                         ep.Pseudorange, ep.invMC, navLib,
+                                         &trop[0]);
+            saveResults(serial, ep);
+            for (const auto& sat : ep.Satellites)
+               nExcluded += (sat.id < 0 ? 1 : 0);
+            nFailed += (ep.iret < 0 ? 1 : 0);
+         }
+            // make sure the test data is actually exercising RAIM
+         TUASSERTE(unsigned, 0, nFailed);
+         TUASSERT(nExcluded >= 48);
+         TUASSERT(::fabs(serial.Solution[0] - rx.X()) < 1.0);
+
+            // identical results for any number of threads, block size and
+            // number of subset threads; a second call continues from the
+            // memory left by the first
+         const unsigned blockSizes[] = { 0, 1, 16, 1000 };
+         for (const auto& trops : { trop1, trop4 })
+         {
+            for (unsigned blockSize : blockSizes)
+            {
+               for (unsigned nThreads : { 1, 4 })
+               {
+                  gnsstk::PRSolution prs;
+                  configure(prs);
+                  prs.hasMemory = memory;
+                  prs.NThreads = nThreads;
+                  std::vector<gnsstk::PRSolutionEpoch>
+                     first(epochs.begin(), epochs.begin()+128),
+                     second(epochs.begin()+128, epochs.end());
+                  for (auto& ep : first)
+                     ep.invMC = makeInvMC(ep.Satellites.size(), kind);
+                  for (auto& ep : second)
+                     ep.invMC = makeInvMC(ep.Satellites.size(), kind);
+                  TUASSERTE(int, 128, prs.RAIMComputeEpochs(first, navLib,
+                                                            trops,
+                                                            blockSize));
+                  TUASSERTE(int, 112, prs.RAIMComputeEpochs(second, navLib,
+                                                            trops,
+                                                            blockSize));
+                  unsigned diffs = 0;
+                  for (unsigned i = 0; i < first.size(); i++)
+                     diffs += compareAll(expected[i], first[i]);
+                  for (unsigned i = 0; i < second.size(); i++)
+                     diffs += compareAll(expected[128+i], second[i]);
+                  TUASSERTE(unsigned, 0, diffs);
+                     // the member data and memory
+                  gnsstk::PRSolutionEpoch last, lastExp(expected.back());
+                  last.time = lastExp.time;
+                  last.Satellites = lastExp.Satellites;
+                  last.iret = lastExp.iret;
+                  saveResults(prs, last);
+                  TUASSERTE(unsigned, 0, compareAll(lastExp, last));
+                  TUASSERTE(int, serial.was.getN(), prs.was.getN());
+                  if (memory)
+                  {
+                     TUASSERTE(unsigned, 0, compare(serial.was.getSol(),
+                                                    prs.was.getSol()));
+                  }
+                  TUASSERTE(unsigned, 0, compare(serial.was.getInfo(),
+                                                 prs.was.getInfo()));
+                  TUASSERTE(int, serial.ndata, prs.ndata);
+                  TUASSERTE(int, serial.nsol, prs.nsol);
+                  TUASSERTE(int, serial.ndof, prs.ndof);
+                  TUASSERTE(double, serial.APV, prs.APV);
+                  TUASSERTE(double, serial.getAPV(), prs.getAPV());
+                  TUASSERTE(unsigned, 0, compare(serial.APSolution,
+                                                 prs.APSolution));
+               }
+            }
+         }
+      }
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   PRSolution_T testClass;
+
+   errorTotal += testClass.simplePRSolutionTest();
+   errorTotal += testClass.raimComputeTest();
+   errorTotal += testClass.singularTest();
+   errorTotal += testClass.nThreadsTest();
+   errorTotal += testClass.raimComputeEpochsTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -42,6 +42,7 @@
 #include <iostream>
 #include <sstream>
 #include <cmath>
+#include "TimeSystem.hpp"
 
 class BasicTimeSystemConverter_T
 {
@@ -166,6 +167,99 @@ public:
 
       TURETURN();
    }
+
+      /// Compare getOffset with the calendar-based correction.
+   unsigned getOffsetRangeTest()
+   {
+      TUDEF("TimeSystemConverter", "getOffset");
+      gnsstk::BasicTimeSystemConverter btsc;
+      const gnsstk::TimeSystem systems[] =
+      {
+         gnsstk::TimeSystem::GPS, gnsstk::TimeSystem::UTC,
+         gnsstk::TimeSystem::GLO, gnsstk::TimeSystem::BDT,
+         gnsstk::TimeSystem::TAI, gnsstk::TimeSystem::TDB
+      };
+      const unsigned numSys = sizeof(systems)/sizeof(systems[0]);
+      unsigned diffs = 0;
+      for (gnsstk::CommonTime t = gnsstk::CivilTime(1958,1,1,6,0,0);
+           t < gnsstk::CivilTime(2030,1,1); t += 3 * 86400. + 3600.)
+      {
+         gnsstk::CivilTime civ(t);
+         for (unsigned i = 0; i < numSys; i++)
+         {
+            for (unsigned j = 0; j < numSys; j++)
+            {
+               double offs;
+               btsc.getOffset(systems[i], systems[j], t, offs);
+               if (offs != gnsstk::getTimeSystemCorrection(
+                      systems[i], systems[j], civ.year, civ.month, civ.day))
+               {
+                  diffs++;
+               }
+            }
+         }
+      }
+      TUASSERTE(unsigned, 0, diffs);
+      TURETURN();
+   }
+
+
+      /// Count the times in a that differ from b, including system.
+   static unsigned countDiffs(const std::vector<gnsstk::CommonTime>& a,
+                              const std::vector<gnsstk::CommonTime>& b)
+   {
+      unsigned rv = 0;
+      for (unsigned i = 0; i < a.size(); i++)
+      {
+         if ((a[i] != b[i]) || (a[i].getTimeSystem() != b[i].getTimeSystem()))
+            rv++;
+      }
+      return rv;
+   }
+
+
+      /// Check that the bulk conversion matches one at a time.
+   unsigned changeTimeSystemTest()
+   {
+      TUDEF("TimeSystemConverter", "changeTimeSystem");
+      gnsstk::BasicTimeSystemConverter btsc;
+      std::vector<gnsstk::CommonTime> times, expected;
+         // 30 second epochs across the 2016/2017 leap second, some
+         // out of order and in a mix of time systems
+      gnsstk::CommonTime t = gnsstk::CivilTime(2016,12,31,23,0,0,
+                                               gnsstk::TimeSystem::UTC);
+      for (unsigned i = 0; i < 480; i++)
+      {
+         times.push_back(t);
+         t += 30.;
+      }
+      times[5].setTimeSystem(gnsstk::TimeSystem::GLO);
+      times[6].setTimeSystem(gnsstk::TimeSystem::BDT);
+      times[7] = gnsstk::CivilTime(1999,1,1,0,0,0,gnsstk::TimeSystem::TAI);
+      times[8].setTimeSystem(gnsstk::TimeSystem::GPS);
+      expected = times;
+      for (unsigned i = 0; i < expected.size(); i++)
+      {
+         TUASSERTE(bool, true, expected[i].changeTimeSystem(
+                      gnsstk::TimeSystem::GPS, &btsc));
+      }
+      TUASSERTE(bool, true, btsc.changeTimeSystem(times,
+                                                  gnsstk::TimeSystem::GPS));
+      TUASSERTE(unsigned, 0, countDiffs(expected, times));
+         // a time that can't be converted is left alone
+      times[3].setTimeSystem(gnsstk::TimeSystem::Unknown);
+      gnsstk::CommonTime unk = times[3];
+      expected = times;
+      for (unsigned i = 0; i < expected.size(); i++)
+      {
+         expected[i].changeTimeSystem(gnsstk::TimeSystem::UTC, &btsc);
+      }
+      TUASSERTE(bool, false, btsc.changeTimeSystem(times,
+                                                   gnsstk::TimeSystem::UTC));
+      TUASSERTE(unsigned, 0, countDiffs(expected, times));
+      TUASSERTE(gnsstk::CommonTime, unk, times[3]);
+      TURETURN();
+   }
 };
 
 
@@ -175,6 +269,8 @@ int main() //Main function to initialize and run all tests above
    unsigned errorCounter = 0;
 
    errorCounter += testClass.getOffsetTest();
+   errorCounter += testClass.getOffsetRangeTest();
+   errorCounter += testClass.changeTimeSystemTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorCounter
              << std::endl;
@@ -37,7 +37,12 @@
 //==============================================================================
 
 #include "TimeSystem.hpp"
+#include "TimeConverters.hpp"
+#include "TimeConstants.hpp"
 #include "TestUtil.hpp"
+#include "build_config.h"
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <cmath>
@@ -126,6 +131,164 @@ public:
 
       TURETURN();
    }
+
+
+      /* Compare getLeapSecondsMJD and getTimeSystemCorrectionMJD
+       * against the calendar versions for every day from before
+       * the first UTC-TAI offset to well after the last leap
+       * second. */
+   unsigned mjdTest()
+   {
+      TUDEF("TimeSystem", "getLeapSecondsMJD");
+      long firstMJD = gnsstk::convertCalendarToJD(1955,1,1) -
+         gnsstk::MJD_JDAY;
+      long lastMJD = gnsstk::convertCalendarToJD(2040,1,1) -
+         gnsstk::MJD_JDAY;
+      unsigned leapDiffs = 0;
+      for (long mjd = firstMJD; mjd <= lastMJD; mjd++)
+      {
+         int year, month, day;
+         gnsstk::convertJDtoCalendar(mjd + gnsstk::MJD_JDAY,
+                                     year, month, day);
+         if (gnsstk::getLeapSecondsMJD(mjd) !=
+             gnsstk::getLeapSeconds(year, month, day))
+         {
+            leapDiffs++;
+         }
+      }
+      TUASSERTE(unsigned, 0, leapDiffs);
+         // spot checks either side of a leap second and before 1972
+      TUASSERTE(double, 36, gnsstk::getLeapSecondsMJD(57753));
+      TUASSERTE(double, 37, gnsstk::getLeapSecondsMJD(57754));
+      TUASSERTE(double, 0, gnsstk::getLeapSecondsMJD(36933));
+      TUASSERTFE(5.478066, gnsstk::getLeapSecondsMJD(40375));
+
+      TUCSM("getTimeSystemCorrectionMJD");
+      for (gnsstk::TimeSystem in : gnsstk::TimeSystemIterator())
+      {
+         for (gnsstk::TimeSystem out : gnsstk::TimeSystemIterator())
+         {
+            unsigned diffs = 0;
+               // every 7th day keeps the run time down while still
+               // landing on every day of the week and month
+            for (long mjd = firstMJD; mjd <= lastMJD; mjd += 7)
+            {
+               int year, month, day;
+               gnsstk::convertJDtoCalendar(mjd + gnsstk::MJD_JDAY,
+                                           year, month, day);
+               double frac = (mjd % 4) * 0.25;
+               std::string expErr, gotErr;
+               double exp = 0, got = 0;
+               try
+               {
+                  exp = gnsstk::getTimeSystemCorrection(in, out, year, month,
+                                                        day + frac);
+               }
+               catch (gnsstk::Exception& e)
+               {
+                  expErr = e.getText();
+               }
+               try
+               {
+                  got = gnsstk::getTimeSystemCorrectionMJD(in, out, mjd,
+                                                           frac);
+               }
+               catch (gnsstk::Exception& e)
+               {
+                  gotErr = e.getText();
+               }
+               if ((exp != got) || (expErr != gotErr))
+                  diffs++;
+            }
+            TUASSERTE(unsigned, 0, diffs);
+         }
+      }
+      TUASSERTFE(-18, gnsstk::getTimeSystemCorrectionMJD(
+                    gnsstk::TimeSystem::GPS, gnsstk::TimeSystem::UTC, 57754));
+      TUASSERTFE(-4, gnsstk::getTimeSystemCorrectionMJD(
+                    gnsstk::TimeSystem::BDT, gnsstk::TimeSystem::UTC, 57754));
+      TURETURN();
+   }
+
+
+      /* Compare getTimeSystemCorrectionMJD and the calendar
+       * getTimeSystemCorrection with values computed by the toolkit
+       * before getTimeSystemCorrectionMJD was added, one second
+       * either side of every change in UTC-TAI, for every pair of
+       * systems. */
+   unsigned baselineTest()
+   {
+      TUDEF("TimeSystem", "getTimeSystemCorrectionMJD");
+      std::string fn(gnsstk::getPathData() + gnsstk::getFileSep() +
+                     "test_output_TimeSystem_corrections.txt");
+      std::ifstream ifs(fn.c_str());
+      TUASSERT(ifs.good());
+      std::string line;
+      long mjd = 0;
+      double frac = 0;
+      int year = 0, month = 0, day = 0;
+      unsigned numEpochs = 0, numPairs = 0, mjdDiffs = 0, calDiffs = 0;
+      while (std::getline(ifs, line))
+      {
+         if (line.empty() || (line[0] == '#'))
+            continue;
+         std::istringstream iss(line);
+         std::string inStr, outStr, expStr;
+         if (line[0] == '@')
+         {
+            std::string fracStr;
+            iss >> inStr >> mjd >> fracStr;
+               // hexadecimal, so the value is exact
+            frac = std::strtod(fracStr.c_str(), nullptr);
+            gnsstk::convertJDtoCalendar(mjd + gnsstk::MJD_JDAY,
+                                        year, month, day);
+            numEpochs++;
+            continue;
+         }
+         iss >> inStr >> outStr >> expStr;
+         gnsstk::TimeSystem in = gnsstk::StringUtils::asTimeSystem(inStr);
+         gnsstk::TimeSystem out = gnsstk::StringUtils::asTimeSystem(outStr);
+            // either the correction or "throw" and the exception text
+         std::string exp(expStr);
+         if (expStr == "throw")
+         {
+            std::getline(iss, exp);
+            exp = "throw" + exp;
+         }
+         double expVal = std::strtod(expStr.c_str(), nullptr);
+         std::string mjdGot, calGot;
+         try
+         {
+            double got = gnsstk::getTimeSystemCorrectionMJD(in, out, mjd,
+                                                            frac);
+            mjdGot = (got == expVal ? expStr : "differs");
+         }
+         catch (gnsstk::Exception& e)
+         {
+            mjdGot = "throw " + e.getText();
+         }
+         try
+         {
+            double got = gnsstk::getTimeSystemCorrection(in, out, year, month,
+                                                         day + frac);
+            calGot = (got == expVal ? expStr : "differs");
+         }
+         catch (gnsstk::Exception& e)
+         {
+            calGot = "throw " + e.getText();
+         }
+         mjdDiffs += (mjdGot == exp ? 0 : 1);
+         calDiffs += (calGot == exp ? 0 : 1);
+         numPairs++;
+      }
+      TUASSERTE(unsigned, 0, mjdDiffs);
+      TUCSM("getTimeSystemCorrection");
+      TUASSERTE(unsigned, 0, calDiffs);
+         // 42 changes in UTC-TAI from 1960 to 2017, both sides of each
+      TUASSERTE(unsigned, 84, numEpochs);
+      TUASSERTE(unsigned, 84 * 144, numPairs);
+      TURETURN();
+   }
 };
 
 
@@ -137,6 +300,8 @@ int main() //Main function to initialize and run all tests above
    errorCounter += testClass.operatorTest();
    errorCounter += testClass.getLeapSecondsTest();
    errorCounter += testClass.correctionTest();
+   errorCounter += testClass.mjdTest();
+   errorCounter += testClass.baselineTest();
 
    std::cout << "Total Failures for " << __FILE__ << ": " << errorCounter
              << std::endl;
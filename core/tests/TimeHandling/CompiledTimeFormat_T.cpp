@@ -0,0 +1,258 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "CompiledTimeFormat.hpp"
+#include "TimeString.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+#include <iostream>
+
+using namespace gnsstk;
+using namespace std;
+
+   /// Formats used by the FileHandling writers and readers.
+static const char *writerFormats[] =
+{
+   "%02m/%02d/%04Y %02H:%02M:%02S",
+   "%4Y %02m %02d %02H %02M %06.3f %P",
+   "%4Y %02m %02d %02H %02M %06.3f",
+   "%04Y/%02m/%02d %02H:%02M:%06.3f %P",
+   "%Y/%02m/%02d %2H:%02M:%06.3f = %F/%10.3g %P",
+   "%4Y %02m %02d %02H %02M %9.6f",
+   "%4Y %02m %02d %02H %02M %02S",
+   "%4F/%w/%10.3g = %04Y/%02m/%02d %02H:%02M:%02S",
+   "%4F %10.3g",
+   "%04Y/%02m/%02d %02H:%02M:%02S %4P",
+   "%04Y%02m%02d %02H%02M%02S UTC",
+   "%04Y%02m%02d %02H%02M%02S %P",
+   "%02y %2m %2d %2H %2M %4.1f",
+   " TOC %Y/%02m/%02d %02H:%02M:%02S",
+   " %02y %2m %2d %2H %2M%5.1f",
+};
+
+   /// Formats exercising every identifier and printTime() oddities.
+static const char *otherFormats[] =
+{
+   "%K %P",
+   "%Y %y %m %b %B %d %H %M %S %f",
+   "%E %F %G %w %g %P",
+   "%a %A %z %Z %c %C",
+   "%J %Q %15.6J %.3Q",
+   "%U %u %W %N",
+   "%Y %j %s %10.2s",
+   "%T %L %l %R %D %e %V %h %i %X %O %o",
+   "%%Y %5%Y %.3Y %x %-5d %05.1f % 3m",
+   "abc%",
+   "%5",
+   "",
+   "no identifiers",
+   "%Y %j %s",
+   "%F %g %P",
+   "%4F %w %02H:%02M:%02S",
+   "%F %w %s",
+   "%E %G %g",
+   "%L %g %P",
+   "%T %l %w %s",
+   "%D %g",
+   "%h %10.3g",
+   "%O %g",
+   "%Q %P",
+   "%J",
+   "%K",
+   "%U %u",
+   "%C",
+   "%F %z",
+   "%m/%d/%Y %H:%M:%S",
+   "%Y %b %d %H:%M:%f",
+   "%Y %B %d %s",
+   "%a %F %w %g",
+};
+
+class CompiledTimeFormat_T
+{
+public:
+   CompiledTimeFormat_T();
+      /// Compare print() with printTime().
+   unsigned printTest();
+      /// Compare print() into a short buffer with snprintf behavior.
+   unsigned printBufferTest();
+      /// Compare scan() with scanTime().
+   unsigned scanTest();
+
+      /// Times to print and scan.
+   vector<CommonTime> times;
+      /// Every format to test.
+   vector<string> formats;
+};
+
+
+CompiledTimeFormat_T ::
+CompiledTimeFormat_T()
+{
+   times.push_back(CivilTime(2008,8,21,13,30,15.25,TimeSystem::GPS));
+   times.push_back(CivilTime(2020,2,29,23,59,59.9995,TimeSystem::UTC));
+   times.push_back(CivilTime(1999,12,31,0,0,0,TimeSystem::GAL));
+   times.push_back(CivilTime(2015,6,7,8,9,10.125,TimeSystem::BDT));
+      // Before the GPS and BeiDou epochs, so printTime() falls
+      // through some TimeTag classes.
+   times.push_back(CivilTime(1975,3,4,5,6,7.5,TimeSystem::UTC));
+   times.push_back(CivilTime(1965,1,1,12,0,0,TimeSystem::Any));
+   for (unsigned i = 0; i < sizeof(writerFormats)/sizeof(writerFormats[0]);
+        i++)
+   {
+      formats.push_back(writerFormats[i]);
+   }
+   for (unsigned i = 0; i < sizeof(otherFormats)/sizeof(otherFormats[0]);
+        i++)
+   {
+      formats.push_back(otherFormats[i]);
+   }
+}
+
+
+unsigned CompiledTimeFormat_T ::
+printTest()
+{
+   TUDEF("CompiledTimeFormat", "print");
+   for (unsigned f = 0; f < formats.size(); f++)
+   {
+      CompiledTimeFormat uut(formats[f]);
+      TUASSERTE(std::string, formats[f], uut.getFormat());
+      for (unsigned i = 0; i < times.size(); i++)
+      {
+         std::string exp = printTime(times[i], formats[f]);
+         TUASSERTE(std::string, exp, uut.print(times[i]));
+         char buf[256];
+         TUASSERTE(std::string::size_type, exp.size(),
+                   uut.print(times[i], buf, sizeof(buf)));
+         TUASSERTE(std::string, exp, std::string(buf));
+      }
+   }
+   TURETURN();
+}
+
+
+unsigned CompiledTimeFormat_T ::
+printBufferTest()
+{
+   TUDEF("CompiledTimeFormat", "print");
+   CompiledTimeFormat uut("%04Y/%02m/%02d %02H:%02M:%06.3f %P");
+   std::string exp = printTime(times[0], uut.getFormat());
+   char buf[64];
+   for (unsigned len = 0; len < 30; len++)
+   {
+      memset(buf, 'x', sizeof(buf));
+      TUASSERTE(std::string::size_type, exp.size(),
+                uut.print(times[0], buf, len));
+      if (len > 0)
+      {
+         TUASSERTE(std::string, exp.substr(0, len-1), std::string(buf));
+      }
+         // nothing past the end of the buffer may be touched
+      TUASSERTE(char, 'x', buf[len]);
+   }
+      // longer than the internal buffer of print(t)
+   std::string longFmt(300, '-');
+   longFmt += "%Y";
+   uut.compile(longFmt);
+   TUASSERTE(std::string, printTime(times[0], longFmt), uut.print(times[0]));
+   TURETURN();
+}
+
+
+unsigned CompiledTimeFormat_T ::
+scanTest()
+{
+   TUDEF("CompiledTimeFormat", "scan");
+   for (unsigned f = 0; f < formats.size(); f++)
+   {
+      CompiledTimeFormat uut(formats[f]);
+      for (unsigned i = 0; i < times.size(); i++)
+      {
+         std::string str = printTime(times[i], formats[f]);
+            // whole strings, then truncated ones that scanTime rejects
+         for (std::string::size_type len = str.size(); ; len /= 2)
+         {
+            std::string sub(str.substr(0, len));
+            CommonTime exp, got;
+            std::string expErr, gotErr;
+            try
+            {
+               scanTime(exp, sub, formats[f]);
+            }
+            catch (gnsstk::Exception& e)
+            {
+               expErr = e.getText();
+            }
+            try
+            {
+               uut.scan(got, sub);
+            }
+            catch (gnsstk::Exception& e)
+            {
+               gotErr = e.getText();
+            }
+            TUCSM("scan \"" + formats[f] + "\" \"" + sub + "\"");
+            TUASSERTE(std::string, expErr, gotErr);
+            if (expErr.empty())
+            {
+               TUASSERTE(CommonTime, exp, got);
+            }
+            if (len == 0)
+               break;
+         }
+      }
+   }
+   TURETURN();
+}
+
+
+int main()
+{
+   CompiledTimeFormat_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.printTest();
+   errorTotal += testClass.printBufferTest();
+   errorTotal += testClass.scanTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,276 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include "FixedPointTime.hpp"
+#include "CivilTime.hpp"
+#include "TestUtil.hpp"
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+using namespace gnsstk;
+using namespace std;
+
+   // arithmetic and comparison are usable in constant expressions
+static_assert(FixedPointTime(10, -1) < FixedPointTime(10, 0),
+              "FixedPointTime::operator< is not constexpr");
+static_assert(FixedPointTime(10, -1).getSeconds() == 9,
+              "FixedPointTime normalization is not constexpr");
+static_assert(FixedPointTime(10, 0).addSeconds(-0.25).getAttoseconds() ==
+              750000000000000000LL,
+              "FixedPointTime::addSeconds is not constexpr");
+static_assert(FixedPointTime(12, 5) - FixedPointTime(10, 5) == 2.0,
+              "FixedPointTime::operator- is not constexpr");
+
+class FixedPointTime_T
+{
+public:
+   FixedPointTime_T();
+      /// Convert CommonTime to FixedPointTime and back.
+   unsigned roundTripTest();
+      /// Compare ordering and equality with CommonTime.
+   unsigned compareTest();
+      /// Compare differences and addition with CommonTime.
+   unsigned arithmeticTest();
+      /// Use FixedPointTime as map and unordered_map keys.
+   unsigned keyTest();
+
+      /// Times with fractional milliseconds across the CommonTime range.
+   vector<CommonTime> times;
+};
+
+
+FixedPointTime_T ::
+FixedPointTime_T()
+{
+   std::mt19937 gen(20221);
+   std::uniform_int_distribution<long> dayDist(CommonTime::BEGIN_LIMIT_JDAY,
+                                               CommonTime::END_LIMIT_JDAY-1);
+   std::uniform_int_distribution<long> msodDist(0, MS_PER_DAY-1);
+   std::uniform_real_distribution<double> fsodDist(0, 0.001);
+   times.push_back(CommonTime::BEGINNING_OF_TIME);
+   times.push_back(CommonTime::END_OF_TIME);
+   times.push_back(CivilTime(2022,1,1,0,0,0.0,TimeSystem::GPS));
+   times.push_back(CivilTime(2022,1,1,23,59,59.9999999999,TimeSystem::GPS));
+   for (unsigned i = 0; i < 2000; i++)
+   {
+      CommonTime ct;
+      ct.setInternal(dayDist(gen), msodDist(gen), (i % 4) ? fsodDist(gen) : 0,
+                     TimeSystem::GPS);
+      times.push_back(ct);
+   }
+}
+
+
+unsigned FixedPointTime_T ::
+roundTripTest()
+{
+   TUDEF("FixedPointTime", "FixedPointTime(CommonTime)");
+   unsigned bad = 0, badFixed = 0;
+   for (const auto& ct : times)
+   {
+      FixedPointTime fpt(ct);
+      CommonTime back(fpt.toCommonTime());
+      long d1, m1, d2, m2;
+      double f1, f2;
+      TimeSystem ts1, ts2;
+      ct.getInternal(d1, m1, f1, ts1);
+      back.getInternal(d2, m2, f2, ts2);
+      if (!(back == ct) || d1 != d2 || m1 != m2 || ts1 != ts2 ||
+          std::abs(f1-f2) > 1e-18)
+      {
+         bad++;
+      }
+      if (FixedPointTime(back) != fpt)
+      {
+         badFixed++;
+      }
+   }
+   TUASSERTE(unsigned, 0, bad);
+   TUASSERTE(unsigned, 0, badFixed);
+   FixedPointTime bot(CommonTime::BEGINNING_OF_TIME);
+   TUASSERTE(int64_t, 0, bot.getSeconds());
+   TUASSERTE(int64_t, 0, bot.getAttoseconds());
+   TUASSERTE(TimeSystem, TimeSystem::Any, bot.getTimeSystem());
+      // the last millisecond carries into the next second
+   CommonTime ct;
+   ct.setInternal(2459581, 999, std::nextafter(0.001, 0.0), TimeSystem::GPS);
+   FixedPointTime carry(ct);
+   TUASSERTE(int64_t, 2459581LL * 86400 + 1, carry.getSeconds());
+   TUASSERTE(int64_t, 0, carry.getAttoseconds());
+   TUCSM("toCommonTime");
+   TUTHROW(bot.addSeconds(-1).toCommonTime());
+   TUTHROW(FixedPointTime(CommonTime::END_OF_TIME).add(SEC_PER_DAY)
+           .toCommonTime());
+   TURETURN();
+}
+
+
+unsigned FixedPointTime_T ::
+compareTest()
+{
+   TUDEF("FixedPointTime", "operator<");
+   unsigned bad = 0;
+      // skip the Any sentinels, CommonTime won't order them with GPS
+   for (unsigned i = 2; i < times.size(); i++)
+   {
+      for (unsigned j = i; j < i + 50 && j < times.size(); j++)
+      {
+         FixedPointTime a(times[i]), b(times[j]);
+         if ((a < b) != (times[i] < times[j]) ||
+             (b < a) != (times[j] < times[i]) ||
+             (a == b) != (times[i] == times[j]) ||
+             (a <= b) != (times[i] <= times[j]) ||
+             (a >= b) != (times[i] >= times[j]))
+         {
+            bad++;
+         }
+      }
+   }
+   TUASSERTE(unsigned, 0, bad);
+      // same instant, different system: ordered, never equal
+   FixedPointTime gps(times[2]), utc(times[2]);
+   utc.setTimeSystem(TimeSystem::UTC);
+   TUASSERT(gps != utc);
+   TUASSERT((gps < utc) != (utc < gps));
+   TUASSERT(FixedPointTime(1, 0) > FixedPointTime(0, 999999999999999999LL));
+   TURETURN();
+}
+
+
+unsigned FixedPointTime_T ::
+arithmeticTest()
+{
+   TUDEF("FixedPointTime", "operator-");
+   unsigned badDiff = 0, badAdd = 0;
+   const double offsets[] = { 0.0, 1e-7, -1e-7, 0.5, -0.5, 30.25, -30.25,
+                              86399.999, -86399.999, 604800.125 };
+   for (unsigned i = 2; i + 1 < times.size(); i++)
+   {
+      FixedPointTime a(times[i]), b(times[i+1]);
+      double expDiff = times[i] - times[i+1];
+      if (std::abs((a - b) - expDiff) > std::abs(expDiff) * 1e-15 + 1e-9)
+      {
+         badDiff++;
+      }
+      for (double off : offsets)
+      {
+         CommonTime exp(times[i]);
+         try
+         {
+            exp.addSeconds(off);
+         }
+         catch (Exception&)
+         {
+            continue;
+         }
+         FixedPointTime got(a + off);
+            // CommonTime splits off into ms and a fraction, so allow
+            // for its rounding
+         if (std::abs(got.toCommonTime() - exp) > 1e-9)
+         {
+            badAdd++;
+         }
+      }
+   }
+   TUASSERTE(unsigned, 0, badDiff);
+   TUCSM("operator+");
+   TUASSERTE(unsigned, 0, badAdd);
+   FixedPointTime t(100, 0);
+   t += 0.75;
+   TUASSERTE(int64_t, 100, t.getSeconds());
+   TUASSERTE(int64_t, 750000000000000000LL, t.getAttoseconds());
+   t -= 1.5;
+   TUASSERTE(int64_t, 99, t.getSeconds());
+   TUASSERTE(int64_t, 250000000000000000LL, t.getAttoseconds());
+   TUCSM("diffAtto");
+   TUASSERTE(int64_t, -1500000000000000000LL,
+             t.diffAtto(FixedPointTime(100, 750000000000000000LL)));
+   TURETURN();
+}
+
+
+unsigned FixedPointTime_T ::
+keyTest()
+{
+   TUDEF("FixedPointTime", "hash");
+   map<FixedPointTime, unsigned> ordered;
+   unordered_map<FixedPointTime, unsigned> hashed;
+   map<CommonTime, unsigned> common;
+   for (unsigned i = 2; i < times.size(); i++)
+   {
+      FixedPointTime fpt(times[i]);
+      ordered[fpt] = i;
+      hashed[fpt] = i;
+      common[times[i]] = i;
+   }
+   TUASSERTE(size_t, common.size(), ordered.size());
+   TUASSERTE(size_t, common.size(), hashed.size());
+   unsigned badOrder = 0, badFind = 0;
+   auto ci = common.begin();
+   for (auto oi = ordered.begin(); oi != ordered.end(); ++oi, ++ci)
+   {
+      if (oi->first.toCommonTime() != ci->first || oi->second != ci->second)
+         badOrder++;
+      auto hi = hashed.find(oi->first);
+      if (hi == hashed.end() || hi->second != oi->second)
+         badFind++;
+   }
+   TUASSERTE(unsigned, 0, badOrder);
+   TUASSERTE(unsigned, 0, badFind);
+   TURETURN();
+}
+
+
+int main()
+{
+   FixedPointTime_T testClass;
+   unsigned errorTotal = 0;
+
+   errorTotal += testClass.roundTripTest();
+   errorTotal += testClass.compareTest();
+   errorTotal += testClass.arithmeticTest();
+   errorTotal += testClass.keyTest();
+
+   std::cout << "Total Failures for " << __FILE__ << ": " << errorTotal
+             << std::endl;
+
+   return errorTotal;
+}
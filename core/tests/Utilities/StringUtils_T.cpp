@@ -36,8 +36,11 @@
 //
 //==============================================================================
 
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <sstream>
 #include <iterator>
 #include "StringUtils.hpp"
@@ -412,6 +415,54 @@ public:
    }
 
 
+      /**
+       * Tests for the fixed-width field asDouble.
+       * Fields both simple enough to be decoded directly and those
+       * that aren't must give the same result as the std::string
+       * version.
+       */
+   unsigned fixedFieldToNumberTest()
+   {
+      TUDEF("StringUtils", "asDouble");
+      const char *fields[] =
+         { "  23619095.450", " -23619095.450", "        -0.000",
+           "        +1.5  ", "           12.", "          .125",
+           "123456789012.3", "1234567890.123", "  1.234567e+03",
+           "    12.5x     ", "    1 2       ", "             -",
+           "  1234567890123456.", "0.1234567890123456789",
+           "\t12.5", "              " };
+      for (unsigned i = 0; i < sizeof(fields)/sizeof(fields[0]); i++)
+      {
+         std::string str(fields[i]);
+         double exp = asDouble(str);
+         double got = asDouble(str.data(), str.length());
+         TUASSERTE(double, exp, got);
+         TUASSERTE(bool, std::signbit(exp), std::signbit(got));
+      }
+         // fields within a longer string
+      std::string line("G01  23619095.450   124118795.55917");
+      TUASSERTE(double, 23619095.45, asDouble(line.data()+3, 14));
+      TUASSERTE(double, 124118795.559, asDouble(line.data()+19, 14));
+         // sweep of F14.3 values including the full 13 digit range
+      unsigned long long seed = 12345;
+      unsigned mismatch = 0;
+      for (unsigned i = 0; i < 100000; i++)
+      {
+         seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+         long long ival = (seed >> 20) % 10000000000000LL;
+         if (seed & 1)
+            ival = -(ival / 10);
+         char buf[32];
+         snprintf(buf, sizeof(buf), "%14.3f", ival / 1000.);
+         std::string str(buf);
+         if (asDouble(str) != asDouble(str.data(), str.length()))
+            mismatch++;
+      }
+      TUASSERTE(unsigned, 0, mismatch);
+      TURETURN();
+   }
+
+
       /**
        * Tests for the number to string method.
        * Given numbers of various types, convert them to a string and
@@ -1269,6 +1320,7 @@ int main() // Main function to initialize and run all tests above
    errorTotal += testClass.stripTrailingTest();
    errorTotal += testClass.stripTest();
    errorTotal += testClass.stringToNumberTest();
+   errorTotal += testClass.fixedFieldToNumberTest();
    errorTotal += testClass.numberToStringTest();
    errorTotal += testClass.hexConversionTest();
    errorTotal += testClass.stringReplaceTest();
@@ -0,0 +1,161 @@
+//==============================================================================
+//
+//  This file is part of GNSSTk, the ARL:UT GNSS Toolkit.
+//
+//  The GNSSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GNSSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GNSSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin.
+//  Copyright 2004-2022, The Board of Regents of The University of Texas System
+//
+//==============================================================================
+
+//==============================================================================
+//
+//  This software was developed by Applied Research Laboratories at the
+//  University of Texas at Austin, under contract to an agency or agencies
+//  within the U.S. Department of Defense. The U.S. Government retains all
+//  rights to use, duplicate, distribute, disclose, or release this software.
+//
+//  Pursuant to DoD Directive 523024
+//
+//  DISTRIBUTION STATEMENT A: This software has been approved for public
+//                            release, distribution is unlimited.
+//
+//==============================================================================
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+
+class ThreadPool_T
+{
+public:
+      /// Make sure every iteration is run exactly once.
+   unsigned runTest();
+      /// Make sure minPerRange limits the number of ranges.
+   unsigned minPerRangeTest();
+      /// Make sure exceptions reach the caller and the pool still works.
+   unsigned exceptionTest();
+};
+
+
+unsigned ThreadPool_T ::
+runTest()
+{
+   TUDEF("ThreadPool", "run");
+   for (unsigned numThreads : {1, 2, 3, 8})
+   {
+      gnsstk::ThreadPool pool(numThreads);
+      TUASSERTE(unsigned, numThreads, pool.size());
+         // reuse the pool for loops of various sizes, including ones
+         // shorter than the number of threads
+      for (size_t n : {0, 1, 2, 5, 1000, 3, 10007})
+      {
+         vector<unsigned> hits(n, 0);
+         pool.run(n, [&hits](size_t first, size_t last)
+                  {
+                     for (size_t i = first; i < last; i++)
+                        hits[i]++;
+                  });
+         TUASSERTE(size_t, n, (size_t)count(hits.begin(), hits.end(), 1U));
+      }
+   }
+   gnsstk::ThreadPool hw;
+   TUASSERT(hw.size() > 0);
+   TURETURN();
+}
+
+
+unsigned ThreadPool_T ::
+minPerRangeTest()
+{
+   TUDEF("ThreadPool", "run");
+   gnsstk::ThreadPool pool(4);
+   for (size_t minPerRange : {1, 10, 30, 100})
+   {
+      mutex mtx;
+      vector<size_t> sizes;
+      pool.run(100, [&](size_t first, size_t last)
+               {
+                  lock_guard<mutex> lock(mtx);
+                  sizes.push_back(last - first);
+               }, minPerRange);
+      size_t expRanges = min<size_t>(4, max<size_t>(1, 100 / minPerRange));
+      TUASSERTE(size_t, expRanges, sizes.size());
+      size_t total = 0;
+      for (size_t sz : sizes)
+      {
+         TUASSERT(sz >= min<size_t>(minPerRange, 100));
+         total += sz;
+      }
+      TUASSERTE(size_t, 100, total);
+   }
+   TURETURN();
+}
+
+
+unsigned ThreadPool_T ::
+exceptionTest()
+{
+   TUDEF("ThreadPool", "run");
+   gnsstk::ThreadPool pool(3);
+   vector<unsigned> hits(30, 0);
+   try
+   {
+      pool.run(30, [&hits](size_t first, size_t last)
+               {
+                  for (size_t i = first; i < last; i++)
+                     hits[i]++;
+                  if (first > 0)
+                     throw std::runtime_error(to_string(first));
+               });
+      TUFAIL("no exception");
+   }
+   catch (std::runtime_error& e)
+   {
+         // the lowest throwing range is reported, after all finished
+      TUASSERTE(string, "10", string(e.what()));
+      TUASSERTE(size_t, 30, (size_t)count(hits.begin(), hits.end(), 1U));
+   }
+   size_t total = 0;
+   mutex mtx;
+   pool.run(30, [&](size_t first, size_t last)
+            {
+               lock_guard<mutex> lock(mtx);
+               total += last - first;
+            });
+   TUASSERTE(size_t, 30, total);
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   ThreadPool_T testClass;
+
+   errorTotal += testClass.runTest();
+   errorTotal += testClass.minPerRangeTest();
+   errorTotal += testClass.exceptionTest();
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+   return errorTotal;
+}